@@ -46,6 +46,8 @@
 #include "ossPath.hpp"
 #include "pmdStartup.hpp"
 #include "utilCompressor.hpp"
+#include "barStreamJob.hpp"
+#include "../bson/lib/md5.hpp"
 #include "pdTrace.hpp"
 #include "barTrace.hpp"
 
@@ -68,6 +70,7 @@ namespace engine
    #define BAR_SU_FILE_NAME               "suFileName"
    #define BAR_SU_FILE_OFFSET             "offset"
    #define BAR_SU_FILE_TYPE               "type"
+   #define BAR_REF_EXTENT_ID              "refExtentID"
 
    /*
       back up extent meta fields values
@@ -85,6 +88,9 @@ namespace engine
    #define BAR_COMPRSSS_MAX_SIZE          BAR_MAX_EXTENT_DATA_SIZE
    #define BAR_COMPRESS_RATIO_THRESHOLD   (0.8)                // 80%
 
+   // the segments of a storage unit file are split into tasks by the number
+   #define BAR_TASK_SEGMENT_NUM           (8)
+
    /*
       _barBaseLogger implement
    */
@@ -101,6 +107,9 @@ namespace engine
 
       _pCompressBuff = NULL ;
       _buffSize      = 0 ;
+
+      _runningStreams = 0 ;
+      _streamRC      = SDB_OK ;
    }
 
    _barBaseLogger::~_barBaseLogger ()
@@ -647,6 +656,78 @@ namespace engine
       return pBuff ;
    }
 
+   INT32 _barBaseLogger::runStream( _pmdEDUCB *cb )
+   {
+      INT32 rc = _runStream( cb ) ;
+      _onStreamEnd( rc ) ;
+      return rc ;
+   }
+
+   void _barBaseLogger::_onStreamEnd( INT32 result )
+   {
+      ossScopedLock lock( &_streamLatch ) ;
+      if ( SDB_OK != result && SDB_OK == _streamRC )
+      {
+         _streamRC = result ;
+      }
+      SDB_ASSERT( _runningStreams > 0, "No running stream" ) ;
+      if ( 0 == --_runningStreams )
+      {
+         _streamEvent.signalAll() ;
+      }
+   }
+
+   INT32 _barBaseLogger::_runStreams( UINT32 streamNum, _pmdEDUCB *cb )
+   {
+      INT32 rc = SDB_OK ;
+      UINT32 started = 0 ;
+
+      if ( 0 == streamNum )
+      {
+         goto done ;
+      }
+
+      _streamRC = SDB_OK ;
+      _runningStreams = streamNum ;
+      _streamEvent.reset() ;
+
+      for ( ; started < streamNum ; ++started )
+      {
+         rc = startStreamJob( this ) ;
+         if ( rc )
+         {
+            PD_LOG( PDERROR, "Failed to start stream job, rc: %d", rc ) ;
+            break ;
+         }
+      }
+      // the streams not started end with the error
+      for ( UINT32 i = started ; i < streamNum ; ++i )
+      {
+         _onStreamEnd( rc ) ;
+      }
+
+      // the streams refer to the logger, so wait for all of them
+      while ( SDB_OK != _streamEvent.wait( OSS_ONE_SEC ) )
+      {
+         if ( cb->isInterrupted() && SDB_OK == _streamRC )
+         {
+            ossScopedLock lock( &_streamLatch ) ;
+            if ( SDB_OK == _streamRC )
+            {
+               _streamRC = SDB_APP_INTERRUPT ;
+            }
+         }
+      }
+      rc = _streamRC ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to run %u streams, rc: %d",
+                   streamNum, rc ) ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
    /*
       _barBkupBaseLogger implement
    */
@@ -1032,10 +1113,9 @@ namespace engine
          return SDB_OK ;
       }
 
-      ++_metaHeader._lastDataSequence ;
-
+      UINT32 sequence = _allocDataSequence() ;
       barBackupDataHeader *pHeader = NULL ;
-      string fileName = getDataFileName( _metaHeader._lastDataSequence ) ;
+      string fileName = getDataFileName( sequence ) ;
       INT32 rc = ossOpen( fileName.c_str(), OSS_REPLACE | OSS_READWRITE,
                           OSS_RU | OSS_WU | OSS_RG, _curFile ) ;
       if ( rc )
@@ -1055,7 +1135,7 @@ namespace engine
       }
 
       pHeader->_secretValue   = _metaHeader._secretValue ;
-      pHeader->_sequence      = _metaHeader._lastDataSequence ;
+      pHeader->_sequence      = sequence ;
       pHeader->_compressionType = _metaHeader._compressionType ;
 
       rc = _flush( _curFile, (const CHAR *)pHeader,
@@ -1065,7 +1145,6 @@ namespace engine
 
       _curFileSize = BAR_BACKUPDATA_HEADER_SIZE ;
       _metaHeader._dataSize += BAR_BACKUPDATA_HEADER_SIZE ;
-      _metaHeader._dataFileNum++ ;
 
    done:
       if ( pHeader )
@@ -1077,6 +1156,14 @@ namespace engine
       goto done ;
    }
 
+   UINT32 _barBkupBaseLogger::_allocDataSequence ()
+   {
+      ossScopedLock lock( &_streamLatch ) ;
+      // the file is dropped with the backup once the sequence is taken
+      ++_metaHeader._dataFileNum ;
+      return ++_metaHeader._lastDataSequence ;
+   }
+
    barBackupExtentHeader* _barBkupBaseLogger::_nextDataExtent( UINT32 dataType )
    {
       if ( !_pDataExtent )
@@ -1240,21 +1327,33 @@ namespace engine
    */
    _barBKOfflineLogger::_barBKOfflineLogger ()
    {
-      _curDataType = BAR_DATA_TYPE_RAW_DATA ;
-      _curOffset   = 0 ;
-      _curSequence = 0 ;
       _replStatus  = -1 ;
       _hasRegBackup = FALSE ;
-      _pExtentBuff = NULL ;
+      _streamNum   = BAR_DFT_STREAM_NUM ;
+      _taskPos     = 0 ;
+      _streamPos   = 0 ;
    }
 
    _barBKOfflineLogger::~_barBKOfflineLogger ()
    {
-      if ( _pExtentBuff )
+      for ( UINT32 i = 0 ; i < _streams.size() ; ++i )
       {
-         SDB_OSS_FREE( _pExtentBuff ) ;
-         _pExtentBuff = NULL ;
+         SDB_OSS_DEL _streams[ i ] ;
+      }
+      _streams.clear() ;
+   }
+
+   void _barBKOfflineLogger::setStreamNum( UINT32 streamNum )
+   {
+      if ( 0 == streamNum )
+      {
+         streamNum = BAR_DFT_STREAM_NUM ;
       }
+      else if ( streamNum > BAR_MAX_STREAM_NUM )
+      {
+         streamNum = BAR_MAX_STREAM_NUM ;
+      }
+      _streamNum = streamNum ;
    }
 
    UINT32 _barBKOfflineLogger::_getBackupType () const
@@ -1414,60 +1513,9 @@ namespace engine
 
       if ( BAR_BACKUP_OP_TYPE_FULL == _metaHeader._opType )
       {
-         dmsStorageUnit *su = NULL ;
-         _SDB_DMSCB::CSCB_ITERATOR itr = _pDMSCB->begin() ;
-         while ( itr != _pDMSCB->end() )
-         {
-            if ( NULL == *itr )
-            {
-               ++itr ;
-               continue ;
-            }
-
-            su = (*itr)->_su ;
-
-            if ( su->data()->isTempSU () )
-            {
-               ++itr ;
-               continue ;
-            }
-
-            PD_LOG( PDEVENT, "Begin to backup storage: %s", su->CSName() ) ;
-
-            _curSequence = su->CSSequence() ;
-
-            _curDataType = BAR_DATA_TYPE_RAW_DATA ;
-            _curOffset = 0 ;
-            rc = _backupSU( su->data(), cb ) ;
-            PD_RC_CHECK( rc, PDERROR, "Failed to backup storage unit[%s] data "
-                         "su, rc: %d", su->CSName(), rc ) ;
-
-            _curDataType = BAR_DATA_TYPE_RAW_IDX ;
-            _curOffset = 0 ;
-            rc = _backupSU ( su->index(), cb ) ;
-            PD_RC_CHECK( rc, PDERROR, "Failed to backup storage unit[%s] "
-                         "index su, rc: %d", su->CSName(), rc ) ;
-
-            if ( su->lob()->isOpened() )
-            {
-               _curDataType = BAR_DATA_TYPE_RAW_LOBM ;
-               _curOffset = 0 ;
-               rc = _backupSU( su->lob(), cb ) ;
-               PD_RC_CHECK( rc, PDERROR, "Failed to backup storage unit[%s] "
-                            "lob meta su, rc: %d", su->CSName(), rc ) ;
-
-               _curDataType = BAR_DATA_TYPE_RAW_LOBD ;
-               _curOffset = 0 ;
-               rc = _backupLobData( su->lob(), cb ) ;
-               PD_RC_CHECK( rc, PDERROR, "Failed to backup storage unit[%s] "
-                            "lob data su, rc: %d", su->CSName(), rc ) ;
-            }
-
-            PD_LOG( PDEVENT, "Complete backup storage: %s", su->CSName() ) ;
-
-            _metaHeader._csNum++ ;
-            ++itr ;
-         }
+         rc = _backupStreams( cb ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to backup storage units, rc: %d",
+                      rc ) ;
       }
 
       PD_LOG( PDEVENT, "Begin to backup repl-log: %lld",
@@ -1484,144 +1532,176 @@ namespace engine
       goto done ;
    }
 
-   BSONObj _barBKOfflineLogger::_makeExtentMeta( _dmsStorageBase *pSU )
+   INT32 _barBKOfflineLogger::_backupStreams( _pmdEDUCB *cb )
    {
-      BSONObjBuilder builder ;
-      builder.append( BAR_SU_NAME, pSU->getSuName() ) ;
-      builder.append( BAR_SU_FILE_NAME, pSU->getSuFileName() ) ;
-      builder.append( BAR_SU_FILE_OFFSET, (long long)_curOffset ) ;
-      builder.append( BAR_SU_SEQUENCE, (INT32)_curSequence ) ;
-      if ( BAR_DATA_TYPE_RAW_DATA == _curDataType )
+      INT32 rc = SDB_OK ;
+      UINT32 streamNum = 0 ;
+      barBkupStream *pStream = NULL ;
+
+      _prepareTasks() ;
+      if ( _tasks.empty() )
       {
-         builder.append( BAR_SU_FILE_TYPE, BAR_SU_FILE_TYPE_DATA ) ;
+         goto done ;
       }
-      else if ( BAR_DATA_TYPE_RAW_IDX == _curDataType )
+
+      streamNum = _streamNum < _tasks.size() ?
+                  _streamNum : (UINT32)_tasks.size() ;
+      for ( UINT32 i = 1 ; i <= streamNum ; ++i )
       {
-         builder.append( BAR_SU_FILE_TYPE, BAR_SU_FILE_TYPE_INDEX ) ;
+         pStream = SDB_OSS_NEW barBkupStream( this, i ) ;
+         if ( !pStream )
+         {
+            PD_LOG( PDERROR, "Failed to alloc memory for backup stream" ) ;
+            rc = SDB_OOM ;
+            goto error ;
+         }
+         _streams.push_back( pStream ) ;
       }
-      else if ( BAR_DATA_TYPE_RAW_LOBM == _curDataType )
+      _taskPos = 0 ;
+      _streamPos = 0 ;
+
+      PD_LOG( PDEVENT, "Begin to backup %u storages by %u streams, task "
+              "num: %u", _metaHeader._csNum, streamNum, _tasks.size() ) ;
+
+      rc = _runStreams( streamNum, cb ) ;
+
+      for ( UINT32 i = 0 ; i < _streams.size() ; ++i )
       {
-         builder.append( BAR_SU_FILE_TYPE, BAR_SU_FILE_TYPE_LOBM ) ;
+         pStream = _streams[ i ] ;
+         _metaHeader._dataSize += pStream->_dataSize ;
+         _metaHeader._thinDataSize += pStream->_thinDataSize ;
+         _metaHeader._compressDataSize += pStream->_compressDataSize ;
+         _metaHeader._dedupDataSize += pStream->_dedupDataSize ;
+         _metaHeader._streamLastExtentID[ i ] = pStream->lastExtentID() ;
       }
-      else
+      _metaHeader._streamNum = streamNum ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to backup storages by streams, "
+                   "rc: %d", rc ) ;
+
+      PD_LOG( PDEVENT, "Complete backup storages, dedup data size: %llu",
+              _metaHeader._dedupDataSize ) ;
+
+   done:
+      for ( UINT32 i = 0 ; i < _streams.size() ; ++i )
       {
-         builder.append( BAR_SU_FILE_TYPE, BAR_SU_FILE_TYPE_LOBD ) ;
+         SDB_OSS_DEL _streams[ i ] ;
       }
-
-      return builder.obj() ;
+      _streams.clear() ;
+      _tasks.clear() ;
+      return rc ;
+   error:
+      goto done ;
    }
 
-   BSONObj _barBKOfflineLogger::_makeExtentMeta( _dmsStorageLob *pLobSU )
+   void _barBKOfflineLogger::_prepareTasks ()
    {
-      BSONObjBuilder builder ;
-      builder.append( BAR_SU_NAME, pLobSU->getSuName() ) ;
-      builder.append( BAR_SU_FILE_NAME,
-                      pLobSU->getLobData()->getFileName() ) ;
-      builder.append( BAR_SU_FILE_OFFSET, (long long)_curOffset ) ;
-      builder.append( BAR_SU_SEQUENCE, (INT32)_curSequence ) ;
-      if ( BAR_DATA_TYPE_RAW_DATA == _curDataType )
-      {
-         builder.append( BAR_SU_FILE_TYPE, BAR_SU_FILE_TYPE_DATA ) ;
-      }
-      else if ( BAR_DATA_TYPE_RAW_IDX == _curDataType )
-      {
-         builder.append( BAR_SU_FILE_TYPE, BAR_SU_FILE_TYPE_INDEX ) ;
-      }
-      else if ( BAR_DATA_TYPE_RAW_LOBM == _curDataType )
-      {
-         builder.append( BAR_SU_FILE_TYPE, BAR_SU_FILE_TYPE_LOBM ) ;
-      }
-      else
+      dmsStorageUnit *su = NULL ;
+      dmsStorageLobData *pLobData = NULL ;
+      _SDB_DMSCB::CSCB_ITERATOR itr = _pDMSCB->begin() ;
+
+      _tasks.clear() ;
+      for ( ; itr != _pDMSCB->end() ; ++itr )
       {
-         builder.append( BAR_SU_FILE_TYPE, BAR_SU_FILE_TYPE_LOBD ) ;
-      }
+         if ( NULL == *itr )
+         {
+            continue ;
+         }
 
-      return builder.obj() ;
+         su = (*itr)->_su ;
+
+         if ( su->data()->isTempSU () )
+         {
+            continue ;
+         }
+
+         su->data()->syncMemToMmap() ;
+         _addTasks( su, BAR_DATA_TYPE_RAW_DATA, su->data()->segmentSize() ) ;
+         su->index()->syncMemToMmap() ;
+         _addTasks( su, BAR_DATA_TYPE_RAW_IDX, su->index()->segmentSize() ) ;
+
+         if ( su->lob()->isOpened() )
+         {
+            su->lob()->syncMemToMmap() ;
+            _addTasks( su, BAR_DATA_TYPE_RAW_LOBM,
+                       su->lob()->segmentSize() ) ;
+
+            // the segment 0 is the part before the pages
+            pLobData = su->lob()->getLobData() ;
+            _addTasks( su, BAR_DATA_TYPE_RAW_LOBD,
+                       1 + (UINT32)( ( pLobData->getDataSz() +
+                                       DMS_SEGMENT_SZ - 1 ) /
+                                     DMS_SEGMENT_SZ ) ) ;
+         }
+
+         PD_LOG( PDEVENT, "Backup storage: %s", su->CSName() ) ;
+         _metaHeader._csNum++ ;
+      }
    }
 
-   INT32 _barBKOfflineLogger::_nextThinCopyInfo( dmsStorageBase *pSU,
-                                                 UINT32 startExtID,
-                                                 UINT32 maxExtID,
-                                                 UINT32 maxNum,
-                                                 UINT32 &num,
-                                                 BOOLEAN &used )
+   void _barBKOfflineLogger::_addTasks( _dmsStorageUnit *pSU,
+                                        UINT32 dataType,
+                                        UINT32 segmentNum )
    {
-      INT32 rc = SDB_OK ;
-      const dmsSpaceManagementExtent *pSME = pSU->getSME() ;
-      num   = 0 ;
-      used  = FALSE ;
-      CHAR  flag = DMS_SME_ALLOCATED ;
+      barBackupTask task ;
+      task._pSU = pSU ;
+      task._dataType = dataType ;
 
-      if ( startExtID >= pSU->pageNum() )
+      for ( UINT32 seg = 0 ; seg < segmentNum ; seg += BAR_TASK_SEGMENT_NUM )
       {
-         rc = SDB_SYS ;
-         PD_LOG( PDERROR, "start extent id[%u] is more than total data "
-                 "pages[%u]", startExtID, pSU->pageNum() ) ;
-         goto error ;
+         task._beginSeg = seg ;
+         task._endSeg = segmentNum - seg > BAR_TASK_SEGMENT_NUM ?
+                        seg + BAR_TASK_SEGMENT_NUM : segmentNum ;
+         _tasks.push_back( task ) ;
       }
+   }
 
-      if ( startExtID >= maxExtID || num >= maxNum )
+   BOOLEAN _barBKOfflineLogger::_popTask( barBackupTask &task )
+   {
+      ossScopedLock lock( &_streamLatch ) ;
+      if ( _isStreamStopped() || _taskPos >= _tasks.size() )
       {
-         goto done ;
+         return FALSE ;
       }
+      task = _tasks[ _taskPos++ ] ;
+      return TRUE ;
+   }
 
-      if ( DMS_SME_ALLOCATED == pSME->getBitMask( startExtID ) )
-      {
-         used = TRUE ;
-      }
-      else
+   INT32 _barBKOfflineLogger::_runStream( _pmdEDUCB *cb )
+   {
+      barBkupStream *pStream = NULL ;
+
+      _streamLatch.get() ;
+      if ( _streamPos < _streams.size() )
       {
-         used = FALSE ;
+         pStream = _streams[ _streamPos++ ] ;
       }
-      ++num ;
+      _streamLatch.release() ;
 
-      while ( num < maxNum && startExtID + num < maxExtID )
+      if ( !pStream )
       {
-         flag = pSME->getBitMask( startExtID + num ) ;
-
-         if ( ( used && DMS_SME_ALLOCATED != flag ) ||
-              ( !used && DMS_SME_ALLOCATED == flag ) )
-         {
-            break ;
-         }
-         ++num ;
+         PD_LOG( PDERROR, "No backup stream to run" ) ;
+         return SDB_SYS ;
       }
-
-   done:
-      return rc ;
-   error:
-      goto done ;
+      return pStream->run( cb ) ;
    }
 
-   INT32 _barBKOfflineLogger::_backupSU( _dmsStorageBase *pSU,
-                                         _pmdEDUCB *cb )
+   INT32 _barBKOfflineLogger::_backupLog( pmdEDUCB *cb )
    {
       INT32 rc = SDB_OK ;
-      BSONObj metaObj ;
+      DPS_LSN lsn ;
+      DPS_LSN_OFFSET oldTransLsn = DPS_INVALID_LSN_OFFSET ;
       barBackupExtentHeader *pHeader = NULL ;
-      ossValuePtr ptr   = 0 ;
-      UINT32 length     = 0 ;
-      BOOLEAN thinCopy  = FALSE ;
-
-      UINT32 segmentID = 0 ;
-      UINT32 curExtentID = 0 ;
-      UINT32 maxExtNum = BAR_MAX_EXTENT_DATA_SIZE >> pSU->pageSizeSquareRoot() ;
-
-      pSU->syncMemToMmap() ;
+      dpsMessageBlock mb( BAR_MAX_EXTENT_DATA_SIZE ) ;
+      BOOLEAN endLoop = FALSE ;
+      const dpsLogRecordHeader *pLastLSN = NULL ;
 
-      if ( pSU->dataSize() > ((UINT64)BAR_THINCOPY_THRESHOLD_SIZE << 20 ) )
+      if ( DPS_INVALID_LSN_OFFSET == _metaHeader._beginLSNOffset )
       {
-         FLOAT64 ratio = (FLOAT64)pSU->getSMEMgr()->totalFree() /
-                         (FLOAT64)pSU->pageNum() ;
-         if ( ratio >= BAR_THINCOPY_THRESHOLD_RATIO )
-         {
-            thinCopy = TRUE ;
-         }
+         goto done ;
       }
 
-      UINT32 pos = pSU->begin() ;
-      ossMmapFile::ossMmapSegment *pSegment = NULL ;
-      while ( NULL != ( pSegment = pSU->next( pos ) ) )
+      lsn.offset = _metaHeader._beginLSNOffset ;
+      while ( !endLoop )
       {
          if ( cb->isInterrupted() )
          {
@@ -1629,33 +1709,344 @@ namespace engine
             goto error ;
          }
 
-         ptr = pSegment->_ptr ;
-         length = pSegment->_length ;
+         mb.clear() ;
 
-         if ( segmentID < pSU->dataStartSegID() || !thinCopy )
+         while ( mb.length() < BAR_MAX_EXTENT_DATA_SIZE )
          {
-            while ( length > 0 )
+            rc = _pDPSCB->search( lsn, &mb ) ;
+            if ( SDB_DPS_LSN_OUTOFRANGE == rc )
             {
-               pHeader = _nextDataExtent( _curDataType ) ;
-               pHeader->_dataSize = length < BAR_MAX_EXTENT_DATA_SIZE ?
-                                    length : BAR_MAX_EXTENT_DATA_SIZE ;
-               metaObj = _makeExtentMeta( pSU ) ;
-               pHeader->setMetaData( metaObj.objdata(), metaObj.objsize() ) ;
-
-               rc = _writeExtent( pHeader, (const CHAR *)ptr ) ;
-               PD_RC_CHECK( rc, PDERROR, "Failed to write extent, rc: %d",
-                            rc ) ;
-
-               length -= pHeader->_dataSize ;
-               ptr += pHeader->_dataSize ;
-               _curOffset += pHeader->_dataSize ;
+               rc = SDB_OK ;
+               endLoop = TRUE ;
+               break ;
+            }
+            else if ( rc )
+            {
+               DPS_LSN fileBegin ;
+               DPS_LSN memBegin ;
+               DPS_LSN endLsn ;
+               DPS_LSN expectLsn ;
+               _pDPSCB->getLsnWindow( fileBegin, memBegin, endLsn,
+                                      &expectLsn, NULL ) ;
+               PD_LOG( PDERROR, "Failed to search lsn[%u,%lld] in "
+                       "log[FileBeginLsn:%lld, MemBeginLsn:%lld, EndLsn:%lld,"
+                       "ExpectLsn:%lld], rc: %d", lsn.version, lsn.offset,
+                       fileBegin.offset, memBegin.offset, endLsn.offset,
+                       expectLsn.offset, rc ) ;
+               goto error ;
             }
+            pLastLSN = (const dpsLogRecordHeader*)mb.readPtr() ;
+            mb.readPtr( mb.length() ) ;
+            lsn.offset += pLastLSN->_length ;
+            lsn.version = pLastLSN->_version ;
          }
-         else
+
+         oldTransLsn = _pTransCB->getOldestBeginLsn() ;
+         if ( 0 == mb.length() )
          {
-            UINT32 num = 0 ;
+            break ;
+         }
+
+         pHeader = _nextDataExtent( BAR_DATA_TYPE_REPL_LOG ) ;
+         pHeader->_dataSize = mb.length() ;
+
+         rc = _writeExtent( pHeader, mb.startPtr() ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to write extent, rc: %d", rc ) ;
+      }
+
+      if ( lsn.compareOffset( _metaHeader._endLSNOffset ) < 0 )
+      {
+         PD_LOG( PDWARNING, "Real end lsn[%u,%llu] is smaller than expect "
+                 "end lsn[%llu]", lsn.version, lsn.offset,
+                 _metaHeader._endLSNOffset ) ;
+         _metaHeader._endLSNOffset = lsn.offset ;
+      }
+      else if ( lsn.compareOffset( _metaHeader._endLSNOffset ) > 0 )
+      {
+         PD_LOG( PDINFO, "Real end lsn[%u,%llu] is grater than expect "
+                 "end lsn[%llu]", lsn.version, lsn.offset,
+                 _metaHeader._endLSNOffset ) ;
+         _metaHeader._endLSNOffset = lsn.offset ;
+      }
+      if ( oldTransLsn != _metaHeader._transLSNOffset )
+      {
+         PD_LOG( PDWARNING, "Old trans lsn[%lld] is not the same with "
+                 "expect trans lsn[%lld]", oldTransLsn,
+                 _metaHeader._transLSNOffset ) ;
+         _metaHeader._transLSNOffset = oldTransLsn ;
+      }
+
+      if ( pLastLSN )
+      {
+         _metaHeader._lastLSN = pLastLSN->_lsn ;
+         _metaHeader._lastLSNCode = ossHash( (const CHAR*)pLastLSN,
+                                             pLastLSN->_length ) ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   /*
+      _barBkupStream implement
+   */
+   _barBkupStream::_barBkupStream( _barBKOfflineLogger *pLogger,
+                                   UINT32 streamID )
+   {
+      _dataSize         = 0 ;
+      _thinDataSize     = 0 ;
+      _compressDataSize = 0 ;
+      _dedupDataSize    = 0 ;
+
+      _pLogger          = pLogger ;
+      _streamID         = streamID ;
+      _extentSeq        = 0 ;
+
+      _isOpened         = FALSE ;
+      _curFileSize      = 0 ;
+
+      _curDataType      = BAR_DATA_TYPE_RAW_DATA ;
+      _curOffset        = 0 ;
+      _curSequence      = 0 ;
+
+      _pExtentBuff      = NULL ;
+      _extentBuffSize   = 0 ;
+      _pCompressBuff    = NULL ;
+      _compressBuffSize = 0 ;
+   }
+
+   _barBkupStream::~_barBkupStream()
+   {
+      _closeDataFile() ;
+      if ( _pExtentBuff )
+      {
+         SDB_OSS_FREE( _pExtentBuff ) ;
+         _pExtentBuff = NULL ;
+      }
+      if ( _pCompressBuff )
+      {
+         SDB_OSS_FREE( _pCompressBuff ) ;
+         _pCompressBuff = NULL ;
+      }
+   }
+
+   INT32 _barBkupStream::run( _pmdEDUCB *cb )
+   {
+      INT32 rc = SDB_OK ;
+      barBackupTask task ;
+
+      while ( _pLogger->_popTask( task ) )
+      {
+         rc = _backupTask( task, cb ) ;
+         PD_RC_CHECK( rc, PDERROR, "Stream[%u] failed to backup storage[%s], "
+                      "data type: %u, segment: [%u, %u), rc: %d", _streamID,
+                      task._pSU->CSName(), task._dataType, task._beginSeg,
+                      task._endSeg, rc ) ;
+      }
+
+   done:
+      _closeDataFile() ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _barBkupStream::_backupTask( const barBackupTask &task,
+                                      _pmdEDUCB *cb )
+   {
+      INT32 rc = SDB_OK ;
+      dmsStorageUnit *su = task._pSU ;
+
+      PD_LOG( PDDEBUG, "Stream[%u] begin to backup storage[%s], data type: "
+              "%u, segment: [%u, %u)", _streamID, su->CSName(),
+              task._dataType, task._beginSeg, task._endSeg ) ;
+
+      _curSequence = su->CSSequence() ;
+      _curDataType = task._dataType ;
+
+      switch ( task._dataType )
+      {
+         case BAR_DATA_TYPE_RAW_DATA :
+            rc = _backupSU( su->data(), task, cb ) ;
+            break ;
+         case BAR_DATA_TYPE_RAW_IDX :
+            rc = _backupSU( su->index(), task, cb ) ;
+            break ;
+         case BAR_DATA_TYPE_RAW_LOBM :
+            rc = _backupSU( su->lob(), task, cb ) ;
+            break ;
+         case BAR_DATA_TYPE_RAW_LOBD :
+            rc = _backupLobData( su->lob(), task, cb ) ;
+            break ;
+         default :
+            PD_LOG( PDERROR, "Unknow data type[%u]", task._dataType ) ;
+            rc = SDB_SYS ;
+            break ;
+      }
+
+      return rc ;
+   }
+
+   BSONObj _barBkupStream::_makeExtentMeta( const CHAR *suName,
+                                            const CHAR *suFileName )
+   {
+      BSONObjBuilder builder ;
+      builder.append( BAR_SU_NAME, suName ) ;
+      builder.append( BAR_SU_FILE_NAME, suFileName ) ;
+      builder.append( BAR_SU_FILE_OFFSET, (long long)_curOffset ) ;
+      builder.append( BAR_SU_SEQUENCE, (INT32)_curSequence ) ;
+      if ( BAR_DATA_TYPE_RAW_DATA == _curDataType )
+      {
+         builder.append( BAR_SU_FILE_TYPE, BAR_SU_FILE_TYPE_DATA ) ;
+      }
+      else if ( BAR_DATA_TYPE_RAW_IDX == _curDataType )
+      {
+         builder.append( BAR_SU_FILE_TYPE, BAR_SU_FILE_TYPE_INDEX ) ;
+      }
+      else if ( BAR_DATA_TYPE_RAW_LOBM == _curDataType )
+      {
+         builder.append( BAR_SU_FILE_TYPE, BAR_SU_FILE_TYPE_LOBM ) ;
+      }
+      else
+      {
+         builder.append( BAR_SU_FILE_TYPE, BAR_SU_FILE_TYPE_LOBD ) ;
+      }
+
+      return builder.obj() ;
+   }
+
+   INT32 _barBkupStream::_nextThinCopyInfo( dmsStorageBase *pSU,
+                                            UINT32 startExtID,
+                                            UINT32 maxExtID,
+                                            UINT32 maxNum,
+                                            UINT32 &num,
+                                            BOOLEAN &used )
+   {
+      INT32 rc = SDB_OK ;
+      const dmsSpaceManagementExtent *pSME = pSU->getSME() ;
+      num   = 0 ;
+      used  = FALSE ;
+      CHAR  flag = DMS_SME_ALLOCATED ;
+
+      if ( startExtID >= pSU->pageNum() )
+      {
+         rc = SDB_SYS ;
+         PD_LOG( PDERROR, "start extent id[%u] is more than total data "
+                 "pages[%u]", startExtID, pSU->pageNum() ) ;
+         goto error ;
+      }
+
+      if ( startExtID >= maxExtID || num >= maxNum )
+      {
+         goto done ;
+      }
+
+      if ( DMS_SME_ALLOCATED == pSME->getBitMask( startExtID ) )
+      {
+         used = TRUE ;
+      }
+      else
+      {
+         used = FALSE ;
+      }
+      ++num ;
+
+      while ( num < maxNum && startExtID + num < maxExtID )
+      {
+         flag = pSME->getBitMask( startExtID + num ) ;
+
+         if ( ( used && DMS_SME_ALLOCATED != flag ) ||
+              ( !used && DMS_SME_ALLOCATED == flag ) )
+         {
+            break ;
+         }
+         ++num ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _barBkupStream::_backupSU( _dmsStorageBase *pSU,
+                                    const barBackupTask &task,
+                                    _pmdEDUCB *cb )
+   {
+      INT32 rc = SDB_OK ;
+      BSONObj metaObj ;
+      barBackupExtentHeader *pHeader = NULL ;
+      ossValuePtr ptr   = 0 ;
+      UINT32 length     = 0 ;
+      BOOLEAN thinCopy  = FALSE ;
+
+      UINT32 segmentID = 0 ;
+      UINT32 curExtentID = 0 ;
+      UINT32 maxExtNum = BAR_MAX_EXTENT_DATA_SIZE >> pSU->pageSizeSquareRoot() ;
+
+      if ( pSU->dataSize() > ((UINT64)BAR_THINCOPY_THRESHOLD_SIZE << 20 ) )
+      {
+         FLOAT64 ratio = (FLOAT64)pSU->getSMEMgr()->totalFree() /
+                         (FLOAT64)pSU->pageNum() ;
+         if ( ratio >= BAR_THINCOPY_THRESHOLD_RATIO )
+         {
+            thinCopy = TRUE ;
+         }
+      }
+
+      _curOffset = 0 ;
+      UINT32 pos = pSU->begin() ;
+      ossMmapFile::ossMmapSegment *pSegment = NULL ;
+      while ( segmentID < task._endSeg &&
+              NULL != ( pSegment = pSU->next( pos ) ) )
+      {
+         if ( segmentID < task._beginSeg )
+         {
+            _curOffset += pSegment->_length ;
+            ++segmentID ;
+            continue ;
+         }
+
+         if ( cb->isInterrupted() || _pLogger->_isStreamStopped() )
+         {
+            rc = SDB_APP_INTERRUPT ;
+            goto error ;
+         }
+
+         ptr = pSegment->_ptr ;
+         length = pSegment->_length ;
+
+         if ( segmentID < pSU->dataStartSegID() || !thinCopy )
+         {
+            while ( length > 0 )
+            {
+               pHeader = _nextExtent() ;
+               pHeader->_dataSize = length < BAR_MAX_EXTENT_DATA_SIZE ?
+                                    length : BAR_MAX_EXTENT_DATA_SIZE ;
+               metaObj = _makeExtentMeta( pSU->getSuName(),
+                                          pSU->getSuFileName() ) ;
+               pHeader->setMetaData( metaObj.objdata(), metaObj.objsize() ) ;
+
+               rc = _writeExtent( pHeader, (const CHAR *)ptr ) ;
+               PD_RC_CHECK( rc, PDERROR, "Failed to write extent, rc: %d",
+                            rc ) ;
+
+               length -= pHeader->_dataSize ;
+               ptr += pHeader->_dataSize ;
+               _curOffset += pHeader->_dataSize ;
+            }
+         }
+         else
+         {
+            UINT32 num = 0 ;
             BOOLEAN used = FALSE ;
-            UINT32 maxExtID = curExtentID + pSU->segmentPages() ;
+            UINT32 maxExtID = 0 ;
+
+            curExtentID = ( segmentID - pSU->dataStartSegID() ) <<
+                          pSU->segmentPagesSquareRoot() ;
+            maxExtID = curExtentID + pSU->segmentPages() ;
             while ( curExtentID < maxExtID )
             {
                rc = _nextThinCopyInfo( pSU, curExtentID, maxExtID, maxExtNum,
@@ -1663,10 +2054,11 @@ namespace engine
                PD_RC_CHECK( rc, PDERROR, "Failed to get next thin copy info, "
                             "rc: %d", rc ) ;
 
-               pHeader = _nextDataExtent( _curDataType ) ;
+               pHeader = _nextExtent() ;
                pHeader->_dataSize = (UINT64)num << pSU->pageSizeSquareRoot() ;
                pHeader->_thinCopy = used ? 0 : 1 ;
-               metaObj = _makeExtentMeta( pSU ) ;
+               metaObj = _makeExtentMeta( pSU->getSuName(),
+                                          pSU->getSuFileName() ) ;
                pHeader->setMetaData( metaObj.objdata(), metaObj.objsize() ) ;
 
                rc = _writeExtent( pHeader, (const CHAR*)ptr ) ;
@@ -1688,30 +2080,63 @@ namespace engine
       goto done ;
    }
 
-   INT32 _barBKOfflineLogger::_backupLobData( _dmsStorageLob * pLobSU,
-                                              _pmdEDUCB * cb )
+   INT32 _barBkupStream::_readLobData( _dmsStorageLob *pLobSU,
+                                       barBackupExtentHeader *pHeader,
+                                       _pmdEDUCB *cb )
+   {
+      INT32 rc = SDB_OK ;
+      dmsStorageLobData *pLobData = pLobSU->getLobData() ;
+      UINT32 readLen = 0 ;
+
+      rc = pLobData->readRaw( _curOffset, pHeader->_dataSize,
+                              _pExtentBuff, readLen, cb, FALSE ) ;
+      if ( rc )
+      {
+         PD_LOG( PDERROR, "Read lob file[%s, offset: %lld, len: %lld] "
+                 "failed, rc: %d", pLobData->getFileName(),
+                 _curOffset, pHeader->_dataSize, rc ) ;
+         goto error ;
+      }
+      else if ( readLen != pHeader->_dataSize )
+      {
+         rc = SDB_SYS ;
+         PD_LOG( PDERROR, "Read lob file[%s, offset: %lld, len: %lld] "
+                 "failed[readLen: %d], rc: %d",
+                 pLobData->getFileName(), _curOffset,
+                 pHeader->_dataSize, readLen, rc ) ;
+         goto error ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _barBkupStream::_backupLobData( _dmsStorageLob *pLobSU,
+                                         const barBackupTask &task,
+                                         _pmdEDUCB *cb )
    {
       INT32 rc = SDB_OK ;
       BSONObj metaObj ;
       barBackupExtentHeader *pHeader = NULL ;
       BOOLEAN thinCopy  = FALSE ;
       dmsStorageLobData *pLobData = pLobSU->getLobData() ;
-      UINT64 metaLen    = pLobData->getFileSz() - pLobData->getDataSz() ;
-      UINT32 readLen    = 0 ;
+      UINT64 fileSize   = pLobData->getFileSz() ;
+      UINT64 metaLen    = fileSize - pLobData->getDataSz() ;
+      UINT64 endOffset  = metaLen + (UINT64)( task._endSeg - 1 ) *
+                          DMS_SEGMENT_SZ ;
 
       UINT32 curExtentID = 0 ;
       UINT32 maxExtNum = BAR_MAX_EXTENT_DATA_SIZE >>
                          pLobData->pageSizeSquareRoot() ;
 
-      if ( !_pExtentBuff )
+      if ( !_allocBuff( _pExtentBuff, _extentBuffSize,
+                        BAR_MAX_EXTENT_DATA_SIZE ) )
       {
-         _pExtentBuff = ( CHAR* )SDB_OSS_MALLOC( BAR_MAX_EXTENT_DATA_SIZE ) ;
-         if ( !_pExtentBuff )
-         {
-            PD_LOG( PDERROR, "Alloc extent buff failed" ) ;
-            rc = SDB_OOM ;
-            goto error ;
-         }
+         PD_LOG( PDERROR, "Alloc extent buff failed" ) ;
+         rc = SDB_OOM ;
+         goto error ;
       }
 
       if ( (UINT64)pLobData->getDataSz() >
@@ -1725,9 +2150,16 @@ namespace engine
          }
       }
 
-      while ( _curOffset < (UINT64)pLobData->getFileSz() )
+      if ( endOffset > fileSize )
       {
-         if ( cb->isInterrupted() )
+         endOffset = fileSize ;
+      }
+      _curOffset = ( 0 == task._beginSeg ) ? 0 :
+                   metaLen + (UINT64)( task._beginSeg - 1 ) * DMS_SEGMENT_SZ ;
+
+      while ( _curOffset < endOffset )
+      {
+         if ( cb->isInterrupted() || _pLogger->_isStreamStopped() )
          {
             rc = SDB_APP_INTERRUPT ;
             goto error ;
@@ -1743,37 +2175,25 @@ namespace engine
             else
             {
                onceLen = _curOffset + DMS_SEGMENT_SZ ;
-               if ( onceLen > (UINT64)pLobData->getFileSz() )
+               if ( onceLen > endOffset )
                {
-                  onceLen = pLobData->getFileSz() ;
+                  onceLen = endOffset ;
                }
             }
             while ( _curOffset < onceLen )
             {
-               pHeader = _nextDataExtent( _curDataType ) ;
+               pHeader = _nextExtent() ;
                pHeader->_dataSize = onceLen - _curOffset <
                                     BAR_MAX_EXTENT_DATA_SIZE ?
                                     onceLen - _curOffset :
                                     BAR_MAX_EXTENT_DATA_SIZE ;
-               metaObj = _makeExtentMeta( pLobSU ) ;
+               metaObj = _makeExtentMeta( pLobSU->getSuName(),
+                                          pLobData->getFileName() ) ;
                pHeader->setMetaData( metaObj.objdata(), metaObj.objsize() ) ;
 
-               rc = pLobData->readRaw( _curOffset, pHeader->_dataSize,
-                                       _pExtentBuff, readLen, cb, FALSE ) ;
+               rc = _readLobData( pLobSU, pHeader, cb ) ;
                if ( rc )
                {
-                  PD_LOG( PDERROR, "Read lob file[%s, offset: %lld, len: %lld] "
-                          "failed, rc: %d", pLobData->getFileName(),
-                          _curOffset, pHeader->_dataSize, rc ) ;
-                  goto error ;
-               }
-               else if ( readLen != pHeader->_dataSize )
-               {
-                  rc = SDB_SYS ;
-                  PD_LOG( PDERROR, "Read lob file[%s, offset: %lld, len: %lld] "
-                          "failed[readLen: %d], rc: %d",
-                          pLobData->getFileName(), _curOffset,
-                          pHeader->_dataSize, readLen, rc ) ;
                   goto error ;
                }
 
@@ -1788,7 +2208,11 @@ namespace engine
          {
             UINT32 num = 0 ;
             BOOLEAN used = FALSE ;
-            UINT32 maxExtID = curExtentID + pLobSU->segmentPages() ;
+            UINT32 maxExtID = 0 ;
+
+            curExtentID = (UINT32)( ( _curOffset - metaLen ) >>
+                                    pLobData->pageSizeSquareRoot() ) ;
+            maxExtID = curExtentID + pLobSU->segmentPages() ;
             while ( curExtentID < maxExtID )
             {
                rc = _nextThinCopyInfo( pLobSU, curExtentID, maxExtID,
@@ -1796,29 +2220,21 @@ namespace engine
                PD_RC_CHECK( rc, PDERROR, "Failed to get next thin copy info, "
                             "rc: %d", rc ) ;
 
-               pHeader = _nextDataExtent( _curDataType ) ;
+               pHeader = _nextExtent() ;
                pHeader->_dataSize = (UINT64)num << pLobData->pageSizeSquareRoot() ;
                pHeader->_thinCopy = used ? 0 : 1 ;
-               metaObj = _makeExtentMeta( pLobSU ) ;
+               metaObj = _makeExtentMeta( pLobSU->getSuName(),
+                                          pLobData->getFileName() ) ;
                pHeader->setMetaData( metaObj.objdata(), metaObj.objsize() ) ;
 
-               rc = pLobData->readRaw( _curOffset, pHeader->_dataSize,
-                                       _pExtentBuff, readLen, cb, FALSE ) ;
-               if ( rc )
-               {
-                  PD_LOG( PDERROR, "Read lob file[%s, offset: %lld, len: %lld] "
-                          "failed, rc: %d", pLobData->getFileName(),
-                          _curOffset, pHeader->_dataSize, rc ) ;
-                  goto error ;
-               }
-               else if ( readLen != pHeader->_dataSize )
+               // the free pages are not read
+               if ( used )
                {
-                  rc = SDB_SYS ;
-                  PD_LOG( PDERROR, "Read lob file[%s, offset: %lld, len: %lld] "
-                          "failed[readLen: %d], rc: %d",
-                          pLobData->getFileName(), _curOffset,
-                          pHeader->_dataSize, readLen, rc ) ;
-                  goto error ;
+                  rc = _readLobData( pLobSU, pHeader, cb ) ;
+                  if ( rc )
+                  {
+                     goto error ;
+                  }
                }
 
                rc = _writeExtent( pHeader, _pExtentBuff ) ;
@@ -1837,110 +2253,238 @@ namespace engine
       goto done ;
    }
 
-   INT32 _barBKOfflineLogger::_backupLog( pmdEDUCB *cb )
+   barBackupExtentHeader* _barBkupStream::_nextExtent()
+   {
+      _extent.init() ;
+      _extent._dataType = _curDataType ;
+      _extent._extentID = BAR_STREAM_EXTENT_ID( _streamID, ++_extentSeq ) ;
+      return &_extent ;
+   }
+
+   INT32 _barBkupStream::_dedupExtent( barBackupExtentHeader *pHeader,
+                                       const CHAR *pData )
    {
       INT32 rc = SDB_OK ;
-      DPS_LSN lsn ;
-      DPS_LSN_OFFSET oldTransLsn = DPS_INVALID_LSN_OFFSET ;
-      barBackupExtentHeader *pHeader = NULL ;
-      dpsMessageBlock mb( BAR_MAX_EXTENT_DATA_SIZE ) ;
-      BOOLEAN endLoop = FALSE ;
-      const dpsLogRecordHeader *pLastLSN = NULL ;
+      md5::md5digest digest ;
 
-      if ( DPS_INVALID_LSN_OFFSET == _metaHeader._beginLSNOffset )
+      md5::md5( pData, (INT32)pHeader->_dataSize, digest ) ;
+      ossMemcpy( pHeader->_md5Value, digest, BAR_BACKUP_MD5_LEN ) ;
+
+      try
       {
-         goto done ;
+         std::string key( (const CHAR*)digest, BAR_BACKUP_MD5_LEN ) ;
+         key.append( (const CHAR*)&( pHeader->_dataSize ),
+                     sizeof( pHeader->_dataSize ) ) ;
+
+         MAP_DEDUP::iterator it = _mapDedup.find( key ) ;
+         if ( it == _mapDedup.end() )
+         {
+            _mapDedup[ key ] = pHeader->_extentID ;
+         }
+         else
+         {
+            BSONObjBuilder builder ;
+            builder.appendElements( BSONObj( pHeader->getMetaData() ) ) ;
+            builder.append( BAR_REF_EXTENT_ID, (long long)it->second ) ;
+            BSONObj metaObj = builder.obj() ;
+
+            rc = pHeader->setMetaData( metaObj.objdata(),
+                                       metaObj.objsize() ) ;
+            PD_RC_CHECK( rc, PDERROR, "Failed to set meta data of extent, "
+                         "rc: %d", rc ) ;
+            pHeader->_dedup = 1 ;
+         }
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "Occur exception: %s", e.what() ) ;
+         rc = SDB_SYS ;
+         goto error ;
       }
 
-      lsn.offset = _metaHeader._beginLSNOffset ;
-      while ( !endLoop )
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _barBkupStream::_writeExtent( barBackupExtentHeader *pHeader,
+                                       const CHAR *pData )
+   {
+      INT32 rc = SDB_OK ;
+      UINT64 srcDataSize = pHeader->_dataSize ;
+      UINT64 dataLen = 0 ;
+      _utilCompressor *pCompressor = _pLogger->_pCompressor ;
+
+      if ( 0 == pHeader->_thinCopy )
       {
-         if ( cb->isInterrupted() )
+         rc = _dedupExtent( pHeader, pData ) ;
+         if ( rc )
          {
-            rc = SDB_APP_INTERRUPT ;
             goto error ;
          }
+      }
 
-         mb.clear() ;
-
-         while ( mb.length() < BAR_MAX_EXTENT_DATA_SIZE )
+      if ( 0 != pHeader->_thinCopy )
+      {
+         _thinDataSize += srcDataSize ;
+      }
+      else if ( 0 != pHeader->_dedup )
+      {
+         _dedupDataSize += srcDataSize ;
+      }
+      else
+      {
+         if ( _pLogger->_compressed && pCompressor &&
+              srcDataSize >= BAR_COMPRESS_MIN_SIZE &&
+              srcDataSize <= BAR_COMPRSSS_MAX_SIZE )
          {
-            rc = _pDPSCB->search( lsn, &mb ) ;
-            if ( SDB_DPS_LSN_OUTOFRANGE == rc )
+            UINT32 destLen = 0 ;
+            CHAR *pBuff = NULL ;
+
+            if ( SDB_OK == pCompressor->compressBound( srcDataSize, destLen,
+                                                       NULL ) )
             {
-               rc = SDB_OK ;
-               endLoop = TRUE ;
-               break ;
+               pBuff = _allocBuff( _pCompressBuff, _compressBuffSize,
+                                   destLen ) ;
             }
-            else if ( rc )
+            if ( pBuff &&
+                 SDB_OK == pCompressor->compress( pData, srcDataSize, pBuff,
+                                                  destLen, NULL, NULL ) &&
+                 ( (FLOAT64)destLen / srcDataSize ) <=
+                 BAR_COMPRESS_RATIO_THRESHOLD )
             {
-               DPS_LSN fileBegin ;
-               DPS_LSN memBegin ;
-               DPS_LSN endLsn ;
-               DPS_LSN expectLsn ;
-               _pDPSCB->getLsnWindow( fileBegin, memBegin, endLsn,
-                                      &expectLsn, NULL ) ;
-               PD_LOG( PDERROR, "Failed to search lsn[%u,%lld] in "
-                       "log[FileBeginLsn:%lld, MemBeginLsn:%lld, EndLsn:%lld,"
-                       "ExpectLsn:%lld], rc: %d", lsn.version, lsn.offset,
-                       fileBegin.offset, memBegin.offset, endLsn.offset,
-                       expectLsn.offset, rc ) ;
-               goto error ;
-            }
-            pLastLSN = (const dpsLogRecordHeader*)mb.readPtr() ;
-            mb.readPtr( mb.length() ) ;
-            lsn.offset += pLastLSN->_length ;
-            lsn.version = pLastLSN->_version ;
-         }
+               _compressDataSize += ( srcDataSize - destLen ) ;
 
-         oldTransLsn = _pTransCB->getOldestBeginLsn() ;
-         if ( 0 == mb.length() )
-         {
-            break ;
+               pHeader->_compressed = 1 ;
+               pHeader->_dataSize = destLen ;
+               pData = pBuff ;
+            }
          }
+         dataLen = pHeader->_dataSize ;
+      }
 
-         pHeader = _nextDataExtent( BAR_DATA_TYPE_REPL_LOG ) ;
-         pHeader->_dataSize = mb.length() ;
-
-         rc = _writeExtent( pHeader, mb.startPtr() ) ;
-         PD_RC_CHECK( rc, PDERROR, "Failed to write extent, rc: %d", rc ) ;
+      if ( _isOpened && _curFileSize + BAR_BACKUP_EXTENT_HEADER_SIZE +
+           dataLen > _pLogger->_metaHeader._maxDataFileSize )
+      {
+         _closeDataFile() ;
       }
 
-      if ( lsn.compareOffset( _metaHeader._endLSNOffset ) < 0 )
+      rc = _writeData( (const CHAR*)pHeader, BAR_BACKUP_EXTENT_HEADER_SIZE ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to write extent header, rc: %d",
+                   rc ) ;
+
+      if ( dataLen > 0 )
       {
-         PD_LOG( PDWARNING, "Real end lsn[%u,%llu] is smaller than expect "
-                 "end lsn[%llu]", lsn.version, lsn.offset,
-                 _metaHeader._endLSNOffset ) ;
-         _metaHeader._endLSNOffset = lsn.offset ;
+         rc = _writeData( pData, dataLen ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to write extent data, rc: %d",
+                      rc ) ;
       }
-      else if ( lsn.compareOffset( _metaHeader._endLSNOffset ) > 0 )
+
+   done:
+      pHeader->_dataSize = srcDataSize ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _barBkupStream::_writeData( const CHAR *buf, UINT64 len )
+   {
+      INT32 rc = SDB_OK ;
+
+      if ( !_isOpened )
       {
-         PD_LOG( PDINFO, "Real end lsn[%u,%llu] is grater than expect "
-                 "end lsn[%llu]", lsn.version, lsn.offset,
-                 _metaHeader._endLSNOffset ) ;
-         _metaHeader._endLSNOffset = lsn.offset ;
+         rc = _openDataFile() ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to open data file, rc: %d", rc ) ;
       }
-      if ( oldTransLsn != _metaHeader._transLSNOffset )
+
+      rc = _pLogger->_flush( _file, buf, len ) ;
+      if ( rc )
       {
-         PD_LOG( PDWARNING, "Old trans lsn[%lld] is not the same with "
-                 "expect trans lsn[%lld]", oldTransLsn,
-                 _metaHeader._transLSNOffset ) ;
-         _metaHeader._transLSNOffset = oldTransLsn ;
+         goto error ;
       }
+      _curFileSize += len ;
+      _dataSize += len ;
 
-      if ( pLastLSN )
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _barBkupStream::_openDataFile()
+   {
+      INT32 rc = SDB_OK ;
+      barBackupDataHeader *pHeader = NULL ;
+      UINT32 sequence = _pLogger->_allocDataSequence() ;
+      string fileName = _pLogger->getDataFileName( sequence ) ;
+
+      rc = ossOpen( fileName.c_str(), OSS_REPLACE | OSS_READWRITE,
+                    OSS_RU | OSS_WU | OSS_RG, _file ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to open file[%s], rc: %d",
+                   fileName.c_str(), rc ) ;
+      _isOpened = TRUE ;
+
+      pHeader = SDB_OSS_NEW barBackupDataHeader ;
+      if ( !pHeader )
       {
-         _metaHeader._lastLSN = pLastLSN->_lsn ;
-         _metaHeader._lastLSNCode = ossHash( (const CHAR*)pLastLSN,
-                                             pLastLSN->_length ) ;
+         PD_LOG( PDERROR, "Failed to alloc memory for backup data header" ) ;
+         rc = SDB_OOM ;
+         goto error ;
       }
 
+      pHeader->_secretValue   = _pLogger->_metaHeader._secretValue ;
+      pHeader->_sequence      = sequence ;
+      pHeader->_compressionType = _pLogger->_metaHeader._compressionType ;
+      pHeader->_streamID      = _streamID ;
+
+      rc = _pLogger->_flush( _file, (const CHAR *)pHeader,
+                             BAR_BACKUPDATA_HEADER_SIZE ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to write header to file[%s], rc: %d",
+                   fileName.c_str(), rc ) ;
+
+      _curFileSize = BAR_BACKUPDATA_HEADER_SIZE ;
+      _dataSize += BAR_BACKUPDATA_HEADER_SIZE ;
+
    done:
+      if ( pHeader )
+      {
+         SDB_OSS_DEL pHeader ;
+      }
       return rc ;
    error:
       goto done ;
    }
 
+   void _barBkupStream::_closeDataFile()
+   {
+      if ( _isOpened )
+      {
+         ossClose( _file ) ;
+         _isOpened = FALSE ;
+      }
+   }
+
+   CHAR* _barBkupStream::_allocBuff( CHAR *&pBuff, UINT64 &buffSize,
+                                     UINT64 size )
+   {
+      if ( size > buffSize )
+      {
+         if ( pBuff )
+         {
+            SDB_OSS_FREE( pBuff ) ;
+            pBuff = NULL ;
+            buffSize = 0 ;
+         }
+         pBuff = ( CHAR* )SDB_OSS_MALLOC( size ) ;
+         if ( pBuff )
+         {
+            buffSize = size ;
+         }
+      }
+      return pBuff ;
+   }
+
    /*
       _barRSBaseLogger implement
    */
@@ -2018,26 +2562,9 @@ namespace engine
       {
          return SDB_OK ;
       }
-      ++_curDataFileSeq ;
+      INT32 rc = SDB_OK ;
       barBackupDataHeader *pHeader = NULL ;
-      string fileName = getDataFileName( _curDataFileSeq ) ;
-
-      if ( _isDoRestoring )
-      {
-         std::cout << "Begin to restore data file: " << fileName.c_str()
-                   << " ..." << std::endl ;
-         PD_LOG( PDEVENT, "Begin to restore data file[%s]", fileName.c_str() ) ;
-      }
-
-      INT32 rc = ossOpen( fileName.c_str(), OSS_READONLY,
-                          OSS_RU | OSS_WU | OSS_RG, _curFile ) ;
-      if ( rc )
-      {
-         PD_LOG( PDERROR, "Failed to open file[%s], rc: %d", fileName.c_str(),
-                 rc ) ;
-         goto error ;
-      }
-      _isOpened = TRUE ;
+      string fileName ;
 
       pHeader = SDB_OSS_NEW barBackupDataHeader ;
       if ( !pHeader )
@@ -2047,11 +2574,45 @@ namespace engine
          goto error ;
       }
 
-      rc = _readDataHeader( _curFile, fileName, pHeader, TRUE, _secretValue,
-                            _curDataFileSeq ) ;
-      if ( rc )
+      while ( TRUE )
       {
-         goto error ;
+         if ( _curDataFileSeq >= _metaHeader._lastDataSequence )
+         {
+            rc = SDB_EOF ;
+            goto error ;
+         }
+         ++_curDataFileSeq ;
+         fileName = getDataFileName( _curDataFileSeq ) ;
+
+         rc = ossOpen( fileName.c_str(), OSS_READONLY,
+                       OSS_RU | OSS_WU | OSS_RG, _curFile ) ;
+         if ( rc )
+         {
+            PD_LOG( PDERROR, "Failed to open file[%s], rc: %d",
+                    fileName.c_str(), rc ) ;
+            goto error ;
+         }
+         _isOpened = TRUE ;
+
+         rc = _readDataHeader( _curFile, fileName, pHeader, TRUE,
+                               _secretValue, _curDataFileSeq ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         if ( 0 == pHeader->_streamID )
+         {
+            break ;
+         }
+         // the files of the streams are restored by the streams
+         _closeCurFile() ;
+      }
+
+      if ( _isDoRestoring )
+      {
+         std::cout << "Begin to restore data file: " << fileName.c_str()
+                   << " ..." << std::endl ;
+         PD_LOG( PDEVENT, "Begin to restore data file[%s]", fileName.c_str() ) ;
       }
       _curOffset = BAR_BACKUPDATA_HEADER_SIZE ;
       _pCompressor = getCompressorByType(
@@ -2395,7 +2956,14 @@ namespace engine
 
       if ( _expectExtID > _metaHeader._lastExtentID )
       {
-         if ( _curDataFileSeq != _metaHeader._lastDataSequence )
+         // only the files of the streams can be left
+         _closeCurFile() ;
+         rc = _openDataFile() ;
+         if ( SDB_EOF == rc )
+         {
+            rc = SDB_OK ;
+         }
+         else if ( SDB_OK == rc )
          {
             PD_LOG( PDERROR, "Invalid backup file, expect extent id: %llu, "
                     "meta header last extent id: %llu, cur file seq: %d, meta "
@@ -2538,6 +3106,7 @@ namespace engine
       _openedSU         = FALSE ;
       _incDataFileBeginSeq = (UINT32)-1 ;
       _hasLoadDMS       = FALSE ;
+      _streamPos        = 0 ;
    }
 
    _barRSOfflineLogger::~_barRSOfflineLogger ()
@@ -2764,6 +3333,12 @@ namespace engine
       BOOLEAN restoreDPS = FALSE ;
       BOOLEAN restoreInc = FALSE ;
 
+      if ( 0 == _beginID )
+      {
+         rc = _restoreStreams( cb ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to restore streams, rc: %d", rc ) ;
+      }
+
       while ( TRUE )
       {
          if ( cb->isInterrupted() )
@@ -2871,19 +3446,124 @@ namespace engine
       goto done ;
    }
 
-   INT32 _barRSOfflineLogger::_processConfigData( barBackupExtentHeader * pExtHeader,
-                                                  const CHAR * pData )
-   {
-      return SDB_OK ;
-   }
-
-   INT32 _barRSOfflineLogger::_processRawData( barBackupExtentHeader * pExtHeader,
-                                               const CHAR * pData )
+   INT32 _barRSOfflineLogger::_restoreStreams( _pmdEDUCB *cb )
    {
-      return _writeSU( pExtHeader, pData ) ;
-   }
+      INT32 rc = SDB_OK ;
+      UINT32 streamNum = 0 ;
+      UINT32 beginSeq = 0 ;
+      barBackupHeader *pHeader = NULL ;
+      barBackupDataHeader *pDataHeader = NULL ;
 
-   INT32 _barRSOfflineLogger::_processRawIndex( barBackupExtentHeader * pExtHeader,
+      pHeader = SDB_OSS_NEW barBackupHeader ;
+      pDataHeader = SDB_OSS_NEW barBackupDataHeader ;
+      if ( !pHeader || !pDataHeader )
+      {
+         PD_LOG( PDERROR, "Alloc backup header failed" ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+
+      rc = _readMetaHeader( 0, pHeader, TRUE, _secretValue ) ;
+      PD_RC_CHECK( rc, PDERROR, "Read meta header[Name:%s,ID:0] failed, "
+                   "rc: %d", backupName(), rc ) ;
+
+      streamNum = pHeader->_streamNum ;
+      if ( 0 == streamNum )
+      {
+         goto done ;
+      }
+      else if ( streamNum > BAR_MAX_STREAM_NUM )
+      {
+         PD_LOG( PDERROR, "Invalid stream num[%u] in meta header", streamNum ) ;
+         rc = SDB_BAR_DAMAGED_BK_FILE ;
+         goto error ;
+      }
+
+      _streamFiles.clear() ;
+      _streamFiles.resize( streamNum ) ;
+      _streamLastExtentIDs.assign( pHeader->_streamLastExtentID,
+                                   pHeader->_streamLastExtentID + streamNum ) ;
+
+      beginSeq = pHeader->_lastDataSequence - pHeader->_dataFileNum + 1 ;
+      for ( UINT32 seq = beginSeq ; seq <= pHeader->_lastDataSequence ; ++seq )
+      {
+         rc = _readDataHeader( seq, pDataHeader, TRUE, _secretValue ) ;
+         PD_RC_CHECK( rc, PDERROR, "Read data header[%u] failed, rc: %d",
+                      seq, rc ) ;
+
+         if ( 0 == pDataHeader->_streamID )
+         {
+            continue ;
+         }
+         else if ( pDataHeader->_streamID > streamNum )
+         {
+            PD_LOG( PDERROR, "Invalid stream id[%u] of data file[%u], stream "
+                    "num: %u", pDataHeader->_streamID, seq, streamNum ) ;
+            rc = SDB_BAR_DAMAGED_BK_FILE ;
+            goto error ;
+         }
+         _streamFiles[ pDataHeader->_streamID - 1 ].push_back( seq ) ;
+      }
+      _streamPos = 0 ;
+
+      PD_LOG( PDEVENT, "Begin to restore storages by %u streams...",
+              streamNum ) ;
+      std::cout << "Begin to restore storages by " << streamNum
+                << " streams..." << std::endl ;
+
+      rc = _runStreams( streamNum, cb ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to restore storages by streams, "
+                   "rc: %d", rc ) ;
+
+   done:
+      if ( pHeader )
+      {
+         SDB_OSS_DEL pHeader ;
+      }
+      if ( pDataHeader )
+      {
+         SDB_OSS_DEL pDataHeader ;
+      }
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _barRSOfflineLogger::_runStream( _pmdEDUCB *cb )
+   {
+      UINT32 streamID = 0 ;
+
+      _streamLatch.get() ;
+      if ( _streamPos < _streamFiles.size() )
+      {
+         streamID = ++_streamPos ;
+      }
+      _streamLatch.release() ;
+
+      if ( 0 == streamID )
+      {
+         PD_LOG( PDERROR, "No restore stream to run" ) ;
+         return SDB_SYS ;
+      }
+
+      barRSStream stream( this, streamID ) ;
+      return stream.restore( _streamFiles[ streamID - 1 ],
+                             _streamLastExtentIDs[ streamID - 1 ], cb ) ;
+   }
+
+   INT32 _barRSOfflineLogger::_processConfigData( barBackupExtentHeader * pExtHeader,
+                                                  const CHAR * pData )
+   {
+      return SDB_OK ;
+   }
+
+   INT32 _barRSOfflineLogger::_processRawData( barBackupExtentHeader * pExtHeader,
+                                               const CHAR * pData )
+   {
+      return _writeSU( pExtHeader, pData ) ;
+   }
+
+   INT32 _barRSOfflineLogger::_processRawIndex( barBackupExtentHeader * pExtHeader,
                                                 const CHAR * pData )
    {
       return _writeSU( pExtHeader, pData ) ;
@@ -2988,22 +3668,7 @@ namespace engine
          _closeSUFile() ;
       }
 
-      if ( BAR_DATA_TYPE_RAW_DATA == pExtHeader->_dataType )
-      {
-         path = _pOptCB->getDbPath() ;
-      }
-      else if ( BAR_DATA_TYPE_RAW_IDX == pExtHeader->_dataType )
-      {
-         path = _pOptCB->getIndexPath() ;
-      }
-      else if ( BAR_DATA_TYPE_RAW_LOBD == pExtHeader->_dataType )
-      {
-         path = _pOptCB->getLobPath() ;
-      }
-      else
-      {
-         path = _pOptCB->getLobMetaPath() ;
-      }
+      path = _getSUPath( pExtHeader->_dataType ) ;
 
       rc = _openSUFile( path, suName, suFileName, sequence  ) ;
       PD_RC_CHECK( rc, PDERROR, "Failed to open su file[%s], rc: %d",
@@ -3028,6 +3693,23 @@ namespace engine
       goto done ;
    }
 
+   string _barRSOfflineLogger::_getSUPath( UINT32 dataType )
+   {
+      if ( BAR_DATA_TYPE_RAW_DATA == dataType )
+      {
+         return _pOptCB->getDbPath() ;
+      }
+      else if ( BAR_DATA_TYPE_RAW_IDX == dataType )
+      {
+         return _pOptCB->getIndexPath() ;
+      }
+      else if ( BAR_DATA_TYPE_RAW_LOBD == dataType )
+      {
+         return _pOptCB->getLobPath() ;
+      }
+      return _pOptCB->getLobMetaPath() ;
+   }
+
    INT32 _barRSOfflineLogger::_openSUFile( const string &path,
                                            const string & suName,
                                            const string & suFileName,
@@ -3092,6 +3774,448 @@ namespace engine
       goto done ;
    }
 
+   /*
+      _barRSStream implement
+   */
+   _barRSStream::_barRSStream( _barRSOfflineLogger *pLogger,
+                               UINT32 streamID )
+   {
+      _pLogger          = pLogger ;
+      _streamID         = streamID ;
+      _expectExtID      = BAR_STREAM_EXTENT_ID( streamID, 1 ) ;
+      _pCompressor      = NULL ;
+
+      _isOpened         = FALSE ;
+      _curDataFileSeq   = 0 ;
+      _openedSU         = FALSE ;
+
+      _pBuff            = NULL ;
+      _buffSize         = 0 ;
+      _pUncompBuff      = NULL ;
+      _uncompBuffSize   = 0 ;
+   }
+
+   _barRSStream::~_barRSStream()
+   {
+      _closeDataFile() ;
+      _closeSUFile() ;
+      if ( _pBuff )
+      {
+         SDB_OSS_FREE( _pBuff ) ;
+         _pBuff = NULL ;
+      }
+      if ( _pUncompBuff )
+      {
+         SDB_OSS_FREE( _pUncompBuff ) ;
+         _pUncompBuff = NULL ;
+      }
+   }
+
+   INT32 _barRSStream::restore( const std::vector< UINT32 > &sequences,
+                                UINT64 lastExtentID,
+                                _pmdEDUCB *cb )
+   {
+      INT32 rc = SDB_OK ;
+      const CHAR *pData = NULL ;
+
+      for ( UINT32 i = 0 ; i < sequences.size() ; ++i )
+      {
+         rc = _openDataFile( sequences[ i ] ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+
+         while ( TRUE )
+         {
+            if ( cb->isInterrupted() || _pLogger->_isStreamStopped() )
+            {
+               rc = SDB_APP_INTERRUPT ;
+               goto error ;
+            }
+
+            rc = _readExtent( &pData ) ;
+            if ( SDB_EOF == rc )
+            {
+               rc = SDB_OK ;
+               break ;
+            }
+            else if ( rc )
+            {
+               goto error ;
+            }
+
+            rc = _writeSU( pData ) ;
+            if ( rc )
+            {
+               goto error ;
+            }
+         }
+         _closeDataFile() ;
+      }
+
+      if ( _expectExtID != lastExtentID + 1 )
+      {
+         PD_LOG( PDERROR, "Stream[%u] expect extent id[%llu] is not the next "
+                 "of the last extent id[%llu]", _streamID, _expectExtID,
+                 lastExtentID ) ;
+         rc = SDB_BAR_DAMAGED_BK_FILE ;
+         goto error ;
+      }
+
+   done:
+      _closeSUFile() ;
+      _closeDataFile() ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _barRSStream::_openDataFile( UINT32 sequence )
+   {
+      INT32 rc = SDB_OK ;
+      barBackupDataHeader *pHeader = NULL ;
+      string fileName = _pLogger->getDataFileName( sequence ) ;
+
+      rc = ossOpen( fileName.c_str(), OSS_READONLY,
+                    OSS_RU | OSS_WU | OSS_RG, _file ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to open file[%s], rc: %d",
+                   fileName.c_str(), rc ) ;
+      _isOpened = TRUE ;
+      _curDataFileSeq = sequence ;
+
+      pHeader = SDB_OSS_NEW barBackupDataHeader ;
+      if ( !pHeader )
+      {
+         PD_LOG( PDERROR, "Failed to alloc memory for backup data header" ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+
+      rc = _pLogger->_readDataHeader( _file, fileName, pHeader, TRUE,
+                                      _pLogger->_secretValue, sequence ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+      else if ( pHeader->_streamID != _streamID )
+      {
+         PD_LOG( PDERROR, "Stream id[%u] of file[%s] is not expect[%u]",
+                 pHeader->_streamID, fileName.c_str(), _streamID ) ;
+         rc = SDB_BAR_DAMAGED_BK_FILE ;
+         goto error ;
+      }
+      _pCompressor = getCompressorByType(
+         (UTIL_COMPRESSOR_TYPE)pHeader->_compressionType ) ;
+
+      PD_LOG( PDEVENT, "Stream[%u] begin to restore data file[%s]",
+              _streamID, fileName.c_str() ) ;
+      std::cout << "Begin to restore data file: " << fileName.c_str()
+                << " ..." << std::endl ;
+
+   done:
+      if ( pHeader )
+      {
+         SDB_OSS_DEL pHeader ;
+      }
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   void _barRSStream::_closeDataFile()
+   {
+      if ( _isOpened )
+      {
+         ossClose( _file ) ;
+         _isOpened = FALSE ;
+      }
+   }
+
+   INT32 _barRSStream::_readExtent( const CHAR **ppData )
+   {
+      INT32 rc = SDB_OK ;
+      *ppData = NULL ;
+
+      rc = _pLogger->_read( _file, (CHAR*)&_extent,
+                            BAR_BACKUP_EXTENT_HEADER_SIZE ) ;
+      if ( SDB_EOF == rc )
+      {
+         goto error ;
+      }
+      PD_RC_CHECK( rc, PDERROR, "Failed to read data extent header, data "
+                   "seq: %u, expect extent id: %llu, rc: %d", _curDataFileSeq,
+                   _expectExtID, rc ) ;
+
+      if ( 0 != ossStrncmp( _extent._eyeCatcher, BAR_EXTENT_EYECATCH,
+                           BAR_BACKUP_HEADER_EYECATCHER_LEN ) )
+      {
+         PD_LOG( PDERROR, "Extent eyecatcher[%s] is invalid, data seq: %u",
+                 _extent._eyeCatcher, _curDataFileSeq ) ;
+         rc = SDB_BAR_DAMAGED_BK_FILE ;
+         goto error ;
+      }
+      else if ( _extent._extentID != _expectExtID )
+      {
+         PD_LOG( PDERROR, "Extent id[%llu] is not expect[%llu], data seq: %u",
+                 _extent._extentID, _expectExtID, _curDataFileSeq ) ;
+         rc = SDB_BAR_DAMAGED_BK_FILE ;
+         goto error ;
+      }
+      ++_expectExtID ;
+
+      if ( 0 == _extent._dataSize )
+      {
+         goto done ;
+      }
+      else if ( 0 != _extent._dedup )
+      {
+         rc = _readRefExtent( ppData ) ;
+         goto done ;
+      }
+      else if ( !_allocBuff( _pBuff, _buffSize, _extent._dataSize ) )
+      {
+         PD_LOG( PDERROR, "Failed to alloc memory, size: %llu",
+                 _extent._dataSize ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+
+      if ( 0 != _extent._thinCopy )
+      {
+         ossMemset( _pBuff, 0, _extent._dataSize ) ;
+         *ppData = _pBuff ;
+         goto done ;
+      }
+
+      rc = _pLogger->_read( _file, _pBuff, _extent._dataSize ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to read extent data, data seq: %u, "
+                   "rc: %d", _curDataFileSeq, rc ) ;
+
+      if ( 0 != _extent._compressed )
+      {
+         UINT32 destLen = BAR_MAX_EXTENT_DATA_SIZE ;
+         UINT32 unCompLen = 0 ;
+
+         if ( !_pCompressor )
+         {
+            PD_LOG( PDERROR, "Compressor is NULL" ) ;
+            rc = SDB_SYS ;
+            goto error ;
+         }
+         rc = _pCompressor->getUncompressedLen( _pBuff, _extent._dataSize,
+                                                unCompLen ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to get uncompressed length, "
+                      "rc: %d", rc ) ;
+
+         if ( unCompLen > destLen )
+         {
+            destLen = unCompLen ;
+         }
+         if ( !_allocBuff( _pUncompBuff, _uncompBuffSize, destLen ) )
+         {
+            PD_LOG( PDERROR, "Alloc uncompressed buffer failed" ) ;
+            rc = SDB_OOM ;
+            goto error ;
+         }
+         rc = _pCompressor->decompress( _pBuff, _extent._dataSize,
+                                        _pUncompBuff, destLen, NULL ) ;
+         PD_RC_CHECK( rc, PDERROR, "Uncompress data failed, rc: %d", rc ) ;
+
+         _extent._dataSize = destLen ;
+         *ppData = _pUncompBuff ;
+      }
+      else
+      {
+         *ppData = _pBuff ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _barRSStream::_readRefExtent( const CHAR **ppData )
+   {
+      INT32 rc = SDB_OK ;
+      UINT64 refExtentID = 0 ;
+      MAP_EXTENT_LOC::iterator it ;
+      OSSFILE file ;
+      BOOLEAN isOpened = FALSE ;
+      SINT64 readLen = 0 ;
+
+      try
+      {
+         BSONObj metaObj( _extent.getMetaData() ) ;
+         BSONElement ele = metaObj.getField( BAR_REF_EXTENT_ID ) ;
+         if ( ele.type() != NumberLong )
+         {
+            PD_LOG( PDERROR, "Field[%s] type[%d] error in [%s]",
+                    BAR_REF_EXTENT_ID, ele.type(),
+                    metaObj.toString().c_str() ) ;
+            rc = SDB_BAR_DAMAGED_BK_FILE ;
+            goto error ;
+         }
+         refExtentID = (UINT64)ele.numberLong() ;
+      }
+      catch( std::exception &e )
+      {
+         PD_LOG( PDERROR, "Occur exception when get meta obj: %s", e.what() ) ;
+         rc = SDB_BAR_DAMAGED_BK_FILE ;
+         goto error ;
+      }
+
+      it = _mapExtentLoc.find( refExtentID ) ;
+      if ( it == _mapExtentLoc.end() )
+      {
+         PD_LOG( PDERROR, "The referenced extent[%llu] of extent[%llu] is "
+                 "not restored", refExtentID, _extent._extentID ) ;
+         rc = SDB_BAR_DAMAGED_BK_FILE ;
+         goto error ;
+      }
+
+      if ( !_allocBuff( _pBuff, _buffSize, _extent._dataSize ) )
+      {
+         PD_LOG( PDERROR, "Failed to alloc memory, size: %llu",
+                 _extent._dataSize ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+
+      // the referenced extent has been restored, read it back
+      rc = ossOpen( it->second._pathName.c_str(), OSS_READONLY,
+                    OSS_RU | OSS_WU | OSS_RG, file ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to open su file[%s], rc: %d",
+                   it->second._pathName.c_str(), rc ) ;
+      isOpened = TRUE ;
+
+      rc = ossSeekAndReadN( &file, it->second._offset, _extent._dataSize,
+                            _pBuff, readLen ) ;
+      if ( SDB_OK == rc && (UINT64)readLen != _extent._dataSize )
+      {
+         rc = SDB_BAR_DAMAGED_BK_FILE ;
+      }
+      PD_RC_CHECK( rc, PDERROR, "Failed to read the referenced extent from "
+                   "su file[%s, offset: %llu, len: %llu], rc: %d",
+                   it->second._pathName.c_str(), it->second._offset,
+                   _extent._dataSize, rc ) ;
+
+      *ppData = _pBuff ;
+
+   done:
+      if ( isOpened )
+      {
+         ossClose( file ) ;
+      }
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _barRSStream::_writeSU( const CHAR *pData )
+   {
+      INT32 rc = SDB_OK ;
+      string suName ;
+      string suFileName ;
+      string pathName ;
+      UINT32 sequence = 0 ;
+      UINT64 offset = 0 ;
+      SINT64 written = 0 ;
+
+      rc = _pLogger->_parseExtentMeta( &_extent, suName, suFileName,
+                                       sequence, offset ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+
+      pathName = rtnFullPathName( _pLogger->_getSUPath( _extent._dataType ),
+                                  suFileName ) ;
+      if ( _openedSU && pathName != _suPathName )
+      {
+         _closeSUFile() ;
+      }
+      if ( !_openedSU )
+      {
+         rc = _openSUFile( pathName ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+      }
+
+      if ( _extent._dataSize > 0 )
+      {
+         rc = ossSeekAndWriteN( &_suFile, offset, pData, _extent._dataSize,
+                                written ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to write data to file[%s, offset: "
+                      "%llu], rc: %d", pathName.c_str(), offset, rc ) ;
+      }
+
+      if ( 0 == _extent._thinCopy && 0 == _extent._dedup )
+      {
+         _extentLoc &loc = _mapExtentLoc[ _extent._extentID ] ;
+         loc._pathName = pathName ;
+         loc._offset = offset ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _barRSStream::_openSUFile( const std::string &pathName )
+   {
+      INT32 rc = SDB_OK ;
+
+      rc = ossOpen( pathName.c_str(), OSS_CREATE | OSS_READWRITE,
+                    OSS_RU | OSS_WU | OSS_RG, _suFile ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to open su file[%s], rc: %d",
+                   pathName.c_str(), rc ) ;
+      _openedSU = TRUE ;
+      _suPathName = pathName ;
+
+      PD_LOG( PDDEBUG, "Stream[%u] begin to restore su file[%s]", _streamID,
+              pathName.c_str() ) ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   void _barRSStream::_closeSUFile()
+   {
+      if ( _openedSU )
+      {
+         ossClose( _suFile ) ;
+         _openedSU = FALSE ;
+         _suPathName = "" ;
+      }
+   }
+
+   CHAR* _barRSStream::_allocBuff( CHAR *&pBuff, UINT64 &buffSize,
+                                   UINT64 size )
+   {
+      if ( size > buffSize )
+      {
+         if ( pBuff )
+         {
+            SDB_OSS_FREE( pBuff ) ;
+            pBuff = NULL ;
+            buffSize = 0 ;
+         }
+         pBuff = ( CHAR* )SDB_OSS_MALLOC( size ) ;
+         if ( pBuff )
+         {
+            buffSize = size ;
+         }
+      }
+      return pBuff ;
+   }
+
    /*
       _barBackupMgr implement
    */
@@ -3345,9 +4469,12 @@ namespace engine
          builder.append( "ThinDataSize", (INT64)pHeader->_thinDataSize ) ;
          builder.append( "CompressedDataSize",
                          (INT64)pHeader->_compressDataSize ) ;
+         builder.append( "DedupDataSize", (INT64)pHeader->_dedupDataSize ) ;
+         builder.append( FIELD_NAME_STREAM_NUM, (INT32)pHeader->_streamNum ) ;
 
          UINT64 totalSize = pHeader->_dataSize + pHeader->_thinDataSize +
-                            pHeader->_compressDataSize ;
+                            pHeader->_compressDataSize +
+                            pHeader->_dedupDataSize ;
          INT32 ratio = (INT32)((FLOAT64)(pHeader->_dataSize*100)/totalSize) ;
          builder.append( "CompressedRatio", ratio ) ;
 
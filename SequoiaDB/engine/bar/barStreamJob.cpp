@@ -0,0 +1,98 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = barStreamJob.cpp
+
+   Descriptive Name = Backup And Restore Stream Job
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of backup and restore component. This file contains the
+   background job which runs a stream of the backup or the restore.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#include "barStreamJob.hpp"
+#include "pd.hpp"
+
+namespace engine
+{
+
+   /*
+      _barStreamJob implement
+   */
+   _barStreamJob::_barStreamJob( barBaseLogger *pLogger )
+   {
+      _pLogger = pLogger ;
+   }
+
+   _barStreamJob::~_barStreamJob ()
+   {
+      _pLogger = NULL ;
+   }
+
+   RTN_JOB_TYPE _barStreamJob::type() const
+   {
+      return RTN_JOB_BAR_STREAM ;
+   }
+
+   const CHAR *_barStreamJob::name() const
+   {
+      return "BarStream" ;
+   }
+
+   BOOLEAN _barStreamJob::muteXOn( const _rtnBaseJob *pOther )
+   {
+      return FALSE ;
+   }
+
+   INT32 _barStreamJob::doit ()
+   {
+      return _pLogger->runStream( eduCB() ) ;
+   }
+
+   INT32 startStreamJob( barBaseLogger *pLogger, EDUID *pEDUID )
+   {
+      INT32 rc                = SDB_OK ;
+      barStreamJob *pJob      = NULL ;
+
+      pJob = SDB_OSS_NEW barStreamJob( pLogger ) ;
+      if ( !pJob )
+      {
+         rc = SDB_OOM ;
+         PD_LOG( PDERROR, "Allocate failed" ) ;
+         goto error ;
+      }
+      rc = rtnGetJobMgr()->startJob( pJob, RTN_JOB_MUTEX_NONE, pEDUID ) ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+}
+
@@ -0,0 +1,230 @@
+/*******************************************************************************
+
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = bpsReadAhead.cpp
+
+   Descriptive Name = Buffer Pool Service Read Ahead
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of BPS component. This file contains functions for the scan
+   read ahead.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+#include "bpsReadAhead.hpp"
+#include "bps.hpp"
+#include "pmd.hpp"
+#include "dmsStorageBase.hpp"
+#include "msgDef.h"
+
+namespace engine
+{
+
+   /*
+      _bpsReadAheadStat implement
+   */
+   void _bpsReadAheadStat::toBSON( BSONObjBuilder &builder ) const
+   {
+      builder.append( FIELD_NAME_RA_ISSUE_NUM, (INT64)_issueNum.peek() ) ;
+      builder.append( FIELD_NAME_RA_ISSUE_PAGES, (INT64)_issuePages.peek() ) ;
+      builder.append( FIELD_NAME_RA_HIT_NUM, (INT64)_hitNum.peek() ) ;
+      builder.append( FIELD_NAME_RA_MISS_NUM, (INT64)_missNum.peek() ) ;
+      builder.append( FIELD_NAME_RA_WASTED_PAGES,
+                      (INT64)_wastedPages.peek() ) ;
+   }
+
+   /*
+      _bpsReadAhead implement
+   */
+   _bpsReadAhead::_bpsReadAhead()
+   {
+      _su            = NULL ;
+      _lastExtent    = DMS_INVALID_EXTENT ;
+      _nextExtent    = DMS_INVALID_EXTENT ;
+      _raBegin       = 0 ;
+      _raEnd         = 0 ;
+      _seqNum        = 0 ;
+      _window        = 0 ;
+      _consumed      = 0 ;
+      _lastIssueTime = 0 ;
+   }
+
+   _bpsReadAhead::~_bpsReadAhead()
+   {
+      reset() ;
+   }
+
+   void _bpsReadAhead::reset()
+   {
+      if ( _su && _raEnd > _raBegin && _raEnd > _nextExtent )
+      {
+         bpsReadAheadStat *pStat =
+            pmdGetKRCB()->getBPSCB()->getReadAheadStat() ;
+         pStat->_wastedPages.add( _raEnd - OSS_MAX( _raBegin,
+                                                    _nextExtent ) ) ;
+      }
+
+      _su            = NULL ;
+      _lastExtent    = DMS_INVALID_EXTENT ;
+      _nextExtent    = DMS_INVALID_EXTENT ;
+      _raBegin       = 0 ;
+      _raEnd         = 0 ;
+      _seqNum        = 0 ;
+      _window        = 0 ;
+      _consumed      = 0 ;
+      _lastIssueTime = 0 ;
+   }
+
+   void _bpsReadAhead::onAccess( _dmsStorageBase *su, dmsExtentID extentID,
+                                 UINT32 pageNum )
+   {
+      BOOLEAN missed = FALSE ;
+      dmsExtentID endExtent = DMS_INVALID_EXTENT ;
+      bpsReadAheadStat *pStat = NULL ;
+
+      if ( DMS_INVALID_EXTENT == extentID || 0 == pageNum )
+      {
+         return ;
+      }
+      else if ( su == _su && extentID >= _lastExtent &&
+                extentID < _nextExtent )
+      {
+         // still in the last extent
+         return ;
+      }
+      else if ( 0 == pmdGetOptionCB()->readAheadSize() )
+      {
+         reset() ;
+         return ;
+      }
+
+      endExtent = extentID + pageNum ;
+
+      // a forward step within the window ( the extents of other
+      // collections may lay between ) keeps the sequence
+      if ( su != _su || extentID < _nextExtent ||
+           extentID - _nextExtent > (INT32)_window )
+      {
+         reset() ;
+         _su         = su ;
+         _window     = BPS_RA_MIN_WINDOW_SIZE >> su->pageSizeSquareRoot() ;
+         _seqNum     = 1 ;
+         _consumed   = pageNum ;
+         _lastExtent = extentID ;
+         _nextExtent = endExtent ;
+         return ;
+      }
+
+      ++_seqNum ;
+      _consumed += pageNum ;
+      _lastExtent = extentID ;
+      _nextExtent = endExtent ;
+
+      if ( _raEnd > _raBegin )
+      {
+         pStat = pmdGetKRCB()->getBPSCB()->getReadAheadStat() ;
+         if ( extentID >= _raBegin && endExtent <= _raEnd )
+         {
+            pStat->_hitNum.inc() ;
+         }
+         else
+         {
+            pStat->_missNum.inc() ;
+            missed = TRUE ;
+         }
+      }
+
+      if ( _seqNum >= BPS_RA_SEQ_THRESHOLD &&
+           endExtent + (INT32)( _window / 2 ) >= _raEnd )
+      {
+         _issue( endExtent, missed ) ;
+      }
+   }
+
+   void _bpsReadAhead::_issue( dmsExtentID endExtent, BOOLEAN missed )
+   {
+      UINT64 curTime = ossGetCurrentMicroseconds() ;
+      UINT32 pageSquare = _su->pageSizeSquareRoot() ;
+      UINT32 minWindow = BPS_RA_MIN_WINDOW_SIZE >> pageSquare ;
+      UINT64 maxSize = (UINT64)pmdGetOptionCB()->readAheadSize() << 20 ;
+      UINT32 maxWindow = (UINT32)( maxSize >> pageSquare ) ;
+      dmsExtentID beginExtent = OSS_MAX( endExtent, _raEnd ) ;
+      UINT32 advised = 0 ;
+      bpsReadAheadStat *pStat = NULL ;
+
+      if ( missed )
+      {
+         // the scan has caught up with the window
+         _window *= 2 ;
+      }
+      else if ( _lastIssueTime > 0 && curTime > _lastIssueTime )
+      {
+         UINT64 target = (UINT64)_consumed * BPS_RA_LEAD_TIME /
+                         ( curTime - _lastIssueTime ) ;
+         if ( target > _window )
+         {
+            _window = (UINT32)OSS_MIN( target, (UINT64)_window * 2 ) ;
+         }
+         else if ( target < _window / 2 )
+         {
+            _window /= 2 ;
+         }
+      }
+
+      if ( maxWindow < minWindow )
+      {
+         maxWindow = minWindow ;
+      }
+      _window = OSS_MAX( _window, minWindow ) ;
+      _window = OSS_MIN( _window, maxWindow ) ;
+
+      _consumed = 0 ;
+      _lastIssueTime = curTime ;
+
+      if ( beginExtent >= endExtent + (INT32)_window )
+      {
+         return ;
+      }
+
+      advised = _su->readAhead( beginExtent,
+                                endExtent + _window - beginExtent ) ;
+      if ( advised > 0 )
+      {
+         if ( _raEnd < beginExtent )
+         {
+            _raBegin = beginExtent ;
+         }
+         _raEnd = beginExtent + advised ;
+
+         pStat = pmdGetKRCB()->getBPSCB()->getReadAheadStat() ;
+         pStat->_issueNum.inc() ;
+         pStat->_issuePages.add( advised ) ;
+      }
+   }
+
+}
+
@@ -0,0 +1,278 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = catCataNotifier.cpp
+
+   Descriptive Name = Catalog Change Notifier
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of catalog component. This file contains the notifier which
+   pushes the catalog changes to the subscribed coordinators.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#include "catCataNotifier.hpp"
+#include "catalogueCB.hpp"
+#include "msgCatalog.hpp"
+#include "pmd.hpp"
+#include "pd.hpp"
+#include "pdTrace.hpp"
+#include "catTrace.hpp"
+
+using namespace bson ;
+
+namespace engine
+{
+
+   /*
+      _catCataNotifier implement
+   */
+   _catCataNotifier::_catCataNotifier()
+   {
+      _pCatCB = NULL ;
+   }
+
+   _catCataNotifier::~_catCataNotifier()
+   {
+   }
+
+   INT32 _catCataNotifier::init()
+   {
+      _pCatCB = pmdGetKRCB()->getCATLOGUECB() ;
+      _pCatCB->regEventHandler( this ) ;
+      return SDB_OK ;
+   }
+
+   INT32 _catCataNotifier::fini()
+   {
+      if ( _pCatCB )
+      {
+         _pCatCB->unregEventHandler( this ) ;
+      }
+      clear() ;
+      return SDB_OK ;
+   }
+
+   EDUID _catCataNotifier::_curEDUID()
+   {
+      pmdEDUCB *cb = pmdGetThreadEDUCB() ;
+      return cb ? cb->getID() : PMD_INVALID_EDUID ;
+   }
+
+   INT32 _catCataNotifier::onBeginCommand( MsgHeader *pReqMsg )
+   {
+      EDUID eduID = _curEDUID() ;
+      ossScopedLock lock( &_latch ) ;
+      // only the names of the command of current EDU are reset
+      _changedNames[ eduID ].clear() ;
+      return SDB_OK ;
+   }
+
+   INT32 _catCataNotifier::onEndCommand( MsgHeader *pReqMsg, INT32 result )
+   {
+      EDUID eduID = _curEDUID() ;
+      SET_NAME names ;
+      MAP_EDU_NAME_IT it ;
+
+      _latch.get() ;
+      it = _changedNames.find( eduID ) ;
+      if ( it != _changedNames.end() )
+      {
+         names.swap( it->second ) ;
+         _changedNames.erase( it ) ;
+      }
+      _latch.release() ;
+
+      // the changes of the failed command are rolled back
+      if ( SDB_OK == result || SDB_DMS_EOC == result )
+      {
+         _notify( names ) ;
+      }
+      return SDB_OK ;
+   }
+
+   BOOLEAN _catCataNotifier::subscribe( const NET_HANDLE &handle,
+                                        UINT32 &leaseTime )
+   {
+      BOOLEAN isNew = FALSE ;
+      UINT64 now = ossGetCurrentMilliseconds() ;
+      MAP_SUBSCRIBER_IT it ;
+
+      if ( leaseTime < CAT_CATA_LEASE_MIN )
+      {
+         leaseTime = CAT_CATA_LEASE_MIN ;
+      }
+      else if ( leaseTime > CAT_CATA_LEASE_MAX )
+      {
+         leaseTime = CAT_CATA_LEASE_MAX ;
+      }
+
+      ossScopedLock lock( &_latch ) ;
+      it = _subscribers.find( handle ) ;
+      // an expired subscriber may have missed the changes
+      if ( it == _subscribers.end() || it->second < now )
+      {
+         isNew = TRUE ;
+      }
+      _subscribers[ handle ] = now + leaseTime ;
+
+      return isNew ;
+   }
+
+   void _catCataNotifier::unsubscribe( const NET_HANDLE &handle )
+   {
+      ossScopedLock lock( &_latch ) ;
+      _subscribers.erase( handle ) ;
+   }
+
+   void _catCataNotifier::clear()
+   {
+      ossScopedLock lock( &_latch ) ;
+      _subscribers.clear() ;
+      _changedNames.clear() ;
+   }
+
+   void _catCataNotifier::onChange( const CHAR *clFullName )
+   {
+      SET_NAME names ;
+      MAP_EDU_NAME_IT it ;
+
+      if ( !clFullName || !*clFullName )
+      {
+         return ;
+      }
+
+      _latch.get() ;
+      if ( !_subscribers.empty() )
+      {
+         it = _changedNames.find( _curEDUID() ) ;
+         if ( it != _changedNames.end() )
+         {
+            it->second.insert( clFullName ) ;
+         }
+         else
+         {
+            // out of any command, nothing will roll it back
+            names.insert( clFullName ) ;
+         }
+      }
+      _latch.release() ;
+
+      _notify( names ) ;
+   }
+
+   UINT32 _catCataNotifier::subscriberNum()
+   {
+      ossScopedLock lock( &_latch ) ;
+      return _subscribers.size() ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_CATCATANOTIFIER__NOTIFY, "_catCataNotifier::_notify" )
+   void _catCataNotifier::_notify( const SET_NAME &names )
+   {
+      PD_TRACE_ENTRY ( SDB_CATCATANOTIFIER__NOTIFY ) ;
+      std::vector< NET_HANDLE > handles ;
+      UINT64 now = ossGetCurrentMilliseconds() ;
+      MAP_SUBSCRIBER_IT it ;
+
+      if ( names.empty() )
+      {
+         goto done ;
+      }
+
+      _latch.get() ;
+      it = _subscribers.begin() ;
+      while ( it != _subscribers.end() )
+      {
+         if ( it->second < now )
+         {
+            _subscribers.erase( it++ ) ;
+            continue ;
+         }
+         handles.push_back( it->first ) ;
+         ++it ;
+      }
+      _latch.release() ;
+
+      if ( handles.empty() )
+      {
+         goto done ;
+      }
+
+      try
+      {
+         SET_NAME::const_iterator itName = names.begin() ;
+         while ( itName != names.end() )
+         {
+            BSONObjBuilder builder ;
+            BSONArrayBuilder arr( builder.subarrayStart(
+                                  FIELD_NAME_COLLECTION ) ) ;
+            for ( UINT32 count = 0 ;
+                  itName != names.end() && count < CAT_CATA_NTY_MAX_NAME_NUM ;
+                  ++itName, ++count )
+            {
+               arr.append( *itName ) ;
+            }
+            arr.done() ;
+            _sendNty( handles, builder.obj() ) ;
+         }
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDWARNING, "Failed to build catalog change notification, "
+                 "occur exception: %s", e.what() ) ;
+      }
+
+   done:
+      PD_TRACE_EXIT ( SDB_CATCATANOTIFIER__NOTIFY ) ;
+   }
+
+   void _catCataNotifier::_sendNty( const std::vector< NET_HANDLE > &handles,
+                                    const BSONObj &obj )
+   {
+      INT32 rc = SDB_OK ;
+      MsgCatCatalogChangeNty nty ;
+      nty.header.messageLength = sizeof( MsgCatCatalogChangeNty ) +
+                                 obj.objsize() ;
+
+      for ( UINT32 i = 0 ; i < handles.size() ; ++i )
+      {
+         rc = _pCatCB->netWork()->syncSend( handles[ i ], &( nty.header ),
+                                            (void*)obj.objdata(),
+                                            (UINT32)obj.objsize() ) ;
+         if ( rc )
+         {
+            // the subscriber will find its lease lost and refresh all
+            PD_LOG( PDWARNING, "Failed to send catalog change notification "
+                    "to handle[%u], rc: %d", handles[ i ], rc ) ;
+            unsubscribe( handles[ i ] ) ;
+         }
+      }
+   }
+
+}
+
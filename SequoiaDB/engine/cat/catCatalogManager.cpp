@@ -73,6 +73,8 @@ namespace engine
 
    INT32 catCatalogueManager::deactive()
    {
+      // the subscribers renew the leases from the new primary
+      _pCatCB->getCataNotifier()->clear() ;
       return SDB_OK ;
    }
 
@@ -483,6 +485,68 @@ namespace engine
       goto done ;
    }
 
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_CATALOGMGR_SUBSCRIBE, "catCatalogueManager::processSubscribe" )
+   INT32 catCatalogueManager::processSubscribe ( const NET_HANDLE &handle,
+                                                 MsgHeader *pMsg )
+   {
+      INT32 rc                         = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB_CATALOGMGR_SUBSCRIBE ) ;
+      MsgCatSubscribeReq *pReq         = (MsgCatSubscribeReq*)pMsg ;
+      MsgCatSubscribeRes reply ;
+      BOOLEAN isDelay                  = FALSE ;
+      UINT32 leaseTime                 = 0 ;
+
+      reply.header.header.TID          = pMsg->TID ;
+      reply.header.header.requestID    = pMsg->requestID ;
+
+      rc = _pCatCB->primaryCheck( _pEduCB, FALSE, isDelay ) ;
+      if ( rc )
+      {
+         PD_LOG ( PDDEBUG, "Service deactive but received subscribe "
+                  "request, rc: %d", rc ) ;
+         goto error ;
+      }
+
+      PD_CHECK ( pMsg->messageLength >= (INT32)sizeof( MsgCatSubscribeReq ),
+                 SDB_INVALIDARG, error, PDERROR,
+                 "Received unexpected subscribe request, message "
+                 "length(%d) is invalid", pMsg->messageLength ) ;
+
+      leaseTime = pReq->leaseTime ;
+      reply.isNew = _pCatCB->getCataNotifier()->subscribe( handle,
+                                                           leaseTime ) ?
+                    1 : 0 ;
+      reply.leaseTime = leaseTime ;
+      PD_LOG( PDDEBUG, "Handle[%u] subscribed the catalog changes, lease "
+              "time: %u, new: %u", handle, leaseTime, reply.isNew ) ;
+
+      rc = _pCatCB->sendReply( handle, &( reply.header ), rc,
+                               NULL, 0, FALSE ) ;
+
+   done :
+      PD_TRACE_EXITRC ( SDB_CATALOGMGR_SUBSCRIBE, rc ) ;
+      return rc ;
+   error :
+      {
+         MsgOpReply replyMsg ;
+         replyMsg.header.messageLength = sizeof( MsgOpReply ) ;
+         replyMsg.header.opCode        = MSG_CAT_SUBSCRIBE_RSP ;
+         replyMsg.header.TID           = pMsg->TID ;
+         replyMsg.header.routeID.value = 0 ;
+         replyMsg.header.requestID     = pMsg->requestID ;
+         replyMsg.numReturned          = 0 ;
+         replyMsg.flags                = rc ;
+         replyMsg.contextID            = -1 ;
+         replyMsg.startFrom            = 0 ;
+         if ( SDB_CLS_NOT_PRIMARY == rc )
+         {
+            replyMsg.startFrom = _pCatCB->getPrimaryNode() ;
+         }
+         _pCatCB->sendReply( handle, &replyMsg, rc, NULL, 0, FALSE ) ;
+      }
+      goto done ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB_CATALOGMGR_CREATECS, "catCatalogueManager::processCmdCreateCS" )
    INT32 catCatalogueManager::processCmdCreateCS( const CHAR * pQuery,
                                                   rtnContextBuf &ctxBuf )
@@ -924,6 +988,11 @@ namespace engine
             rc = processQueryTask ( handle, pMsg ) ;
             break ;
          }
+      case MSG_CAT_SUBSCRIBE_REQ:
+         {
+            rc = processSubscribe ( handle, pMsg ) ;
+            break ;
+         }
       default:
          {
             rc = SDB_UNKNOWN_MESSAGE;
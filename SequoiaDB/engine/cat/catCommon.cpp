@@ -33,6 +33,7 @@
 #include "pmd.hpp"
 #include "pmdCB.hpp"
 #include "catCommon.hpp"
+#include "catalogueCB.hpp"
 #include "pdTrace.hpp"
 #include "catTrace.hpp"
 #include "rtn.hpp"
@@ -1163,6 +1164,15 @@ namespace engine
       goto done ;
    }
 
+   static void _catNotifyCataChange( const CHAR *clFullName )
+   {
+      sdbCatalogueCB *pCatCB = pmdGetKRCB()->getCATLOGUECB() ;
+      if ( pCatCB )
+      {
+         pCatCB->getCataNotifier()->onChange( clFullName ) ;
+      }
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB_CATREMOVECL, "catRemoveCL" )
    INT32 catRemoveCL( const CHAR * clFullName, pmdEDUCB * cb,
                       SDB_DMSCB * dmsCB, SDB_DPSCB * dpsCB, INT16 w )
@@ -1177,6 +1187,7 @@ namespace engine
       PD_RC_CHECK( rc, PDERROR, "Failed to del record from collection: %s, "
                    "match: %s, rc: %d", CAT_COLLECTION_INFO_COLLECTION,
                    boMatcher.toString().c_str(), rc ) ;
+      _catNotifyCataChange( clFullName ) ;
    done:
       PD_TRACE_EXITRC ( SDB_CATREMOVECL, rc ) ;
       return rc ;
@@ -1244,6 +1255,7 @@ namespace engine
       PD_RC_CHECK( rc, PDSEVERE, "Failed to update collection[%s] catalog info"
                    "[%s], rc: %d", clFullName, cataInfo.toString().c_str(),
                    rc ) ;
+      _catNotifyCataChange( clFullName ) ;
    done:
       PD_TRACE_EXITRC ( SDB_CATUPDATECATALOG, rc ) ;
       return rc ;
@@ -1273,6 +1285,7 @@ namespace engine
       PD_RC_CHECK( rc, PDSEVERE, "Failed to update collection[%s] catalog info"
                    "by push [%s:%s], rc: %d", clFullName, field,
                    boObj.toString().c_str(), rc ) ;
+      _catNotifyCataChange( clFullName ) ;
    done:
       PD_TRACE_EXITRC ( SDB_CATUPDATECATALOGBYPUSH, rc ) ;
       return rc ;
@@ -1300,6 +1313,7 @@ namespace engine
       PD_RC_CHECK( rc, PDSEVERE,
                    "Failed to update collection[%s] by unset[%s], rc: %d",
                    clFullName, field, rc ) ;
+      _catNotifyCataChange( clFullName ) ;
    done:
       PD_TRACE_EXITRC ( SDB_CATUPDATECATALOGBYUNSET, rc ) ;
       return rc ;
@@ -3209,6 +3223,7 @@ namespace engine
       clInfo._isSharding         = FALSE ;
       clInfo._isMainCL           = false;
       clInfo._strictDataMode     = FALSE ;
+      clInfo._blockCompressed    = FALSE ;
       clInfo._assignType         = ASSIGN_RANDOM ;
 
       fieldMask = 0 ;
@@ -3356,6 +3371,16 @@ namespace engine
             clInfo._strictDataMode = eleTmp.boolean() ;
             fieldMask |= CAT_MASK_STRICTDATAMODE ;
          }
+         else if ( ossStrcmp( eleTmp.fieldName(),
+                              CAT_BLOCKCOMPRESSED ) == 0 )
+         {
+            PD_CHECK( Bool == eleTmp.type(),
+                      SDB_INVALIDARG, error, PDWARNING,
+                      "Field [%s] type [%d] error",
+                      CAT_BLOCKCOMPRESSED, eleTmp.type() ) ;
+            clInfo._blockCompressed = eleTmp.boolean() ;
+            fieldMask |= CAT_MASK_BLOCKCOMPRESSED ;
+         }
          else if ( 0 == ossStrcmp( eleTmp.fieldName(),
                                    CAT_GROUP_NAME ) )
          {
@@ -3647,6 +3672,12 @@ namespace engine
       {
          attribute |= DMS_MB_ATTR_STRICTDATAMODE ;
       }
+      // the extents of capped collection are recycled, never sealed
+      if ( ( mask & CAT_MASK_BLOCKCOMPRESSED ) && clInfo._blockCompressed &&
+           !clInfo._capped )
+      {
+         attribute |= DMS_MB_ATTR_BLOCKCOMPRESSED ;
+      }
       mbAttr2String( attribute, szAttr, sizeof( szAttr ) - 1 ) ;
 
       if ( mask & CAT_MASK_CLNAME )
@@ -859,6 +859,7 @@ namespace engine
       PD_LOG ( PDDEBUG, "Killing handle contexts %u", handle ) ;
       _delContextByHandle( handle ) ;
       _deleteDelayedOperation( handle ) ;
+      _pCatCB->getCataNotifier()->unsubscribe( handle ) ;
       PD_TRACE_EXITRC ( SDB_CATMAINCT_REMOTEDISC, rc ) ;
       return rc ;
    }
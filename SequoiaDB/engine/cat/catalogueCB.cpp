@@ -183,6 +183,9 @@ namespace engine
       rc = _catDCMgr.init() ;
       PD_RC_CHECK( rc, PDERROR, "Init cat dc manager failed, rc: %d", rc ) ;
 
+      rc = _cataNotifier.init() ;
+      PD_RC_CHECK( rc, PDERROR, "Init catalog notifier failed, rc: %d", rc ) ;
+
       PD_TRACE1 ( SDB_CATALOGCB_INIT,
                   PD_PACK_ULONG ( _routeID.value ) ) ;
       _pNetWork->setLocalID( _routeID );
@@ -262,6 +265,7 @@ namespace engine
 
    INT32 sdbCatalogueCB::fini ()
    {
+      _cataNotifier.fini() ;
       _catDCMgr.fini() ;
       _catNodeMgr.fini() ;
       _catlogueMgr.fini() ;
@@ -6148,6 +6148,52 @@ SDB_EXPORT INT32 sdbQueryAndRemove ( sdbCollectionHandle cHandle,
                            numToSkip, numToReturn, flag, FALSE, FALSE, handle ) ;
 }
 
+SDB_EXPORT INT32 sdbQueryPrepared ( sdbCollectionHandle cHandle,
+                                    bson *shape,
+                                    bson *parameters,
+                                    bson *select,
+                                    bson *orderBy,
+                                    bson *hint,
+                                    INT64 numToSkip,
+                                    INT64 numToReturn,
+                                    INT32 flag,
+                                    sdbCursorHandle *handle )
+{
+   INT32 rc = SDB_OK ;
+   BOOLEAN hintInit = FALSE ;
+   bson newHint ;
+
+   BSON_INIT2( newHint, hintInit ) ;
+   if ( NULL == shape || NULL == parameters || ( flag & FLG_QUERY_MODIFY ) )
+   {
+      rc = SDB_INVALIDARG ;
+      goto error ;
+   }
+
+   /* the parameters are sent in the hint */
+   if ( NULL != hint )
+   {
+      rc = _mergeBson( &newHint, hint ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+   }
+   BSON_APPEND( newHint, FIELD_NAME_PREPARED_PARAMS, parameters, array ) ;
+   BSON_FINISH( newHint ) ;
+
+   flag |= FLG_QUERY_PREPARED ;
+
+   rc = sdbQuery1( cHandle, shape, select, orderBy, &newHint,
+                   numToSkip, numToReturn, flag, handle ) ;
+
+done:
+   BSON_DESTROY2( newHint, hintInit ) ;
+   return rc ;
+error:
+   goto done ;
+}
+
 SDB_EXPORT INT32 sdbNext ( sdbCursorHandle cHandle,
                            bson *obj )
 {
@@ -10121,6 +10167,59 @@ error:
    goto done ;
 }
 
+SDB_EXPORT INT32 sdbBulkLoad( sdbConnectionHandle cHandle,
+                              const CHAR *fullName,
+                              const CHAR *pBlock,
+                              INT32 blockSize,
+                              INT32 recordNum,
+                              INT32 version )
+{
+   INT32 rc = SDB_OK ;
+   bson newObj ;
+   BOOLEAN bsoninit = FALSE ;
+   sdbConnectionStruct *connection = (sdbConnectionStruct *)cHandle ;
+   HANDLE_CHECK( cHandle, connection, SDB_HANDLE_TYPE_CONNECTION ) ;
+
+   if ( NULL == fullName || 0 == ossStrlen( fullName ) ||
+        NULL == pBlock || blockSize <= 0 || recordNum <= 0 )
+   {
+      rc = SDB_INVALIDARG ;
+      goto error ;
+   }
+
+   BSON_INIT( newObj ) ;
+   BSON_APPEND( newObj, FIELD_NAME_COLLECTION, fullName, string ) ;
+   rc = bson_append_binary( &newObj, FIELD_NAME_DATA, BSON_BIN_BINARY,
+                            pBlock, blockSize ) ;
+   if ( rc )
+   {
+      rc = SDB_DRIVER_BSON_ERROR ;
+      goto error ;
+   }
+   BSON_APPEND( newObj, FIELD_NAME_RECORD_NUM, recordNum, int ) ;
+   BSON_APPEND( newObj, FIELD_NAME_VERSION, version, int ) ;
+   BSON_FINISH( newObj ) ;
+
+   rc = _runCommand( cHandle, connection->_sock, &connection->_pSendBuffer,
+                     &connection->_sendBufferSize,
+                     &connection->_pReceiveBuffer,
+                     &connection->_receiveBufferSize,
+                     connection->_endianConvert,
+                     CMD_ADMIN_PREFIX CMD_NAME_BULK_LOAD,
+                     &newObj,
+                     NULL, NULL, NULL ) ;
+   if ( rc )
+   {
+      goto error ;
+   }
+
+done:
+   BSON_DESTROY( newObj ) ;
+   return rc ;
+error:
+   goto done ;
+}
+
 SDB_EXPORT INT32 sdbDetachNode( sdbReplicaGroupHandle cHandle,
                                 const CHAR *hostName,
                                 const CHAR *serviceName,
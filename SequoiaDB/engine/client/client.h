@@ -1671,6 +1671,46 @@ SDB_EXPORT INT32 sdbQueryAndRemove ( sdbCollectionHandle cHandle,
                                      INT32 flag,
                                      sdbCursorHandle *handle ) ;
 
+/** \fn INT32 sdbQueryPrepared ( sdbCollectionHandle cHandle,
+                                 bson *shape,
+                                 bson *parameters,
+                                 bson *select,
+                                 bson *orderBy,
+                                 bson *hint,
+                                 INT64 numToSkip,
+                                 INT64 numToReturn,
+                                 INT32 flag,
+                                 sdbCursorHandle *handle )
+    \brief Get the matching documents of a prepared query in current collection.
+           The shape is kept by the application and executed with different
+           parameters, the database reuses the normalized query and the plan
+           of the shape, instead of parsing the matching rule every time
+    \param [in] cHandle The collection handle
+    \param [in] shape The matching rule, in which the values are given by the
+                      slots { "$param" : <index> }.
+                      e.g. { "a" : { "$param" : 0 }, "b" : { "$gt" : { "$param" : 1 } } }
+    \param [in] parameters The array of the values of the slots, e.g. [ 10, "abc" ]
+    \param [in] select The selective rule, return the whole document if null
+    \param [in] orderBy The ordered rule, never sort if null
+    \param [in] hint Specified the index used to scan data, the same as sdbQuery1
+    \param [in] numToSkip Skip the first numToSkip documents, never skip if this parameter is 0
+    \param [in] numToReturn Only return numToReturn documents, return all if this parameter is -1
+    \param [in] flag The query flag, the same as sdbQuery1
+    \param [out] handle The cursor handle of current query
+    \retval SDB_OK Operation Success
+    \retval Others Operation Fail
+*/
+SDB_EXPORT INT32 sdbQueryPrepared ( sdbCollectionHandle cHandle,
+                                    bson *shape,
+                                    bson *parameters,
+                                    bson *select,
+                                    bson *orderBy,
+                                    bson *hint,
+                                    INT64 numToSkip,
+                                    INT64 numToReturn,
+                                    INT32 flag,
+                                    sdbCursorHandle *handle ) ;
+
 /** \fn INT32 sdbExplain ( sdbCollectionHandle cHandle,
                            bson *condition,
                            bson *select,
@@ -2494,6 +2534,31 @@ SDB_EXPORT INT32 sdbPop( sdbConnectionHandle cHandle,
                          const CHAR *fullName,
                          bson *options ) ;
 
+/* \fn INT32 sdbBulkLoad( sdbConnectionHandle cHandle,
+                           const CHAR *fullName,
+                           const CHAR *pBlock,
+                           INT32 blockSize,
+                           INT32 recordNum,
+                           INT32 version )
+    \brief load a block of records to the collection of the data node
+    \param [in] cHandle The handle of connection to the primary data node.
+    \param [in] fullName The full name of collection, eg: foo.bar.
+    \param [in] pBlock The records, one bson after another, and each is
+                aligned by 4 bytes. Every record must have _id.
+    \param [in] blockSize The size of the block.
+    \param [in] recordNum The number of the records in the block.
+    \param [in] version The catalog version of the collection, by which the
+                records are routed to the data node.
+    \retval SDB_OK Operation Success
+    \retval Others Operation Fail
+*/
+SDB_EXPORT INT32 sdbBulkLoad( sdbConnectionHandle cHandle,
+                              const CHAR *fullName,
+                              const CHAR *pBlock,
+                              INT32 blockSize,
+                              INT32 recordNum,
+                              INT32 version ) ;
+
 
 /** \fn INT32 sdbDetachNode( sdbReplicaGroupHandle cHandle,
                              const CHAR *hostName,
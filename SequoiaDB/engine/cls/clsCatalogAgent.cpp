@@ -42,6 +42,7 @@
 #include "utilBsonHash.hpp"
 #include "utilCommon.hpp"
 #include <set>
+#include <algorithm>
 
 #include "../bson/lib/md5.hpp"
 #include "../bson/lib/md5.h"
@@ -828,6 +829,165 @@ namespace engine
       goto done ;
    }
 
+   /*
+      Append the sharding key of the record to keyBuf, and return the offset
+      of the key. The key is the same as the one of the key generator: the
+      fields are not named, and the missing ones are undefined. -1 is
+      returned when the record has array in the sharding key, which may make
+      more than one key, and is left to the key generator.
+   */
+   INT32 _clsCatalogSet::_extractKey( const BSONObj &obj,
+                                      BufBuilder &keyBuf )
+   {
+      INT32 offset = keyBuf.len() ;
+      BOOLEAN hasArray = FALSE ;
+
+      {
+         BSONObjBuilder builder( keyBuf ) ;
+         BSONObjIterator itr( _shardingKey ) ;
+         while ( itr.more() )
+         {
+            const CHAR *pName = itr.next().fieldName() ;
+            BSONElement e = obj.getFieldDottedOrArray( pName ) ;
+            if ( e.eoo() )
+            {
+               builder.appendUndefined( "" ) ;
+            }
+            else if ( Array == e.type() )
+            {
+               hasArray = TRUE ;
+               break ;
+            }
+            else
+            {
+               builder.appendAs( e, "" ) ;
+            }
+         }
+         builder.doneFast() ;
+      }
+
+      if ( hasArray )
+      {
+         keyBuf.setlen( offset ) ;
+         offset = -1 ;
+      }
+      return offset ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__CLSCTSET_FINDITEMBATCH, "_clsCatalogSet::findItems" )
+   INT32 _clsCatalogSet::findItems( clsRouteBatch &batch )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__CLSCTSET_FINDITEMBATCH ) ;
+      UINT32 num = batch.size() ;
+      UINT32 i = 0 ;
+      clsCatalogItem *item = NULL ;
+
+      batch._items.resize( num ) ;
+
+      if ( !isSharding() || ( _isWholeRange && 1 == _groupCount ) )
+      {
+         PD_CHECK ( 1 == _mapItems.size(), SDB_SYS, error, PDERROR,
+                    "When not sharding, the collection[%s] cataItem "
+                    "number[%d] error", name(), _mapItems.size() ) ;
+         std::fill( batch._items.begin(), batch._items.end(),
+                    _mapItems.begin()->second ) ;
+         goto done ;
+      }
+      PD_CHECK( _pKeyGen, SDB_SYS, error, PDSEVERE, "KeyGen is null" ) ;
+
+      try
+      {
+         BOOLEAN isHash = isHashSharding() ;
+         INT32 lastRange = -1 ;
+
+         // extract the keys of the whole batch first, then route them in one
+         // pass over the flat buffer
+         batch._keyBuf.reset() ;
+         batch._keyOffsets.resize( num ) ;
+         for ( i = 0 ; i < num ; ++i )
+         {
+            batch._keyOffsets[ i ] = _extractKey( BSONObj( batch.record( i ) ),
+                                                  batch._keyBuf ) ;
+         }
+
+         for ( i = 0 ; i < num ; ++i )
+         {
+            INT32 offset = batch._keyOffsets[ i ] ;
+            if ( offset < 0 )
+            {
+               rc = findItem( BSONObj( batch.record( i ) ), item ) ;
+               lastRange = -1 ;
+            }
+            else if ( isHash )
+            {
+               INT32 range = _hash( BSONObj( batch._keyBuf.buf() + offset ) ) ;
+               // the records with the same key are usually together
+               if ( range != lastRange )
+               {
+                  rc = _findItem( clsCataItemKey( range ), item ) ;
+                  lastRange = range ;
+               }
+            }
+            else
+            {
+               clsCataItemKey findKey( batch._keyBuf.buf() + offset,
+                                       getOrdering() ) ;
+               rc = _findItem( findKey, item ) ;
+            }
+
+            if ( rc )
+            {
+               PD_LOG( PDERROR, "Failed to find the catalog item of "
+                       "record[%s] in collection[%s], rc: %d",
+                       BSONObj( batch.record( i ) ).toString().c_str(),
+                       name(), rc ) ;
+               goto error ;
+            }
+            batch._items[ i ] = item ;
+         }
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "Failed to find the catalog items of records, "
+                 "occur exception: %s", e.what() ) ;
+         rc = SDB_SYS ;
+         goto error ;
+      }
+
+   done:
+      PD_TRACE_EXITRC( SDB__CLSCTSET_FINDITEMBATCH, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__CLSCTSET_FINDGPIDBATCH, "_clsCatalogSet::findGroupIDs" )
+   INT32 _clsCatalogSet::findGroupIDs( clsRouteBatch &batch )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__CLSCTSET_FINDGPIDBATCH ) ;
+      UINT32 num = batch.size() ;
+
+      rc = findItems( batch ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+
+      batch._groupIDs.resize( num ) ;
+      for ( UINT32 i = 0 ; i < num ; ++i )
+      {
+         batch._groupIDs[ i ] = batch._items[ i ]->getGroupID() ;
+      }
+
+   done:
+      PD_TRACE_EXITRC( SDB__CLSCTSET_FINDGPIDBATCH, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB__CLSCTSET_FINDGPIDS, "_clsCatalogSet::findGroupIDS" )
    INT32 _clsCatalogSet::findGroupIDS ( const BSONObj &matcher,
                                         VEC_GROUP_ID &vecGroup )
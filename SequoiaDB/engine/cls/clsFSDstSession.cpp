@@ -745,8 +745,14 @@ namespace engine
          if ( !noMore )
          {
             vector<BSONObj>::iterator itr = indexes.begin() ;
+            _deferredIndexes.clear() ;
             for ( ; itr != indexes.end(); itr++ )
             {
+               if ( _canDeferIndex( *itr ) )
+               {
+                  _deferredIndexes.push_back( itr->getOwned() ) ;
+                  continue ;
+               }
                _replayer.replayIXCrt( _fullNames.at( _current ).c_str(),
                                       *itr, eduCB() ) ;
             }
@@ -821,6 +827,14 @@ namespace engine
             _status = CLS_FS_STATUS_NOTIFY_LOB ;
             _notify( CLS_FS_NOTIFY_TYPE_LOB ) ;
             _needMoreDoc = FALSE ;
+
+            // the peer is notified first, it prepares the lobs while the
+            // indexes are built on the loaded data
+            rc = _buildDeferredIndexes() ;
+            if ( SDB_OK != rc )
+            {
+               goto error ;
+            }
          }
       }
       else if ( CLS_FS_NOTIFY_TYPE_LOG == msg->type )
@@ -864,6 +878,12 @@ namespace engine
          }
          else
          {
+            rc = _buildDeferredIndexes() ;
+            if ( SDB_OK != rc )
+            {
+               goto error ;
+            }
+
             _expectLSN = msg->lsn ;
             _status = CLS_FS_STATUS_META ;
 
@@ -894,6 +914,56 @@ namespace engine
       goto done ;
    }
 
+   BOOLEAN _clsDataDstBaseSession::_canDeferIndex( const BSONObj &index )
+   {
+      // the unique indexes are created before the data, the duplicate
+      // records replayed from the logs are skipped by them
+      if ( !_deferIndex() ||
+           index.getBoolField( IXM_UNIQUE_FIELD ) ||
+           0 == ossStrcmp( index.getStringField( IXM_NAME_FIELD ),
+                           IXM_ID_KEY_NAME ) )
+      {
+         return FALSE ;
+      }
+      return TRUE ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__CLSDATADBS__BUILDDEFIDX, "_clsDataDstBaseSession::_buildDeferredIndexes" )
+   INT32 _clsDataDstBaseSession::_buildDeferredIndexes()
+   {
+      PD_TRACE_ENTRY ( SDB__CLSDATADBS__BUILDDEFIDX ) ;
+      INT32 rc = SDB_OK ;
+      vector<BSONObj>::iterator itr = _deferredIndexes.begin() ;
+
+      if ( _current >= _fullNames.size() )
+      {
+         _deferredIndexes.clear() ;
+         goto done ;
+      }
+
+      // the indexes are built by sorting the keys of the loaded records
+      for ( ; itr != _deferredIndexes.end() ; ++itr )
+      {
+         rc = _replayer.replayIXCrt( _fullNames[ _current ].c_str(),
+                                     *itr, eduCB() ) ;
+         if ( rc )
+         {
+            PD_LOG( PDERROR, "Session[%s]: Failed to build index[%s] of "
+                    "collection[%s], rc: %d", sessionName(),
+                    itr->toString().c_str(),
+                    _fullNames[ _current ].c_str(), rc ) ;
+            goto error ;
+         }
+      }
+
+   done:
+      _deferredIndexes.clear() ;
+      PD_TRACE_EXITRC ( SDB__CLSDATADBS__BUILDDEFIDX, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB__CLSDATADBS__REPLAYDOC, "_clsDataDstBaseSession::_replayDoc" )
    INT32 _clsDataDstBaseSession::_replayDoc( const MsgClsFSNotifyRes *msg )
    {
@@ -2103,6 +2173,10 @@ namespace engine
       clsCB *pClsMgr = pmdGetKRCB()->getClsCB() ;
       UINT32 splitTaskCount = 0 ;
 
+      // the synced data keeps all the indexes even if the split breaks,
+      // the split is incomplete then and restarts anyway
+      _buildDeferredIndexes() ;
+
       if ( _regTask )
       {
          pClsMgr->getTaskMgr()->unregCollection( _pTask->clFullName() ) ;
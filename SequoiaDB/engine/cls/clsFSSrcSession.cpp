@@ -44,6 +44,7 @@
 #include "clsCleanupJob.hpp"
 #include "rtnIXScanner.hpp"
 #include "dpsLogRecord.hpp"
+#include "dpsOp2Record.hpp"
 #include "pdTrace.hpp"
 #include "clsTrace.hpp"
 #include "dpsLogRecordDef.hpp"
@@ -61,6 +62,7 @@ namespace engine
 
 #define CLS_SYNC_MAX_TIME                 (5)         // second
 #define CLS_FS_SRC_MAX_NO_MSG_TIME        (3600000)   // 1 hour
+#define CLS_SPLIT_STREAM_NUM              (4)
 
 #define CLS_IS_LOB_LOG( type )\
         ( LOG_TYPE_LOB_WRITE == ( type ) || \
@@ -612,6 +614,23 @@ namespace engine
       goto done ;
    }
 
+   BOOLEAN _clsDataSrcBaseSession::isSyncing( UINT32 suLID, UINT32 clLID )
+   {
+      BOOLEAN syncing = FALSE ;
+      UINT64 fullCLLID = ossPack32To64( suLID, clLID ) ;
+
+      // the collections which are not started are synced by the scan
+      // later, and the ones not to sync are never in the list
+      _LSNlatch.get() ;
+      if ( _init && !_quit )
+      {
+         syncing = ( fullCLLID == _curCollection ||
+                     _mapOveredCLs.end() != _mapOveredCLs.find( fullCLLID ) ) ;
+      }
+      _LSNlatch.release() ;
+      return syncing ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB__CLSDSBS__DISCONN, "_clsDataSrcBaseSession::_disconnect" )
    void _clsDataSrcBaseSession::_disconnect()
    {
@@ -784,6 +803,20 @@ namespace engine
       _dataType = CLS_FS_NOTIFY_TYPE_LOG ;
       BOOLEAN retryTime = 0 ;
 
+      if ( _hasPendingRecord() )
+      {
+         // the records read before the logs were generated must reach the
+         // peer before the logs
+         rc = _syncRecord( handle, packet, routeID, TID, requestID ) ;
+         if ( rc )
+         {
+            PD_LOG( PDERROR, "Session[%s]: Failed to sync pending record, "
+                    "rc: %d", sessionName(), rc ) ;
+            goto error ;
+         }
+         goto done ;
+      }
+
    retry:
       bEnd = FALSE ;
       _mb.clear() ;
@@ -1712,6 +1745,9 @@ namespace engine
                goto done ;
             }
          }
+         // a bulk load block is notified with its lowest extent, it's sent
+         // when any of the records is scanned, the replayer skips the ones
+         // which are synced by the scan too
          else if ( _findEnd || extLID <= _curExtID )
          {
             _deqLSN.push_back ( offset ) ;
@@ -2061,10 +2097,14 @@ namespace engine
       _collectionW      = 1 ;
       _lastOprLSN       = DPS_INVALID_LSN_OFFSET ;
       _internalV        = 0 ;
+
+      _streamScan       = FALSE ;
+      _aliveStreamNum   = 0 ;
    }
 
    _clsSplitSrcSession::~_clsSplitSrcSession()
    {
+      _closeStreams() ;
       _pCatAgent = NULL ;
       _pFreezingWindow = NULL ;
    }
@@ -2154,7 +2194,8 @@ namespace engine
       lsnLen = record.head()._length ;
 
       if ( TBSCAN == _scanType() && !inEndMap && !_findEnd &&
-           extLID > _curExtID && !( CLS_IS_LOB_LOG( record.head()._type ) ) )
+           !_isExtScanned( extLID ) &&
+           !( CLS_IS_LOB_LOG( record.head()._type ) ) )
       {
          goto done ;
       }
@@ -2238,6 +2279,34 @@ namespace engine
             _deqLSN.push_back( offset ) ;
             goto done ;
          }
+         else if ( LOG_TYPE_DATA_LOAD == record.head()._type )
+         {
+            UINT32 inRangeNum = 0 ;
+            UINT32 recordNum = 0 ;
+            rc = _countLoadInRange( _lsnSearchMB.startPtr(), inRangeNum,
+                                    recordNum ) ;
+            if ( SDB_OK != rc )
+            {
+               goto error ;
+            }
+            // the block is replayed as a whole, it can't be sent when only
+            // a part of it is in the range. The ones synced by the scan too
+            // are skipped by the replayer
+            if ( inRangeNum == recordNum )
+            {
+               _deqLSN.push_back( offset ) ;
+            }
+            else if ( inRangeNum > 0 )
+            {
+               PD_LOG( PDWARNING, "Session[%s]: %u of %u records of the "
+                       "bulk load block[offset:%lld] are in the range, the "
+                       "split has to restart", sessionName(), inRangeNum,
+                       recordNum, offset ) ;
+               rc = SDB_OPERATION_INCOMPATIBLE ;
+               goto error ;
+            }
+            goto done ;
+         }
 
          {
             BSONObj keyObj ;
@@ -2250,7 +2319,7 @@ namespace engine
             if ( _GEThanRangeKey( keyObj ) && _LThanRangeEndKey( keyObj ) &&
                  ( _findEnd || inEndMap ||
                   ( IXSCAN == _scanType() && _LEThanScanObj( keyObj ) ) ||
-                  ( TBSCAN == _scanType() && extLID <= _curExtID ) ) )
+                  ( TBSCAN == _scanType() && _isExtScanned( extLID ) ) ) )
             {
                _deqLSN.push_back( offset ) ;
                /*PD_LOG( PDERROR, "Session[%s]: push queue: %s, curObj: "
@@ -2723,6 +2792,61 @@ namespace engine
       return rc ;
    }
 
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__CLSSPLSS__CNTLOADINRANGE, "_clsSplitSrcSession::_countLoadInRange" )
+   INT32 _clsSplitSrcSession::_countLoadInRange( const CHAR *pLogRecord,
+                                                 UINT32 &inRangeNum,
+                                                 UINT32 &recordNum )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__CLSSPLSS__CNTLOADINRANGE ) ;
+      const CHAR *fullName = NULL ;
+      const CHAR *pBlock = NULL ;
+      UINT32 blockSize = 0 ;
+      UINT32 offset = 0 ;
+      BSONObj keyObj ;
+
+      inRangeNum = 0 ;
+      rc = dpsRecord2Load( pLogRecord, &fullName, &pBlock, blockSize,
+                           recordNum ) ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG( PDERROR, "Session[%s]: parse load log failed[rc:%d]",
+                 sessionName(), rc ) ;
+         goto error ;
+      }
+
+      try
+      {
+         while ( offset < blockSize )
+         {
+            BSONObj obj( pBlock + offset ) ;
+            rc = _genKeyObj( obj, keyObj ) ;
+            if ( SDB_OK != rc )
+            {
+               goto error ;
+            }
+            if ( _GEThanRangeKey( keyObj ) && _LThanRangeEndKey( keyObj ) )
+            {
+               ++inRangeNum ;
+            }
+            offset += ossAlign4( (UINT32)obj.objsize() ) ;
+         }
+      }
+      catch( std::exception &e )
+      {
+         PD_LOG( PDERROR, "Session[%s]: occur exception: %s",
+                 sessionName(), e.what() ) ;
+         rc = SDB_SYS ;
+         goto error ;
+      }
+
+   done:
+      PD_TRACE_EXITRC ( SDB__CLSSPLSS__CNTLOADINRANGE, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB__CLSSPLSS__GENKEYOBJ, "_clsSplitSrcSession::_genKeyObj" )
    INT32 _clsSplitSrcSession::_genKeyObj( const BSONObj & obj,
                                           BSONObj & keyObj )
@@ -3027,4 +3151,518 @@ namespace engine
       return rc ;
    }
 
+   BOOLEAN _clsSplitSrcSession::_hasPendingRecord()
+   {
+      for ( UINT32 i = 0 ; i < _vecReadAhead.size() ; ++i )
+      {
+         if ( _vecReadAhead[ i ] )
+         {
+            return TRUE ;
+         }
+      }
+      return FALSE ;
+   }
+
+   void _clsSplitSrcSession::_reset()
+   {
+      _closeStreams() ;
+      _clsDataSrcBaseSession::_reset() ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__CLSSPLSS__OPNCONTX, "_clsSplitSrcSession::_openContext" )
+   INT32 _clsSplitSrcSession::_openContext( CHAR *cs, CHAR *collection )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__CLSSPLSS__OPNCONTX ) ;
+      _dmsStorageUnit *su = NULL ;
+      dmsMBContext *mbContext = NULL ;
+      vector< dmsExtentID > segExtents ;
+
+      // called in _LSNlatch
+      _closeStreams() ;
+
+      rc = _clsDataSrcBaseSession::_openContext( cs, collection ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+
+      if ( NULL == _context || TBSCAN != _scanType() )
+      {
+         goto done ;
+      }
+
+      su = _context->getSU() ;
+      if ( !su->data()->isBlockScanSupport() )
+      {
+         goto done ;
+      }
+
+      mbContext = _context->getMBContext() ;
+      rc = su->getSegExtents( NULL, segExtents, mbContext ) ;
+      mbContext->mbUnlock() ;
+      if ( rc )
+      {
+         PD_LOG( PDWARNING, "Session[%s]: Failed to get the segments of "
+                 "collection[%s.%s], rc: %d", sessionName(), cs,
+                 collection, rc ) ;
+         rc = SDB_OK ;
+         goto done ;
+      }
+      else if ( segExtents.size() < 2 )
+      {
+         goto done ;
+      }
+
+      rc = _openStreams( segExtents ) ;
+      if ( rc )
+      {
+         // scan by the context directly
+         PD_LOG( PDWARNING, "Session[%s]: Failed to open the streams of "
+                 "collection[%s.%s], rc: %d", sessionName(), cs,
+                 collection, rc ) ;
+         _closeStreams() ;
+         rc = SDB_OK ;
+         goto done ;
+      }
+
+      PD_LOG( PDEVENT, "Session[%s]: Scan %u segments of collection[%s.%s] "
+              "by %u streams", sessionName(), segExtents.size(), cs,
+              collection, _aliveStreamNum ) ;
+
+   done:
+      PD_TRACE_EXITRC ( SDB__CLSSPLSS__OPNCONTX, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__CLSSPLSS__OPNSTREAMS, "_clsSplitSrcSession::_openStreams" )
+   INT32 _clsSplitSrcSession::_openStreams(
+                              const vector< dmsExtentID > &segExtents )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__CLSSPLSS__OPNSTREAMS ) ;
+      dmsStorageDataCommon *pData = _context->getSU()->data() ;
+      UINT32 streamNum = CLS_SPLIT_STREAM_NUM ;
+      UINT32 step = 0 ;
+      UINT32 begin = 0 ;
+      UINT32 i = 0 ;
+      _rtnContextData *pContext = NULL ;
+      BSONObj blockObj ;
+
+      if ( segExtents.size() < streamNum )
+      {
+         streamNum = segExtents.size() ;
+      }
+      if ( 0 == streamNum )
+      {
+         goto done ;
+      }
+      step = ( segExtents.size() + streamNum - 1 ) / streamNum ;
+
+      // the adjacent segments are scanned by one stream, so the extents
+      // are read in order in every stream
+      for ( begin = 0 ; begin < segExtents.size() ; begin += step )
+      {
+         try
+         {
+            BSONArrayBuilder builder ;
+            for ( i = begin ; i < begin + step && i < segExtents.size() ; ++i )
+            {
+               builder.append( segExtents[ i ] ) ;
+            }
+            blockObj = builder.arr() ;
+         }
+         catch ( std::exception &e )
+         {
+            PD_LOG( PDERROR, "Session[%s]: Failed to build the segments, "
+                    "occur exception: %s", sessionName(), e.what() ) ;
+            rc = SDB_SYS ;
+            goto error ;
+         }
+
+         rc = _openStream( blockObj, &pContext ) ;
+         PD_RC_CHECK( rc, PDERROR, "Session[%s]: Failed to open stream of "
+                      "segments[%s], rc: %d", sessionName(),
+                      blockObj.toString().c_str(), rc ) ;
+
+         for ( i = begin ; i < begin + step && i < segExtents.size() ; ++i )
+         {
+            _mapSegOwner[ pData->extent2LogicSeg( segExtents[ i ] ) ] =
+               (INT32)_vecStream.size() ;
+         }
+         _vecStream.push_back( pContext ) ;
+         _vecReadAhead.push_back( FALSE ) ;
+         ++_aliveStreamNum ;
+      }
+      _streamScan = TRUE ;
+
+   done:
+      PD_TRACE_EXITRC ( SDB__CLSSPLSS__OPNSTREAMS, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _clsSplitSrcSession::_openStream( const BSONObj &blockObj,
+                                           _rtnContextData **ppContext )
+   {
+      INT32 rc = SDB_OK ;
+      _dmsStorageUnit *su = _context->getSU() ;
+      optAccessPlanRuntime *planRuntime = _context->getPlanRuntime() ;
+      dmsMBContext *mbContext = NULL ;
+      rtnContextData *pContext = NULL ;
+      rtnReturnOptions returnOptions ;
+
+      rc = su->data()->getMBContext( &mbContext, planRuntime->getCLMBID(),
+                                     DMS_INVALID_CLID, DMS_INVALID_CLID,
+                                     -1 ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to get dms mb context, rc: %d", rc ) ;
+      PD_CHECK( planRuntime->getCLLID() == mbContext->clLID(),
+                SDB_DMS_NOTEXIST, error, PDERROR, "Failed to get dms mb "
+                "context, rc: %d", SDB_DMS_NOTEXIST ) ;
+
+      pContext = SDB_OSS_NEW rtnContextData( -1, eduCB()->getID() ) ;
+      if ( !pContext )
+      {
+         rc = SDB_OOM ;
+         PD_LOG( PDERROR, "Alloc stream context out of memory" ) ;
+         goto error ;
+      }
+      pContext->getPlanRuntime()->inheritRuntime( planRuntime ) ;
+
+      rc = pContext->open( su, mbContext, eduCB(), returnOptions,
+                           &blockObj, 1 ) ;
+      PD_RC_CHECK( rc, PDERROR, "Open stream context failed, rc: %d", rc ) ;
+      mbContext = NULL ;
+      pContext->setEnableQueryActivity( FALSE ) ;
+
+      *ppContext = pContext ;
+      pContext = NULL ;
+
+   done:
+      return rc ;
+   error:
+      if ( pContext )
+      {
+         SDB_OSS_DEL pContext ;
+      }
+      if ( mbContext )
+      {
+         su->data()->releaseMBContext( mbContext ) ;
+      }
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__CLSSPLSS__NEXTSTREAMPASS, "_clsSplitSrcSession::_nextStreamPass" )
+   INT32 _clsSplitSrcSession::_nextStreamPass()
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__CLSSPLSS__NEXTSTREAMPASS ) ;
+      _dmsStorageUnit *su = _context->getSU() ;
+      dmsMBContext *mbContext = _context->getMBContext() ;
+      vector< dmsExtentID > segExtents ;
+      vector< dmsExtentID > newSegExtents ;
+
+      rc = su->getSegExtents( NULL, segExtents, mbContext ) ;
+      if ( rc )
+      {
+         mbContext->mbUnlock() ;
+         PD_LOG( PDERROR, "Session[%s]: Failed to get the segments, rc: %d",
+                 sessionName(), rc ) ;
+         goto error ;
+      }
+
+      for ( UINT32 i = 0 ; i < segExtents.size() ; ++i )
+      {
+         if ( _mapSegOwner.end() == _mapSegOwner.find(
+              su->data()->extent2LogicSeg( segExtents[ i ] ) ) )
+         {
+            newSegExtents.push_back( segExtents[ i ] ) ;
+         }
+      }
+
+      if ( newSegExtents.empty() )
+      {
+         // no segment is created since the last pass, hold the mb lock
+         // while ending, so the records of the segments created later are
+         // all synced by the logs
+         _LSNlatch.get() ;
+         _findEnd = TRUE ;
+         _closeStreams() ;
+         _LSNlatch.release() ;
+         mbContext->mbUnlock() ;
+
+         pmdGetKRCB()->getRTNCB()->contextDelete( _contextID, eduCB() ) ;
+         _contextID = -1 ;
+         _context = NULL ;
+         goto done ;
+      }
+      mbContext->mbUnlock() ;
+
+      PD_LOG( PDDEBUG, "Session[%s]: %u segments are created while "
+              "scanning", sessionName(), newSegExtents.size() ) ;
+
+      _LSNlatch.get() ;
+      rc = _openStreams( newSegExtents ) ;
+      _LSNlatch.release() ;
+      if ( rc )
+      {
+         goto error ;
+      }
+
+   done:
+      PD_TRACE_EXITRC ( SDB__CLSSPLSS__NEXTSTREAMPASS, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   void _clsSplitSrcSession::_closeStream( UINT32 index )
+   {
+      _rtnContextData *pContext = NULL ;
+      map< UINT32, INT32 >::iterator it ;
+
+      _LSNlatch.get() ;
+      pContext = _vecStream[ index ] ;
+      _vecStream[ index ] = NULL ;
+      _vecReadAhead[ index ] = FALSE ;
+      for ( it = _mapSegOwner.begin() ; it != _mapSegOwner.end() ; ++it )
+      {
+         if ( (INT32)index == it->second )
+         {
+            it->second = -1 ;
+         }
+      }
+      --_aliveStreamNum ;
+      _LSNlatch.release() ;
+
+      if ( pContext )
+      {
+         pContext->waitForPrefetch() ;
+         SDB_OSS_DEL pContext ;
+      }
+   }
+
+   void _clsSplitSrcSession::_closeStreams()
+   {
+      for ( UINT32 i = 0 ; i < _vecStream.size() ; ++i )
+      {
+         if ( _vecStream[ i ] )
+         {
+            _vecStream[ i ]->waitForPrefetch() ;
+            SDB_OSS_DEL _vecStream[ i ] ;
+         }
+      }
+      _vecStream.clear() ;
+      _vecReadAhead.clear() ;
+      _mapSegOwner.clear() ;
+      _aliveStreamNum = 0 ;
+      _streamScan = FALSE ;
+   }
+
+   BOOLEAN _clsSplitSrcSession::_isExtScanned( dmsExtentID extLID )
+   {
+      map< UINT32, INT32 >::iterator it ;
+      _rtnContextData *pContext = NULL ;
+
+      if ( !_streamScan )
+      {
+         return extLID <= _curExtID ? TRUE : FALSE ;
+      }
+
+      // the segments created after the streams are opened are scanned
+      // in the next pass
+      it = _mapSegOwner.find(
+         _context->getSU()->data()->extLID2LogicSeg( extLID ) ) ;
+      if ( _mapSegOwner.end() == it )
+      {
+         return FALSE ;
+      }
+      else if ( it->second < 0 )
+      {
+         return TRUE ;
+      }
+
+      // the stream reads the extents of its segments in order
+      pContext = _vecStream[ it->second ] ;
+      return ( pContext->eof() || extLID <= pContext->lastExtLID() ) ?
+             TRUE : FALSE ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__CLSSPLSS__SYNCRECD, "_clsSplitSrcSession::_syncRecord" )
+   INT32 _clsSplitSrcSession::_syncRecord( const NET_HANDLE &handle,
+                                           SINT64 packet,
+                                           const MsgRouteID &routeID,
+                                           UINT32 TID, UINT64 requestID )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__CLSSPLSS__SYNCRECD ) ;
+      time_t bTime = time( NULL ) ;
+      BOOLEAN drain = FALSE ;
+      BOOLEAN isFull = FALSE ;
+      _rtnContextData *pContext = NULL ;
+      const CHAR *pData = NULL ;
+      INT32 dataLen = 0 ;
+      UINT32 alignLen = 0 ;
+      UINT32 tempSize = 0 ;
+      rtnContextBuf buffObj ;
+      MsgClsFSNotifyRes msg ;
+
+      if ( !_streamScan )
+      {
+         rc = _clsDataSrcBaseSession::_syncRecord( handle, packet, routeID,
+                                                   TID, requestID ) ;
+         goto done ;
+      }
+
+      _dataType = CLS_FS_NOTIFY_TYPE_DOC ;
+      msg.header.header.TID = TID ;
+      msg.header.header.routeID = routeID ;
+      msg.header.res = SDB_OK ;
+      msg.header.header.requestID = requestID ;
+      msg.packet = packet ;
+      msg.type = CLS_FS_NOTIFY_TYPE_DOC ;
+
+      _mb.clear () ;
+      _query = NULL ;
+      _queryLen = 0 ;
+
+      // when logs are waiting, stop reading ahead and only send the records
+      // which have been read, then the logs are sent
+      _LSNlatch.get() ;
+      drain = ( _deqLSN.size() > 0 && _hasPendingRecord() ) ? TRUE : FALSE ;
+      _LSNlatch.release() ;
+
+      while ( SDB_OK == rc && _streamScan && !isFull )
+      {
+         if ( 0 == _aliveStreamNum )
+         {
+            rc = _nextStreamPass() ;
+            continue ;
+         }
+
+         for ( UINT32 i = 0 ; i < _vecStream.size() && !isFull ; ++i )
+         {
+            pContext = _vecStream[ i ] ;
+            if ( NULL == pContext )
+            {
+               continue ;
+            }
+            else if ( drain )
+            {
+               if ( !_vecReadAhead[ i ] )
+               {
+                  continue ;
+               }
+               pContext->disablePrefetch() ;
+               _vecReadAhead[ i ] = FALSE ;
+            }
+            else if ( !_vecReadAhead[ i ] )
+            {
+               pContext->enablePrefetch( eduCB() ) ;
+               _vecReadAhead[ i ] = TRUE ;
+            }
+
+            rc = pContext->getMore( -1, buffObj, eduCB() ) ;
+            if ( SDB_DMS_EOC == rc )
+            {
+               _closeStream( i ) ;
+               rc = SDB_OK ;
+               continue ;
+            }
+            else if ( rc )
+            {
+               break ;
+            }
+
+            pData = _onObjFilter( buffObj.data(), buffObj.size(), dataLen ) ;
+            if ( dataLen > 0 )
+            {
+               alignLen = ossRoundUpToMultipleX( dataLen, sizeof( UINT32 ) ) ;
+               if ( _mb.idleSize() < alignLen )
+               {
+                  tempSize = ossRoundUpToMultipleX( alignLen - _mb.idleSize(),
+                                                    sizeof( UINT32 ) ) ;
+                  rc = _mb.extend( tempSize ) ;
+                  if ( rc )
+                  {
+                     PD_LOG( PDERROR, "Session[%s]: Failed to extend mb "
+                             "size[%d]", sessionName(), tempSize ) ;
+                     break ;
+                  }
+               }
+               ossMemcpy( _mb.writePtr(), pData, dataLen ) ;
+               _mb.writePtr( _mb.length() + alignLen ) ;
+            }
+            buffObj.release() ;
+
+            if ( _mb.length() >= CLS_SYNC_MAX_LEN ||
+                 ( time( NULL ) - bTime >= CLS_SYNC_MAX_TIME &&
+                   _mb.length() > 0 ) )
+            {
+               isFull = TRUE ;
+            }
+         }
+
+         if ( drain )
+         {
+            // nothing is read ahead, read as usual
+            drain = FALSE ;
+            isFull = _mb.length() > 0 ? TRUE : FALSE ;
+         }
+      }
+
+      if ( SDB_DMS_NOTEXIST == rc || SDB_DMS_TRUNCATED == rc )
+      {
+         _LSNlatch.get() ;
+         _findEnd = TRUE ;
+         _closeStreams() ;
+         _LSNlatch.release() ;
+         rc = SDB_OK ;
+      }
+      else if ( rc )
+      {
+         PD_LOG( PDERROR, "Session[%s]: Failed to get more from the streams, "
+                 "rc: %d", sessionName(), rc ) ;
+         goto error ;
+      }
+
+      if ( _mb.length() > 0 )
+      {
+         _queryLen = _mb.length() ;
+         _query = _mb.startPtr() ;
+         msg.header.header.messageLength = sizeof( MsgClsFSNotifyRes ) +
+                                           _queryLen ;
+         _agent->syncSend( handle, &(msg.header.header), (void*)_query,
+                           _queryLen ) ;
+      }
+      else
+      {
+         SDB_ASSERT( _findEnd, "Must be the end" ) ;
+         msg.eof = CLS_FS_EOF ;
+         msg.lsn = pmdGetKRCB()->getDPSCB()->expectLsn () ;
+
+         _LSNlatch.get () ;
+         if ( _deqLSN.size() > 0 )
+         {
+            msg.lsn.offset = _deqLSN.front() ;
+         }
+         else
+         {
+            msg.lsn.offset = _beginLSNOffset ;
+         }
+         _LSNlatch.release() ;
+         _agent->syncSend( handle, &msg ) ;
+      }
+
+   done:
+      PD_TRACE_EXITRC ( SDB__CLSSPLSS__SYNCRECD, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
 }
+
@@ -370,6 +370,12 @@ namespace engine
    }
 
    UINT32 _clsBucket::calcIndex( const CHAR * pData, UINT32 len )
+   {
+      return calcIndex( NULL, 0, pData, len ) ;
+   }
+
+   UINT32 _clsBucket::calcIndex( const CHAR *pPrefix, UINT32 prefixLen,
+                                 const CHAR *pData, UINT32 len )
    {
       if ( 0 == _bitSize )
       {
@@ -377,7 +383,14 @@ namespace engine
       }
 
       md5::md5digest digest ;
-      md5::md5( pData, len, digest ) ;
+      md5_state_t st ;
+      md5_init( &st ) ;
+      if ( pPrefix && prefixLen > 0 )
+      {
+         md5_append( &st, (const md5_byte_t *)pPrefix, prefixLen ) ;
+      }
+      md5_append( &st, (const md5_byte_t *)pData, len ) ;
+      md5_finish( &st, digest ) ;
       UINT32 hashValue = 0 ;
       UINT32 i = 0 ;
       while ( i++ < 4 )
@@ -214,6 +214,7 @@ namespace engine
       }
 
       _pReplBucket->reset() ;
+      _replayer.clearReplayModeCache() ;
    }
 
    void _clsReplDstSession::_onDetach()
@@ -620,6 +621,7 @@ namespace engine
       BOOLEAN needNotify = FALSE ;
 
       _status = CLS_SESSION_STATUS_FULL_SYNC ;
+      _replayer.clearReplayModeCache() ;
 
       if ( SDB_DB_NORMAL != PMD_DB_STATUS() &&
            SDB_DB_FULLSYNC != PMD_DB_STATUS() )
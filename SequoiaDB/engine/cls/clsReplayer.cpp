@@ -96,6 +96,7 @@ namespace engine
       UINT32 sequence = 0 ;
       BOOLEAN paralla = FALSE ;
       BOOLEAN updateSameOID = FALSE ;
+      CLS_REPLAY_MODE replayMode = CLS_REPLAY_SERIAL ;
       UINT32 bucketID = ~0 ;
 
       SDB_ASSERT( recordHeader && pBucket, "Invalid param" ) ;
@@ -192,42 +193,34 @@ namespace engine
 
       if ( LOG_TYPE_DATA_INSERT == recordHeader->_type ||
            LOG_TYPE_DATA_DELETE == recordHeader->_type ||
-           ( LOG_TYPE_DATA_UPDATE == recordHeader->_type && updateSameOID ) )
+           LOG_TYPE_DATA_UPDATE == recordHeader->_type )
       {
-         dmsStorageUnit *su = NULL ;
-         const CHAR *pShortName = NULL ;
-         dmsStorageUnitID suID = DMS_INVALID_SUID ;
-         rc = rtnResolveCollectionNameAndLock( fullname, _dmsCB, &su,
-                                               &pShortName, suID ) ;
-         if ( SDB_OK == rc )
+         replayMode = _getReplayMode( fullname ) ;
+         // the update which changes the match touches two records
+         if ( CLS_REPLAY_BY_ID == replayMode &&
+              LOG_TYPE_DATA_UPDATE == recordHeader->_type && !updateSameOID )
          {
-            dmsMBContext *mbContext = NULL ;
-            rc = su->data()->getMBContext( &mbContext, pShortName, SHARED ) ;
-            if ( SDB_OK == rc )
-            {
-               paralla = ( mbContext->mbStat()->_uniqueIdxNum <= 1 &&
-                           0 == mbContext->mbStat()->_textIdxNum ) ?
-                         TRUE : FALSE ;
-               su->data()->releaseMBContext( mbContext ) ;
-            }
-
-            if ( DMS_STORAGE_CAPPED == su->type() )
-            {
-               paralla = FALSE ;
-            }
-            _dmsCB->suUnlock( suID, SHARED ) ;
+            replayMode = CLS_REPLAY_SERIAL ;
          }
       }
 
-      if ( paralla )
+      if ( CLS_REPLAY_BY_ID == replayMode )
       {
          idEle = obj.getField( DMS_ID_KEY_NAME ) ;
          if ( !idEle.eoo() )
          {
-            bucketID = pBucket->calcIndex( idEle.value(),
+            bucketID = pBucket->calcIndex( fullname, ossStrlen( fullname ),
+                                           idEle.value(),
                                            idEle.valuesize() ) ;
          }
-         else if ( NULL != oidPtr )
+      }
+      else if ( CLS_REPLAY_BY_CL == replayMode )
+      {
+         bucketID = pBucket->calcIndex( fullname, ossStrlen( fullname ) ) ;
+      }
+      else if ( paralla )
+      {
+         if ( NULL != oidPtr )
          {
             CHAR tmpData[ sizeof( *oidPtr ) + sizeof( sequence ) ] = { 0 } ;
             ossMemcpy( tmpData, ( const CHAR * )( oidPtr->getData()),
@@ -247,6 +240,15 @@ namespace engine
       }
       else
       {
+         if ( LOG_TYPE_DATA_INSERT != recordHeader->_type &&
+              LOG_TYPE_DATA_DELETE != recordHeader->_type &&
+              LOG_TYPE_DATA_UPDATE != recordHeader->_type &&
+              LOG_TYPE_DATA_LOAD != recordHeader->_type )
+         {
+            // DDL may change the replay mode of the collections
+            clearReplayModeCache() ;
+         }
+
          rc = pBucket->waitEmptyWithCheck() ;
          if ( rc )
          {
@@ -302,6 +304,64 @@ namespace engine
       goto done ;
    }
 
+   void _clsReplayer::clearReplayModeCache()
+   {
+      _mapReplayMode.clear() ;
+   }
+
+   CLS_REPLAY_MODE _clsReplayer::_getReplayMode( const CHAR *fullName )
+   {
+      CLS_REPLAY_MODE replayMode = CLS_REPLAY_SERIAL ;
+      dmsStorageUnit *su = NULL ;
+      const CHAR *pShortName = NULL ;
+      dmsStorageUnitID suID = DMS_INVALID_SUID ;
+      dmsMBContext *mbContext = NULL ;
+      std::map< std::string, CLS_REPLAY_MODE >::iterator it ;
+
+      it = _mapReplayMode.find( fullName ) ;
+      if ( it != _mapReplayMode.end() )
+      {
+         return it->second ;
+      }
+
+      if ( SDB_OK != rtnResolveCollectionNameAndLock( fullName, _dmsCB, &su,
+                                                      &pShortName, suID ) )
+      {
+         // don't cache, the collection may be created later
+         return CLS_REPLAY_SERIAL ;
+      }
+
+      if ( SDB_OK == su->data()->getMBContext( &mbContext, pShortName,
+                                               SHARED ) )
+      {
+         if ( mbContext->mbStat()->_textIdxNum > 0 )
+         {
+            replayMode = CLS_REPLAY_SERIAL ;
+         }
+         else if ( mbContext->mbStat()->_uniqueIdxNum > 1 ||
+                   DMS_STORAGE_CAPPED == su->type() )
+         {
+            // the records depend on each other by the unique keys or the
+            // insert order, keep the order of the whole collection
+            replayMode = CLS_REPLAY_BY_CL ;
+         }
+         else
+         {
+            replayMode = CLS_REPLAY_BY_ID ;
+         }
+         su->data()->releaseMBContext( mbContext ) ;
+
+         if ( _mapReplayMode.size() >= CLS_REPLAY_MAX_CL_CACHE )
+         {
+            _mapReplayMode.clear() ;
+         }
+         _mapReplayMode[ fullName ] = replayMode ;
+      }
+      _dmsCB->suUnlock( suID, SHARED ) ;
+
+      return replayMode ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB__CLSREP_REPLAY, "_clsReplayer::replay" )
    INT32 _clsReplayer::replay( dpsLogRecordHeader *recordHeader,
                                pmdEDUCB *eduCB, BOOLEAN incCount )
@@ -430,6 +490,48 @@ namespace engine
             }
             break ;
          }
+         case LOG_TYPE_DATA_LOAD :
+         {
+            const CHAR *fullName = NULL ;
+            const CHAR *pBlock = NULL ;
+            UINT32 blockSize = 0 ;
+            UINT32 recordNum = 0 ;
+            rc = dpsRecord2Load( (CHAR *)recordHeader, &fullName, &pBlock,
+                                 blockSize, recordNum ) ;
+            if ( rc )
+            {
+               goto error ;
+            }
+
+            rc = rtnBulkLoad( fullName, pBlock, blockSize, recordNum,
+                              eduCB, _dmsCB, _dpsCB, 1, FALSE ) ;
+            if ( SDB_OK == rc && incCount )
+            {
+               _monDBCB->monOperationCountInc ( MON_INSERT_REPL,
+                                                recordNum ) ;
+            }
+            else if ( SDB_IXM_DUP_KEY == rc )
+            {
+               // some of the records may have been synced by the scan of
+               // full sync or split, insert the others one by one
+               UINT32 offset = 0 ;
+               PD_LOG( PDINFO, "Records of block[num: %u] already exist "
+                       "when load, insert them one by one", recordNum ) ;
+               rc = SDB_OK ;
+               while ( offset < blockSize )
+               {
+                  BSONObj obj( pBlock + offset ) ;
+                  rc = rtnReplayInsert( fullName, obj, FLG_INSERT_CONTONDUP,
+                                        eduCB, _dmsCB, _dpsCB, 1 ) ;
+                  if ( SDB_OK != rc )
+                  {
+                     break ;
+                  }
+                  offset += ossAlign4( (UINT32)obj.objsize() ) ;
+               }
+            }
+            break ;
+         }
          case LOG_TYPE_CS_CRT :
          {
             const CHAR *cs = NULL ;
@@ -862,6 +964,8 @@ namespace engine
       PD_TRACE_ENTRY ( SDB__CLSREP_ROLBCK );
       SDB_ASSERT( NULL != recordHeader, "head should not be NULL" ) ;
 
+      clearReplayModeCache() ;
+
       if ( !_dpsCB )
       {
          eduCB->insertLsn( recordHeader->_lsn, TRUE ) ;
@@ -903,6 +1007,48 @@ namespace engine
             }
             break ;
          }
+         case LOG_TYPE_DATA_LOAD :
+         {
+            const CHAR *fullname = NULL ;
+            const CHAR *pBlock = NULL ;
+            UINT32 blockSize = 0 ;
+            UINT32 recordNum = 0 ;
+            UINT32 offset = 0 ;
+            BSONObj hint = BSON(""<<IXM_ID_KEY_NAME) ;
+            rc = dpsRecord2Load( (const CHAR *)recordHeader, &fullname,
+                                 &pBlock, blockSize, recordNum ) ;
+            if ( SDB_OK != rc )
+            {
+               goto error ;
+            }
+
+            while ( offset < blockSize )
+            {
+               BSONObj obj( pBlock + offset ) ;
+               BSONElement idEle = obj.getField( DMS_ID_KEY_NAME ) ;
+               if ( idEle.eoo() )
+               {
+                  PD_LOG( PDWARNING, "replay: failed to parse"
+                          " oid from bson:[%s]",obj.toString().c_str() ) ;
+                  rc = SDB_INVALIDARG ;
+                  goto error ;
+               }
+
+               {
+                  BSONObjBuilder selectorBuilder ;
+                  selectorBuilder.append( idEle ) ;
+                  BSONObj selector = selectorBuilder.obj() ;
+                  rc = rtnDelete( fullname, selector, hint, 0, eduCB, _dmsCB,
+                                  _dpsCB, 1 ) ;
+                  if ( rc )
+                  {
+                     goto error ;
+                  }
+               }
+               offset += ossAlign4( (UINT32)obj.objsize() ) ;
+            }
+            break ;
+         }
          case LOG_TYPE_DATA_UPDATE :
          {
             const CHAR *fullname = NULL ;
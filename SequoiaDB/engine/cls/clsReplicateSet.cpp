@@ -184,6 +184,24 @@ namespace engine
       PD_TRACE_EXIT ( SDB__CLSREPSET_UNREGSN );
    }
 
+   BOOLEAN _clsReplicateSet::isCLInDataSync( UINT32 suLID, UINT32 clLID )
+   {
+      BOOLEAN inSync = FALSE ;
+
+      if ( _srcSessionNum > 0 )
+      {
+         UINT32 index = 0 ;
+         _vecLatch.lock_r () ;
+         while ( index < _srcSessionNum && !inSync )
+         {
+            inSync = _vecSrcSessions[index]->isSyncing( suLID, clLID ) ;
+            ++index ;
+         }
+         _vecLatch.release_r () ;
+      }
+      return inSync ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB__CLSREPSET_INIT, "_clsReplicateSet::initialize" )
    INT32 _clsReplicateSet::initialize ()
    {
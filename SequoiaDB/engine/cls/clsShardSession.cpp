@@ -41,6 +41,7 @@
 #include "rtnContextExplain.hpp"
 #include "rtnContextMainCL.hpp"
 #include "rtnContextDel.hpp"
+#include "rtnPreparedQuery.hpp"
 #include "utilCompressor.hpp"
 #include "pmdStartup.hpp"
 
@@ -1204,6 +1205,7 @@ namespace engine
             rtnQueryOptions options( matcher, selector, orderBy, hint,
                                      pCollectionName, numToSkip, numToReturn,
                                      flags ) ;
+            rtnPreparedBinding preparedBinding ;
             options.setMainCLName( mainCLName ) ;
 
             /*
@@ -1219,6 +1221,17 @@ namespace engine
             }
             else
             {
+               // the sub-collections are selected by the bound query
+               if ( options.testFlag( FLG_QUERY_PREPARED ) )
+               {
+                  rc = preparedBinding.bind( options ) ;
+                  if ( rc )
+                  {
+                     PD_LOG( PDERROR, "Session[%s] failed to bind prepared "
+                             "query, rc: %d", sessionName(), rc ) ;
+                     goto error ;
+                  }
+               }
                rc = _queryToMainCL( options, _pEDUCB, contextID, &pContext, w ) ;
             }
 
@@ -47,11 +47,15 @@ namespace engine
 {
    #define COORD_WAIT_EDU_ATTACH_TIMEOUT ( 60 * OSS_ONE_SEC )
    #define COORD_INVALID_TIMERID         (0)
+   #define COORD_CATA_LEASE_TIME         ( 30 * OSS_ONE_SEC )
+   // renew the lease several times before it expires
+   #define COORD_CATA_LEASE_RENEW_TIME   ( COORD_CATA_LEASE_TIME / 3 )
    /*
    note: _CoordCB implement
    */
    BEGIN_OBJ_MSG_MAP( _CoordCB, _pmdObjBase )
       ON_MSG ( MSG_CAT_REG_RES, _onCatRegisterRes )
+      ON_MSG ( MSG_CAT_SUBSCRIBE_RSP, _onCatSubscribeRes )
    END_OBJ_MSG_MAP()
 
    _CoordCB::_CoordCB()
@@ -60,6 +64,9 @@ namespace engine
     _pAgent( NULL ),
     _shardServiceID ( MSG_ROUTE_SHARD_SERVCIE ),
     _regTimerID ( COORD_INVALID_TIMERID ),
+    _leaseTimerID ( COORD_INVALID_TIMERID ),
+    _leaseSendTime ( 0 ),
+    _leaseExpireTime ( 0 ),
     _pDmsCB( NULL ),
     _pDpsCB( NULL ),
     _pRtnCB( NULL ),
@@ -206,6 +213,16 @@ namespace engine
          }
 
          _sendRegisterMsg () ;
+
+         _leaseTimerID = setTimer( COORD_CATA_LEASE_RENEW_TIME ) ;
+         if ( NET_INVALID_TIMER_ID == _leaseTimerID )
+         {
+            PD_LOG ( PDERROR, "Register lease timer failed" ) ;
+            rc = SDB_SYS ;
+            goto error ;
+         }
+
+         _sendSubscribeMsg () ;
       }
 
    done:
@@ -307,6 +324,10 @@ namespace engine
       {
          _sendRegisterMsg () ;
       }
+      else if ( timerID == _leaseTimerID )
+      {
+         _sendSubscribeMsg () ;
+      }
       else
       {
          _pmdObjBase::onTimer( timerID, interval ) ;
@@ -571,6 +592,82 @@ retry :
       goto done ;
    }
 
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__COORDCB__SNDSUBSCRIBEMSG, "_CoordCB::_sendSubscribeMsg" )
+   INT32 _CoordCB::_sendSubscribeMsg ()
+   {
+      PD_TRACE_ENTRY ( SDB__COORDCB__SNDSUBSCRIBEMSG ) ;
+      INT32 rc = SDB_OK ;
+      MsgCatSubscribeReq req ;
+
+      req.leaseTime = COORD_CATA_LEASE_TIME ;
+      // the lease starts before the catalog receives the request
+      _leaseSendTime = ossGetCurrentMilliseconds() ;
+
+      rc = _sendToCatlog( (MsgHeader *)&req ) ;
+      if ( rc )
+      {
+         PD_LOG ( PDWARNING, "Failed to send subscribe request to "
+                  "catalog, rc: %d", rc ) ;
+      }
+
+      PD_TRACE_EXITRC ( SDB__COORDCB__SNDSUBSCRIBEMSG, rc ) ;
+      return rc ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__COORDCB__ONCATSUBSCRIBERES, "_CoordCB::_onCatSubscribeRes" )
+   INT32 _CoordCB::_onCatSubscribeRes ( const NET_HANDLE &handle,
+                                        MsgHeader *pMsg )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__COORDCB__ONCATSUBSCRIBERES ) ;
+      MsgCatSubscribeRes *pRes = ( MsgCatSubscribeRes* )pMsg ;
+      BOOLEAN lapsed = FALSE ;
+
+      rc = MSG_GET_INNER_REPLY_RC( pMsg ) ;
+      if ( SDB_CLS_NOT_PRIMARY == rc )
+      {
+         CoordGroupInfoPtr cataGroupPtr ;
+         rc = _resource.updateCataGroupInfo( cataGroupPtr, _pEDUCB ) ;
+         PD_RC_CHECK ( rc, PDWARNING, "Fail to update catalog group "
+                       "info[rc:%d]", rc ) ;
+         // renew from the new primary at once
+         _sendSubscribeMsg () ;
+         goto done ;
+      }
+      PD_RC_CHECK ( rc, PDWARNING, "Subscribe catalog changes failed, "
+                    "rc: %d", rc ) ;
+
+      PD_CHECK ( pMsg->messageLength >= (INT32)sizeof( MsgCatSubscribeRes ),
+                 SDB_INVALIDARG, error, PDERROR, "Subscribe response "
+                 "length(%d) is invalid", pMsg->messageLength ) ;
+
+      lapsed = ( _leaseExpireTime < ossGetCurrentMilliseconds() ) ;
+      _leaseExpireTime = _leaseSendTime + pRes->leaseTime ;
+
+      /// The catalog changes may be missed when the lease was lost, so
+      /// refresh all the cached catalog info. The sessions go on with the
+      /// cache, and will retry by the version when it's stale.
+      if ( pRes->isNew || lapsed )
+      {
+         PD_LOG ( PDEVENT, "The lease of catalog changes is renewed "
+                  "[new: %u, lapsed: %d], refresh all catalog info",
+                  pRes->isNew, lapsed ) ;
+         rc = _resource.refreshAllCataInfo( _pEDUCB ) ;
+         if ( rc )
+         {
+            PD_LOG ( PDWARNING, "Refresh all catalog info failed, rc: %d",
+                     rc ) ;
+            rc = SDB_OK ;
+         }
+      }
+
+   done:
+      PD_TRACE_EXITRC ( SDB__COORDCB__ONCATSUBSCRIBERES, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
    INT32 _CoordCB::_defaultMsgFunc( NET_HANDLE handle, MsgHeader *pMsg )
    {
       INT32 rc = SDB_OK ;
@@ -593,7 +690,8 @@ retry :
            MSG_BS_DISCONNECT      == pMsg->opCode ||
            MSG_COM_REMOTE_DISC    == pMsg->opCode ||
            MSG_CLS_GINFO_UPDATED  == pMsg->opCode ||
-           MSG_CAT_GRP_CHANGE_NTY == pMsg->opCode )
+           MSG_CAT_GRP_CHANGE_NTY == pMsg->opCode ||
+           MSG_CAT_CATALOG_CHANGE_NTY == pMsg->opCode )
       {
          _needReply = FALSE ;
       }
@@ -650,6 +748,9 @@ retry :
          case MSG_CAT_GRP_CHANGE_NTY :
             rc = _processCatGrpChgNty() ;
             break ;
+         case MSG_CAT_CATALOG_CHANGE_NTY :
+            rc = _processCataChangeNty( pMsg ) ;
+            break ;
          case MSG_BS_MSG_REQ :
             rc = _processMsgReq( pMsg ) ;
             break ;
@@ -1013,6 +1114,55 @@ retry :
       return rc ;
    }
 
+   INT32 _CoordCB::_processCataChangeNty ( MsgHeader *pMsg )
+   {
+      INT32 rc = SDB_OK ;
+      MsgCatCatalogChangeNty *pNty = ( MsgCatCatalogChangeNty* )pMsg ;
+      vector< string > names ;
+
+      if ( pMsg->messageLength < (INT32)( sizeof( MsgCatCatalogChangeNty ) +
+                                          sizeof( INT32 ) ) )
+      {
+         PD_LOG ( PDERROR, "Catalog change notification length(%d) is "
+                  "invalid", pMsg->messageLength ) ;
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+
+      try
+      {
+         BSONObj obj( (const CHAR*)pNty->data ) ;
+         BSONObjIterator itr( obj.getObjectField( FIELD_NAME_COLLECTION ) ) ;
+         while ( itr.more() )
+         {
+            BSONElement e = itr.next() ;
+            if ( String == e.type() )
+            {
+               names.push_back( e.valuestr() ) ;
+            }
+         }
+      }
+      catch( std::exception &e )
+      {
+         PD_LOG ( PDERROR, "Parse catalog change notification occur "
+                  "exception: %s", e.what() ) ;
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+
+      rc = _resource.refreshCataInfo( names, _pEDUCB ) ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG ( PDWARNING, "Fail to refresh catalog info of the changed "
+                  "collections, rc: %d", rc ) ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
    //PD_TRACE_DECLARE_FUNCTION ( SDB__COORDCB__DELCTXHDL, "_CoordCB::_delContextByHandle" )
    void _CoordCB::_delContextByHandle( const UINT32 &handle )
    {
@@ -139,12 +139,13 @@ namespace engine
    UINT32 _rtnContextCoord::getCachedRecordNum()
    {
       UINT32 recordNum = 0 ;
-      SUB_ORDERED_CTX_MAP::iterator it = _orderedContextMap.begin() ;
-      while( it != _orderedContextMap.end() )
+      for ( UINT32 i = 0 ; i < _orderedContextTree.capacity() ; ++i )
       {
-         rtnSubContext *pSub = it->second ;
-         recordNum += pSub->recordNum() ;
-         ++it ;
+         rtnSubContext *pSub = _orderedContextTree.at( i ) ;
+         if ( pSub )
+         {
+            recordNum += pSub->recordNum() ;
+         }
       }
       if ( _numToSkip > recordNum )
       {
@@ -170,17 +171,21 @@ namespace engine
          _getPrepareNodesData( cb, TRUE ) ;
       }
 
-      SUB_ORDERED_CTX_MAP::iterator itSub = _orderedContextMap.begin() ;
-      while ( _orderedContextMap.end() != itSub )
+      for ( UINT32 i = 0 ; i < _orderedContextTree.capacity() ; ++i )
       {
-         rtnSubContext* rtnSubCtx = itSub->second ;
+         rtnSubContext* rtnSubCtx = _orderedContextTree.at( i ) ;
+         if ( NULL == rtnSubCtx )
+         {
+            continue ;
+         }
          pSubContext = dynamic_cast<coordSubContext*>( rtnSubCtx ) ;
          _prepareContextMap.insert( EMPTY_CONTEXT_MAP::value_type(
                                     pSubContext->getRouteID().value,
                                     pSubContext ) ) ;
-         ++itSub ;
       }
-      _orderedContextMap.clear() ;
+      _orderedContextTree.clear() ;
+      // the prefetching ones are in the tree
+      _prefetchContextMap.clear() ;
 
       EMPTY_CONTEXT_MAP::iterator it = _emptyContextMap.begin() ;
       while ( it != _emptyContextMap.end() )
@@ -402,6 +407,62 @@ namespace engine
       goto done ;
    }
 
+   INT32 _rtnContextCoord::_prefetchSubCtx( pmdEDUCB *cb,
+                                            coordSubContext *pSubContext )
+   {
+      INT32 rc = SDB_OK ;
+      MsgOpGetMore msgReq ;
+      MsgRouteID routeID = pSubContext->getRouteID() ;
+      pmdSubSession *pSub = NULL ;
+
+      if ( -1 == pSubContext->contextID() ||
+           pSubContext->hasPrefetched() ||
+           _prefetchContextMap.end() !=
+           _prefetchContextMap.find( routeID.value ) )
+      {
+         goto done ;
+      }
+
+      msgFillGetMoreMsg( msgReq, cb->getTID(), pSubContext->contextID(),
+                         -1, 0 ) ;
+
+      pSub = _pSession->addSubSession( routeID.value ) ;
+      pSub->setReqMsg( (MsgHeader*)&msgReq, PMD_EDU_MEM_NONE ) ;
+
+      rc = _pSession->sendMsg( pSub ) ;
+      if ( rc )
+      {
+         PD_LOG( PDWARNING, "Send prefetch message[ContextID:%lld] to "
+                 "node[%s] failed, rc: %d", msgReq.contextID,
+                 routeID2String( routeID ).c_str(), rc ) ;
+         goto error ;
+      }
+
+      _prefetchContextMap.insert( EMPTY_CONTEXT_MAP::value_type(
+                                  routeID.value, pSubContext ) ) ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   void _rtnContextCoord::_prefetchOrderedSubCtxs( pmdEDUCB *cb )
+   {
+      // send the get more to the sub contexts which still have data, so
+      // that the next data is here when their data is drained
+      for ( UINT32 i = 0 ; i < _orderedContextTree.capacity() ; ++i )
+      {
+         rtnSubContext *pSub = _orderedContextTree.at( i ) ;
+         if ( NULL != pSub &&
+              SDB_OK != _prefetchSubCtx( cb, (coordSubContext*)pSub ) )
+         {
+            // the get more is sent again when the data is drained
+            break ;
+         }
+      }
+   }
+
    INT32 _rtnContextCoord::_getPrepareNodesData( pmdEDUCB * cb,
                                                  BOOLEAN waitAll )
    {
@@ -509,12 +570,10 @@ namespace engine
    {
       INT32 rc = SDB_OK ;
 
-      if ( _needReOrder && 1 == _orderedContextMap.size() &&
+      if ( _needReOrder && 1 == _orderedContextTree.size() &&
            _requireExplicitSorting() )
       {
-         rtnSubContext* subCtx = _orderedContextMap.begin()->second ;
-
-         _orderedContextMap.clear() ;
+         rtnSubContext* subCtx = _orderedContextTree.popTop() ;
 
          rc = _saveNonEmptyOrderedSubCtx( subCtx ) ;
          if ( rc != SDB_OK )
@@ -553,6 +612,17 @@ namespace engine
       iter = _prepareContextMap.find( pReply->header.routeID.value ) ;
       if ( _prepareContextMap.end() == iter )
       {
+         // the reply of the prefetching one is kept until its data is
+         // drained
+         iter = _prefetchContextMap.find( pReply->header.routeID.value ) ;
+         if ( _prefetchContextMap.end() != iter &&
+              iter->second->contextID() == pReply->contextID )
+         {
+            iter->second->setPrefetched( pReply ) ;
+            _prefetchContextMap.erase( iter ) ;
+            goto done ;
+         }
+
          rc = SDB_INVALIDARG;
          PD_LOG ( PDERROR, "Failed to append the data, no match context"
                   "(groupID=%u, nodeID=%u, serviceID=%u)",
@@ -599,17 +669,12 @@ namespace engine
       {
          _prepareContextMap.erase( iter ) ;
 
-         try
-         {
-            _orderedContextMap.insert(
-               SUB_ORDERED_CTX_MAP::value_type( _emptyKey, pSubContext ) ) ;
-         }
-         catch( std::exception& e )
+         rc = _orderedContextTree.push( pSubContext, _emptyKey ) ;
+         if ( rc )
          {
-            rc = SDB_SYS ;
             pSubContext->clearData() ;
             SDB_OSS_DEL pSubContext ;
-            PD_LOG( PDERROR, "occur unexpected error:%s", e.what() );
+            PD_LOG( PDERROR, "Failed to save sub ctx, rc: %d", rc ) ;
             goto error ;
          }
       }
@@ -707,7 +772,7 @@ namespace engine
 
       SDB_ASSERT ( NULL != pReply, "reply can't be NULL" ) ;
 
-      if ( _orderedContextMap.empty() && _emptyContextMap.empty() &&
+      if ( _orderedContextTree.empty() && _emptyContextMap.empty() &&
            _prepareContextMap.empty() )
       {
          isEmpty = TRUE ;
@@ -776,6 +841,17 @@ namespace engine
          }
          _prepareContextMap.erase ( iter ) ;
       }
+      else
+      {
+         // the prefetching one still has data in the tree, it is released
+         // when the data is drained
+         iter = _prefetchContextMap.find( routeID.value ) ;
+         if ( iter != _prefetchContextMap.end() )
+         {
+            iter->second->setNoMore() ;
+            _prefetchContextMap.erase( iter ) ;
+         }
+      }
    }
 
    INT32 _rtnContextCoord::_prepareSubCtxData( _pmdEDUCB *cb )
@@ -792,9 +868,23 @@ namespace engine
       PD_RC_CHECK( rc, PDERROR, "Send request to empty nodes failed, rc: %d",
                    rc ) ;
 
-      rc = _getPrepareNodesData( cb, _requireExplicitSorting() ) ;
-      PD_RC_CHECK( rc, PDERROR, "Get data from prepare nodes failed, rc: %d",
-                   rc ) ;
+      if ( _requireExplicitSorting() && !_prefetchContextMap.empty() )
+      {
+         // only the drained ones are waited, the replies of the
+         // prefetching ones are kept when they come
+         while ( !_prepareContextMap.empty() )
+         {
+            rc = _getPrepareNodesData( cb, FALSE ) ;
+            PD_RC_CHECK( rc, PDERROR, "Get data from prepare nodes failed, "
+                         "rc: %d", rc ) ;
+         }
+      }
+      else
+      {
+         rc = _getPrepareNodesData( cb, _requireExplicitSorting() ) ;
+         PD_RC_CHECK( rc, PDERROR, "Get data from prepare nodes failed, "
+                      "rc: %d", rc ) ;
+      }
 
    done:
       return rc ;
@@ -810,15 +900,53 @@ namespace engine
    INT32 _rtnContextCoord::_saveEmptyOrderedSubCtx( rtnSubContext* subCtx )
    {
       INT32 rc = SDB_OK ;
+      coordSubContext* coordSubCtx = NULL ;
+      EMPTY_CONTEXT_MAP::iterator iter ;
 
       SDB_ASSERT( NULL != subCtx, "subCtx should be not null" ) ;
 
+      coordSubCtx = dynamic_cast<coordSubContext*>( subCtx ) ;
+      if ( coordSubCtx->hasPrefetched() )
+      {
+         // the next data is here, put it back to the tree without waiting
+         BOOLEAN skipData = FALSE ;
+
+         coordSubCtx->appendPrefetched() ;
+         rc = _processSubContext( coordSubCtx, skipData ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to process prefetched data of "
+                      "sub context[%lld], rc: %d",
+                      coordSubCtx->contextID(), rc ) ;
+
+         if ( !skipData && coordSubCtx->recordNum() > 0 )
+         {
+            if ( _requireExplicitSorting() )
+            {
+               rc = _saveNonEmptyOrderedSubCtx( coordSubCtx ) ;
+            }
+            else
+            {
+               rc = _orderedContextTree.push( coordSubCtx, _emptyKey ) ;
+            }
+            goto done ;
+         }
+      }
+
       try
       {
-         coordSubContext* coordSubCtx = dynamic_cast<coordSubContext*>( subCtx ) ;
-         _emptyContextMap.insert(
-            EMPTY_CONTEXT_MAP::value_type(
-               coordSubCtx->getRouteID().value, coordSubCtx ) ) ;
+         iter = _prefetchContextMap.find( coordSubCtx->getRouteID().value ) ;
+         if ( _prefetchContextMap.end() != iter )
+         {
+            // the get more has been sent, wait for its reply
+            _prepareContextMap.insert( EMPTY_CONTEXT_MAP::value_type(
+                                       iter->first, iter->second ) ) ;
+            _prefetchContextMap.erase( iter ) ;
+         }
+         else
+         {
+            _emptyContextMap.insert(
+               EMPTY_CONTEXT_MAP::value_type(
+                  coordSubCtx->getRouteID().value, coordSubCtx ) ) ;
+         }
       }
       catch( std::exception& e )
       {
@@ -836,11 +964,9 @@ namespace engine
    INT32 _rtnContextCoord::_getNonEmptyNormalSubCtx( _pmdEDUCB *cb, rtnSubContext*& subCtx )
    {
       INT32 rc = SDB_OK ;
-      SUB_ORDERED_CTX_MAP::iterator iter ;
-
       subCtx = NULL ;
 
-      while ( _orderedContextMap.size() == 0 )
+      while ( _orderedContextTree.empty() )
       {
          if ( _emptyContextMap.size() + _prepareContextMap.size() == 0 )
          {
@@ -855,10 +981,9 @@ namespace engine
          }
       }
 
-      SDB_ASSERT( _orderedContextMap.size() != 0, "_orderedContextMap should not be empty" ) ;
+      SDB_ASSERT( !_orderedContextTree.empty(), "_orderedContextTree should not be empty" ) ;
 
-      iter = _orderedContextMap.begin() ;
-      subCtx = iter->second ;
+      subCtx = _orderedContextTree.top() ;
 
    done:
       return rc ;
@@ -874,16 +999,7 @@ namespace engine
       SDB_ASSERT( subCtx->recordNum() == 0, "sub ctx is not empty" ) ;
 
 
-      for ( SUB_ORDERED_CTX_MAP::iterator iter = _orderedContextMap.begin() ;
-            iter != _orderedContextMap.end() ;
-            ++iter )
-      {
-         if ( iter->second == subCtx )
-         {
-            _orderedContextMap.erase ( iter ) ;
-            break ;
-         }
-      }
+      _orderedContextTree.erase( subCtx ) ;
 
       rc = _saveEmptyOrderedSubCtx( subCtx ) ;
       if ( SDB_OK != rc )
@@ -912,6 +1028,10 @@ namespace engine
       if ( _numToReturn != 0 && !_hitEnd && _preRead )
       {
          rc = _send2EmptyNodes( cb ) ;
+         if ( SDB_OK == rc && _requireExplicitSorting() )
+         {
+            _prefetchOrderedSubCtxs( cb ) ;
+         }
       }
 
       return rc ;
@@ -928,6 +1048,7 @@ namespace engine
      _routeID( routeID )
    {
       _pData = NULL ;
+      _pPrefetched = NULL ;
       _curOffset = 0 ;
       _recordNum = 0 ;
    }
@@ -939,6 +1060,11 @@ namespace engine
          SDB_OSS_FREE ( _pData ) ;
          _pData = NULL;
       }
+      if ( NULL != _pPrefetched )
+      {
+         SDB_OSS_FREE ( _pPrefetched ) ;
+         _pPrefetched = NULL ;
+      }
    }
 
    INT32 _coordSubContext::remainLength()
@@ -1015,6 +1141,21 @@ namespace engine
       PD_TRACE_EXIT ( SDB_COSUBCON_APPENDDATA ) ;
    }
 
+   void _coordSubContext::setPrefetched( MsgOpReply *pReply )
+   {
+      SDB_ASSERT( NULL == _pPrefetched, "Prefetched data must be NULL" ) ;
+      _pPrefetched = pReply ;
+   }
+
+   void _coordSubContext::appendPrefetched()
+   {
+      MsgOpReply *pReply = _pPrefetched ;
+
+      SDB_ASSERT( NULL != pReply, "Prefetched data can't be NULL" ) ;
+      _pPrefetched = NULL ;
+      appendData( pReply ) ;
+   }
+
    void _coordSubContext::clearData()
    {
       _pData = NULL; //don't delete it, the fun-caller will delete it
@@ -1023,6 +1164,17 @@ namespace engine
       _isOrderKeyChange = TRUE;
    }
 
+   CHAR* _coordSubContext::detachData()
+   {
+      CHAR *pData = ( CHAR* )_pData ;
+
+      _pData = NULL ;
+      _curOffset = 0 ;
+      _recordNum = 0 ;
+      _isOrderKeyChange = TRUE ;
+      return pData ;
+   }
+
    MsgRouteID _coordSubContext::getRouteID()
    {
       return _routeID;
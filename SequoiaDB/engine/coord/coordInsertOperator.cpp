@@ -296,64 +296,66 @@ namespace engine
       }
    }
 
-   // PD_TRACE_DECLARE_FUNCTION ( COORD_INSERTOPR_SHARDANOBJ, "_coordInsertOperator::shardAnObj" )
-   INT32 _coordInsertOperator::shardAnObj( const CHAR *pInsertor,
-                                           CoordCataInfoPtr &cataInfo,
+   // PD_TRACE_DECLARE_FUNCTION ( COORD_INSERTOPR_SHARDBATCH, "_coordInsertOperator::shardBatch" )
+   INT32 _coordInsertOperator::shardBatch( CoordCataInfoPtr &cataInfo,
                                            const netIOV &fixed,
                                            GROUP_2_IOVEC &datas )
    {
       INT32 rc = SDB_OK ;
-      PD_TRACE_ENTRY ( COORD_INSERTOPR_SHARDANOBJ ) ;
+      PD_TRACE_ENTRY ( COORD_INSERTOPR_SHARDBATCH ) ;
+      UINT32 lastGroupID = 0 ;
+      netIOVec *pIOVec = NULL ;
 
-      try
+      rc = cataInfo->getGroupByRecords( _routeBatch ) ;
+      if ( rc )
+      {
+         PD_LOG( PDERROR, "Failed to get the groups of records from "
+                 "catalog info[%s], rc: %d",
+                 cataInfo->toBSON().toString().c_str(), rc ) ;
+         goto error ;
+      }
+
+      // the groups of the records are known, build the scatter list of each
+      // group in one pass, the adjacent records of a group are merged
+      for ( UINT32 i = 0 ; i < _routeBatch.size() ; ++i )
       {
-         BSONObj insertObj( pInsertor ) ;
-         UINT32 roundLen = ossRoundUpToMultipleX( insertObj.objsize(), 4 ) ;
-         UINT32 groupID = 0 ;
+         const CHAR *pInsertor = _routeBatch.record( i ) ;
+         UINT32 groupID = _routeBatch.groupID( i ) ;
+         UINT32 roundLen = ossRoundUpToMultipleX(
+                              *( const INT32* )pInsertor, 4 ) ;
+         UINT32 size = 0 ;
 
-         rc = cataInfo->getGroupByRecord( insertObj, groupID ) ;
-         if ( rc )
+         if ( NULL == pIOVec || groupID != lastGroupID )
          {
-            PD_LOG( PDERROR, "Failed to get the groupid for obj[%s] from "
-                    "catalog info[%s], rc: %d", insertObj.toString().c_str(),
-                    cataInfo->toBSON().toString().c_str(), rc ) ;
-            goto error ;
+            pIOVec = &datas[ groupID ] ;
+            lastGroupID = groupID ;
          }
 
+         size = pIOVec->size() ;
+         if ( size > 0 )
          {
-            netIOVec &iovec = datas[ groupID ] ;
-            UINT32 size = iovec.size() ;
-            if( size > 0 )
+            netIOV &last = (*pIOVec)[ size - 1 ] ;
+            if ( (const CHAR*)( last.iovBase ) + last.iovLen == pInsertor )
             {
-               if ( (const CHAR*)( iovec[size-1].iovBase ) +
-                    iovec[size-1].iovLen == pInsertor )
-               {
-                  iovec[size-1].iovLen += roundLen ;
-               }
-               else
-               {
-                  iovec.push_back( netIOV( pInsertor, roundLen ) ) ;
-               }
+               last.iovLen += roundLen ;
             }
             else
             {
-               iovec.push_back( fixed ) ;
-               iovec.push_back( netIOV( pInsertor, roundLen ) ) ;
+               pIOVec->push_back( netIOV( pInsertor, roundLen ) ) ;
             }
          }
-      }
-      catch ( std::exception &e )
-      {
-         PD_LOG( PDERROR, "Failed to shard the data, received unexpected "
-                 "error: %s", e.what() ) ;
-         rc = SDB_SYS ;
-         goto error ;
+         else
+         {
+            pIOVec->push_back( fixed ) ;
+            pIOVec->push_back( netIOV( pInsertor, roundLen ) ) ;
+         }
       }
 
    done:
-      PD_TRACE_EXITRC ( COORD_INSERTOPR_SHARDANOBJ, rc ) ;
+      PD_TRACE_EXITRC ( COORD_INSERTOPR_SHARDBATCH, rc ) ;
       return rc ;
    error:
+      datas.clear() ;
       goto done ;
    }
 
@@ -367,18 +369,18 @@ namespace engine
       INT32 rc = SDB_OK;
       PD_TRACE_ENTRY ( COORD_INSERTOPR_SHARDBYGROUP ) ;
 
-      while ( count > 0 )
+      _routeBatch.clear() ;
+      if ( count > 0 )
       {
-         rc = shardAnObj( pInsertor, cataInfo, fixed, datas ) ;
-         if ( rc )
-         {
-            PD_LOG( PDERROR, "Failed to shard the obj, rc: %d", rc ) ;
-            goto error ;
-         }
+         _routeBatch.reserve( count ) ;
+      }
 
+      while ( count > 0 )
+      {
          try
          {
             BSONObj boInsertor( pInsertor ) ;
+            _routeBatch.push( pInsertor ) ;
             pInsertor += ossRoundUpToMultipleX( boInsertor.objsize(), 4 ) ;
          }
          catch ( std::exception &e )
@@ -391,6 +393,13 @@ namespace engine
          --count ;
       }
 
+      rc = shardBatch( cataInfo, fixed, datas ) ;
+      if ( rc )
+      {
+         PD_LOG( PDERROR, "Failed to shard the objs, rc: %d", rc ) ;
+         goto error ;
+      }
+
    done:
       PD_TRACE_EXITRC ( COORD_INSERTOPR_SHARDBYGROUP, rc ) ;
       return rc ;
@@ -413,6 +422,8 @@ namespace engine
 
       GROUP_2_IOVEC newDatas ;
       GROUP_2_IOVEC::iterator it = datas.begin() ;
+
+      _routeBatch.clear() ;
       while ( it != datas.end() )
       {
          netIOVec &iovec = it->second ;
@@ -438,20 +449,20 @@ namespace engine
                   goto error ;
                }
 
-               rc = shardAnObj( pData, cataInfo, fixed, newDatas ) ;
-               if ( rc )
-               {
-                  PD_LOG( PDERROR, "Reshard the insert record failed, rc: %d",
-                          rc ) ;
-                  goto error ;
-               }
-
+               _routeBatch.push( pData ) ;
                pData += roundSize ;
                offset += roundSize ;
             }
          }
          ++it ;
       }
+
+      rc = shardBatch( cataInfo, fixed, newDatas ) ;
+      if ( rc )
+      {
+         PD_LOG( PDERROR, "Reshard the insert records failed, rc: %d", rc ) ;
+         goto error ;
+      }
       datas = newDatas ;
 
    done:
@@ -540,64 +551,107 @@ namespace engine
       _vecObject.clear() ;
    }
 
-   INT32 _coordInsertOperator::shardAnObj( const CHAR *pInsertor,
-                                           CoordCataInfoPtr &cataInfo,
-                                           pmdEDUCB * cb,
-                                           GroupSubCLMap &groupSubCLMap )
+   // PD_TRACE_DECLARE_FUNCTION ( COORD_INSERTOPR_SHARDMAINBATCH, "_coordInsertOperator::shardMainBatch" )
+   INT32 _coordInsertOperator::shardMainBatch( CoordCataInfoPtr &cataInfo,
+                                               pmdEDUCB *cb,
+                                               GroupSubCLMap &groupSubCLMap )
    {
       INT32 rc = SDB_OK ;
-      string subCLName ;
-      UINT32 groupID = CAT_INVALID_GROUPID ;
+      PD_TRACE_ENTRY ( COORD_INSERTOPR_SHARDMAINBATCH ) ;
+      // sub-collection name -> positions of its records in the batch
+      map< string, vector< UINT32 > > subCLRecords ;
+      map< string, vector< UINT32 > >::iterator itSub ;
+
+      rc = cataInfo->getSubCLNameByRecords( _routeBatch ) ;
+      if ( rc )
+      {
+         PD_LOG( PDWARNING, "Couldn't find the sub-collections of records "
+                 "in cl's(%s) catalog info[%s], rc: %d",
+                 cataInfo->getName(), cataInfo->toBSON().toString().c_str(),
+                 rc ) ;
+         goto error ;
+      }
 
       try
       {
-         BSONObj insertObj( pInsertor ) ;
-         CoordCataInfoPtr subClCataInfo ;
-         UINT32 roundLen = ossRoundUpToMultipleX( insertObj.objsize(), 4 ) ;
+         const string *pLastName = NULL ;
+         vector< UINT32 > *pPositions = NULL ;
 
-         rc = cataInfo->getSubCLNameByRecord( insertObj, subCLName ) ;
-         if ( rc )
+         // the adjacent records usually go to the same sub-collection
+         for ( UINT32 i = 0 ; i < _routeBatch.size() ; ++i )
          {
-            PD_LOG( PDWARNING, "Couldn't find the match[%s] sub-collection "
-                    "in cl's(%s) catalog info[%s], rc: %d",
-                    insertObj.toString().c_str(), cataInfo->getName(),
-                    cataInfo->toBSON().toString().c_str(),
-                    rc ) ;
-            goto error ;
+            const string &subCLName = _routeBatch.subCLName( i ) ;
+            if ( NULL == pPositions || &subCLName != pLastName )
+            {
+               pPositions = &subCLRecords[ subCLName ] ;
+               pLastName = &subCLName ;
+            }
+            pPositions->push_back( i ) ;
          }
 
-         rc = _pResource->getOrUpdateCataInfo( subCLName.c_str(),
-                                               subClCataInfo, cb ) ;
-         if ( rc )
+         // then each sub-collection routes its records to groups in one
+         // batch, with its catalog info got once
+         for ( itSub = subCLRecords.begin() ; itSub != subCLRecords.end() ;
+               ++itSub )
          {
-            PD_LOG( PDWARNING, "Get sub-collection[%s]'s catalog info "
-                    "failed, rc: %d", subCLName.c_str(), rc ) ;
-            goto error ;
-         }
+            const string &subCLName = itSub->first ;
+            vector< UINT32 > &positions = itSub->second ;
+            CoordCataInfoPtr subClCataInfo ;
+            UINT32 lastGroupID = 0 ;
+            netIOVec *pIOVec = NULL ;
+
+            rc = _pResource->getOrUpdateCataInfo( subCLName.c_str(),
+                                                  subClCataInfo, cb ) ;
+            if ( rc )
+            {
+               PD_LOG( PDWARNING, "Get sub-collection[%s]'s catalog info "
+                       "failed, rc: %d", subCLName.c_str(), rc ) ;
+               goto error ;
+            }
 
-         rc = subClCataInfo->getGroupByRecord( insertObj, groupID ) ;
-         if ( rc )
-         {
-            PD_LOG( PDWARNING, "Couldn't find the match[%s] catalog of "
-                    "sub-collection(%s), rc: %d",
-                    insertObj.toString().c_str(),
-                    subClCataInfo->toBSON().toString().c_str(),
-                    rc ) ;
-            goto error ;
-         }
+            _subRouteBatch.clear() ;
+            _subRouteBatch.reserve( positions.size() ) ;
+            for ( UINT32 i = 0 ; i < positions.size() ; ++i )
+            {
+               _subRouteBatch.push( _routeBatch.record( positions[ i ] ) ) ;
+            }
 
-         (groupSubCLMap[ groupID ])[ subCLName ].push_back(
-            netIOV( (const void*)pInsertor, roundLen ) ) ;
+            rc = subClCataInfo->getGroupByRecords( _subRouteBatch ) ;
+            if ( rc )
+            {
+               PD_LOG( PDWARNING, "Couldn't find the groups of records in "
+                       "sub-collection(%s), rc: %d",
+                       subClCataInfo->toBSON().toString().c_str(), rc ) ;
+               goto error ;
+            }
+
+            // one iov each record, the sub-collection's object number is
+            // the size of its scatter list
+            for ( UINT32 i = 0 ; i < _subRouteBatch.size() ; ++i )
+            {
+               const CHAR *pInsertor = _subRouteBatch.record( i ) ;
+               UINT32 groupID = _subRouteBatch.groupID( i ) ;
+               if ( NULL == pIOVec || groupID != lastGroupID )
+               {
+                  pIOVec = &( groupSubCLMap[ groupID ][ subCLName ] ) ;
+                  lastGroupID = groupID ;
+               }
+               pIOVec->push_back( netIOV( (const void*)pInsertor,
+                                  ossRoundUpToMultipleX(
+                                     *( const INT32* )pInsertor, 4 ) ) ) ;
+            }
+         }
       }
       catch ( std::exception &e )
       {
-         PD_LOG( PDERROR, "Parse the insert object occur exception: %s",
+         PD_LOG( PDERROR, "Shard the insert records occur exception: %s",
                  e.what() ) ;
          rc = SDB_SYS ;
          goto error ;
       }
 
    done:
+      PD_TRACE_EXITRC ( COORD_INSERTOPR_SHARDMAINBATCH, rc ) ;
       return rc ;
    error:
       goto done ;
@@ -611,18 +665,18 @@ namespace engine
    {
       INT32 rc = SDB_OK ;
 
-      while ( count > 0 )
+      _routeBatch.clear() ;
+      if ( count > 0 )
       {
-         rc = shardAnObj( pInsertor, cataInfo, cb, groupSubCLMap ) ;
-         if ( rc )
-         {
-            PD_LOG( PDERROR, "Failed to shard the object, rc: %d", rc ) ;
-            goto error ;
-         }
+         _routeBatch.reserve( count ) ;
+      }
 
+      while ( count > 0 )
+      {
          try
          {
             BSONObj boInsertor( pInsertor ) ;
+            _routeBatch.push( pInsertor ) ;
             pInsertor += ossRoundUpToMultipleX( boInsertor.objsize(), 4 ) ;
             --count ;
          }
@@ -635,6 +689,13 @@ namespace engine
          }
       }
 
+      rc = shardMainBatch( cataInfo, cb, groupSubCLMap ) ;
+      if ( rc )
+      {
+         PD_LOG( PDERROR, "Failed to shard the objects, rc: %d", rc ) ;
+         goto error ;
+      }
+
    done:
       return rc;
    error:
@@ -649,6 +710,7 @@ namespace engine
       INT32 rc = SDB_OK ;
       GroupSubCLMap groupSubCLMapNew ;
 
+      _routeBatch.clear() ;
       GroupSubCLMap::iterator iterGroup = groupSubCLMap.begin() ;
       while ( iterGroup != groupSubCLMap.end() )
       {
@@ -660,20 +722,19 @@ namespace engine
 
             for ( UINT32 i = 0 ; i < size ; ++i )
             {
-               netIOV &ioItem = iovec[ i ] ;
-               rc = shardAnObj( (const CHAR*)ioItem.iovBase, cataInfo,
-                                cb, groupSubCLMapNew ) ;
-               if ( rc )
-               {
-                  PD_LOG( PDWARNING, "Failed to reshard the object, rc: %d",
-                          rc ) ;
-                  goto error ;
-               }
+               _routeBatch.push( (const CHAR*)iovec[ i ].iovBase ) ;
             }
             ++iterCL ;
          }
          ++iterGroup ;
       }
+
+      rc = shardMainBatch( cataInfo, cb, groupSubCLMapNew ) ;
+      if ( rc )
+      {
+         PD_LOG( PDWARNING, "Failed to reshard the objects, rc: %d", rc ) ;
+         goto error ;
+      }
       groupSubCLMap = groupSubCLMapNew ;
 
    done:
@@ -43,6 +43,7 @@
 #include "coordFactory.hpp"
 #include "rtnCB.hpp"
 #include "rtn.hpp"
+#include "rtnPreparedQuery.hpp"
 #include "pmd.hpp"
 #include "pdTrace.hpp"
 #include "rtnTrace.hpp"
@@ -703,6 +704,20 @@ namespace engine
          goto error ;
       }
 
+      if ( FLG_QUERY_PREPARED & flags )
+      {
+         // the groups are routed and the context is opened with the bound
+         // query, the message is sent as it is, and is bound by the data
+         // nodes with the cached shape
+         rtnPreparedBinding preparedBinding ;
+
+         PD_CHECK( !( FLG_QUERY_MODIFY & flags ), SDB_INVALIDARG, error,
+                   PDERROR, "Query and modify can't be prepared" ) ;
+         rc = preparedBinding.bind( objQuery, objHint, objQuery, objHint ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to bind prepared query, rc: %d",
+                      rc ) ;
+      }
+
       if ( pContext )
       {
          if ( NULL == *pContext )
@@ -769,6 +784,7 @@ namespace engine
             options.setSkip( pQueryMsg->numToSkip ) ;
             options.setLimit( pQueryMsg->numToReturn ) ;
             options.resetFlag( pQueryMsg->flags ) ;
+            options.clearFlag( FLG_QUERY_PREPARED ) ;
 
             if ( OSS_BIT_TEST( pQueryMsg->flags, FLG_QUERY_EXPLAIN ) ||
                  needResetSubQuery )
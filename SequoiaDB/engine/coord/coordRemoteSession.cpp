@@ -850,6 +850,22 @@ namespace engine
       }
 
       _hasUpdate = TRUE ;
+
+      /// When the catalog info is refreshed by the other sessions or by
+      /// the change notification, use the newer one in the cache directly
+      if ( _cataPtr.get() &&
+           0 == ossStrcmp( pCollectionName, _cataPtr->getName() ) )
+      {
+         CoordCataInfoPtr cachePtr ;
+         if ( SDB_OK == _pResource->getCataInfo( pCollectionName,
+                                                 cachePtr ) &&
+              cachePtr->getVersion() > _cataPtr->getVersion() )
+         {
+            _cataPtr = cachePtr ;
+            goto done ;
+         }
+      }
+
       rc = _pResource->updateCataInfo( pCollectionName, _cataPtr, cb ) ;
       if ( rc )
       {
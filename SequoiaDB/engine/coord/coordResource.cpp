@@ -55,6 +55,7 @@ namespace engine
 
    #define COORD_SOCKET_OPR_DFT_TIME         ( 5000 )
    #define COORD_SOCKET_FORCE_TIMEOUT        ( 600000 )
+   #define COORD_CATA_REFRESH_BATCH          ( 100 )
 
    typedef _utilArray< UINT64, CLS_REPLSET_MAX_NODE_SIZE >     NODE_ARRAY ;
 
@@ -1565,6 +1566,103 @@ namespace engine
       return rc ;
    }
 
+   INT32 _coordResource::refreshCataInfo( const vector< string > &names,
+                                          _pmdEDUCB *cb )
+   {
+      INT32 rc = SDB_OK ;
+      vector< CoordCataInfoPtr > oldPtrs ;
+      UINT32 pos = 0 ;
+
+      /// only the cached ones
+      _cataMutex.get_shared() ;
+      for ( UINT32 i = 0 ; i < names.size() ; ++i )
+      {
+         MAP_CATA_INFO_IT it = _mapCataInfo.find( names[ i ].c_str() ) ;
+         if ( it != _mapCataInfo.end() )
+         {
+            oldPtrs.push_back( it->second ) ;
+         }
+      }
+      _cataMutex.release_shared() ;
+
+      while ( pos < oldPtrs.size() )
+      {
+         UINT32 end = pos + COORD_CATA_REFRESH_BATCH ;
+         BSONObj obj ;
+         CoordCataInfoPtr tmpPtr ;
+         INT32 rcTmp = SDB_OK ;
+
+         if ( end > oldPtrs.size() )
+         {
+            end = oldPtrs.size() ;
+         }
+
+         try
+         {
+            /// the catalog requires only one record to be matched when
+            /// the first field is the name, so match by $or
+            BSONObjBuilder builder ;
+            BSONArrayBuilder arr( builder.subarrayStart( "$or" ) ) ;
+            for ( UINT32 i = pos ; i < end ; ++i )
+            {
+               arr.append( BSON( CAT_CATALOGNAME_NAME <<
+                                 oldPtrs[ i ]->getName() ) ) ;
+            }
+            arr.done() ;
+            obj = builder.obj() ;
+         }
+         catch( std::exception &e )
+         {
+            PD_LOG( PDERROR, "Occur exception: %s", e.what() ) ;
+            rc = SDB_SYS ;
+            goto error ;
+         }
+
+         rcTmp = _updateCataInfo( obj, "", tmpPtr, cb ) ;
+         if ( rcTmp && SDB_DMS_NOTEXIST != rcTmp )
+         {
+            PD_LOG( PDWARNING, "Refresh catalog info of %u collections "
+                    "failed, rc: %d", end - pos, rcTmp ) ;
+            rc = rcTmp ;
+         }
+
+         /// the ones which are not replaced are dropped or failed to
+         /// refresh, remove them so that they are updated when used
+         for ( UINT32 i = pos ; i < end ; ++i )
+         {
+            CoordCataInfoPtr cachePtr ;
+            if ( SDB_OK == getCataInfo( oldPtrs[ i ]->getName(),
+                                        cachePtr ) &&
+                 cachePtr.get() == oldPtrs[ i ].get() )
+            {
+               removeCataInfoWithMain( oldPtrs[ i ]->getName() ) ;
+            }
+         }
+         pos = end ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _coordResource::refreshAllCataInfo( _pmdEDUCB *cb )
+   {
+      vector< string > names ;
+
+      _cataMutex.get_shared() ;
+      MAP_CATA_INFO_IT it = _mapCataInfo.begin() ;
+      while ( it != _mapCataInfo.end() )
+      {
+         names.push_back( it->first ) ;
+         ++it ;
+      }
+      _cataMutex.release_shared() ;
+
+      return refreshCataInfo( names, cb ) ;
+   }
+
    INT32 _coordResource::getOrUpdateGroupInfo( UINT32 groupID,
                                                CoordGroupInfoPtr &groupPtr,
                                                _pmdEDUCB *cb )
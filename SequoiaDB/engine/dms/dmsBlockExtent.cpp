@@ -0,0 +1,426 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = dmsBlockExtent.cpp
+
+   Descriptive Name = Data Management Service Block Extent
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of data management component. This file contains the block
+   compression of the sealed data extents, and the cache of the
+   decompressed chunks.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#include "dmsBlockExtent.hpp"
+#include "utilCompressor.hpp"
+#include "ossAtomic.hpp"
+#include "pd.hpp"
+#include "pdTrace.hpp"
+#include "dmsTrace.hpp"
+
+namespace engine
+{
+
+   static ossAtomic64 s_blockSealSeq( 0 ) ;
+
+   /*
+      The seal id tells the blocks of an extent which is sealed again after
+      it's written, so the cached chunks of the old block are never hit.
+   */
+   static UINT64 _dmsBlockNewSealID()
+   {
+      return ( (UINT64)time( NULL ) << 32 ) |
+             ( s_blockSealSeq.inc() & 0xFFFFFFFF ) ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSBLOCKDECOMPRESS, "_dmsBlockDecompress" )
+   static INT32 _dmsBlockDecompress( const dmsBlockHeader *pHeader,
+                                     UINT32 beginChunk, UINT32 endChunk,
+                                     CHAR *pOutput )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__DMSBLOCKDECOMPRESS ) ;
+      const UINT32 *pOffsets = pHeader->offsets() ;
+      UINT32 chunkSize = 1 << pHeader->_chunkSquare ;
+      utilCompressor *compressor = NULL ;
+
+      compressor = getCompressorByType(
+                   (UTIL_COMPRESSOR_TYPE)pHeader->_compressorType ) ;
+      PD_CHECK( compressor, SDB_DMS_CORRUPTED_EXTENT, error, PDERROR,
+                "Invalid compressor type[%d] of block",
+                pHeader->_compressorType ) ;
+      PD_CHECK( endChunk < pHeader->_chunkNum, SDB_DMS_CORRUPTED_EXTENT,
+                error, PDERROR, "Chunk[%u] is out of block[%u]",
+                endChunk, pHeader->_chunkNum ) ;
+
+      for ( UINT32 i = beginChunk ; i <= endChunk ; ++i )
+      {
+         UINT32 rawLen = OSS_MIN( chunkSize,
+                                  pHeader->_rawSize -
+                                  ( i << pHeader->_chunkSquare ) ) ;
+         UINT32 srcLen = 0 ;
+         UINT32 destLen = rawLen ;
+
+         PD_CHECK( pOffsets[ i ] <= pOffsets[ i + 1 ] &&
+                   pOffsets[ i + 1 ] <= pHeader->_dataSize,
+                   SDB_DMS_CORRUPTED_EXTENT, error, PDERROR,
+                   "Invalid offset of chunk[%u]", i ) ;
+         srcLen = pOffsets[ i + 1 ] - pOffsets[ i ] ;
+
+         if ( srcLen == rawLen )
+         {
+            ossMemcpy( pOutput, ( const CHAR* )pHeader + pOffsets[ i ],
+                       rawLen ) ;
+         }
+         else
+         {
+            rc = compressor->decompress( ( const CHAR* )pHeader +
+                                         pOffsets[ i ], srcLen,
+                                         pOutput, destLen ) ;
+            PD_RC_CHECK( rc, PDERROR, "Failed to decompress chunk[%u], "
+                         "rc: %d", i, rc ) ;
+            PD_CHECK( destLen == rawLen, SDB_DMS_CORRUPTED_EXTENT, error,
+                      PDERROR, "Chunk[%u] length[%u] is not %u",
+                      i, destLen, rawLen ) ;
+         }
+         pOutput += rawLen ;
+      }
+
+   done:
+      PD_TRACE_EXITRC ( SDB__DMSBLOCKDECOMPRESS, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_DMSBLOCKCOMPRESS, "dmsBlockCompress" )
+   INT32 dmsBlockCompress( const dmsExtent *pExtent, UINT32 extentSize,
+                           CHAR **ppBlock, UINT32 &blockSize )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB_DMSBLOCKCOMPRESS ) ;
+      const CHAR *pRaw = ( const CHAR* )pExtent + DMS_EXTENT_METADATA_SZ ;
+      UINT32 rawSize = extentSize - DMS_EXTENT_METADATA_SZ ;
+      UINT32 chunkSize = 1 << DMS_BLOCK_CHUNK_SQUARE ;
+      UINT32 chunkNum = ( rawSize + chunkSize - 1 ) >>
+                        DMS_BLOCK_CHUNK_SQUARE ;
+      UINT32 maxBound = 0 ;
+      UINT32 limit = 0 ;
+      UINT32 pos = 0 ;
+      CHAR *pBlock = NULL ;
+      dmsBlockHeader *pHeader = NULL ;
+      UINT32 *pOffsets = NULL ;
+      utilCompressor *compressor = NULL ;
+
+      compressor = getCompressorByType( UTIL_COMPRESSOR_LZ4 ) ;
+      SDB_ASSERT( compressor, "Compressor can't be NULL" ) ;
+      rc = compressor->compressBound( chunkSize, maxBound ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to get compress bound, rc: %d", rc ) ;
+
+      // a chunk is only written when the block is under the limit
+      limit = (UINT32)( (UINT64)rawSize * DMS_BLOCK_MIN_RATIO / 100 ) ;
+      pos = sizeof( dmsBlockHeader ) + ( chunkNum + 1 ) * sizeof( UINT32 ) ;
+      if ( pos > limit )
+      {
+         rc = SDB_UTIL_COMPRESS_ABORT ;
+         goto error ;
+      }
+
+      pBlock = ( CHAR* )SDB_OSS_MALLOC( limit + maxBound ) ;
+      PD_CHECK( pBlock, SDB_OOM, error, PDERROR, "Failed to allocate "
+                "memory for block, size: %u", limit + maxBound ) ;
+
+      pHeader = ( dmsBlockHeader* )pBlock ;
+      pHeader->_eyeCatcher[0] = DMS_BLOCK_EYECATCHER0 ;
+      pHeader->_eyeCatcher[1] = DMS_BLOCK_EYECATCHER1 ;
+      pHeader->_compressorType = UTIL_COMPRESSOR_LZ4 ;
+      pHeader->_chunkSquare = DMS_BLOCK_CHUNK_SQUARE ;
+      pHeader->_chunkNum = chunkNum ;
+      pHeader->_rawSize = rawSize ;
+      pHeader->_sealID = _dmsBlockNewSealID() ;
+      pOffsets = ( UINT32* )( pBlock + sizeof( dmsBlockHeader ) ) ;
+
+      for ( UINT32 i = 0 ; i < chunkNum ; ++i )
+      {
+         const CHAR *pSrc = pRaw + ( i << DMS_BLOCK_CHUNK_SQUARE ) ;
+         UINT32 srcLen = OSS_MIN( chunkSize,
+                                  rawSize - ( i << DMS_BLOCK_CHUNK_SQUARE ) ) ;
+         UINT32 destLen = maxBound ;
+
+         if ( pos > limit )
+         {
+            rc = SDB_UTIL_COMPRESS_ABORT ;
+            goto error ;
+         }
+         pOffsets[ i ] = pos ;
+
+         rc = compressor->compress( pSrc, srcLen, pBlock + pos, destLen ) ;
+         if ( SDB_UTIL_COMPRESS_ABORT == rc ||
+              ( SDB_OK == rc && destLen >= srcLen ) )
+         {
+            // the length tells the raw chunk
+            ossMemcpy( pBlock + pos, pSrc, srcLen ) ;
+            destLen = srcLen ;
+            rc = SDB_OK ;
+         }
+         PD_RC_CHECK( rc, PDERROR, "Failed to compress chunk[%u], rc: %d",
+                      i, rc ) ;
+         pos += destLen ;
+      }
+
+      if ( pos > limit )
+      {
+         rc = SDB_UTIL_COMPRESS_ABORT ;
+         goto error ;
+      }
+      pOffsets[ chunkNum ] = pos ;
+      pHeader->_dataSize = pos ;
+
+      *ppBlock = pBlock ;
+      blockSize = pos ;
+
+   done:
+      PD_TRACE_EXITRC ( SDB_DMSBLOCKCOMPRESS, rc ) ;
+      return rc ;
+   error:
+      if ( pBlock )
+      {
+         SDB_OSS_FREE( pBlock ) ;
+      }
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_DMSBLOCKUNCOMPRESS, "dmsBlockUncompress" )
+   INT32 dmsBlockUncompress( const dmsExtent *pExtent, UINT32 extentSize,
+                             CHAR *pOutput )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB_DMSBLOCKUNCOMPRESS ) ;
+      const dmsBlockHeader *pHeader = dmsGetBlockHeader( pExtent ) ;
+
+      PD_CHECK( pHeader->validate() &&
+                pHeader->_rawSize == extentSize - DMS_EXTENT_METADATA_SZ &&
+                pHeader->_chunkNum > 0,
+                SDB_DMS_CORRUPTED_EXTENT, error, PDERROR,
+                "Invalid block header of extent" ) ;
+
+      ossMemcpy( pOutput, pExtent, DMS_EXTENT_METADATA_SZ ) ;
+      OSS_BIT_CLEAR( ( ( dmsExtent* )pOutput )->_flag,
+                     DMS_EXTENT_FLAG_COMPRESSED ) ;
+
+      rc = _dmsBlockDecompress( pHeader, 0, pHeader->_chunkNum - 1,
+                                pOutput + DMS_EXTENT_METADATA_SZ ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to decompress block, rc: %d", rc ) ;
+
+   done:
+      PD_TRACE_EXITRC ( SDB_DMSBLOCKUNCOMPRESS, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_DMSBLOCKUNSEAL, "dmsBlockUnseal" )
+   INT32 dmsBlockUnseal( dmsExtent *pExtent, UINT32 extentSize )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB_DMSBLOCKUNSEAL ) ;
+      CHAR *pRaw = ( CHAR* )SDB_OSS_MALLOC( extentSize ) ;
+
+      PD_CHECK( pRaw, SDB_OOM, error, PDERROR, "Failed to allocate "
+                "memory for extent, size: %u", extentSize ) ;
+
+      rc = dmsBlockUncompress( pExtent, extentSize, pRaw ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to uncompress extent, rc: %d", rc ) ;
+
+      ossMemcpy( ( CHAR* )pExtent + DMS_EXTENT_METADATA_SZ,
+                 pRaw + DMS_EXTENT_METADATA_SZ,
+                 extentSize - DMS_EXTENT_METADATA_SZ ) ;
+      OSS_BIT_CLEAR( pExtent->_flag, DMS_EXTENT_FLAG_COMPRESSED ) ;
+
+   done:
+      if ( pRaw )
+      {
+         SDB_OSS_FREE( pRaw ) ;
+      }
+      PD_TRACE_EXITRC ( SDB_DMSBLOCKUNSEAL, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   /*
+      _dmsBlockCache implement
+   */
+   _dmsBlockCache::_dmsBlockCache()
+   {
+      ossMemset( _slots, 0, sizeof( _slots ) ) ;
+      for ( UINT32 i = 0 ; i < DMS_BLOCK_CACHE_SLOT_NUM ; ++i )
+      {
+         _slots[ i ]._extentID = DMS_INVALID_EXTENT ;
+      }
+      _tick = 0 ;
+   }
+
+   _dmsBlockCache::~_dmsBlockCache()
+   {
+      clear() ;
+   }
+
+   void _dmsBlockCache::clear()
+   {
+      for ( UINT32 i = 0 ; i < DMS_BLOCK_CACHE_SLOT_NUM ; ++i )
+      {
+         if ( _slots[ i ]._pBuff )
+         {
+            SDB_OSS_FREE( _slots[ i ]._pBuff ) ;
+         }
+      }
+      ossMemset( _slots, 0, sizeof( _slots ) ) ;
+      for ( UINT32 i = 0 ; i < DMS_BLOCK_CACHE_SLOT_NUM ; ++i )
+      {
+         _slots[ i ]._extentID = DMS_INVALID_EXTENT ;
+      }
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSBLOCKCACHE_READ, "_dmsBlockCache::read" )
+   const CHAR* _dmsBlockCache::read( const void *pOwner, INT32 extentID,
+                                     const dmsExtent *pExtent,
+                                     UINT32 offset, UINT32 len, INT32 &rc )
+   {
+      PD_TRACE_ENTRY ( SDB__DMSBLOCKCACHE_READ ) ;
+      const dmsBlockHeader *pHeader = dmsGetBlockHeader( pExtent ) ;
+      const CHAR *pData = NULL ;
+      _slot *pSlot = NULL ;
+      UINT32 pos = 0 ;
+      UINT32 beginChunk = 0 ;
+      UINT32 endChunk = 0 ;
+
+      rc = SDB_OK ;
+
+      if ( offset < DMS_EXTENT_METADATA_SZ || !pHeader->validate() ||
+           offset - DMS_EXTENT_METADATA_SZ + len > pHeader->_rawSize )
+      {
+         PD_LOG( PDERROR, "Invalid range[offset: %u, len: %u] of block "
+                 "extent[%d]", offset, len, extentID ) ;
+         rc = SDB_DMS_CORRUPTED_EXTENT ;
+         goto error ;
+      }
+
+      pos = offset - DMS_EXTENT_METADATA_SZ ;
+      beginChunk = pos >> pHeader->_chunkSquare ;
+      endChunk = ( pos + ( len > 0 ? len : 1 ) - 1 ) >>
+                 pHeader->_chunkSquare ;
+
+      for ( UINT32 i = 0 ; i < DMS_BLOCK_CACHE_SLOT_NUM ; ++i )
+      {
+         _slot &slot = _slots[ i ] ;
+         if ( slot._extentID == extentID && slot._pOwner == pOwner &&
+              slot._sealID == pHeader->_sealID &&
+              slot._beginChunk <= beginChunk && slot._endChunk >= endChunk )
+         {
+            pSlot = &slot ;
+            break ;
+         }
+      }
+
+      if ( !pSlot )
+      {
+         // replace the least recently used one
+         pSlot = &_slots[ 0 ] ;
+         for ( UINT32 i = 1 ; i < DMS_BLOCK_CACHE_SLOT_NUM ; ++i )
+         {
+            if ( _slots[ i ]._tick < pSlot->_tick )
+            {
+               pSlot = &_slots[ i ] ;
+            }
+         }
+         rc = _load( *pSlot, pOwner, extentID, pHeader,
+                     beginChunk, endChunk ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+      }
+
+      pSlot->_tick = ++_tick ;
+      pData = pSlot->_pBuff +
+              ( pos - ( pSlot->_beginChunk << pHeader->_chunkSquare ) ) ;
+
+   done:
+      PD_TRACE_EXITRC ( SDB__DMSBLOCKCACHE_READ, rc ) ;
+      return pData ;
+   error:
+      pData = NULL ;
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSBLOCKCACHE__LOAD, "_dmsBlockCache::_load" )
+   INT32 _dmsBlockCache::_load( _slot &slot, const void *pOwner,
+                                INT32 extentID,
+                                const dmsBlockHeader *pHeader,
+                                UINT32 beginChunk, UINT32 endChunk )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__DMSBLOCKCACHE__LOAD ) ;
+      UINT32 size = OSS_MIN( ( endChunk - beginChunk + 1 ) <<
+                             pHeader->_chunkSquare,
+                             pHeader->_rawSize -
+                             ( beginChunk << pHeader->_chunkSquare ) ) ;
+
+      // a failed load never hits
+      slot._extentID = DMS_INVALID_EXTENT ;
+
+      if ( slot._buffSize < size )
+      {
+         CHAR *pBuff = ( CHAR* )SDB_OSS_REALLOC( slot._pBuff, size ) ;
+         PD_CHECK( pBuff, SDB_OOM, error, PDERROR, "Failed to allocate "
+                   "memory for block cache, size: %u", size ) ;
+         slot._pBuff = pBuff ;
+         slot._buffSize = size ;
+      }
+
+      rc = _dmsBlockDecompress( pHeader, beginChunk, endChunk, slot._pBuff ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to decompress chunks[%u, %u] of "
+                   "extent[%d], rc: %d", beginChunk, endChunk, extentID,
+                   rc ) ;
+
+      slot._pOwner = pOwner ;
+      slot._extentID = extentID ;
+      slot._sealID = pHeader->_sealID ;
+      slot._beginChunk = beginChunk ;
+      slot._endChunk = endChunk ;
+
+   done:
+      PD_TRACE_EXITRC ( SDB__DMSBLOCKCACHE__LOAD, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+}
+
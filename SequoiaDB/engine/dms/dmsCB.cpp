@@ -2066,6 +2066,17 @@ namespace engine
       _dictWaitQue.push( job ) ;
    }
 
+   BOOLEAN _SDB_DMSCB::dispatchSealJob( dmsSealJob &job, INT64 timeout )
+   {
+      return _sealWaitQue.timed_wait_and_pop( job, timeout ) ;
+   }
+
+   void _SDB_DMSCB::pushSealJob( dmsSealJob job )
+   {
+      job._createTime = pmdGetDBTick() ;
+      _sealWaitQue.push( job ) ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB__SDB_DMSCB_AQUIRE_CSMUTEX, "_SDB_DMSCB::aquireCSMutex" )
    void _SDB_DMSCB::aquireCSMutex( const CHAR *pCSName )
    {
@@ -47,6 +47,7 @@
 #include "utilDictionary.hpp"
 #include "dmsStorageDataCapped.hpp"
 #include "rtnLobPieces.hpp"
+#include "dmsBlockExtent.hpp"
 
 using namespace bson ;
 
@@ -869,6 +870,7 @@ namespace engine
       UINT32 len           = 0 ;
       UINT32 hexDumpOption = 0 ;
       dmsExtent *extent    = (dmsExtent*)inBuf ;
+      CHAR *pRawBuf        = NULL ;
 
       if ( NULL == inBuf || NULL == outBuf || inSize < sizeof(dmsExtent) ||
            inSize % DMS_PAGE_SIZE4K != 0 )
@@ -928,6 +930,20 @@ namespace engine
 
          if( dumpRecord )
          {
+            // the records of the block extent are dumped from the raw copy
+            if ( dmsIsBlockExtent( extent ) )
+            {
+               pRawBuf = ( CHAR* )SDB_OSS_MALLOC( inSize ) ;
+               if ( !pRawBuf ||
+                    SDB_OK != dmsBlockUncompress( extent, inSize, pRawBuf ) )
+               {
+                  len += ossSnprintf ( outBuf + len, outSize - len,
+                                       "Error: Failed to decompress block "
+                                       "extent"OSS_NEWLINE ) ;
+                  goto exit ;
+               }
+               inBuf = pRawBuf ;
+            }
             if ( capped )
             {
                len += _dumpCappedExtent( inBuf, inSize, outBuf + len,
@@ -943,6 +959,10 @@ namespace engine
       }
 
    exit :
+      if ( pRawBuf )
+      {
+         SDB_OSS_FREE( pRawBuf ) ;
+      }
       return len ;
    }
 
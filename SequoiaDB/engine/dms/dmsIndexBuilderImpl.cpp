@@ -37,6 +37,8 @@
 #include "dmsCB.hpp"
 #include "pmdEDU.hpp"
 #include "dmsTrace.hpp"
+#include "ixmExtent.hpp"
+#include "pmd.hpp"
 
 namespace engine
 {
@@ -307,6 +309,97 @@ namespace engine
       goto done ;
    }
 
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSINDEXSORTINGBUILDER__LOADKEYS, "_dmsIndexSortingBuilder::_loadKeys" )
+   INT32 _dmsIndexSortingBuilder::_loadKeys( const Ordering& ordering )
+   {
+      INT32 rc = SDB_OK ;
+      INT32 rcTmp = SDB_OK ;
+      PD_TRACE_ENTRY( SDB__DMSINDEXSORTINGBUILDER__LOADKEYS ) ;
+      ixmBulkLoader loader( _indexCB, _suIndex, ordering,
+                            pmdGetOptionCB()->indexFillFactor() ) ;
+      monAppCB *pMonAppCB = _eduCB ? _eduCB->getMonAppCB() : NULL ;
+      ixmKey prevKey ;
+      dmsRecordID prevRID ;
+      BOOLEAN hasPrev = FALSE ;
+
+      rc = loader.init() ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to init index bulk loader, rc: %d",
+                   rc ) ;
+
+      for (;;)
+      {
+         ixmKey key ;
+         dmsRecordID recordID ;
+
+         if ( _eduCB->isInterrupted() )
+         {
+            rc = SDB_APP_INTERRUPT ;
+            goto error ;
+         }
+
+         for ( INT32 i = 0 ; i < _KEYS_PER_BATCH ; i++ )
+         {
+            rc = _sorter->fetch( key, recordID ) ;
+            if ( SDB_DMS_EOC == rc )
+            {
+               rc = SDB_OK ;
+               goto done ;
+            }
+            else if ( SDB_OK != rc )
+            {
+               goto error ;
+            }
+
+            // the keys are sorted by ( key, rid ), so the duplicated keys
+            // are neighbours, and the key data of the previous one stays in
+            // the sorter until it's reset
+            if ( hasPrev && 0 == key.woCompare( prevKey, ordering ) )
+            {
+               if ( 0 == recordID.compare( prevRID ) )
+               {
+                  PD_LOG ( PDWARNING, "Identical key is detected "
+                           "during index rebuild, ignore" ) ;
+                  continue ;
+               }
+               else if ( _unique &&
+                         ( _indexCB->enforced() || !key.isUndefined() ) )
+               {
+                  PD_LOG ( PDERROR, "Duplicate key is detected during index "
+                           "rebuild, key: %s",
+                           key.toString( FALSE, TRUE ).c_str() ) ;
+                  rc = SDB_IXM_DUP_KEY ;
+                  goto error ;
+               }
+            }
+
+            rc = loader.append( key, recordID ) ;
+            if ( SDB_OK != rc )
+            {
+               PD_LOG ( PDERROR, "Failed to load key into index, rc: %d",
+                        rc ) ;
+               goto error ;
+            }
+            prevKey.assign( key ) ;
+            prevRID = recordID ;
+            hasPrev = TRUE ;
+         }
+      }
+
+   done:
+      // link all the loaded pages into the tree even if failed, so that
+      // they can be released when the index is dropped or rebuilt
+      rcTmp = loader.finish() ;
+      if ( SDB_OK == rc )
+      {
+         rc = rcTmp ;
+      }
+      DMS_MON_OP_COUNT_INC( pMonAppCB, MON_INDEX_WRITE, loader.keyNum() ) ;
+      PD_TRACE_EXITRC( SDB__DMSINDEXSORTINGBUILDER__LOADKEYS, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
    INT32 _dmsIndexSortingBuilder::_build()
    {
       INT32 rc = SDB_OK ;
@@ -350,7 +443,17 @@ namespace engine
             goto error ;
          }
 
-         rc = _insertKeys( ordering ) ;
+         // the tree is built bottom-up when it's empty, which is the first
+         // round normally, keys of the following rounds have to be inserted
+         // one by one
+         if ( ixmBulkLoader::isIndexEmpty( _indexCB, _suIndex ) )
+         {
+            rc = _loadKeys( ordering ) ;
+         }
+         else
+         {
+            rc = _insertKeys( ordering ) ;
+         }
          if ( SDB_OK != rc )
          {
             goto error ;
@@ -46,6 +46,7 @@
 #include "dmsTrace.hpp"
 #include "dmsStorageDataCapped.hpp"
 #include "dmsStorageLob.hpp"
+#include "dmsBlockExtent.hpp"
 
 using namespace bson ;
 
@@ -681,7 +682,8 @@ namespace engine
          }
 
          if ( mb->_attributes & ~(DMS_MB_ATTR_COMPRESSED|DMS_MB_ATTR_NOIDINDEX
-                                  |DMS_MB_ATTR_CAPPED) )
+                                  |DMS_MB_ATTR_CAPPED
+                                  |DMS_MB_ATTR_BLOCKCOMPRESSED) )
          {
             mbAttr2String ( mb->_attributes, tmpStr, DMS_COLLECTION_STATUS_LEN ) ;
             len += ossSnprintf ( outBuf + len, outSize - len,
@@ -812,6 +814,7 @@ namespace engine
       SINT32 localErr      = 0 ;
       dmsExtent *extent    = (dmsExtent*)inBuf ;
       dmsExtentID origID   = nextExtent ;
+      CHAR *pRawBuf        = NULL ;
 
       if ( NULL == inBuf || NULL == outBuf || inSize < sizeof(dmsExtent) ||
            inSize % DMS_PAGE_SIZE4K != 0 )
@@ -844,6 +847,22 @@ namespace engine
       }
       nextExtent = extent->_nextExtent ;
 
+      // the records of the block extent are inspected on the raw copy
+      if ( dmsIsBlockExtent( extent ) )
+      {
+         pRawBuf = ( CHAR* )SDB_OSS_MALLOC( inSize ) ;
+         if ( !pRawBuf ||
+              SDB_OK != dmsBlockUncompress( extent, inSize, pRawBuf ) )
+         {
+            len += ossSnprintf ( outBuf + len, outSize - len,
+                                 "Error: Failed to decompress block "
+                                 "extent"OSS_NEWLINE ) ;
+            ++localErr ;
+            goto exit ;
+         }
+         inBuf = pRawBuf ;
+      }
+
       if ( capped )
       {
          len += inspectCappedExtent( inBuf, inSize, outBuf + len, outSize - len,
@@ -868,6 +887,10 @@ namespace engine
                               OSS_NEWLINE ) ;
       }
       err += localErr ;
+      if ( pRawBuf )
+      {
+         SDB_OSS_FREE( pRawBuf ) ;
+      }
 
       return len ;
    }
@@ -1127,7 +1150,8 @@ namespace engine
                               collectionID, collectionID ) ;
          ++err ;
       }
-      if ( extent->_flag != DMS_EXTENT_FLAG_INUSE &&
+      if ( ( extent->_flag & ~DMS_EXTENT_FLAG_COMPRESSED ) !=
+           DMS_EXTENT_FLAG_INUSE &&
            extent->_flag != DMS_EXTENT_FLAG_FREED )
       {
          len += ossSnprintf ( outBuf + len, outSize - len,
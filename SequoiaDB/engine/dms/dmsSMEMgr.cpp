@@ -44,41 +44,174 @@
 
 namespace engine
 {
+   #define DMS_SEGMENT_WORD_MASK( bitBegin, bitEnd ) \
+      ( ( ( bitEnd ) - ( bitBegin ) >= DMS_SEGMENT_WORD_BITS ) ? \
+        DMS_SEGMENT_WORD_ALL : \
+        ( ( ( ( _dmsSegmentWord )1 << ( ( bitEnd ) - ( bitBegin ) ) ) - 1 ) << \
+          ( bitBegin ) ) )
+
+   #define DMS_SEGMENT_WORD_PEEK( pWord ) \
+      ( ( _dmsSegmentWord )ossAtomicPeek64( ( volatile SINT64* )( pWord ) ) )
+
    /*
       _dmsSegmentSpace : implement
    */
    _dmsSegmentSpace::_dmsSegmentSpace ( dmsExtentID startExtent, UINT16 maxNode,
                                         _dmsSMEMgr *pSMEMgr )
+   :_totalFree( 0 )
    {
-      _maxNode     = 0 ;
+      _bitmap      = NULL ;
+      _wordNum     = 0 ;
       _startExtent = startExtent ;
       _totalSize   = maxNode ;
-      _totalFree   = 0 ;
       _pSMEMgr     = pSMEMgr ;
    }
 
    _dmsSegmentSpace::~_dmsSegmentSpace ()
    {
-      _freeSpaceList.clear() ;
+      if ( _bitmap )
+      {
+         SDB_OSS_FREE( _bitmap ) ;
+         _bitmap = NULL ;
+      }
    }
 
-   // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSSMS__RSTMAX, "_dmsSegmentSpace::_resetMax" )
-   void _dmsSegmentSpace::_resetMax ()
+   INT32 _dmsSegmentSpace::init ()
    {
-      PD_TRACE_ENTRY ( SDB__DMSSMS__RSTMAX ) ;
-      list<_dmsSegmentNode>::iterator it ;
-      _maxNode = 0 ;
-      UINT32 size = 0 ;
-      for ( it = _freeSpaceList.begin(); it != _freeSpaceList.end(); ++it )
+      INT32 rc = SDB_OK ;
+
+      _wordNum = ( _totalSize + DMS_SEGMENT_WORD_BITS - 1 ) /
+                 DMS_SEGMENT_WORD_BITS ;
+      _bitmap = ( _dmsSegmentWord* )SDB_OSS_MALLOC( _wordNum *
+                                                    sizeof( _dmsSegmentWord ) ) ;
+      if ( NULL == _bitmap )
+      {
+         PD_LOG ( PDERROR, "Unable to allocate memory for segment bitmap" ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+      // all pages are in use until released
+      ossMemset( _bitmap, 0, _wordNum * sizeof( _dmsSegmentWord ) ) ;
+
+   done :
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSSMS__FINDFREERANGE, "_dmsSegmentSpace::_findFreeRange" )
+   BOOLEAN _dmsSegmentSpace::_findFreeRange ( UINT16 numPages,
+                                              UINT32 &relaStart ) const
+   {
+      PD_TRACE_ENTRY ( SDB__DMSSMS__FINDFREERANGE ) ;
+      BOOLEAN found = FALSE ;
+      UINT32 runStart = 0 ;
+      UINT32 runLen = 0 ;
+
+      for ( UINT32 w = 0 ; w < _wordNum && !found ; ++w )
       {
-         _dmsSegmentNode &node = (*it) ;
-         size = DMS_SEGMENT_NODE_GETSIZE( node ) ;
-         if ( size > _maxNode )
+         _dmsSegmentWord word = DMS_SEGMENT_WORD_PEEK( &_bitmap[ w ] ) ;
+
+         if ( DMS_SEGMENT_WORD_ALL == word )
+         {
+            if ( 0 == runLen )
+            {
+               runStart = w * DMS_SEGMENT_WORD_BITS ;
+            }
+            runLen += DMS_SEGMENT_WORD_BITS ;
+            found = ( runLen >= numPages ) ;
+         }
+         else if ( 0 == word )
          {
-            _maxNode = size ;
+            runLen = 0 ;
+         }
+         else
+         {
+            for ( UINT32 bit = 0 ; bit < DMS_SEGMENT_WORD_BITS ; ++bit )
+            {
+               if ( word & ( ( _dmsSegmentWord )1 << bit ) )
+               {
+                  if ( 0 == runLen )
+                  {
+                     runStart = w * DMS_SEGMENT_WORD_BITS + bit ;
+                  }
+                  if ( ++runLen >= numPages )
+                  {
+                     found = TRUE ;
+                     break ;
+                  }
+               }
+               else
+               {
+                  runLen = 0 ;
+               }
+            }
          }
       }
-      PD_TRACE_EXIT ( SDB__DMSSMS__RSTMAX ) ;
+
+      if ( found )
+      {
+         relaStart = runStart ;
+      }
+
+      PD_TRACE_EXIT ( SDB__DMSSMS__FINDFREERANGE ) ;
+      return found ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSSMS__CLAIMRANGE, "_dmsSegmentSpace::_claimRange" )
+   BOOLEAN _dmsSegmentSpace::_claimRange ( UINT32 relaStart, UINT16 numPages )
+   {
+      PD_TRACE_ENTRY ( SDB__DMSSMS__CLAIMRANGE ) ;
+      BOOLEAN claimed = TRUE ;
+      UINT32 relaEnd = relaStart + numPages ;
+      UINT32 pos = relaStart ;
+
+      while ( pos < relaEnd )
+      {
+         UINT32 w = pos / DMS_SEGMENT_WORD_BITS ;
+         UINT32 wordBegin = w * DMS_SEGMENT_WORD_BITS ;
+         UINT32 bitEnd = OSS_MIN( relaEnd - wordBegin,
+                                  (UINT32)DMS_SEGMENT_WORD_BITS ) ;
+         _dmsSegmentWord mask = DMS_SEGMENT_WORD_MASK( pos - wordBegin,
+                                                       bitEnd ) ;
+         _dmsSegmentWord oldWord = 0 ;
+
+         do
+         {
+            oldWord = DMS_SEGMENT_WORD_PEEK( &_bitmap[ w ] ) ;
+            if ( ( oldWord & mask ) != mask )
+            {
+               // some pages are taken by others, give back what we got
+               _unclaimRange( relaStart, pos ) ;
+               claimed = FALSE ;
+               goto done ;
+            }
+         } while ( !ossCompareAndSwap64( &_bitmap[ w ], oldWord,
+                                         oldWord & ~mask ) ) ;
+
+         pos = wordBegin + bitEnd ;
+      }
+
+   done :
+      PD_TRACE_EXIT ( SDB__DMSSMS__CLAIMRANGE ) ;
+      return claimed ;
+   }
+
+   void _dmsSegmentSpace::_unclaimRange ( UINT32 relaStart, UINT32 relaEnd )
+   {
+      UINT32 pos = relaStart ;
+
+      while ( pos < relaEnd )
+      {
+         UINT32 w = pos / DMS_SEGMENT_WORD_BITS ;
+         UINT32 wordBegin = w * DMS_SEGMENT_WORD_BITS ;
+         UINT32 bitEnd = OSS_MIN( relaEnd - wordBegin,
+                                  (UINT32)DMS_SEGMENT_WORD_BITS ) ;
+
+         ossFetchAndOR64( &_bitmap[ w ],
+                          DMS_SEGMENT_WORD_MASK( pos - wordBegin, bitEnd ) ) ;
+         pos = wordBegin + bitEnd ;
+      }
    }
 
    // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSSMS_RSVPAGES, "_dmsSegmentSpace::reservePages" )
@@ -89,68 +222,45 @@ namespace engine
    {
       INT32 rc = SDB_DMS_NOSPC ;
       PD_TRACE_ENTRY ( SDB__DMSSMS_RSVPAGES );
-      UINT16 oldsize = 0 ;
-      UINT16 newsize = 0 ;
-      list<_dmsSegmentNode>::iterator it ;
-
-      ossScopedLock lock( &_mutex ) ;
+      UINT32 relaStart = 0 ;
 
-      if ( 0 == _totalFree )
+      if ( 0 == _totalFree.peek() )
       {
          pFreePos->compareAndSwap( pos, pos + 1 ) ;
       }
 
-      if ( numPages > _maxNode )
+      while ( _totalFree.peek() >= numPages )
       {
-         rc = SDB_DMS_NOSPC ;
-         goto error ;
+         if ( !_findFreeRange( numPages, relaStart ) )
+         {
+            break ;
+         }
+         // lost the race when failed, find again
+         if ( _claimRange( relaStart, numPages ) )
+         {
+            rc = SDB_OK ;
+            break ;
+         }
       }
 
-      for ( it = _freeSpaceList.begin(); it != _freeSpaceList.end(); ++it )
+      if ( SDB_OK != rc )
       {
-         _dmsSegmentNode &node = (*it) ;
-         oldsize = DMS_SEGMENT_NODE_GETSIZE( node ) ;
-         if ( oldsize >= numPages )
-         {
-            foundPage = DMS_SEGMENT_NODE_GETSTART( node ) ;
-            if ( DMS_SEGMENT_NODE_GETSIZE( node ) == numPages )
-            {
-               _freeSpaceList.erase ( it ) ;
-            }
-            else
-            {
-               newsize = oldsize - numPages ;
-               DMS_SEGMENT_NODE_SET ( node, foundPage+numPages, newsize ) ;
-            }
+         goto error ;
+      }
 
-            foundPage += _startExtent ;
-            _totalFree -= numPages ;
+      foundPage = _startExtent + relaStart ;
+      _totalFree.sub( numPages ) ;
 
-            if ( oldsize == _maxNode )
-            {
-               _resetMax () ;
-            }
-            SDB_ASSERT ( _maxNode != _totalSize, "Internal logic error" ) ;
-            rc = SDB_OK ;
-
-            {
-               UINT32 bitStart = (UINT32)foundPage ;
-               UINT32 bitEnd   = bitStart + numPages ;
-               for ( ; bitStart < bitEnd ; bitStart++ )
-               {
-                  SDB_ASSERT( DMS_SME_FREE == _pSMEMgr->_pSME->getBitMask( bitStart ),
-                              "SME corrupted, bit must be free" ) ;
-                  _pSMEMgr->_pSME->setBitMask( bitStart ) ;
-               }
-               _pSMEMgr->_totalFree.sub( numPages ) ;
-            }
-            goto done ;
-         } // if ( oldsize >= numPages )
-      } // for ( it = _freeSpaceList.begin();
-
-      PD_LOG ( PDSEVERE, "Internal logic error" ) ;
-      SDB_ASSERT ( FALSE, "Internal logic error" ) ;
-      rc = SDB_SYS ;
+#ifdef _DEBUG
+      for ( UINT32 i = 0 ; i < numPages ; ++i )
+      {
+         SDB_ASSERT( DMS_SME_FREE ==
+                     _pSMEMgr->_pSME->getBitMask( foundPage + i ),
+                     "SME corrupted, bit must be free" ) ;
+      }
+#endif //_DEBUG
+      _pSMEMgr->_pSME->setBitMaskRange( (UINT32)foundPage, numPages ) ;
+      _pSMEMgr->_totalFree.sub( numPages ) ;
 
    done :
       PD_TRACE_EXITRC ( SDB__DMSSMS_RSVPAGES, rc );
@@ -165,15 +275,9 @@ namespace engine
    {
       INT32 rc = SDB_OK ;
       PD_TRACE_ENTRY ( SDB__DMSSMS_RLSPAGES );
-      list<_dmsSegmentNode>::iterator it ;
-      list<_dmsSegmentNode>::iterator it1 ;
-      list<_dmsSegmentNode>::iterator oldit ;
-      _dmsSegmentNode newnode   = 0 ;
-      UINT16          newSize   = 0 ;
-      BOOLEAN         prevExist = FALSE ;
-      UINT16          relaStart = (UINT16)(start - _startExtent) ;
-
-      ossScopedLock lock( &_mutex ) ;
+      UINT32 relaStart = 0 ;
+      UINT32 relaEnd = 0 ;
+      UINT32 pos = 0 ;
 
       if ( start < _startExtent ||
            (start+numPages) > (_startExtent + _totalSize) )
@@ -190,117 +294,68 @@ namespace engine
          goto done ;
       }
 
-      DMS_SEGMENT_NODE_SET ( newnode, relaStart, numPages ) ;
+      relaStart = (UINT32)( start - _startExtent ) ;
+      relaEnd = relaStart + numPages ;
+      pos = relaStart ;
 
-      if ( _freeSpaceList.empty () )
-      {
-         SDB_ASSERT ( _maxNode == 0, "max node must be 0 when free space is "
-                      "empty" ) ;
-         _freeSpaceList.push_back ( newnode ) ;
-         _maxNode = numPages ;
-         goto done ;
-      }
-
-      for ( it = _freeSpaceList.begin(); ; ++it )
+#ifdef _DEBUG
+      if ( bitSet )
       {
-         if ( _freeSpaceList.end() == it )
+         for ( UINT32 i = 0 ; i < numPages ; ++i )
          {
-            newSize = numPages ;
-            _freeSpaceList.push_back ( newnode ) ;
-            if ( newSize > _maxNode )
-            {
-               _maxNode = newSize ;
-            }
-
-            list<_dmsSegmentNode>::reverse_iterator rit =
-               _freeSpaceList.rbegin();
-            it1 = (++rit).base() ;
-            break ;
+            SDB_ASSERT( DMS_SME_ALLOCATED ==
+                        _pSMEMgr->_pSME->getBitMask( start + i ),
+                        "SME corrupted, bit must be allocated" ) ;
          }
+      }
+#endif //_DEBUG
 
-         _dmsSegmentNode &node = (*it) ;
-         UINT16      nodeStart = DMS_SEGMENT_NODE_GETSTART( node ) ;
-         UINT16      nodeSize  = DMS_SEGMENT_NODE_GETSIZE( node ) ;
-         if ( relaStart < nodeStart )
+      while ( pos < relaEnd )
+      {
+         UINT32 w = pos / DMS_SEGMENT_WORD_BITS ;
+         UINT32 wordBegin = w * DMS_SEGMENT_WORD_BITS ;
+         UINT32 bitEnd = OSS_MIN( relaEnd - wordBegin,
+                                  (UINT32)DMS_SEGMENT_WORD_BITS ) ;
+         _dmsSegmentWord mask = DMS_SEGMENT_WORD_MASK( pos - wordBegin,
+                                                       bitEnd ) ;
+         _dmsSegmentWord oldWord = 0 ;
+
+         do
          {
-            if ( relaStart + numPages > nodeStart )
-            {
-               PD_LOG ( PDERROR, "Internal logic error" ) ;
-               rc = SDB_SYS ;
-               goto error ;
-            }
-            else if ( relaStart + numPages == nodeStart )
+            oldWord = DMS_SEGMENT_WORD_PEEK( &_bitmap[ w ] ) ;
+            if ( 0 != ( oldWord & mask ) )
             {
-               newSize = nodeSize + numPages ;
-               DMS_SEGMENT_NODE_SET ( node, relaStart, newSize ) ;
-               if ( newSize > _maxNode )
+               PD_LOG ( PDERROR, "Internal logic error, pages of %d:%d are "
+                        "already free", start, numPages ) ;
+               // restore the pages freed by this call
+               while ( pos > relaStart )
                {
-                  _maxNode = newSize ;
-               }
-               it1 = it ;
-            }
-            else
-            {
-               newSize = numPages ;
-               it1 = _freeSpaceList.insert ( it, newnode ) ;
-               if ( newSize > _maxNode )
-               {
-                  _maxNode = newSize ;
+                  w = ( pos - 1 ) / DMS_SEGMENT_WORD_BITS ;
+                  wordBegin = w * DMS_SEGMENT_WORD_BITS ;
+                  mask = DMS_SEGMENT_WORD_MASK(
+                            OSS_MAX( relaStart, wordBegin ) - wordBegin,
+                            pos - wordBegin ) ;
+                  ossFetchAndAND64( &_bitmap[ w ], ~mask ) ;
+                  pos = OSS_MAX( relaStart, wordBegin ) ;
                }
+               rc = SDB_SYS ;
+               goto error ;
             }
-            break ;
-         } // if ( start < nodeStart )
-         else if ( relaStart == nodeStart ||
-                   nodeStart + nodeSize > relaStart )
-         {
-            PD_LOG ( PDERROR, "Internal logic error" ) ;
-            rc = SDB_SYS ;
-            goto error ;
-         }
-         oldit = it ;
-         prevExist = TRUE ;
-      } // for ( it = _freeSpaceList.begin();
+         } while ( !ossCompareAndSwap64( &_bitmap[ w ], oldWord,
+                                         oldWord | mask ) ) ;
 
-      if ( prevExist )
-      {
-         _dmsSegmentNode &prevNode = (*oldit ) ;
-         UINT16      prevStart = DMS_SEGMENT_NODE_GETSTART( prevNode ) ;
-         UINT16      prevSize  = DMS_SEGMENT_NODE_GETSIZE( prevNode ) ;
-         if ( prevStart + prevSize > relaStart )
-         {
-            PD_LOG ( PDERROR, "Internal logic error" ) ;
-            rc = SDB_SYS ;
-            goto error ;
-         }
-         else if ( prevStart + prevSize == relaStart )
-         {
-            DMS_SEGMENT_NODE_SETSIZE ( prevNode, newSize+prevSize ) ;
-            _freeSpaceList.erase ( it1 ) ;
-            if ( newSize+prevSize > _maxNode )
-            {
-               _maxNode = newSize+prevSize ;
-            }
-         }
+         pos = wordBegin + bitEnd ;
       }
 
-   done :
-      if ( SDB_OK == rc )
-      {
-         _totalFree += numPages ;
+      _totalFree.add( numPages ) ;
 
-         if ( bitSet )
-         {
-            UINT32 bitStart = (UINT32)start ;
-            UINT32 bitEnd   = bitStart + numPages ;
-            for ( ; bitStart < bitEnd ; bitStart++ )
-            {
-               SDB_ASSERT( DMS_SME_ALLOCATED == _pSMEMgr->_pSME->getBitMask( bitStart ),
-                           "SME corrupted, bit must be allocated" ) ;
-               _pSMEMgr->_pSME->freeBitMask( bitStart ) ;
-            }
-            _pSMEMgr->_totalFree.add( numPages ) ;
-         }
+      if ( bitSet )
+      {
+         _pSMEMgr->_pSME->freeBitMaskRange( (UINT32)start, numPages ) ;
+         _pSMEMgr->_totalFree.add( numPages ) ;
       }
+
+   done :
       PD_TRACE_EXITRC ( SDB__DMSSMS_RLSPAGES, rc );
       return rc ;
    error :
@@ -309,8 +364,7 @@ namespace engine
 
    UINT16 _dmsSegmentSpace::totalFree ()
    {
-      ossScopedLock lock( &_mutex ) ;
-      return _totalFree ;
+      return (UINT16)_totalFree.peek() ;
    }
 
    /*
@@ -319,8 +373,15 @@ namespace engine
    _dmsSMEMgr::_dmsSMEMgr ()
    :_totalFree( 0 ), _freePos( 0 )
    {
-      _pStorageBase  = NULL ;
-      _pSME          = NULL ;
+      _pageSize            = 0 ;
+      _segmentPages        = 0 ;
+      _segmentPagesSquare  = 0 ;
+      _pStorageBase        = NULL ;
+      _pSME                = NULL ;
+      for ( UINT32 i = 0 ; i < DMS_SME_HINT_NUM ; ++i )
+      {
+         _hints[ i ]._pos = 0 ;
+      }
    }
 
    _dmsSMEMgr::~_dmsSMEMgr ()
@@ -335,27 +396,40 @@ namespace engine
       _pSME = NULL ;
    }
 
-   // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSSMEMGR_INIT, "_dmsSMEMgr::init" )
+   dmsSMEHint &_dmsSMEMgr::_getHint ()
+   {
+      return _hints[ (UINT32)ossGetCurrentThreadID() % DMS_SME_HINT_NUM ] ;
+   }
+
    INT32 _dmsSMEMgr::init ( _dmsStorageBase *pStorageBase,
                             _dmsSpaceManagementExtent *pSME )
+   {
+      _pStorageBase = pStorageBase ;
+      return init( pStorageBase->pageSize(),
+                   pStorageBase->segmentPagesSquareRoot(),
+                   pStorageBase->pageNum(), pSME ) ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSSMEMGR_INIT, "_dmsSMEMgr::init" )
+   INT32 _dmsSMEMgr::init ( UINT32 pageSize, UINT32 segmentPagesSquare,
+                            UINT32 pageNum, _dmsSpaceManagementExtent *pSME )
    {
       PD_TRACE_ENTRY ( SDB__DMSSMEMGR_INIT ) ;
 
-      INT32 rc          = SDB_OK ;
-      _pageSize         = pStorageBase->pageSize() ;
-      _pStorageBase     = pStorageBase ;
-      _pSME             = pSME ;
+      INT32 rc             = SDB_OK ;
+      _pageSize            = pageSize ;
+      _segmentPagesSquare  = segmentPagesSquare ;
+      _segmentPages        = 1 << segmentPagesSquare ;
+      _pSME                = pSME ;
 
-      UINT32 segmentPages = pStorageBase->segmentPages() ;
-      UINT32 segmentPagesSqure = pStorageBase->segmentPagesSquareRoot() ;
       UINT32 releaseBegin  = 0 ;
       BOOLEAN inUse        = FALSE ;
       dmsSegmentSpace      *newspace = NULL ;
       UINT32 i             = 0 ;
 
-      for ( i = 0 ; i < pStorageBase->pageNum() ; ++i )
+      for ( i = 0 ; i < pageNum ; ++i )
       {
-         if ( 0 == ( i & ( ( 1 << segmentPagesSqure ) - 1 ) ) )
+         if ( 0 == ( i & ( _segmentPages - 1 ) ) )
          {
             if ( newspace && !inUse )
             {
@@ -369,13 +443,22 @@ namespace engine
                _totalFree.add( i - releaseBegin ) ;
             }
 
-            newspace = SDB_OSS_NEW dmsSegmentSpace( i, segmentPages, this ) ;
+            newspace = SDB_OSS_NEW dmsSegmentSpace( i, _segmentPages, this ) ;
             if ( NULL == newspace )
             {
                PD_LOG ( PDERROR, "Unable to allocate memory" ) ;
                rc = SDB_OOM ;
                goto error ;
             }
+            rc = newspace->init() ;
+            if ( rc )
+            {
+               PD_LOG ( PDERROR, "Failed to init segment space, rc = %d",
+                        rc ) ;
+               SDB_OSS_DEL newspace ;
+               newspace = NULL ;
+               goto error ;
+            }
             _segments.push_back( newspace ) ;
             inUse = FALSE ;
             releaseBegin = i ;
@@ -427,18 +510,38 @@ namespace engine
       INT32 rc = SDB_OK ;
       UINT32 pos = 0 ;
       UINT32 size = 0 ;
+      UINT32 freePos = 0 ;
+      UINT32 startPos = 0 ;
+      UINT32 scanNum = 0 ;
+      dmsSMEHint &hint = _getHint() ;
 
       ossScopedRWLock lock( &_mutex, SHARED ) ;
 
       size = _segments.size() ;
-      pos = _freePos.fetch() ;
+      freePos = _freePos.fetch() ;
+      scanNum = size > freePos ? size - freePos : 0 ;
 
-      while( pos < size )
+      // start from the segment this thread reserved from last time, then
+      // wrap around to the first free segment
+      startPos = hint._pos ;
+      if ( startPos < freePos || startPos >= size )
       {
+         startPos = freePos ;
+      }
+
+      for ( UINT32 i = 0 ; i < scanNum ; ++i )
+      {
+         pos = startPos + i ;
+         if ( pos >= size )
+         {
+            pos -= scanNum ;
+         }
+
          rc = _segments[pos]->reservePages( numPages, foundPage,
                                             pos, &_freePos ) ;
          if ( SDB_OK == rc )
          {
+            hint._pos = pos ;
             goto done ;
          }
          else if ( SDB_DMS_NOSPC != rc )
@@ -446,7 +549,6 @@ namespace engine
             PD_LOG ( PDERROR, "Failed to reserve pages, rc = %d", rc ) ;
             goto error ;
          }
-         ++pos ;
       }
 
       rc = SDB_OK ;
@@ -469,9 +571,8 @@ namespace engine
       PD_TRACE_ENTRY ( SDB__DMSSMEMGR_RLSPAGES ) ;
 
       INT32 rc             = SDB_OK ;
-      UINT32 segmentPagesSqure = _pStorageBase->segmentPagesSquareRoot () ;
-      UINT32 maxSegments   = DMS_MAX_PG >> segmentPagesSqure ;
-      UINT32 segmentID     = start >> segmentPagesSqure ;
+      UINT32 maxSegments   = DMS_MAX_PG >> _segmentPagesSquare ;
+      UINT32 segmentID     = start >> _segmentPagesSquare ;
 
       ossScopedRWLock lock( &_mutex, SHARED ) ;
 
@@ -505,11 +606,9 @@ namespace engine
       PD_TRACE_ENTRY ( SDB__DMSSMEMGR_DEPOSIT ) ;
 
       INT32 rc             = SDB_OK ;
-      UINT16 segmentPages  = (UINT16)_pStorageBase->segmentPages() ;
-      UINT32 segmentPagesSqure = _pStorageBase->segmentPagesSquareRoot() ;
-      
-      UINT32 maxSegments   = DMS_MAX_PG >> segmentPagesSqure ;
-      UINT32 segmentID     = start >> segmentPagesSqure ;
+      UINT16 segmentPages  = (UINT16)_segmentPages ;
+      UINT32 maxSegments   = DMS_MAX_PG >> _segmentPagesSquare ;
+      UINT32 segmentID     = start >> _segmentPagesSquare ;
       dmsSegmentSpace *newspace = NULL ;
 
       ossScopedRWLock lock( &_mutex, EXCLUSIVE ) ;
@@ -529,6 +628,13 @@ namespace engine
          rc = SDB_OOM ;
          goto error ;
       }
+      rc = newspace->init() ;
+      if ( rc )
+      {
+         PD_LOG ( PDERROR, "Failed to init segment space, rc = %d", rc ) ;
+         SDB_OSS_DEL newspace ;
+         goto error ;
+      }
       _segments.push_back ( newspace ) ;
       rc = newspace->releasePages ( start, segmentPages, FALSE ) ;
       if ( rc )
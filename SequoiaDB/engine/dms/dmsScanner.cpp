@@ -41,6 +41,7 @@
 #include "rtnIXScanner.hpp"
 #include "bpsPrefetch.hpp"
 #include "dmsCompress.hpp"
+#include "dmsBlockExtent.hpp"
 #include "pmd.hpp"
 #include "pmdCB.hpp"
 
@@ -205,12 +206,29 @@ namespace engine
                                    DMS_ACCESS_TYPE accessType,
                                    INT64 maxRecords, INT64 skipNum )
    : _dmsExtScannerBase( su, context, matchRuntime, curExtentID, accessType,
-                         maxRecords, skipNum )
+                         maxRecords, skipNum ),
+     _columnFilter( NULL ),
+     _batchOffsets( NULL ),
+     _batchDatas( NULL ),
+     _batchNum( 0 ),
+     _batchPos( 0 )
    {
    }
 
    _dmsExtScanner::~_dmsExtScanner()
    {
+      _columnFilter = NULL ;
+      if ( _batchOffsets )
+      {
+         SDB_OSS_FREE( _batchOffsets ) ;
+         _batchOffsets = NULL ;
+      }
+      if ( _batchDatas )
+      {
+         SDB_OSS_FREE( _batchDatas ) ;
+         _batchDatas = NULL ;
+      }
+      _batch.release() ;
    }
 
    INT32 _dmsExtScanner::_firstInit( pmdEDUCB *cb )
@@ -268,6 +286,13 @@ namespace engine
       _cb   = cb ;
       _next = _extent->_firstRecordOffset ;
 
+      _batchNum = 0 ;
+      _batchPos = 0 ;
+      if ( NULL == _batchOffsets )
+      {
+         _initColumnFilter() ;
+      }
+
       _firstRun = FALSE ;
 
    done:
@@ -276,6 +301,259 @@ namespace engine
       goto done ;
    }
 
+   void _dmsExtScanner::_initColumnFilter()
+   {
+      INT32 rc = SDB_OK ;
+      UINT32 batchSize = pmdGetOptionCB()->scanBatchSize() ;
+      mthMatchTree *matcher = NULL ;
+
+      // records are locked one by one with write access, and the compressed
+      // records would be uncompressed twice, so only filter by batch for
+      // normal read
+      if ( _recordXLock || 0 == batchSize || NULL == _matchRuntime ||
+           OSS_BIT_TEST( _context->mb()->_attributes,
+                         DMS_MB_ATTR_COMPRESSED ) )
+      {
+         goto done ;
+      }
+
+      // the match runtime may be shared by the cached plan, so the filter
+      // is built by each scanner
+      matcher = _matchRuntime->getMatchTree() ;
+      if ( NULL == matcher ||
+           !matcher->buildColumnFilter( _filter,
+                                        _matchRuntime->getParametersPointer() ) )
+      {
+         goto done ;
+      }
+
+      if ( batchSize > MTH_COLUMN_MAX_BATCH_SIZE )
+      {
+         batchSize = MTH_COLUMN_MAX_BATCH_SIZE ;
+      }
+
+      rc = _batch.init( _filter.getFieldNum(), batchSize ) ;
+      if ( rc )
+      {
+         PD_LOG( PDWARNING, "Failed to init column batch, rc: %d", rc ) ;
+         goto done ;
+      }
+
+      _batchOffsets = ( dmsOffset* )SDB_OSS_MALLOC( batchSize *
+                                                    sizeof( dmsOffset ) ) ;
+      _batchDatas = ( const CHAR** )SDB_OSS_MALLOC( batchSize *
+                                                    sizeof( const CHAR* ) ) ;
+      if ( NULL == _batchOffsets || NULL == _batchDatas )
+      {
+         PD_LOG( PDWARNING, "Failed to allocate batch offsets, size: %u",
+                 batchSize ) ;
+         if ( _batchOffsets )
+         {
+            SDB_OSS_FREE( _batchOffsets ) ;
+            _batchOffsets = NULL ;
+         }
+         if ( _batchDatas )
+         {
+            SDB_OSS_FREE( _batchDatas ) ;
+            _batchDatas = NULL ;
+         }
+         _batch.release() ;
+         goto done ;
+      }
+
+      _columnFilter = &_filter ;
+
+   done:
+      return ;
+   }
+
+   INT32 _dmsExtScanner::_fillBatch( pmdEDUCB *cb )
+   {
+      INT32 rc = SDB_OK ;
+      dmsRecordData recordData ;
+      // the data of a sealed extent is in the chunk cache of the EDU, which
+      // may be replaced by the later records of the batch
+      BOOLEAN sealed = dmsIsBlockExtent( _extent ) ;
+
+      _batchNum = 0 ;
+      _batchPos = 0 ;
+
+      while ( DMS_INVALID_OFFSET != _next && _batchNum < _batch.capacity() )
+      {
+         _curRID._offset = _next ;
+         _recordRW = _pSu->record2RW( _curRID, _context->mbID() ) ;
+         _curRecordPtr = _recordRW.readPtr( 0 ) ;
+         _next = _curRecordPtr->getNextOffset() ;
+
+         if ( _curRecordPtr->isDeleting() )
+         {
+            continue ;
+         }
+         SDB_ASSERT( !_curRecordPtr->isDeleted(), "record can't be deleted" ) ;
+
+         rc = _pSu->extractData( _context, _recordRW, cb, recordData ) ;
+         if ( rc )
+         {
+            PD_LOG( PDERROR, "Extract record data failed, rc: %d", rc ) ;
+            goto error ;
+         }
+
+         try
+         {
+            BSONObj obj( recordData.data() ) ;
+            _columnFilter->extractRow( obj, _batch, _batchNum ) ;
+         }
+         catch( std::exception &e )
+         {
+            PD_LOG ( PDERROR, "Failed to create BSON object: %s",
+                     e.what() ) ;
+            rc = SDB_SYS ;
+            goto error ;
+         }
+
+         _batchOffsets[ _batchNum ] = _curRID._offset ;
+         // the data in place is kept while the mb is locked, the uncompressed
+         // or overflowed one is read again at fetch
+         _batchDatas[ _batchNum ] = ( sealed || _curRecordPtr->isOvf() ||
+                                      _curRecordPtr->isCompressed() ) ?
+                                    NULL : recordData.data() ;
+         ++_batchNum ;
+      }
+
+      if ( _batchNum > 0 )
+      {
+         _columnFilter->evaluate( _batch, _batchNum ) ;
+      }
+
+   done:
+      return rc ;
+   error:
+      _batchNum = 0 ;
+      goto done ;
+   }
+
+   INT32 _dmsExtScanner::_fetchNextBatch( dmsRecordID &recordID,
+                                          _mthRecordGenerator &generator,
+                                          pmdEDUCB *cb,
+                                          _mthMatchTreeContext *mthContext )
+   {
+      INT32 rc                = SDB_OK ;
+      BOOLEAN result          = TRUE ;
+      ossValuePtr recordDataPtr ;
+      dmsRecordData recordData ;
+      const CHAR *pData       = NULL ;
+      UINT8 state             = MTH_COLUMN_ROW_REJECT ;
+      _mthMatchTree *matcher  = _matchRuntime->getMatchTree() ;
+      rtnParamList *parameters = _matchRuntime->getParametersPointer() ;
+
+      while ( 0 != _maxRecords )
+      {
+         if ( _batchPos >= _batchNum )
+         {
+            rc = _fillBatch( cb ) ;
+            if ( rc )
+            {
+               goto error ;
+            }
+            if ( 0 == _batchNum )
+            {
+               break ;
+            }
+         }
+
+         state = _batch.getState( _batchPos ) ;
+         _curRID._offset = _batchOffsets[ _batchPos ] ;
+         pData = _batchDatas[ _batchPos ] ;
+         ++_batchPos ;
+
+         if ( MTH_COLUMN_ROW_REJECT == state )
+         {
+            continue ;
+         }
+
+         _recordRW = _pSu->record2RW( _curRID, _context->mbID() ) ;
+         _curRecordPtr = _recordRW.readPtr( 0 ) ;
+
+         recordID = _curRID ;
+         if ( NULL == pData )
+         {
+            rc = _pSu->extractData( _context, _recordRW, cb, recordData ) ;
+            if ( rc )
+            {
+               PD_LOG( PDERROR, "Extract record data failed, rc: %d", rc ) ;
+               goto error ;
+            }
+            pData = recordData.data() ;
+         }
+         recordDataPtr = ( ossValuePtr )pData ;
+         generator.setDataPtr( recordDataPtr ) ;
+
+         try
+         {
+            BSONObj obj( pData ) ;
+            mthContextClearRecordInfoSafe( mthContext ) ;
+
+            // only the rows the columns can't decide go to the match tree
+            result = TRUE ;
+            if ( MTH_COLUMN_ROW_FALLBACK == state )
+            {
+               rc = matcher->matches( obj, result, mthContext, parameters ) ;
+               if ( rc )
+               {
+                  PD_LOG( PDERROR, "Failed to match record, rc: %d", rc ) ;
+                  goto error ;
+               }
+            }
+
+            if ( result )
+            {
+               rc = generator.resetValue( obj, mthContext ) ;
+               PD_RC_CHECK( rc, PDERROR, "resetValue failed:rc=%d", rc ) ;
+
+               if ( _skipNum > 0 )
+               {
+                  if ( _skipNum >= generator.getRecordNum() )
+                  {
+                     _skipNum -= generator.getRecordNum() ;
+                  }
+                  else
+                  {
+                     generator.popFront( _skipNum ) ;
+                     _skipNum = 0 ;
+                     _checkMaxRecordsNum( generator ) ;
+
+                     goto done ;
+                  }
+               }
+               else
+               {
+                  _checkMaxRecordsNum( generator ) ;
+                  goto done ; // find ok
+               }
+            }
+         }
+         catch( std::exception &e )
+         {
+            PD_LOG ( PDERROR, "Failed to create BSON object: %s",
+                     e.what() ) ;
+            rc = SDB_SYS ;
+            goto error ;
+         }
+      }
+
+      rc = SDB_DMS_EOC ;
+      goto error ;
+
+   done:
+      return rc ;
+   error:
+      recordID.reset() ;
+      recordDataPtr = 0 ;
+      generator.setDataPtr( recordDataPtr ) ;
+      _curRID._offset = DMS_INVALID_OFFSET ;
+      goto done ;
+   }
+
    INT32 _dmsExtScanner::_fetchNext( dmsRecordID &recordID,
                                      _mthRecordGenerator &generator,
                                      pmdEDUCB *cb,
@@ -287,6 +565,11 @@ namespace engine
       dmsRecordData recordData ;
       BOOLEAN lockedRecord    = FALSE ;
 
+      if ( _columnFilter )
+      {
+         return _fetchNextBatch( recordID, generator, cb, mthContext ) ;
+      }
+
       if ( !_matchRuntime && _skipNum > 0 && _skipNum >= _extent->_recCount )
       {
          _skipNum -= _extent->_recCount ;
@@ -44,6 +44,8 @@
 #include "pmdStartup.hpp"
 #include "utilStr.hpp"
 #include "pmdEnv.hpp"
+#include "pmdEDU.hpp"
+#include "dmsBlockExtent.hpp"
 
 using namespace bson ;
 
@@ -287,9 +289,51 @@ namespace engine
          }
          throw pdGeneralException( SDB_SYS, text ) ;
       }
+      if ( _pBase->hasBlockExtent() &&
+           offset + len > DMS_EXTENT_METADATA_SZ &&
+           dmsIsBlockExtent( ( const dmsExtent* )_ptr ) )
+      {
+         return _readBlock( offset, len ) ;
+      }
       return ( const CHAR* )_ptr + offset ;
    }
 
+   const CHAR* _dmsExtRW::_readBlock( UINT32 offset, UINT32 len )
+   {
+      INT32 rc = SDB_OK ;
+      const CHAR *ptr = NULL ;
+      pmdEDUCB *cb = pmdGetThreadEDUCB() ;
+      dmsBlockCache *pCache = cb ? cb->getBlockCache() : NULL ;
+
+      if ( !pCache )
+      {
+         _raiseError( SDB_OOM, "Failed to get block cache: " ) ;
+         return NULL ;
+      }
+      ptr = pCache->read( _pBase, _extentID, ( const dmsExtent* )_ptr,
+                          offset, len, rc ) ;
+      if ( rc )
+      {
+         _raiseError( rc, "Failed to read block extent: " ) ;
+         return NULL ;
+      }
+      return ptr ;
+   }
+
+   void _dmsExtRW::_raiseError( INT32 rc, const CHAR *pDesc )
+   {
+      std::string text = pDesc ;
+      text += toString() ;
+
+      if ( isNothrow() )
+      {
+         PD_LOG( PDERROR, "Exception: %s", text.c_str() ) ;
+         pdSetLastError( rc ) ;
+         return ;
+      }
+      throw pdGeneralException( rc, text ) ;
+   }
+
    CHAR* _dmsExtRW::writePtr( UINT32 offset, UINT32 len )
    {
       if ( (ossValuePtr)0 == _ptr )
@@ -307,6 +351,19 @@ namespace engine
       }
       _markDirty() ;
       _pBase->markDirty( _collectionID, _extentID, DMS_CHG_BEFORE ) ;
+      // the records of the block extent are changed in place, so the
+      // extent is decompressed first
+      if ( _pBase->hasBlockExtent() &&
+           offset + len > DMS_EXTENT_METADATA_SZ &&
+           dmsIsBlockExtent( ( const dmsExtent* )_ptr ) )
+      {
+         INT32 rc = _pBase->unsealExtent( _extentID ) ;
+         if ( rc )
+         {
+            _raiseError( rc, "Failed to unseal block extent: " ) ;
+            return NULL ;
+         }
+      }
       return ( CHAR* )_ptr + offset ;
    }
 
@@ -366,6 +423,7 @@ namespace engine
       _pageSizeSquare     = 0 ;
       _isTempSU           = FALSE ;
       _blockScanSupport   = TRUE ;
+      _hasBlockExtent     = FALSE ;
       _pageSize           = 0 ;
       _lobPageSize        = 0 ;
 
@@ -1585,6 +1643,25 @@ namespace engine
          }
       }
 
+      // the pages may be punched out when they were in a block extent,
+      // allocate the disk space before they are written
+      if ( _hasBlockExtent && DMS_INVALID_EXTENT != foundPage )
+      {
+         rc = reservePages( foundPage, 0, numPages ) ;
+         if ( SDB_OPERATION_INCOMPATIBLE == rc )
+         {
+            rc = SDB_OK ;
+         }
+         else if ( rc )
+         {
+            PD_LOG( PDERROR, "Failed to reserve %d pages from page[%d], "
+                    "rc: %d", numPages, foundPage, rc ) ;
+            _smeMgr.releasePages( foundPage, numPages ) ;
+            foundPage = DMS_INVALID_EXTENT ;
+            goto error ;
+         }
+      }
+
       if ( _extendThreshold() > 0 &&
            _smeMgr.totalFree() < _extendThreshold() &&
            ossTestAndLatch( &_segmentLatch, EXCLUSIVE ) )
@@ -1862,6 +1939,67 @@ namespace engine
       _blockScanSupport = FALSE ;
    }
 
+   INT32 _dmsStorageBase::releasePages( dmsExtentID extentID,
+                                        UINT32 pageOffset,
+                                        UINT32 pageNum )
+   {
+      UINT32 segOffset = 0 ;
+      UINT32 segID = extent2Segment( extentID, &segOffset ) ;
+
+      return releaseBlock( segID, ( segOffset + pageOffset ) <<
+                                  _pageSizeSquare,
+                           pageNum << _pageSizeSquare ) ;
+   }
+
+   INT32 _dmsStorageBase::reservePages( dmsExtentID extentID,
+                                        UINT32 pageOffset,
+                                        UINT32 pageNum )
+   {
+      UINT32 segOffset = 0 ;
+      UINT32 segID = extent2Segment( extentID, &segOffset ) ;
+
+      return reserveBlock( segID, ( segOffset + pageOffset ) <<
+                                  _pageSizeSquare,
+                           pageNum << _pageSizeSquare ) ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSSTORAGEBASE_UNSEALEXTENT, "_dmsStorageBase::unsealExtent" )
+   INT32 _dmsStorageBase::unsealExtent( dmsExtentID extentID )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__DMSSTORAGEBASE_UNSEALEXTENT ) ;
+      dmsExtent *pExtent = ( dmsExtent* )extentAddr( extentID ) ;
+
+      PD_CHECK( pExtent, SDB_SYS, error, PDERROR,
+                "Invalid extent[%d]", extentID ) ;
+      if ( !dmsIsBlockExtent( pExtent ) )
+      {
+         goto done ;
+      }
+
+      // the pages after the block were punched out, allocate them before
+      // they are written
+      rc = reservePages( extentID, 0, pExtent->_blockSize ) ;
+      if ( SDB_OPERATION_INCOMPATIBLE == rc )
+      {
+         rc = SDB_OK ;
+      }
+      PD_RC_CHECK( rc, PDERROR, "Failed to reserve the pages of extent[%d], "
+                   "rc: %d", extentID, rc ) ;
+
+      rc = dmsBlockUnseal( pExtent, pExtent->_blockSize << _pageSizeSquare ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to unseal extent[%d] of "
+                   "storage[%s], rc: %d", extentID, getSuName(), rc ) ;
+      PD_LOG( PDDEBUG, "Unsealed extent[%d] of storage[%s]", extentID,
+              getSuName() ) ;
+
+   done:
+      PD_TRACE_EXITRC ( SDB__DMSSTORAGEBASE_UNSEALEXTENT, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
    /*
       DMS TOOL FUNCTIONS:
    */
@@ -48,6 +48,8 @@
 #include "dmsTrace.hpp"
 #include "pd.hpp"
 #include "utilCompressor.hpp"
+#include "dmsBlockExtent.hpp"
+#include "dmsCB.hpp"
 
 using namespace bson ;
 
@@ -171,6 +173,7 @@ namespace engine
    #define DMS_MB_ATTR_NOIDINDEX_STR                         "NoIDIndex"
    #define DMS_MB_ATTR_CAPPED_STR                            "Capped"
    #define DMS_MB_ATTR_STRICTDATAMODE_STR                    "StrictDataMode"
+   #define DMS_MB_ATTR_BLOCKCOMPRESSED_STR                   "BlockCompressed"
    // PD_TRACE_DECLARE_FUNCTION ( SDB__MBATTR2STRING, "mbAttr2String" )
    void mbAttr2String( UINT32 attributes, CHAR * pBuffer, INT32 bufSize )
    {
@@ -198,6 +201,12 @@ namespace engine
          appendFlagString( pBuffer, bufSize, DMS_MB_ATTR_STRICTDATAMODE_STR ) ;
          OSS_BIT_CLEAR( attributes, DMS_MB_ATTR_STRICTDATAMODE ) ;
       }
+      if ( OSS_BIT_TEST( attributes, DMS_MB_ATTR_BLOCKCOMPRESSED ) )
+      {
+         appendFlagString( pBuffer, bufSize,
+                           DMS_MB_ATTR_BLOCKCOMPRESSED_STR ) ;
+         OSS_BIT_CLEAR( attributes, DMS_MB_ATTR_BLOCKCOMPRESSED ) ;
+      }
 
       if ( attributes )
       {
@@ -430,7 +439,14 @@ namespace engine
          }
          throw pdGeneralException( SDB_DMS_CORRUPTED_EXTENT, text ) ;
       }
-      return (dmsRecord*)_rw.writePtr( _rid._offset, len ) ;
+      dmsRecord *pRecord = (dmsRecord*)_rw.writePtr( _rid._offset, len ) ;
+      // the block extent is decompressed in place by the write, so the
+      // cached pointer is moved to the extent
+      if ( pRecord )
+      {
+         _ptr = pRecord ;
+      }
+      return pRecord ;
    }
 
    std::string _dmsRecordRW::toString() const
@@ -889,6 +905,12 @@ namespace engine
                          "collection: %s, rc = %d",
                          _dmsMME->_mbList[i]._collectionName, rc ) ;
          }
+         if ( DMS_IS_MB_INUSE( _dmsMME->_mbList[i]._flag ) &&
+              OSS_BIT_TEST( _dmsMME->_mbList[i]._attributes,
+                            DMS_MB_ATTR_BLOCKCOMPRESSED ) )
+         {
+            enableBlockExtent() ;
+         }
       }
 
    done:
@@ -1201,6 +1223,17 @@ namespace engine
          _onAllocExtent( context, extAddr, firstFreeExtentID ) ;
       }
 
+      // the extent before the new one is full, seal it in the background
+      if ( !add2LoadList &&
+           OSS_BIT_TEST( context->mb()->_attributes,
+                         DMS_MB_ATTR_BLOCKCOMPRESSED ) &&
+           DMS_INVALID_EXTENT != extAddr->_prevExtent )
+      {
+         sdbGetDMSCB()->pushSealJob( dmsSealJob( _CSID, _logicalCSID,
+                                                 context->mbID(),
+                                                 context->clLID() ) ) ;
+      }
+
    done :
       PD_TRACE_EXITRC ( SDB__DMSSTORAGEDATACOMMON__ALLOCATEEXTENT, rc ) ;
       return rc ;
@@ -1991,6 +2024,10 @@ namespace engine
       }
 
       _setCompressor( context ) ;
+      if ( OSS_BIT_TEST( attributes, DMS_MB_ATTR_BLOCKCOMPRESSED ) )
+      {
+         enableBlockExtent() ;
+      }
 
       if ( 0 != initPages )
       {
@@ -2857,6 +2894,261 @@ namespace engine
       goto done ;
    }
 
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSSTORAGEDATACOMMON_LOADRECORDS, "_dmsStorageDataCommon::loadRecords" )
+   INT32 _dmsStorageDataCommon::loadRecords( dmsMBContext *context,
+                                             const CHAR *pBlock,
+                                             UINT32 blockSize,
+                                             UINT32 recordNum,
+                                             pmdEDUCB *cb,
+                                             SDB_DPSCB *dpscb )
+   {
+      INT32 rc                      = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__DMSSTORAGEDATACOMMON_LOADRECORDS ) ;
+      CHAR fullName[DMS_COLLECTION_FULL_NAME_SZ + 1] = {0} ;
+      dpsTransCB *pTransCB          = pmdGetKRCB()->getTransCB() ;
+      UINT32 logRecSize             = 0 ;
+      monAppCB * pMonAppCB          = cb ? cb->getMonAppCB() : NULL ;
+      dpsMergeInfo info ;
+      dpsLogRecord &logRecord       = info.getMergeBlock().record() ;
+      _dmsCompressorEntry *compressorEntry = &_compressorEntry[context->mbID()] ;
+      UINT32 textIdxNum             = 0 ;
+      UINT32 offset                 = 0 ;
+      UINT32 insertedNum            = 0 ;
+      dmsExtentID firstExtLID       = DMS_INVALID_EXTENT ;
+      DMS_LOAD_RECORDS records ;
+
+      if ( 0 == recordNum || blockSize > DMS_LOAD_BLOCK_MAX_SZ )
+      {
+         PD_LOG( PDERROR, "Invalid block, size: %u, record num: %u",
+                 blockSize, recordNum ) ;
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+
+      {
+         // the loaded records are not compressed, let the caller insert
+         // them one by one
+         dmsCompressorGuard compGuard( compressorEntry, SHARED ) ;
+         if ( compressorEntry->ready() )
+         {
+            PD_LOG( PDERROR, "Bulk load is not supported on compressed "
+                    "collection" ) ;
+            rc = SDB_OPTION_NOT_SUPPORT ;
+            goto error ;
+         }
+      }
+
+      try
+      {
+         records.reserve( recordNum ) ;
+         while ( offset < blockSize )
+         {
+            dmsLoadRecord loadRecord ;
+            const CHAR *pCheckErr = "" ;
+            UINT32 size = 0 ;
+
+            if ( blockSize - offset < DMS_LOAD_RECORD_MIN_SZ )
+            {
+               PD_LOG( PDERROR, "Invalid record at offset[%u] of block",
+                       offset ) ;
+               rc = SDB_INVALIDARG ;
+               goto error ;
+            }
+            size = *(const UINT32*)( pBlock + offset ) ;
+            if ( size < DMS_LOAD_RECORD_MIN_SZ || size > blockSize - offset )
+            {
+               PD_LOG( PDERROR, "Invalid record size[%u] at offset[%u] of "
+                       "block", size, offset ) ;
+               rc = SDB_INVALIDARG ;
+               goto error ;
+            }
+            else if ( size + DMS_RECORD_METADATA_SZ > DMS_RECORD_USER_MAX_SZ )
+            {
+               rc = SDB_DMS_RECORD_TOO_BIG ;
+               goto error ;
+            }
+
+            loadRecord._obj = BSONObj( pBlock + offset ) ;
+            BSONElement ele = loadRecord._obj.getField( DMS_ID_KEY_NAME ) ;
+            if ( ele.eoo() || !dmsIsRecordIDValid( ele, FALSE, &pCheckErr ) )
+            {
+               PD_LOG( PDERROR, "Record[%s] _id is error: %s",
+                       loadRecord._obj.toString().c_str(),
+                       ele.eoo() ? "_id is missing" : pCheckErr ) ;
+               rc = SDB_INVALIDARG ;
+               goto error ;
+            }
+            records.push_back( loadRecord ) ;
+            offset += ossAlign4( size ) ;
+         }
+      }
+      catch( std::exception &e )
+      {
+         PD_LOG( PDERROR, "Occur exception: %s", e.what() ) ;
+         rc = pdGetLastError() ? pdGetLastError() : SDB_SYS ;
+         goto error ;
+      }
+
+      if ( records.size() != recordNum )
+      {
+         PD_LOG( PDERROR, "Record num[%u] of block is not %u",
+                 records.size(), recordNum ) ;
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+
+      if ( dpscb )
+      {
+         _clFullName( context->mb()->_collectionName, fullName,
+                      sizeof(fullName) ) ;
+         rc = dpsLoad2Record( fullName, pBlock, blockSize, recordNum,
+                              logRecord ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to build record, rc: %d", rc ) ;
+
+         logRecSize = ossAlign4( logRecord.alignedLen() ) ;
+
+         rc = dpscb->checkSyncControl( logRecSize, cb ) ;
+         if ( SDB_OK != rc )
+         {
+            logRecSize = 0 ;
+            PD_LOG( PDERROR, "Check sync control failed, rc: %d", rc ) ;
+            goto error ;
+         }
+
+         rc = pTransCB->reservedLogSpace( logRecSize, cb ) ;
+         if ( rc )
+         {
+            PD_LOG( PDERROR, "Failed to reserved log space(length=%u)",
+                    logRecSize ) ;
+            logRecSize = 0 ;
+            goto error ;
+         }
+      }
+
+      rc = context->mbLock( EXCLUSIVE ) ;
+      PD_RC_CHECK( rc, PDERROR, "dms mb context lock failed, rc: %d", rc ) ;
+
+      if ( !dmsAccessAndFlagCompatiblity ( context->mb()->_flag,
+                                           DMS_ACCESS_TYPE_INSERT ) )
+      {
+         PD_LOG ( PDERROR, "Incompatible collection mode: %d",
+                  context->mb()->_flag ) ;
+         rc = SDB_DMS_INCOMPATIBLE_MODE ;
+         goto error ;
+      }
+
+      try
+      {
+         // insert all the data first, the extents are filled in order
+         for ( UINT32 i = 0 ; i < records.size() ; ++i )
+         {
+            dmsLoadRecord &loadRecord = records[ i ] ;
+            UINT32 recordSize = loadRecord._obj.objsize() ;
+            const dmsExtent *pExtent = NULL ;
+            dmsRecordData recordData ;
+            dmsExtRW extRW ;
+            dmsRecordRW recordRW ;
+
+            recordData.setData( loadRecord._obj.objdata(),
+                                loadRecord._obj.objsize(), FALSE, TRUE ) ;
+            _finalRecordSize( recordSize, recordData ) ;
+
+            rc = _allocRecordSpace( context, recordSize, loadRecord._rid,
+                                    cb ) ;
+            PD_RC_CHECK( rc, PDERROR, "Allocate space for record failed, "
+                         "rc: %d", rc ) ;
+
+            extRW = extent2RW( loadRecord._rid._extent, context->mbID() ) ;
+            pExtent = extRW.readPtr<dmsExtent>() ;
+            if ( !pExtent->validate( context->mbID() ) )
+            {
+               ( void )_onInsertFail( context, FALSE, loadRecord._rid,
+                                      NULL, 0, cb ) ;
+               rc = SDB_SYS ;
+               goto error ;
+            }
+            recordRW = record2RW( loadRecord._rid, context->mbID() ) ;
+
+            rc = _extentInsertRecord( context, extRW, recordRW, recordData,
+                                      recordSize, cb, TRUE ) ;
+            if ( rc )
+            {
+               PD_LOG( PDERROR, "Failed to append record, rc: %d", rc ) ;
+               ( void )_onInsertFail( context, FALSE, loadRecord._rid,
+                                      NULL, 0, cb ) ;
+               goto error ;
+            }
+
+            ++insertedNum ;
+            _incWriteRecord() ;
+            loadRecord._extLID = pExtent->_logicID ;
+            if ( DMS_INVALID_EXTENT == firstExtLID ||
+                 loadRecord._extLID < firstExtLID )
+            {
+               firstExtLID = loadRecord._extLID ;
+            }
+         }
+         DMS_MON_OP_COUNT_INC( pMonAppCB, MON_INSERT, insertedNum ) ;
+
+         textIdxNum = context->mbStat()->_textIdxNum ;
+         rc = _pIdxSU->indexesInsertSorted( context, records, cb ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to insert to index, rc: %d", rc ) ;
+      }
+      catch( std::exception &e )
+      {
+         PD_LOG( PDERROR, "Occur exception: %s", e.what() ) ;
+         rc = pdGetLastError() ? pdGetLastError() : SDB_SYS ;
+         goto error ;
+      }
+
+      if ( dpscb )
+      {
+         PD_AUDIT_OP_WITHNAME( AUDIT_INSERT, "BULK LOAD", AUDIT_OBJ_CL,
+                               fullName, rc, "RecordNum: %u, Size: %u",
+                               recordNum, blockSize ) ;
+
+         // keep the lock, so that the records can be removed when failed.
+         // The log is notified with the lowest extent of the block, so the
+         // data sync sends it when any of the records has been scanned
+         rc = _logDPS( dpscb, info, cb, context, firstExtLID, FALSE,
+                       DMS_FILE_DATA ) ;
+         PD_RC_CHECK ( rc, PDERROR, "Failed to insert record into log, "
+                       "rc: %d", rc ) ;
+      }
+      else if ( cb->getLsnCount() > 0 )
+      {
+         context->mbStat()->updateLastLSNWithComp( cb->getEndLsn(),
+                                                   DMS_FILE_DATA,
+                                                   cb->isDoRollback() ) ;
+      }
+
+      if ( textIdxNum > 0 )
+      {
+         IDmsExtDataHandler* handler = getExtDataHandler() ;
+         if ( handler )
+         {
+            handler->done( cb ) ;
+         }
+      }
+
+   done:
+      if ( 0 != logRecSize )
+      {
+         pTransCB->releaseLogSpace( logRecSize, cb ) ;
+      }
+      PD_TRACE_EXITRC ( SDB__DMSSTORAGEDATACOMMON_LOADRECORDS, rc ) ;
+      return rc ;
+   error:
+      // the block is loaded as a whole, remove the inserted records
+      for ( UINT32 i = 0 ; i < insertedNum ; ++i )
+      {
+         ( void )_onInsertFail( context, TRUE, records[ i ]._rid, NULL,
+                                (ossValuePtr)records[ i ]._obj.objdata(),
+                                cb ) ;
+      }
+      goto done ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSSTORAGEDATACOMMON_DELETERECORD, "_dmsStorageDataCommon::deleteRecord" )
    INT32 _dmsStorageDataCommon::deleteRecord( dmsMBContext *context,
                                               const dmsRecordID &recordID,
@@ -3571,6 +3863,295 @@ namespace engine
       goto done ;
    }
 
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSSTORAGEDATACOMMON_SEALEXTENTS, "_dmsStorageDataCommon::sealExtents" )
+   INT32 _dmsStorageDataCommon::sealExtents( dmsMBContext *context,
+                                             pmdEDUCB *cb,
+                                             UINT32 &sealedNum )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB__DMSSTORAGEDATACOMMON_SEALEXTENTS ) ;
+      dmsExtentID extents[ DMS_BLOCK_SEAL_WINDOW ] ;
+      UINT32 extentNum = 0 ;
+      dmsExtentID lastID = DMS_INVALID_EXTENT ;
+      dmsExtentID newestID = DMS_INVALID_EXTENT ;
+      dmsExtentID extentID = DMS_INVALID_EXTENT ;
+      const dmsExtent *pExtent = NULL ;
+      dmsExtRW extRW ;
+      BOOLEAN sealed = FALSE ;
+
+      SDB_ASSERT( !context->isMBLock(), "mb should not have been locked" ) ;
+      sealedNum = 0 ;
+
+      rc = context->mbLock( EXCLUSIVE ) ;
+      PD_RC_CHECK( rc, PDERROR, "dms mb context lock failed, rc: %d", rc ) ;
+
+      if ( !OSS_BIT_TEST( context->mb()->_attributes,
+                          DMS_MB_ATTR_BLOCKCOMPRESSED ) ||
+           OSS_BIT_TEST( context->mb()->_attributes, DMS_MB_ATTR_CAPPED ) )
+      {
+         goto done ;
+      }
+
+      /*
+         The last extent is being filled. Walk back from the one before it
+         until the extent checked last time or the sealed one, the extents
+         which are still not full are given up
+      */
+      lastID = context->mb()->_lastExtentID ;
+      extentID = lastID ;
+      while ( DMS_INVALID_EXTENT != extentID )
+      {
+         extRW = extent2RW( extentID, context->mbID() ) ;
+         extRW.setNothrow( TRUE ) ;
+         pExtent = extRW.readPtr<dmsExtent>() ;
+         PD_CHECK( pExtent && pExtent->validate( context->mbID() ),
+                   SDB_DMS_CORRUPTED_EXTENT, error, PDERROR,
+                   "Invalid extent[%d] of collection[%s]", extentID,
+                   context->mb()->_collectionName ) ;
+
+         if ( extentID == lastID )
+         {
+            newestID = pExtent->_prevExtent ;
+         }
+         else
+         {
+            if ( dmsIsBlockExtent( pExtent ) )
+            {
+               break ;
+            }
+            if ( pExtent->_freeSpace <= DMS_BLOCK_SEAL_MAX_FREE )
+            {
+               extents[ extentNum++ ] = extentID ;
+            }
+            if ( extentNum >= DMS_BLOCK_SEAL_WINDOW )
+            {
+               break ;
+            }
+         }
+
+         extentID = pExtent->_prevExtent ;
+         if ( extentID == context->mbStat()->_sealedExtentID )
+         {
+            break ;
+         }
+      }
+
+      context->mbStat()->_sealedExtentID = newestID ;
+      if ( 0 == extentNum )
+      {
+         goto done ;
+      }
+
+      context->mbUnlock() ;
+
+      // from the oldest, each extent is sealed with a short lock
+      while ( extentNum > 0 && !cb->isInterrupted() )
+      {
+         rc = _sealExtent( context, cb, extents[ --extentNum ], sealed ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to seal extent[%d] of "
+                      "collection[%s], rc: %d", extents[ extentNum ],
+                      context->mb()->_collectionName, rc ) ;
+         if ( sealed )
+         {
+            ++sealedNum ;
+         }
+      }
+
+   done:
+      if ( context->isMBLock() )
+      {
+         context->mbUnlock() ;
+      }
+      PD_TRACE_EXITRC( SDB__DMSSTORAGEDATACOMMON_SEALEXTENTS, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSSTORAGEDATACOMMON__UNLINKSEALSPACE, "_dmsStorageDataCommon::_unlinkSealSpace" )
+   INT32 _dmsStorageDataCommon::_unlinkSealSpace( dmsMBContext *context,
+                                                  pmdEDUCB *cb,
+                                                  dmsExtentID extentID,
+                                                  BOOLEAN testOnly,
+                                                  UINT32 &spaceSize )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB__DMSSTORAGEDATACOMMON__UNLINKSEALSPACE ) ;
+      dpsTransCB *pTransCB = pmdGetKRCB()->getTransCB() ;
+      dmsRecordID foundID ;
+      dmsRecordRW delRecordRW ;
+      const dmsDeletedRecord *pRead = NULL ;
+
+      SDB_ASSERT( context->isMBLock( EXCLUSIVE ), "mb must be locked" ) ;
+      spaceSize = 0 ;
+
+      try
+      {
+         for ( INT32 j = 0 ; j < dmsMB::_max ; ++j )
+         {
+            dmsRecordRW preRW ;
+            foundID = context->mb()->_deleteList[ j ] ;
+            for ( UINT32 i = 0 ; i < DMS_BLOCK_SEAL_MAX_WALK &&
+                                 !foundID.isNull() ; ++i )
+            {
+               delRecordRW = record2RW( foundID, context->mbID() ) ;
+               pRead = delRecordRW.readPtr<dmsDeletedRecord>() ;
+
+               // the record locked by transaction keeps the extent raw
+               if ( extentID == foundID._extent &&
+                    SDB_OK == pTransCB->transLockTestX( cb, _logicalCSID,
+                                                        context->mbID(),
+                                                        &foundID ) )
+               {
+                  spaceSize += pRead->getSize() ;
+                  if ( testOnly )
+                  {
+                     preRW = delRecordRW ;
+                  }
+                  else if ( preRW.isEmpty() )
+                  {
+                     context->mb()->_deleteList[ j ] = pRead->getNextRID() ;
+                  }
+                  else
+                  {
+                     dmsDeletedRecord *preWrite =
+                        preRW.writePtr<dmsDeletedRecord>() ;
+                     preWrite->setNextRID( pRead->getNextRID() ) ;
+                  }
+
+                  if ( !testOnly )
+                  {
+                     dmsExtRW rw = extent2RW( foundID._extent,
+                                              context->mbID() ) ;
+                     dmsExtent *pExtent = rw.writePtr<dmsExtent>() ;
+                     pExtent->_freeSpace -= pRead->getSize() ;
+                     context->mbStat()->_totalDataFreeSpace -=
+                        pRead->getSize() ;
+                  }
+               }
+               else
+               {
+                  preRW = delRecordRW ;
+               }
+               foundID = pRead->getNextRID() ;
+            }
+         }
+      }
+      catch( std::exception &e )
+      {
+         PD_LOG( PDERROR, "Occur exception: %s", e.what() ) ;
+         rc = SDB_SYS ;
+      }
+
+      PD_TRACE_EXITRC( SDB__DMSSTORAGEDATACOMMON__UNLINKSEALSPACE, rc ) ;
+      return rc ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSSTORAGEDATACOMMON__SEALEXTENT, "_dmsStorageDataCommon::_sealExtent" )
+   INT32 _dmsStorageDataCommon::_sealExtent( dmsMBContext *context,
+                                             pmdEDUCB *cb,
+                                             dmsExtentID extentID,
+                                             BOOLEAN &sealed )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB__DMSSTORAGEDATACOMMON__SEALEXTENT ) ;
+      dmsExtRW extRW ;
+      const dmsExtent *pExtent = NULL ;
+      dmsExtent *pWriteExt = NULL ;
+      CHAR *pBlock = NULL ;
+      CHAR *pPayload = NULL ;
+      UINT32 blockSize = 0 ;
+      UINT32 usedPages = 0 ;
+      UINT32 spaceSize = 0 ;
+
+      sealed = FALSE ;
+
+      rc = context->mbLock( EXCLUSIVE ) ;
+      PD_RC_CHECK( rc, PDERROR, "dms mb context lock failed, rc: %d", rc ) ;
+
+      extRW = extent2RW( extentID, context->mbID() ) ;
+      extRW.setNothrow( TRUE ) ;
+      pExtent = extRW.readPtr<dmsExtent>() ;
+      // the extent may be changed when the lock was released
+      if ( !pExtent || !pExtent->validate( context->mbID() ) ||
+           dmsIsBlockExtent( pExtent ) )
+      {
+         goto done ;
+      }
+
+      /*
+         Nothing is changed until the block is built: all the deleted
+         records of the extent must be able to be taken out of the delete
+         list, then the block is compressed, and the records are unlinked
+         at last. An extent which is skipped keeps its free space
+      */
+      rc = _unlinkSealSpace( context, cb, extentID, TRUE, spaceSize ) ;
+      if ( rc || spaceSize != (UINT32)pExtent->_freeSpace )
+      {
+         rc = SDB_OK ;
+         goto done ;
+      }
+
+      rc = dmsBlockCompress( pExtent, (UINT32)pExtent->_blockSize <<
+                                      pageSizeSquareRoot(),
+                             &pBlock, blockSize ) ;
+      if ( SDB_UTIL_COMPRESS_ABORT == rc )
+      {
+         rc = SDB_OK ;
+         goto done ;
+      }
+      PD_RC_CHECK( rc, PDERROR, "Failed to compress extent[%d], rc: %d",
+                   extentID, rc ) ;
+
+      if ( spaceSize > 0 )
+      {
+         rc = _unlinkSealSpace( context, cb, extentID, FALSE, spaceSize ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to unlink the deleted records of "
+                      "extent[%d], rc: %d", extentID, rc ) ;
+         // the delete list can't change under the mb lock, and all the
+         // records of the extent passed the lock test, so all are unlinked
+         PD_CHECK( 0 == pExtent->_freeSpace, SDB_SYS, error, PDERROR,
+                   "Deleted records of extent[%d] are left", extentID ) ;
+      }
+
+      pPayload = extRW.writePtr( DMS_EXTENT_METADATA_SZ, blockSize ) ;
+      pWriteExt = extRW.writePtr<dmsExtent>() ;
+      PD_CHECK( pPayload && pWriteExt, SDB_SYS, error, PDERROR,
+                "Get extent[%d] address failed", extentID ) ;
+      ossMemcpy( pPayload, pBlock, blockSize ) ;
+      pWriteExt->_flag |= DMS_EXTENT_FLAG_COMPRESSED ;
+      sealed = TRUE ;
+
+      // give back the disk space after the block, it's allocated again
+      // before the extent is unsealed
+      usedPages = ( DMS_EXTENT_METADATA_SZ + blockSize + pageSize() - 1 ) >>
+                  pageSizeSquareRoot() ;
+      if ( usedPages < pExtent->_blockSize )
+      {
+         INT32 rcTmp = releasePages( extentID, usedPages,
+                                     pExtent->_blockSize - usedPages ) ;
+         if ( rcTmp && SDB_OPERATION_INCOMPATIBLE != rcTmp )
+         {
+            PD_LOG( PDWARNING, "Failed to release the pages of extent[%d], "
+                    "rc: %d", extentID, rcTmp ) ;
+         }
+      }
+
+   done:
+      if ( context->isMBLock() )
+      {
+         context->mbUnlock() ;
+      }
+      if ( pBlock )
+      {
+         SDB_OSS_FREE( pBlock ) ;
+      }
+      PD_TRACE_EXITRC( SDB__DMSSTORAGEDATACOMMON__SEALEXTENT, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
    UINT32 _dmsStorageDataCommon::_getRecordDataLen( const dmsRecord *pRecord )
    {
       if ( pRecord->isOvf() )
@@ -47,6 +47,7 @@
 #include "pdTrace.hpp"
 #include "dmsTrace.hpp"
 #include "dmsIndexBuilder.hpp"
+#include <algorithm>
 
 using namespace bson ;
 
@@ -692,7 +693,8 @@ namespace engine
          }
 
          {
-            ixmExtent idx( rootExtentID, context->mbID(), this ) ;
+            ixmExtent idx( rootExtentID, context->mbID(), this,
+                           indexCB.normalizedKey() ) ;
          }
          indexCB.setRoot ( rootExtentID ) ;
 
@@ -1420,6 +1422,134 @@ namespace engine
       goto done ;
    }
 
+   typedef std::pair< BSONObj, dmsRecordID >       dmsKeyRID ;
+
+   struct _dmsKeyRIDLess
+   {
+      const Ordering *_pOrder ;
+
+      _dmsKeyRIDLess( const Ordering *pOrder ) : _pOrder( pOrder ) {}
+
+      bool operator() ( const dmsKeyRID &l, const dmsKeyRID &r ) const
+      {
+         INT32 res = l.first.woCompare( r.first, *_pOrder, false ) ;
+         if ( 0 != res )
+         {
+            return res < 0 ;
+         }
+         return l.second < r.second ;
+      }
+   } ;
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSSTORAGEINDEX_INDEXESINSERTSORTED, "_dmsStorageIndex::indexesInsertSorted" )
+   INT32 _dmsStorageIndex::indexesInsertSorted( dmsMBContext *context,
+                                                const DMS_LOAD_RECORDS &records,
+                                                pmdEDUCB *cb )
+   {
+      PD_TRACE_ENTRY ( SDB__DMSSTORAGEINDEX_INDEXESINSERTSORTED ) ;
+      INT32 rc                     = SDB_OK ;
+      INT32 indexID                = 0 ;
+
+      if ( !context->isMBLock( EXCLUSIVE ) )
+      {
+         PD_LOG( PDERROR, "Caller must hold mb exclusive lock[%s]",
+                 context->toString().c_str() ) ;
+         rc = SDB_SYS ;
+         goto error ;
+      }
+
+      for ( indexID = 0 ; indexID < DMS_COLLECTION_MAX_INDEX ; ++indexID )
+      {
+         if ( DMS_INVALID_EXTENT == context->mb()->_indexExtent[indexID] )
+         {
+            break ;
+         }
+         ixmIndexCB indexCB ( context->mb()->_indexExtent[indexID], this,
+                              context ) ;
+         PD_CHECK ( indexCB.isInitialized(), SDB_DMS_INIT_INDEX, error,
+                    PDERROR, "Failed to init index" ) ;
+
+         if ( indexCB.getFlag() != IXM_INDEX_FLAG_NORMAL &&
+              indexCB.getFlag() != IXM_INDEX_FLAG_CREATING )
+         {
+            continue ;
+         }
+
+         if ( IXM_EXTENT_HAS_TYPE( indexCB.getIndexType(),
+                                   IXM_EXTENT_TYPE_TEXT ) )
+         {
+            IDmsExtDataHandler *handler = _pDataSu->getExtDataHandler() ;
+            if ( !handler )
+            {
+               rc = SDB_SYS ;
+               PD_LOG( PDERROR,
+                       "External operation handler of index[%s] is invalid",
+                       indexCB.getName() ) ;
+               goto error ;
+            }
+
+            for ( UINT32 i = 0 ; i < records.size() ; ++i )
+            {
+               BSONObj obj = records[ i ]._obj ;
+               if ( IXM_INDEX_FLAG_CREATING == indexCB.getFlag() &&
+                    records[ i ]._extLID > indexCB.scanExtLID() )
+               {
+                  continue ;
+               }
+               rc = handler->onInsert( _pDataSu->getSuName(),
+                                       context->mb()->_collectionName,
+                                       indexCB.getName(),
+                                       indexCB, obj, cb ) ;
+               PD_RC_CHECK( rc, PDERROR, "Insert on text index failed[ %d ]",
+                            rc ) ;
+            }
+         }
+         else
+         {
+            std::vector< dmsKeyRID > keys ;
+            Ordering order = Ordering::make( indexCB.keyPattern() ) ;
+            BOOLEAN unique = indexCB.unique() ;
+            BOOLEAN dropDups = indexCB.dropDups() ;
+
+            for ( UINT32 i = 0 ; i < records.size() ; ++i )
+            {
+               BSONObjSet keySet ;
+               BSONObjSet::iterator it ;
+
+               if ( IXM_INDEX_FLAG_CREATING == indexCB.getFlag() &&
+                    records[ i ]._extLID > indexCB.scanExtLID() )
+               {
+                  continue ;
+               }
+               rc = indexCB.getKeysFromObject ( records[ i ]._obj, keySet ) ;
+               PD_RC_CHECK ( rc, PDERROR, "Failed to get keys from object %s",
+                             records[ i ]._obj.toString().c_str() ) ;
+               for ( it = keySet.begin() ; it != keySet.end() ; ++it )
+               {
+                  keys.push_back( dmsKeyRID( *it, records[ i ]._rid ) ) ;
+               }
+            }
+
+            std::sort( keys.begin(), keys.end(), _dmsKeyRIDLess( &order ) ) ;
+
+            for ( UINT32 i = 0 ; i < keys.size() ; ++i )
+            {
+               ixmKeyOwned ko ( keys[ i ].first ) ;
+               rc = _indexInsert ( &indexCB, ko, keys[ i ].second, order, cb,
+                                   !unique, dropDups ) ;
+               PD_RC_CHECK ( rc, PDERROR, "Failed to insert index, rc: %d",
+                             rc ) ;
+            }
+         }
+      }
+
+   done :
+      PD_TRACE_EXITRC ( SDB__DMSSTORAGEINDEX_INDEXESINSERTSORTED, rc ) ;
+      return rc ;
+   error :
+      goto done ;
+   }
+
    INT32 _dmsStorageIndex::_indexUpdate( dmsMBContext *context,
                                          ixmIndexCB *indexCB,
                                          BSONObj &originalObj,
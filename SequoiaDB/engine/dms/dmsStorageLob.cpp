@@ -1073,6 +1073,123 @@ namespace engine
       goto done ;
    }
 
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSSTORAGELOB_READV, "_dmsStorageLob::readv" )
+   INT32 _dmsStorageLob::readv( const DMS_LOB_READ_PIECES &pieces,
+                                dmsMBContext *mbContext,
+                                pmdEDUCB *cb )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB__DMSSTORAGELOB_READV ) ;
+      DMS_LOB_PAGEID page = DMS_LOB_INVALID_PAGEID ;
+      BOOLEAN locked = FALSE ;
+      utilCacheContext cContext ;
+      DMS_LOB_READ_REQS reqs ;
+
+      if ( _needDelayOpen )
+      {
+         rc = _delayOpen() ;
+         PD_RC_CHECK( rc, PDERROR, "Delay open failed in readv, rc: %d", rc ) ;
+      }
+
+      if ( !mbContext->isMBLock() )
+      {
+         rc = mbContext->mbLock( SHARED ) ;
+         PD_RC_CHECK( rc, PDERROR, "dms mb context lock failed, rc: %d", rc ) ;
+         locked = TRUE ;
+      }
+
+      if ( !isOpened() )
+      {
+         rc = SDB_SYS ;
+         PD_LOG( PDERROR, "File[%s] is not open in readv", getSuName() ) ;
+         goto error ;
+      }
+
+      try
+      {
+         reqs.reserve( pieces.size() ) ;
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "Occur exception: %s", e.what() ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+
+      for ( UINT32 i = 0 ; i < pieces.size() ; ++i )
+      {
+         const dmsLobRecord &record = pieces[ i ]._record ;
+
+         if ( record._offset + record._dataLen > getLobdPageSize() )
+         {
+            rc = SDB_SYS ;
+            PD_LOG( PDERROR, "Read record[%s] length more than page size[%u]",
+                    record.toString().c_str(), getLobdPageSize() ) ;
+            goto error ;
+         }
+
+         rc = _find( record, mbContext->clLID(), page ) ;
+         if ( SDB_OK != rc )
+         {
+            PD_LOG( PDERROR, "Failed to find page of record[%s], rc:%d",
+                    record.toString().c_str(), rc ) ;
+            goto error ;
+         }
+
+         if ( DMS_LOB_INVALID_PAGEID == page )
+         {
+            rc = SDB_LOB_SEQUENCE_NOT_EXIST ;
+            goto error ;
+         }
+
+         // the cached page may be newer than the file
+         _pCacheUnit->prepareRead( page, record._offset, record._dataLen,
+                                   cb, cContext ) ;
+         if ( cContext.isPageValid() )
+         {
+            rc = cContext.read( pieces[ i ]._pBuf, record._offset,
+                                record._dataLen, cb ) ;
+            if ( rc )
+            {
+               PD_LOG( PDERROR, "Failed to read data from cache, rc:%d",
+                       rc ) ;
+               cContext.release() ;
+               goto error ;
+            }
+            cContext.submit( cb ) ;
+         }
+         else
+         {
+            cContext.release() ;
+            reqs.push_back( dmsLobReadReq( page, record._offset,
+                                           record._dataLen,
+                                           pieces[ i ]._pBuf ) ) ;
+         }
+      }
+
+      if ( !reqs.empty() )
+      {
+         rc = _data.readv( reqs, cb ) ;
+         if ( rc )
+         {
+            PD_LOG( PDERROR, "Failed to read %u pieces from file, rc:%d",
+                    reqs.size(), rc ) ;
+            goto error ;
+         }
+      }
+
+   done:
+      if ( locked )
+      {
+         mbContext->mbUnlock() ;
+         locked = FALSE ;
+      }
+      PD_TRACE_EXITRC( SDB__DMSSTORAGELOB_READV, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB__DMSSTORAGELOB__ALLOCATEPAGE, "_dmsStorageLob::_allocatePage" )
    INT32 _dmsStorageLob::_allocatePage( const dmsLobRecord &record,
                                         dmsMBContext *context,
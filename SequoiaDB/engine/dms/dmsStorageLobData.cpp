@@ -40,6 +40,8 @@
 #include "dmsTrace.hpp"
 #include "pdTrace.hpp"
 
+#include <algorithm>
+
 namespace engine
 {
 
@@ -408,6 +410,10 @@ namespace engine
    {
       INT32 rc = SDB_OK ;
       PD_TRACE_ENTRY( SDB_DMSSTORAGELOBDATA_CLOSE ) ;
+      if ( _directFile.isOpened() )
+      {
+         ossClose( _directFile ) ;
+      }
       if ( _file.isOpened() )
       {
          rc = ossClose( _file ) ;
@@ -728,6 +734,132 @@ namespace engine
       goto done ;
    }
 
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_DMSSTORAGELOBDATA_READV, "_dmsStorageLobData::readv" )
+   INT32 _dmsStorageLobData::readv( DMS_LOB_READ_REQS &reqs, IExecutor *cb )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB_DMSSTORAGELOBDATA_READV ) ;
+      OSSFILE *pFile = &_file ;
+      BOOLEAN isDirect = isDirectIO() ;
+      UINT64 totalLen = 0 ;
+      UINT32 begin = 0 ;
+
+      for ( UINT32 i = 0 ; i < reqs.size() ; ++i )
+      {
+         totalLen += reqs[ i ]._len ;
+      }
+
+      if ( !isDirect && totalLen >= DMS_LOBD_DIRECT_READ_MIN )
+      {
+         OSSFILE *pDirectFile = _getDirectFile() ;
+         if ( pDirectFile )
+         {
+            pFile = pDirectFile ;
+            isDirect = TRUE ;
+         }
+      }
+
+      std::sort( reqs.begin(), reqs.end() ) ;
+
+      while ( begin < reqs.size() )
+      {
+         UINT32 end = begin + 1 ;
+         UINT32 len = reqs[ begin ]._len ;
+
+         while ( end < reqs.size() )
+         {
+            const dmsLobReadReq &last = reqs[ end - 1 ] ;
+            const dmsLobReadReq &cur = reqs[ end ] ;
+
+            if ( getSeek( last._pageID, last._offset ) + last._len !=
+                 getSeek( cur._pageID, cur._offset ) ||
+                 last._pBuf + last._len != cur._pBuf ||
+                 len + cur._len > DMS_LOBD_READ_RUN_MAX )
+            {
+               break ;
+            }
+            len += cur._len ;
+            ++end ;
+         }
+
+         rc = _readRun( pFile, isDirect, reqs[ begin ], len, cb ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         begin = end ;
+      }
+
+   done:
+      PD_TRACE_EXITRC( SDB_DMSSTORAGELOBDATA_READV, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _dmsStorageLobData::_readRun( OSSFILE *pFile, BOOLEAN isDirect,
+                                       const dmsLobReadReq &req, UINT32 len,
+                                       IExecutor *cb )
+   {
+      INT32 rc = SDB_OK ;
+      SINT64 readFromFile = 0 ;
+      INT64 readOffset = 0 ;
+      _dmsLobDirectInBuffer buffer( req._pBuf, len, req._offset,
+                                    isDirect, cb ) ;
+      const _dmsLobDirectBuffer::tuple *t = NULL ;
+
+      rc = buffer.doit( &t ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+
+      readOffset = getSeek( req._pageID, t->offset ) ;
+      if ( readOffset + t->size > _fileSz )
+      {
+         PD_LOG( PDERROR, "Offset[%lld] grater than file size[%lld] in "
+                 "file[%s]", readOffset, _fileSz, _fileName.c_str() ) ;
+         rc = SDB_SYS ;
+         goto error ;
+      }
+
+      rc = ossSeekAndReadN( pFile, readOffset, t->size, t->buf,
+                            readFromFile ) ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG( PDERROR, "Failed to read pages[begin: %d, offset: %u, "
+                 "len: %u], rc: %d", req._pageID, req._offset, len, rc ) ;
+         goto error ;
+      }
+
+      buffer.done() ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   OSSFILE* _dmsStorageLobData::_getDirectFile()
+   {
+      ossScopedLock lock( &_directLatch ) ;
+
+      if ( !_directFile.isOpened() && _file.isOpened() )
+      {
+         INT32 rc = ossOpen( _fullPath, OSS_READONLY | OSS_SHAREREAD |
+                             OSS_DIRECTIO, OSS_RU|OSS_WU|OSS_RG,
+                             _directFile ) ;
+         if ( rc )
+         {
+            // fall back to the buffered io
+            PD_LOG( PDWARNING, "Failed to open file[%s] with direct io, "
+                    "rc: %d", _fullPath, rc ) ;
+            return NULL ;
+         }
+      }
+      return _directFile.isOpened() ? &_directFile : NULL ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB_DMSSTORAGELOBDATA_EXTEND, "_dmsStorageLobData::extend" )
    INT32 _dmsStorageLobData::extend( INT64 len )
    {
@@ -688,14 +688,17 @@ namespace engine
          rc = SDB_SYS ;
          goto error ;
       }
+      // cleared before the sync, as the file may be written meanwhile by
+      // the flush out of the commit sync
+      _dirty = FALSE ;
       rc = ossFsync( _file ) ;
       if ( SDB_OK != rc )
       {
          PD_LOG( PDERROR, "failed to sync file, file no:%d, rc:%d",
                  _fileNum, rc ) ;
+         _dirty = TRUE ;
          goto error ;
       }      
-      _dirty = FALSE ;
 
    done:
       PD_TRACE_EXITRC( SDB__DPSLOGFILE_SYNC, rc ) ;
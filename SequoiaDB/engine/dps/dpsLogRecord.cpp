@@ -605,6 +605,37 @@ namespace engine
                                 *( (INT8*)itrDirect.value() ) ) ;
             break ;
          }
+         case LOG_TYPE_DATA_LOAD:
+         {
+            len += ossSnprintf( outBuf + len, outSize - len,
+                                " Type   : %s(%d)"OSS_NEWLINE,
+                                "LOAD", LOG_TYPE_DATA_LOAD ) ;
+            dpsLogRecord::iterator itrFullName, itrBlock, itrNum ;
+            itrFullName = this->find( DPS_LOG_PUBLIC_FULLNAME ) ;
+            if ( !itrFullName.valid() )
+            {
+               PD_LOG( PDERROR, "failed to find fullname in record" ) ;
+               goto done ;
+            }
+            len += ossSnprintf( outBuf + len, outSize - len,
+                                " CLName : %s"OSS_NEWLINE,
+                                itrFullName.value() ) ;
+
+            itrNum = this->find( DPS_LOG_LOAD_NUM ) ;
+            itrBlock = this->find( DPS_LOG_LOAD_BLOCK ) ;
+            if ( !itrNum.valid() || !itrBlock.valid() )
+            {
+               PD_LOG( PDERROR, "failed to find load block in record" ) ;
+               goto done ;
+            }
+            // the records are too many to dump
+            len += ossSnprintf( outBuf + len, outSize - len,
+                                " Records: %u"OSS_NEWLINE
+                                " Size   : %u"OSS_NEWLINE,
+                                *( (UINT32*)itrNum.value() ),
+                                itrBlock.len() ) ;
+            break ;
+         }
          case LOG_TYPE_CS_CRT:
          {
             len += ossSnprintf ( outBuf + len, outSize - len,
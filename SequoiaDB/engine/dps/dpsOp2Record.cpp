@@ -562,6 +562,90 @@ namespace engine
       goto done ;
    }
 
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__DPS_LOAD2RECORD, "dpsLoad2Record" )
+   INT32 dpsLoad2Record( const CHAR *fullName, const CHAR *pBlock,
+                         const UINT32 &blockSize, const UINT32 &recordNum,
+                         dpsLogRecord &record )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB__DPS_LOAD2RECORD ) ;
+      dpsLogRecordHeader &header = record.head() ;
+      header._type = LOG_TYPE_DATA_LOAD ;
+
+      rc = record.push( DPS_LOG_PUBLIC_FULLNAME,
+                        ossStrlen( fullName ) + 1,
+                        fullName ) ;
+      PD_RC_CHECK( rc, PDERROR,
+                   "Failed to push fullname to record, rc: %d", rc ) ;
+
+      rc = record.push( DPS_LOG_LOAD_BLOCK, blockSize, pBlock ) ;
+      PD_RC_CHECK( rc, PDERROR,
+                   "Failed to push block to record, rc: %d", rc ) ;
+
+      rc = record.push( DPS_LOG_LOAD_NUM, sizeof( recordNum ),
+                        (CHAR *)( &recordNum ) ) ;
+      PD_RC_CHECK( rc, PDERROR,
+                   "Failed to push record number to record, rc: %d", rc ) ;
+
+      header._length = record.alignedLen() ;
+
+   done:
+      PD_TRACE_EXITRC( SDB__DPS_LOAD2RECORD, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__DPS_RECORD2LOAD, "dpsRecord2Load" )
+   INT32 dpsRecord2Load( const CHAR *logRecord, const CHAR **fullName,
+                         const CHAR **pBlock, UINT32 &blockSize,
+                         UINT32 &recordNum )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB__DPS_RECORD2LOAD ) ;
+      dpsLogRecord record ;
+      rc = record.load( logRecord ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to load record, rc: %d", rc ) ;
+
+      {
+         dpsLogRecord::iterator itrName, itrBlock, itrNum ;
+         itrName = record.find( DPS_LOG_PUBLIC_FULLNAME ) ;
+         if ( !itrName.valid() )
+         {
+            PD_LOG( PDERROR, "Failed to find tag fullname in record" ) ;
+            rc = SDB_SYS ;
+            goto error ;
+         }
+
+         itrBlock = record.find( DPS_LOG_LOAD_BLOCK ) ;
+         if ( !itrBlock.valid() )
+         {
+            PD_LOG( PDERROR, "Failed to find tag block in record" ) ;
+            rc = SDB_SYS ;
+            goto error ;
+         }
+
+         itrNum = record.find( DPS_LOG_LOAD_NUM ) ;
+         if ( !itrNum.valid() )
+         {
+            PD_LOG( PDERROR, "Failed to find tag record number in record" ) ;
+            rc = SDB_SYS ;
+            goto error ;
+         }
+
+         *fullName = itrName.value() ;
+         *pBlock = itrBlock.value() ;
+         blockSize = itrBlock.len() ;
+         recordNum = *(UINT32 *)( itrNum.value() ) ;
+      }
+
+   done:
+      PD_TRACE_EXITRC( SDB__DPS_RECORD2LOAD, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB__DPS_CSCRT2RECORD, "dpsCSCrt2Record" )
    INT32 dpsCSCrt2Record( const CHAR *csName,
                           const INT32 &pageSize,
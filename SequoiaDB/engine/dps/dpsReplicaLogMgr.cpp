@@ -78,6 +78,12 @@ namespace engine
 
       _transCB = NULL ;
       _incVersion = FALSE ;
+
+      _commitBeginGen = 0 ;
+      _commitEndGen = 0 ;
+      _syncEndGen = 0 ;
+      _flushing = FALSE ;
+      _syncing = FALSE ;
    }
 
    _dpsReplicaLogMgr::~_dpsReplicaLogMgr()
@@ -151,6 +157,7 @@ namespace engine
          if ( SDB_OK == rc )
          {
             _lastCommitted = _currentLsn ;
+            _lastSynced = _currentLsn ;
             PD_LOG ( PDEVENT, "Dps restore succeed, file lsn[%lld], buff "
                      "lsn[%lld], current lsn[%lld], expect lsn[%lld]",
                      _logger.getStartLSN().offset, _getStartLsn().offset,
@@ -557,6 +564,7 @@ namespace engine
       _lsn.version = version ;
 
       _lastCommitted = DPS_LSN() ;
+      _lastSynced = DPS_LSN() ;
 
    done:
       PD_TRACE_EXITRC ( SDB__DPSRPCMGR__MVPAGES, rc );
@@ -1279,36 +1287,154 @@ namespace engine
    {
       INT32 rc = SDB_OK ;
       PD_TRACE_ENTRY( SDB__DPSRPCMGR_COMMIT ) ;
-      _dpsLogPage *work = NULL ;
+      UINT64 arriveGen = 0 ;
+      UINT64 commitGen = 0 ;
+      UINT64 syncGen = 0 ;
 
-      _writeMutex.get() ;
- 
-      work = WORK_PAGE ;
-      if ( 0 ==_lastCommitted.compare( _currentLsn ) )
       {
-         goto done ;
+         QNIQUE_LOCK lock( _commitMutex ) ;
+
+         /*
+            The log written before arriving is committed by any flush which
+            begins after arriving, and is synced by any sync which begins
+            after such a flush ends
+         */
+         arriveGen = _commitBeginGen ;
+
+         while ( TRUE )
+         {
+            if ( deeply ? ( _syncEndGen > arriveGen ) :
+                          ( _commitEndGen > arriveGen ) )
+            {
+               break ;
+            }
+            else if ( !_flushing && _commitEndGen <= arriveGen )
+            {
+               // be the flush leader of the committers arrived till now, a
+               // deep committer whose log is flushed goes on to the sync
+               _flushing = TRUE ;
+               commitGen = ++_commitBeginGen ;
+               lock.unlock() ;
+
+               rc = _commitFlush() ;
+
+               lock.lock() ;
+               _flushing = FALSE ;
+               if ( SDB_OK == rc )
+               {
+                  _commitEndGen = commitGen ;
+               }
+               _commitCond.notify_all() ;
+               if ( rc )
+               {
+                  goto error ;
+               }
+            }
+            else if ( deeply && _commitEndGen > arriveGen && !_syncing )
+            {
+               // be the sync leader, the next flush goes on meanwhile
+               _syncing = TRUE ;
+               syncGen = _commitEndGen ;
+               lock.unlock() ;
+
+               rc = _commitSync() ;
+
+               lock.lock() ;
+               _syncing = FALSE ;
+               if ( SDB_OK == rc && syncGen > _syncEndGen )
+               {
+                  _syncEndGen = syncGen ;
+               }
+               _commitCond.notify_all() ;
+               if ( rc )
+               {
+                  goto error ;
+               }
+            }
+            else
+            {
+               _commitCond.wait( lock ) ;
+            }
+         }
       }
 
-      while ( !_queSize.compare( 0 ) )
+   done:
+      if ( NULL != committedLsn )
       {
-         ossSleep ( 1 ) ;
+         *committedLsn = commitLsn() ;
       }
+      PD_TRACE_EXITRC( SDB__DPSRPCMGR_COMMIT, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION (SDB__DPSRPCMGR__COMMITFLUSH, "_dpsReplicaLogMgr::_commitFlush" )
+   INT32 _dpsReplicaLogMgr::_commitFlush()
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB__DPSRPCMGR__COMMITFLUSH ) ;
+      _dpsLogPage *work = NULL ;
+      DPS_LSN commitLsn ;
+
+      // the work page is written by the merges under _writeMutex, so it's
+      // held only during the flush, the sync is out of it
+      _writeMutex.get() ;
+
+      work = WORK_PAGE ;
 
-      work->lock() ;
-      work->unlock() ;
+      _mtx.get() ;
+      commitLsn = _currentLsn ;
+      _mtx.release() ;
 
-      if ( 0 != work->getLength() )
+      if ( 0 != _lastCommitted.compare( commitLsn ) )
       {
-         ossMemset( work->mb()->writePtr(), 0, work->getLastSize() ) ;
-         rc = _logger.flush( work->mb(), work->getBeginLSN(), TRUE ) ;
-         if ( SDB_OK != rc )
+         while ( !_queSize.compare( 0 ) )
          {
-            PD_LOG ( PDERROR, "Failed to flush page, rc = %d", rc ) ;
-            goto error ;
+            ossSleep ( 1 ) ;
+         }
+
+         work->lock() ;
+         work->unlock() ;
+
+         if ( 0 != work->getLength() )
+         {
+            ossMemset( work->mb()->writePtr(), 0, work->getLastSize() ) ;
+            rc = _logger.flush( work->mb(), work->getBeginLSN(), TRUE ) ;
+            if ( SDB_OK != rc )
+            {
+               PD_LOG ( PDERROR, "Failed to flush page, rc = %d", rc ) ;
+               goto error ;
+            }
          }
       }
 
-      if ( deeply )
+      _mtx.get() ;
+      _lastCommitted = commitLsn ;
+      _mtx.release() ;
+
+   done:
+      _writeMutex.release() ;
+      PD_TRACE_EXITRC( SDB__DPSRPCMGR__COMMITFLUSH, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION (SDB__DPSRPCMGR__COMMITSYNC, "_dpsReplicaLogMgr::_commitSync" )
+   INT32 _dpsReplicaLogMgr::_commitSync()
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB__DPSRPCMGR__COMMITSYNC ) ;
+      DPS_LSN syncLsn ;
+
+      // the flushes ended before the sync are covered by it, the ones run
+      // during the sync mark the files dirty again
+      _mtx.get() ;
+      syncLsn = _lastCommitted ;
+      _mtx.release() ;
+
+      if ( 0 != _lastSynced.compare( syncLsn ) )
       {
          rc = _logger.sync() ;
          if ( SDB_OK != rc )
@@ -1316,22 +1442,15 @@ namespace engine
             PD_LOG( PDERROR, "Failed to sync log file: %d", rc ) ;
             goto error ;
          }
+         _mtx.get() ;
+         _lastSynced = syncLsn ;
+         _mtx.release() ;
       }
 
-      _mtx.get() ;
-      _lastCommitted = _currentLsn ;
-      _mtx.release() ;
-
    done:
-      if ( NULL != committedLsn )
-      {
-          *committedLsn = _lastCommitted ;
-      }
-      _writeMutex.release() ;
-      PD_TRACE_EXITRC( SDB__DPSRPCMGR_COMMIT, rc ) ;
+      PD_TRACE_EXITRC( SDB__DPSRPCMGR__COMMITSYNC, rc ) ;
       return rc ;
    error:
       goto done ;
    }
 }
-
@@ -763,6 +763,11 @@ namespace engine
       return _TransLock.hasWait( lockId );
    }
 
+   void dpsTransCB::dumpLockStat( BSONObjBuilder &ob )
+   {
+      _TransLock.dumpStat( ob ) ;
+   }
+
    INT32 dpsTransCB::reservedLogSpace( UINT32 length, _pmdEDUCB *cb )
    {
       INT32 rc = SDB_OK;
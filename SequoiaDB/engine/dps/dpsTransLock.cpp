@@ -42,12 +42,35 @@
 #include "pmdEDU.hpp"
 #include "pdTrace.hpp"
 #include "dpsTrace.hpp"
+#include "msgDef.h"
 
 namespace engine
 {
+   #define DPS_LOCKID_HASH_FACTOR         ( 0x9E3779B97F4A7C15ULL )
+
+   static OSS_INLINE UINT32 _dpsHashLockId( const dpsTransLockId &lockId )
+   {
+      UINT64 hash = lockId._logicCSID ;
+      hash = hash * DPS_LOCKID_HASH_FACTOR + lockId._collectionID ;
+      if ( lockId._recordOffset != DMS_INVALID_OFFSET )
+      {
+         hash = hash * DPS_LOCKID_HASH_FACTOR +
+                (UINT32)lockId._recordExtentID ;
+         hash = hash * DPS_LOCKID_HASH_FACTOR + (UINT32)lockId._recordOffset ;
+      }
+      return (UINT32)( hash ^ ( hash >> 29 ) ^ ( hash >> 47 ) ) ;
+   }
+
+   static OSS_INLINE BOOLEAN _dpsIsStrongLock( DPS_TRANSLOCK_TYPE lockType )
+   {
+      return DPS_TRANSLOCK_S == lockType || DPS_TRANSLOCK_X == lockType ;
+   }
+
    dpsTransLock::dpsTransLock()
    :_bucketLst(MAX_LOCKBUCKET_NUM, (dpsLockBucket*)NULL)
    {
+      ossMemset( _padHead, 0, sizeof( _padHead ) ) ;
+      ossMemset( (void*)_intentSlots, 0, sizeof( _intentSlots ) ) ;
    }
 
    dpsTransLock::~dpsTransLock()
@@ -73,6 +96,7 @@ namespace engine
       dpsTransLockId iLockId;
       dpsTransCBLockInfo *pLockInfo = NULL;
       BOOLEAN isIXLocked = FALSE;
+      BOOLEAN isStrong = FALSE;
 
       if ( lockId._collectionID != DMS_INVALID_MBID )
       {
@@ -102,6 +126,10 @@ namespace engine
          goto done;
       }
 
+      rc = enterStrong( eduCB, lockId, pLockInfo, TRUE, isStrong );
+      PD_RC_CHECK( rc, PDERROR, "Failed to wait for the intent-locks, "
+                   "get X-lock failed(rc=%d)", rc );
+
       if ( pLockInfo )
       {
          rc = upgrade( eduCB, lockId, pLockInfo, DPS_TRANSLOCK_X );
@@ -118,7 +146,9 @@ namespace engine
          {
          DPS_TRANS_WAIT_LOCK _transWaitLock( eduCB, lockId ) ;
          eduCB->addLockInfo( lockId, DPS_TRANSLOCK_X );
-         rc = pLockBucket->acquire( eduCB, lockId, DPS_TRANSLOCK_X );
+         rc = pLockBucket->acquire( eduCB, lockId, DPS_TRANSLOCK_X,
+                                    isIntentLockId( lockId ) ?
+                                    getIntentSlot( lockId ) : NULL );
          }
          if ( rc )
          {
@@ -133,6 +163,10 @@ namespace engine
       PD_TRACE_EXIT ( SDB_DPSTRANSLOCK_ACQUIREX );
       return rc;
    error:
+      if ( isStrong )
+      {
+         leaveStrong( lockId );
+      }
       if ( isIXLocked )
       {
          release( eduCB, iLockId );
@@ -151,6 +185,7 @@ namespace engine
       dpsTransLockId iLockId;
       dpsTransCBLockInfo *pLockInfo = NULL;
       BOOLEAN isISLocked = FALSE;
+      BOOLEAN isStrong = FALSE;
 
       if ( lockId._collectionID != DMS_INVALID_MBID )
       {
@@ -178,6 +213,10 @@ namespace engine
          goto done;
       }
 
+      rc = enterStrong( eduCB, lockId, pLockInfo, TRUE, isStrong );
+      PD_RC_CHECK( rc, PDERROR, "Failed to wait for the intent-locks, "
+                   "get S-lock failed(rc=%d)", rc );
+
       if ( pLockInfo )
       {
          rc = upgrade( eduCB, lockId, pLockInfo, DPS_TRANSLOCK_S );
@@ -194,7 +233,9 @@ namespace engine
          {
          DPS_TRANS_WAIT_LOCK _transWaitLock( eduCB, lockId ) ;
          eduCB->addLockInfo( lockId, DPS_TRANSLOCK_S);
-         rc = pLockBucket->acquire( eduCB, lockId, DPS_TRANSLOCK_S );
+         rc = pLockBucket->acquire( eduCB, lockId, DPS_TRANSLOCK_S,
+                                    isIntentLockId( lockId ) ?
+                                    getIntentSlot( lockId ) : NULL );
          }
          if ( rc )
          {
@@ -209,6 +250,10 @@ namespace engine
       PD_TRACE_EXIT ( SDB_DPSTRANSLOCK_ACQUIRES );
       return rc;
    error:
+      if ( isStrong )
+      {
+         leaveStrong( lockId );
+      }
       if ( isISLocked )
       {
          release( eduCB, iLockId );
@@ -258,6 +303,15 @@ namespace engine
       }
       else
       {
+         BOOLEAN granted = FALSE ;
+         rc = tryFastIntent( eduCB, lockId, DPS_TRANSLOCK_IX, granted );
+         PD_RC_CHECK( rc, PDERROR, "Failed to get the IX-lock by fast path"
+                      "(rc=%d)", rc );
+         if ( granted )
+         {
+            goto done;
+         }
+
          rc = getBucket( lockId, pLockBucket );
          PD_RC_CHECK( rc, PDERROR, "Failed to get the lock-bucket, "
                       "get IX-lock failed(rc=%d)", rc );
@@ -302,6 +356,7 @@ namespace engine
       dpsTransLockId sLockId;
       dpsTransCBLockInfo *pLockInfo = NULL;
       BOOLEAN isISLocked = FALSE;
+      BOOLEAN granted = FALSE;
 
       if ( lockId._collectionID != DMS_INVALID_MBID )
       {
@@ -319,6 +374,14 @@ namespace engine
          goto done;
       }
 
+      rc = tryFastIntent( eduCB, lockId, DPS_TRANSLOCK_IS, granted );
+      PD_RC_CHECK( rc, PDERROR, "Failed to get the IS-lock by fast path"
+                   "(rc=%d)", rc );
+      if ( granted )
+      {
+         goto done;
+      }
+
       rc = getBucket( lockId, pLockBucket );
       PD_RC_CHECK( rc, PDERROR, "Failed to get the lock-bucket, "
                    "get IS-lock failed(rc=%d)", rc );
@@ -354,7 +417,6 @@ namespace engine
       PD_TRACE_ENTRY( SDB_DPSTRANSLOCK_RELEASE ) ;
       SDB_ASSERT( eduCB, "eduCB can't be null" ) ;
       INT32 rc = SDB_OK;
-      dpsLockBucket *pLockBucket = NULL;
       dpsTransLockId iLockId;
       dpsTransCBLockInfo *pLockInfo = NULL;
       INT64 lockRef = 0;
@@ -366,16 +428,7 @@ namespace engine
       lockRef = pLockInfo->decRef();
       if ( lockRef <= 0 )
       {
-         rc = getBucket( lockId, pLockBucket );
-         if ( rc )
-         {
-            PD_LOG( PDWARNING, "Failed to get lock-bucket while release "
-                    "lock(rc=%d)", rc );
-         }
-         else
-         {
-            pLockBucket->release( eduCB, lockId );
-         }
+         releaseLock( eduCB, lockId, pLockInfo );
 
          eduCB->delLockInfo( lockId );
          pLockInfo = NULL;
@@ -407,22 +460,11 @@ namespace engine
    {
       PD_TRACE_ENTRY( SDB_DPSTRANSLOCK_RELEASEALL ) ;
       SDB_ASSERT( eduCB, "eduCB can't be null" ) ;
-      INT32 rc = SDB_OK;
-      dpsLockBucket *pLockBucket = NULL;
       DpsTransCBLockList *pLockLst = eduCB->getLockList();
       DpsTransCBLockList::iterator iterLst = pLockLst->begin();
       while ( iterLst != pLockLst->end() )
       {
-         rc = getBucket( iterLst->first, pLockBucket );
-         if ( rc )
-         {
-            PD_LOG( PDWARNING, "Failed to get lock-bucket while release "
-                    "lock(rc=%d)", rc );
-         }
-         else
-         {
-            pLockBucket->release( eduCB, iterLst->first );
-         }
+         releaseLock( eduCB, iterLst->first, iterLst->second );
          iterLst++ ;
       }
       eduCB->clearLockList() ;
@@ -430,6 +472,43 @@ namespace engine
       return ;
    }
 
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_DPSTRANSLOCK_RELEASELOCK, "dpsTransLock::releaseLock" )
+   void dpsTransLock::releaseLock( _pmdEDUCB *eduCB,
+                                   const dpsTransLockId &lockId,
+                                   dpsTransCBLockInfo *pLockInfo )
+   {
+      PD_TRACE_ENTRY( SDB_DPSTRANSLOCK_RELEASELOCK ) ;
+      INT32 rc = SDB_OK;
+      dpsLockBucket *pLockBucket = NULL;
+
+      if ( pLockInfo->isFast() )
+      {
+         releaseFastIntent( lockId );
+         goto done;
+      }
+
+      rc = getBucket( lockId, pLockBucket );
+      if ( rc )
+      {
+         PD_LOG( PDWARNING, "Failed to get lock-bucket while release "
+                 "lock(rc=%d)", rc );
+      }
+      else
+      {
+         pLockBucket->release( eduCB, lockId );
+      }
+
+      if ( isIntentLockId( lockId ) &&
+           _dpsIsStrongLock( pLockInfo->getType() ) )
+      {
+         leaveStrong( lockId );
+      }
+
+   done:
+      PD_TRACE_EXIT ( SDB_DPSTRANSLOCK_RELEASELOCK );
+      return ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB_DPSTRANSLOCK_UPGRADE, "dpsTransLock::upgrade" )
    INT32 dpsTransLock::upgrade( _pmdEDUCB *eduCB,
                                 const dpsTransLockId &lockId,
@@ -445,13 +524,26 @@ namespace engine
       rc = upgradeCheck( pLockInfo->getType(), lockType );
       PD_RC_CHECK( rc, PDERROR, "Upgrade lock failed(rc=%d)", rc );
 
+      if ( pLockInfo->isFast() )
+      {
+         // IS to IX, the strong locks are kept away by the fast holder
+         // number, so it's done in place
+         SDB_ASSERT( !_dpsIsStrongLock( lockType ),
+                     "Fast intent-lock can't be upgraded to S/X" ) ;
+         pLockInfo->setType( lockType );
+         goto done;
+      }
+
       rc = getBucket( lockId, pLockBucket );
       PD_RC_CHECK( rc, PDERROR, "Failed to get lock-bucket, upgrade lock "
                    "failed(rc=%d)", rc );
 
       lastLockType = pLockInfo->getType();
       pLockInfo->setType( lockType );
-      rc = pLockBucket->upgrade( eduCB, lockId, lockType );
+      rc = pLockBucket->upgrade( eduCB, lockId, lockType,
+                                 ( isIntentLockId( lockId ) &&
+                                   _dpsIsStrongLock( lockType ) ) ?
+                                 getIntentSlot( lockId ) : NULL );
       PD_CHECK( SDB_OK == rc, rc, rollbackType, PDERROR,
                 "upgrade lock failed(rc=%d)", rc );
 
@@ -481,15 +573,7 @@ namespace engine
 
    UINT32 dpsTransLock::getBucketNo( const dpsTransLockId &lockId )
    {
-      if ( lockId._recordOffset != DMS_INVALID_OFFSET )
-      {
-         return lockId._recordOffset % MAX_LOCKBUCKET_NUM ;
-      }
-      else if ( lockId._collectionID != DMS_INVALID_MBID )
-      {
-         return lockId._collectionID % MAX_LOCKBUCKET_NUM;
-      }
-      return lockId._logicCSID % MAX_LOCKBUCKET_NUM;
+      return _dpsHashLockId( lockId ) % MAX_LOCKBUCKET_NUM ;
    }
 
    // PD_TRACE_DECLARE_FUNCTION ( SDB_DPSTRANSLOCK_GETBUCKET, "dpsTransLock::getBucket" )
@@ -518,6 +602,264 @@ namespace engine
       goto done;
    }
 
+   BOOLEAN dpsTransLock::isIntentLockId( const dpsTransLockId &lockId )
+   {
+      return DMS_INVALID_OFFSET == lockId._recordOffset ;
+   }
+
+   dpsIntentSlot *dpsTransLock::getIntentSlot( const dpsTransLockId &lockId )
+   {
+      return &_intentSlots[ _dpsHashLockId( lockId ) % DPS_INTENT_SLOT_NUM ] ;
+   }
+
+   UINT32 dpsTransLock::fastHolderNum( dpsIntentSlot *pSlot,
+                                       const dpsTransLockId &lockId )
+   {
+      return pSlot->holderNum( lockId ) ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_DPSTRANSLOCK_TRYFASTINTENT, "dpsTransLock::tryFastIntent" )
+   INT32 dpsTransLock::tryFastIntent( _pmdEDUCB *eduCB,
+                                      const dpsTransLockId &lockId,
+                                      DPS_TRANSLOCK_TYPE lockType,
+                                      BOOLEAN &granted )
+   {
+      PD_TRACE_ENTRY( SDB_DPSTRANSLOCK_TRYFASTINTENT ) ;
+      INT32 rc = SDB_OK;
+      dpsIntentSlot *pSlot = getIntentSlot( lockId );
+      SINT64 tag = dpsIntentSlot::tagOf( lockId );
+      SINT64 value = 0;
+      SINT64 newValue = 0;
+      SINT64 holderNum = 0;
+      dpsTransCBLockInfo *pLockInfo = NULL;
+
+      granted = FALSE;
+
+      while ( TRUE )
+      {
+         if ( pSlot->_strongNum > 0 )
+         {
+            goto done;
+         }
+         value = ossAtomicPeek64( &pSlot->_value );
+         holderNum = value & DPS_INTENT_HOLDER_MASK;
+         if ( 0 == holderNum )
+         {
+            // the slot is free, take it for the lock-id
+            newValue = tag + 1;
+         }
+         else if ( ( value & ~DPS_INTENT_HOLDER_MASK ) != tag ||
+                   DPS_INTENT_HOLDER_MASK == holderNum )
+         {
+            // served for another lock-id, or too many holders
+            goto done;
+         }
+         else
+         {
+            newValue = value + 1;
+         }
+         if ( ossCompareAndSwap64( &pSlot->_value, value, newValue ) )
+         {
+            break;
+         }
+      }
+
+      // strong lockers increase _strongNum before checking the holders,
+      // so check it again after we are counted in
+      if ( pSlot->_strongNum > 0 )
+      {
+         releaseFastIntent( lockId );
+         goto done;
+      }
+
+      eduCB->addLockInfo( lockId, lockType );
+      pLockInfo = eduCB->getTransLock( lockId );
+      if ( NULL == pLockInfo )
+      {
+         releaseFastIntent( lockId );
+         rc = SDB_OOM;
+         goto error;
+      }
+      pLockInfo->setFast( TRUE );
+      granted = TRUE;
+
+      PD_LOG( PDDEBUG, "Get the intent-lock(%s) by fast path",
+              lockId.toString().c_str() );
+
+   done:
+      PD_TRACE_EXIT ( SDB_DPSTRANSLOCK_TRYFASTINTENT );
+      return rc;
+   error:
+      goto done;
+   }
+
+   void dpsTransLock::releaseFastIntent( const dpsTransLockId &lockId )
+   {
+      dpsIntentSlot *pSlot = getIntentSlot( lockId );
+      dpsLockBucket *pLockBucket = NULL;
+      SINT64 value = 0;
+      SDB_ASSERT( fastHolderNum( pSlot, lockId ) > 0,
+                  "No fast holder of the intent-lock" ) ;
+      value = ossFetchAndAdd64( &pSlot->_value, -1 );
+
+      // the S/X lockers wait in the lock-bucket for the fast holders to
+      // drain, the last holder wakes them up
+      if ( 1 == ( value & DPS_INTENT_HOLDER_MASK ) &&
+           pSlot->_strongNum > 0 &&
+           SDB_OK == getBucket( lockId, pLockBucket ) )
+      {
+         pLockBucket->wakeUpWait( lockId );
+      }
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_DPSTRANSLOCK_ENTERSTRONG, "dpsTransLock::enterStrong" )
+   INT32 dpsTransLock::enterStrong( _pmdEDUCB *eduCB,
+                                    const dpsTransLockId &lockId,
+                                    dpsTransCBLockInfo *pLockInfo,
+                                    BOOLEAN canWait,
+                                    BOOLEAN &entered )
+   {
+      PD_TRACE_ENTRY( SDB_DPSTRANSLOCK_ENTERSTRONG ) ;
+      INT32 rc = SDB_OK;
+      dpsIntentSlot *pSlot = NULL;
+      dpsLockBucket *pLockBucket = NULL;
+
+      entered = FALSE;
+
+      // S/X on records don't conflict with the fast path, and the S/X held
+      // on the lock-id is counted already
+      if ( !isIntentLockId( lockId ) ||
+           ( pLockInfo && !pLockInfo->isFast() &&
+             _dpsIsStrongLock( pLockInfo->getType() ) ) )
+      {
+         goto done;
+      }
+
+      pSlot = getIntentSlot( lockId );
+      ossFetchAndAdd32( &pSlot->_strongNum, 1 );
+      entered = TRUE;
+
+      // move our own fast intent-lock into the lock-bucket, then it's
+      // upgraded there
+      if ( pLockInfo && pLockInfo->isFast() )
+      {
+         rc = getBucket( lockId, pLockBucket );
+         PD_RC_CHECK( rc, PDERROR, "Failed to get the lock-bucket(rc=%d)",
+                      rc );
+         rc = pLockBucket->tryAcquire( eduCB, lockId, pLockInfo->getType() );
+         PD_RC_CHECK( rc, PDERROR, "Failed to move the intent-lock(%s) to "
+                      "lock-bucket(rc=%d)", lockId.toString().c_str(), rc );
+         pLockInfo->setFast( FALSE );
+         releaseFastIntent( lockId );
+      }
+
+      // the waiting lockers are queued in the lock-bucket until the fast
+      // holders drain, see dpsLockBucket::acquire
+      if ( !canWait && fastHolderNum( pSlot, lockId ) > 0 )
+      {
+         rc = SDB_DPS_TRANS_LOCK_INCOMPATIBLE;
+         goto error;
+      }
+
+   done:
+      PD_TRACE_EXIT ( SDB_DPSTRANSLOCK_ENTERSTRONG );
+      return rc;
+   error:
+      if ( entered )
+      {
+         leaveStrong( lockId );
+         entered = FALSE;
+      }
+      goto done;
+   }
+
+   void dpsTransLock::leaveStrong( const dpsTransLockId &lockId )
+   {
+      dpsIntentSlot *pSlot = getIntentSlot( lockId );
+      SDB_ASSERT( pSlot->_strongNum > 0, "No strong lock in the slot" ) ;
+      ossFetchAndAdd32( &pSlot->_strongNum, -1 );
+   }
+
+   INT32 dpsTransLock::testStrong( _pmdEDUCB *eduCB,
+                                   const dpsTransLockId &lockId,
+                                   dpsTransCBLockInfo *pLockInfo )
+   {
+      UINT32 holderNum = 0;
+      if ( !isIntentLockId( lockId ) )
+      {
+         return SDB_OK;
+      }
+      holderNum = fastHolderNum( getIntentSlot( lockId ), lockId );
+      if ( pLockInfo && pLockInfo->isFast() && holderNum > 0 )
+      {
+         --holderNum;
+      }
+      return holderNum > 0 ? SDB_DPS_TRANS_LOCK_INCOMPATIBLE : SDB_OK;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_DPSTRANSLOCK_DUMPSTAT, "dpsTransLock::dumpStat" )
+   void dpsTransLock::dumpStat( bson::BSONObjBuilder &ob )
+   {
+      PD_TRACE_ENTRY( SDB_DPSTRANSLOCK_DUMPSTAT ) ;
+      UINT32 fastNum = 0;
+      dpsLockBucketStat total;
+      dpsLockBucketStat stat;
+      UINT32 i = 0;
+
+      for ( i = 0; i < DPS_INTENT_SLOT_NUM; ++i )
+      {
+         fastNum += (UINT32)( ossAtomicPeek64( &_intentSlots[i]._value ) &
+                              DPS_INTENT_HOLDER_MASK );
+      }
+      for ( i = 0; i < MAX_LOCKBUCKET_NUM; ++i )
+      {
+         if ( NULL == _bucketLst[i] )
+         {
+            continue;
+         }
+         _bucketLst[i]->getStat( stat );
+         total._holdNum += stat._holdNum;
+         total._waitNum += stat._waitNum;
+         total._acquireNum += stat._acquireNum;
+         total._waitTimes += stat._waitTimes;
+      }
+
+      ob.append( FIELD_NAME_FAST_INTENT_LOCKS, (INT32)fastNum );
+      ob.append( FIELD_NAME_LOCK_HOLD_NUM, (INT32)total._holdNum );
+      ob.append( FIELD_NAME_LOCK_WAIT_NUM, (INT32)total._waitNum );
+      ob.append( FIELD_NAME_LOCK_ACQUIRE_NUM, (INT64)total._acquireNum );
+      ob.append( FIELD_NAME_LOCK_WAIT_TIMES, (INT64)total._waitTimes );
+
+      // only the buckets being waited, the hot ones
+      {
+         bson::BSONArrayBuilder arr(
+            ob.subarrayStart( FIELD_NAME_LOCK_WAIT_BUCKETS ) );
+         for ( i = 0; i < MAX_LOCKBUCKET_NUM; ++i )
+         {
+            if ( NULL == _bucketLst[i] )
+            {
+               continue;
+            }
+            _bucketLst[i]->getStat( stat );
+            if ( 0 == stat._waitNum )
+            {
+               continue;
+            }
+            arr.append( BSON( FIELD_NAME_LOCK_BUCKET_NO << (INT32)i <<
+                              FIELD_NAME_LOCK_HOLD_NUM <<
+                              (INT32)stat._holdNum <<
+                              FIELD_NAME_LOCK_WAIT_NUM <<
+                              (INT32)stat._waitNum <<
+                              FIELD_NAME_LOCK_ACQUIRE_NUM <<
+                              (INT64)stat._acquireNum <<
+                              FIELD_NAME_LOCK_WAIT_TIMES <<
+                              (INT64)stat._waitTimes ) );
+         }
+         arr.done();
+      }
+      PD_TRACE_EXIT ( SDB_DPSTRANSLOCK_DUMPSTAT );
+   }
+
    //PD_TRACE_DECLARE_FUNCTION ( SDB_DPSTRANSLOCK_TESTS, "dpsTransLock::testS" )
    INT32 dpsTransLock::testS( _pmdEDUCB *eduCB, const dpsTransLockId &lockId )
    {
@@ -552,6 +894,10 @@ namespace engine
                      "test S-lock failed(rc=%d)", rc );
       }
 
+      rc = testStrong( eduCB, lockId, pLockInfo );
+      PD_RC_CHECK( rc, PDINFO, "Intent-locks are held by others, "
+                   "test S-lock failed(rc=%d)", rc );
+
       if ( pLockInfo )
       {
          rc = testUpgrade( eduCB, lockId, pLockInfo, DPS_TRANSLOCK_S );
@@ -675,6 +1021,10 @@ namespace engine
                       "test IX-lock failed(rc=%d)", rc );
       }
 
+      rc = testStrong( eduCB, lockId, pLockInfo );
+      PD_RC_CHECK( rc, PDINFO, "Intent-locks are held by others, "
+                   "test X-lock failed(rc=%d)", rc );
+
       if ( pLockInfo )
       {
          rc = testUpgrade( eduCB, lockId, pLockInfo, DPS_TRANSLOCK_X );
@@ -753,6 +1103,7 @@ namespace engine
       dpsTransLockId iLockId;
       dpsTransCBLockInfo *pLockInfo = NULL;
       BOOLEAN isIXLocked = FALSE;
+      BOOLEAN isStrong = FALSE;
 
       if ( lockId._collectionID != DMS_INVALID_MBID )
       {
@@ -780,6 +1131,10 @@ namespace engine
          goto done;
       }
 
+      rc = enterStrong( eduCB, lockId, pLockInfo, FALSE, isStrong );
+      PD_RC_CHECK( rc, PDINFO, "Intent-locks are held by others, "
+                   "get X-lock failed(rc=%d)", rc );
+
       if ( pLockInfo )
       {
          rc = tryUpgrade( eduCB, lockId, pLockInfo, DPS_TRANSLOCK_X );
@@ -808,6 +1163,10 @@ namespace engine
       PD_TRACE_EXIT ( SDB_DPSTRANSLOCK_TRYX );
       return rc;
    error:
+      if ( isStrong )
+      {
+         leaveStrong( lockId );
+      }
       if ( isIXLocked )
       {
          release( eduCB, iLockId );
@@ -825,6 +1184,7 @@ namespace engine
       dpsTransLockId iLockId;
       dpsTransCBLockInfo *pLockInfo = NULL;
       BOOLEAN isISLocked = FALSE;
+      BOOLEAN isStrong = FALSE;
 
       if ( lockId._collectionID != DMS_INVALID_MBID )
       {
@@ -852,6 +1212,10 @@ namespace engine
          goto done;
       }
 
+      rc = enterStrong( eduCB, lockId, pLockInfo, FALSE, isStrong );
+      PD_RC_CHECK( rc, PDINFO, "Intent-locks are held by others, "
+                   "get S-lock failed(rc=%d)", rc );
+
       if ( pLockInfo )
       {
          rc = tryUpgrade( eduCB, lockId, pLockInfo, DPS_TRANSLOCK_S );
@@ -880,6 +1244,10 @@ namespace engine
       PD_TRACE_EXIT ( SDB_DPSTRANSLOCK_TRYS );
       return rc;
    error:
+      if ( isStrong )
+      {
+         leaveStrong( lockId );
+      }
       if ( isISLocked )
       {
          release( eduCB, iLockId );
@@ -927,6 +1295,15 @@ namespace engine
       }
       else
       {
+         BOOLEAN granted = FALSE ;
+         rc = tryFastIntent( eduCB, lockId, DPS_TRANSLOCK_IX, granted );
+         PD_RC_CHECK( rc, PDERROR, "Failed to get the IX-lock by fast path"
+                      "(rc=%d)", rc );
+         if ( granted )
+         {
+            goto done;
+         }
+
          rc = getBucket( lockId, pLockBucket );
          PD_RC_CHECK( rc, PDERROR, "Failed to get the lock-bucket, "
                       "get IX-lock failed(rc=%d)", rc );
@@ -964,6 +1341,7 @@ namespace engine
       dpsTransLockId sLockId;
       dpsTransCBLockInfo *pLockInfo = NULL;
       BOOLEAN isISLocked = FALSE;
+      BOOLEAN granted = FALSE;
 
       if ( lockId._collectionID != DMS_INVALID_MBID )
       {
@@ -981,6 +1359,14 @@ namespace engine
          goto done;
       }
 
+      rc = tryFastIntent( eduCB, lockId, DPS_TRANSLOCK_IS, granted );
+      PD_RC_CHECK( rc, PDERROR, "Failed to get the IS-lock by fast path"
+                   "(rc=%d)", rc );
+      if ( granted )
+      {
+         goto done;
+      }
+
       rc = getBucket( lockId, pLockBucket );
       PD_RC_CHECK( rc, PDERROR, "Failed to get the lock-bucket, "
                    "get IS-lock failed(rc=%d)", rc );
@@ -1019,6 +1405,14 @@ namespace engine
       rc = upgradeCheck( pLockInfo->getType(), lockType );
       PD_RC_CHECK( rc, PDERROR, "Upgrade lock failed(rc=%d)", rc );
 
+      if ( pLockInfo->isFast() )
+      {
+         SDB_ASSERT( !_dpsIsStrongLock( lockType ),
+                     "Fast intent-lock can't be upgraded to S/X" ) ;
+         pLockInfo->setType( lockType );
+         goto done;
+      }
+
       rc = getBucket( lockId, pLockBucket );
       PD_RC_CHECK( rc, PDERROR, "Failed to get lock-bucket, upgrade lock "
                    "failed(rc=%d)", rc );
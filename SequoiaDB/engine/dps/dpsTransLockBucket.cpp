@@ -35,6 +35,7 @@
 *******************************************************************************/
 
 #include "dpsTransLockBucket.hpp"
+#include "dpsTransLock.hpp"
 #include "dpsTransLockUnit.hpp"
 #include "dpsTransLockDef.hpp"
 #include "pmdDef.hpp"
@@ -69,7 +70,8 @@ namespace engine
    // PD_TRACE_DECLARE_FUNCTION ( SDB_DPSLOCKBUCKET_ACQUIRE, "dpsLockBucket::acquire" )
    INT32 dpsLockBucket::acquire( _pmdEDUCB *eduCB,
                                  const dpsTransLockId &lockId,
-                                 DPS_TRANSLOCK_TYPE lockType )
+                                 DPS_TRANSLOCK_TYPE lockType,
+                                 dpsIntentSlot *pSlot )
    {
       PD_TRACE_ENTRY( SDB_DPSLOCKBUCKET_ACQUIRE ) ;
       INT32 rc = SDB_OK;
@@ -94,7 +96,7 @@ namespace engine
             pLockUnit = iterLst->second ;
          }
 
-         rc = appendToRun( eduCB, lockType, pLockUnit );
+         rc = appendToRun( eduCB, lockId, lockType, pLockUnit, pSlot );
          if ( rc )
          {
             appendToWait( eduCB, lockId, pLockUnit );
@@ -120,7 +122,7 @@ namespace engine
             goto error ;
          }
 
-         rc = appendToRun( eduCB, lockType, pLockUnit );
+         rc = appendToRun( eduCB, lockId, lockType, pLockUnit, pSlot );
          if ( rc )
          {
             goto waitretry;
@@ -184,7 +186,8 @@ namespace engine
    // PD_TRACE_DECLARE_FUNCTION ( SDB_DPSLOCKBUCKET_UPGRADE, "dpsLockBucket::upgrade" )
    INT32 dpsLockBucket::upgrade( _pmdEDUCB *eduCB,
                                  const dpsTransLockId &lockId,
-                                 DPS_TRANSLOCK_TYPE lockType )
+                                 DPS_TRANSLOCK_TYPE lockType,
+                                 dpsIntentSlot *pSlot )
    {
       PD_TRACE_ENTRY( SDB_DPSLOCKBUCKET_UPGRADE ) ;
       SDB_ASSERT( eduCB, "eduCB can't be null" ) ;
@@ -210,7 +213,7 @@ namespace engine
             pLockUnit = iterLst->second ;
          }
 
-         rc = appendToRun( eduCB, lockType, pLockUnit );
+         rc = appendToRun( eduCB, lockId, lockType, pLockUnit, pSlot );
          if ( rc )
          {
             appendHeadToWait( eduCB, lockId, pLockUnit );
@@ -235,7 +238,7 @@ namespace engine
             goto error ;
          }
 
-         rc = appendToRun( eduCB, lockType, pLockUnit );
+         rc = appendToRun( eduCB, lockId, lockType, pLockUnit, pSlot );
          if ( rc )
          {
             goto waitretry;
@@ -290,13 +293,24 @@ namespace engine
       SDB_ASSERT( eduCB, "eduCB can't be null" ) ;
       SDB_ASSERT( pLockUnit, "pLockUnit can't be null" ) ;
       INT32 rc = SDB_OK;
+      dpsTransLockRunList::iterator iterRun ;
       if ( !checkCompatible( eduCB, lockType, pLockUnit) )
       {
          rc = SDB_DPS_TRANS_LOCK_INCOMPATIBLE;
          goto error;
       }
 
-      pLockUnit->_runList[eduCB->getTID()] = lockType;
+      iterRun = pLockUnit->_runList.find( eduCB->getTID() ) ;
+      if ( pLockUnit->_runList.end() == iterRun )
+      {
+         pLockUnit->_runList[eduCB->getTID()] = lockType;
+         ++_stat._holdNum ;
+      }
+      else
+      {
+         iterRun->second = lockType ;
+      }
+      ++_stat._acquireNum ;
    done:
       PD_TRACE_EXIT ( SDB_DPSLOCKBUCKET_APPENDTORUN );
       return rc ;
@@ -304,6 +318,21 @@ namespace engine
       goto done ;
    }
 
+   INT32 dpsLockBucket::appendToRun( _pmdEDUCB *eduCB,
+                                     const dpsTransLockId &lockId,
+                                     DPS_TRANSLOCK_TYPE lockType,
+                                     dpsTransLockUnit *pLockUnit,
+                                     dpsIntentSlot *pSlot )
+   {
+      // the fast holders are released without the latch, the last of them
+      // takes the latch to wake up the waiter, so the waiter can't miss it
+      if ( pSlot && pSlot->holderNum( lockId ) > 0 )
+      {
+         return SDB_DPS_TRANS_LOCK_INCOMPATIBLE ;
+      }
+      return appendToRun( eduCB, lockType, pLockUnit ) ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB_DPSLOCKBUCKET_APPENDTOWAIT, "dpsLockBucket::appendToWait" )
    void dpsLockBucket::appendToWait( _pmdEDUCB *eduCB,
                                      const dpsTransLockId &lockId,
@@ -314,6 +343,8 @@ namespace engine
       SDB_ASSERT( pLockUnit, "pLockUnit can't be null" ) ;
       dpsTransCBLockInfo *pLockInfo = NULL ;
       _pmdEDUCB *pWaitCB = pLockUnit->_pWaitCB;
+      ++_stat._waitNum ;
+      ++_stat._waitTimes ;
       if ( NULL == pWaitCB )
       {
          pLockUnit->_pWaitCB = eduCB ;
@@ -346,6 +377,8 @@ namespace engine
 
       _pmdEDUCB *pWaitCB = pLockUnit->_pWaitCB;
       pLockUnit->_pWaitCB = eduCB;
+      ++_stat._waitNum ;
+      ++_stat._waitTimes ;
       if ( pWaitCB != NULL )
       {
          pLockInfo = eduCB->getTransLock( lockId );
@@ -363,8 +396,10 @@ namespace engine
       SDB_ASSERT( eduCB, "eduCB can't be null" ) ;
       SDB_ASSERT( pLockUnit, "pLockUnit can't be null" ) ;
 
-      dpsTransLockRunList::iterator iterLst;
-      pLockUnit->_runList.erase( eduCB->getTID() );
+      if ( pLockUnit->_runList.erase( eduCB->getTID() ) > 0 )
+      {
+         --_stat._holdNum ;
+      }
 
       if ( pLockUnit->_pWaitCB != NULL )
       {
@@ -388,6 +423,7 @@ namespace engine
 
       if ( pWaitCB->getTID() == id )
       {
+         --_stat._waitNum ;
          pLockInfo = pWaitCB->getTransLock( lockId );
          if ( pLockInfo && pLockInfo->getNextWaitCB() )
          {
@@ -407,6 +443,7 @@ namespace engine
          pWaitCB = pLockInfo->getNextWaitCB();
          if ( pWaitCB && pWaitCB->getTID() == id )
          {
+            --_stat._waitNum ;
             dpsTransCBLockInfo *pLockInfoTmp
                         = pWaitCB->getTransLock( lockId );
             if ( pLockInfoTmp )
@@ -660,4 +697,22 @@ namespace engine
       PD_TRACE_EXIT ( SDB_DPSLOCKBUCKET_HASWAIT );
       return result;
    }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_DPSLOCKBUCKET_WAKEUPWAIT, "dpsLockBucket::wakeUpWait" )
+   void dpsLockBucket::wakeUpWait( const dpsTransLockId &lockId )
+   {
+      PD_TRACE_ENTRY( SDB_DPSLOCKBUCKET_WAKEUPWAIT ) ;
+      {
+         ossScopedLock _lock( &_lstMutex );
+
+         dpsTransLockUnitList::iterator iterLst
+                                 = _lockLst.find( lockId );
+         if ( iterLst != _lockLst.end() &&
+              iterLst->second->_pWaitCB != NULL )
+         {
+            wakeUp( iterLst->second->_pWaitCB );
+         }
+      }
+      PD_TRACE_EXIT ( SDB_DPSLOCKBUCKET_WAKEUPWAIT );
+   }
 }
@@ -162,6 +162,7 @@ namespace engine
    : _lockType( lockType )
    {
       _pNextWaitCB = NULL ;
+      _isFast = FALSE ;
       _pRef = SDB_OSS_NEW ossAtomicSigned64(0);
    }
    dpsTransCBLockInfo::~dpsTransCBLockInfo()
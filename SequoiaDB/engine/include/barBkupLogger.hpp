@@ -39,6 +39,8 @@
 #include "ossIO.hpp"
 #include "oss.hpp"
 #include "ossUtil.hpp"
+#include "ossLatch.hpp"
+#include "ossEvent.hpp"
 #include "core.hpp"
 #include "pmdOptionsMgr.hpp"
 #include "dpsDef.hpp"
@@ -60,6 +62,7 @@ namespace engine
    class _dmsStorageLob ;
    class _pmdEDUCB ;
    class _clsMgr ;
+   class _dmsStorageUnit ;
 
    #define BAR_BACKUP_META_FILE_EXT                   ".bak"
 
@@ -86,7 +89,7 @@ namespace engine
    /*
       Header:: backup version define
    */
-   #define BAR_BACKUP_CUR_VERSION                     2
+   #define BAR_BACKUP_CUR_VERSION                     3
 
    /*
       Backup length define
@@ -112,6 +115,16 @@ namespace engine
 #endif
    #define BAR_MIN_DATAFILE_SIZE                      (32)        // MB
 
+   /*
+      Backup stream define
+   */
+   #define BAR_MAX_STREAM_NUM                         (64)
+   #define BAR_DFT_STREAM_NUM                         (4)
+   // the extent id of a stream has the stream id in the high bits
+   #define BAR_STREAM_EXTENT_ID_BITS                  (48)
+   #define BAR_STREAM_EXTENT_ID( streamID, seq ) \
+      ( ( (UINT64)(streamID) << BAR_STREAM_EXTENT_ID_BITS ) + (UINT64)(seq) )
+
    /*
       _barBackupHeader define
    */
@@ -148,7 +161,11 @@ namespace engine
       UINT64            _thinDataSize ;
       UINT64            _compressDataSize ;
       INT32             _compressionType ;
-      CHAR              _pad[61932] ;
+      UINT32            _streamNum ;
+      UINT64            _dedupDataSize ;
+      // the last extent id of the streams, index is stream id - 1
+      UINT64            _streamLastExtentID[BAR_MAX_STREAM_NUM] ;
+      CHAR              _pad[61408] ;
 
       _barBackupHeader ()
       {
@@ -176,6 +193,8 @@ namespace engine
          _thinDataSize     = 0 ;
          _compressDataSize = 0 ;
          _compressionType  = UTIL_COMPRESSOR_INVALID ;
+         _streamNum        = 0 ;
+         _dedupDataSize    = 0 ;
       }
       void createTime( UINT64 &curTime, CHAR *pBuff, UINT32 size )
       {
@@ -228,7 +247,8 @@ namespace engine
       UINT64            _time ;
       UINT64            _secretValue ;
       INT32             _compressionType ;
-      CHAR              _pad[4060] ;
+      UINT32            _streamID ;          // 0 for the main stream
+      CHAR              _pad[4056] ;
 
       _barBackupDataHeader ()
       {
@@ -275,7 +295,8 @@ namespace engine
       CHAR              _md5Value[BAR_BACKUP_MD5_LEN] ;
       UINT8             _thinCopy ;
       UINT8             _compressed ;
-      CHAR              _reserved[10] ;
+      UINT8             _dedup ;             // refer to an extent
+      CHAR              _reserved[9] ;
       CHAR              _metaData[960] ;
 
       void init ()
@@ -290,6 +311,7 @@ namespace engine
          _dataSize         = 0 ;
          _thinCopy         = 0 ;
          _compressed       = 0 ;
+         _dedup            = 0 ;
       }
       _barBackupExtentHeader ()
       {
@@ -343,6 +365,9 @@ namespace engine
          const CHAR *backupName () const { return _backupName.c_str() ; }
          const CHAR *path () const { return _path.c_str() ; }
 
+         // the entry of the stream worker
+         INT32    runStream ( _pmdEDUCB *cb ) ;
+
       public:
          string   getMainFileName() ;
          string   getIncFileName( UINT32 sequence ) ;
@@ -406,6 +431,20 @@ namespace engine
 
          CHAR*       _allocCompressBuff( UINT64 buffSize ) ;
 
+         /*
+            Start the stream workers and wait for them. The first error of
+            the workers is returned, and the others stop then.
+         */
+         INT32       _runStreams ( UINT32 streamNum, _pmdEDUCB *cb ) ;
+         virtual INT32 _runStream ( _pmdEDUCB *cb ) { return SDB_OK ; }
+         BOOLEAN     _isStreamStopped () const
+         {
+            return SDB_OK != _streamRC ? TRUE : FALSE ;
+         }
+
+      private:
+         void        _onStreamEnd ( INT32 result ) ;
+
       protected:
          barBackupHeader               _metaHeader ;
          string                        _path ;
@@ -422,6 +461,11 @@ namespace engine
          CHAR                          *_pCompressBuff ;
          UINT64                        _buffSize ;
 
+         ossSpinXLatch                 _streamLatch ;
+         ossEvent                      _streamEvent ;
+         UINT32                        _runningStreams ;
+         volatile INT32                _streamRC ;
+
    } ;
    typedef _barBaseLogger barBaseLogger ;
 
@@ -472,6 +516,9 @@ namespace engine
 
          barBackupExtentHeader *_nextDataExtent ( UINT32 dataType ) ;
 
+         // the data files of the streams share the sequence
+         UINT32      _allocDataSequence () ;
+
       private:
          INT32       _openDataFile () ;
          INT32       _closeCurFile () ;
@@ -495,15 +542,118 @@ namespace engine
    } ;
    typedef _barBkupBaseLogger barBkupBaseLogger ;
 
+   /*
+      _barBackupTask define
+      A range of the segments of a storage unit file. The segment 0 of the
+      lob data file is the part before the pages.
+   */
+   struct _barBackupTask
+   {
+      _dmsStorageUnit   *_pSU ;
+      UINT32            _dataType ;
+      UINT32            _beginSeg ;
+      UINT32            _endSeg ;
+   } ;
+   typedef _barBackupTask barBackupTask ;
+
+   class _barBKOfflineLogger ;
+
+   /*
+      _barBkupStream define
+      A backup worker writes the extents of the tasks it takes into its own
+      data files. The extents of a stream are numbered continuously from
+      BAR_STREAM_EXTENT_ID( streamID, 1 ). An extent whose content has been
+      written in the stream is written as a reference to the first one.
+   */
+   class _barBkupStream : public SDBObject
+   {
+      // md5 and size -> extent id
+      typedef std::map< std::string, UINT64 >      MAP_DEDUP ;
+
+      public:
+         _barBkupStream ( _barBKOfflineLogger *pLogger, UINT32 streamID ) ;
+         ~_barBkupStream () ;
+
+         UINT32   streamID () const { return _streamID ; }
+         UINT64   lastExtentID () const
+         {
+            return BAR_STREAM_EXTENT_ID( _streamID, _extentSeq ) ;
+         }
+
+         INT32    run ( _pmdEDUCB *cb ) ;
+
+      private:
+         INT32    _backupTask ( const barBackupTask &task, _pmdEDUCB *cb ) ;
+         INT32    _backupSU ( _dmsStorageBase *pSU,
+                              const barBackupTask &task,
+                              _pmdEDUCB *cb ) ;
+         INT32    _backupLobData ( _dmsStorageLob *pLobSU,
+                                   const barBackupTask &task,
+                                   _pmdEDUCB *cb ) ;
+         INT32    _readLobData ( _dmsStorageLob *pLobSU,
+                                 barBackupExtentHeader *pHeader,
+                                 _pmdEDUCB *cb ) ;
+         INT32    _nextThinCopyInfo ( _dmsStorageBase *pSU,
+                                      UINT32 startExtID,
+                                      UINT32 maxExtID,
+                                      UINT32 maxNum,
+                                      UINT32 &num,
+                                      BOOLEAN &used ) ;
+         BSONObj  _makeExtentMeta ( const CHAR *suName,
+                                    const CHAR *suFileName ) ;
+
+         barBackupExtentHeader* _nextExtent () ;
+         INT32    _dedupExtent ( barBackupExtentHeader *pHeader,
+                                 const CHAR *pData ) ;
+         INT32    _writeExtent ( barBackupExtentHeader *pHeader,
+                                 const CHAR *pData ) ;
+         INT32    _writeData ( const CHAR *buf, UINT64 len ) ;
+         INT32    _openDataFile () ;
+         void     _closeDataFile () ;
+         CHAR*    _allocBuff ( CHAR *&pBuff, UINT64 &buffSize,
+                               UINT64 size ) ;
+
+      public:
+         UINT64                  _dataSize ;
+         UINT64                  _thinDataSize ;
+         UINT64                  _compressDataSize ;
+         UINT64                  _dedupDataSize ;
+
+      private:
+         _barBKOfflineLogger     *_pLogger ;
+         UINT32                  _streamID ;
+         UINT64                  _extentSeq ;
+         barBackupExtentHeader   _extent ;
+
+         OSSFILE                 _file ;
+         BOOLEAN                 _isOpened ;
+         UINT64                  _curFileSize ;
+
+         UINT32                  _curDataType ;
+         UINT64                  _curOffset ;
+         UINT32                  _curSequence ;
+
+         CHAR                    *_pExtentBuff ;
+         UINT64                  _extentBuffSize ;
+         CHAR                    *_pCompressBuff ;
+         UINT64                  _compressBuffSize ;
+         MAP_DEDUP               _mapDedup ;
+   } ;
+   typedef _barBkupStream barBkupStream ;
+
    /*
       _barBKOfflineLogger define
    */
    class _barBKOfflineLogger : public _barBkupBaseLogger
    {
+      friend class _barBkupStream ;
+
       public:
          _barBKOfflineLogger () ;
          virtual ~_barBKOfflineLogger () ;
 
+         void     setStreamNum ( UINT32 streamNum ) ;
+
       protected:
          virtual UINT32    _getBackupType () const ;
 
@@ -511,32 +661,28 @@ namespace engine
          virtual INT32     _doBackup ( _pmdEDUCB *cb ) ;
          virtual INT32     _afterBackup ( _pmdEDUCB *cb ) ;
          virtual INT32     _onWriteMetaFile () ;
+         virtual INT32     _runStream ( _pmdEDUCB *cb ) ;
 
       protected:
-         INT32             _backupSU( _dmsStorageBase *pSU,
-                                      _pmdEDUCB *cb ) ;
+         INT32             _backupStreams( _pmdEDUCB *cb ) ;
          INT32             _backupLog( _pmdEDUCB *cb ) ;
-         INT32             _backupLobData( _dmsStorageLob *pLobSU,
-                                           _pmdEDUCB *cb ) ;
-         BSONObj           _makeExtentMeta( _dmsStorageBase *pSU ) ;
-         BSONObj           _makeExtentMeta( _dmsStorageLob *pLobSU ) ;
 
       private:
-         INT32             _nextThinCopyInfo ( _dmsStorageBase *pSU,
-                                               UINT32 startExtID,
-                                               UINT32 maxExtID,
-                                               UINT32 maxNum,
-                                               UINT32 &num,
-                                               BOOLEAN &used ) ;
+         void              _prepareTasks () ;
+         void              _addTasks ( _dmsStorageUnit *pSU,
+                                       UINT32 dataType,
+                                       UINT32 segmentNum ) ;
+         BOOLEAN           _popTask ( barBackupTask &task ) ;
 
       private:
-         UINT32            _curDataType ;
-         UINT64            _curOffset ;
-         UINT32            _curSequence ;
          INT32             _replStatus ;
          BOOLEAN           _hasRegBackup ;
 
-         CHAR              *_pExtentBuff ;
+         UINT32                        _streamNum ;
+         std::vector< barBackupTask >  _tasks ;
+         UINT32                        _taskPos ;
+         std::vector< barBkupStream* > _streams ;
+         UINT32                        _streamPos ;
    } ;
    typedef _barBKOfflineLogger barBKOfflineLogger ;
 
@@ -642,11 +788,71 @@ namespace engine
    } ;
    typedef _barRSBaseLogger barRSBaseLogger ;
 
+   class _barRSOfflineLogger ;
+
+   /*
+      _barRSStream define
+      A restore worker restores the data files of a stream of the full
+      backup. The extents are written at their offsets of the storage unit
+      files, so that the streams are restored in parallel.
+   */
+   class _barRSStream : public SDBObject
+   {
+      struct _extentLoc
+      {
+         std::string    _pathName ;
+         UINT64         _offset ;
+      } ;
+      typedef std::map< UINT64, _extentLoc >       MAP_EXTENT_LOC ;
+
+      public:
+         _barRSStream ( _barRSOfflineLogger *pLogger, UINT32 streamID ) ;
+         ~_barRSStream () ;
+
+         INT32    restore ( const std::vector< UINT32 > &sequences,
+                            UINT64 lastExtentID,
+                            _pmdEDUCB *cb ) ;
+
+      private:
+         INT32    _openDataFile ( UINT32 sequence ) ;
+         void     _closeDataFile () ;
+         INT32    _readExtent ( const CHAR **ppData ) ;
+         INT32    _readRefExtent ( const CHAR **ppData ) ;
+         INT32    _writeSU ( const CHAR *pData ) ;
+         INT32    _openSUFile ( const std::string &pathName ) ;
+         void     _closeSUFile () ;
+         CHAR*    _allocBuff ( CHAR *&pBuff, UINT64 &buffSize,
+                               UINT64 size ) ;
+
+      private:
+         _barRSOfflineLogger     *_pLogger ;
+         UINT32                  _streamID ;
+         UINT64                  _expectExtID ;
+         barBackupExtentHeader   _extent ;
+         _utilCompressor         *_pCompressor ;
+
+         OSSFILE                 _file ;
+         BOOLEAN                 _isOpened ;
+         UINT32                  _curDataFileSeq ;
+         OSSFILE                 _suFile ;
+         BOOLEAN                 _openedSU ;
+         std::string             _suPathName ;
+
+         CHAR                    *_pBuff ;
+         UINT64                  _buffSize ;
+         CHAR                    *_pUncompBuff ;
+         UINT64                  _uncompBuffSize ;
+         MAP_EXTENT_LOC          _mapExtentLoc ;
+   } ;
+   typedef _barRSStream barRSStream ;
+
    /*
       _barRSOfflineLogger define
    */
    class _barRSOfflineLogger : public _barRSBaseLogger
    {
+      friend class _barRSStream ;
+
       public:
          _barRSOfflineLogger () ;
          virtual ~_barRSOfflineLogger () ;
@@ -656,6 +862,9 @@ namespace engine
                                              BOOLEAN &isEmpty ) ;
          virtual INT32     _doRestore ( _pmdEDUCB *cb ) ;
          virtual INT32     _afterRestore ( _pmdEDUCB *cb ) ;
+         virtual INT32     _runStream ( _pmdEDUCB *cb ) ;
+
+         INT32    _restoreStreams ( _pmdEDUCB *cb ) ;
 
          INT32    _processConfigData( barBackupExtentHeader *pExtHeader,
                                       const CHAR *pData ) ;
@@ -683,6 +892,7 @@ namespace engine
                                              UINT64 &offset ) ;
          INT32             _writeSU( barBackupExtentHeader *pExtHeader,
                                      const CHAR *pData ) ;
+         string            _getSUPath ( UINT32 dataType ) ;
 
       private:
          string               _curSUName ;
@@ -696,6 +906,11 @@ namespace engine
          BOOLEAN              _openedSU ;
 
          clsBucket            _replBucket ;
+
+         // the data file sequences of the streams of the full backup
+         std::vector< std::vector< UINT32 > >   _streamFiles ;
+         std::vector< UINT64 >                  _streamLastExtentIDs ;
+         UINT32                                 _streamPos ;
    } ;
    typedef _barRSOfflineLogger barRSOfflineLogger ;
 
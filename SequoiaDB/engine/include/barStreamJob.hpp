@@ -0,0 +1,73 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = barStreamJob.hpp
+
+   Descriptive Name = Backup And Restore Stream Job Header
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of backup and restore component. This file contains the
+   background job which runs a stream of the backup or the restore.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#ifndef BAR_STREAM_JOB_HPP__
+#define BAR_STREAM_JOB_HPP__
+
+#include "rtnBackgroundJob.hpp"
+#include "barBkupLogger.hpp"
+
+namespace engine
+{
+
+   /*
+      _barStreamJob define
+   */
+   class _barStreamJob : public _rtnBaseJob
+   {
+      public:
+         _barStreamJob ( barBaseLogger *pLogger ) ;
+         virtual ~_barStreamJob () ;
+
+      public:
+         virtual RTN_JOB_TYPE type () const ;
+         virtual const CHAR* name () const ;
+         virtual BOOLEAN muteXOn ( const _rtnBaseJob *pOther ) ;
+         virtual INT32 doit () ;
+
+      private:
+         barBaseLogger           *_pLogger ;
+
+   } ;
+   typedef _barStreamJob barStreamJob ;
+
+   INT32 startStreamJob ( barBaseLogger *pLogger, EDUID *pEDUID = NULL ) ;
+
+}
+
+#endif //BAR_STREAM_JOB_HPP__
+
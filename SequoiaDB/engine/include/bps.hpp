@@ -43,6 +43,7 @@
 #include "oss.hpp"
 #include "ossQueue.hpp"
 #include "bpsPrefetch.hpp"
+#include "bpsReadAhead.hpp"
 #include "ossAtomic.hpp"
 #include "sdbInterface.hpp"
 
@@ -61,6 +62,7 @@ namespace engine
          INT32                      _numPreLoad ;
          UINT32                     _maxPrefPool ;
          std::vector<EDUID>         _preLoaderList ;
+         bpsReadAheadStat           _readAheadStat ;
 
       public:
          ossAtomic32                _curPrefAgentNum ;
@@ -90,6 +92,10 @@ namespace engine
          {
             return _maxPrefPool > 0 ? TRUE : FALSE ;
          }
+         OSS_INLINE bpsReadAheadStat *getReadAheadStat ()
+         {
+            return &_readAheadStat ;
+         }
 
       public :
          _bpsCB () :
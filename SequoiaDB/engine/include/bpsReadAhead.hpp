@@ -0,0 +1,132 @@
+/*******************************************************************************
+
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = bpsReadAhead.hpp
+
+   Descriptive Name = Buffer Pool Service Read Ahead Header
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of BPS component. This file contains structure for the scan
+   read ahead, which detects the sequential extent access of a scan and
+   asks the OS to read the following pages of the mapped file in advance.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+#ifndef BPS_READAHEAD_HPP__
+#define BPS_READAHEAD_HPP__
+
+#include "core.hpp"
+#include "oss.hpp"
+#include "ossAtomic.hpp"
+#include "dms.hpp"
+#include "../bson/bson.hpp"
+
+using namespace bson ;
+
+namespace engine
+{
+   class _dmsStorageBase ;
+
+   /*
+      Read ahead window
+   */
+   #define BPS_RA_MIN_WINDOW_SIZE         ( 1024 * 1024 )
+   // the window covers the pages consumed in this time ( microseconds )
+   #define BPS_RA_LEAD_TIME               ( 200 * 1000 )
+   // accesses in sequence before the first read ahead
+   #define BPS_RA_SEQ_THRESHOLD           ( 2 )
+
+   /*
+      _bpsReadAheadStat define
+   */
+   class _bpsReadAheadStat : public SDBObject
+   {
+      public:
+         _bpsReadAheadStat ()
+         : _issueNum( 0 ), _issuePages( 0 ), _hitNum( 0 ), _missNum( 0 ),
+           _wastedPages( 0 )
+         {
+         }
+         ~_bpsReadAheadStat () {}
+
+         void toBSON( BSONObjBuilder &builder ) const ;
+
+      public:
+         // number of read ahead issued and the pages of them
+         ossAtomic64       _issueNum ;
+         ossAtomic64       _issuePages ;
+         // sequential accesses which hit / missed the read ahead window
+         ossAtomic64       _hitNum ;
+         ossAtomic64       _missNum ;
+         // pages read ahead but never accessed by the scan
+         ossAtomic64       _wastedPages ;
+   } ;
+   typedef _bpsReadAheadStat bpsReadAheadStat ;
+
+   /*
+      _bpsReadAhead define
+
+      Read ahead state of one scan. The scan reports every extent ( or
+      index page ) it steps into by onAccess(). When the accesses go
+      forward in the file, the pages after the current extent are advised
+      with WILLNEED. The window is sized by the consuming rate of the scan,
+      so that it covers BPS_RA_LEAD_TIME of scanning, and is doubled when
+      the scan catches up with the window.
+   */
+   class _bpsReadAhead : public SDBObject
+   {
+      public:
+         _bpsReadAhead() ;
+         ~_bpsReadAhead() ;
+
+         void  onAccess( _dmsStorageBase *su, dmsExtentID extentID,
+                         UINT32 pageNum ) ;
+
+         // the scan has stopped or moved away, the window is dropped
+         void  reset() ;
+
+      private:
+         void  _issue( dmsExtentID endExtent, BOOLEAN missed ) ;
+
+      private:
+         _dmsStorageBase      *_su ;
+         dmsExtentID          _lastExtent ;
+         // the page after the last accessed extent
+         dmsExtentID          _nextExtent ;
+         // pages [ _raBegin, _raEnd ) are advised
+         dmsExtentID          _raBegin ;
+         dmsExtentID          _raEnd ;
+         UINT32               _seqNum ;
+         UINT32               _window ;
+         UINT32               _consumed ;
+         UINT64               _lastIssueTime ;
+   } ;
+   typedef _bpsReadAhead bpsReadAhead ;
+
+}
+
+#endif //BPS_READAHEAD_HPP__
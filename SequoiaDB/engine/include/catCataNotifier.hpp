@@ -0,0 +1,128 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = catCataNotifier.hpp
+
+   Descriptive Name = Catalog Change Notifier Header
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of catalog component. This file contains the notifier which
+   pushes the catalog changes to the subscribed coordinators.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+#ifndef CAT_CATA_NOTIFIER_HPP__
+#define CAT_CATA_NOTIFIER_HPP__
+
+#include "core.hpp"
+#include "oss.hpp"
+#include "ossLatch.hpp"
+#include "netDef.hpp"
+#include "catEventHandler.hpp"
+#include "../bson/bson.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace bson ;
+
+namespace engine
+{
+   class sdbCatalogueCB ;
+
+   #define CAT_CATA_LEASE_MIN                ( OSS_ONE_SEC )
+   #define CAT_CATA_LEASE_MAX                ( 300 * OSS_ONE_SEC )
+   // the max number of the names in one notification
+   #define CAT_CATA_NTY_MAX_NAME_NUM         ( 1000 )
+
+   /*
+      _catCataNotifier define
+      The coordinators subscribe the catalog changes with a lease, which
+      they renew periodically. The names of the collections whose catalog
+      is changed in a command are pushed to the subscribers whose leases
+      are alive when the command ends, so that the coordinators refresh
+      their cache before the sessions hit the stale version. The changes
+      are kept per EDU, the ones made out of any command are pushed at
+      once.
+   */
+   class _catCataNotifier : public SDBObject, public _catEventHandler
+   {
+      // handle -> expire time( ms )
+      typedef std::map< NET_HANDLE, UINT64 >       MAP_SUBSCRIBER ;
+      typedef MAP_SUBSCRIBER::iterator             MAP_SUBSCRIBER_IT ;
+      typedef std::set< std::string >              SET_NAME ;
+      // the EDUs in command -> names changed in the command
+      typedef std::map< EDUID, SET_NAME >          MAP_EDU_NAME ;
+      typedef MAP_EDU_NAME::iterator               MAP_EDU_NAME_IT ;
+
+   public:
+      _catCataNotifier() ;
+      virtual ~_catCataNotifier() ;
+
+      INT32 init() ;
+      INT32 fini() ;
+
+      virtual const CHAR *getHandlerName () { return "catCataNotifier" ; }
+      virtual INT32 onBeginCommand ( MsgHeader *pReqMsg ) ;
+      virtual INT32 onEndCommand ( MsgHeader *pReqMsg, INT32 result ) ;
+      virtual INT32 onSendReply ( MsgOpReply *pReply, INT32 result )
+      {
+         return SDB_OK ;
+      }
+
+      /*
+         Subscribe or renew the lease, the lease time is adjusted into
+         the range. Return whether the subscriber is new.
+      */
+      BOOLEAN  subscribe ( const NET_HANDLE &handle, UINT32 &leaseTime ) ;
+      void     unsubscribe ( const NET_HANDLE &handle ) ;
+      void     clear () ;
+
+      // the catalog of the collection is changed by current EDU
+      void     onChange ( const CHAR *clFullName ) ;
+
+      UINT32   subscriberNum () ;
+
+   private:
+      EDUID    _curEDUID () ;
+      void     _notify ( const SET_NAME &names ) ;
+      void     _sendNty ( const std::vector< NET_HANDLE > &handles,
+                          const BSONObj &obj ) ;
+
+   private:
+      sdbCatalogueCB       *_pCatCB ;
+      MAP_SUBSCRIBER       _subscribers ;
+      MAP_EDU_NAME         _changedNames ;
+      ossSpinXLatch        _latch ;
+   } ;
+   typedef _catCataNotifier catCataNotifier ;
+
+}
+
+#endif // CAT_CATA_NOTIFIER_HPP__
+
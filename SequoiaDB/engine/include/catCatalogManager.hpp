@@ -75,6 +75,7 @@ namespace engine
    #define CAT_MASK_CLMAXSIZE       0x00004000
    #define CAT_MASK_CLOVERWRITE     0x00008000
    #define CAT_MASK_STRICTDATAMODE  0x00010000
+   #define CAT_MASK_BLOCKCOMPRESSED 0x00020000
 
    struct _catCollectionInfo
    {
@@ -91,6 +92,7 @@ namespace engine
       BOOLEAN     _autoSplit ;
       BOOLEAN     _autoRebalance ;
       BOOLEAN     _strictDataMode ;
+      BOOLEAN     _blockCompressed ;
       const CHAR * _gpSpecified ;
       INT32       _version ;
       INT32       _assignType ;
@@ -117,6 +119,7 @@ namespace engine
          _autoSplit           = FALSE ;
          _autoRebalance       = FALSE ;
          _strictDataMode      = FALSE ;
+         _blockCompressed     = FALSE ;
          _gpSpecified         = NULL ;
          _version             = 0 ;
          _assignType          = ASSIGN_RANDOM ;
@@ -196,6 +199,7 @@ namespace engine
       INT32 processQueryCatalogue ( const NET_HANDLE &handle,
                                     MsgHeader *pMsg ) ;
       INT32 processQueryTask ( const NET_HANDLE &handle, MsgHeader *pMsg ) ;
+      INT32 processSubscribe ( const NET_HANDLE &handle, MsgHeader *pMsg ) ;
       INT32 processCmdCrtProcedures( void *pMsg ) ;
       INT32 processCmdRmProcedures( void *pMsg ) ;
       INT32 processCmdCreateDomain ( const CHAR *pQuery ) ;
@@ -49,6 +49,7 @@
 #include "catCatalogManager.hpp"
 #include "catNodeManager.hpp"
 #include "catDCManager.hpp"
+#include "catCataNotifier.hpp"
 #include "sdbInterface.hpp"
 #include "catLevelLock.hpp"
 
@@ -156,6 +157,10 @@ namespace engine
          {
             return &_levelLockMgr ;
          }
+         catCataNotifier* getCataNotifier()
+         {
+            return &_cataNotifier ;
+         }
 
          void regEventHandler ( _catEventHandler *pHandler ) ;
          void unregEventHandler ( _catEventHandler *pHandler ) ;
@@ -192,6 +197,7 @@ namespace engine
          catNodeManager       _catNodeMgr ;
          catDCManager         _catDCMgr ;
          catLevelLockMgr      _levelLockMgr ;
+         catCataNotifier      _cataNotifier ;
 
          MsgRouteID           _primaryID ;
          BOOLEAN              _isActived ;
@@ -157,6 +157,60 @@ namespace engine
 
    class _clsShardingKeySite ;
 
+   /*
+      _clsRouteBatch define
+
+      The records of a batch and their catalog items. The sharding keys of
+      the whole batch are extracted into one flat buffer before routing,
+      the buffers are kept by the caller and reused between the batches,
+      so that no memory is allocated for each record.
+   */
+   class _clsRouteBatch : public SDBObject
+   {
+      public:
+         _clsRouteBatch() {}
+         ~_clsRouteBatch() {}
+
+         void  clear()
+         {
+            _records.clear() ;
+            _keyOffsets.clear() ;
+            _items.clear() ;
+            _groupIDs.clear() ;
+            _keyBuf.reset() ;
+         }
+
+         void  reserve( UINT32 num )
+         {
+            _records.reserve( num ) ;
+            _keyOffsets.reserve( num ) ;
+            _items.reserve( num ) ;
+            _groupIDs.reserve( num ) ;
+         }
+
+         void  push( const CHAR *pRecord ) { _records.push_back( pRecord ) ; }
+
+         UINT32 size() const { return _records.size() ; }
+         const CHAR* record( UINT32 pos ) const { return _records[ pos ] ; }
+         UINT32 groupID( UINT32 pos ) const { return _groupIDs[ pos ] ; }
+         // of the main collection, valid after findItems
+         const string& subCLName( UINT32 pos ) const
+         {
+            return _items[ pos ]->getSubClName() ;
+         }
+
+      private:
+         std::vector< const CHAR* >    _records ;
+         // offset of the key in _keyBuf, -1 when the record is routed alone
+         std::vector< INT32 >          _keyOffsets ;
+         std::vector< clsCatalogItem* > _items ;
+         VEC_GROUP_ID                  _groupIDs ;
+         BufBuilder                    _keyBuf ;
+
+         friend class _clsCatalogSet ;
+   } ;
+   typedef _clsRouteBatch clsRouteBatch ;
+
    /*
       _clsCatalogSet define
    */
@@ -199,6 +253,8 @@ namespace engine
          INT32             findGroupID ( const bson::OID &oid,
                                          UINT32 sequence,
                                          UINT32 &groupID ) ;
+         INT32             findItems ( clsRouteBatch &batch ) ;
+         INT32             findGroupIDs ( clsRouteBatch &batch ) ;
          INT32             findGroupIDS ( const BSONObj &matcher,
                                           VEC_GROUP_ID &vecGroup );
          INT32             findSubCLName ( const BSONObj &obj,
@@ -268,6 +324,8 @@ namespace engine
          INT32             _findItem( const clsCataItemKey &findKey,
                                       clsCatalogItem *& item ) ;
          INT32             _hash( const BSONObj &key ) ;
+         INT32             _extractKey( const BSONObj &obj,
+                                        BufBuilder &keyBuf ) ;
          void              _addSubClName( UINT32 id,
                                           const std::string &strClName );
 
@@ -111,6 +111,11 @@ namespace engine
             return TRUE, will run after code
          */
          virtual BOOLEAN _onNotify ( MsgClsFSNotifyRes *pMsg ) = 0 ;
+         /*
+            return TRUE, the non-unique indexes are built after the data
+            of the collection is synced
+         */
+         virtual BOOLEAN _deferIndex () const { return FALSE ; }
 
       protected:
          INT32 handleMetaRes( NET_HANDLE handle, MsgHeader* header ) ;
@@ -151,6 +156,9 @@ namespace engine
          UINT32         _removeCS ( const CHAR *pCSName ) ;
          UINT32         _removeValidCLs( const vector<string> &validCLs ) ;
 
+         BOOLEAN        _canDeferIndex( const BSONObj &index ) ;
+         INT32          _buildDeferredIndexes() ;
+
       private:
          INT32 _replayDoc( const MsgClsFSNotifyRes *msg ) ;
          INT32 _replayLog( const MsgClsFSNotifyRes *msg ) ;
@@ -171,6 +179,7 @@ namespace engine
          DPS_LSN              _expectLSN ;
          UINT64               _lastOprLSN ;
          BOOLEAN              _needMoreDoc ;
+         vector<BSONObj>      _deferredIndexes ;
 
    };
 
@@ -284,6 +293,7 @@ namespace engine
          virtual INT32     _dataSessionType () const ;
          virtual BOOLEAN   _isReady () ;
          virtual BOOLEAN   _onNotify ( MsgClsFSNotifyRes *pMsg ) ;
+         virtual BOOLEAN   _deferIndex () const { return TRUE ; }
 
       private:
          void              _taskNotify ( INT32 msgType ) ;
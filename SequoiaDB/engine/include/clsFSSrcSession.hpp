@@ -47,6 +47,7 @@
 #include "rtnRecover.hpp"
 #include "../bson/bsonobj.h"
 #include <map>
+#include <vector>
 
 using namespace std ;
 using namespace bson ;
@@ -87,6 +88,8 @@ namespace engine
          virtual INT32 notifyLSN ( UINT32 suLID, UINT32 clLID,
                                    dmsExtentID extLID,
                                    const DPS_LSN_OFFSET &offset ) = 0 ;
+         // the collection is being scanned, or its logs are being sent
+         BOOLEAN       isSyncing ( UINT32 suLID, UINT32 clLID ) ;
 
       protected:
          virtual INT32       _isReady () = 0 ;
@@ -101,6 +104,8 @@ namespace engine
          virtual INT32     _onLobFilter( const bson::OID &oid,
                                          UINT32 sequence,
                                          BOOLEAN &need2Send ) = 0 ;
+         // the records which have been read but not sent yet
+         virtual BOOLEAN   _hasPendingRecord () { return FALSE ; }
 
       protected:
          virtual void   _onAttach () ;
@@ -116,7 +121,7 @@ namespace engine
                                     const _MsgClsFSNotify *req ) ;
          void              _eraseDefaultIndex() ;
          BOOLEAN           _existIndex( const CHAR *indexName ) ;
-         INT32             _openContext( CHAR *cs, CHAR *collection ) ;
+         virtual INT32     _openContext( CHAR *cs, CHAR *collection ) ;
          void              _constructIndex( BSONObj &obj ) ;
          void              _constructMeta( BSONObj &obj, const CHAR *cs,
                                            const CHAR *collection,
@@ -131,7 +136,7 @@ namespace engine
                                      SINT64 packet,
                                      const MsgRouteID &routeID,
                                      UINT32 TID, UINT64 requestID ) ;
-         INT32             _syncRecord( const NET_HANDLE &handle,
+         virtual INT32     _syncRecord( const NET_HANDLE &handle,
                                         SINT64 packet,
                                         const MsgRouteID &routeID,
                                         UINT32 TID, UINT64 requestID ) ;
@@ -260,9 +265,29 @@ namespace engine
          virtual INT32   _onLobFilter( const bson::OID &oid,
                                        UINT32 sequence,
                                        BOOLEAN &need2Send ) ;
+         virtual BOOLEAN _hasPendingRecord () ;
+         virtual void    _reset () ;
+         virtual INT32   _openContext( CHAR *cs, CHAR *collection ) ;
+         virtual INT32   _syncRecord( const NET_HANDLE &handle,
+                                      SINT64 packet,
+                                      const MsgRouteID &routeID,
+                                      UINT32 TID, UINT64 requestID ) ;
+
+      protected:
+         INT32   _openStreams( const vector< dmsExtentID > &segExtents ) ;
+         INT32   _openStream( const BSONObj &blockObj,
+                              _rtnContextData **ppContext ) ;
+         INT32   _nextStreamPass() ;
+         void    _closeStream( UINT32 index ) ;
+         void    _closeStreams() ;
+         BOOLEAN _isExtScanned( dmsExtentID extLID ) ;
 
       protected:
          INT32   _genKeyObj ( const BSONObj &obj, BSONObj &keyObj ) ;
+         // count the records of the bulk load log which are in the range
+         INT32   _countLoadInRange( const CHAR *pLogRecord,
+                                    UINT32 &inRangeNum,
+                                    UINT32 &recordNum ) ;
          BOOLEAN _containMultiKey ( const BSONObj &obj ) ;
          BOOLEAN _GEThanRangeKey ( const BSONObj &keyObj ) ;
          BOOLEAN _LThanRangeEndKey( const BSONObj &keyObj ) ;
@@ -298,6 +323,20 @@ namespace engine
          UINT64                           _lastOprLSN ;
          UINT32                           _internalV ;
          string                           _mainCLName ;
+
+         /*
+            The segments of the collection are scanned by several streams
+            when the block scan is supported, each stream is a data context
+            of a part of the segments and reads ahead on the prefetch EDUs.
+            The streams and the owners of the segments are changed under
+            _LSNlatch, as notifyLSN checks them.
+         */
+         BOOLEAN                          _streamScan ;
+         UINT32                           _aliveStreamNum ;
+         vector< _rtnContextData* >       _vecStream ;
+         vector< BOOLEAN >                _vecReadAhead ;
+         // logical segment -> stream index, -1 for the scanned segments
+         map< UINT32, INT32 >             _mapSegOwner ;
    };
 }
 
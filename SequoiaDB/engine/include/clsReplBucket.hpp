@@ -162,6 +162,8 @@ namespace engine
          void        fini () ;
 
          UINT32      calcIndex( const CHAR *pData, UINT32 len ) ;
+         UINT32      calcIndex( const CHAR *pPrefix, UINT32 prefixLen,
+                                const CHAR *pData, UINT32 len ) ;
 
          INT32       pushData( UINT32 index, CHAR *pData, UINT32 len ) ;
          BOOLEAN     popData( UINT32 index, CHAR **ppData, UINT32 &len ) ;
@@ -45,6 +45,8 @@
 #include "rtnBackgroundJob.hpp"
 #include "utilCompressor.hpp"
 #include "../bson/bsonobj.h"
+#include <map>
+#include <string>
 
 using namespace bson ;
 
@@ -55,6 +57,22 @@ namespace engine
    class _dpsLogWrapper ;
    class _clsBucket ;
 
+   /*
+      CLS_REPLAY_MODE define, how the data logs of a collection are
+      dispatched to the repl bucket
+   */
+   enum CLS_REPLAY_MODE
+   {
+      // wait the bucket empty and replay by the session itself
+      CLS_REPLAY_SERIAL       = 0,
+      // hashed by collection and _id, the logs of one record are in order
+      CLS_REPLAY_BY_ID,
+      // hashed by collection, the logs of one collection are in order
+      CLS_REPLAY_BY_CL
+   } ;
+
+   #define CLS_REPLAY_MAX_CL_CACHE        ( 4096 )
+
    /*
       _clsReplayer define
    */
@@ -102,10 +120,21 @@ namespace engine
                             const CHAR *data,
                             _pmdEDUCB *eduCB ) ;
 
+      /*
+         The replay mode of collections is cached until a log which isn't
+         replayed by bucket ( DDL, transaction commit, ... ), a rollback,
+         or this function
+      */
+      void  clearReplayModeCache () ;
+
+   private:
+      CLS_REPLAY_MODE _getReplayMode( const CHAR *fullName ) ;
+
    private:
       _SDB_DMSCB              *_dmsCB ;
       _dpsLogWrapper          *_dpsCB ;
       monDBCB                 *_monDBCB ;
+      std::map< std::string, CLS_REPLAY_MODE >  _mapReplayMode ;
 
    } ;
    typedef class _clsReplayer clsReplayer ;
@@ -228,6 +228,8 @@ namespace engine
       public:
          void  regSession ( _clsDataSrcBaseSession *pSession ) ;
          void  unregSession ( _clsDataSrcBaseSession *pSession ) ;
+         // whether a split or full sync source session syncs the collection
+         BOOLEAN isCLInDataSync ( UINT32 suLID, UINT32 clLID ) ;
 
       public:
          INT32 initialize() ;
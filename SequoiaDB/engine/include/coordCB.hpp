@@ -93,6 +93,9 @@ namespace engine
                         UINT32 replyDataLen = 0 ) ;
          INT32 _sendRegisterMsg () ;
          INT32 _onCatRegisterRes ( const NET_HANDLE &handle, MsgHeader *pMsg ) ;
+         INT32 _sendSubscribeMsg () ;
+         INT32 _onCatSubscribeRes ( const NET_HANDLE &handle,
+                                    MsgHeader *pMsg ) ;
          INT32 _defaultMsgFunc( NET_HANDLE handle, MsgHeader *pMsg ) ;
          void _onMsgBegin( MsgHeader *pMsg ) ;
          void _onMsgEnd() ;
@@ -120,6 +123,7 @@ namespace engine
          INT32 _sendToCatlog ( MsgHeader *pMsg, NET_HANDLE *pHandle = NULL ) ;
          INT32 _processUpdateGrpInfo () ;
          INT32 _processCatGrpChgNty () ;
+         INT32 _processCataChangeNty ( MsgHeader *pMsg ) ;
       private:
 
          coordResource                 _resource ;
@@ -135,6 +139,10 @@ namespace engine
          _MsgRouteID                   _selfNodeID ;
 
          UINT64                        _regTimerID ;
+         // the lease of the catalog change notification
+         UINT64                        _leaseTimerID ;
+         UINT64                        _leaseSendTime ;
+         UINT64                        _leaseExpireTime ;
 
          ossEvent                      _attachEvent ;
 
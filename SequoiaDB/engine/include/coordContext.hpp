@@ -67,6 +67,15 @@ namespace engine
    public:
       void           appendData ( MsgOpReply *pReply ) ;
       void           clearData () ;
+      // keep the reply of the get more which is sent before the data is
+      // drained, it is taken as the data by appendPrefetched()
+      void           setPrefetched( MsgOpReply *pReply ) ;
+      BOOLEAN        hasPrefetched() const { return NULL != _pPrefetched ; }
+      void           appendPrefetched() ;
+      // the context of the data node is closed
+      void           setNoMore() { _contextID = -1 ; }
+      // the reply is given up, which is forwarded by the main context
+      virtual CHAR*  detachData() ;
       MsgRouteID     getRouteID() ;
       const CHAR*    front () ;
       INT32          pop() ;
@@ -91,6 +100,7 @@ namespace engine
       MsgRouteID           _routeID ;
       INT32                _curOffset ;
       MsgOpReply*          _pData ;
+      MsgOpReply*          _pPrefetched ;
       INT32                _recordNum ;
    } ;
    typedef _coordSubContext coordSubContext ;
@@ -165,9 +175,16 @@ namespace engine
          INT32    _reOrderSubContext() ;
          INT32    _prepareSubCtxData( _pmdEDUCB *cb ) ;
 
+         INT32    _prefetchSubCtx( _pmdEDUCB *cb,
+                                   coordSubContext *pSubContext ) ;
+         void     _prefetchOrderedSubCtxs( _pmdEDUCB *cb ) ;
+
       private:
          EMPTY_CONTEXT_MAP          _emptyContextMap ;
          EMPTY_CONTEXT_MAP          _prepareContextMap ;
+         // the ordered sub contexts which have data, and the get more is
+         // sent for their next data
+         EMPTY_CONTEXT_MAP          _prefetchContextMap ;
 
          rtnOrderKey                _emptyKey ;
          BOOLEAN                    _preRead ;
@@ -191,7 +208,7 @@ namespace engine
    OSS_INLINE BOOLEAN _rtnContextCoord::_requireExplicitSorting () const
    {
       return requireOrder() &&
-             ( _orderedContextMap.size() + _emptyContextMap.size() +
+             ( _orderedContextTree.size() + _emptyContextMap.size() +
                _prepareContextMap.size() > 1 ) ;
    }
 
@@ -185,12 +185,22 @@ namespace engine
          return _catlogSet.findGroupID ( recordObj, groupID ) ;
       }
 
+      INT32 getGroupByRecords( clsRouteBatch &batch )
+      {
+         return _catlogSet.findGroupIDs( batch ) ;
+      }
+
       INT32 getSubCLNameByRecord( const BSONObj &recordObj,
                                   string &subCLName )
       {
          return _catlogSet.findSubCLName( recordObj, subCLName ) ;
       }
 
+      INT32 getSubCLNameByRecords( clsRouteBatch &batch )
+      {
+         return _catlogSet.findItems( batch ) ;
+      }
+
       INT32 getMatchSubCLs( const BSONObj &matcher,
                             CoordSubCLlist &subCLList )
       {
@@ -74,19 +74,17 @@ namespace engine
                                  const netIOV &fixed,
                                  GROUP_2_IOVEC &datas ) ;
 
-         INT32 shardAnObj( const CHAR *pInsertor,
-                           CoordCataInfoPtr &cataInfo,
-                           const netIOV &fixed,
-                           GROUP_2_IOVEC &datas ) ;
-
          INT32 reshardData( CoordCataInfoPtr &cataInfo,
                             const netIOV &fixed,
                             GROUP_2_IOVEC &datas ) ;
 
-         INT32 shardAnObj( const CHAR *pInsertor,
-                           CoordCataInfoPtr &cataInfo,
-                           pmdEDUCB * cb,
-                           GroupSubCLMap &groupSubCLMap ) ;
+         INT32 shardBatch( CoordCataInfoPtr &cataInfo,
+                           const netIOV &fixed,
+                           GROUP_2_IOVEC &datas ) ;
+
+         INT32 shardMainBatch( CoordCataInfoPtr &cataInfo,
+                               pmdEDUCB *cb,
+                               GroupSubCLMap &groupSubCLMap ) ;
 
          INT32 shardDataByGroup( CoordCataInfoPtr &cataInfo,
                                  INT32 count,
@@ -140,6 +138,10 @@ namespace engine
       private:
          UINT32         _insertedNum ;
          UINT32         _ignoredNum ;
+         // the records to route, reused by the batches and the retries
+         clsRouteBatch  _routeBatch ;
+         // the records of one sub-collection of main collection
+         clsRouteBatch  _subRouteBatch ;
 
          /*
             For main collection
@@ -171,6 +171,15 @@ namespace engine
                                           CoordCataInfoPtr &cataPtr,
                                           _pmdEDUCB *cb ) ;
 
+         /*
+            Refresh the cached catalog info of the collections in batch,
+            the collections which are not cached are ignored, and the
+            ones which are not refreshed are removed from the cache.
+         */
+         INT32       refreshCataInfo( const vector< string > &names,
+                                      _pmdEDUCB *cb ) ;
+         INT32       refreshAllCataInfo( _pmdEDUCB *cb ) ;
+
       protected:
          void        setCataGroupInfo( CoordGroupInfoPtr &groupPtr ) ;
          void        addGroupInfo( CoordGroupInfoPtr &groupPtr ) ;
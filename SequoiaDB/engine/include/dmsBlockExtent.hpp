@@ -0,0 +1,178 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = dmsBlockExtent.hpp
+
+   Descriptive Name = Data Management Service Block Extent Header
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of data management component. This file contains the block
+   compression of the sealed data extents, and the cache of the
+   decompressed chunks.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#ifndef DMSBLOCKEXTENT_HPP__
+#define DMSBLOCKEXTENT_HPP__
+
+#include "core.hpp"
+#include "oss.hpp"
+#include "dmsExtent.hpp"
+
+namespace engine
+{
+   /*
+      Eyecatcher define
+   */
+   #define DMS_BLOCK_EYECATCHER0          'B'
+   #define DMS_BLOCK_EYECATCHER1          'K'
+
+   // the payload is compressed by chunks, so that a read only decompresses
+   // the chunks covering the record
+   #define DMS_BLOCK_CHUNK_SQUARE         ( 16 )   // 64KB
+   // the extent is left raw when the block is greater than the ratio
+   #define DMS_BLOCK_MIN_RATIO            ( 80 )
+   // the deleted space of a full extent is given up when it's sealed
+   #define DMS_BLOCK_SEAL_MAX_FREE        ( DMS_PAGE_SIZE4K )
+   // the number of the extents before the last one checked in a round
+   #define DMS_BLOCK_SEAL_WINDOW          ( 16 )
+   // the max number of the deleted records checked in a delete list
+   #define DMS_BLOCK_SEAL_MAX_WALK        ( 1024 )
+   #define DMS_BLOCK_CACHE_SLOT_NUM       ( 4 )
+
+   /*
+      _dmsBlockHeader define
+      It's at the beginning of the payload of a compressed extent, and is
+      followed by the offsets of the chunks( _chunkNum + 1 ), which are
+      relative to the header. A chunk whose length is the raw length is
+      stored raw.
+   */
+   struct _dmsBlockHeader
+   {
+      CHAR        _eyeCatcher[2] ;
+      UINT8       _compressorType ;
+      UINT8       _chunkSquare ;
+      UINT32      _chunkNum ;
+      UINT32      _rawSize ;
+      UINT32      _dataSize ;    // header, offsets and chunks
+      UINT64      _sealID ;
+
+      BOOLEAN validate() const
+      {
+         return DMS_BLOCK_EYECATCHER0 == _eyeCatcher[0] &&
+                DMS_BLOCK_EYECATCHER1 == _eyeCatcher[1] ;
+      }
+      const UINT32* offsets() const
+      {
+         return ( const UINT32* )( ( const CHAR* )this +
+                                   sizeof( _dmsBlockHeader ) ) ;
+      }
+   } ;
+   typedef struct _dmsBlockHeader dmsBlockHeader ;
+
+   OSS_INLINE BOOLEAN dmsIsBlockExtent( const dmsExtent *pExtent )
+   {
+      return DMS_EXTENT_EYECATCHER0 == pExtent->_eyeCatcher[0] &&
+             DMS_EXTENT_EYECATCHER1 == pExtent->_eyeCatcher[1] &&
+             ( pExtent->_flag & DMS_EXTENT_FLAG_COMPRESSED ) ;
+   }
+
+   OSS_INLINE const dmsBlockHeader* dmsGetBlockHeader(
+                                             const dmsExtent *pExtent )
+   {
+      return ( const dmsBlockHeader* )( ( const CHAR* )pExtent +
+                                        DMS_EXTENT_METADATA_SZ ) ;
+   }
+
+   /*
+      Compress the payload of the extent into a new allocated block, which
+      is released by SDB_OSS_FREE. SDB_UTIL_COMPRESS_ABORT is returned when
+      the block doesn't meet the ratio.
+   */
+   INT32 dmsBlockCompress( const dmsExtent *pExtent, UINT32 extentSize,
+                           CHAR **ppBlock, UINT32 &blockSize ) ;
+
+   /*
+      Decompress the payload of the compressed extent into pOutput, which
+      has the extent size. The extent header is copied without the flag.
+   */
+   INT32 dmsBlockUncompress( const dmsExtent *pExtent, UINT32 extentSize,
+                             CHAR *pOutput ) ;
+
+   // decompress the payload in place, the caller holds the extent exclusive
+   INT32 dmsBlockUnseal( dmsExtent *pExtent, UINT32 extentSize ) ;
+
+   /*
+      _dmsBlockCache define
+      The decompressed chunks of the compressed extents read by an EDU. A
+      pointer got from the cache is valid until the EDU misses the cache
+      DMS_BLOCK_CACHE_SLOT_NUM times, which covers a record and the
+      neighbours being used together.
+   */
+   class _dmsBlockCache : public SDBObject
+   {
+      struct _slot
+      {
+         const void  *_pOwner ;
+         INT32       _extentID ;
+         UINT64      _sealID ;
+         UINT32      _beginChunk ;
+         UINT32      _endChunk ;
+         CHAR        *_pBuff ;
+         UINT32      _buffSize ;
+         UINT64      _tick ;
+      } ;
+
+   public:
+      _dmsBlockCache() ;
+      ~_dmsBlockCache() ;
+
+      /*
+         Read the range of the compressed extent, the offset is relative
+         to the extent and must be after the extent header. The owner is the
+         storage of the extent.
+      */
+      const CHAR* read( const void *pOwner, INT32 extentID,
+                        const dmsExtent *pExtent,
+                        UINT32 offset, UINT32 len, INT32 &rc ) ;
+      void        clear() ;
+
+   private:
+      INT32       _load( _slot &slot, const void *pOwner, INT32 extentID,
+                         const dmsBlockHeader *pHeader,
+                         UINT32 beginChunk, UINT32 endChunk ) ;
+
+   private:
+      _slot       _slots[ DMS_BLOCK_CACHE_SLOT_NUM ] ;
+      UINT64      _tick ;
+   } ;
+   typedef _dmsBlockCache dmsBlockCache ;
+
+}
+
+#endif // DMSBLOCKEXTENT_HPP__
+
@@ -128,6 +128,8 @@ namespace engine
       }
    } ;
    typedef _dmsDictJob dmsDictJob ;
+   // the collection whose full extents are waiting for sealing
+   typedef _dmsDictJob dmsSealJob ;
 
    /*
       _SDB_DMSCB define
@@ -179,6 +181,12 @@ namespace engine
        * queue.
        */
       ossQueue<dmsDictJob>    _dictWaitQue ;
+      /*
+       * Queue of collections which have new full extents to be compressed.
+       * The same collection may be pushed many times, the later jobs find
+       * nothing to do.
+       */
+      ossQueue<dmsSealJob>    _sealWaitQue ;
 
       ossSpinXLatch           _stateMtx;
       ossEvent                _blockEvent ;
@@ -319,6 +327,9 @@ namespace engine
       BOOLEAN dispatchDictJob( dmsDictJob &job ) ;
       void pushDictJob( dmsDictJob job ) ;
 
+      BOOLEAN dispatchSealJob( dmsSealJob &job, INT64 timeout ) ;
+      void pushSealJob( dmsSealJob job ) ;
+
       void setIxmKeySorterCreator( dmsIxmKeySorterCreator* creator ) ;
       dmsIxmKeySorterCreator* getIxmKeySorterCreator() ;
       dmsIxmKeySorter* createIxmKeySorter( INT64 bufSize, const _dmsIxmKeyComparer& comparer ) ;
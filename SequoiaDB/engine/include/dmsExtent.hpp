@@ -62,6 +62,8 @@ namespace engine
    */
    #define DMS_EXTENT_FLAG_INUSE          0x01
    #define DMS_EXTENT_FLAG_FREED          0x02
+   // the payload is compressed as a block, see dmsBlockExtent.hpp
+   #define DMS_EXTENT_FLAG_COMPRESSED     0x04
    /*
       Version define
    */
@@ -105,7 +107,8 @@ namespace engine
       {
          if ( DMS_EXTENT_EYECATCHER0 != _eyeCatcher[0] ||
               DMS_EXTENT_EYECATCHER1 != _eyeCatcher[1] ||
-              DMS_EXTENT_FLAG_INUSE  != _flag )
+              DMS_EXTENT_FLAG_INUSE  !=
+              ( _flag & ~DMS_EXTENT_FLAG_COMPRESSED ) )
          {
             return FALSE ;
          }
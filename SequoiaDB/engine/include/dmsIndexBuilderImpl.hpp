@@ -72,6 +72,7 @@ namespace engine
       INT32 _init() ;
       INT32 _fillSorter() ;
       INT32 _insertKeys( const Ordering& ordering ) ;
+      INT32 _loadKeys( const Ordering& ordering ) ;
       INT32 _build() ;
 
    private:
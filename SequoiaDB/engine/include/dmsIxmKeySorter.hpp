@@ -50,6 +50,16 @@ namespace engine
          return ( key1.woCompare( key2, _order ) < 0 ) ;
       }
 
+      INT32 compare( const ixmKey& key1, const ixmKey& key2 ) const
+      {
+         return key1.woCompare( key2, _order ) ;
+      }
+
+      const bson::Ordering& getOrder() const
+      {
+         return _order ;
+      }
+
    private:
       bson::Ordering _order ;
    } ;
@@ -44,7 +44,7 @@
 #include "dms.hpp"
 #include "ossLatch.hpp"
 #include "ossRWMutex.hpp"
-#include <list>
+#include "ossAtomic.hpp"
 #include <vector>
 
 using namespace std ;
@@ -52,37 +52,45 @@ using namespace std ;
 namespace engine
 {
 
-   typedef UINT32 _dmsSegmentNode ; // high: start, low: size
+   typedef UINT64 _dmsSegmentWord ; // 1 bit for 1 page, set means free
 
-   #define DMS_SEGMENT_NODE_GETSTART(x)   ((UINT16)((x)>>16))
-   #define DMS_SEGMENT_NODE_GETSIZE(x)    ((UINT16)(0xFFFF&(x)))
-   #define DMS_SEGMENT_NODE_SETSTART(x,y) (x=(((UINT32)(y)<<16)|(0xFFFF&(x))))
-   #define DMS_SEGMENT_NODE_SETSIZE(x,y)  (x=(((UINT16)(y))|(0xFFFF0000&(x))))
-   #define DMS_SEGMENT_NODE_SET(x,y,z)    (x=(((UINT32)(y)<<16)|(0xFFFF&(z))))
+   #define DMS_SEGMENT_WORD_BITS          ( 64 )
+   #define DMS_SEGMENT_WORD_ALL           ( ~( (_dmsSegmentWord)0 ) )
+
+   // number of reserve position hints, reservers of different threads start
+   // from their own hint, so that they don't always collide on the first
+   // free segment
+   #define DMS_SME_HINT_NUM               ( 64 )
+   #define DMS_SME_CACHE_LINE_SIZE        ( 64 )
 
    class _dmsSMEMgr ;
    /*
       _dmsSegmentSpace : defined
+      The free pages of a segment are kept in a bitmap. Pages are reserved
+      by CAS on the bitmap words, so reservers of one segment don't block
+      each other
    */
    class _dmsSegmentSpace : public SDBObject
    {
    private :
-      list<_dmsSegmentNode>   _freeSpaceList ;
-      UINT16                  _maxNode ;
+      _dmsSegmentWord         *_bitmap ;
+      UINT32                  _wordNum ;
       dmsExtentID             _startExtent ;
       UINT16                  _totalSize ;
-      UINT16                  _totalFree ;
-
-      ossSpinXLatch           _mutex ;
+      ossAtomic32             _totalFree ;
       _dmsSMEMgr              *_pSMEMgr ;
 
-      void  _resetMax () ;
+      BOOLEAN _findFreeRange ( UINT16 numPages, UINT32 &relaStart ) const ;
+      BOOLEAN _claimRange ( UINT32 relaStart, UINT16 numPages ) ;
+      void    _unclaimRange ( UINT32 relaStart, UINT32 relaEnd ) ;
 
    public :
       explicit _dmsSegmentSpace ( dmsExtentID startExtent, UINT16 maxNode,
                                   _dmsSMEMgr *pSMEMgr ) ;
       ~_dmsSegmentSpace () ;
 
+      INT32 init () ;
+
       INT32 reservePages ( UINT16 numPages, dmsExtentID &foundPage,
                            UINT32 pos, ossAtomic32 *pFreePos ) ;
       INT32 releasePages ( dmsExtentID start, UINT16 numPages,
@@ -93,6 +101,16 @@ namespace engine
    } ;
    typedef class _dmsSegmentSpace dmsSegmentSpace ;
 
+   /*
+      _dmsSMEHint define
+   */
+   struct _dmsSMEHint
+   {
+      volatile UINT32   _pos ;
+      CHAR              _pad[ DMS_SME_CACHE_LINE_SIZE - sizeof( UINT32 ) ] ;
+   } ;
+   typedef struct _dmsSMEHint dmsSMEHint ;
+
    struct _dmsSpaceManagementExtent ;
    class  _dmsStorageBase ;
    /*
@@ -106,10 +124,15 @@ namespace engine
       vector<dmsSegmentSpace*>   _segments ;
       ossRWMutex                 _mutex ;
       UINT32                     _pageSize ;
+      UINT32                     _segmentPages ;
+      UINT32                     _segmentPagesSquare ;
       _dmsStorageBase            *_pStorageBase ;
       _dmsSpaceManagementExtent  *_pSME ;
       ossAtomic32                _totalFree ;
       ossAtomic32                _freePos ;
+      dmsSMEHint                 _hints[ DMS_SME_HINT_NUM ] ;
+
+      dmsSMEHint &_getHint () ;
 
    public :
       _dmsSMEMgr() ;
@@ -118,6 +141,12 @@ namespace engine
       INT32 init ( _dmsStorageBase *pStorageBase,
                    _dmsSpaceManagementExtent *pSME ) ;
 
+      /*
+         init without storage, pageNum pages of the SME are loaded
+      */
+      INT32 init ( UINT32 pageSize, UINT32 segmentPagesSquare,
+                   UINT32 pageNum, _dmsSpaceManagementExtent *pSME ) ;
+
       INT32 reservePages ( UINT16 numPages, dmsExtentID &foundPage,
                            UINT32 *pSegmentNum = NULL ) ;
 
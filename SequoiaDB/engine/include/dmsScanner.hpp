@@ -163,6 +163,24 @@ namespace engine
                                    _mthRecordGenerator &generator,
                                    _pmdEDUCB *cb,
                                    _mthMatchTreeContext *mhtContext = NULL) ;
+
+         void  _initColumnFilter() ;
+         INT32 _fillBatch( _pmdEDUCB *cb ) ;
+         INT32 _fetchNextBatch( dmsRecordID &recordID,
+                                _mthRecordGenerator &generator,
+                                _pmdEDUCB *cb,
+                                _mthMatchTreeContext *mhtContext ) ;
+
+      private:
+         // the records are filtered by batch when _columnFilter is not NULL
+         mthColumnFilter      _filter ;
+         mthColumnFilter      *_columnFilter ;
+         mthColumnBatch       _batch ;
+         dmsOffset            *_batchOffsets ;
+         // the data extracted by the batch, NULL when it must be read again
+         const CHAR           **_batchDatas ;
+         UINT32               _batchNum ;
+         UINT32               _batchPos ;
    } ;
    typedef _dmsExtScanner dmsExtScanner ;
 
@@ -181,6 +181,54 @@ namespace engine
          SDB_ASSERT( bitNum < DMS_MAX_PG, "Invalid bitNum" ) ;
          _smeMask[bitNum >> 3] |= ( 1 << (7 - (bitNum & 7))) ;
       }
+      /*
+         Thread safe versions, the pages of one byte may be reserved or
+         released by different threads at the same time
+      */
+      void setBitMaskRange( UINT32 bitStart, UINT32 bitNum )
+      {
+         _updateBitMaskRange( bitStart, bitNum, TRUE ) ;
+      }
+      void freeBitMaskRange( UINT32 bitStart, UINT32 bitNum )
+      {
+         _updateBitMaskRange( bitStart, bitNum, FALSE ) ;
+      }
+   private:
+      void _updateBitMaskRange( UINT32 bitStart, UINT32 bitNum,
+                                BOOLEAN isSet )
+      {
+         UINT32 bitEnd = bitStart + bitNum ;
+         SDB_ASSERT( bitEnd <= DMS_MAX_PG, "Invalid bitNum" ) ;
+         while ( bitStart < bitEnd )
+         {
+            UINT32 byteNum = bitStart >> 3 ;
+            UINT8 byteMask = 0 ;
+            union
+            {
+               UINT32   _word ;
+               UINT8    _bytes[ 4 ] ;
+            } wordMask ;
+
+            for ( ; bitStart < bitEnd && ( bitStart >> 3 ) == byteNum ;
+                  ++bitStart )
+            {
+               byteMask |= (UINT8)( 1 << ( 7 - ( bitStart & 7 ) ) ) ;
+            }
+
+            // the mask is mapped from the file at page boundary, so the
+            // aligned word holding the byte can be updated atomically
+            wordMask._word = 0 ;
+            wordMask._bytes[ byteNum & 3 ] = byteMask ;
+            if ( isSet )
+            {
+               ossFetchAndOR32( &_smeMask[ byteNum & ~3 ], wordMask._word ) ;
+            }
+            else
+            {
+               ossFetchAndAND32( &_smeMask[ byteNum & ~3 ], ~wordMask._word ) ;
+            }
+         }
+      }
    } ;
    typedef _dmsSpaceManagementExtent dmsSpaceManagementExtent ;
    #define DMS_SME_SZ  sizeof(dmsSpaceManagementExtent)
@@ -310,6 +358,9 @@ namespace engine
 
       protected:
          void           _markDirty() ;
+         // read the payload of the block extent by the cache of the EDU
+         const CHAR*    _readBlock( UINT32 offset, UINT32 len ) ;
+         void           _raiseError( INT32 rc, const CHAR *pDesc ) ;
 
       private:
          INT32                _extentID ;
@@ -428,6 +479,37 @@ namespace engine
                                                       UINT32 pageNum ) ;
          OSS_INLINE void        endFixedAddr( const ossValuePtr ptr ) ;
 
+         /*
+            Read ahead the pages from extentID in the background, stop at
+            the end of the segment. Return the number of pages advised
+         */
+         OSS_INLINE UINT32      readAhead( dmsExtentID extentID,
+                                           UINT32 pageNum ) ;
+
+         /*
+            Give back the disk space of the pages from the page offset of
+            the extent, or allocate it again. They are used by the extents
+            compressed as blocks, see dmsBlockExtent.hpp
+         */
+         INT32                  releasePages( dmsExtentID extentID,
+                                              UINT32 pageOffset,
+                                              UINT32 pageNum ) ;
+         INT32                  reservePages( dmsExtentID extentID,
+                                              UINT32 pageOffset,
+                                              UINT32 pageNum ) ;
+         // decompress the block extent in place, the caller holds it
+         // exclusive
+         INT32                  unsealExtent( dmsExtentID extentID ) ;
+
+         OSS_INLINE BOOLEAN     hasBlockExtent() const
+         {
+            return _hasBlockExtent ;
+         }
+         void                   enableBlockExtent()
+         {
+            _hasBlockExtent = TRUE ;
+         }
+
          OSS_INLINE void        markAllDirty( DMS_CHG_STEP step ) ;
          OSS_INLINE void        markDirty( INT32 collectionID,
                                            INT32 extentID,
@@ -590,6 +672,7 @@ namespace engine
          CHAR                          _fullPathName[ OSS_MAX_PATHSIZE + 1 ] ;
          BOOLEAN                       _isTempSU ;
          BOOLEAN                       _blockScanSupport ;
+         BOOLEAN                       _hasBlockExtent ;
    } ;
    typedef _dmsStorageBase dmsStorageBase ;
 
@@ -731,6 +814,33 @@ namespace engine
    OSS_INLINE void _dmsStorageBase::endFixedAddr( const ossValuePtr ptr )
    {
    }
+   OSS_INLINE UINT32 _dmsStorageBase::readAhead( dmsExtentID extentID,
+                                                 UINT32 pageNum )
+   {
+      UINT32 segOffset = 0 ;
+      UINT32 advised = 0 ;
+      UINT32 segID = 0 ;
+
+      if ( DMS_INVALID_EXTENT == extentID || 0 == pageNum )
+      {
+         return 0 ;
+      }
+      segID = extent2Segment( extentID, &segOffset ) ;
+      if ( segID > (UINT32)_maxSegID )
+      {
+         return 0 ;
+      }
+      if ( pageNum > _segmentPages - segOffset )
+      {
+         pageNum = _segmentPages - segOffset ;
+      }
+      if ( SDB_OK != willNeed( segID, segOffset << _pageSizeSquare,
+                               pageNum << _pageSizeSquare, &advised ) )
+      {
+         return 0 ;
+      }
+      return advised >> _pageSizeSquare ;
+   }
    OSS_INLINE void _dmsStorageBase::markAllDirty( DMS_CHG_STEP step )
    {
       _markHeaderInvalid( -1, TRUE ) ;
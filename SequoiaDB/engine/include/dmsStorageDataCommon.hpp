@@ -87,6 +87,11 @@ namespace engine
 
 #pragma pack()
 
+   // the max size of a block loaded by bulk load
+   #define DMS_LOAD_BLOCK_MAX_SZ                   DMS_RECORD_USER_MAX_SZ
+   // the size of an empty bson
+   #define DMS_LOAD_RECORD_MIN_SZ                  5
+
    /*
       MB FLAG(_flag) values :
    */
@@ -187,6 +192,8 @@ namespace engine
    #define DMS_MB_ATTR_NOIDINDEX          0x00000002
    #define DMS_MB_ATTR_CAPPED             0x00000004
    #define DMS_MB_ATTR_STRICTDATAMODE     0x00000008
+   // the full extents are compressed as blocks in the background
+   #define DMS_MB_ATTR_BLOCKCOMPRESSED    0x00000010
 
 #pragma pack(4)
    /*
@@ -458,6 +465,9 @@ namespace engine
       UINT64      _lobLastWriteTick ;
       BOOLEAN     _lobIsCrash ;
 
+      // the newest extent checked by the sealing, see sealExtents
+      dmsExtentID _sealedExtentID ;
+
       void reset()
       {
          _totalRecords           = 0 ;
@@ -486,6 +496,7 @@ namespace engine
          _lobLastLSN.init( ~0 ) ;
          _lobLastWriteTick       = 0 ;
          _lobIsCrash             = FALSE ;
+         _sealedExtentID         = DMS_INVALID_EXTENT ;
       }
 
       void updateLastLSN( UINT64 lsn, DMS_FILE_TYPE type )
@@ -819,6 +830,13 @@ namespace engine
 
          OSS_INLINE UINT32 getCollectionNum() ;
 
+         /*
+            The segment( from the data start segment ) of the extent or the
+            logical extent, only valid when block scan is supported
+         */
+         OSS_INLINE UINT32 extent2LogicSeg( dmsExtentID extentID ) ;
+         OSS_INLINE UINT32 extLID2LogicSeg( dmsExtentID extLID ) const ;
+
          OSS_INLINE dmsRecordRW record2RW( const dmsRecordID &record,
                                            UINT16 collectionID ) ;
 
@@ -891,6 +909,18 @@ namespace engine
                               BOOLEAN canUnLock = TRUE,
                               INT64 position = -1 ) ;
 
+         /*
+            Load a block of records, which are aligned by 4 bytes and must
+            have _id. The records are inserted as a whole and logged by
+            one log record, the keys are inserted in order after the data
+         */
+         INT32 loadRecords ( dmsMBContext *context,
+                             const CHAR *pBlock,
+                             UINT32 blockSize,
+                             UINT32 recordNum,
+                             _pmdEDUCB *cb,
+                             SDB_DPSCB *dpscb ) ;
+
          INT32 deleteRecord ( dmsMBContext *context,
                               const dmsRecordID &recordID,
                               ossValuePtr deletedDataPtr,
@@ -922,6 +952,14 @@ namespace engine
                             const CHAR *dict, UINT32 dictLen ) ;
          OSS_INLINE _dmsCompressorEntry *getCompressorEntry( UINT16 mbID ) ;
 
+         /*
+            Compress the full extents before the last one of the block
+            compressed collection in place, see dmsBlockExtent.hpp. The
+            context must not be locked
+         */
+         INT32 sealExtents( dmsMBContext *context, _pmdEDUCB *cb,
+                            UINT32 &sealedNum ) ;
+
          /*
             Caller must hold the mbContext
          */
@@ -1083,6 +1121,21 @@ namespace engine
 
          INT32          _truncateCollectionLoads( dmsMBContext *context ) ;
 
+         /*
+            Take the deleted records in the extent out of the delete list,
+            the space is given up when the extent is sealed. With testOnly,
+            nothing is changed, spaceSize is the space which can be taken
+         */
+         INT32          _unlinkSealSpace( dmsMBContext *context,
+                                          _pmdEDUCB *cb,
+                                          dmsExtentID extentID,
+                                          BOOLEAN testOnly,
+                                          UINT32 &spaceSize ) ;
+         INT32          _sealExtent( dmsMBContext *context,
+                                     _pmdEDUCB *cb,
+                                     dmsExtentID extentID,
+                                     BOOLEAN &sealed ) ;
+
          /*
             Caller must hold the mbContext
          */
@@ -1333,6 +1386,18 @@ namespace engine
       return 16 + 14 - pageSizeSquareRoot() ;
    }
 
+   OSS_INLINE UINT32 _dmsStorageDataCommon::extent2LogicSeg(
+                                            dmsExtentID extentID )
+   {
+      return extent2Segment( extentID ) - dataStartSegID() ;
+   }
+
+   OSS_INLINE UINT32 _dmsStorageDataCommon::extLID2LogicSeg(
+                                            dmsExtentID extLID ) const
+   {
+      return (UINT32)extLID >> _getFactor() ;
+   }
+
    /*
       Tool Functions
    */
@@ -59,6 +59,20 @@ namespace engine
    #define DMS_INDEXSU_EYECATCHER         "SDBIDX"
    #define DMS_INDEXSU_CUR_VERSION        1
 
+   /*
+      _dmsLoadRecord define
+      A record inserted by bulk load, the keys of the records are inserted
+      after all the records of the block are inserted
+   */
+   struct _dmsLoadRecord
+   {
+      BSONObj        _obj ;
+      dmsRecordID    _rid ;
+      dmsExtentID    _extLID ;
+   } ;
+   typedef _dmsLoadRecord dmsLoadRecord ;
+   typedef std::vector< dmsLoadRecord >   DMS_LOAD_RECORDS ;
+
    /*
       _dmsStorageIndex defined
    */
@@ -107,6 +121,15 @@ namespace engine
                                   BSONObj &inputObj, const dmsRecordID &rid,
                                   _pmdEDUCB *cb ) ;
 
+         /*
+            Insert the keys of the loaded records, the keys of an index are
+            sorted before inserted, so that the leaves are filled in order
+            instead of being split randomly
+         */
+         INT32    indexesInsertSorted ( _dmsMBContext *context,
+                                        const DMS_LOAD_RECORDS &records,
+                                        _pmdEDUCB *cb ) ;
+
          INT32    indexesUpdate ( _dmsMBContext *context, dmsExtentID extLID,
                                   BSONObj &originalObj, BSONObj &newObj,
                                   const dmsRecordID &rid, _pmdEDUCB *cb,
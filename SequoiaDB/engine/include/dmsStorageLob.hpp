@@ -67,6 +67,24 @@ namespace engine
 
    #define DMS_BME_SZ (sizeof( dmsBucketsManagementExtent ))
 
+   /*
+      _dmsLobReadPiece define
+      A piece of the batched read, the data is copied to _pBuf
+   */
+   struct _dmsLobReadPiece
+   {
+      dmsLobRecord      _record ;
+      CHAR              *_pBuf ;
+
+      _dmsLobReadPiece( const dmsLobRecord &record, CHAR *pBuf )
+      :_record( record ),
+       _pBuf( pBuf )
+      {
+      }
+   } ;
+   typedef struct _dmsLobReadPiece dmsLobReadPiece ;
+   typedef std::vector< dmsLobReadPiece >    DMS_LOB_READ_PIECES ;
+
 
    class _pmdEDUCB ;
 
@@ -139,6 +157,16 @@ namespace engine
                   CHAR *buf,
                   UINT32 &len ) ;
 
+      /*
+         Read the pieces of a lob in one batch. The pages are located in
+         one pass under the mb lock, the pieces in the cache are read from
+         the cache, and the others are submitted to the lob data file
+         together.
+      */
+      INT32 readv( const DMS_LOB_READ_PIECES &pieces,
+                   dmsMBContext *mbContext,
+                   _pmdEDUCB *cb ) ;
+
       INT32 readPage( DMS_LOB_PAGEID &pos,
                       BOOLEAN onlyMetaPage,
                       _pmdEDUCB *cb,
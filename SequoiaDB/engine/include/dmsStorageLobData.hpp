@@ -36,10 +36,13 @@
 
 #include "dmsLobDef.hpp"
 #include "ossIO.hpp"
+#include "ossLatch.hpp"
 #include "dmsStorageBase.hpp"
 #include "pmdEDU.hpp"
 #include "utilCache.hpp"
 
+#include <vector>
+
 namespace engine
 {
    #define DMS_LOBD_FLAG_NULL       0x00000000
@@ -49,6 +52,42 @@ namespace engine
    #define DMS_LOBD_EYECATCHER            "SDBLOBD"
    #define DMS_LOBD_EYECATCHER_LEN        8
 
+   // the batched read bypasses the page cache when it's not less than this
+   #define DMS_LOBD_DIRECT_READ_MIN       ( 1024 * 1024 )
+   // the max length of the continuous ranges read together
+   #define DMS_LOBD_READ_RUN_MAX          ( 8 * 1024 * 1024 )
+
+   /*
+      _dmsLobReadReq define
+      A range of a page in the batched read, the data is copied to _pBuf
+   */
+   struct _dmsLobReadReq
+   {
+      INT32       _pageID ;
+      UINT32      _offset ;
+      UINT32      _len ;
+      CHAR        *_pBuf ;
+
+      _dmsLobReadReq( INT32 pageID, UINT32 offset, UINT32 len, CHAR *pBuf )
+      :_pageID( pageID ),
+       _offset( offset ),
+       _len( len ),
+       _pBuf( pBuf )
+      {
+      }
+
+      bool operator< ( const _dmsLobReadReq &rhs ) const
+      {
+         if ( _pageID != rhs._pageID )
+         {
+            return _pageID < rhs._pageID ;
+         }
+         return _offset < rhs._offset ;
+      }
+   } ;
+   typedef struct _dmsLobReadReq dmsLobReadReq ;
+   typedef std::vector< dmsLobReadReq >      DMS_LOB_READ_REQS ;
+
    /*
       _dmsStorageLobData define
    */
@@ -109,6 +148,14 @@ namespace engine
                               IExecutor *cb,
                               BOOLEAN isAligned ) ;
 
+      /*
+         Read the ranges in one batch. The ranges are sorted by the position
+         in file, and the ranges which are continuous both in file and in
+         buffer are read by one call. A big batch is read with direct io,
+         so that it doesn't evict the other data from the page cache.
+      */
+      INT32  readv( DMS_LOB_READ_REQS &reqs, IExecutor *cb ) ;
+
    public:
       OSS_INLINE INT64 getFileSz() const
       {
@@ -212,10 +259,19 @@ namespace engine
 
       INT32 _postOpen( INT32 cause ) ;
 
+      OSSFILE* _getDirectFile() ;
+
+      INT32 _readRun( OSSFILE *pFile, BOOLEAN isDirect,
+                      const dmsLobReadReq &req, UINT32 len,
+                      IExecutor *cb ) ;
+
    private:
       std::string       _fileName ;
       CHAR              _fullPath[ OSS_MAX_PATHSIZE + 1 ] ;
       OSSFILE           _file ;
+      // opened with direct io for the big batched read
+      OSSFILE           _directFile ;
+      ossSpinXLatch     _directLatch ;
       INT64             _fileSz ;
       UINT32            _pageSz ;
       UINT32            _logarithmic ;
@@ -80,6 +80,12 @@ namespace engine
       DPS_LOG_POP_DIRECTION = 2
    } ;
 
+   enum DPS_LOG_LOAD
+   {
+      DPS_LOG_LOAD_BLOCK = 1,
+      DPS_LOG_LOAD_NUM = 2
+   } ;
+
    enum DPS_LOG_CSCRT
    {
       DPS_LOG_CSCRT_CSNAME = 1,
@@ -101,6 +101,22 @@ namespace engine
                         INT64 &logicalID,
                         INT8 &direction ) ;
 
+   /*
+      The block is the records loaded together, one bson after another
+      and each is aligned by 4 bytes
+   */
+   INT32 dpsLoad2Record( const CHAR *fullName,
+                         const CHAR *pBlock,
+                         const UINT32 &blockSize,
+                         const UINT32 &recordNum,
+                         dpsLogRecord &record ) ;
+
+   INT32 dpsRecord2Load( const CHAR *logRecord,
+                         const CHAR **fullName,
+                         const CHAR **pBlock,
+                         UINT32 &blockSize,
+                         UINT32 &recordNum ) ;
+
    INT32 dpsCSCrt2Record( const CHAR *csName,
                           const INT32 &pageSize,
                           const INT32 &lobPageSize,
@@ -47,6 +47,7 @@
 #include "dpsLogFileMgr.hpp"
 #include "ossUtil.hpp"
 #include "ossEvent.hpp"
+#include "ossCondition.hpp"
 #include "ossQueue.hpp"
 
 #include <vector>
@@ -77,6 +78,7 @@ namespace engine
       DPS_LSN                    _lsn;
       DPS_LSN                    _currentLsn;
       DPS_LSN                    _lastCommitted ;
+      DPS_LSN                    _lastSynced ;
       UINT32                     _totalSize;
       UINT32                     _work;
       UINT32                     _begin ;
@@ -86,6 +88,20 @@ namespace engine
       ossAutoEvent               _allocateEvent ;
       _ossAtomic32               _queSize ;
 
+      /*
+         Group commit in two stages. A flush leader flushes the work page
+         for all the committers arrived before it starts, then a sync
+         leader syncs the files out of _writeMutex, while the next flush
+         and the merges go on. The others wait for the generations.
+      */
+      _ossConditionMutex         _commitMutex ;
+      _ossCondition              _commitCond ;
+      UINT64                     _commitBeginGen ;
+      UINT64                     _commitEndGen ;
+      UINT64                     _syncEndGen ;
+      BOOLEAN                    _flushing ;
+      BOOLEAN                    _syncing ;
+
       dpsTransCB                 *_transCB ;
       vector< dpsEventHandler* > _vecEventHandler ;
       BOOLEAN                    _incVersion ;
@@ -258,6 +274,8 @@ namespace engine
                        UINT32 &offset );
       INT32 _flushPage( _dpsLogPage *page, BOOLEAN shutdown = FALSE );
       INT32 _flushAll() ;
+      INT32 _commitFlush() ;
+      INT32 _commitSync() ;
       INT32 _search ( const DPS_LSN &lsn, _dpsMessageBlock *mb,
                       BOOLEAN onlyHeader,
                       UINT32 *pLength = NULL ) ;
@@ -195,6 +195,8 @@ namespace engine
       BOOLEAN hasWait( UINT32 logicCSID, UINT16 collectionID,
                        const dmsRecordID *recordID);
 
+      void dumpLockStat( bson::BSONObjBuilder &ob ) ;
+
       INT32 reservedLogSpace( UINT32 length, _pmdEDUCB *cb ) ;
 
       void releaseLogSpace( UINT32 length, _pmdEDUCB *cb );
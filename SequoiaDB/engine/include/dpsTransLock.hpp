@@ -50,7 +50,43 @@ namespace engine
    class dpsLockBucket;
 
 
-   #define MAX_LOCKBUCKET_NUM             ( 1000 )
+   #define MAX_LOCKBUCKET_NUM             ( 1024 )
+   #define DPS_INTENT_SLOT_NUM            ( 1024 )
+   #define DPS_INTENT_HOLDER_MASK         ( 0xFFFFLL )
+
+   /*
+      dpsIntentSlot define
+
+      Fast path of IS/IX locks on collection space and collection. _value
+      holds the lock-id ( high 48 bits ) which the slot serves and the number
+      of its fast holders ( low 16 bits ). _strongNum is the number of S/X
+      locks requested or held on the lock-ids hashed to the slot, the fast
+      path of the slot is closed while it's not zero.
+   */
+   struct dpsIntentSlot
+   {
+      volatile SINT64   _value ;
+      volatile INT32    _strongNum ;
+      CHAR              _pad[ DPS_LOCK_CACHE_LINE_SIZE - sizeof( SINT64 ) -
+                              sizeof( INT32 ) ] ;
+
+      static SINT64 tagOf( const dpsTransLockId &lockId )
+      {
+         return (SINT64)( ( ( (UINT64)lockId._logicCSID << 16 ) |
+                            lockId._collectionID ) << 16 ) ;
+      }
+
+      // the number of fast holders of the lock-id
+      UINT32 holderNum( const dpsTransLockId &lockId )
+      {
+         SINT64 value = ossAtomicPeek64( &_value ) ;
+         if ( ( value & ~DPS_INTENT_HOLDER_MASK ) != tagOf( lockId ) )
+         {
+            return 0 ;
+         }
+         return (UINT32)( value & DPS_INTENT_HOLDER_MASK ) ;
+      }
+   } ;
 
    /*
       dpsTransLock define
@@ -97,6 +133,8 @@ namespace engine
 
       BOOLEAN hasWait( const dpsTransLockId &lockId );
 
+      void dumpStat( bson::BSONObjBuilder &ob );
+
 
    private:
       INT32 upgrade( _pmdEDUCB *eduCB,
@@ -127,9 +165,35 @@ namespace engine
                                     dpsTransCBLockInfo *pLockInfo,
                                     DPS_TRANSLOCK_TYPE lockType ) ;
 
+      void releaseLock( _pmdEDUCB *eduCB, const dpsTransLockId &lockId,
+                        dpsTransCBLockInfo *pLockInfo );
+
+      BOOLEAN isIntentLockId( const dpsTransLockId &lockId );
+
+      dpsIntentSlot *getIntentSlot( const dpsTransLockId &lockId );
+
+      UINT32 fastHolderNum( dpsIntentSlot *pSlot,
+                            const dpsTransLockId &lockId );
+
+      INT32 tryFastIntent( _pmdEDUCB *eduCB, const dpsTransLockId &lockId,
+                           DPS_TRANSLOCK_TYPE lockType, BOOLEAN &granted );
+
+      void releaseFastIntent( const dpsTransLockId &lockId );
+
+      INT32 enterStrong( _pmdEDUCB *eduCB, const dpsTransLockId &lockId,
+                         dpsTransCBLockInfo *pLockInfo, BOOLEAN canWait,
+                         BOOLEAN &entered );
+
+      void leaveStrong( const dpsTransLockId &lockId );
+
+      INT32 testStrong( _pmdEDUCB *eduCB, const dpsTransLockId &lockId,
+                        dpsTransCBLockInfo *pLockInfo );
+
    private:
       LockBucketLst           _bucketLst;
       ossSpinXLatch           _LstMutex;
+      CHAR                    _padHead[ DPS_LOCK_CACHE_LINE_SIZE ] ;
+      dpsIntentSlot           _intentSlots[ DPS_INTENT_SLOT_NUM ] ;
 
    } ;
 
@@ -46,8 +46,28 @@
 namespace engine
 {
    class dpsTransLockUnit;
+   struct dpsIntentSlot;
    typedef std::map< dpsTransLockId, dpsTransLockUnit * > dpsTransLockUnitList;
 
+   /*
+      dpsLockBucketStat define
+   */
+   struct dpsLockBucketStat
+   {
+      UINT32         _holdNum ;     // current lock holders
+      UINT32         _waitNum ;     // current lock waiters
+      UINT64         _acquireNum ;  // total granted locks
+      UINT64         _waitTimes ;   // total times of waiting for lock
+
+      dpsLockBucketStat()
+      {
+         _holdNum = 0 ;
+         _waitNum = 0 ;
+         _acquireNum = 0 ;
+         _waitTimes = 0 ;
+      }
+   } ;
+
    /*
       dpsLockBucket define
    */
@@ -57,14 +77,21 @@ namespace engine
       friend class dpsTransLock;
 
       static void setLockTimeout( UINT32 timeout ) { _lockTimeout = timeout ; }
+      static UINT32 getLockTimeout() { return _lockTimeout ; }
+
+      void getStat( dpsLockBucketStat &stat ) const { stat = _stat ; }
 
    protected:
       dpsLockBucket();
       ~dpsLockBucket();
+      // pSlot is the intent-slot of the lock-id for S/X on intent lock-id,
+      // the lock isn't granted until the fast holders in the slot drain
       INT32 acquire( _pmdEDUCB *eduCB, const dpsTransLockId &lockId,
-                     DPS_TRANSLOCK_TYPE lockType );
+                     DPS_TRANSLOCK_TYPE lockType,
+                     dpsIntentSlot *pSlot = NULL );
       INT32 upgrade( _pmdEDUCB *eduCB, const dpsTransLockId &lockId,
-                     DPS_TRANSLOCK_TYPE lockType );
+                     DPS_TRANSLOCK_TYPE lockType,
+                     dpsIntentSlot *pSlot = NULL );
       void release( _pmdEDUCB *eduCB, const dpsTransLockId &lockId );
 
       INT32 test( _pmdEDUCB *eduCB, const dpsTransLockId &lockId,
@@ -80,6 +107,8 @@ namespace engine
 
       BOOLEAN hasWait( const dpsTransLockId &lockId );
 
+      void wakeUpWait( const dpsTransLockId &lockId );
+
       INT32 waitLockX( _pmdEDUCB *eduCB, const dpsTransLockId &lockId );
 
 
@@ -87,6 +116,11 @@ namespace engine
       INT32 appendToRun( _pmdEDUCB *eduCB, DPS_TRANSLOCK_TYPE lockType,
                          dpsTransLockUnit *pLockUnit );
 
+      INT32 appendToRun( _pmdEDUCB *eduCB, const dpsTransLockId &lockId,
+                         DPS_TRANSLOCK_TYPE lockType,
+                         dpsTransLockUnit *pLockUnit,
+                         dpsIntentSlot *pSlot );
+
       void appendToWait( _pmdEDUCB *eduCB, const dpsTransLockId &lockId,
                          dpsTransLockUnit *pLockUnit );
 
@@ -113,8 +147,13 @@ namespace engine
 
 
    private:
-      dpsTransLockUnitList       _lockLst;
+      // buckets are allocated separately, pad both sides so that the latch
+      // and the counters don't share cache line with other objects
+      CHAR                       _padHead[ DPS_LOCK_CACHE_LINE_SIZE ] ;
       ossSpinXLatch              _lstMutex;
+      dpsLockBucketStat          _stat ;
+      dpsTransLockUnitList       _lockLst;
+      CHAR                       _padTail[ DPS_LOCK_CACHE_LINE_SIZE ] ;
       static ossSpinXLatch       _initMutex;
       static UINT32              _lockTimeout;  // The variable is shared by all lock-buckets
    };
@@ -51,6 +51,8 @@ namespace engine
 {
    class _pmdEDUCB;
 
+   #define DPS_LOCK_CACHE_LINE_SIZE       ( 64 )
+
    enum DPS_TRANSLOCK_TYPE
    {
       DPS_TRANSLOCK_IS = 0,
@@ -108,9 +110,14 @@ namespace engine
       void setType( DPS_TRANSLOCK_TYPE lockType );
       _pmdEDUCB *getNextWaitCB();
       void setNextWaitCB( _pmdEDUCB *pWaitCB );
+      // the intent lock is granted by the fast path of dpsTransLock,
+      // it's not queued in any lock-bucket
+      BOOLEAN isFast() const { return _isFast ; }
+      void setFast( BOOLEAN isFast ) { _isFast = isFast ; }
    private:
       _pmdEDUCB                  *_pNextWaitCB ;
       DPS_TRANSLOCK_TYPE         _lockType ;
+      BOOLEAN                    _isFast ;
       ossAtomicSigned64          *_pRef;
    };
 
@@ -596,6 +596,15 @@ namespace engine
          return _infoObj[ IXM_ENFORCED_FIELD ].trueValue() ;
       }
 
+      // the pages of the index keep the normalized keys for byte compares,
+      // only set when the index is created
+      BOOLEAN normalizedKey() const
+      {
+         SDB_ASSERT ( _isInitialized,
+                      "index details must be initialized first" ) ;
+         return _infoObj[ IXM_NORMALIZED_KEY_FIELD ].trueValue() ;
+      }
+
       /** return true if dropDups was set when building index (if any
         * duplicates, dropdups drops the duplicating objects) */
       BOOLEAN dropDups() const
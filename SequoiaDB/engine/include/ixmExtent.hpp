@@ -64,7 +64,9 @@ namespace engine
       dmsExtentID _left ;
       dmsRecordID _rid ;
       UINT16      _keyOffset ;
-      UINT16      _pad ;
+      // the 2 normalized bytes after the page prefix in V1 pages, unused
+      // in V0 pages
+      UINT16      _normSlice ;
 
       UINT16 keyDataOffset () const
       {
@@ -103,8 +105,32 @@ namespace engine
       IXM EXTENT HEAD VERSION DEFINE
    */
    #define IXM_EXTENT_VERSION_V0       0
+   #define IXM_EXTENT_VERSION_V1       1
    #define IXM_EXTENT_CURRENT_V        IXM_EXTENT_VERSION_V0
 
+   /*
+      IXM EXTENT NORMALIZED KEY DEFINE
+
+      V1 pages are used by the indexes created with normalizedKey. The keys
+      are still stored in compact format, besides them the page keeps the
+      normalized form ( see ixmKey::normalize ) prefix-compressed:
+      - the byte before the compact flag at the end of the page is the
+        length of the normalized prefix shared by all the keys of the page,
+        the prefix bytes are taken from any key of the page
+      - _normSlice of each key node is the 2 normalized bytes after the
+        prefix, zero padded
+      So the page search compares the search key by memcmp against the
+      prefix once, then by the slices, and only calls woCompare when the
+      slices are equal. The length is IXM_EXTENT_NORM_PREFIX_NONE once a
+      key which can't be normalized is in the page, byte compares are off
+      for the page until it's empty again.
+   */
+   #define IXM_EXTENT_NORM_PREFIX_MAX  ( 253 )
+   #define IXM_EXTENT_NORM_PREFIX_NONE ( 0xFF )
+   #define IXM_EXTENT_NORM_SLICE_SIZE  ( 2 )
+   #define IXM_EXTENT_NORM_BUF_SIZE    ( IXM_EXTENT_NORM_PREFIX_MAX + \
+                                         IXM_EXTENT_NORM_SLICE_SIZE )
+
    /*
       _ixmExtentHead define
    */
@@ -122,11 +148,28 @@ namespace engine
    } ;
    typedef struct _ixmExtentHead ixmExtentHead ;
 
+   /*
+      _ixmNormSearchKey define
+
+      A search key normalized against the prefix of one V1 page
+   */
+   struct _ixmNormSearchKey : public SDBObject
+   {
+      // the order of the search key against all the keys of the page, 0 if
+      // the prefix doesn't decide it
+      INT32       _result ;
+      BOOLEAN     _hasSlice ;
+      UINT16      _slice ;
+   } ;
+   typedef struct _ixmNormSearchKey ixmNormSearchKey ;
+
    /*
       _ixmExtent define
    */
    class _ixmExtent : public SDBObject
    {
+      friend class _ixmBulkLoader ;
+
    protected:
       const ixmExtentHead  *_extentHead ;
       dmsExtentID          _me ;
@@ -136,6 +179,26 @@ namespace engine
 
       dmsExtRW             _extRW ;
 
+      OSS_INLINE UINT16 _keyDataEnd () const
+      {
+         // V1 pages keep the normalized prefix length before the compact
+         // flag
+         return isNormalized() ? _pageSize - 2 : _pageSize - 1 ;
+      }
+      OSS_INLINE UINT8 _normPrefixLen () const
+      {
+         return ((const UINT8*)_extentHead)[ _pageSize - 2 ] ;
+      }
+      void  _setNormPrefixLen ( UINT8 prefixLen ) ;
+      void  _normKeyAdded ( UINT16 pos, const ixmKey &key,
+                            const Ordering &order ) ;
+      void  _normReset ( UINT8 prefixLen, const Ordering &order ) ;
+      void  _normSearchKey ( const ixmKey &key, const Ordering &order,
+                             ixmNormSearchKey &normKey ) const ;
+      INT32 _keyCompare ( const ixmKey &key, const Ordering &order,
+                          const ixmNormSearchKey &normKey,
+                          UINT16 pos ) const ;
+
       INT32 _reorg (const Ordering &order, UINT16 &newPos) ;
       INT32 _reorg (const Ordering &order) ;
       INT32 _alloc ( INT32 requestSpace, UINT16 &beginOffset ) ;
@@ -165,6 +228,8 @@ namespace engine
       INT32 _pushBack ( const dmsRecordID &rid, const ixmKey &key,
                         const Ordering &order, const dmsExtentID left ) ;
 
+      INT32 _popBack () ;
+
       INT32 _fixParentPtrs ( UINT16 startPos, UINT16 stopPos ) const ;
 
       void  _assignRight ( const dmsExtentID right ) ;
@@ -211,12 +276,17 @@ namespace engine
                        dmsExtentID &resultExtent, _pmdEDUCB *cb ) const ;
    public:
       _ixmExtent ( dmsExtentID extentID, UINT16 mbID,
-                   _dmsStorageIndex *pIndexSu );
+                   _dmsStorageIndex *pIndexSu,
+                   BOOLEAN normalized = FALSE );
 
       _ixmExtent ( dmsExtentID extentID,
                    _dmsStorageIndex *pIndexSu ) ;
 
       BOOLEAN verify() const ;
+      OSS_INLINE BOOLEAN isNormalized () const
+      {
+         return IXM_EXTENT_VERSION_V1 == _extentHead->_version ;
+      }
       OSS_INLINE UINT16 getNumKeyNode () const
       {
          return _extentHead->_totalKeyNodeNum ;
@@ -268,7 +338,7 @@ namespace engine
       }
       OSS_INLINE UINT16 getTotalKeySize() const
       {
-         return (UINT16)(_pageSize-1) - _extentHead->_totalFreeSize -
+         return _keyDataEnd() - _extentHead->_totalFreeSize -
                 (sizeof(ixmExtentHead) +
                  _extentHead->_totalKeyNodeNum * sizeof(ixmKeyNode)) ;
       }
@@ -383,6 +453,58 @@ namespace engine
       INT32 dumpIndexExtentIntoLog() const ;
    } ;
    typedef class _ixmExtent ixmExtent ;
+
+   #define IXM_BULK_MAX_LEVEL             ( 32 )
+   #define IXM_BULK_MIN_FILL_FACTOR       ( 50 )
+   #define IXM_BULK_MAX_FILL_FACTOR       ( 100 )
+
+   /*
+      _ixmBulkLoader define
+
+      Build the b-tree of an empty index bottom-up from keys in ascending
+      ( key, rid ) order. Every page is filled up to the fill factor, then
+      its last key is promoted to the upper level, so the inner levels are
+      built along with the leaves and no page is ever split.
+   */
+   class _ixmBulkLoader : public SDBObject
+   {
+   public:
+      _ixmBulkLoader ( ixmIndexCB *indexCB, _dmsStorageIndex *pIndexSu,
+                       const Ordering &order, UINT32 fillFactor ) ;
+      ~_ixmBulkLoader () ;
+
+      // the root of the index must be empty
+      INT32 init () ;
+      INT32 append ( const ixmKey &key, const dmsRecordID &rid ) ;
+      // link the right-most pages of all levels and set the new root, must
+      // be called even if append failed, so that all the pages are in the
+      // tree and can be truncated
+      INT32 finish () ;
+
+      OSS_INLINE UINT64 keyNum () const
+      {
+         return _keyNum ;
+      }
+
+      static BOOLEAN isIndexEmpty ( ixmIndexCB *indexCB,
+                                    _dmsStorageIndex *pIndexSu ) ;
+
+   private:
+      INT32 _append ( UINT32 level, const dmsRecordID &rid,
+                      const ixmKey &key, dmsExtentID left ) ;
+      INT32 _newExtent ( UINT32 level ) ;
+
+   private:
+      ixmIndexCB           *_indexCB ;
+      _dmsStorageIndex     *_pIndexSu ;
+      Ordering             _order ;
+      UINT32               _fillSize ;
+      UINT32               _levelNum ;
+      dmsExtentID          _levels[ IXM_BULK_MAX_LEVEL ] ;
+      UINT64               _keyNum ;
+      BOOLEAN              _finished ;
+   } ;
+   typedef class _ixmBulkLoader ixmBulkLoader ;
 }
 
 #endif //IXMEXTENT_HPP_
@@ -49,6 +49,7 @@ using namespace bson ;
 using namespace std ;
 namespace engine
 {
+   #define IXM_KEY_NORM_PREFIX_SIZE       ( 8 )
 
    class _ixmKey : public SDBObject
    {
@@ -95,6 +96,28 @@ namespace engine
 
       BOOLEAN isUndefined() const ;
 
+      /*
+         The normalized form is used by the index key sorter, the merge of
+         the sub contexts and the V1 index pages ( see ixmExtent.hpp ).
+         The keys themselves are always stored in compact format.
+
+         Write the memcmp-comparable form of the key into pBuf: comparing the
+         normalized bytes of two keys by memcmp gives the same order as
+         woCompare with the same ordering. At most bufSize bytes are written,
+         and the full length is returned. Keys in BSON format can't be
+         normalized, FALSE is returned for them.
+      */
+      BOOLEAN normalize ( const Ordering &o, UINT8 *pBuf, UINT32 bufSize,
+                          UINT32 &length ) const ;
+
+      /*
+         The first IXM_KEY_NORM_PREFIX_SIZE normalized bytes as a big-endian
+         integer, 0 is returned for keys in BSON format. If the prefixes of
+         two keys are both non-zero and different, they are in the same
+         order as the keys, otherwise woCompare is needed.
+      */
+      UINT64 normalizedPrefix ( const Ordering &o ) const ;
+
       OSS_INLINE const CHAR *data() const
       {
          return (const CHAR *) _keyData ;
@@ -51,6 +51,7 @@ using namespace bson ;
 #define IXM_ENFORCED_FIELD          IXM_FIELD_NAME_ENFORCED
 #define IXM_DROPDUP_FIELD           IXM_FIELD_NAME_DROPDUPS
 #define IXM_2DRANGE_FIELD           IXM_FIELD_NAME_2DRANGE
+#define IXM_NORMALIZED_KEY_FIELD    IXM_FIELD_NAME_NORMALIZED_KEY
 
 namespace engine
 {
@@ -306,6 +306,12 @@ namespace engine
       UINT64 totalSelect ;  // total records into result set
       UINT64 totalRead ;    // total records readed from disk
 
+      // bytes of the compressed messages, on the wire and the original
+      UINT64 compressWireIn ;
+      UINT64 compressRawIn ;
+      UINT64 compressWireOut ;
+      UINT64 compressRawOut ;
+
       ossTickDelta   totalReadTime ;
       ossTickDelta   totalWriteTime ;
       ossTimestamp   _connectTimestamp ;
@@ -110,6 +110,10 @@ namespace engine
 
    INT32 monDBDumpLogInfo( BSONObjBuilder &ob );
 
+   INT32 monDBDumpTransLockInfo( BSONObjBuilder &ob );
+
+   INT32 monDBDumpReadAheadInfo( BSONObjBuilder &ob );
+
    INT32 monDumpLastOpInfo( BSONObjBuilder &ob, const monAppCB &moncb ) ;
 
    /*
@@ -157,6 +157,10 @@ enum MSG_TYPE
    MSG_CAT_DROP_IDX_REQ               = 3140,
    MSG_CAT_DROP_IDX_RSP               = MAKE_REPLY_TYPE(MSG_CAT_DROP_IDX_REQ),
 
+   MSG_CAT_SUBSCRIBE_REQ               = 3141,
+   MSG_CAT_SUBSCRIBE_RSP               = MAKE_REPLY_TYPE(MSG_CAT_SUBSCRIBE_REQ),
+   MSG_CAT_CATALOG_CHANGE_NTY          = 3142,
+
    MSG_CAT_CATALOGUE_END               = 3199,
 
    MSG_CAT_NODE_BEGIN                  = 3200,
@@ -232,6 +236,9 @@ enum MSG_TYPE
    MSG_COM_REMOTE_DISC                 = 5001,
    MSG_COM_SESSION_INIT_REQ            = 5002,
    MSG_COM_SESSION_INIT_RSP            = MAKE_REPLY_TYPE(MSG_COM_SESSION_INIT_REQ),
+   MSG_COM_COMPRESSED                  = 5003,
+   MSG_COM_COMPRESS_NEGO_REQ           = 5004,
+   MSG_COM_COMPRESS_NEGO_RSP           = MAKE_REPLY_TYPE(MSG_COM_COMPRESS_NEGO_REQ),
    MSG_COM_END                         = 5999,
 
    MSG_CM_REMOTE                       = 6000,
@@ -426,6 +433,8 @@ typedef struct _MsgOpInsert MsgOpInsert ;
 #define FLG_QUERY_FORCE_IDX_BY_SORT          0x00002000
 #define FLG_QUERY_PREPARE_MORE               0x00004000
 #define FLG_QUERY_KEEP_SHARDINGKEY_IN_UPDATE 0x00008000
+// the matcher is a shape with slots, the parameters are in the hint
+#define FLG_QUERY_PREPARED                   0x00010000
 
 struct _MsgOpQuery
 {
@@ -572,6 +581,37 @@ typedef struct _MsgComSessionInitReq
    CHAR        data[0] ;         /// BSON DATA( usename, passwd and so on...)
 } MsgComSessionInitReq ;
 
+/*
+   Sent after the connection is established. The peer which understands
+   MSG_COM_COMPRESSED replies MSG_COM_COMPRESS_NEGO_RSP, then both sides
+   may send the compressed messages. The compressorType of the request is
+   the one the requester wants to receive, the reply tells the one which
+   is used by the replier.
+*/
+typedef struct _MsgComCompressNego
+{
+   MsgHeader   header ;
+   INT32       compressorType ;  /// UTIL_COMPRESSOR_TYPE
+   UINT32      threshold ;       /// the messages shorter are not compressed
+   CHAR        reserved[8] ;
+} MsgComCompressNego ;
+
+/*
+   The wrapper of a compressed message. header.TID, routeID and requestID
+   are the same as the original message. The first rawLen bytes of the
+   original message( the MsgHeader and the fixed part of the operation )
+   follow the wrapper, then the compressed left of the message.
+*/
+typedef struct _MsgComCompressed
+{
+   MsgHeader   header ;
+   INT32       originalLen ;     /// messageLength of the original message
+   INT32       rawLen ;
+   UINT8       compressorType ;  /// UTIL_COMPRESSOR_TYPE
+   CHAR        reserved[7] ;
+   CHAR        data[0] ;
+} MsgComCompressed ;
+
 typedef struct _MsgOpAggregate
 {
    MsgHeader header ;     // message header
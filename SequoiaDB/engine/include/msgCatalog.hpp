@@ -227,6 +227,88 @@ namespace engine
    typedef MsgOpQuery MsgCatQueryTaskReq ;
    typedef MsgOpReply MsgCatQueryTaskRes ;
 
+   /************************************************
+   * subscribe the catalog changes from the primary
+   * catalog node, which pushes MSG_CAT_CATALOG_CHANGE_NTY
+   * to the subscriber until the lease( ms ) expires
+   ************************************************/
+   class _MsgCatSubscribeReq : public SDBObject
+   {
+   public :
+      MsgHeader      header ;
+      UINT32         leaseTime ;
+      UINT32         reserved ;
+      _MsgCatSubscribeReq()
+      {
+         header.messageLength = sizeof( _MsgCatSubscribeReq ) ;
+         header.opCode = MSG_CAT_SUBSCRIBE_REQ ;
+         header.routeID.value = 0 ;
+         header.requestID = 0 ;
+         header.TID = 0 ;
+         leaseTime = 0 ;
+         reserved = 0 ;
+      }
+   private :
+      _MsgCatSubscribeReq ( _MsgCatSubscribeReq const & ) ;
+      _MsgCatSubscribeReq& operator=( _MsgCatSubscribeReq const & ) ;
+   } ;
+   typedef _MsgCatSubscribeReq         MsgCatSubscribeReq ;
+
+   /************************************************
+   * isNew is 1 when the subscriber is not known by
+   * the catalog node, so the changes before may be
+   * missed. When failed, it's a MsgOpReply
+   ************************************************/
+   class _MsgCatSubscribeRes : public SDBObject
+   {
+   public :
+      MsgOpReply     header ;
+      UINT32         leaseTime ;
+      UINT32         isNew ;
+      _MsgCatSubscribeRes()
+      {
+         header.header.messageLength = sizeof( _MsgCatSubscribeRes ) ;
+         header.header.opCode = MSG_CAT_SUBSCRIBE_RSP ;
+         header.header.routeID.value = 0 ;
+         header.header.requestID = 0 ;
+         header.header.TID = 0 ;
+         header.contextID = -1 ;
+         header.flags = 0 ;
+         header.startFrom = 0 ;
+         header.numReturned = 0 ;
+         leaseTime = 0 ;
+         isNew = 0 ;
+      }
+   private :
+      _MsgCatSubscribeRes ( _MsgCatSubscribeRes const & ) ;
+      _MsgCatSubscribeRes& operator=( _MsgCatSubscribeRes const & ) ;
+   } ;
+   typedef _MsgCatSubscribeRes         MsgCatSubscribeRes ;
+
+   /************************************************
+   * the catalog of the collections is changed
+   * data is a BsonObject:
+   * { "Collection" : [ "cs1.cl1", "cs1.cl2", ... ] }
+   ************************************************/
+   class _MsgCatCatalogChangeNty : public SDBObject
+   {
+   public :
+      MsgHeader      header ;
+      BYTE           data[0] ;
+      _MsgCatCatalogChangeNty()
+      {
+         header.messageLength = sizeof( _MsgCatCatalogChangeNty ) ;
+         header.opCode = MSG_CAT_CATALOG_CHANGE_NTY ;
+         header.routeID.value = 0 ;
+         header.requestID = 0 ;
+         header.TID = 0 ;
+      }
+   private :
+      _MsgCatCatalogChangeNty ( _MsgCatCatalogChangeNty const & ) ;
+      _MsgCatCatalogChangeNty& operator=( _MsgCatCatalogChangeNty const & ) ;
+   } ;
+   typedef _MsgCatCatalogChangeNty     MsgCatCatalogChangeNty ;
+
 }
 #pragma pack()
 
@@ -74,6 +74,7 @@
 #define CAT_COMPRESSED                    FIELD_NAME_COMPRESSED
 #define CAT_COMPRESSIONTYPE               FIELD_NAME_COMPRESSIONTYPE
 #define CAT_STRICTDATAMODE                FIELD_NAME_STRICTDATAMODE
+#define CAT_BLOCKCOMPRESSED               FIELD_NAME_BLOCKCOMPRESSED
 #define CAT_COMPRESSOR_SNAPPY             VALUE_NAME_SNAPPY
 #define CAT_COMPRESSOR_LZW                VALUE_NAME_LZW
 #define CAT_COMPRESSOR_ZLIB               VALUE_NAME_ZLIB
@@ -0,0 +1,122 @@
+/*******************************************************************************
+
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = msgCompress.hpp
+
+   Descriptive Name = Message Compression Header
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of MSG component. This file contains functions to wrap a
+   message into MSG_COM_COMPRESSED and to restore it.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#ifndef MSGCOMPRESS_HPP_
+#define MSGCOMPRESS_HPP_
+
+#include "core.hpp"
+#include "oss.hpp"
+#include "msg.h"
+#include "ossAtomic.hpp"
+#include "utilCompression.hpp"
+
+namespace engine
+{
+   #define MSG_COMPRESS_DFT_THRESHOLD        ( 4096 )
+   // the message is sent raw when the compressed is not smaller than 90%
+   #define MSG_COMPRESS_MIN_RATIO            ( 90 )
+
+   /*
+      _msgCompressStat define
+      The bytes of the compressed messages of the node. The wire bytes are
+      the length of MSG_COM_COMPRESSED, the raw bytes are the length of the
+      original messages.
+   */
+   struct _msgCompressStat
+   {
+      ossAtomic64    _wireIn ;
+      ossAtomic64    _rawIn ;
+      ossAtomic64    _wireOut ;
+      ossAtomic64    _rawOut ;
+
+      _msgCompressStat()
+      :_wireIn( 0 ), _rawIn( 0 ), _wireOut( 0 ), _rawOut( 0 )
+      {
+      }
+   } ;
+   typedef _msgCompressStat msgCompressStat ;
+
+   msgCompressStat*     msgGetCompressStat() ;
+
+   /*
+      The compressor and the threshold of the node, set by the options
+   */
+   void                 msgSetCompressConf( UTIL_COMPRESSOR_TYPE type,
+                                            UINT32 threshold ) ;
+   UTIL_COMPRESSOR_TYPE msgGetCompressType() ;
+   UINT32               msgGetCompressThreshold() ;
+
+   // LZW needs the dictionary of the collection, which is not for the
+   // messages
+   BOOLEAN              msgIsValidCompressType( INT32 type ) ;
+
+   OSS_INLINE BOOLEAN msgNeedCompress( INT32 type, UINT32 threshold,
+                                       UINT32 msgLen )
+   {
+      return msgIsValidCompressType( type ) && msgLen >= threshold ;
+   }
+
+   /*
+      Compress the message made up of pRaw and pData. The first rawLen
+      bytes( begin with MsgHeader ) are kept raw, pData is compressed.
+      *ppOut is allocated by SDB_OSS_MALLOC, and should be freed by the
+      caller. SDB_UTIL_COMPRESS_ABORT is returned when the message is not
+      worth compressing, the caller sends the original message then.
+   */
+   INT32 msgCompress( INT32 type, const CHAR *pRaw, UINT32 rawLen,
+                      const CHAR *pData, UINT32 dataLen,
+                      CHAR **ppOut, UINT32 &outLen ) ;
+
+   /*
+      Restore the MSG_COM_COMPRESSED message to pOut, whose size should be
+      not less than the originalLen of the message.
+   */
+   INT32 msgUncompress( const MsgHeader *pMsg, CHAR *pOut, UINT32 outSize ) ;
+
+   OSS_INLINE UINT32 msgUncompressedLen( const MsgHeader *pMsg )
+   {
+      return (UINT32)( (const MsgComCompressed*)pMsg )->originalLen ;
+   }
+
+   void  msgBuildCompressNego( MsgComCompressNego &nego, INT32 opCode,
+                               INT32 type, UINT32 threshold ) ;
+
+}
+
+#endif // MSGCOMPRESS_HPP_
+
@@ -93,6 +93,7 @@
 #define FIELD_NAME_COMPRESSED                "Compressed"
 #define FIELD_NAME_COMPRESSIONTYPE           "CompressionType"
 #define FIELD_NAME_STRICTDATAMODE            "StrictDataMode"
+#define FIELD_NAME_BLOCKCOMPRESSED           "BlockCompressed"
 #define FIELD_NAME_COMPRESSIONTYPE_DESC      "CompressionTypeDesc"
 #define VALUE_NAME_SNAPPY                    "snappy"
 #define VALUE_NAME_LZW                       "lzw"
@@ -290,10 +291,12 @@
 #define FIELD_NAME_PREFIX                    "Prefix"
 #define FIELD_NAME_MAX_DATAFILE_SIZE         "MaxDataFileSize"
 #define FIELD_NAME_BACKUP_LOG                "BackupLog"
+#define FIELD_NAME_STREAM_NUM                "StreamNum"
 #define FIELD_NAME_USE_EXT_SORT              "UseExtSort"
 #define FIELD_NAME_SUB_COLLECTIONS           "SubCollections"
 #define FIELD_NAME_ELAPSED_TIME              "ElapsedTime"
 #define FIELD_NAME_RETURN_NUM                "ReturnNum"
+#define FIELD_NAME_RECORD_NUM                "RecordNum"
 #define FIELD_NAME_RUN                       "Run"
 #define FIELD_NAME_CLUSTERNAME               "ClusterName"
 #define FIELD_NAME_BUSINESSNAME              "BusinessName"
@@ -313,6 +316,20 @@
 #define FIELD_NAME_TRANS_LOCKS_NUM           "TransactionLocksNum"
 #define FIELD_NAME_TRANS_LOCKS               "GotLocks"
 #define FIELD_NAME_TRANS_WAIT_LOCK           "WaitLock"
+#define FIELD_NAME_TRANS_LOCK_STAT           "TransLockStat"
+#define FIELD_NAME_FAST_INTENT_LOCKS         "FastIntentLocks"
+#define FIELD_NAME_LOCK_HOLD_NUM             "HoldNum"
+#define FIELD_NAME_LOCK_WAIT_NUM             "WaitNum"
+#define FIELD_NAME_LOCK_ACQUIRE_NUM          "AcquireNum"
+#define FIELD_NAME_LOCK_WAIT_TIMES           "WaitTimes"
+#define FIELD_NAME_LOCK_WAIT_BUCKETS         "WaitBuckets"
+#define FIELD_NAME_LOCK_BUCKET_NO            "BucketNo"
+#define FIELD_NAME_READ_AHEAD_STAT           "ReadAheadStat"
+#define FIELD_NAME_RA_ISSUE_NUM              "IssueNum"
+#define FIELD_NAME_RA_ISSUE_PAGES            "IssuePages"
+#define FIELD_NAME_RA_HIT_NUM                "HitNum"
+#define FIELD_NAME_RA_MISS_NUM               "MissNum"
+#define FIELD_NAME_RA_WASTED_PAGES           "WastedPages"
 #define FIELD_NAME_SLICE                     "Slice"
 #define FIELD_NAME_REMOTE_IP                 "RemoteIP"
 #define FIELD_NAME_REMOTE_PORT               "RemotePort"
@@ -322,6 +339,7 @@
 #define FIELD_NAME_OP_UPDATE                 "Update"
 #define FIELD_NAME_OP_REMOVE                 "Remove"
 #define FIELD_NAME_RETURNNEW                 "ReturnNew"
+#define FIELD_NAME_PREPARED_PARAMS           "$Parameters"
 #define FIELD_NAME_KEEP_SHARDING_KEY         "KeepShardingKey"
 
 #define FIELD_NAME_INSERT                    "Insert"
@@ -376,6 +394,10 @@
 #define FIELD_NAME_REPL_NETOUT               "replNetOut"
 #define FIELD_NAME_SHARD_NETIN               "shardNetIn"
 #define FIELD_NAME_SHARD_NETOUT              "shardNetOut"
+#define FIELD_NAME_COMPRESS_NETIN            "compressNetIn"
+#define FIELD_NAME_COMPRESS_RAWIN            "compressRawIn"
+#define FIELD_NAME_COMPRESS_NETOUT           "compressNetOut"
+#define FIELD_NAME_COMPRESS_RAWOUT           "compressRawOut"
 #define FIELD_NAME_DOMAIN_AUTO_SPLIT         "AutoSplit"
 #define FIELD_NAME_DOMAIN_AUTO_REBALANCE     "AutoRebalance"
 #define FIELD_NAME_LOB_OID                   "Oid"
@@ -440,6 +462,7 @@
 #define IXM_FIELD_NAME_ENFORCED              "enforced"
 #define IXM_FIELD_NAME_DROPDUPS              "dropDups"
 #define IXM_FIELD_NAME_2DRANGE               "2drange"
+#define IXM_FIELD_NAME_NORMALIZED_KEY        "normalizedKey"
 #define IXM_FIELD_NAME_INDEX_DEF             "IndexDef"
 #define IXM_FIELD_NAME_INDEX_FLAG            "IndexFlag"
 #define IXM_FIELD_NAME_SCAN_EXTLID           "ScanExtentLID"
@@ -547,6 +570,7 @@
 #define CMD_NAME_POP                         "pop"
 #define CMD_NAME_RELOAD_CONFIG               "reload config"
 #define CMD_NAME_ANALYZE                     "analyze"
+#define CMD_NAME_BULK_LOAD                   "bulk load"
 
 #define CMD_NAME_SNAPSHOT_DATABASE_INTR      "SNAPSHOT_DB"
 #define CMD_NAME_SNAPSHOT_SYSTEM_INTR        "SNAPSHOT_SYSTEM"
@@ -0,0 +1,203 @@
+/*******************************************************************************
+
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = mthColumnFilter.hpp
+
+   Descriptive Name = Matcher Column Filter Header
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of Matcher component. This file contains structure for the
+   columnar filter, which evaluates simple numeric predicates of a match tree
+   over a batch of records.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+#ifndef MTH_COLUMNFILTER_HPP_
+#define MTH_COLUMNFILTER_HPP_
+
+#include "core.hpp"
+#include "oss.hpp"
+#include "ossUtil.hpp"
+#include "../bson/bson.hpp"
+#include <vector>
+#include <string>
+
+using namespace bson ;
+using namespace std ;
+
+namespace engine
+{
+   #define MTH_COLUMN_MAX_FIELD_NUM          ( 8 )
+   #define MTH_COLUMN_MAX_PRED_NUM           ( 16 )
+   #define MTH_COLUMN_MAX_IN_NUM             ( 64 )
+   #define MTH_COLUMN_MAX_BATCH_SIZE         ( 1024 )
+
+   /*
+      Row state after the columnar evaluation
+   */
+   #define MTH_COLUMN_ROW_REJECT             ( 0 )
+   #define MTH_COLUMN_ROW_ACCEPT             ( 1 )
+   // the row contains a value the columnar path can't handle exactly
+   // ( missing field, array, string, NaN, ... ), caller must use the
+   // match tree to evaluate it
+   #define MTH_COLUMN_ROW_FALLBACK           ( 2 )
+
+   /*
+      _mthColumnPred define
+   */
+   struct _mthColumnPred
+   {
+      UINT32   _column ;
+      INT32    _opType ;
+      FLOAT64  _value ;
+      UINT32   _inStart ;
+      UINT32   _inNum ;
+   } ;
+   typedef struct _mthColumnPred mthColumnPred ;
+
+   class _mthColumnBatch ;
+
+   /*
+      _mthColumnFilter define
+
+      Conjunction of $et/$lt/$lte/$gt/$gte/$in predicates on top-level fields
+      with numeric constants. It's built from a match tree ( see
+      _mthMatchTree::buildColumnFilter ), and is read-only after built, so it
+      can be shared by several scanners of the same query.
+   */
+   class _mthColumnFilter : public SDBObject
+   {
+      public:
+         _mthColumnFilter() ;
+         ~_mthColumnFilter() ;
+
+      public:
+         void     clear() ;
+
+         // return FALSE when the predicate can't be evaluated by columns,
+         // the filter should be invalidated by caller then
+         BOOLEAN  addPredicate( const CHAR *fieldName, INT32 opType,
+                                const BSONElement &value ) ;
+
+         OSS_INLINE BOOLEAN isValid() const
+         {
+            return _isValid && _predNum > 0 ;
+         }
+
+         OSS_INLINE void invalidate()
+         {
+            _isValid = FALSE ;
+         }
+
+         OSS_INLINE UINT32 getFieldNum() const
+         {
+            return _fieldNum ;
+         }
+
+         OSS_INLINE const CHAR *getFieldName( UINT32 column ) const
+         {
+            return _fieldNames[ column ].c_str() ;
+         }
+
+         /*
+            extract the referenced fields of the record into row 'row' of
+            the batch
+         */
+         void     extractRow( const BSONObj &obj, _mthColumnBatch &batch,
+                              UINT32 row ) const ;
+
+         /*
+            evaluate all predicates over the first 'rowNum' rows of the
+            batch, and generate the row states
+         */
+         void     evaluate( _mthColumnBatch &batch, UINT32 rowNum ) const ;
+
+         string   toString() const ;
+
+      private:
+         INT32    _getColumn( const CHAR *fieldName ) ;
+         static BOOLEAN _toNumber( const BSONElement &ele, FLOAT64 &value ) ;
+
+      private:
+         BOOLEAN           _isValid ;
+         UINT32            _fieldNum ;
+         string            _fieldNames[ MTH_COLUMN_MAX_FIELD_NUM ] ;
+         UINT32            _predNum ;
+         mthColumnPred     _preds[ MTH_COLUMN_MAX_PRED_NUM ] ;
+         vector<FLOAT64>   _inValues ;
+   } ;
+   typedef class _mthColumnFilter mthColumnFilter ;
+
+   /*
+      _mthColumnBatch define
+
+      Column vectors of a batch of records, owned by the scanner
+   */
+   class _mthColumnBatch : public SDBObject
+   {
+      friend class _mthColumnFilter ;
+
+      public:
+         _mthColumnBatch() ;
+         ~_mthColumnBatch() ;
+
+      public:
+         INT32    init( UINT32 fieldNum, UINT32 batchSize ) ;
+         void     release() ;
+
+         OSS_INLINE UINT32 capacity() const
+         {
+            return _batchSize ;
+         }
+
+         OSS_INLINE UINT8 getState( UINT32 row ) const
+         {
+            return _states[ row ] ;
+         }
+
+         OSS_INLINE FLOAT64 *column( UINT32 column )
+         {
+            return _columns + column * _batchSize ;
+         }
+
+         OSS_INLINE const FLOAT64 *column( UINT32 column ) const
+         {
+            return _columns + column * _batchSize ;
+         }
+
+      private:
+         UINT32            _fieldNum ;
+         UINT32            _batchSize ;
+         FLOAT64 *         _columns ;
+         UINT8 *           _valids ;
+         UINT8 *           _states ;
+   } ;
+   typedef class _mthColumnBatch mthColumnBatch ;
+
+}
+
+#endif //MTH_COLUMNFILTER_HPP_
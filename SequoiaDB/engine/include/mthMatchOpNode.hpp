@@ -47,6 +47,7 @@
 #include "../bson/bson.hpp"
 #include "mthMatchNode.hpp"
 #include "mthCommon.hpp"
+#include "mthColumnFilter.hpp"
 #include <vector>
 #ifdef HAVE_CONFIG_H
 #include "config.h"
@@ -550,6 +551,13 @@ namespace engine
          void getFuncList( MTH_FUNC_LIST &funcList ) ;
          BOOLEAN hasReturnMatch() ;
 
+         /*
+            Add the node to the column filter, return FALSE when the node
+            can't be evaluated by columns
+         */
+         BOOLEAN addToColumnFilter( _mthColumnFilter &filter,
+                                    const rtnParamList *parameters ) ;
+
          virtual INT32 getBSONOpType () = 0 ;
 
       protected: /* from itself */
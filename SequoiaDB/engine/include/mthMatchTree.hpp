@@ -47,6 +47,7 @@
 #include "mthMatchLogicNode.hpp"
 #include "mthMatchOpNode.hpp"
 #include "mthMatchNormalizer.hpp"
+#include "mthColumnFilter.hpp"
 #include "rtnPredicate.hpp"
 #include <vector>
 
@@ -131,7 +132,17 @@ namespace engine
          INT32    calcPredicate ( rtnPredicateSet &predicateSet,
                                   const rtnParamList * paramList ) ;
 
+         /*
+            Build the columnar filter of the tree, return FALSE when the
+            tree can't be fully evaluated by the column filter
+         */
+         BOOLEAN  buildColumnFilter ( _mthColumnFilter &filter,
+                                      const rtnParamList *parameters ) ;
+
       private:
+         BOOLEAN  _buildColumnFilter( _mthMatchNode *node,
+                                      _mthColumnFilter &filter,
+                                      const rtnParamList *parameters ) ;
          INT32    _matches( const BSONObj &matchTarget, BOOLEAN &result,
                             _mthMatchTreeContext &context ) ;
          INT32    _addOperator( const CHAR *fieldName, const BSONElement &ele,
@@ -111,9 +111,19 @@ namespace engine
          {
             return _handle ;
          }
+         // the compressed message is restored before it is handled
          CHAR *msg()
          {
-            return _buf ;
+            return _isUncompressed ? _plainBuf : _buf ;
+         }
+         // the peer understands MSG_COM_COMPRESSED, set with mtx()
+         OSS_INLINE void setPeerCompress( BOOLEAN peerCompress )
+         {
+            _peerCompress = peerCompress ;
+         }
+         OSS_INLINE BOOLEAN isPeerCompress() const
+         {
+            return _peerCompress ;
          }
          OSS_INLINE NET_EVENT_HANDLER_STATE state() const
          {
@@ -152,6 +162,9 @@ namespace engine
       private:
          void  _readCallback( const boost::system::error_code &error ) ;
          INT32 _allocateBuf( UINT32 len ) ;
+#if defined ( SDB_ENGINE )
+         INT32 _uncompress() ;
+#endif // SDB_ENGINE
 
       private:
          boost::asio::ip::tcp::socket     _sock ;
@@ -159,6 +172,10 @@ namespace engine
          _MsgHeader                       _header ;
          CHAR                             *_buf ;
          UINT32                           _bufLen ;
+         CHAR                             *_plainBuf ;
+         UINT32                           _plainBufLen ;
+         BOOLEAN                          _isUncompressed ;
+         volatile BOOLEAN                 _peerCompress ;
          NET_EVENT_HANDLER_STATE          _state ;
          _MsgRouteID                      _id ;
          netEvSuitPtr                     _evSuitPtr ;
@@ -237,6 +237,18 @@ namespace engine
 
          void     _heartbeat( INT32 serviceType ) ;
 
+         // called with eh->mtx()
+         INT32    _syncSend( NET_EH &eh, MsgHeader *header, UINT32 headLen,
+                             const void *body, UINT32 bodyLen,
+                             const netIOVec *pIOV = NULL ) ;
+#if defined ( SDB_ENGINE )
+         INT32    _syncSendCompressed( NET_EH &eh, MsgHeader *header,
+                                       UINT32 headLen, const void *body,
+                                       UINT32 bodyLen, const netIOVec *pIOV,
+                                       BOOLEAN &sent ) ;
+#endif // SDB_ENGINE
+         void     _negoCompress( NET_EH &eh ) ;
+
          void     _checkBreak( UINT32 timeout, INT32 serviceType ) ;
 
       private:
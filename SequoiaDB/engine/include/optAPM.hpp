@@ -497,6 +497,9 @@ namespace engine
          INT32 _getCachedAccessPlan ( const optAccessPlanKey &planKey,
                                       optAccessPlan **ppPlan ) ;
 
+         INT32 _getCachedCLAccessPlan ( const optAccessPlanKey &planKey,
+                                        optGeneralAccessPlan **ppPlan ) ;
+
          BOOLEAN _cacheAccessPlan ( optAccessPlan *pPlan ) ;
 
          INT32 _validateParamPlan ( dmsStorageUnit *su,
@@ -242,6 +242,11 @@ namespace engine
             return _scanPath.getKeyPattern() ;
          }
 
+         OSS_INLINE virtual BSONObj getOrderBy () const
+         {
+            return _key.getOrderBy() ;
+         }
+
          OSS_INLINE virtual BOOLEAN sortRequired () const
          {
             SDB_ASSERT ( _isInitialized, "optAccessPlan must be optimized "
@@ -206,6 +206,21 @@ namespace engine
          INT32 normalize ( optAccessPlanHelper &planHelper,
                            mthMatchRuntime *matchRuntime ) ;
 
+         // normalized by the shape of the prepared query, the normalizer
+         // and the predicates of the plan helper are not built
+         OSS_INLINE BOOLEAN isPreparedNormalized () const
+         {
+            return _preparedNormalized ;
+         }
+
+         // the query will be normalized by the normalizer again
+         OSS_INLINE void resetPrepared ()
+         {
+            setPreparedBinding( NULL ) ;
+            _preparedNormalized = FALSE ;
+            _normalizedQuery = BSONObj() ;
+         }
+
          OSS_INLINE static const CHAR * getCacheLevelName (
                                              OPT_PLAN_CACHE_LEVEL cacheLevel )
          {
@@ -231,10 +246,19 @@ namespace engine
 
          UINT32 _generateKeyCodeHash () ;
 
+         UINT32 _getPreparedSign ( optAccessPlanHelper &planHelper ) const ;
+
+         BOOLEAN _normalizePrepared ( optAccessPlanHelper &planHelper,
+                                      mthMatchRuntime *matchRuntime ) ;
+
+         void _learnPrepared ( optAccessPlanHelper &planHelper,
+                               mthMatchRuntime *matchRuntime ) ;
+
       protected :
          BOOLEAN                 _isValid ;
          OPT_PLAN_CACHE_LEVEL    _cacheLevel ;
          BSONObj                 _normalizedQuery ;
+         BOOLEAN                 _preparedNormalized ;
    } ;
 
    typedef class _optAccessPlanKey optAccessPlanKey ;
@@ -270,6 +270,11 @@ namespace engine
             return _plan ? _plan->getDirection() : 1 ;
          }
 
+         OSS_INLINE BSONObj getOrderBy () const
+         {
+            return _plan ? _plan->getOrderBy() : BSONObj() ;
+         }
+
          OSS_INLINE const CHAR *getIndexName () const
          {
             SDB_ASSERT( _plan, "_plan is invalid" ) ;
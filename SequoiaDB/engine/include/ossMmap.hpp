@@ -99,6 +99,8 @@ private:
 
    void  _clearSeg() ;
    INT32 _ensureSpace( UINT32 size ) ;
+   INT32 _allocBlock( UINT32 segmentID, UINT32 offset,
+                      UINT32 length, BOOLEAN punchHole ) ;
 
 public:
 
@@ -177,6 +179,20 @@ public:
    */
    INT32 flushBlock ( UINT32 segmentID, UINT32 offset,
                       INT32 length, BOOLEAN sync = FALSE ) ;
+   /*
+      ask the OS to read the block in the background, the length is cut
+      at the end of the segment, and the advised length is returned by
+      pAdvised
+   */
+   INT32 willNeed ( UINT32 segmentID, UINT32 offset, UINT32 length,
+                    UINT32 *pAdvised = NULL ) ;
+   /*
+      give back the disk space of the block, which reads as zero afterwards,
+      and allocate the space again before the block is written, so that the
+      write doesn't hit SIGBUS when the disk is full
+   */
+   INT32 releaseBlock ( UINT32 segmentID, UINT32 offset, UINT32 length ) ;
+   INT32 reserveBlock ( UINT32 segmentID, UINT32 offset, UINT32 length ) ;
    INT32 unlink () ;
    INT32 size ( UINT64 &fileSize ) ;
 
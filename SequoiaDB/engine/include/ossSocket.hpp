@@ -71,6 +71,17 @@
 #define OSS_MAX_HOSTNAME            NI_MAXHOST
 #define OSS_MAX_SERVICENAME         NI_MAXSERV
 
+/*
+   _ossSockVec define
+   One piece of the data which is sent by a gather write
+*/
+struct _ossSockVec
+{
+   const CHAR  *pData ;
+   INT32       len ;
+} ;
+typedef struct _ossSockVec ossSockVec ;
+
 #ifdef SDB_SSL
 SDB_EXTERN_C_START
 struct SSLHandle ;
@@ -133,6 +144,13 @@ class _ossSocket : public SDBObject
                    INT32 timeout = OSS_SOCKET_DFT_TIMEOUT,
                    INT32 flags = 0,
                    BOOLEAN block = TRUE ) ;
+      // send the pieces by one sendmsg, the pieces are moved forward by
+      // the sent bytes, so a timed out send can be continued by calling
+      // again with the same pieces
+      INT32 sendv ( ossSockVec *pVec, INT32 num,
+                    INT32 &sentLen,
+                    INT32 timeout = OSS_SOCKET_DFT_TIMEOUT,
+                    INT32 flags = 0 ) ;
       INT32 recv ( CHAR *pMsg, INT32 len,
                    INT32 &receivedLen,
                    INT32 timeout = OSS_SOCKET_DFT_TIMEOUT,
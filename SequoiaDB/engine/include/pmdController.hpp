@@ -43,6 +43,7 @@
 #include "restAdaptor.hpp"
 #include "pmdRemoteSession.hpp"
 #include "pmdAccessProtocolBase.hpp"
+#include "pmdPollService.hpp"
 
 #include <string>
 #include <map>
@@ -82,6 +83,7 @@ namespace engine
 
          restAdaptor*   getRestAdptor() { return &_restAdptor ; }
          pmdRemoteSessionMgr* getRSManager() { return _pRSManager ; }
+         pmdPollService* getPollService() { return &_pollService ; }
 
       public:
          void              detachSessionInfo( restSessionInfo *pSessionInfo ) ;
@@ -113,6 +115,8 @@ namespace engine
          INT32 activeForeignModule() ;
          void  finishForeignModule() ;
 
+         void  _applyNetCompress() ;
+
       private:
          ossSocket               *_pTcpListener ;
          ossSocket               *_pHttpListener ;
@@ -137,6 +141,7 @@ namespace engine
 
          restAdaptor                            _restAdptor ;
          pmdRemoteSessionMgr                    *_pRSManager ;
+         pmdPollService                         _pollService ;
 
          map< _netFrame*, INT32 >               _mapMonNets ;
 
@@ -166,6 +166,7 @@ namespace engine
       EDU_TYPE_FAPLISTENER,
       EDU_TYPE_DBMONITOR,
       EDU_TYPE_RTNNETWORK,
+      EDU_TYPE_SVCPOLLER,
 #if defined (_LINUX)
       EDU_TYPE_SIGNALTEST,
 #endif // _LINUX
@@ -178,6 +179,7 @@ namespace engine
       EDU_TYPE_RESTAGENT,
       EDU_TYPE_FAPAGENT,
       EDU_TYPE_OMAAGENT,
+      EDU_TYPE_POLLAGENT,
 
       EDU_TYPE_AGENT_END,
 
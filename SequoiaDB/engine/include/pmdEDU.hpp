@@ -92,6 +92,9 @@ namespace engine
    } ;
 
    class _pmdEDUMgr ;
+#if defined ( SDB_ENGINE )
+   class _dmsBlockCache ;
+#endif // SDB_ENGINE
 
    /*
       _pmdEDUCB define
@@ -377,6 +380,9 @@ namespace engine
 
       void     dumpTransInfo( monTransInfo &transInfo ) ;
 
+      // the decompressed chunks of the block extents, NULL when no memory
+      _dmsBlockCache *getBlockCache() ;
+
    #endif // SDB_ENGINE
 
    protected:
@@ -449,6 +455,7 @@ namespace engine
       DpsTransNodeMap         *_pTransNodeMap ;
       INT32                   _transRC ;
       dpsTransLockId          _waitLock ;
+      _dmsBlockCache          *_pBlockCache ;
    #endif // SDB_ENGINE
 
       /*
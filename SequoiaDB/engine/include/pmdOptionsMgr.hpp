@@ -519,6 +519,18 @@ namespace engine
          OSS_INLINE BOOLEAN memDebugEnabled () const { return _memDebugEnabled ; }
          OSS_INLINE UINT32 memDebugSize () const { return _memDebugSize ; }
          OSS_INLINE UINT32 indexScanStep () const { return _indexScanStep ; }
+         OSS_INLINE UINT32 scanBatchSize () const { return _scanBatchSize ; }
+         OSS_INLINE UINT32 indexFillFactor () const { return _indexFillFactor ; }
+         OSS_INLINE UINT32 readAheadSize () const { return _readAheadSize ; }
+         OSS_INLINE UINT32 maxPollAgent () const { return _maxPollAgent ; }
+         OSS_INLINE const CHAR* netCompressStr () const
+         {
+            return _netCompressStr ;
+         }
+         OSS_INLINE UINT32 netCompressThreshold () const
+         {
+            return _netCompressThreshold ;
+         }
          OSS_INLINE UINT32 getReplLogBuffSize () const { return _logBuffSize ; }
          OSS_INLINE const CHAR* dbroleStr() const { return _krcbRole ; }
          OSS_INLINE INT32 diagFileNum() const { return _dialogFileNum ; }
@@ -591,6 +603,7 @@ namespace engine
          CHAR        _prefInstStr[ PMD_MAX_LONG_STR_LEN + 1 ] ;
          CHAR        _prefInstModeStr[ PMD_MAX_SHORT_STR_LEN + 1 ] ;
          CHAR        _auditMaskStr[ OSS_MAX_PATHSIZE + 1 ] ;
+         CHAR        _netCompressStr[ PMD_MAX_ENUM_STR_LEN + 1 ] ;
          UINT32      _logFileSz ;
          UINT32      _logFileNum ;
          UINT32      _numPreLoaders ;
@@ -603,6 +616,11 @@ namespace engine
          BOOLEAN     _memDebugEnabled ;
          UINT32      _memDebugSize ;
          UINT32      _indexScanStep ;
+         UINT32      _scanBatchSize ;
+         UINT32      _indexFillFactor ;
+         UINT32      _readAheadSize ;
+         UINT32      _maxPollAgent ;
+         UINT32      _netCompressThreshold ;
          BOOLEAN     _dpslocal ;
          BOOLEAN     _traceOn ;
          UINT32      _traceBufSz ;
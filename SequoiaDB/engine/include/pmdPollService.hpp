@@ -0,0 +1,128 @@
+/*******************************************************************************
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = pmdPollService.hpp
+
+   Descriptive Name = Process MoDel Poll Service Header
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of PMD component. This file contains the service which keeps
+   the idle client sessions in epoll, and hands the sessions with request
+   to a bounded number of agents.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+#ifndef PMD_POLL_SERVICE_HPP__
+#define PMD_POLL_SERVICE_HPP__
+
+#include "core.hpp"
+#include "oss.hpp"
+#include "ossLatch.hpp"
+#include "ossAtomic.hpp"
+#include "ossQueue.hpp"
+#include "ossSocket.hpp"
+
+#include <set>
+
+namespace engine
+{
+
+   class _pmdLocalSession ;
+   class _pmdEDUCB ;
+
+   #define PMD_POLL_EVENT_NUM             ( 256 )
+   #define PMD_POLL_WAIT_TIMEOUT          ( 100 )
+   // an agent waits so long for the sessions before going back to the pool
+   #define PMD_POLL_AGENT_IDLE_TIMEOUT    ( 60 * OSS_ONE_SEC )
+
+   /*
+      _pmdPollService define
+
+      The listener passes the accepted sockets to the service. The sessions
+      are kept in epoll while they are idle, the poller pushes the readable
+      ones to the ready queue, which is served by at most maxpollagent
+      agents. An agent serves a request of a session, then returns it to
+      epoll. A session which keeps the state in the agent ( context,
+      transaction, attributes ) can't leave the agent, the agent is
+      dedicated to it out of the bound until it is idle again, so that
+      the bounded agents never wait for the clients.
+   */
+   class _pmdPollService : public SDBObject
+   {
+      typedef std::set< _pmdLocalSession* >     SET_SESSION ;
+
+      public:
+         _pmdPollService() ;
+         ~_pmdPollService() ;
+
+         INT32    init( UINT32 maxAgentNum ) ;
+         void     fini() ;
+
+         OSS_INLINE BOOLEAN isEnabled() const { return _maxAgentNum > 0 ; }
+
+         // the socket is owned by the service, and is closed when failed
+         INT32    addSession( SOCKET fd ) ;
+
+         // called by the poller
+         INT32    poll( _pmdEDUCB *cb, INT32 timeout ) ;
+
+         // called by the agents
+         BOOLEAN  popSession( _pmdLocalSession **ppSession, INT64 timeout ) ;
+         // the agent leaves the bound for the session keeping the state
+         void     dedicateAgent( _pmdEDUCB *cb ) ;
+         /*
+            The session is returned to epoll, or is released when closed.
+            A dedicated agent goes back to the bound when there is room,
+            otherwise FALSE is returned and the agent must quit.
+         */
+         BOOLEAN  releaseSession( _pmdLocalSession *pSession,
+                                  BOOLEAN dedicated ) ;
+         void     onAgentExit() ;
+
+         OSS_INLINE UINT32 sessionNum() const { return _sessionNum.peek() ; }
+         OSS_INLINE UINT32 agentNum() const { return _agentNum.peek() ; }
+
+      private:
+         INT32    _arm( _pmdLocalSession *pSession, BOOLEAN isAdd ) ;
+         void     _closeSession( _pmdLocalSession *pSession ) ;
+         void     _startAgents( _pmdEDUCB *cb ) ;
+         BOOLEAN  _reserveAgent() ;
+
+      private:
+         INT32                               _epollFD ;
+         UINT32                              _maxAgentNum ;
+         ossQueue< _pmdLocalSession* >       _readyQue ;
+         ossSpinXLatch                       _latch ;
+         SET_SESSION                         _sessions ;
+         ossAtomic32                         _sessionNum ;
+         ossAtomic32                         _agentNum ;
+         ossAtomic32                         _idleAgentNum ;
+   } ;
+   typedef _pmdPollService pmdPollService ;
+
+}
+
+#endif //PMD_POLL_SERVICE_HPP__
+
@@ -62,7 +62,17 @@ namespace engine
 
          virtual INT32     run() ;
 
+         /*
+            Serve a request, or the requests until the session is idle
+            again when untilIdle, used by the agents of the poll service.
+            The session is closed when failed.
+         */
+         INT32             serve( BOOLEAN untilIdle ) ;
+         // no state of the session is kept in the agent
+         BOOLEAN           isIdle() ;
+
       protected:
+         INT32          _recvAndProcess() ;
          INT32          _processMsg( MsgHeader *msg ) ;
          virtual INT32  _onMsgBegin( MsgHeader *msg ) ;
          virtual void   _onMsgEnd( INT32 result, MsgHeader *msg ) ;
@@ -74,6 +84,13 @@ namespace engine
          INT32          _reply( MsgOpReply* responseMsg, const CHAR *pBody,
                                 INT32 bodyLen ) ;
 
+         INT32          _processCompressNego( const MsgHeader *msg ) ;
+         INT32          _uncompressMsg( MsgHeader *msg,
+                                        MsgHeader **ppPlainMsg ) ;
+         INT32          _replyCompressed( MsgOpReply *responseMsg,
+                                          const CHAR *pBody, INT32 bodyLen,
+                                          BOOLEAN &sent ) ;
+
       protected:
          virtual void            _onAttach () ;
          virtual void            _onDetach () ;
@@ -84,6 +101,15 @@ namespace engine
          MsgOpReply           _replyHeader ;
          BOOLEAN              _needReply ;
          BOOLEAN              _needRollback ;
+         // the session attributes are kept in the agent
+         BOOLEAN              _pinned ;
+
+         // negotiated with the client, the replies are compressed by
+         // the type when they are not shorter than the threshold
+         INT32                _compressType ;
+         UINT32               _compressThreshold ;
+         CHAR                 *_pPlainBuff ;
+         UINT32               _plainBuffSize ;
 
          BSONObj              _errorInfo ;
 
@@ -77,7 +77,9 @@ namespace engine
          ossSocket*  socket () { return &_socket ; }
 
          void        attach( _pmdEDUCB * cb ) ;
-         void        detach() ;
+         // the client keeps logged in when the session is parked by the
+         // poll service and is attached to another agent later
+         void        detach( BOOLEAN logout = TRUE ) ;
 
          void        attachProcessor( _pmdProcessor *pProcessor ) ;
          void        detachProcessor() ;
@@ -99,6 +101,11 @@ namespace engine
                                BOOLEAN block = TRUE,
                                INT32 *pSentLen = NULL,
                                INT32 flags = 0 ) ;
+         // send the pieces by gather write, without copying them into one
+         // buffer
+         INT32       sendDataV( ossSockVec *pVec, INT32 num,
+                                INT32 timeout = -1,
+                                INT32 flags = 0 ) ;
          INT32       recvData( CHAR *pData, INT32 size,
                                INT32 timeout = -1,
                                BOOLEAN block = TRUE,
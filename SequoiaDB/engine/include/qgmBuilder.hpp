@@ -101,6 +101,9 @@ namespace engine
                          _qgmPlan *father,
                          _qgmPlan *&pyh ) ;
 
+      BOOLEAN _canHashAggr( _qgmOptiAggregation *aggr,
+                            _qgmOptiTreeNode *subNode ) ;
+
       INT32 _crtPhyJoin( _qgmOptiNLJoin *join,
                          _qgmPlan *father,
                          _qgmPlan *&pyh ) ;
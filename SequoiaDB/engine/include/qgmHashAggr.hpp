@@ -0,0 +1,277 @@
+/*******************************************************************************
+
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = qgmHashAggr.hpp
+
+   Descriptive Name = QGM Hash Aggregation Header
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of QGM component. This file contains the hash table used by
+   the aggregation plan to group the records without sorting them first.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#ifndef QGMHASHAGGR_HPP_
+#define QGMHASHAGGR_HPP_
+
+#include "core.hpp"
+#include "oss.hpp"
+#include "qgmDef.hpp"
+#include "rtnSQLFunc.hpp"
+#include "dmsTmpBlkUnit.hpp"
+#include "../bson/bson.hpp"
+#include <vector>
+#include <list>
+
+using namespace bson ;
+
+namespace engine
+{
+   class _qgmSelector ;
+
+   #define QGM_HASH_AGGR_BATCH_SIZE          ( 1024 )
+   #define QGM_HASH_AGGR_MIN_SLOT_NUM        ( 1024 )
+   #define QGM_HASH_AGGR_PART_NUM            ( 16 )
+   #define QGM_HASH_AGGR_PART_BITS           ( 4 )
+   // spilled partitions are split again with the next bits of the hash,
+   // the low bits are left for the slots
+   #define QGM_HASH_AGGR_MAX_DEPTH           ( 4 )
+   #define QGM_HASH_AGGR_SPILL_BUF_SIZE      ( 256 * 1024 )
+   #define QGM_HASH_AGGR_RUN_BUF_SIZE        ( 64 * 1024 )
+   #define QGM_HASH_AGGR_MIN_KEY_BUF_SIZE    ( 1024 )
+   // the limit of Ordering
+   #define QGM_HASH_AGGR_MAX_KEY_NUM         ( 31 )
+   // the first byte of a normalized key tells whether the key could be
+   // normalized, otherwise the bson of the key follows
+   #define QGM_HASH_AGGR_NORM_KEY            ( 0 )
+   #define QGM_HASH_AGGR_RAW_KEY             ( 1 )
+
+   enum QGM_HASH_AGGR_FUNC
+   {
+      QGM_HASH_AGGR_COUNT = 0,
+      QGM_HASH_AGGR_SUM,
+      QGM_HASH_AGGR_AVG,
+      QGM_HASH_AGGR_MIN,
+      QGM_HASH_AGGR_MAX,
+      QGM_HASH_AGGR_FIRST,
+      QGM_HASH_AGGR_LAST,
+      QGM_HASH_AGGR_UNKNOWN
+   } ;
+
+   /*
+      _qgmHashAggrAccum define
+      The state of one function in one group. COUNT, SUM and AVG are
+      numeric, the others keep an owned copy of the value.
+   */
+   struct _qgmHashAggrAccum
+   {
+      FLOAT64        _sum ;
+      SINT64         _count ;
+      bsonDecimal    *_pDecimal ;
+      BSONObj        _value ;
+
+      _qgmHashAggrAccum()
+      :_sum( 0 ), _count( 0 ), _pDecimal( NULL )
+      {
+      }
+   } ;
+   typedef struct _qgmHashAggrAccum qgmHashAggrAccum ;
+
+   /*
+      _qgmHashAggrGroup define
+      The key of a group is kept in the key buffer: the normalized key
+      which is used for the hashing and equality, followed by the bson of
+      the key which is used for the ordering.
+   */
+   struct _qgmHashAggrGroup
+   {
+      UINT64         _keyOffset ;
+      UINT32         _normLen ;
+      UINT32         _hash ;
+   } ;
+   typedef struct _qgmHashAggrGroup qgmHashAggrGroup ;
+
+   /*
+      _qgmHashAggrPart define
+      The records spilled to the temp file by the hash of their keys.
+   */
+   struct _qgmHashAggrPart
+   {
+      RTN_SORT_BLKS  _blks ;
+      UINT32         _depth ;
+   } ;
+   typedef struct _qgmHashAggrPart qgmHashAggrPart ;
+
+   /*
+      _qgmHashAggrRun define
+      The sorted results of one pass, which are merged after spilling.
+   */
+   struct _qgmHashAggrRun
+   {
+      dmsTmpBlk      _blk ;
+      CHAR           *_pBuf ;
+      UINT32         _bufSize ;
+      UINT32         _loaded ;
+      UINT32         _read ;
+      BSONObj        _key ;
+      BSONObj        _result ;
+      BOOLEAN        _eof ;
+
+      _qgmHashAggrRun()
+      :_pBuf( NULL ), _bufSize( 0 ), _loaded( 0 ), _read( 0 ), _eof( FALSE )
+      {
+      }
+   } ;
+   typedef struct _qgmHashAggrRun qgmHashAggrRun ;
+
+   /*
+      _qgmHashAggr define
+
+      The records are grouped by an open-addressing table keyed on the
+      normalized group key. COUNT, SUM and AVG of the records are collected
+      into columns and added to the groups a batch at a time. When the
+      memory is used up, records of the new groups are spilled to the temp
+      file by partitions, which are grouped one by one after the input is
+      done. The results are returned in the order of the group key, like
+      the sort-based aggregation does.
+   */
+   class _qgmHashAggr : public SDBObject
+   {
+   public:
+      _qgmHashAggr() ;
+      ~_qgmHashAggr() ;
+
+   public:
+      static BOOLEAN isSupported( const std::vector<_rtnSQLFunc *> &func ) ;
+
+      INT32 init( const std::vector<_rtnSQLFunc *> &func,
+                  const _qgmSelector *groupby,
+                  const BSONObj &orderBy,
+                  UINT64 memLimit ) ;
+
+      INT32 push( const qgmFetchOut &next, const BSONObj &key ) ;
+
+      // the input is done
+      INT32 finish() ;
+
+      INT32 fetch( BSONObj &result ) ;
+
+      void  clear() ;
+
+      OSS_INLINE UINT64 recordNum() const { return _recordNum ; }
+      OSS_INLINE BOOLEAN isSpilled() const { return _spilled ; }
+
+   private:
+      INT32 _push( const qgmFetchOut &next, const BSONObj &key ) ;
+      INT32 _findGroup( const BSONObj &key, UINT32 &groupID ) ;
+      INT32 _newGroup( const UINT8 *pNorm, UINT32 normLen,
+                       const BSONObj &key, UINT32 hash,
+                       UINT32 &groupID ) ;
+      INT32 _growSlots() ;
+      INT32 _reserveKeyBuf( UINT64 size ) ;
+      INT32 _update( UINT32 groupID, const qgmFetchOut &next ) ;
+      void  _flushBatch() ;
+      void  _resetTable() ;
+      UINT64 _memUsed() const ;
+
+      INT32 _spill( const qgmFetchOut &next, UINT32 hash ) ;
+      INT32 _flushPart( UINT32 index ) ;
+      INT32 _writeBlk( const CHAR *pData, UINT64 size, RTN_SORT_BLKS &blks ) ;
+      INT32 _finishPass() ;
+      INT32 _loadPart( qgmHashAggrPart &part ) ;
+      INT32 _readBlk( dmsTmpBlk &blk ) ;
+
+      void  _sortGroups() ;
+      INT32 _result( UINT32 groupID, BSONObj &result ) ;
+      INT32 _saveRun() ;
+      INT32 _nextOfRun( qgmHashAggrRun &run ) ;
+      INT32 _fetchMerged( BSONObj &result ) ;
+
+      OSS_INLINE const CHAR *_keyOf( UINT32 groupID ) const
+      {
+         return _pKeyBuf + _groups[ groupID ]._keyOffset ;
+      }
+      OSS_INLINE BSONObj _bsonKeyOf( UINT32 groupID ) const
+      {
+         return BSONObj( _keyOf( groupID ) + _groups[ groupID ]._normLen ) ;
+      }
+      INT32 _compareGroup( UINT32 left, UINT32 right ) const ;
+
+      friend struct _qgmHashAggrGroupLess ;
+
+   private:
+      std::vector<_rtnSQLFunc *>       _func ;
+      std::vector<QGM_HASH_AGGR_FUNC>  _funcType ;
+      std::vector<std::string>         _alias ;
+      const _qgmSelector               *_groupby ;
+      BSONObj                          _orderBy ;
+      Ordering                         *_pOrder ;
+      UINT64                           _memLimit ;
+
+      // the table
+      UINT32                           *_pSlots ;
+      UINT32                           _slotNum ;
+      std::vector<qgmHashAggrGroup>    _groups ;
+      std::vector<qgmHashAggrAccum>    _accums ;
+      CHAR                             *_pKeyBuf ;
+      UINT64                           _keyBufSize ;
+      UINT64                           _keyBufUsed ;
+      UINT64                           _valueSize ;
+      UINT8                            *_pNormBuf ;
+      UINT32                           _normBufSize ;
+
+      // the batch of numeric values, one column per function
+      UINT32                           *_pBatchGroup ;
+      FLOAT64                          *_pBatchValue ;
+      BOOLEAN                          *_pBatchValid ;
+      UINT32                           _batchNum ;
+
+      // spilling
+      UINT32                           _depth ;
+      BOOLEAN                          _spilled ;
+      _dmsTmpBlkUnit                   *_pUnit ;
+      UINT64                           _blkBegin ;
+      qgmHashAggrPart                  _parts[ QGM_HASH_AGGR_PART_NUM ] ;
+      CHAR                             *_pPartBuf[ QGM_HASH_AGGR_PART_NUM ] ;
+      UINT32                           _partBufUsed[ QGM_HASH_AGGR_PART_NUM ] ;
+      std::list<qgmHashAggrPart>       _pendingParts ;
+      CHAR                             *_pReadBuf ;
+      UINT64                           _readBufSize ;
+
+      // results
+      std::vector<UINT32>              _sorted ;
+      UINT32                           _fetchPos ;
+      BOOLEAN                          _finished ;
+      std::vector<qgmHashAggrRun>      _runs ;
+      UINT64                           _recordNum ;
+   } ;
+   typedef class _qgmHashAggr qgmHashAggr ;
+}
+
+#endif
+
@@ -0,0 +1,265 @@
+/*******************************************************************************
+
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = qgmHashJoin.hpp
+
+   Descriptive Name = QGM Hash Join Header
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of QGM component. This file contains the partitioned hash
+   table used by the hash join plan, which spills the partitions to the
+   temp file when the build side doesn't fit in the memory.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#ifndef QGMHASHJOIN_HPP_
+#define QGMHASHJOIN_HPP_
+
+#include "core.hpp"
+#include "oss.hpp"
+#include "dmsTmpBlkUnit.hpp"
+#include "../bson/bson.hpp"
+#include <vector>
+#include <list>
+#include <string>
+
+using namespace bson ;
+
+namespace engine
+{
+   #define QGM_HASH_JOIN_PART_NUM            ( 16 )
+   #define QGM_HASH_JOIN_PART_BITS           ( 4 )
+   // spilled partitions are split again with the next bits of the hash,
+   // the low bits are left for the buckets
+   #define QGM_HASH_JOIN_MAX_DEPTH           ( 4 )
+   #define QGM_HASH_JOIN_SPILL_BUF_SIZE      ( 128 * 1024 )
+   #define QGM_HASH_JOIN_MIN_ROW_BUF_SIZE    ( 64 * 1024 )
+   #define QGM_HASH_JOIN_MAX_THREAD          ( 8 )
+   #define QGM_HASH_JOIN_MIN_ROWS_PER_THREAD ( 16 * 1024 )
+   // the probe rows are matched batch by batch
+   #define QGM_HASH_JOIN_PROBE_BATCH_ROWS    ( 16 * 1024 )
+   #define QGM_HASH_JOIN_PROBE_BATCH_SIZE    ( 4 * 1024 * 1024 )
+   #define QGM_HASH_JOIN_MIN_PROBES_PER_THREAD  ( 2 * 1024 )
+
+   /*
+      _qgmHashJoinEntry define
+      The row at the offset of the row buffer of the partition. The next is
+      the index + 1 of the next entry in the bucket, 0 for the end.
+   */
+   struct _qgmHashJoinEntry
+   {
+      UINT64         _offset ;
+      UINT32         _hash ;
+      UINT32         _next ;
+   } ;
+   typedef struct _qgmHashJoinEntry qgmHashJoinEntry ;
+
+   /*
+      _qgmHashJoinProbeRow define
+      The probe row at the offset of the probe batch buffer. Its matches
+      are [ _matchBegin, _matchEnd ) of the matches of the partition.
+   */
+   struct _qgmHashJoinProbeRow
+   {
+      UINT64         _offset ;
+      UINT32         _hash ;
+      UINT32         _part ;
+      UINT32         _matchBegin ;
+      UINT32         _matchEnd ;
+   } ;
+   typedef struct _qgmHashJoinProbeRow qgmHashJoinProbeRow ;
+
+   /*
+      _qgmHashJoinPart define
+      The build rows of one partition are kept in the row buffer one after
+      another, so that the partition is spilled by writing the buffer. When
+      it is spilled, the rows of both sides are written to the temp file.
+      The probe rows of the batch in the partition and the entries they
+      match are kept for the batch.
+   */
+   struct _qgmHashJoinPart
+   {
+      CHAR                             *_pRowBuf ;
+      UINT64                           _rowBufSize ;
+      UINT64                           _rowBufUsed ;
+      std::vector<qgmHashJoinEntry>    _entries ;
+      UINT32                           *_pBuckets ;
+      UINT32                           _bucketNum ;
+
+      std::vector<UINT32>              _batchRows ;
+      std::vector<UINT32>              _batchMatches ;
+
+      BOOLEAN                          _spilled ;
+      CHAR                             *_pSpillBuf ;
+      UINT32                           _spillBufUsed ;
+      RTN_SORT_BLKS                    _buildBlks ;
+      RTN_SORT_BLKS                    _probeBlks ;
+
+      _qgmHashJoinPart()
+      :_pRowBuf( NULL ), _rowBufSize( 0 ), _rowBufUsed( 0 ),
+       _pBuckets( NULL ), _bucketNum( 0 ), _spilled( FALSE ),
+       _pSpillBuf( NULL ), _spillBufUsed( 0 )
+      {
+      }
+   } ;
+   typedef struct _qgmHashJoinPart qgmHashJoinPart ;
+
+   /*
+      _qgmHashJoinPending define
+      A spilled partition, which is joined in a later pass.
+   */
+   struct _qgmHashJoinPending
+   {
+      RTN_SORT_BLKS  _buildBlks ;
+      RTN_SORT_BLKS  _probeBlks ;
+      UINT32         _depth ;
+   } ;
+   typedef struct _qgmHashJoinPending qgmHashJoinPending ;
+
+   /*
+      _qgmHashJoin define
+      The build rows are hashed on the join keys into partitions. When the
+      memory is used up, the largest partition is spilled to the temp file,
+      and the probe rows of a spilled partition are spilled as well. After
+      the build side is done, the tables of the partitions in memory are
+      built by the parallel jobs. The probe rows are copied into a batch,
+      whose partitions are matched by the parallel jobs as well. The
+      spilled partitions are joined pass by pass after the probe side is
+      done, and they are split again with the next bits of the hash if
+      they still don't fit.
+   */
+   class _qgmHashJoin : public SDBObject
+   {
+   public:
+      _qgmHashJoin() ;
+      ~_qgmHashJoin() ;
+
+   public:
+      INT32 init( const std::vector<std::string> &buildKeys,
+                  const std::vector<std::string> &probeKeys,
+                  UINT64 memLimit ) ;
+      void  clear() ;
+
+      // the build rows of the current pass
+      INT32 pushBuild( const BSONObj &row ) ;
+      INT32 finishBuild() ;
+
+      /*
+         Add the probe row to the batch, the row is copied. When the
+         partition of the row is spilled, the row is saved for the later
+         pass instead.
+      */
+      INT32 pushProbe( const BSONObj &row ) ;
+      OSS_INLINE BOOLEAN isProbeBatchFull() const
+      {
+         return _probeRows.size() >= QGM_HASH_JOIN_PROBE_BATCH_ROWS ||
+                _probeBufUsed >= QGM_HASH_JOIN_PROBE_BATCH_SIZE ;
+      }
+      OSS_INLINE BOOLEAN isProbeBatchEmpty() const
+      {
+         return _probeRows.empty() ;
+      }
+      /*
+         Match the rows of the batch, then the pairs are got in the order
+         of the probe rows. The rows are valid till the next pushProbe(),
+         SDB_DMS_EOC is returned when the batch is done.
+      */
+      INT32 probeBatch() ;
+      INT32 nextMatch( BSONObj &probeRow, BSONObj &buildRow ) ;
+
+      /*
+         The probe rows of the current pass are done. The next pass loads
+         a spilled partition, whose probe rows are got by nextProbe().
+         SDB_DMS_EOC is returned when there is no more pass.
+      */
+      INT32 finishProbe() ;
+      INT32 nextPass() ;
+      INT32 nextProbe( BSONObj &row ) ;
+
+      OSS_INLINE UINT32 depth() const { return _depth ; }
+      OSS_INLINE BOOLEAN isSpilled() const { return NULL != _pUnit ; }
+      OSS_INLINE UINT64 buildNum() const { return _buildNum ; }
+
+   private:
+      BOOLEAN _keyHash( const BSONObj &row,
+                        const std::vector<std::string> &keys,
+                        BSONElement *pEles, UINT32 &hash ) const ;
+      UINT32  _partOf( UINT32 hash ) const ;
+      void    _clearProbeBatch() ;
+
+      INT32   _addRow( qgmHashJoinPart &part, const BSONObj &row,
+                       UINT32 hash ) ;
+      INT32   _makeRoom( UINT32 index, UINT64 size ) ;
+      INT32   _spillPart( UINT32 index ) ;
+      INT32   _spillRow( UINT32 index, const BSONObj &row,
+                         RTN_SORT_BLKS &blks ) ;
+      INT32   _flushSpill( UINT32 index, RTN_SORT_BLKS &blks ) ;
+      INT32   _buildTables() ;
+      void    _resetParts() ;
+      UINT64  _memUsed() const ;
+
+      INT32   _openUnit() ;
+      INT32   _writeBlk( const CHAR *pData, UINT64 size,
+                         RTN_SORT_BLKS &blks ) ;
+      INT32   _readBlk( dmsTmpBlk &blk ) ;
+
+   private:
+      std::vector<std::string>         _buildKeys ;
+      std::vector<std::string>         _probeKeys ;
+      UINT64                           _memLimit ;
+      UINT64                           _buildNum ;
+
+      // the partitions of the current pass
+      UINT32                           _depth ;
+      qgmHashJoinPart                  _parts[ QGM_HASH_JOIN_PART_NUM ] ;
+
+      // the probe batch and the position of the pair to get
+      CHAR                             *_pProbeBuf ;
+      UINT64                           _probeBufSize ;
+      UINT64                           _probeBufUsed ;
+      std::vector<qgmHashJoinProbeRow> _probeRows ;
+      UINT32                           _probePos ;
+      UINT32                           _matchPos ;
+
+      // spilling
+      _dmsTmpBlkUnit                   *_pUnit ;
+      UINT64                           _blkBegin ;
+      std::list<qgmHashJoinPending>    _pendings ;
+      CHAR                             *_pReadBuf ;
+      UINT64                           _readBufSize ;
+
+      // the spilled probe rows of the current pass
+      RTN_SORT_BLKS                    _probeBlks ;
+      UINT64                           _probeOffset ;
+      BOOLEAN                          _probeLoaded ;
+   } ;
+   typedef class _qgmHashJoin qgmHashJoin ;
+}
+
+#endif
+
@@ -57,6 +57,10 @@ namespace engine
       BOOLEAN              needMakeCondition() const ;
       INT32                makeCondition() ;
 
+      // the equations of the fields which make up the condition, they are
+      // the keys of the hash join
+      BOOLEAN              getEquiConds( qgmConditionNodePtrVec &conds ) const ;
+
    public:
       virtual INT32     outputSort( qgmOPFieldVec &sortFields ) ;
       virtual INT32     outputStream( qgmOpStream &stream ) ;
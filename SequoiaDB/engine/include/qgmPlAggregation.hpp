@@ -42,6 +42,7 @@
 #include "qgmOptiAggregation.hpp"
 #include "rtnSQLFunc.hpp"
 #include "qgmSelector.hpp"
+#include "qgmHashAggr.hpp"
 
 namespace engine
 {
@@ -58,12 +59,18 @@ namespace engine
    public:
       virtual string toString() const ;
 
+      // group the records by hash instead of the sort below, the results
+      // are still returned in the order of orderBy
+      BOOLEAN enableHashAggr( const BSONObj &orderBy ) ;
+
    private:
       virtual INT32 _execute( _pmdEDUCB *eduCB ) ;
 
       virtual INT32 _fetchNext( qgmFetchOut &next ) ;
 
    private:
+      INT32 _fetchNextHash( qgmFetchOut &next ) ;
+
       INT32 _push( const qgmFetchOut &next ) ;
 
       INT32 _result( qgmFetchOut &result ) ;
@@ -82,6 +89,8 @@ namespace engine
       BOOLEAN _pushedAtAnyTime ;
       BOOLEAN _isAggr;
       BOOLEAN _isStat ;
+      _qgmHashAggr *_hashAggr ;
+      BOOLEAN _hashBuilt ;
    } ;
 
    typedef class _qgmPlAggregation qgmPlAggregation ;
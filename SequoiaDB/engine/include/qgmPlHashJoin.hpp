@@ -39,7 +39,7 @@
 #define QGMPLHASHJOIN_HPP_
 
 #include "qgmPlJoin.hpp"
-#include "qgmHashTable.hpp"
+#include "qgmHashJoin.hpp"
 
 namespace engine
 {
@@ -61,6 +61,8 @@ namespace engine
    public:
       virtual string toString()const ;
 
+      virtual void close() ;
+
       INT32 init( _qgmOptiNLJoin *opti ) ;
 
    private:
@@ -70,20 +72,24 @@ namespace engine
 
       INT32 _buildHashTbl() ;
 
+      INT32 _fillProbeBatch() ;
+
    private:
-      _qgmHashTable _hashTbl ;
+      _qgmHashJoin _hashJoin ;
       _qgmPlan *_build ;
       _qgmPlan *_probe ;
       const qgmField *_buildAlias ;
       const qgmField *_probeAlias ;
-      std::string _buildKey ;
-      std::string _probeKey ;
-      QGM_HT_CONTEXT _hashContext ;
+      std::vector<std::string> _buildKeys ;
+      std::vector<std::string> _probeKeys ;
       _qgmFetchOut _buildF ;
       _qgmFetchOut _probeF ;
-      BSONElement _probeEle ;
       QGM_HJ_FETCH_STATE _state ;
-      BOOLEAN _hitBuildEnd ;
+      // the probe rows are fetched from the probe plan in the first pass,
+      // and from the spilled partitions later
+      BOOLEAN _probeFromPlan ;
+      // the probe rows of the pass are all in the batches
+      BOOLEAN _passDone ;
    } ;
 }
 
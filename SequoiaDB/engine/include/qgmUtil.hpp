@@ -148,6 +148,10 @@ namespace engine
    BOOLEAN  sqlIsCommonValue( INT32 type ) ;
    BOOLEAN  sqlIsNestedValue( INT32 type ) ;
 
+   // the temp files of the hash aggregation and the hash join use negative
+   // ids, so that they don't conflict with the files of the sort contexts
+   INT64    qgmNewTmpFileID() ;
+
 }
 
 #endif // QGMUTIL_HPP_
@@ -425,6 +425,13 @@ namespace engine
                         pmdEDUCB *cb, SDB_DMSCB *dmsCB, SDB_DPSCB *dpsCB,
                         INT16 w, INT8 direction = 1 ) ;
 
+   // the load is refused when checkDataSync and the collection is being
+   // synced by split or full sync, as the sync sends the block as a whole
+   INT32 rtnBulkLoad( const CHAR *pCollectionName, const CHAR *pBlock,
+                      UINT32 blockSize, UINT32 recordNum,
+                      pmdEDUCB *cb, SDB_DMSCB *dmsCB, SDB_DPSCB *dpsCB,
+                      INT16 w, BOOLEAN checkDataSync ) ;
+
    INT32 rtnTestIndex( const CHAR *pCollection,
                        const CHAR *pIndexName,
                        SDB_DMSCB *dmsCB,
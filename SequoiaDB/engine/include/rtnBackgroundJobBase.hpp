@@ -63,6 +63,9 @@ namespace engine
       RTN_JOB_CLS_STORAGE_CHECK  = 17, // storage check job
       RTN_JOB_OPT_PLAN_CLEAR     = 18, // opt plan clear job
       RTN_JOB_PAGEMAPPING        = 19, // page mapping job
+      RTN_JOB_SEAL_EXTENT        = 20, // compress full extents
+      RTN_JOB_BAR_STREAM         = 21, // backup or restore stream
+      RTN_JOB_PARALLEL           = 22, // a piece of a parallel operation
 
       RTN_JOB_MAX
    } ;
@@ -1304,6 +1304,61 @@ namespace engine
       INT8 _direction ;
    };
 
+   /*
+      _rtnBulkLoad define
+      Load a block of sorted records, which is sent to the primary node by
+      the import tool directly. The tool routes the records by its catalog,
+      so the version of the catalog and the group of every record are
+      checked by the data node
+   */
+   class _rtnBulkLoad : public _rtnCommand
+   {
+   DECLARE_CMD_AUTO_REGISTER()
+   public:
+      _rtnBulkLoad()
+      : _fullName( NULL ),
+        _pBlock( NULL ),
+        _blockSize( 0 ),
+        _recordNum( 0 ),
+        _version( -1 )
+      {
+      }
+
+      virtual ~_rtnBulkLoad() {}
+
+   public:
+      virtual const CHAR *name() { return NAME_BULK_LOAD ; }
+      virtual RTN_COMMAND_TYPE type() { return CMD_BULK_LOAD ; }
+      virtual BOOLEAN writable()
+      {
+         return TRUE ;
+      }
+
+      virtual const CHAR* collectionFullName()
+      {
+         return _fullName ;
+      }
+
+      virtual INT32 init ( INT32 flags, INT64 numToSkip, INT64 numToReturn,
+                           const CHAR *pMatcherBuff,
+                           const CHAR *pSelectBuff,
+                           const CHAR *pOrderByBuff,
+                           const CHAR *pHintBuff ) ;
+      virtual INT32 doit ( _pmdEDUCB *cb, _SDB_DMSCB *dmsCB,
+                           _SDB_RTNCB *rtnCB, _dpsLogWrapper *dpsCB,
+                           INT16 w = 1, INT64 *pContextID = NULL ) ;
+
+   private:
+      INT32 _checkCatalog() ;
+
+   private:
+      const CHAR *_fullName ;
+      const CHAR *_pBlock ;
+      UINT32 _blockSize ;
+      UINT32 _recordNum ;
+      INT32 _version ;
+   };
+
    class _rtnAlterCollection: public _rtnCommand
    {
    DECLARE_CMD_AUTO_REGISTER()
@@ -109,6 +109,7 @@ namespace engine
 #define NAME_POP                             CMD_NAME_POP
 #define NAME_RELOAD_CONFIG                   CMD_NAME_RELOAD_CONFIG
 #define NAME_ANALYZE                         CMD_NAME_ANALYZE
+#define NAME_BULK_LOAD                       CMD_NAME_BULK_LOAD
 
 #define NAME_CREATE_GROUP                    CMD_NAME_CREATE_GROUP
 #define NAME_REMOVE_GROUP                    CMD_NAME_REMOVE_GROUP
@@ -264,6 +265,7 @@ namespace engine
       CMD_POP                                = 252,
 
       CMD_ANALYZE                            = 253,
+      CMD_BULK_LOAD                          = 254,
 
       CMD_UNKNOW                             = 65535
    };
@@ -175,6 +175,20 @@ namespace engine
                      rtnContextBuf& buf ) ;
       void     release() ;
 
+      /*
+         Return the records in pBlock( allocated by SDB_OSS_MALLOC ) without
+         copying them, the buffer takes over pBlock when succeed. It is
+         allowed only when the buffer is empty and is not referenced. The
+         records are copied into the buffer when more is appended before
+         they are got.
+      */
+      OSS_INLINE BOOLEAN   canForward() const
+      {
+         return !_countOnly && isEmpty() && 0 == getRefCount() ;
+      }
+      INT32    forward( CHAR *pBlock, const CHAR *objBuf,
+                        INT32 len, INT32 num ) ;
+
    public:
       OSS_INLINE void      enableCountMode() { _countOnly = TRUE ; }
       OSS_INLINE BOOLEAN   isCountMode() const { return _countOnly ; }
@@ -211,13 +225,18 @@ namespace engine
          _numRecords = 0 ;
          _readOffset = 0 ;
          _writeOffset = 0 ;
+         // the forward block is freed when it is not referenced
+         _fwdData = NULL ;
       }
 
    private:
       INT32    _ensureBufferSize( INT32 ensuredSize ) ;
+      INT32    _endForward() ;
+      void     _freeForwardBlock() ;
 
    private:
       CHAR*    _buffer ;
+      const CHAR* _fwdData ;
       INT64    _numRecords ;
       INT32    _bufferSize ;
       INT32    _readOffset ;
@@ -259,6 +278,13 @@ namespace engine
                               INT32 len,
                               INT32 num,
                               BOOLEAN needAligned = TRUE ) ;
+         // return the records in pBlock without copying, pBlock is taken
+         // over when succeed
+         BOOLEAN  canForwardObjs() const { return _buffer.canForward() ; }
+         INT32    forwardObjs( CHAR *pBlock,
+                               const CHAR *pObjBuff,
+                               INT32 len,
+                               INT32 num ) ;
 
          virtual INT32    getMore( INT32 maxNumToReturn,
                                    rtnContextBuf &buffObj,
@@ -55,11 +55,19 @@ namespace engine
    #define RTN_DFT_BUFFERSIZE                DMS_PAGE_SIZE_MAX
    #define RTN_RESULTBUFFER_SIZE_MAX         DMS_SEGMENT_SZ
 
-   #define RTN_BUFF_TO_REAL_PTR( buff )      ((CHAR*)buff - 8 )
-   #define RTN_REAL_PTR_TO_BUFF( ptr )       ((CHAR*)ptr + 8 )
-   #define RTN_BUFF_TO_PTR_SIZE( size )      ( size + 8 )
+   /*
+      The context buffer is led by the head:
+      | forward block( 8 ) | context flag( 4 ) | reference( 4 ) |
+      The forward block is the message whose records are returned without
+      copying into the buffer, it is freed with the buffer.
+   */
+   #define RTN_BUFF_HEAD_SIZE                ( 16 )
+   #define RTN_BUFF_TO_REAL_PTR( buff )      ((CHAR*)buff - RTN_BUFF_HEAD_SIZE )
+   #define RTN_REAL_PTR_TO_BUFF( ptr )       ((CHAR*)ptr + RTN_BUFF_HEAD_SIZE )
+   #define RTN_BUFF_TO_PTR_SIZE( size )      ( size + RTN_BUFF_HEAD_SIZE )
    #define RTN_GET_REFERENCE( buff )         (INT32*)((CHAR*)buff - 4 )
    #define RTN_GET_CONTEXT_FLAG( buff )      (INT32*)((CHAR*)buff - 8 )
+   #define RTN_GET_FORWARD_BLOCK( buff )     (CHAR**)((CHAR*)buff - 16 )
 
    /*
       _rtnObjBuff define
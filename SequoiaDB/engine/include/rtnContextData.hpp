@@ -42,6 +42,7 @@
 #include "rtnQueryOptions.hpp"
 #include "rtnQueryModifier.hpp"
 #include "optAccessPlanRuntime.hpp"
+#include "bpsReadAhead.hpp"
 
 namespace engine
 {
@@ -157,6 +158,7 @@ namespace engine
          BOOLEAN                    _segmentScan ;
          std::vector< dmsExtentID > _segments ;
          _rtnIXScanner              *_scanner ;
+         bpsReadAhead               _readAhead ;
          std::vector< BSONObj >     _indexBlocks ;
          std::vector< dmsRecordID > _indexRIDs ;
          BOOLEAN                    _indexBlockScan ;
@@ -169,6 +171,13 @@ namespace engine
 
    /*
       _rtnContextParaData define
+
+      The segments ( TBSCAN ) or index key ranges ( IXSCAN ) of the collection
+      are split into morsels, at most 'maxsubquery' sub contexts scan the
+      morsels on the prefetch EDUs at the same time. A new morsel is handed
+      out when a sub context is drained, so a slow morsel doesn't hold the
+      other workers. When the index provides the order of the query, the
+      morsels are returned in key order.
    */
    class _rtnContextParaData : public _rtnContextData
    {
@@ -192,7 +201,7 @@ namespace engine
          virtual BOOLEAN   _canPrefetch () const { return FALSE ; }
 
          const BSONObj* _nextBlockObj () ;
-         INT32          _checkAndPrefetch () ;
+         INT32          _checkAndPrefetch ( _pmdEDUCB *cb ) ;
          INT32          _getSubContextData( _pmdEDUCB *cb ) ;
          INT32          _openSubContext( _pmdEDUCB *cb,
                                          const rtnReturnOptions &subReturnOptions,
@@ -204,10 +213,12 @@ namespace engine
       protected:
          std::vector< _rtnContextData* >           _vecContext ;
          BOOLEAN                                   _isParalled ;
+         BOOLEAN                                   _isOrdered ;
          BSONObj                                   _blockObj ;
          UINT32                                    _curIndex ;
          UINT32                                    _step ;
          rtnPrefWatcher                            _prefWather ;
+         rtnReturnOptions                          _subReturnOptions ;
 
    } ;
    typedef _rtnContextParaData rtnContextParaData ;
@@ -50,9 +50,6 @@ namespace engine
    class _rtnContextMain : public _rtnContextBase,
                            public _rtnCtxDataDispatcher
    {
-   protected:
-      typedef std::multimap< rtnOrderKey, rtnSubContext* > SUB_ORDERED_CTX_MAP ;
-
    public:
       _rtnContextMain( INT64 contextID, UINT64 eduID ) ;
       virtual ~_rtnContextMain() ;
@@ -106,11 +103,13 @@ namespace engine
       INT32 _processSubContext ( rtnSubContext * subContext,
                                  BOOLEAN & skipData ) ;
 
+      INT32 _appendSubCtxObjs( rtnSubContext *ctx ) ;
+
       INT32 _checkSubContext ( rtnSubContext * subContext ) ;
 
    protected:
       rtnQueryOptions            _options ;
-      SUB_ORDERED_CTX_MAP        _orderedContextMap ;
+      rtnSubCtxTree              _orderedContextTree ;
       _ixmIndexKeyGen*           _keyGen ;
       INT64                      _numToReturn ;
       INT64                      _numToSkip ;
@@ -122,7 +122,7 @@ namespace engine
 
       BOOLEAN _requireExplicitSorting () const
       {
-         return ( _orderedContextMap.size() > 0 || _subContextMap.size() > 1 ) &&
+         return ( !_orderedContextTree.empty() || _subContextMap.size() > 1 ) &&
                 requireOrder() ;
       }
 
@@ -0,0 +1,71 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = rtnExtentSealJob.hpp
+
+   Descriptive Name = Runtime Extent Seal Job Header
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of runtime component. This file contains the background job
+   which compresses the full extents of the block compressed collections.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#ifndef RTN_EXTENT_SEAL_JOB_HPP_
+#define RTN_EXTENT_SEAL_JOB_HPP_
+
+#include "dmsCB.hpp"
+#include "rtnBackgroundJobBase.hpp"
+
+namespace engine
+{
+   #define RTN_SEAL_WAIT_INTERVAL         ( OSS_ONE_SEC )
+
+   /*
+      _rtnExtentSealJob define
+   */
+   class _rtnExtentSealJob : public _rtnBaseJob
+   {
+   public:
+      _rtnExtentSealJob () ;
+      virtual ~_rtnExtentSealJob () ;
+
+   public:
+      virtual RTN_JOB_TYPE type () const ;
+      virtual const CHAR* name () const ;
+      virtual BOOLEAN muteXOn ( const _rtnBaseJob *pOther ) ;
+      virtual INT32 doit () ;
+
+   private:
+      INT32 _sealCL( const dmsSealJob &job ) ;
+   } ;
+   typedef _rtnExtentSealJob rtnExtentSealJob ;
+
+   INT32 startExtentSealJob ( EDUID *pEDUID ) ;
+}
+
+#endif /* RTN_EXTENT_SEAL_JOB_HPP_ */
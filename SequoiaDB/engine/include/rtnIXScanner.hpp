@@ -48,7 +48,9 @@
 #include "../bson/oid.h"
 #include "dms.hpp"
 #include "monCB.hpp"
+#include "bpsReadAhead.hpp"
 #include <set>
+#include <string>
 
 namespace engine
 {
@@ -68,6 +70,7 @@ namespace engine
       Ordering _order ;
       _dmsStorageUnit *_su ;
       monContextCB *_pMonCtxCB ;
+      bpsReadAhead *_pReadAhead ;
       _pmdEDUCB *_cb ;
       INT32 _direction ;
 
@@ -81,6 +84,11 @@ namespace engine
 
       BSONObj _curKeyObj ;
 
+      // the compact bytes of _savedObj, and of the last key in the bounds,
+      // empty for the keys in BSON format
+      std::string _savedKeyData ;
+      std::string _matchedKeyData ;
+
       OID _indexOID ;
       dmsExtentID _indexCBExtent ;
       dmsExtentID _indexLID ;
@@ -95,6 +103,11 @@ namespace engine
          _pMonCtxCB = monCtxCB ;
       }
 
+      void setReadAhead ( bpsReadAhead *readAhead )
+      {
+         _pReadAhead = readAhead ;
+      }
+
       BSONObj getSavedObj () const
       {
          return _savedObj ;
@@ -134,6 +147,7 @@ namespace engine
       {
          _curIndexRID.reset() ;
          _listIterator.reset() ;
+         _matchedKeyData.clear() ;
          _dupBuffer.clear() ;
          _init    = FALSE ;
       }
@@ -143,6 +157,29 @@ namespace engine
       INT32 advance ( dmsRecordID &rid, BOOLEAN isReadOnly = TRUE ) ;
       INT32 relocateRID () ;
       INT32 relocateRID ( const BSONObj &keyObj, const dmsRecordID &rid ) ;
+
+   private :
+      static OSS_INLINE void _keepKeyData ( std::string &keyData,
+                                            const ixmKey &key )
+      {
+         if ( key.isCompactFormat() )
+         {
+            keyData.assign( key.data(), key.dataSize() ) ;
+         }
+         else
+         {
+            keyData.clear() ;
+         }
+      }
+      static OSS_INLINE BOOLEAN _isSameKey ( const std::string &keyData,
+                                             const ixmKey &key )
+      {
+         return !keyData.empty() && key.isCompactFormat() &&
+                keyData.size() == (UINT32)key.dataSize() &&
+                0 == ossMemcmp( keyData.c_str(), key.data(),
+                                keyData.size() ) ;
+      }
+      BOOLEAN _isSavedKey ( const ixmKey &key ) const ;
    } ;
    typedef class _rtnIXScanner rtnIXScanner ;
 
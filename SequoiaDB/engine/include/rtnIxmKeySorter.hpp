@@ -35,6 +35,8 @@
 
 namespace engine
 {
+   struct _rtnIxmKeySlot ;
+
    class _rtnIxmKeySorter: public dmsIxmKeySorter
    {
    private:
@@ -51,6 +53,10 @@ namespace engine
       INT32 reset() ;
       INT64 usedBufferSize() const ;
 
+   private:
+      UINT32 _sortThreadNum() const ;
+      void   _parallelSort( _rtnIxmKeySlot* keyStart, UINT32 threadNum ) ;
+
    private:
       CHAR*                _buf ;
       INT64                _headOffset ;
@@ -107,10 +107,6 @@ namespace engine
 
       virtual INT32 _close( _pmdEDUCB *cb ) ;
 
-      INT32 _read( const _rtnLobTuple &tuple,
-                   _pmdEDUCB *cb,
-                   CHAR *buf ) ;
-
       INT32 _getAccessPrivilege( const CHAR *fullName,
                                  const bson::OID &oid,
                                  INT32 mode ) ;
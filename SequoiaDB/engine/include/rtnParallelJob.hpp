@@ -0,0 +1,120 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = rtnParallelJob.hpp
+
+   Descriptive Name = Runtime Parallel Job Header
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of runtime component. This file contains the background job
+   which runs a piece of an operation split for several EDUs.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#ifndef RTN_PARALLEL_JOB_HPP_
+#define RTN_PARALLEL_JOB_HPP_
+
+#include "rtnBackgroundJobBase.hpp"
+#include "ossLatch.hpp"
+#include "ossEvent.hpp"
+
+namespace engine
+{
+   // the EDUs working for the parallel operations of the node at most
+   #define RTN_PARALLEL_MAX_JOB_NUM       ( 16 )
+
+   /*
+      _rtnParallelTask define
+      A piece of an operation, it mustn't throw
+   */
+   class _rtnParallelTask : public SDBObject
+   {
+   public:
+      _rtnParallelTask () {}
+      virtual ~_rtnParallelTask () {}
+
+   public:
+      virtual void run () = 0 ;
+   } ;
+   typedef _rtnParallelTask rtnParallelTask ;
+
+   /*
+      _rtnParallelRunner define
+      Runs the tasks of an operation on the background job EDUs, which are
+      pooled by the EDU manager. The jobs of all the operations of the node
+      are no more than RTN_PARALLEL_MAX_JOB_NUM, the task which can't get a
+      job is run by the caller. The tasks must live until wait() returns.
+   */
+   class _rtnParallelRunner : public SDBObject
+   {
+      friend class _rtnParallelJob ;
+
+   public:
+      _rtnParallelRunner () ;
+      ~_rtnParallelRunner () ;
+
+   public:
+      void     run ( rtnParallelTask *pTask ) ;
+      // wait for all the tasks started by run()
+      void     wait () ;
+
+   private:
+      void     _onJobEnd () ;
+
+   private:
+      ossSpinXLatch     _latch ;
+      UINT32            _runningNum ;
+      ossEvent          _event ;
+   } ;
+   typedef _rtnParallelRunner rtnParallelRunner ;
+
+   /*
+      _rtnParallelJob define
+   */
+   class _rtnParallelJob : public _rtnBaseJob
+   {
+   public:
+      _rtnParallelJob ( rtnParallelRunner *pRunner,
+                        rtnParallelTask *pTask ) ;
+      virtual ~_rtnParallelJob () ;
+
+   public:
+      virtual RTN_JOB_TYPE type () const ;
+      virtual const CHAR* name () const ;
+      virtual BOOLEAN muteXOn ( const _rtnBaseJob *pOther ) ;
+      virtual INT32 doit () ;
+
+      virtual BOOLEAN reuseEDU() const { return TRUE ; }
+
+   private:
+      rtnParallelRunner    *_pRunner ;
+      rtnParallelTask      *_pTask ;
+   } ;
+   typedef _rtnParallelJob rtnParallelJob ;
+}
+
+#endif /* RTN_PARALLEL_JOB_HPP_ */
@@ -0,0 +1,255 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = rtnPreparedQuery.hpp
+
+   Descriptive Name = Runtime Prepared Query Header
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of runtime component. This file contains the shapes of the
+   prepared queries, which are shared by the sessions of the node, and the
+   binding of the parameters of one execution.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#ifndef RTN_PREPAREDQUERY_HPP_
+#define RTN_PREPAREDQUERY_HPP_
+
+#include "core.hpp"
+#include "oss.hpp"
+#include "ossLatch.hpp"
+#include "ossAtomic.hpp"
+#include "rtnPredicate.hpp"
+#include "../bson/bson.hpp"
+
+#include <map>
+
+using namespace bson ;
+
+namespace engine
+{
+
+   class _rtnQueryOptions ;
+
+   /*
+      A prepared query is sent with FLG_QUERY_PREPARED. The matcher is the
+      shape of the query, in which the values are given by the slots
+      { "$param" : <index> }, and the values are given by the array
+      "$Parameters" in the hint. Such as:
+         matcher : { a : { $param : 0 }, b : { $gt : { $param : 1 } } }
+         hint    : { "$Parameters" : [ 10, "abc" ] }
+   */
+   #define RTN_PREPARED_MAX_SLOT_NUM         ( RTN_MAX_PARAM_NUM )
+   #define RTN_PREPARED_MAX_SHAPE_NUM        ( 1024 )
+
+   class _rtnPreparedBinding ;
+
+   /*
+      _rtnPreparedShape define
+
+      The shape of a prepared query. The first execution which is
+      normalized by the optimizer teaches the shape how the parameters of
+      the normalized query come from the slots, then the executions with
+      the same slot types get the normalized query and the parameters
+      from the shape, without parsing and normalizing the matcher again.
+   */
+   class _rtnPreparedShape : public SDBObject
+   {
+      public :
+         _rtnPreparedShape () ;
+         ~_rtnPreparedShape () ;
+
+         INT32    init ( const BSONObj &shape, UINT32 hash ) ;
+
+         OSS_INLINE UINT32 getHash () const { return _hash ; }
+         OSS_INLINE const BSONObj &getShape () const { return _shape ; }
+
+         BOOLEAN  isSame ( const BSONObj &shape ) const ;
+
+         OSS_INLINE UINT32 incRef () { return _refCount.inc() ; }
+         OSS_INLINE UINT32 decRef () { return _refCount.dec() - 1 ; }
+         OSS_INLINE UINT32 getRef () const { return _refCount.peek() ; }
+
+         /*
+            Learn from the normalization of the binding. The paramSlots
+            tell the slot of each parameter, -1 for the one not from the
+            slots, whose value is kept in constParams in order. The sign
+            is the configure of the normalizer.
+         */
+         OSS_INLINE BOOLEAN needLearn () const
+         {
+            return RTN_PREPARED_UNKNOWN == _state.peek() ;
+         }
+         void     setLearned ( UINT32 sign,
+                               const _rtnPreparedBinding &binding,
+                               const BSONObj &normalizedQuery,
+                               const INT8 *paramSlots,
+                               UINT32 paramNum,
+                               const BSONObj &constParams ) ;
+         void     setUnlearnable () ;
+
+         BOOLEAN  canBind ( UINT32 sign,
+                            const _rtnPreparedBinding &binding ) const ;
+
+         // query is the bound query of the binding, or a copy of it
+         INT32    bindParams ( const BSONObj &query,
+                               const _rtnPreparedBinding &binding,
+                               rtnParamList &parameters ) const ;
+
+         OSS_INLINE const BSONObj &getNormalizedQuery () const
+         {
+            return _normalizedQuery ;
+         }
+
+      private :
+         enum RTN_PREPARED_STATE
+         {
+            RTN_PREPARED_UNKNOWN = 0,
+            RTN_PREPARED_LEARNED,
+            RTN_PREPARED_UNLEARNABLE
+         } ;
+
+         BSONObj              _shape ;
+         UINT32               _hash ;
+         ossAtomic32          _refCount ;
+         ossSpinXLatch        _latch ;
+
+         // immutable after the state is changed to learned
+         ossAtomic32          _state ;
+         UINT32               _sign ;
+         UINT32               _slotNum ;
+         INT8                 _slotTypes[ RTN_PREPARED_MAX_SLOT_NUM ] ;
+         BSONObj              _normalizedQuery ;
+         UINT32               _paramNum ;
+         INT8                 _paramSlots[ RTN_MAX_PARAM_NUM ] ;
+         BSONObj              _constParams ;
+   } ;
+   typedef _rtnPreparedShape rtnPreparedShape ;
+
+   /*
+      _rtnPreparedShapeMgr define
+      The shapes are cached by the hash, when the cache is full, an
+      unreferenced shape is dropped.
+   */
+   class _rtnPreparedShapeMgr : public SDBObject
+   {
+      typedef std::map< UINT32, rtnPreparedShape* >   MAP_SHAPE ;
+
+      public :
+         _rtnPreparedShapeMgr () ;
+         ~_rtnPreparedShapeMgr () ;
+
+         // *ppShape is NULL when the shape can't be cached
+         INT32    acquire ( const BSONObj &shape, rtnPreparedShape **ppShape ) ;
+         void     release ( rtnPreparedShape *pShape ) ;
+
+         OSS_INLINE UINT32 size () const { return _shapeNum.peek() ; }
+
+      private :
+         void     _evictOne () ;
+
+      private :
+         MAP_SHAPE            _shapes ;
+         ossSpinSLatch        _latch ;
+         ossAtomic32          _shapeNum ;
+   } ;
+   typedef _rtnPreparedShapeMgr rtnPreparedShapeMgr ;
+
+   rtnPreparedShapeMgr* rtnGetPreparedShapeMgr() ;
+
+   /*
+      _rtnPreparedBinding define
+      The parameters of one execution bound to the shape. It should live
+      until the access plan of the query is got.
+   */
+   class _rtnPreparedBinding : public SDBObject
+   {
+      public :
+         _rtnPreparedBinding () ;
+         ~_rtnPreparedBinding () ;
+
+         /*
+            Bind the parameters in the hint to the matcher of the options,
+            which are replaced by the bound query and the hint without
+            parameters, and FLG_QUERY_PREPARED is cleared. The options
+            refer to the binding when the shape is cached, so that the
+            query is normalized with the shape.
+         */
+         INT32    bind ( _rtnQueryOptions &options ) ;
+
+         /*
+            Bind without the cached shape, the bound query and the hint
+            without parameters are returned.
+         */
+         INT32    bind ( const BSONObj &shape, const BSONObj &hint,
+                         BSONObj &query, BSONObj &newHint ) ;
+
+         OSS_INLINE rtnPreparedShape *getShape () const { return _pShape ; }
+         OSS_INLINE UINT32 getSlotNum () const { return _slotNum ; }
+         OSS_INLINE INT32 getSlotOffset ( UINT32 slot ) const
+         {
+            SDB_ASSERT( slot < _slotNum, "Slot is invalid" ) ;
+            return _slotOffsets[ slot ] ;
+         }
+         OSS_INLINE INT8 getSlotType ( UINT32 slot ) const
+         {
+            SDB_ASSERT( slot < _slotNum, "Slot is invalid" ) ;
+            return _slotTypes[ slot ] ;
+         }
+
+         // the slot whose value is at the offset of the bound query, or -1
+         INT32    findSlot ( INT32 offset ) const ;
+
+      private :
+         INT32    _bindObj ( const BSONObj &shape,
+                             BSONObjBuilder &builder,
+                             const BSONElement *values,
+                             UINT32 valueNum ) ;
+         void     _locateSlots ( const BSONObj &shape,
+                                 const BSONObj &bound,
+                                 const CHAR *pBase,
+                                 UINT32 &slot ) ;
+
+         void     _releaseShape () ;
+
+      private :
+         rtnPreparedShape     *_pShape ;
+         UINT32               _slotNum ;
+         INT32                _slotOffsets[ RTN_PREPARED_MAX_SLOT_NUM ] ;
+         INT8                 _slotTypes[ RTN_PREPARED_MAX_SLOT_NUM ] ;
+   } ;
+   typedef _rtnPreparedBinding rtnPreparedBinding ;
+
+   /*
+      Whether the element is the slot { "$param" : <index> }
+   */
+   BOOLEAN rtnIsPreparedSlot ( const BSONElement &e, INT32 &index ) ;
+
+}
+
+#endif // RTN_PREPAREDQUERY_HPP_
+
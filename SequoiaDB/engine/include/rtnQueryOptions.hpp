@@ -52,6 +52,8 @@ using namespace std ;
 namespace engine
 {
 
+   class _rtnPreparedBinding ;
+
    /*
       _rtnReturnOptions define
     */
@@ -320,6 +322,16 @@ namespace engine
 
          void setMainCLQuery ( const CHAR *mainCLName, const CHAR *subCLName ) ;
 
+         OSS_INLINE void setPreparedBinding ( _rtnPreparedBinding *binding )
+         {
+            _preparedBinding = binding ;
+         }
+
+         OSS_INLINE _rtnPreparedBinding *getPreparedBinding () const
+         {
+            return _preparedBinding ;
+         }
+
          OSS_INLINE BOOLEAN canPrepareMore () const
          {
             return testFlag( FLG_QUERY_PREPARE_MORE )&&
@@ -334,6 +346,8 @@ namespace engine
          CHAR *         _fullNameBuf ;
          const CHAR *   _mainCLName ;
          CHAR *         _mainCLNameBuf ;
+         // the binding of the prepared query, which is not owned
+         _rtnPreparedBinding * _preparedBinding ;
    } ;
 
    typedef class _rtnQueryOptions rtnQueryOptions ;
@@ -113,6 +113,11 @@ namespace engine
          return _name.c_str() ;
       }
 
+      const _qgmField &alias() const
+      {
+         return _alias ;
+      }
+
       virtual BOOLEAN isAggr() const { return TRUE ; }
       virtual BOOLEAN isStat() const { return FALSE ; }
 
@@ -59,11 +59,17 @@ namespace engine
 
       public:
          BOOLEAN operator<( const _rtnOrderKey &rhs ) const ;
+         INT32 compare( const _rtnOrderKey &rhs ) const ;
+         // the order of the keys which are equal by the fields
+         INT32 compareHash( const _rtnOrderKey &rhs ) const ;
          void clear() ;
          void setOrderBy( const BSONObj &orderBy ) ;
          INT32 generateKey( const BSONObj &record,
                             _ixmIndexKeyGen *keyGen ) ;
 
+         OSS_INLINE const BSONObj& getKeyObj() const { return _keyObj ; }
+         OSS_INLINE const BSONObj& getOrderBy() const { return _orderBy ; }
+
       private:
          BSONObj              _orderBy ;
          ixmHashValue         _hash ;
@@ -96,6 +102,11 @@ namespace engine
       virtual INT64        getDataID () const = 0 ;
       INT64                getProcessType () const { return _startFrom ; }
 
+      // give up the memory block( allocated by SDB_OSS_MALLOC ) which holds
+      // the records from front(), the sub context is empty then. NULL is
+      // returned when the records can't be taken without copying
+      virtual CHAR*        detachData() { return NULL ; }
+
    protected:
       _rtnOrderKey      _orderKey ;
       BOOLEAN           _isOrderKeyChange ;
@@ -104,6 +115,75 @@ namespace engine
       _ixmIndexKeyGen*  _keyGen ;
    } ;
    typedef _rtnSubContext rtnSubContext ;
+
+   #define RTN_SUB_CTX_NORM_KEY_SIZE      ( 64 )
+
+   /*
+      _rtnSubCtxTree define
+
+      The loser tree to merge the ordered sub contexts. Each leaf holds a
+      sub context with the order key of its front record, the internal
+      nodes hold the losers, and the node 0 holds the winner, which is the
+      sub context with the smallest key. The sub contexts with the same
+      key are in the order of pushing, as the multimap did.
+      Replacing the key of the winner costs log(n) comparisons, pushing
+      into a free leaf or erasing the others rebuilds the tree. The keys
+      are normalized once when they are set, and compared by memcmp, the
+      keys which can't be normalized are compared by woCompare.
+   */
+   class _rtnSubCtxTree : public SDBObject
+   {
+      struct _leaf
+      {
+         rtnSubContext        *_pCtx ;
+         rtnOrderKey          _key ;
+         UINT64               _seq ;
+         std::vector< UINT8 > _norm ;
+         UINT32               _normLen ;
+         BOOLEAN              _normalized ;
+
+         _leaf() : _pCtx( NULL ), _seq( 0 ), _normLen( 0 ),
+                   _normalized( FALSE ) {}
+      } ;
+
+      public:
+         _rtnSubCtxTree() ;
+         ~_rtnSubCtxTree() ;
+
+         OSS_INLINE UINT32    size() const { return _num ; }
+         OSS_INLINE BOOLEAN   empty() const { return 0 == _num ; }
+
+         INT32          push( rtnSubContext *pCtx, const rtnOrderKey &key ) ;
+         rtnSubContext* top() const ;
+         // the key of the winner is changed by its next record
+         void           replaceTop( const rtnOrderKey &key ) ;
+         rtnSubContext* popTop() ;
+         BOOLEAN        erase( rtnSubContext *pCtx ) ;
+         void           clear() ;
+
+         // iterate the leaves, the free ones return NULL
+         OSS_INLINE UINT32 capacity() const { return _leaves.size() ; }
+         OSS_INLINE rtnSubContext* at( UINT32 pos ) const
+         {
+            return _leaves[ pos ]._pCtx ;
+         }
+
+      private:
+         BOOLEAN        _less( INT32 left, INT32 right ) const ;
+         void           _setKey( INT32 leaf, const rtnOrderKey &key ) ;
+         void           _replay( INT32 leaf ) ;
+         void           _rebuild() ;
+         INT32          _build( UINT32 node ) ;
+         void           _free( INT32 leaf ) ;
+
+      private:
+         std::vector< _leaf >       _leaves ;
+         std::vector< INT32 >       _nodes ;
+         std::vector< INT32 >       _freeLeaves ;
+         UINT32                     _num ;
+         UINT64                     _seq ;
+   } ;
+   typedef _rtnSubCtxTree rtnSubCtxTree ;
 }
 
 #endif /* RTN_SUB_CONTEXT_HPP_ */
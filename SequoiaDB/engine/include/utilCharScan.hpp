@@ -0,0 +1,69 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = utilCharScan.hpp
+
+   Descriptive Name = Structural Character Scan Header
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of utility component. This file contains the functions which
+   search the first structural character( delimiters, quotes, braces ) of
+   the CSV or JSON text by SIMD.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#ifndef UTILCHARSCAN_HPP__
+#define UTILCHARSCAN_HPP__
+
+#include "core.hpp"
+
+namespace engine
+{
+   // the max number of the characters searched together
+   #define UTIL_SCAN_MAX_CHARS            ( 8 )
+
+   /*
+      Return the offset of the first byte in pData which is one of the num
+      characters in pChars, or len when none is found. The characters are
+      compared by bytes, so the multi-byte characters of UTF-8 never match
+      an ASCII character. The vector path is chosen by the cpu at the first
+      call: AVX2, SSE2, or the scalar one.
+   */
+   UINT32 utilScanChars( const CHAR *pData, UINT32 len,
+                         const CHAR *pChars, UINT32 num ) ;
+
+   // the scalar implement, which is the reference of the vector paths
+   UINT32 utilScanCharsScalar( const CHAR *pData, UINT32 len,
+                               const CHAR *pChars, UINT32 num ) ;
+
+   // the name of the implement chosen by utilScanChars
+   const CHAR* utilScanImplName() ;
+
+}
+
+#endif // UTILCHARSCAN_HPP__
+
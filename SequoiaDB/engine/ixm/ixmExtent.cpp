@@ -50,7 +50,7 @@ namespace engine
 
    // PD_TRACE_DECLARE_FUNCTION ( SDB__IXMEXT2, "_ixmExtent::_ixmExtent" )
    _ixmExtent::_ixmExtent ( dmsExtentID extentID, UINT16 mbID,
-                            dmsStorageIndex *pIndexSu )
+                            dmsStorageIndex *pIndexSu, BOOLEAN normalized )
    {
       SDB_ASSERT ( pIndexSu, "index su can't be NULL" ) ;
       PD_TRACE_ENTRY ( SDB__IXMEXT2 ) ;
@@ -68,13 +68,18 @@ namespace engine
       pHeader->_eyeCatcher [1] = IXM_EXTENT_EYECATCHER1 ;
       pHeader->_totalKeyNodeNum = 0 ;
       pHeader->_mbID = mbID ;
-      pHeader->_version = IXM_EXTENT_CURRENT_V ;
+      pHeader->_version = normalized ? IXM_EXTENT_VERSION_V1 :
+                                       IXM_EXTENT_CURRENT_V ;
       pHeader->_parentExtentID = DMS_INVALID_EXTENT ;
-      pHeader->_beginFreeOffset = _pageSize-1 ;
+      pHeader->_beginFreeOffset = _keyDataEnd() ;
       pHeader->_right = DMS_INVALID_EXTENT ;
       pHeader->_totalFreeSize = pHeader->_beginFreeOffset -
                         (sizeof(ixmExtentHead) +
                         (pHeader->_totalKeyNodeNum*sizeof(ixmKeyNode))) ;
+      if ( normalized )
+      {
+         _setNormPrefixLen( 0 ) ;
+      }
       pIndexSu->addStatFreeSpace( mbID, pHeader->_totalFreeSize ) ;
 
       PD_TRACE_EXIT ( SDB__IXMEXT2 );
@@ -129,6 +134,8 @@ namespace engine
       INT32 low = 0 ;
       INT32 high = _extentHead->_totalKeyNodeNum-1 ;
       INT32 middle = (low + high)/2 ;
+      ixmNormSearchKey normKey ;
+      _normSearchKey ( key, order, normKey ) ;
       while ( low <= high )
       {
          PD_TRACE3 ( SDB__IXMEXT_FIND,
@@ -143,8 +150,7 @@ namespace engine
             rc = SDB_SYS ;
             goto error ;
          }
-         ixmKey keyDisk(keyData) ;
-         INT32 result = key.woCompare ( keyDisk, order ) ;
+         INT32 result = _keyCompare ( key, order, normKey, middle ) ;
          PD_TRACE1 ( SDB__IXMEXT_FIND, PD_PACK_INT ( result ) ) ;
          if ( 0 == result )
          {
@@ -184,22 +190,16 @@ namespace engine
       PD_TRACE1 ( SDB__IXMEXT_FIND, PD_PACK_USHORT(pos) ) ;
       if ( pos != _extentHead->_totalKeyNodeNum )
       {
+         if ( _keyCompare ( key, order, normKey, pos ) > 0 )
          {
-            const CHAR *keyData = getKeyData (pos) ;
-            ixmKey keyDisk( keyData ) ;
-            if ( key.woCompare ( keyDisk, order ) > 0 )
-            {
-               PD_LOG ( PDERROR, "Internal logic error, key compare wrong" ) ;
-               dumpIndexExtentIntoLog () ;
-               rc = SDB_SYS ;
-               goto error ;
-            }
+            PD_LOG ( PDERROR, "Internal logic error, key compare wrong" ) ;
+            dumpIndexExtentIntoLog () ;
+            rc = SDB_SYS ;
+            goto error ;
          }
          if ( pos > 0 )
          {
-            const CHAR *keyData = getKeyData( pos-1 ) ;
-            ixmKey keyDisk(keyData) ;
-            if ( keyDisk.woCompare ( key, order ) > 0 )
+            if ( _keyCompare ( key, order, normKey, pos-1 ) < 0 )
             {
                PD_LOG ( PDERROR, "Internal logic error, key compare wrong" ) ;
                dumpIndexExtentIntoLog () ;
@@ -215,6 +215,165 @@ namespace engine
       goto done ;
    }
 
+   static OSS_INLINE UINT16 _ixmNormSlice ( const UINT8 *pSlice )
+   {
+      return (UINT16)( ( pSlice[ 0 ] << 8 ) | pSlice[ 1 ] ) ;
+   }
+
+   void _ixmExtent::_setNormPrefixLen ( UINT8 prefixLen )
+   {
+      UINT8 *pHead = (UINT8*)_extRW.writePtr( 0, _pageSize ) ;
+      pHead[ _pageSize - 2 ] = prefixLen ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__IXMEXT__NORMKEYADDED, "_ixmExtent::_normKeyAdded" )
+   void _ixmExtent::_normKeyAdded ( UINT16 pos, const ixmKey &key,
+                                    const Ordering &order )
+   {
+      PD_TRACE_ENTRY ( SDB__IXMEXT__NORMKEYADDED ) ;
+      UINT8 keyBuf[ IXM_EXTENT_NORM_BUF_SIZE ] = { 0 } ;
+      UINT8 pageBuf[ IXM_EXTENT_NORM_BUF_SIZE ] = { 0 } ;
+      UINT32 length = 0 ;
+      UINT8 prefixLen = 0 ;
+      UINT8 common = 0 ;
+
+      if ( !isNormalized() )
+      {
+         goto done ;
+      }
+      if ( !key.normalize( order, keyBuf, IXM_EXTENT_NORM_BUF_SIZE,
+                           length ) )
+      {
+         _setNormPrefixLen( IXM_EXTENT_NORM_PREFIX_NONE ) ;
+         goto done ;
+      }
+      if ( 1 == getNumKeyNode() )
+      {
+         // the first key of the page, the whole key is the prefix
+         prefixLen = (UINT8)OSS_MIN( length,
+                                   (UINT32)IXM_EXTENT_NORM_PREFIX_MAX ) ;
+         _setNormPrefixLen( prefixLen ) ;
+         writeKeyNode( pos )->_normSlice = _ixmNormSlice( keyBuf +
+                                                          prefixLen ) ;
+         goto done ;
+      }
+
+      prefixLen = _normPrefixLen() ;
+      if ( IXM_EXTENT_NORM_PREFIX_NONE == prefixLen )
+      {
+         goto done ;
+      }
+      // all the other keys share the prefix, take it from a neighbour
+      ixmKey( getKeyData( 0 == pos ? 1 : 0 ) ).normalize( order, pageBuf,
+                                                          prefixLen,
+                                                          length ) ;
+      while ( common < prefixLen && keyBuf[ common ] == pageBuf[ common ] )
+      {
+         ++common ;
+      }
+      if ( common < prefixLen )
+      {
+         _normReset( common, order ) ;
+      }
+      else
+      {
+         writeKeyNode( pos )->_normSlice = _ixmNormSlice( keyBuf +
+                                                          prefixLen ) ;
+      }
+
+   done :
+      PD_TRACE_EXIT ( SDB__IXMEXT__NORMKEYADDED ) ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__IXMEXT__NORMRESET, "_ixmExtent::_normReset" )
+   void _ixmExtent::_normReset ( UINT8 prefixLen, const Ordering &order )
+   {
+      PD_TRACE_ENTRY ( SDB__IXMEXT__NORMRESET ) ;
+      UINT8 keyBuf[ IXM_EXTENT_NORM_BUF_SIZE ] ;
+      UINT32 bufSize = prefixLen + IXM_EXTENT_NORM_SLICE_SIZE ;
+      UINT32 length = 0 ;
+
+      // the prefix shrinks, so the slices of all the keys move
+      _setNormPrefixLen( prefixLen ) ;
+      for ( UINT16 i = 0 ; i < getNumKeyNode() ; ++i )
+      {
+         ossMemset( keyBuf, 0, bufSize ) ;
+         if ( !ixmKey( getKeyData( i ) ).normalize( order, keyBuf, bufSize,
+                                                    length ) )
+         {
+            _setNormPrefixLen( IXM_EXTENT_NORM_PREFIX_NONE ) ;
+            break ;
+         }
+         writeKeyNode( i )->_normSlice = _ixmNormSlice( keyBuf +
+                                                        prefixLen ) ;
+      }
+      PD_TRACE_EXIT ( SDB__IXMEXT__NORMRESET ) ;
+   }
+
+   void _ixmExtent::_normSearchKey ( const ixmKey &key, const Ordering &order,
+                                     ixmNormSearchKey &normKey ) const
+   {
+      UINT8 keyBuf[ IXM_EXTENT_NORM_BUF_SIZE ] = { 0 } ;
+      UINT8 pageBuf[ IXM_EXTENT_NORM_BUF_SIZE ] = { 0 } ;
+      UINT32 length = 0 ;
+      UINT8 prefixLen = 0 ;
+      INT32 result = 0 ;
+
+      normKey._result = 0 ;
+      normKey._hasSlice = FALSE ;
+      normKey._slice = 0 ;
+
+      if ( !isNormalized() || 0 == getNumKeyNode() )
+      {
+         return ;
+      }
+      prefixLen = _normPrefixLen() ;
+      if ( IXM_EXTENT_NORM_PREFIX_NONE == prefixLen ||
+           !key.normalize( order, keyBuf,
+                           prefixLen + IXM_EXTENT_NORM_SLICE_SIZE, length ) )
+      {
+         return ;
+      }
+      if ( prefixLen > 0 )
+      {
+         ixmKey( getKeyData( 0 ) ).normalize( order, pageBuf, prefixLen,
+                                              length ) ;
+         result = ossMemcmp( keyBuf, pageBuf, prefixLen ) ;
+         if ( 0 != result )
+         {
+            normKey._result = result < 0 ? -1 : 1 ;
+            return ;
+         }
+      }
+      normKey._hasSlice = TRUE ;
+      normKey._slice = _ixmNormSlice( keyBuf + prefixLen ) ;
+   }
+
+   /*
+      Compare the key with the key at pos, by the normalized bytes of V1
+      pages first. A normalized key which is a prefix of another one is the
+      smaller one, so the zero padded bytes keep the order of woCompare
+      when they differ, only the ties need woCompare
+   */
+   INT32 _ixmExtent::_keyCompare ( const ixmKey &key, const Ordering &order,
+                                   const ixmNormSearchKey &normKey,
+                                   UINT16 pos ) const
+   {
+      if ( 0 != normKey._result )
+      {
+         return normKey._result ;
+      }
+      if ( normKey._hasSlice )
+      {
+         UINT16 slice = getKeyNode( pos )->_normSlice ;
+         if ( normKey._slice != slice )
+         {
+            return normKey._slice < slice ? -1 : 1 ;
+         }
+      }
+      return key.woCompare( ixmKey( getKeyData( pos ) ), order ) ;
+   }
+
    INT32 _ixmExtent::insert ( const ixmKey &key, const dmsRecordID &rid,
                               const Ordering &order, BOOLEAN dupAllowed,
                               ixmIndexCB *indexCB )
@@ -345,6 +504,7 @@ namespace engine
          ossMemcpy ( ((CHAR*)pHeader) + kn->_keyOffset,
                       key.data(), datasize ) ;
       }
+      _normKeyAdded ( pos, key, order ) ;
 #if defined (_DEBUG)
       rc = _validate(MAX, order) ;
       if ( rc )
@@ -389,7 +549,8 @@ namespace engine
          goto error ;
       }
       {
-         _ixmExtent newExtent( newExtentID, _extentHead->_mbID, _pIndexSu ) ;
+         _ixmExtent newExtent( newExtentID, _extentHead->_mbID, _pIndexSu,
+                               isNormalized() ) ;
          for ( UINT16 i = splitPos + 1 ; i< getNumKeyNode() ; i++ )
          {
             const ixmKeyNode *kn = getKeyNode(i) ;
@@ -431,7 +592,7 @@ namespace engine
                goto error ;
             }
             _ixmExtent rootExtent( rootExtentID, _extentHead->_mbID,
-                                   _pIndexSu ) ;
+                                   _pIndexSu, isNormalized() ) ;
             rc = rootExtent._pushBack ( splitKey->_rid,
                                         ixmKey(((const CHAR*)_extentHead)+
                                         splitKey->_keyOffset), order, _me ) ;
@@ -657,6 +818,7 @@ namespace engine
       }
       ossMemcpy ( ((CHAR*)pHeader)+kn->_keyOffset,
                   key.data(), key.dataSize()) ;
+      _normKeyAdded ( getNumKeyNode() - 1, key, order ) ;
    done :
       PD_TRACE_EXITRC ( SDB__IXMEXT__PSHBACK, rc );
       return rc ;
@@ -664,6 +826,43 @@ namespace engine
       goto done ;
    }
 
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__IXMEXT__POPBACK, "_ixmExtent::_popBack" )
+   INT32 _ixmExtent::_popBack ()
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__IXMEXT__POPBACK );
+      ixmExtentHead *pHeader = _extRW.writePtr<ixmExtentHead>( 0, _pageSize ) ;
+      const ixmKeyNode *kn = NULL ;
+      UINT16 freeSize = sizeof(ixmKeyNode) ;
+      if ( 0 == getNumKeyNode() )
+      {
+         PD_LOG ( PDERROR, "No key to pop in extent %d", _me ) ;
+         rc = SDB_SYS ;
+         goto error ;
+      }
+      kn = getKeyNode ( getNumKeyNode() - 1 ) ;
+      // the key data can be reclaimed only when it's the last allocated one,
+      // otherwise leave it to reorg
+      if ( kn->_keyOffset == pHeader->_beginFreeOffset )
+      {
+         UINT16 keySize = ixmKey( getKeyData( getNumKeyNode() - 1 ) ).dataSize() ;
+         pHeader->_beginFreeOffset += keySize ;
+         freeSize += keySize ;
+      }
+      else
+      {
+         unsetCompact() ;
+      }
+      pHeader->_totalKeyNodeNum-- ;
+      pHeader->_totalFreeSize += freeSize ;
+      _pIndexSu->addStatFreeSpace( pHeader->_mbID, freeSize ) ;
+   done :
+      PD_TRACE_EXITRC ( SDB__IXMEXT__POPBACK, rc );
+      return rc ;
+   error :
+      goto done ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB__IXMEXT__VALIDATE2, "_ixmExtent::_validate" )
    INT32 _ixmExtent::_validate( ixmIndexCB *indexCB, dmsExtentID parent )
    {
@@ -812,7 +1011,7 @@ namespace engine
       PD_TRACE_ENTRY ( SDB__IXMEXT__REORG );
 
       ixmExtentHead *pHeader = NULL ;
-      UINT16 beginFreeOffset = _pageSize-1 ;
+      UINT16 beginFreeOffset = _keyDataEnd() ;
       UINT16 totalKeyNodeNum = 0 ;
       UINT16 totalFreeSize = beginFreeOffset - sizeof(ixmExtentHead) ;
       CHAR   buffer[DMS_PAGE_SIZE_MAX] ;
@@ -883,7 +1082,7 @@ namespace engine
                                    pHeader->_totalFreeSize ) ;
       ossMemcpy ( ((CHAR*)pHeader)+beginFreeOffset,
                   &buffer[beginFreeOffset],
-                  _pageSize - beginFreeOffset ) ;
+                  _keyDataEnd() - beginFreeOffset ) ;
 #if defined (_DEBUG)
       rc = _validate(MAX, order) ;
 #else
@@ -1687,7 +1886,7 @@ namespace engine
       INT32 rc = SDB_OK ;
       PD_TRACE_ENTRY ( SDB__IXMEXT_TRUNC );
       dmsExtentID childExtentID = DMS_INVALID_EXTENT ;
-      UINT16 totalFreeSize = _pageSize - 1 - sizeof(ixmExtentHead) ;
+      UINT16 totalFreeSize = _keyDataEnd() - sizeof(ixmExtentHead) ;
       dmsPageMap *pPageMap = _pIndexSu->getPageMap( getMBID() ) ;
 
       rc = _validate( indexCB, parent ) ;
@@ -1745,7 +1944,7 @@ namespace engine
       {
          ixmExtentHead *pHeader = _extRW.writePtr<ixmExtentHead>() ;
          pHeader->_totalKeyNodeNum = 0 ;
-         pHeader->_beginFreeOffset = _pageSize - 1 ;
+         pHeader->_beginFreeOffset = _keyDataEnd() ;
          pHeader->_totalFreeSize = totalFreeSize ;
       }
       _pIndexSu->addStatFreeSpace( _extentHead->_mbID, totalFreeSize ) ;
@@ -2198,6 +2397,254 @@ namespace engine
       goto done ;
    }
 
+   /*
+      _ixmBulkLoader implement
+   */
+   _ixmBulkLoader::_ixmBulkLoader ( ixmIndexCB *indexCB,
+                                    dmsStorageIndex *pIndexSu,
+                                    const Ordering &order,
+                                    UINT32 fillFactor )
+   : _indexCB( indexCB ),
+     _pIndexSu( pIndexSu ),
+     _order( order )
+   {
+      SDB_ASSERT ( indexCB, "index control block can't be NULL" ) ;
+      SDB_ASSERT ( pIndexSu, "index su can't be NULL" ) ;
+
+      if ( fillFactor < IXM_BULK_MIN_FILL_FACTOR )
+      {
+         fillFactor = IXM_BULK_MIN_FILL_FACTOR ;
+      }
+      else if ( fillFactor > IXM_BULK_MAX_FILL_FACTOR )
+      {
+         fillFactor = IXM_BULK_MAX_FILL_FACTOR ;
+      }
+      _fillSize = ( pIndexSu->pageSize() - 1 - sizeof(ixmExtentHead) ) *
+                  fillFactor / 100 ;
+      _levelNum = 0 ;
+      _keyNum = 0 ;
+      _finished = FALSE ;
+      for ( UINT32 i = 0 ; i < IXM_BULK_MAX_LEVEL ; ++i )
+      {
+         _levels[ i ] = DMS_INVALID_EXTENT ;
+      }
+   }
+
+   _ixmBulkLoader::~_ixmBulkLoader ()
+   {
+      SDB_ASSERT ( 0 == _levelNum || _finished,
+                   "bulk loader must be finished" ) ;
+   }
+
+   BOOLEAN _ixmBulkLoader::isIndexEmpty ( ixmIndexCB *indexCB,
+                                          dmsStorageIndex *pIndexSu )
+   {
+      dmsExtentID root = indexCB->getRoot() ;
+      if ( DMS_INVALID_EXTENT == root )
+      {
+         return FALSE ;
+      }
+      ixmExtent rootExtent ( root, pIndexSu ) ;
+      return 0 == rootExtent.getNumKeyNode() &&
+             DMS_INVALID_EXTENT == rootExtent.getChildExtentID( 0 ) ;
+   }
+
+   INT32 _ixmBulkLoader::init ()
+   {
+      INT32 rc = SDB_OK ;
+
+      PD_CHECK ( isIndexEmpty( _indexCB, _pIndexSu ), SDB_SYS, error, PDERROR,
+                 "Index must be empty before bulk load" ) ;
+
+      // the empty root becomes the first leaf
+      _levels[ 0 ] = _indexCB->getRoot() ;
+      _levelNum = 1 ;
+      _keyNum = 0 ;
+      _finished = FALSE ;
+
+   done :
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   INT32 _ixmBulkLoader::_newExtent ( UINT32 level )
+   {
+      INT32 rc = SDB_OK ;
+      dmsExtentID extentID = DMS_INVALID_EXTENT ;
+
+      rc = _indexCB->allocExtent ( extentID ) ;
+      if ( rc )
+      {
+         PD_LOG ( PDERROR, "Failed to allocate new extent for index, rc = %d",
+                  rc ) ;
+         goto error ;
+      }
+      {
+         // initialize the extent head
+         _ixmExtent newExtent( extentID, _indexCB->getMBID(), _pIndexSu,
+                               _indexCB->normalizedKey() ) ;
+      }
+      _levels[ level ] = extentID ;
+
+   done :
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__IXMBULKLOADER__APPEND, "_ixmBulkLoader::_append" )
+   INT32 _ixmBulkLoader::_append ( UINT32 level, const dmsRecordID &rid,
+                                   const ixmKey &key, dmsExtentID left )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__IXMBULKLOADER__APPEND ) ;
+      UINT32 needed = key.dataSize() + sizeof(ixmKeyNode) ;
+
+      if ( level >= _levelNum )
+      {
+         PD_CHECK ( level < IXM_BULK_MAX_LEVEL, SDB_SYS, error, PDERROR,
+                    "Too many levels in index: %u", level ) ;
+         rc = _newExtent( level ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         _levelNum = level + 1 ;
+      }
+
+      {
+         ixmExtent extent( _levels[ level ], _pIndexSu ) ;
+         UINT32 freeSize = extent.getFreeSize() ;
+         UINT32 usedSize = _pIndexSu->pageSize() - 1 -
+                           sizeof(ixmExtentHead) - freeSize ;
+
+         // keep at least one key in the page after the last key is promoted
+         if ( extent.getNumKeyNode() >= 2 &&
+              ( usedSize + needed > _fillSize || needed > freeSize ) )
+         {
+            UINT16 last = extent.getNumKeyNode() - 1 ;
+            const ixmKeyNode *kn = extent.getKeyNode( last ) ;
+            dmsExtentID lastLeft = kn->_left ;
+
+            // promote the last key, the page becomes its left child, and
+            // the left child of the key becomes the right-most child of the
+            // page
+            rc = _append( level + 1, kn->_rid,
+                          ixmKey( extent.getKeyData( last ) ), _levels[ level ] ) ;
+            if ( rc )
+            {
+               goto error ;
+            }
+            rc = extent._popBack() ;
+            if ( rc )
+            {
+               PD_LOG ( PDERROR, "Failed to pop key from extent %d, rc = %d",
+                        _levels[ level ], rc ) ;
+               goto error ;
+            }
+            extent._assignRight( lastLeft ) ;
+
+            rc = _newExtent( level ) ;
+            if ( rc )
+            {
+               goto error ;
+            }
+         }
+      }
+
+      {
+         ixmExtent extent( _levels[ level ], _pIndexSu ) ;
+         rc = extent._pushBack( rid, key, _order, left ) ;
+         if ( rc )
+         {
+            PD_LOG ( PDERROR, "Failed to push back key to extent %d, rc = %d",
+                     _levels[ level ], rc ) ;
+            goto error ;
+         }
+      }
+
+   done :
+      PD_TRACE_EXITRC ( SDB__IXMBULKLOADER__APPEND, rc ) ;
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   INT32 _ixmBulkLoader::append ( const ixmKey &key, const dmsRecordID &rid )
+   {
+      INT32 rc = SDB_OK ;
+
+      SDB_ASSERT ( _levelNum > 0 && !_finished, "bulk loader is not ready" ) ;
+
+      if ( key.dataSize() >= IXM_KEY_MAX_SIZE )
+      {
+         PD_LOG ( PDERROR, "key size must be less than %d", IXM_KEY_MAX_SIZE ) ;
+         rc = SDB_IXM_KEY_TOO_LARGE ;
+         goto error ;
+      }
+      if ( key.dataSize() <= 0 )
+      {
+         PD_LOG ( PDERROR, "key size must be greater than 0" ) ;
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+
+      rc = _append( 0, rid, key, DMS_INVALID_EXTENT ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+      ++_keyNum ;
+
+   done :
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__IXMBULKLOADER_FINISH, "_ixmBulkLoader::finish" )
+   INT32 _ixmBulkLoader::finish ()
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__IXMBULKLOADER_FINISH ) ;
+      dmsExtentID child = DMS_INVALID_EXTENT ;
+      dmsExtentID root = DMS_INVALID_EXTENT ;
+
+      if ( _finished || 0 == _levelNum )
+      {
+         goto done ;
+      }
+
+      // the right-most page of each level is the right-most child of the
+      // right-most page of the upper level
+      for ( UINT32 level = 0 ; level < _levelNum ; ++level )
+      {
+         ixmExtent extent( _levels[ level ], _pIndexSu ) ;
+         if ( level > 0 )
+         {
+            extent._assignRight( child ) ;
+         }
+         child = _levels[ level ] ;
+      }
+
+      root = _levels[ _levelNum - 1 ] ;
+      if ( root != _indexCB->getRoot() )
+      {
+         ixmExtent rootExtent( root, _pIndexSu ) ;
+         rootExtent.setParent( DMS_INVALID_EXTENT ) ;
+         _indexCB->setRoot( root ) ;
+      }
+      _finished = TRUE ;
+
+      PD_LOG ( PDDEBUG, "Bulk loaded %llu keys into %u levels", _keyNum,
+               _levelNum ) ;
+
+   done :
+      PD_TRACE_EXITRC ( SDB__IXMBULKLOADER_FINISH, rc ) ;
+      return rc ;
+   }
+
 }
 
 
@@ -564,4 +564,169 @@ namespace engine
       } while ( more ) ;
       return p - _keyData ;
    }
+
+   /*
+      _ixmNormWriter define
+   */
+   struct _ixmNormWriter
+   {
+      UINT8    *_pBuf ;
+      UINT32   _bufSize ;
+      UINT32   _length ;
+      UINT8    _mask ;
+
+      OSS_INLINE void put ( UINT8 byte )
+      {
+         if ( _length < _bufSize )
+         {
+            _pBuf[ _length ] = byte ^ _mask ;
+         }
+         ++_length ;
+      }
+      OSS_INLINE void putUInt64 ( UINT64 value )
+      {
+         for ( INT32 shift = 56 ; shift >= 0 ; shift -= 8 )
+         {
+            put( (UINT8)( value >> shift ) ) ;
+         }
+      }
+      OSS_INLINE BOOLEAN isFull () const
+      {
+         return _length >= _bufSize ;
+      }
+   } ;
+
+   // the elements are encoded to be prefix-free, so the concatenation of
+   // them keeps the order, and a key with more elements is greater, which
+   // is the same as woCompare. All the bytes of a descending element are
+   // inverted
+   static void _ixmNormalize ( const UINT8 *p, const Ordering &o,
+                               _ixmNormWriter &writer, BOOLEAN prefixOnly )
+   {
+      UINT32 mask = 1 ;
+      while ( TRUE )
+      {
+         UINT8 bits = *p++ ;
+         UINT32 type = bits & cCANONTYPEMASK ;
+
+         writer._mask = o.descending( mask ) ? 0xFF : 0 ;
+         writer.put( (UINT8)type ) ;
+         switch ( type )
+         {
+         case cdouble:
+         {
+            FLOAT64 d = (reinterpret_cast< const PackedDouble* >(p))->d ;
+            UINT64 value = 0 ;
+            if ( 0 == d )
+            {
+               // -0.0 equals to 0.0
+               d = 0 ;
+            }
+            ossMemcpy( &value, &d, sizeof(FLOAT64) ) ;
+            value = ( value & 0x8000000000000000ULL ) ?
+                    ~value : ( value | 0x8000000000000000ULL ) ;
+            writer.putUInt64( value ) ;
+            p += sizeof(FLOAT64) ;
+            break ;
+         }
+         case cstring:
+         {
+            UINT32 len = *p++ ;
+            for ( UINT32 i = 0 ; i < len && !( prefixOnly &&
+                                                 writer.isFull() ) ; ++i )
+            {
+               writer.put( p[ i ] ) ;
+               if ( 0 == p[ i ] )
+               {
+                  writer.put( 0xFF ) ;
+               }
+            }
+            writer.put( 0 ) ;
+            writer.put( 0 ) ;
+            p += len ;
+            break ;
+         }
+         case cbindata:
+         {
+            INT32 len = binDataCodeToLength( *p ) ;
+            writer.put( (UINT8)len ) ;
+            writer.put( *p++ ) ;
+            for ( INT32 i = 0 ; i < len ; ++i )
+            {
+               writer.put( p[ i ] ) ;
+            }
+            p += len ;
+            break ;
+         }
+         case coid:
+            for ( UINT32 i = 0 ; i < sizeof(OID) ; ++i )
+            {
+               writer.put( p[ i ] ) ;
+            }
+            p += sizeof(OID) ;
+            break ;
+         case cdate:
+         {
+            INT64 value = 0 ;
+            ossMemcpy( &value, p, sizeof(INT64) ) ;
+            writer.putUInt64( (UINT64)value ^ 0x8000000000000000ULL ) ;
+            p += sizeof(INT64) ;
+            break ;
+         }
+         default:
+            break ;
+         }
+         if ( ( bits & cHASMORE ) == 0 ||
+              ( prefixOnly && writer.isFull() ) )
+         {
+            break ;
+         }
+         mask <<= 1 ;
+      }
+      writer._mask = 0 ;
+   }
+
+   BOOLEAN _ixmKey::normalize ( const Ordering &o, UINT8 *pBuf,
+                                UINT32 bufSize, UINT32 &length ) const
+   {
+      _ixmNormWriter writer ;
+
+      length = 0 ;
+      if ( NULL == _keyData || !isCompactFormat() )
+      {
+         return FALSE ;
+      }
+
+      writer._pBuf = pBuf ;
+      writer._bufSize = bufSize ;
+      writer._length = 0 ;
+      writer._mask = 0 ;
+      _ixmNormalize( _keyData, o, writer, FALSE ) ;
+      length = writer._length ;
+      return TRUE ;
+   }
+
+   UINT64 _ixmKey::normalizedPrefix ( const Ordering &o ) const
+   {
+      UINT8 buf[ IXM_KEY_NORM_PREFIX_SIZE ] = { 0 } ;
+      UINT64 prefix = 0 ;
+      _ixmNormWriter writer ;
+
+      if ( NULL == _keyData || !isCompactFormat() )
+      {
+         return 0 ;
+      }
+
+      writer._pBuf = buf ;
+      writer._bufSize = IXM_KEY_NORM_PREFIX_SIZE ;
+      writer._length = 0 ;
+      writer._mask = 0 ;
+      _ixmNormalize( _keyData, o, writer, TRUE ) ;
+
+      for ( UINT32 i = 0 ; i < IXM_KEY_NORM_PREFIX_SIZE ; ++i )
+      {
+         prefix = ( prefix << 8 ) | buf[ i ] ;
+      }
+      return prefix ;
+   }
 }
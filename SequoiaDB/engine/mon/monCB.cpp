@@ -154,6 +154,11 @@ namespace engine
       totalSelect               = rhs.totalSelect ;
       totalRead                 = rhs.totalRead ;
 
+      compressWireIn            = rhs.compressWireIn ;
+      compressRawIn             = rhs.compressRawIn ;
+      compressWireOut           = rhs.compressWireOut ;
+      compressRawOut            = rhs.compressRawOut ;
+
       totalReadTime             = rhs.totalReadTime ;
       totalWriteTime            = rhs.totalWriteTime ;
       _connectTimestamp         = rhs._connectTimestamp ;
@@ -185,6 +190,11 @@ namespace engine
       totalSelect                += rhs.totalSelect ;
       totalRead                  += rhs.totalRead ;
 
+      compressWireIn             += rhs.compressWireIn ;
+      compressRawIn              += rhs.compressRawIn ;
+      compressWireOut            += rhs.compressWireOut ;
+      compressRawOut             += rhs.compressRawOut ;
+
       totalReadTime              += rhs.totalReadTime ;
       totalWriteTime             += rhs.totalWriteTime ;
 
@@ -209,6 +219,11 @@ namespace engine
       totalSelect = 0 ;
       totalRead  = 0 ;
 
+      compressWireIn = 0 ;
+      compressRawIn = 0 ;
+      compressWireOut = 0 ;
+      compressRawOut = 0 ;
+
       totalReadTime.clear() ;
       totalWriteTime.clear() ;
 
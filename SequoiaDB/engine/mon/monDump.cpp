@@ -60,6 +60,7 @@
 #include "pmdEnv.hpp"
 #include "utilEnvCheck.hpp"
 #include "pmdStartupHistoryLogger.hpp"
+#include "msgCompress.hpp"
 
 using namespace bson ;
 
@@ -789,6 +790,14 @@ namespace engine
       ob.append( FIELD_NAME_TOTALINSERT, (SINT64)full._monApplCB.totalInsert ) ;
       ob.append( FIELD_NAME_TOTALSELECT, (SINT64)full._monApplCB.totalSelect ) ;
       ob.append( FIELD_NAME_TOTALREAD, (SINT64)full._monApplCB.totalRead ) ;
+      ob.append( FIELD_NAME_COMPRESS_NETIN,
+                 (SINT64)full._monApplCB.compressWireIn ) ;
+      ob.append( FIELD_NAME_COMPRESS_RAWIN,
+                 (SINT64)full._monApplCB.compressRawIn ) ;
+      ob.append( FIELD_NAME_COMPRESS_NETOUT,
+                 (SINT64)full._monApplCB.compressWireOut ) ;
+      ob.append( FIELD_NAME_COMPRESS_RAWOUT,
+                 (SINT64)full._monApplCB.compressRawOut ) ;
 
       full._monApplCB.totalReadTime.convertToTime ( factor,
                                                     seconds,
@@ -915,6 +924,8 @@ namespace engine
                         indexObj.getBoolField(IXM_DROPDUP_FIELD) ) ;
             ob.append ( IXM_ENFORCED_FIELD,
                         indexObj.getBoolField(IXM_ENFORCED_FIELD) ) ;
+            ob.append ( IXM_NORMALIZED_KEY_FIELD,
+                        indexObj[IXM_NORMALIZED_KEY_FIELD].trueValue() ) ;
             BSONObj range = indexObj.getObjectField( IXM_2DRANGE_FIELD ) ;
             if ( !range.isEmpty() )
             {
@@ -1302,6 +1313,14 @@ namespace engine
             ob.append( FIELD_NAME_REPL_NETIN, pReplCB->netIn() ) ;
             ob.append( FIELD_NAME_REPL_NETOUT, pReplCB->netOut() ) ;
          }
+
+         msgCompressStat *pStat = msgGetCompressStat() ;
+         ob.append( FIELD_NAME_COMPRESS_NETIN, (INT64)pStat->_wireIn.peek() ) ;
+         ob.append( FIELD_NAME_COMPRESS_RAWIN, (INT64)pStat->_rawIn.peek() ) ;
+         ob.append( FIELD_NAME_COMPRESS_NETOUT,
+                    (INT64)pStat->_wireOut.peek() ) ;
+         ob.append( FIELD_NAME_COMPRESS_RAWOUT,
+                    (INT64)pStat->_rawOut.peek() ) ;
       }
       catch ( std::exception &e )
       {
@@ -1339,6 +1358,54 @@ namespace engine
       goto done ;
    }
 
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_MONDBDUMPTRANSLOCKINFO, "monDBDumpTransLockInfo" )
+   INT32 monDBDumpTransLockInfo( BSONObjBuilder &ob )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB_MONDBDUMPTRANSLOCKINFO ) ;
+      try
+      {
+         BSONObjBuilder lockOb( ob.subobjStart( FIELD_NAME_TRANS_LOCK_STAT ) ) ;
+         pmdGetKRCB()->getTransCB()->dumpLockStat( lockOb ) ;
+         lockOb.done() ;
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "Ocurr exception: %s", e.what() ) ;
+         rc = SDB_SYS ;
+         goto error ;
+      }
+   done:
+      PD_TRACE_EXITRC ( SDB_MONDBDUMPTRANSLOCKINFO, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_MONDBDUMPREADAHEADINFO, "monDBDumpReadAheadInfo" )
+   INT32 monDBDumpReadAheadInfo( BSONObjBuilder &ob )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB_MONDBDUMPREADAHEADINFO ) ;
+      try
+      {
+         BSONObjBuilder raOb( ob.subobjStart( FIELD_NAME_READ_AHEAD_STAT ) ) ;
+         pmdGetKRCB()->getBPSCB()->getReadAheadStat()->toBSON( raOb ) ;
+         raOb.done() ;
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "Ocurr exception: %s", e.what() ) ;
+         rc = SDB_SYS ;
+         goto error ;
+      }
+   done:
+      PD_TRACE_EXITRC ( SDB_MONDBDUMPREADAHEADINFO, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB_MONDBDUMPLASTOPINFO, "monDumpLastOpInfo" )
    INT32 monDumpLastOpInfo( BSONObjBuilder &ob, const monAppCB &moncb )
    {
@@ -2629,6 +2696,8 @@ namespace engine
 
          monDBDump ( ob, mondbcb, factor, userTime, sysTime ) ;
          monDBDumpLogInfo( ob ) ;
+         monDBDumpTransLockInfo( ob ) ;
+         monDBDumpReadAheadInfo( ob ) ;
          monDBDumpProcMemInfo( ob ) ;
          monDBDumpStorageInfo( ob ) ;
          monDBDumpNetInfo( ob ) ;
@@ -3117,6 +3186,8 @@ namespace engine
                       indexObj.getBoolField( IXM_DROPDUP_FIELD ) ) ;
          sub.append ( IXM_ENFORCED_FIELD,
                       indexObj.getBoolField( IXM_ENFORCED_FIELD ) ) ;
+         sub.append ( IXM_NORMALIZED_KEY_FIELD,
+                      indexObj[IXM_NORMALIZED_KEY_FIELD].trueValue() ) ;
          BSONObj range = indexObj.getObjectField( IXM_2DRANGE_FIELD ) ;
          if ( !range.isEmpty() )
          {
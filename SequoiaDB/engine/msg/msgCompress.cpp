@@ -0,0 +1,265 @@
+/*******************************************************************************
+
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = msgCompress.cpp
+
+   Descriptive Name = Message Compression
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of MSG component. This file contains functions to wrap a
+   message into MSG_COM_COMPRESSED and to restore it.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#include "msgCompress.hpp"
+#include "utilCompressor.hpp"
+#include "ossMem.hpp"
+#include "pd.hpp"
+#include "pdTrace.hpp"
+#include "msgTrace.hpp"
+
+namespace engine
+{
+
+   static msgCompressStat  s_compressStat ;
+   static volatile INT32   s_compressType = UTIL_COMPRESSOR_INVALID ;
+   static volatile UINT32  s_compressThreshold = MSG_COMPRESS_DFT_THRESHOLD ;
+
+   msgCompressStat* msgGetCompressStat()
+   {
+      return &s_compressStat ;
+   }
+
+   void msgSetCompressConf( UTIL_COMPRESSOR_TYPE type, UINT32 threshold )
+   {
+      s_compressType = msgIsValidCompressType( type ) ?
+                       type : UTIL_COMPRESSOR_INVALID ;
+      s_compressThreshold = threshold ;
+   }
+
+   UTIL_COMPRESSOR_TYPE msgGetCompressType()
+   {
+      return (UTIL_COMPRESSOR_TYPE)s_compressType ;
+   }
+
+   UINT32 msgGetCompressThreshold()
+   {
+      return s_compressThreshold ;
+   }
+
+   BOOLEAN msgIsValidCompressType( INT32 type )
+   {
+      return UTIL_COMPRESSOR_SNAPPY == type ||
+             UTIL_COMPRESSOR_LZ4 == type ||
+             UTIL_COMPRESSOR_ZLIB == type ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_MSGCOMPRESS, "msgCompress" )
+   INT32 msgCompress( INT32 type, const CHAR *pRaw, UINT32 rawLen,
+                      const CHAR *pData, UINT32 dataLen,
+                      CHAR **ppOut, UINT32 &outLen )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB_MSGCOMPRESS ) ;
+      utilCompressor *pCompressor = NULL ;
+      utilCompressStrategy strategy ;
+      MsgComCompressed *pMsg = NULL ;
+      const MsgHeader *pHeader = ( const MsgHeader* )pRaw ;
+      UINT32 bound = 0 ;
+      UINT32 compLen = 0 ;
+      CHAR *pOut = NULL ;
+
+      SDB_ASSERT( rawLen >= sizeof( MsgHeader ), "Raw part is too short" ) ;
+
+      if ( !msgIsValidCompressType( type ) )
+      {
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+      pCompressor = getCompressorByType( (UTIL_COMPRESSOR_TYPE)type ) ;
+      if ( !pCompressor )
+      {
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+
+      rc = pCompressor->compressBound( dataLen, bound ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to get the compress bound, rc: %d",
+                   rc ) ;
+
+      pOut = ( CHAR* )SDB_OSS_MALLOC( sizeof( MsgComCompressed ) + rawLen +
+                                      bound ) ;
+      if ( !pOut )
+      {
+         PD_LOG( PDERROR, "Failed to alloc compress buffer[%u]",
+                 sizeof( MsgComCompressed ) + rawLen + bound ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+
+      strategy._minRatio = MSG_COMPRESS_MIN_RATIO ;
+      strategy._level = UTIL_COMP_BEST_SPEED ;
+      compLen = bound ;
+      rc = pCompressor->compress( pData, dataLen,
+                                  pOut + sizeof( MsgComCompressed ) + rawLen,
+                                  compLen, NULL, &strategy ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+      // not all the compressors check the ratio
+      else if ( (UINT64)compLen * 100 >
+                (UINT64)dataLen * MSG_COMPRESS_MIN_RATIO )
+      {
+         rc = SDB_UTIL_COMPRESS_ABORT ;
+         goto error ;
+      }
+
+      ossMemcpy( pOut + sizeof( MsgComCompressed ), pRaw, rawLen ) ;
+
+      pMsg = ( MsgComCompressed* )pOut ;
+      ossMemset( pMsg, 0, sizeof( MsgComCompressed ) ) ;
+      pMsg->header.messageLength = sizeof( MsgComCompressed ) + rawLen +
+                                   compLen ;
+      pMsg->header.opCode = MSG_COM_COMPRESSED ;
+      pMsg->header.TID = pHeader->TID ;
+      pMsg->header.routeID = pHeader->routeID ;
+      pMsg->header.requestID = pHeader->requestID ;
+      pMsg->originalLen = rawLen + dataLen ;
+      pMsg->rawLen = rawLen ;
+      pMsg->compressorType = (UINT8)type ;
+
+      outLen = pMsg->header.messageLength ;
+      *ppOut = pOut ;
+
+      s_compressStat._wireOut.add( outLen ) ;
+      s_compressStat._rawOut.add( rawLen + dataLen ) ;
+
+   done:
+      PD_TRACE_EXITRC ( SDB_MSGCOMPRESS, rc ) ;
+      return rc ;
+   error:
+      if ( pOut )
+      {
+         SDB_OSS_FREE( pOut ) ;
+      }
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_MSGUNCOMPRESS, "msgUncompress" )
+   INT32 msgUncompress( const MsgHeader *pMsg, CHAR *pOut, UINT32 outSize )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB_MSGUNCOMPRESS ) ;
+      const MsgComCompressed *pComp = ( const MsgComCompressed* )pMsg ;
+      utilCompressor *pCompressor = NULL ;
+      const CHAR *pData = NULL ;
+      UINT32 compLen = 0 ;
+      UINT32 dataLen = 0 ;
+
+      if ( (UINT32)pMsg->messageLength < sizeof( MsgComCompressed ) ||
+           pComp->rawLen < (INT32)sizeof( MsgHeader ) ||
+           pComp->originalLen < pComp->rawLen ||
+           (UINT32)pComp->originalLen > SDB_MAX_MSG_LENGTH ||
+           (UINT32)pMsg->messageLength - sizeof( MsgComCompressed ) <=
+           (UINT32)pComp->rawLen )
+      {
+         PD_LOG( PDERROR, "Invalid compressed message[length: %d, raw "
+                 "length: %d, original length: %d]", pMsg->messageLength,
+                 pComp->rawLen, pComp->originalLen ) ;
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+      else if ( outSize < (UINT32)pComp->originalLen )
+      {
+         rc = SDB_UTIL_DECOMPRESS_BUFF_SMALL ;
+         goto error ;
+      }
+
+      pCompressor = msgIsValidCompressType( pComp->compressorType ) ?
+                    getCompressorByType(
+                       (UTIL_COMPRESSOR_TYPE)pComp->compressorType ) : NULL ;
+      if ( !pCompressor )
+      {
+         PD_LOG( PDERROR, "Invalid compressor type[%d] of message",
+                 pComp->compressorType ) ;
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+
+      pData = pComp->data + pComp->rawLen ;
+      compLen = pMsg->messageLength - sizeof( MsgComCompressed ) -
+                pComp->rawLen ;
+      rc = pCompressor->getUncompressedLen( pData, compLen, dataLen ) ;
+      if ( SDB_OK == rc &&
+           dataLen != (UINT32)( pComp->originalLen - pComp->rawLen ) )
+      {
+         rc = SDB_UTIL_DECOMPRESS_FAIL ;
+      }
+      PD_RC_CHECK( rc, PDERROR, "Invalid uncompressed length[%u] of "
+                   "message, expect: %d, rc: %d", dataLen,
+                   pComp->originalLen - pComp->rawLen, rc ) ;
+
+      ossMemcpy( pOut, pComp->data, pComp->rawLen ) ;
+      rc = pCompressor->decompress( pData, compLen, pOut + pComp->rawLen,
+                                    dataLen ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to uncompress message, rc: %d",
+                   rc ) ;
+
+      if ( ( (MsgHeader*)pOut )->messageLength != pComp->originalLen )
+      {
+         PD_LOG( PDERROR, "Length[%d] of the uncompressed message is not "
+                 "the same as the original length[%d]",
+                 ( (MsgHeader*)pOut )->messageLength, pComp->originalLen ) ;
+         rc = SDB_UTIL_DECOMPRESS_FAIL ;
+         goto error ;
+      }
+
+      s_compressStat._wireIn.add( pMsg->messageLength ) ;
+      s_compressStat._rawIn.add( pComp->originalLen ) ;
+
+   done:
+      PD_TRACE_EXITRC ( SDB_MSGUNCOMPRESS, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   void msgBuildCompressNego( MsgComCompressNego &nego, INT32 opCode,
+                              INT32 type, UINT32 threshold )
+   {
+      ossMemset( &nego, 0, sizeof( nego ) ) ;
+      nego.header.messageLength = sizeof( MsgComCompressNego ) ;
+      nego.header.opCode = opCode ;
+      nego.header.routeID.value = MSG_INVALID_ROUTEID ;
+      nego.compressorType = type ;
+      nego.threshold = threshold ;
+   }
+
+}
+
@@ -0,0 +1,428 @@
+/*******************************************************************************
+
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = mthColumnFilter.cpp
+
+   Descriptive Name = Matcher Column Filter
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of Matcher component. This file contains functions for the
+   columnar filter.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#include "mthColumnFilter.hpp"
+#include "mthMatchNode.hpp"
+#include "pdTrace.hpp"
+#include "mthTrace.hpp"
+#include <sstream>
+
+using namespace bson ;
+
+namespace engine
+{
+
+   // integers out of this range can't be represented exactly by double
+   #define MTH_COLUMN_MAX_EXACT_INT          ( 9007199254740992LL )
+
+   /*
+      _mthColumnFilter implement
+   */
+   _mthColumnFilter::_mthColumnFilter()
+   {
+      clear() ;
+   }
+
+   _mthColumnFilter::~_mthColumnFilter()
+   {
+   }
+
+   void _mthColumnFilter::clear()
+   {
+      for ( UINT32 i = 0 ; i < MTH_COLUMN_MAX_FIELD_NUM ; ++i )
+      {
+         _fieldNames[ i ].clear() ;
+      }
+      _isValid = TRUE ;
+      _fieldNum = 0 ;
+      _predNum = 0 ;
+      _inValues.clear() ;
+   }
+
+   BOOLEAN _mthColumnFilter::_toNumber( const BSONElement &ele,
+                                        FLOAT64 &value )
+   {
+      switch ( ele.type() )
+      {
+         case NumberInt :
+            value = (FLOAT64)ele._numberInt() ;
+            return TRUE ;
+         case NumberLong :
+         {
+            INT64 v = ele._numberLong() ;
+            if ( v > MTH_COLUMN_MAX_EXACT_INT ||
+                 v < -MTH_COLUMN_MAX_EXACT_INT )
+            {
+               return FALSE ;
+            }
+            value = (FLOAT64)v ;
+            return TRUE ;
+         }
+         case NumberDouble :
+            value = ele._numberDouble() ;
+            // NaN has its own order in BSON compare
+            return value == value ? TRUE : FALSE ;
+         default :
+            break ;
+      }
+      return FALSE ;
+   }
+
+   INT32 _mthColumnFilter::_getColumn( const CHAR *fieldName )
+   {
+      UINT32 i = 0 ;
+      for ( i = 0 ; i < _fieldNum ; ++i )
+      {
+         if ( 0 == ossStrcmp( _fieldNames[ i ].c_str(), fieldName ) )
+         {
+            return (INT32)i ;
+         }
+      }
+      if ( _fieldNum >= MTH_COLUMN_MAX_FIELD_NUM )
+      {
+         return -1 ;
+      }
+      _fieldNames[ _fieldNum ] = fieldName ;
+      return (INT32)( _fieldNum++ ) ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__MTHCOLFILTER_ADDPRED, "_mthColumnFilter::addPredicate" )
+   BOOLEAN _mthColumnFilter::addPredicate( const CHAR *fieldName,
+                                           INT32 opType,
+                                           const BSONElement &value )
+   {
+      PD_TRACE_ENTRY( SDB__MTHCOLFILTER_ADDPRED ) ;
+      BOOLEAN added = FALSE ;
+      INT32 column = -1 ;
+      mthColumnPred pred ;
+
+      if ( !_isValid || _predNum >= MTH_COLUMN_MAX_PRED_NUM ||
+           NULL == fieldName || NULL != ossStrchr( fieldName, '.' ) )
+      {
+         goto done ;
+      }
+
+      pred._opType = opType ;
+      pred._value = 0.0 ;
+      pred._inStart = 0 ;
+      pred._inNum = 0 ;
+
+      switch ( opType )
+      {
+         case EN_MATCH_OPERATOR_ET :
+         case EN_MATCH_OPERATOR_LT :
+         case EN_MATCH_OPERATOR_LTE :
+         case EN_MATCH_OPERATOR_GT :
+         case EN_MATCH_OPERATOR_GTE :
+            if ( !_toNumber( value, pred._value ) )
+            {
+               goto done ;
+            }
+            break ;
+         case EN_MATCH_OPERATOR_IN :
+         {
+            if ( Array != value.type() )
+            {
+               goto done ;
+            }
+            pred._inStart = _inValues.size() ;
+            BSONObjIterator itr( value.embeddedObject() ) ;
+            while ( itr.more() )
+            {
+               FLOAT64 v = 0.0 ;
+               if ( pred._inNum >= MTH_COLUMN_MAX_IN_NUM ||
+                    !_toNumber( itr.next(), v ) )
+               {
+                  _inValues.resize( pred._inStart ) ;
+                  goto done ;
+               }
+               _inValues.push_back( v ) ;
+               ++pred._inNum ;
+            }
+            // $in:[] matches empty arrays, leave it to the match tree
+            if ( 0 == pred._inNum )
+            {
+               goto done ;
+            }
+            break ;
+         }
+         default :
+            goto done ;
+      }
+
+      column = _getColumn( fieldName ) ;
+      if ( column < 0 )
+      {
+         goto done ;
+      }
+      pred._column = (UINT32)column ;
+      _preds[ _predNum++ ] = pred ;
+      added = TRUE ;
+
+   done:
+      PD_TRACE_EXIT( SDB__MTHCOLFILTER_ADDPRED ) ;
+      return added ;
+   }
+
+   void _mthColumnFilter::extractRow( const BSONObj &obj,
+                                      _mthColumnBatch &batch,
+                                      UINT32 row ) const
+   {
+      UINT32 found = 0 ;
+      UINT32 foundMask = 0 ;
+      UINT8 valid = 1 ;
+
+      BSONObjIterator itr( obj ) ;
+      while ( itr.more() && found < _fieldNum )
+      {
+         BSONElement ele = itr.next() ;
+         const CHAR *name = ele.fieldName() ;
+         for ( UINT32 i = 0 ; i < _fieldNum ; ++i )
+         {
+            if ( 0 == ( foundMask & ( 1 << i ) ) &&
+                 0 == ossStrcmp( name, _fieldNames[ i ].c_str() ) )
+            {
+               FLOAT64 value = 0.0 ;
+               if ( !_toNumber( ele, value ) )
+               {
+                  valid = 0 ;
+               }
+               batch.column( i )[ row ] = value ;
+               foundMask |= ( 1 << i ) ;
+               ++found ;
+               break ;
+            }
+         }
+      }
+
+      // missing field, the match tree decides ( e.g. { a: { $et: null } } )
+      if ( found < _fieldNum )
+      {
+         valid = 0 ;
+         for ( UINT32 i = 0 ; i < _fieldNum ; ++i )
+         {
+            if ( 0 == ( foundMask & ( 1 << i ) ) )
+            {
+               batch.column( i )[ row ] = 0.0 ;
+            }
+         }
+      }
+      batch._valids[ row ] = valid ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__MTHCOLFILTER_EVALUATE, "_mthColumnFilter::evaluate" )
+   void _mthColumnFilter::evaluate( _mthColumnBatch &batch,
+                                    UINT32 rowNum ) const
+   {
+      PD_TRACE_ENTRY( SDB__MTHCOLFILTER_EVALUATE ) ;
+      UINT8 *states = batch._states ;
+      const UINT8 *valids = batch._valids ;
+
+      SDB_ASSERT( rowNum <= batch.capacity(), "row number is invalid" ) ;
+
+      for ( UINT32 row = 0 ; row < rowNum ; ++row )
+      {
+         states[ row ] = 1 ;
+      }
+
+      /*
+         Loops below are kept branch-free on purpose, so that compilers are
+         able to vectorize them
+      */
+      for ( UINT32 i = 0 ; i < _predNum ; ++i )
+      {
+         const mthColumnPred &pred = _preds[ i ] ;
+         const FLOAT64 *col = batch.column( pred._column ) ;
+         const FLOAT64 value = pred._value ;
+         UINT32 row = 0 ;
+
+         switch ( pred._opType )
+         {
+            case EN_MATCH_OPERATOR_ET :
+               for ( row = 0 ; row < rowNum ; ++row )
+               {
+                  states[ row ] &= (UINT8)( col[ row ] == value ) ;
+               }
+               break ;
+            case EN_MATCH_OPERATOR_LT :
+               for ( row = 0 ; row < rowNum ; ++row )
+               {
+                  states[ row ] &= (UINT8)( col[ row ] < value ) ;
+               }
+               break ;
+            case EN_MATCH_OPERATOR_LTE :
+               for ( row = 0 ; row < rowNum ; ++row )
+               {
+                  states[ row ] &= (UINT8)( col[ row ] <= value ) ;
+               }
+               break ;
+            case EN_MATCH_OPERATOR_GT :
+               for ( row = 0 ; row < rowNum ; ++row )
+               {
+                  states[ row ] &= (UINT8)( col[ row ] > value ) ;
+               }
+               break ;
+            case EN_MATCH_OPERATOR_GTE :
+               for ( row = 0 ; row < rowNum ; ++row )
+               {
+                  states[ row ] &= (UINT8)( col[ row ] >= value ) ;
+               }
+               break ;
+            case EN_MATCH_OPERATOR_IN :
+            {
+               const FLOAT64 *inValues = &_inValues[ pred._inStart ] ;
+               for ( row = 0 ; row < rowNum ; ++row )
+               {
+                  UINT8 hit = 0 ;
+                  for ( UINT32 j = 0 ; j < pred._inNum ; ++j )
+                  {
+                     hit |= (UINT8)( col[ row ] == inValues[ j ] ) ;
+                  }
+                  states[ row ] &= hit ;
+               }
+               break ;
+            }
+            default :
+               SDB_ASSERT( FALSE, "Invalid column predicate" ) ;
+               break ;
+         }
+      }
+
+      for ( UINT32 row = 0 ; row < rowNum ; ++row )
+      {
+         states[ row ] = valids[ row ] ? states[ row ] :
+                                         (UINT8)MTH_COLUMN_ROW_FALLBACK ;
+      }
+
+      PD_TRACE_EXIT( SDB__MTHCOLFILTER_EVALUATE ) ;
+   }
+
+   string _mthColumnFilter::toString() const
+   {
+      stringstream ss ;
+      ss << "Valid: " << ( isValid() ? "TRUE" : "FALSE" ) << ", Preds: [" ;
+      for ( UINT32 i = 0 ; i < _predNum ; ++i )
+      {
+         const mthColumnPred &pred = _preds[ i ] ;
+         if ( i > 0 )
+         {
+            ss << ", " ;
+         }
+         ss << _fieldNames[ pred._column ] << " " << pred._opType << " " ;
+         if ( EN_MATCH_OPERATOR_IN == pred._opType )
+         {
+            ss << "(" << pred._inNum << " values)" ;
+         }
+         else
+         {
+            ss << pred._value ;
+         }
+      }
+      ss << "]" ;
+      return ss.str() ;
+   }
+
+   /*
+      _mthColumnBatch implement
+   */
+   _mthColumnBatch::_mthColumnBatch()
+   : _fieldNum( 0 ),
+     _batchSize( 0 ),
+     _columns( NULL ),
+     _valids( NULL ),
+     _states( NULL )
+   {
+   }
+
+   _mthColumnBatch::~_mthColumnBatch()
+   {
+      release() ;
+   }
+
+   INT32 _mthColumnBatch::init( UINT32 fieldNum, UINT32 batchSize )
+   {
+      INT32 rc = SDB_OK ;
+      UINT32 colSize = 0 ;
+      CHAR *pBuff = NULL ;
+
+      if ( 0 == fieldNum || fieldNum > MTH_COLUMN_MAX_FIELD_NUM ||
+           0 == batchSize || batchSize > MTH_COLUMN_MAX_BATCH_SIZE )
+      {
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+
+      release() ;
+
+      // columns first to keep them aligned, then valid and state flags
+      colSize = fieldNum * batchSize * sizeof( FLOAT64 ) ;
+      pBuff = ( CHAR* )SDB_OSS_MALLOC( colSize + 2 * batchSize ) ;
+      if ( NULL == pBuff )
+      {
+         PD_LOG( PDERROR, "Failed to allocate column batch, size: %u",
+                 colSize + 2 * batchSize ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+
+      _columns = ( FLOAT64* )pBuff ;
+      _valids = ( UINT8* )( pBuff + colSize ) ;
+      _states = _valids + batchSize ;
+      _fieldNum = fieldNum ;
+      _batchSize = batchSize ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   void _mthColumnBatch::release()
+   {
+      if ( _columns )
+      {
+         SDB_OSS_FREE( _columns ) ;
+      }
+      _columns = NULL ;
+      _valids = NULL ;
+      _states = NULL ;
+      _fieldNum = 0 ;
+      _batchSize = 0 ;
+   }
+
+}
@@ -2595,6 +2595,47 @@ namespace engine
       return _hasReturnMatch ;
    }
 
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__MTHMATCHOPNODE_ADDTOCOLFILTER, "_mthMatchOpNode::addToColumnFilter" )
+   BOOLEAN _mthMatchOpNode::addToColumnFilter( _mthColumnFilter &filter,
+                                               const rtnParamList *parameters )
+   {
+      PD_TRACE_ENTRY( SDB__MTHMATCHOPNODE_ADDTOCOLFILTER ) ;
+      BOOLEAN added = FALSE ;
+      BSONElement toMatchEle ;
+
+      if ( _funcList.size() > 0 || _isCompareField || _hasDollarFieldName ||
+           _hasReturnMatch || _hasExpand || _isUnderLogicNot ||
+           _getFuzzyIndex() >= 0 )
+      {
+         goto done ;
+      }
+
+      if ( _paramIndex != -1 )
+      {
+         if ( NULL == parameters )
+         {
+            goto done ;
+         }
+         if ( _doneByPred || parameters->isDoneByPred( _paramIndex ) )
+         {
+            // always matches, nothing to evaluate
+            added = TRUE ;
+            goto done ;
+         }
+         toMatchEle = parameters->getParam( _paramIndex ) ;
+      }
+      else
+      {
+         toMatchEle = _toMatch ;
+      }
+
+      added = filter.addPredicate( getFieldName(), getType(), toMatchEle ) ;
+
+   done:
+      PD_TRACE_EXIT( SDB__MTHMATCHOPNODE_ADDTOCOLFILTER ) ;
+      return added ;
+   }
+
    BSONObj _mthMatchOpNode::_toBson ( const rtnParamList &parameters )
    {
       BSONObjBuilder builder ;
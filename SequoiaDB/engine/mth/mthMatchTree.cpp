@@ -2406,6 +2406,55 @@ namespace engine
       return _isTotallyConverted ;
    }
 
+   BOOLEAN _mthMatchTree::_buildColumnFilter( _mthMatchNode *node,
+                                              _mthColumnFilter &filter,
+                                              const rtnParamList *parameters )
+   {
+      INT32 type = node->getType() ;
+
+      if ( EN_MATCH_OPERATOR_LOGIC_AND == type )
+      {
+         _mthMatchNodeIterator iter( node ) ;
+         while ( iter.more() )
+         {
+            if ( !_buildColumnFilter( iter.next(), filter, parameters ) )
+            {
+               return FALSE ;
+            }
+         }
+         return TRUE ;
+      }
+      else if ( type > EN_MATCH_OPERATOR_LOGIC_END &&
+                type < EN_MATCH_OPERATOR_END )
+      {
+         _mthMatchOpNode *opNode = dynamic_cast< _mthMatchOpNode* >( node ) ;
+         return ( NULL != opNode &&
+                  opNode->addToColumnFilter( filter, parameters ) ) ;
+      }
+
+      // $or and $not are left to the match tree
+      return FALSE ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__MTHMATCHTREE_BUILDCOLFILTER, "_mthMatchTree::buildColumnFilter" )
+   BOOLEAN _mthMatchTree::buildColumnFilter( _mthColumnFilter &filter,
+                                             const rtnParamList *parameters )
+   {
+      PD_TRACE_ENTRY( SDB__MTHMATCHTREE_BUILDCOLFILTER ) ;
+
+      filter.clear() ;
+
+      if ( !_isInitialized || _isMatchesAll || NULL == _root ||
+           _hasExpand || _hasReturnMatch || _hasDollarFieldName ||
+           !_buildColumnFilter( _root, filter, parameters ) )
+      {
+         filter.invalidate() ;
+      }
+
+      PD_TRACE_EXIT( SDB__MTHMATCHTREE_BUILDCOLFILTER ) ;
+      return filter.isValid() ;
+   }
+
    void _mthMatchTree::setMatchesAll( BOOLEAN matchesAll )
    {
       if ( ( _hasExpand || _hasReturnMatch ) && matchesAll )
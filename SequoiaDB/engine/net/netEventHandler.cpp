@@ -45,6 +45,7 @@
 #include "netTrace.hpp"
 #include "msgMessageFormat.hpp"
 #include "netEventSuit.hpp"
+#include "msgCompress.hpp"
 #include <boost/bind.hpp>
 #if defined (_WINDOWS)
 #include <mstcpip.h>
@@ -61,6 +62,10 @@ namespace engine
    : _sock( evSuitPtr->getIOService() ),
      _buf(NULL),
      _bufLen(0),
+     _plainBuf(NULL),
+     _plainBufLen(0),
+     _isUncompressed(FALSE),
+     _peerCompress(FALSE),
      _state(NET_EVENT_HANDLER_STATE_HEADER),
      _handle( handle )
    {
@@ -90,6 +95,10 @@ namespace engine
       {
          SDB_OSS_FREE( _buf ) ;
       }
+      if ( NULL != _plainBuf )
+      {
+         SDB_OSS_FREE( _plainBuf ) ;
+      }
 
       _evSuitPtr->delHandle( _handle ) ;
    }
@@ -535,6 +544,53 @@ namespace engine
       goto done ;
    }
 
+#if defined ( SDB_ENGINE )
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__NETEVNHND__UNCOMPRESS, "_netEventHandler::_uncompress" )
+   INT32 _netEventHandler::_uncompress()
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__NETEVNHND__UNCOMPRESS ) ;
+      UINT32 len = msgUncompressedLen( (const MsgHeader*)_buf ) ;
+
+      if ( len > SDB_MAX_MSG_LENGTH )
+      {
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+      if ( _plainBufLen < len )
+      {
+         if ( NULL != _plainBuf )
+         {
+            SDB_OSS_FREE( _plainBuf ) ;
+            _plainBufLen = 0 ;
+         }
+         _plainBuf = (CHAR *)SDB_OSS_MALLOC( len ) ;
+         if ( NULL == _plainBuf )
+         {
+            rc = SDB_OOM ;
+            goto error ;
+         }
+         _plainBufLen = len ;
+      }
+
+      rc = msgUncompress( (const MsgHeader*)_buf, _plainBuf, _plainBufLen ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+      _isUncompressed = TRUE ;
+
+   done:
+      PD_TRACE_EXITRC ( SDB__NETEVNHND__UNCOMPRESS, rc ) ;
+      return rc ;
+   error:
+      PD_LOG( PDERROR, "Connection[Handle:%d, Node:%s] failed to uncompress "
+              "message[length: %u], rc: %d", _handle,
+              routeID2String( _id ).c_str(), len, rc ) ;
+      goto done ;
+   }
+#endif // SDB_ENGINE
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB__NETEVNHND__RDCALLBK, "_netEventHandler::_readCallback" )
    void _netEventHandler::_readCallback( const boost::system::error_code &error )
    {
@@ -656,7 +712,15 @@ namespace engine
       else
       {
          _srDataLen += _header.messageLength ;
+#if defined ( SDB_ENGINE )
+         if ( MSG_COM_COMPRESSED == _header.opCode &&
+              SDB_OK != _uncompress() )
+         {
+            goto error_close ;
+         }
+#endif // SDB_ENGINE
          _evSuitPtr->getFrame()->handleMsg( shared_from_this() ) ;
+         _isUncompressed = FALSE ;
          _state = NET_EVENT_HANDLER_STATE_HEADER ;
          asyncRead() ;
       }
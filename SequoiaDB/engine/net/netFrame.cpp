@@ -45,6 +45,7 @@
 #include "pdTrace.hpp"
 #include "netTrace.hpp"
 #include "netRoute.hpp"
+#include "msgCompress.hpp"
 #include <boost/bind.hpp>
 
 using namespace boost::asio::ip ;
@@ -545,6 +546,9 @@ namespace engine
          }
 
          eh->id( id ) ;
+         eh->mtx().get() ;
+         _negoCompress( eh ) ;
+         eh->mtx().release() ;
          eh->asyncRead() ;
 
          _mtx.get() ;
@@ -586,6 +590,7 @@ namespace engine
                if ( SDB_OK == rc )
                {
                   hasConnect = TRUE ;
+                  _negoCompress( eh ) ;
                   eh->asyncRead() ;
                }
             }
@@ -721,7 +726,7 @@ namespace engine
          msgHeader->routeID = _local ;
       }
       eh->mtx().get() ;
-      rc = eh->syncSend( msgHeader, msgHeader->messageLength ) ;
+      rc = _syncSend( eh, msgHeader, msgHeader->messageLength, NULL, 0 ) ;
       if ( pHandle )
       {
          *pHandle = eh->handle() ;
@@ -732,7 +737,6 @@ namespace engine
          eh->close() ;
          goto error ;
       }
-      _netOut.add( msgHeader->messageLength ) ;
 
    done:
       PD_TRACE_EXITRC ( SDB__NETFRAME_SYNCSEND, rc );
@@ -771,14 +775,13 @@ namespace engine
          msgHeader->routeID = _local ;
       }
       eh->mtx().get() ;
-      rc = eh->syncSend( msgHeader, msgHeader->messageLength ) ;
+      rc = _syncSend( eh, msgHeader, msgHeader->messageLength, NULL, 0 ) ;
       eh->mtx().release() ;
       if ( SDB_OK != rc )
       {
          eh->close() ;
          goto error ;
       }
-      _netOut.add( msgHeader->messageLength ) ;
 
    done:
       PD_TRACE_EXITRC ( SDB__NETFRAME_SYNCSEND2, rc );
@@ -857,22 +860,13 @@ namespace engine
          header->routeID = _local ;
       }
       eh->mtx().get() ;
-      rc = eh->syncSend( header, headLen ) ;
-      if ( SDB_OK != rc )
-      {
-         eh->mtx().release() ;
-         eh->close() ;
-         goto error ;
-      }
-      _netOut.add( headLen ) ;
-      rc = eh->syncSend( body, bodyLen ) ;
+      rc = _syncSend( eh, header, headLen, body, bodyLen ) ;
       eh->mtx().release() ;
       if ( SDB_OK != rc )
       {
          eh->close() ;
          goto error ;
       }
-      _netOut.add( bodyLen ) ;
    done:
       PD_TRACE_EXITRC ( SDB__NETFRAME_SYNCSEND3, rc );
       return rc ;
@@ -915,33 +909,13 @@ namespace engine
       _mtx.release_shared() ;
 
       eh->mtx().get() ;
-      rc = eh->syncSend( header, sizeof(MsgHeader) ) ;
+      rc = _syncSend( eh, header, sizeof(MsgHeader), NULL, 0, &iov ) ;
+      eh->mtx().release() ;
       if ( SDB_OK != rc )
       {
-         eh->mtx().release() ;
          eh->close() ;
          goto error ;
       }
-      _netOut.add( sizeof(MsgHeader) ) ;
-
-      for ( netIOVec::const_iterator itr = iov.begin() ; itr != iov.end();
-            ++itr )
-      {
-         SDB_ASSERT( NULL != itr->iovBase, "should not be NULL" ) ;
-
-         if ( itr->iovBase )
-         {
-            rc = eh->syncSend( itr->iovBase, itr->iovLen ) ;
-            if ( SDB_OK != rc )
-            {
-               eh->mtx().release() ;
-               eh->close() ;
-               goto error ;
-            }
-            _netOut.add( itr->iovLen ) ;
-         }
-      }
-      eh->mtx().release() ;
 
    done:
       return rc ;
@@ -987,22 +961,13 @@ namespace engine
       {
          *pHandle = eh->handle() ;
       }
-      rc = eh->syncSend( header, headLen ) ;
-      if ( SDB_OK != rc )
-      {
-         eh->mtx().release() ;
-         eh->close() ;
-         goto error ;
-      }
-      _netOut.add( headLen ) ;
-      rc = eh->syncSend( body, bodyLen ) ;
+      rc = _syncSend( eh, header, headLen, body, bodyLen ) ;
       eh->mtx().release() ;
       if ( SDB_OK != rc )
       {
          eh->close() ;
          goto error ;
       }
-      _netOut.add( bodyLen ) ;
    done:
       PD_TRACE_EXITRC ( SDB__NETFRAME_SYNCSEND4, rc );
       return rc ;
@@ -1054,33 +1019,13 @@ namespace engine
       {
          *pHandle = eh->handle() ;
       }
-      rc = eh->syncSend( header, sizeof(MsgHeader) ) ;
+      rc = _syncSend( eh, header, sizeof(MsgHeader), NULL, 0, &iov ) ;
+      eh->mtx().release() ;
       if ( SDB_OK != rc )
       {
-         eh->mtx().release() ;
          eh->close() ;
          goto error ;
       }
-      _netOut.add( sizeof(MsgHeader) ) ;
-
-      for ( netIOVec::const_iterator itr = iov.begin() ; itr != iov.end() ;
-            ++itr )
-      {
-         SDB_ASSERT( NULL != itr->iovBase, "should not be NULL" ) ;
-
-         if ( itr->iovBase && itr->iovLen > 0 )
-         {
-            rc = eh->syncSend( itr->iovBase, itr->iovLen ) ;
-            if ( SDB_OK != rc )
-            {
-               eh->mtx().release() ;
-               eh->close() ;
-               goto error ;
-            }
-            _netOut.add( itr->iovLen ) ;
-         }
-      }
-      eh->mtx().release() ;
 
    done:
       PD_TRACE_EXITRC( SDB__NETFRAME_SYNCSENDV, rc ) ;
@@ -1219,6 +1164,208 @@ namespace engine
       return rc ;
    }
 
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__NETFRAME__SYNCSEND, "_netFrame::_syncSend" )
+   INT32 _netFrame::_syncSend( NET_EH &eh, MsgHeader *header, UINT32 headLen,
+                               const void *body, UINT32 bodyLen,
+                               const netIOVec *pIOV )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__NETFRAME__SYNCSEND ) ;
+      BOOLEAN sent = FALSE ;
+
+#if defined ( SDB_ENGINE )
+      rc = _syncSendCompressed( eh, header, headLen, body, bodyLen, pIOV,
+                                sent ) ;
+      if ( rc || sent )
+      {
+         goto done ;
+      }
+#endif // SDB_ENGINE
+
+      rc = eh->syncSend( header, headLen ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+      _netOut.add( headLen ) ;
+
+      if ( body && bodyLen > 0 )
+      {
+         rc = eh->syncSend( body, bodyLen ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         _netOut.add( bodyLen ) ;
+      }
+
+      if ( pIOV )
+      {
+         for ( netIOVec::const_iterator itr = pIOV->begin() ;
+               itr != pIOV->end() ; ++itr )
+         {
+            SDB_ASSERT( NULL != itr->iovBase, "should not be NULL" ) ;
+
+            if ( itr->iovBase && itr->iovLen > 0 )
+            {
+               rc = eh->syncSend( itr->iovBase, itr->iovLen ) ;
+               if ( rc )
+               {
+                  goto error ;
+               }
+               _netOut.add( itr->iovLen ) ;
+            }
+         }
+      }
+
+   done:
+      PD_TRACE_EXITRC ( SDB__NETFRAME__SYNCSEND, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+#if defined ( SDB_ENGINE )
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__NETFRAME__SYNCSENDCOMP, "_netFrame::_syncSendCompressed" )
+   INT32 _netFrame::_syncSendCompressed( NET_EH &eh, MsgHeader *header,
+                                         UINT32 headLen, const void *body,
+                                         UINT32 bodyLen,
+                                         const netIOVec *pIOV,
+                                         BOOLEAN &sent )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__NETFRAME__SYNCSENDCOMP ) ;
+      INT32 type = msgGetCompressType() ;
+      UINT32 dataLen = header->messageLength - sizeof( MsgHeader ) ;
+      const CHAR *pData = NULL ;
+      CHAR *pGather = NULL ;
+      CHAR *pOut = NULL ;
+      UINT32 outLen = 0 ;
+      UINT32 pieceNum = 0 ;
+      netIOV pieces[ 2 ] ;
+
+      sent = FALSE ;
+      if ( !eh->isPeerCompress() ||
+           !msgNeedCompress( type, msgGetCompressThreshold(),
+                             header->messageLength ) )
+      {
+         goto done ;
+      }
+
+      // the message is compressed as a whole, except the MsgHeader
+      if ( headLen > sizeof( MsgHeader ) )
+      {
+         pieces[ pieceNum++ ] = netIOV( (CHAR*)header + sizeof( MsgHeader ),
+                                        headLen - sizeof( MsgHeader ) ) ;
+      }
+      if ( body && bodyLen > 0 )
+      {
+         pieces[ pieceNum++ ] = netIOV( body, bodyLen ) ;
+      }
+      if ( pIOV && 0 == pieceNum && 1 == pIOV->size() )
+      {
+         pieces[ pieceNum++ ] = (*pIOV)[ 0 ] ;
+      }
+      else if ( pIOV )
+      {
+         pieceNum += pIOV->size() ;
+      }
+
+      if ( 1 == pieceNum )
+      {
+         pData = (const CHAR*)pieces[ 0 ].iovBase ;
+      }
+      else
+      {
+         UINT32 offset = 0 ;
+         pGather = (CHAR*)SDB_OSS_MALLOC( dataLen ) ;
+         if ( !pGather )
+         {
+            // send the message raw
+            goto done ;
+         }
+         for ( UINT32 i = 0 ; i < 2 ; ++i )
+         {
+            if ( pieces[ i ].iovBase )
+            {
+               ossMemcpy( pGather + offset, pieces[ i ].iovBase,
+                          pieces[ i ].iovLen ) ;
+               offset += pieces[ i ].iovLen ;
+            }
+         }
+         if ( pIOV )
+         {
+            for ( netIOVec::const_iterator itr = pIOV->begin() ;
+                  itr != pIOV->end() ; ++itr )
+            {
+               if ( itr->iovBase && itr->iovLen > 0 )
+               {
+                  ossMemcpy( pGather + offset, itr->iovBase, itr->iovLen ) ;
+                  offset += itr->iovLen ;
+               }
+            }
+         }
+         SDB_ASSERT( offset == dataLen, "Invalid message length" ) ;
+         pData = pGather ;
+      }
+
+      if ( SDB_OK != msgCompress( type, (const CHAR*)header,
+                                  sizeof( MsgHeader ), pData, dataLen,
+                                  &pOut, outLen ) )
+      {
+         // not worth compressing, send the message raw
+         goto done ;
+      }
+
+      rc = eh->syncSend( pOut, outLen ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+      _netOut.add( outLen ) ;
+      sent = TRUE ;
+
+   done:
+      if ( pGather )
+      {
+         SDB_OSS_FREE( pGather ) ;
+      }
+      if ( pOut )
+      {
+         SDB_OSS_FREE( pOut ) ;
+      }
+      PD_TRACE_EXITRC ( SDB__NETFRAME__SYNCSENDCOMP, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+#endif // SDB_ENGINE
+
+   void _netFrame::_negoCompress( NET_EH &eh )
+   {
+#if defined ( SDB_ENGINE )
+      MsgComCompressNego nego ;
+
+      // only the side that compresses asks, the peer answers the request
+      // whatever it's configured, so the reply tells the peer accepts
+      // compressed messages
+      if ( !msgIsValidCompressType( msgGetCompressType() ) )
+      {
+         return ;
+      }
+
+      msgBuildCompressNego( nego, MSG_COM_COMPRESS_NEGO_REQ,
+                            msgGetCompressType(),
+                            msgGetCompressThreshold() ) ;
+      nego.header.routeID = _local ;
+      if ( SDB_OK == eh->syncSend( (const void*)&nego,
+                                   nego.header.messageLength ) )
+      {
+         _netOut.add( nego.header.messageLength ) ;
+      }
+#endif // SDB_ENGINE
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB__NETFRAME_HNDMSG, "_netFrame::handleMsg" )
    void _netFrame::handleMsg( NET_EH eh )
    {
@@ -1244,6 +1391,29 @@ namespace engine
          eh->syncSend( (const void*)&reply, reply.header.messageLength ) ;
          eh->mtx().release() ;
       }
+      else if ( MSG_COM_COMPRESS_NEGO_REQ == pMsg->opCode )
+      {
+#if defined ( SDB_ENGINE )
+         MsgComCompressNego reply ;
+         msgBuildCompressNego( reply, MSG_COM_COMPRESS_NEGO_RSP,
+                               msgGetCompressType(),
+                               msgGetCompressThreshold() ) ;
+         reply.header.requestID = pMsg->requestID ;
+         reply.header.TID = pMsg->TID ;
+
+         eh->mtx().get() ;
+         reply.header.routeID = _local ;
+         eh->syncSend( (const void*)&reply, reply.header.messageLength ) ;
+         eh->setPeerCompress( TRUE ) ;
+         eh->mtx().release() ;
+#endif // SDB_ENGINE
+      }
+      else if ( MSG_COM_COMPRESS_NEGO_RSP == pMsg->opCode )
+      {
+#if defined ( SDB_ENGINE )
+         eh->setPeerCompress( TRUE ) ;
+#endif // SDB_ENGINE
+      }
       else if ( MSG_HEARTBEAT_RES == pMsg->opCode )
       {
          MsgOpReply *pReply = ( MsgOpReply* )pMsg ;
@@ -1713,6 +1713,34 @@ namespace engine
       goto done ;
    }
 
+   /*
+      Whether the cached plan can be bound to the query normalized by the
+      shape of the prepared query, only the valid parameterized plans with
+      the predicates built are bound without the plan helper.
+   */
+   static BOOLEAN _optCanBindPrepared ( optGeneralAccessPlan *pPlan )
+   {
+      optParamAccessPlan *paramPlan = NULL ;
+
+      if ( NULL == pPlan ||
+           pPlan->getCacheLevel() < OPT_PLAN_PARAMETERIZED ||
+           !pPlan->isParamValid() )
+      {
+         return FALSE ;
+      }
+
+      paramPlan = dynamic_cast<optParamAccessPlan *>( pPlan ) ;
+      if ( NULL == paramPlan )
+      {
+         return FALSE ;
+      }
+
+      return IXSCAN != paramPlan->getScanType() ||
+             paramPlan->getMatchRuntime()->isFixedPredList() ||
+             ( NULL != paramPlan->getParamPredList() &&
+               !paramPlan->getParamPredList()->empty() ) ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB_OPTAPM__GETCLAP_LEVEL, "_optAccessPlanManager::_getCLAccessPlan" )
    INT32 _optAccessPlanManager::_getCLAccessPlan ( const rtnQueryOptions &options,
                                                    OPT_PLAN_CACHE_LEVEL cacheLevel,
@@ -1729,7 +1757,6 @@ namespace engine
       SDB_ASSERT( mbContext, "mbContext is invalid" ) ;
 
       optGeneralAccessPlan *pPlan = NULL ;
-      optAccessPlan *pTmpPlan = NULL ;
 
       optAccessPlanKey planKey( options, cacheLevel ) ;
 
@@ -1748,15 +1775,32 @@ namespace engine
 
       if ( needCache )
       {
-         rc = _getCachedAccessPlan( planKey, &pTmpPlan ) ;
+         rc = _getCachedCLAccessPlan( planKey, &pPlan ) ;
          PD_RC_CHECK( rc, PDERROR, "Failed to get access plan, rc: %d", rc ) ;
-         if ( NULL != pTmpPlan )
+      }
+
+      if ( planKey.isPreparedNormalized() && !_optCanBindPrepared( pPlan ) )
+      {
+         // the normalizer and the predicates of the plan helper, which are
+         // skipped by the shape of the prepared query, are required to
+         // create or validate the plan
+         if ( NULL != pPlan )
          {
-            pPlan = dynamic_cast<_optGeneralAccessPlan *>( pTmpPlan ) ;
-            if ( NULL == pPlan )
-            {
-               pTmpPlan->release() ;
-            }
+            pPlan->release() ;
+            pPlan = NULL ;
+         }
+
+         planKey.resetPrepared() ;
+         rc = _prepareAccessPlanKey( su, mbContext, planKey, planHelper,
+                                     planRuntime ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to prepare key of access plan, "
+                      "rc: %d", rc ) ;
+
+         if ( needCache )
+         {
+            rc = _getCachedCLAccessPlan( planKey, &pPlan ) ;
+            PD_RC_CHECK( rc, PDERROR, "Failed to get access plan, rc: %d",
+                         rc ) ;
          }
       }
 
@@ -1842,6 +1886,8 @@ namespace engine
          optAccessPlanKey planKey( options, cacheLevel ) ;
          planKey.setCLFullName( options.getMainCLName() ) ;
          planKey.setMainCLName( NULL ) ;
+         // the main-collection plan is bound with the plan helper
+         planKey.setPreparedBinding( NULL ) ;
 
          optAccessPlanHelper planHelper( cacheLevel, getPlanConfig(),
                                          getMatchConfig(), FALSE ) ;
@@ -2061,6 +2107,28 @@ namespace engine
       return rc ;
    }
 
+   INT32 _optAccessPlanManager::_getCachedCLAccessPlan (
+                                             const optAccessPlanKey &planKey,
+                                             optGeneralAccessPlan **ppPlan )
+   {
+      INT32 rc = SDB_OK ;
+      optAccessPlan *pTmpPlan = NULL ;
+
+      (*ppPlan) = NULL ;
+
+      rc = _getCachedAccessPlan( planKey, &pTmpPlan ) ;
+      if ( SDB_OK == rc && NULL != pTmpPlan )
+      {
+         (*ppPlan) = dynamic_cast<_optGeneralAccessPlan *>( pTmpPlan ) ;
+         if ( NULL == (*ppPlan) )
+         {
+            pTmpPlan->release() ;
+         }
+      }
+
+      return rc ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION ( SDB_OPTAPM__CACHEAP, "_optAccessPlanManager::_cacheAccessPlan" )
    BOOLEAN _optAccessPlanManager::_cacheAccessPlan ( optAccessPlan *pPlan )
    {
@@ -42,6 +42,8 @@
 #include "pmd.hpp"
 #include "mthMatchTree.hpp"
 #include "mthMatchNormalizer.hpp"
+#include "mthMatchOpNode.hpp"
+#include "rtnPreparedQuery.hpp"
 
 using namespace bson ;
 
@@ -57,7 +59,8 @@ namespace engine
      _utilHashTableKey(),
      _optCollectionInfo(),
      _isValid( FALSE ),
-     _cacheLevel( cacheLevel )
+     _cacheLevel( cacheLevel ),
+     _preparedNormalized( FALSE )
    {
       SDB_ASSERT( NULL != getCLFullName(), "pCLFullName is invalid" ) ;
 
@@ -72,7 +75,8 @@ namespace engine
      _optCollectionInfo( planKey ),
      _isValid( FALSE ),
      _cacheLevel( planKey._cacheLevel ),
-     _normalizedQuery( planKey._normalizedQuery )
+     _normalizedQuery( planKey._normalizedQuery ),
+     _preparedNormalized( planKey._preparedNormalized )
    {
    }
 
@@ -193,6 +197,11 @@ namespace engine
 
       matchRuntime->setQuery( getQuery(), TRUE ) ;
 
+      if ( _normalizePrepared( planHelper, matchRuntime ) )
+      {
+         goto done ;
+      }
+
       rc = planHelper.normalizeQuery( matchRuntime->getQuery(),
                                       normalBuilder,
                                       matchRuntime->getParameters(),
@@ -208,6 +217,10 @@ namespace engine
             planHelper.setMthEnableFuzzyOptr( FALSE ) ;
             planHelper.setMthEnableParameterized( FALSE ) ;
          }
+         else
+         {
+            _learnPrepared( planHelper, matchRuntime ) ;
+         }
          goto done ;
       }
 
@@ -229,6 +242,124 @@ namespace engine
       goto done ;
    }
 
+   UINT32 _optAccessPlanKey::_getPreparedSign (
+                                       optAccessPlanHelper &planHelper ) const
+   {
+      const mthNodeConfig &config = planHelper.getMatchConfig() ;
+      return (UINT32)_cacheLevel |
+             ( config._enableMixCmp ? 0x100 : 0 ) |
+             ( config._enableParameterized ? 0x200 : 0 ) |
+             ( config._enableFuzzyOptr ? 0x400 : 0 ) ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_OPTAPKEY__NORMALIZEPREPARED, "_optAccessPlanKey::_normalizePrepared" )
+   BOOLEAN _optAccessPlanKey::_normalizePrepared (
+                                       optAccessPlanHelper &planHelper,
+                                       mthMatchRuntime *matchRuntime )
+   {
+      BOOLEAN normalized = FALSE ;
+      PD_TRACE_ENTRY( SDB_OPTAPKEY__NORMALIZEPREPARED ) ;
+      rtnPreparedBinding *binding = getPreparedBinding() ;
+      rtnPreparedShape *shape = binding ? binding->getShape() : NULL ;
+
+      _preparedNormalized = FALSE ;
+
+      if ( NULL == shape ||
+           _cacheLevel < OPT_PLAN_PARAMETERIZED ||
+           !shape->canBind( _getPreparedSign( planHelper ), *binding ) )
+      {
+         goto done ;
+      }
+
+      // the parameters refer to the query of the match runtime
+      if ( SDB_OK != shape->bindParams( matchRuntime->getQuery(), *binding,
+                                        matchRuntime->getParameters() ) )
+      {
+         goto done ;
+      }
+
+      _normalizedQuery = shape->getNormalizedQuery() ;
+      _preparedNormalized = TRUE ;
+      normalized = TRUE ;
+
+   done:
+      PD_TRACE_EXIT( SDB_OPTAPKEY__NORMALIZEPREPARED ) ;
+      return normalized ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_OPTAPKEY__LEARNPREPARED, "_optAccessPlanKey::_learnPrepared" )
+   void _optAccessPlanKey::_learnPrepared ( optAccessPlanHelper &planHelper,
+                                            mthMatchRuntime *matchRuntime )
+   {
+      PD_TRACE_ENTRY( SDB_OPTAPKEY__LEARNPREPARED ) ;
+      rtnPreparedBinding *binding = getPreparedBinding() ;
+      rtnPreparedShape *shape = binding ? binding->getShape() : NULL ;
+      const rtnParamList &parameters = matchRuntime->getParameters() ;
+      const CHAR *pBase = matchRuntime->getQuery().objdata() ;
+      const CHAR *pEnd = pBase + matchRuntime->getQuery().objsize() ;
+      INT8 paramSlots[ RTN_MAX_PARAM_NUM ] ;
+      UINT32 usedSlots = 0 ;
+      UINT32 paramNum = (UINT32)parameters.getCurIndex() ;
+      BSONObjBuilder constBuilder ;
+
+      if ( NULL == shape || !shape->needLearn() ||
+           _cacheLevel < OPT_PLAN_PARAMETERIZED )
+      {
+         goto done ;
+      }
+
+      for ( UINT32 i = 0 ; i < paramNum ; ++i )
+      {
+         BSONElement param = parameters.getParam( (INT8)i ) ;
+         const CHAR *pParam = param.rawdata() ;
+         INT32 slot = -1 ;
+
+         if ( pParam >= pBase && pParam < pEnd )
+         {
+            slot = binding->findSlot( (INT32)( pParam - pBase ) ) ;
+         }
+         else if ( pParam != _mthFuzzyIncOptr.firstElement().rawdata() &&
+                   pParam != _mthFuzzyExcOptr.firstElement().rawdata() )
+         {
+            // made from the values, which can't be learned
+            goto unlearnable ;
+         }
+
+         if ( slot >= 0 )
+         {
+            if ( OSS_BIT_TEST( usedSlots, 1 << slot ) )
+            {
+               goto unlearnable ;
+            }
+            OSS_BIT_SET( usedSlots, 1 << slot ) ;
+         }
+         else
+         {
+            // the constant of the shape, or the fuzzy operator
+            constBuilder.append( param ) ;
+         }
+         paramSlots[ i ] = (INT8)slot ;
+      }
+
+      // the value of a slot which is not parameterized is in the
+      // normalized query
+      if ( usedSlots != ( 1u << binding->getSlotNum() ) - 1 )
+      {
+         goto unlearnable ;
+      }
+
+      shape->setLearned( _getPreparedSign( planHelper ), *binding,
+                         _normalizedQuery, paramSlots, paramNum,
+                         constBuilder.obj() ) ;
+
+   done:
+      PD_TRACE_EXIT( SDB_OPTAPKEY__LEARNPREPARED ) ;
+      return ;
+   unlearnable:
+      shape->setUnlearnable() ;
+      goto done ;
+   }
+
    void _optAccessPlanKey::_generateKeyCodeInternal ()
    {
       setKeyCode( _generateKeyCodeHash() ) ;
@@ -41,6 +41,8 @@
 #include "ossTrace.hpp"
 #if defined (_LINUX)
 #include <sys/mman.h>
+#include <fcntl.h>
+#include <linux/falloc.h>
 #elif defined (_WINDOWS)
 #include "dms.hpp"
 #endif
@@ -377,6 +379,133 @@ error :
    goto done ;
 }
 
+// PD_TRACE_DECLARE_FUNCTION ( SDB__OSSMMF_WILLNEED, "_ossMmapFile::willNeed" )
+INT32 _ossMmapFile::willNeed( UINT32 segmentID, UINT32 offset,
+                              UINT32 length, UINT32 *pAdvised )
+{
+   INT32 rc = SDB_OK ;
+   PD_TRACE_ENTRY ( SDB__OSSMMF_WILLNEED );
+   ossMmapSegment *pSegment = NULL ;
+   ossValuePtr ptr = 0 ;
+
+   engine::ossScopedRWLock lock( &_rwMutex, SHARED ) ;
+
+   if ( pAdvised )
+   {
+      *pAdvised = 0 ;
+   }
+
+   if ( segmentID >= _size )
+   {
+      rc = SDB_INVALIDARG ;
+      goto error ;
+   }
+
+   pSegment = &_pSegArray[segmentID] ;
+   if ( offset >= pSegment->_length || 0 == length )
+   {
+      goto done ;
+   }
+   else if ( length > pSegment->_length - offset )
+   {
+      length = pSegment->_length - offset ;
+   }
+
+   ptr = pSegment->_ptr + offset ;
+
+#if defined (_LINUX)
+   if ( madvise( (void*)ptr, length, MADV_WILLNEED ) )
+   {
+      PD_LOG ( PDWARNING, "Failed to madvise, err=%d", ossGetLastError() ) ;
+      rc = SDB_SYS ;
+      goto error ;
+   }
+#endif
+
+   if ( pAdvised )
+   {
+      *pAdvised = length ;
+   }
+
+done :
+   PD_TRACE_EXITRC ( SDB__OSSMMF_WILLNEED, rc );
+   return rc ;
+error :
+   goto done ;
+}
+
+// PD_TRACE_DECLARE_FUNCTION ( SDB__OSSMMF__ALLOCBLOCK, "_ossMmapFile::_allocBlock" )
+INT32 _ossMmapFile::_allocBlock( UINT32 segmentID, UINT32 offset,
+                                 UINT32 length, BOOLEAN punchHole )
+{
+   INT32 rc = SDB_OK ;
+   PD_TRACE_ENTRY ( SDB__OSSMMF__ALLOCBLOCK );
+   ossMmapSegment *pSegment = NULL ;
+
+   engine::ossScopedRWLock lock( &_rwMutex, SHARED ) ;
+
+   if ( segmentID >= _size )
+   {
+      rc = SDB_INVALIDARG ;
+      goto error ;
+   }
+
+   pSegment = &_pSegArray[segmentID] ;
+   if ( offset >= pSegment->_length || 0 == length )
+   {
+      goto done ;
+   }
+   else if ( length > pSegment->_length - offset )
+   {
+      length = pSegment->_length - offset ;
+   }
+
+#if defined (_LINUX)
+   if ( fallocate( _file.fd,
+                   punchHole ? FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE : 0,
+                   (off_t)( pSegment->_offset + offset ), (off_t)length ) )
+   {
+      INT32 err = ossGetLastError() ;
+      if ( EOPNOTSUPP == err )
+      {
+         rc = SDB_OPERATION_INCOMPATIBLE ;
+      }
+      else if ( ENOSPC == err )
+      {
+         rc = SDB_DMS_NOSPC ;
+      }
+      else
+      {
+         rc = SDB_SYS ;
+      }
+      PD_LOG ( PDWARNING, "Failed to fallocate, punch hole: %d, err=%d",
+               punchHole, err ) ;
+      goto error ;
+   }
+#else
+   rc = SDB_OPERATION_INCOMPATIBLE ;
+   goto error ;
+#endif
+
+done :
+   PD_TRACE_EXITRC ( SDB__OSSMMF__ALLOCBLOCK, rc );
+   return rc ;
+error :
+   goto done ;
+}
+
+INT32 _ossMmapFile::releaseBlock( UINT32 segmentID, UINT32 offset,
+                                  UINT32 length )
+{
+   return _allocBlock( segmentID, offset, length, TRUE ) ;
+}
+
+INT32 _ossMmapFile::reserveBlock( UINT32 segmentID, UINT32 offset,
+                                  UINT32 length )
+{
+   return _allocBlock( segmentID, offset, length, FALSE ) ;
+}
+
 // PD_TRACE_DECLARE_FUNCTION ( SDB__OSSMMF_UNLINK, "_ossMmapFile::unlink" )
 INT32 _ossMmapFile::unlink ()
 {
@@ -479,6 +479,159 @@ error :
    goto done ;
 }
 
+#define OSS_SOCKET_MAX_VEC          ( 16 )
+
+// PD_TRACE_DECLARE_FUNCTION ( SDB_OSSSK_SENDV, "ossSocket::sendv" )
+INT32 _ossSocket::sendv ( ossSockVec *pVec, INT32 num,
+                          INT32 &sentLen,
+                          INT32 timeout, INT32 flags )
+{
+   INT32 rc = SDB_OK ;
+   PD_TRACE_ENTRY ( SDB_OSSSK_SENDV );
+   SDB_ASSERT ( pVec && num > 0, "vector is invalid" ) ;
+
+   INT32 first = 0 ;
+   sentLen = 0 ;
+
+   PD_CHECK( _init, SDB_SYS, error, PDWARNING, "Socket is not init" ) ;
+
+#if !defined (_WINDOWS)
+#ifdef SDB_SSL
+   if ( NULL == _sslHandle )
+#endif /* SDB_SSL */
+   {
+      UINT32 retries = 0 ;
+      SOCKET maxFD = _fd ;
+      struct timeval maxSelectTime ;
+      fd_set fds ;
+      struct iovec iov[ OSS_SOCKET_MAX_VEC ] ;
+      struct msghdr msg ;
+
+      while ( first < num && pVec[ first ].len <= 0 )
+      {
+         ++first ;
+      }
+      if ( first >= num )
+      {
+         goto done ;
+      }
+
+      maxSelectTime.tv_sec = timeout / 1000 ;
+      maxSelectTime.tv_usec = ( timeout % 1000 ) * 1000 ;
+      while ( TRUE )
+      {
+         FD_ZERO ( &fds ) ;
+         FD_SET ( _fd, &fds ) ;
+         rc = select ( maxFD + 1, NULL, &fds, NULL,
+                       timeout>=0?&maxSelectTime:NULL ) ;
+         if ( 0 == rc )
+         {
+            rc = SDB_TIMEOUT ;
+            goto done ;
+         }
+         if ( 0 > rc )
+         {
+            rc = SOCKET_GETLASTERROR ;
+            if ( SOCKET_EINTR == rc )
+            {
+               continue ;
+            }
+            PD_LOG ( PDERROR, "Failed to select from socket, rc = %d", rc ) ;
+            rc = SDB_NETWORK ;
+            goto error ;
+         }
+         if ( FD_ISSET ( _fd, &fds ) )
+         {
+            break ;
+         }
+      }
+
+      while ( first < num )
+      {
+         INT32 iovNum = 0 ;
+         INT32 sent = 0 ;
+
+         ossMemset( &msg, 0, sizeof( msg ) ) ;
+         for ( INT32 i = first ; i < num && iovNum < OSS_SOCKET_MAX_VEC ;
+               ++i )
+         {
+            iov[ iovNum ].iov_base = (void*)pVec[ i ].pData ;
+            iov[ iovNum ].iov_len = pVec[ i ].len ;
+            ++iovNum ;
+         }
+         msg.msg_iov = iov ;
+         msg.msg_iovlen = iovNum ;
+
+         sent = ::sendmsg ( _fd, &msg, MSG_NOSIGNAL|flags ) ;
+         if ( -1 == sent )
+         {
+            rc = SOCKET_GETLASTERROR ;
+            if ( (EAGAIN == rc || EWOULDBLOCK == rc || ETIMEDOUT == rc ) &&
+                 _timeout > 0 )
+            {
+               rc = SDB_TIMEOUT ;
+               goto error ;
+            }
+            if ( SOCKET_EINTR == rc && retries < MAX_INTR_RETRIES )
+            {
+               retries ++ ;
+               continue ;
+            }
+            PD_LOG ( PDERROR, "Failed to send, rc = %d", rc ) ;
+            rc = SDB_NETWORK ;
+            goto error ;
+         }
+
+         sentLen += sent ;
+         while ( first < num && sent >= pVec[ first ].len )
+         {
+            sent -= pVec[ first ].len ;
+            pVec[ first ].pData += pVec[ first ].len ;
+            pVec[ first ].len = 0 ;
+            ++first ;
+         }
+         if ( first < num )
+         {
+            pVec[ first ].pData += sent ;
+            pVec[ first ].len -= sent ;
+         }
+      }
+      rc = SDB_OK ;
+      goto done ;
+   }
+#endif // _WINDOWS
+
+   // send the pieces one by one
+   for ( first = 0 ; first < num ; ++first )
+   {
+      INT32 pieceSent = 0 ;
+
+      if ( pVec[ first ].len <= 0 )
+      {
+         continue ;
+      }
+      rc = send ( pVec[ first ].pData, pVec[ first ].len, pieceSent,
+                  timeout, flags ) ;
+      sentLen += pieceSent ;
+      pVec[ first ].pData += pieceSent ;
+      pVec[ first ].len -= pieceSent ;
+      if ( rc )
+      {
+         goto done ;
+      }
+   }
+
+done :
+   PD_TRACE_EXITRC ( SDB_OSSSK_SENDV, rc );
+   return rc ;
+error :
+   if ( SDB_NETWORK == rc )
+   {
+      close() ;
+   }
+   goto done ;
+}
+
 // PD_TRACE_DECLARE_FUNCTION ( SDB_OSSSK_ISCONN, "ossSocket::isConnected" )
 BOOLEAN _ossSocket::isConnected ()
 {
@@ -39,6 +39,7 @@
 #include "pmd.hpp"
 #include "pmdSession.hpp"
 #include "pmdProcessor.hpp"
+#include "pmdPollService.hpp"
 #include "pdTrace.hpp"
 #include "pmdTrace.hpp"
 
@@ -81,5 +82,79 @@ namespace engine
                           pmdLocalAgentEntryPoint,
                           "Agent" ) ;
 
+   // return FALSE when the agent isn't counted in the bound any more
+   static BOOLEAN _pmdPollAgentServe( pmdEDUCB *cb, pmdPollService *pSvc,
+                                      pmdProcessor *pProcessor )
+   {
+      pmdLocalSession *pSession = NULL ;
+      UINT64 idleTime = 0 ;
+      BOOLEAN dedicated = FALSE ;
+
+      while ( !cb->isDisconnected() &&
+              idleTime < PMD_POLL_AGENT_IDLE_TIMEOUT )
+      {
+         if ( !pSvc->popSession( &pSession, OSS_ONE_SEC ) )
+         {
+            idleTime += OSS_ONE_SEC ;
+            continue ;
+         }
+         idleTime = 0 ;
+
+         pSession->attach( cb ) ;
+         pSession->attachProcessor( pProcessor ) ;
+         pSession->serve( FALSE ) ;
+         if ( !pSession->socket()->isClosed() && !pSession->isIdle() )
+         {
+            // the state is kept in the agent, wait for the client out of
+            // the bound
+            pSvc->dedicateAgent( cb ) ;
+            dedicated = TRUE ;
+            pSession->serve( TRUE ) ;
+         }
+         pSession->detachProcessor() ;
+         pSession->detach( pSession->socket()->isClosed() ) ;
+
+         if ( !pSvc->releaseSession( pSession, dedicated ) )
+         {
+            return FALSE ;
+         }
+         dedicated = FALSE ;
+      }
+      return TRUE ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_PMDPOLLAGENTENTPNT, "pmdPollAgentEntryPoint" )
+   INT32 pmdPollAgentEntryPoint( pmdEDUCB *cb, void *arg )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB_PMDPOLLAGENTENTPNT );
+
+      pmdPollService *pSvc = ( pmdPollService* )arg ;
+      BOOLEAN inBound = TRUE ;
+
+      if ( pmdGetDBRole() == SDB_ROLE_COORD )
+      {
+         pmdCoordProcessor coordProcessor ;
+         inBound = _pmdPollAgentServe( cb, pSvc, &coordProcessor ) ;
+      }
+      else
+      {
+         pmdDataProcessor dataProcessor ;
+         inBound = _pmdPollAgentServe( cb, pSvc, &dataProcessor ) ;
+      }
+
+      if ( inBound )
+      {
+         pSvc->onAgentExit() ;
+      }
+
+      PD_TRACE_EXITRC ( SDB_PMDPOLLAGENTENTPNT, rc );
+      return rc ;
+   }
+
+   PMD_DEFINE_ENTRYPOINT( EDU_TYPE_POLLAGENT, FALSE,
+                          pmdPollAgentEntryPoint,
+                          "PollAgent" ) ;
+
 }
 
@@ -38,10 +38,13 @@
 #include "pmd.hpp"
 #include "pmdCB.hpp"
 #include "rtnDictCreatorJob.hpp"
+#include "rtnExtentSealJob.hpp"
 #include "../bson/lib/md5.hpp"
 #include "ossDynamicLoad.hpp"
 #include "pmdModuleLoader.hpp"
 #include "ossProc.hpp"
+#include "msgCompress.hpp"
+#include "utilCompressor.hpp"
 
 namespace engine
 {
@@ -123,6 +126,11 @@ namespace engine
                    "rc: %d", port, rc ) ;
       PD_LOG( PDEVENT, "Listerning on port[%d]", port ) ;
 
+      rc = _pollService.init( pOptCB->maxPollAgent() ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to init poll service, rc: %d", rc ) ;
+
+      _applyNetCompress() ;
+
       rc = ossGetPort( pOptCB->getRestService(), port ) ;
       PD_RC_CHECK( rc, PDERROR, "Failed to get port by service name: %s, "
                    "rc: %d", pOptCB->getRestService(), rc ) ;
@@ -175,6 +183,14 @@ namespace engine
       }
 #endif // _LINUX
 
+      if ( _pollService.isEnabled() )
+      {
+         rc = pEDUMgr->startEDU( EDU_TYPE_SVCPOLLER, (void*)&_pollService,
+                                 &eduID ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to start service poller, rc: %d",
+                      rc ) ;
+      }
+
       rc = pEDUMgr->startEDU( EDU_TYPE_TCPLISTENER, (void*)_pTcpListener,
                               &eduID ) ;
       PD_RC_CHECK( rc, PDERROR, "Failed to start tcp listerner, rc: %d",
@@ -208,6 +224,10 @@ namespace engine
          rc = startDictCreatorJob( NULL ) ;
          PD_RC_CHECK( rc, PDERROR, "Start dictionary creating job "
                       "thread failed, rc: %d", rc ) ;
+
+         rc = startExtentSealJob( NULL ) ;
+         PD_RC_CHECK( rc, PDERROR, "Start extent seal job thread failed, "
+                      "rc: %d", rc ) ;
       }
 
    done:
@@ -233,6 +253,7 @@ namespace engine
          SDB_OSS_DEL _pHttpListener ;
          _pHttpListener = NULL ;
       }
+      _pollService.fini() ;
 
       finishForeignModule() ;
 
@@ -281,6 +302,24 @@ namespace engine
       pmdGetKRCB()->getSyncMgr()->setSyncDeep(
          pmdGetOptionCB()->isSyncDeep() ) ;
 
+      _applyNetCompress() ;
+   }
+
+   void _pmdController::_applyNetCompress()
+   {
+      const CHAR *pStr = pmdGetOptionCB()->netCompressStr() ;
+      UTIL_COMPRESSOR_TYPE type = utilString2CompressType( pStr ) ;
+
+      if ( !msgIsValidCompressType( type ) )
+      {
+         if ( 0 != ossStrcasecmp( pStr, "none" ) && 0 != *pStr )
+         {
+            PD_LOG( PDWARNING, "Invalid value[%s] of %s, the messages are "
+                    "not compressed", pStr, PMD_OPTION_NET_COMPRESS ) ;
+         }
+         type = UTIL_COMPRESSOR_INVALID ;
+      }
+      msgSetCompressConf( type, pmdGetOptionCB()->netCompressThreshold() ) ;
    }
 
    void _pmdController::registerCB( SDB_ROLE dbrole )
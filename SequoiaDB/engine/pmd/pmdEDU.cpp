@@ -45,6 +45,9 @@
 #include "pmd.hpp"
 #include "pdTrace.hpp"
 #include "pmdTrace.hpp"
+#if defined ( SDB_ENGINE )
+#include "dmsBlockExtent.hpp"
+#endif // SDB_ENGINE
 #include <map>
 
 namespace engine
@@ -127,6 +130,7 @@ namespace engine
       _relatedTransLSN  = DPS_INVALID_LSN_OFFSET ;
       _pTransNodeMap    = NULL ;
       _transRC          = SDB_OK ;
+      _pBlockCache      = NULL ;
 
       _curRequestID     = 1 ;
 #endif // SDB_ENGINE
@@ -179,6 +183,11 @@ namespace engine
 
 #if defined ( SDB_ENGINE )
       clearTransInfo() ;
+      if ( _pBlockCache )
+      {
+         SDB_OSS_DEL _pBlockCache ;
+         _pBlockCache = NULL ;
+      }
 #endif // SDB_ENGINE
 
       if ( _pCompressBuff )
@@ -1166,6 +1175,15 @@ namespace engine
       transInfo._waitLock     = _waitLock ;
    }
 
+   _dmsBlockCache* _pmdEDUCB::getBlockCache()
+   {
+      if ( !_pBlockCache )
+      {
+         _pBlockCache = SDB_OSS_NEW _dmsBlockCache() ;
+      }
+      return _pBlockCache ;
+   }
+
 #endif // SDB_ENGINE
 
    static OSS_THREAD_LOCAL _pmdEDUCB *__eduCB ;
@@ -75,6 +75,12 @@ namespace engine
    #define PMD_DEFAULT_MAX_REPLSYNC    (10)
    #define PMD_DFT_REPL_BUCKET_SIZE    (32)
    #define PMD_DFT_INDEX_SCAN_STEP     (100)
+   #define PMD_DFT_SCAN_BATCH_SIZE     (64)
+   #define PMD_DFT_INDEX_FILL_FACTOR   (90)
+   #define PMD_DFT_READ_AHEAD_SIZE     (32)
+   #define PMD_DFT_MAX_POLL_AGENT      (0)
+   #define PMD_DFT_NET_COMPRESS        "none"
+   #define PMD_DFT_NET_COMPRESS_THRESHOLD ( 4096 )
    #define PMD_DFT_START_SHIFT_TIME    (600)
    #define PMD_MAX_NUMPAGECLEAN        (50)
    #define PMD_MIN_PAGECLEANINTERVAL   (1000)
@@ -1464,6 +1470,7 @@ namespace engine
       ossMemset( _krcbLobPath, 0, OSS_MAX_PATHSIZE + 1 ) ;
       ossMemset( _krcbLobMetaPath, 0, OSS_MAX_PATHSIZE + 1 ) ;
       ossMemset( _auditMaskStr, 0, sizeof( _auditMaskStr ) ) ;
+      ossMemset( _netCompressStr, 0, sizeof( _netCompressStr ) ) ;
 
       _krcbMaxPool         = 0 ;
       _krcbDiagLvl         = (UINT16)PDWARNING ;
@@ -1479,6 +1486,11 @@ namespace engine
       _memDebugEnabled     = FALSE ;
       _memDebugSize        = 0 ;
       _indexScanStep       = PMD_DFT_INDEX_SCAN_STEP ;
+      _scanBatchSize       = PMD_DFT_SCAN_BATCH_SIZE ;
+      _indexFillFactor     = PMD_DFT_INDEX_FILL_FACTOR ;
+      _readAheadSize       = PMD_DFT_READ_AHEAD_SIZE ;
+      _maxPollAgent        = PMD_DFT_MAX_POLL_AGENT ;
+      _netCompressThreshold = PMD_DFT_NET_COMPRESS_THRESHOLD ;
       _dpslocal            = FALSE ;
       _traceOn             = FALSE ;
       _traceBufSz          = TRACE_DFT_BUFFER_SIZE ;
@@ -1639,6 +1651,24 @@ namespace engine
       rdxUInt( pEX, PMD_OPTION_INDEX_SCAN_STEP, _indexScanStep, FALSE, TRUE,
                PMD_DFT_INDEX_SCAN_STEP, TRUE ) ;
       rdvMinMax( pEX, _indexScanStep, 1, 10000, TRUE ) ;
+      rdxUInt( pEX, PMD_OPTION_SCAN_BATCH_SIZE, _scanBatchSize, FALSE, TRUE,
+               PMD_DFT_SCAN_BATCH_SIZE, TRUE ) ;
+      rdvMinMax( pEX, _scanBatchSize, 0, 1024, TRUE ) ;
+      rdxUInt( pEX, PMD_OPTION_INDEX_FILL_FACTOR, _indexFillFactor, FALSE,
+               TRUE, PMD_DFT_INDEX_FILL_FACTOR, TRUE ) ;
+      rdvMinMax( pEX, _indexFillFactor, 50, 100, TRUE ) ;
+      rdxUInt( pEX, PMD_OPTION_READ_AHEAD_SIZE, _readAheadSize, FALSE, TRUE,
+               PMD_DFT_READ_AHEAD_SIZE, TRUE ) ;
+      rdvMinMax( pEX, _readAheadSize, 0, 1024, TRUE ) ;
+      rdxUInt( pEX, PMD_OPTION_MAX_POLL_AGENT, _maxPollAgent, FALSE, FALSE,
+               PMD_DFT_MAX_POLL_AGENT, TRUE ) ;
+      rdvMinMax( pEX, _maxPollAgent, 0, 10000, TRUE ) ;
+      rdxString( pEX, PMD_OPTION_NET_COMPRESS, _netCompressStr,
+                 sizeof( _netCompressStr ), FALSE, TRUE,
+                 PMD_DFT_NET_COMPRESS, TRUE ) ;
+      rdxUInt( pEX, PMD_OPTION_NET_COMPRESS_THRESHOLD, _netCompressThreshold,
+               FALSE, TRUE, PMD_DFT_NET_COMPRESS_THRESHOLD, TRUE ) ;
+      rdvMinMax( pEX, _netCompressThreshold, 512, 67108864, TRUE ) ;
       rdxBooleanS( pEX, PMD_OPTION_DPSLOCAL, _dpslocal, FALSE, TRUE, FALSE,
                    TRUE ) ;
       rdxBooleanS( pEX, PMD_OPTION_TRACEON, _traceOn, FALSE, FALSE, FALSE,
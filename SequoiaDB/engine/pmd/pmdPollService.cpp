@@ -0,0 +1,326 @@
+/*******************************************************************************
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = pmdPollService.cpp
+
+   Descriptive Name = Process MoDel Poll Service
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of PMD component. This file contains functions of the service
+   which multiplexes the idle client sessions by epoll.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#include "pmdPollService.hpp"
+#include "pmdSession.hpp"
+#include "pmdEDUMgr.hpp"
+#include "pmd.hpp"
+#include "pd.hpp"
+
+#if defined (_LINUX)
+#include <sys/epoll.h>
+#endif // _LINUX
+
+namespace engine
+{
+
+   /*
+      _pmdPollService implement
+   */
+   _pmdPollService::_pmdPollService()
+   :_sessionNum( 0 ), _agentNum( 0 ), _idleAgentNum( 0 )
+   {
+      _epollFD = -1 ;
+      _maxAgentNum = 0 ;
+   }
+
+   _pmdPollService::~_pmdPollService()
+   {
+      fini() ;
+   }
+
+   INT32 _pmdPollService::init( UINT32 maxAgentNum )
+   {
+      INT32 rc = SDB_OK ;
+
+      if ( 0 == maxAgentNum )
+      {
+         goto done ;
+      }
+
+#if defined (_LINUX)
+      _epollFD = epoll_create( PMD_POLL_EVENT_NUM ) ;
+      if ( _epollFD < 0 )
+      {
+         PD_LOG( PDERROR, "Failed to create epoll, errno: %d",
+                 ossGetLastError() ) ;
+         rc = SDB_SYS ;
+         goto error ;
+      }
+      _maxAgentNum = maxAgentNum ;
+      PD_LOG( PDEVENT, "Client sessions are served by at most %u poll "
+              "agents", _maxAgentNum ) ;
+#else
+      PD_LOG( PDWARNING, "Poll service is not supported on this platform, "
+              "one agent is started for each connection" ) ;
+#endif // _LINUX
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   void _pmdPollService::fini()
+   {
+      SET_SESSION::iterator it ;
+      _pmdLocalSession *pSession = NULL ;
+
+      // all agents are gone, the left sessions are idle or in the queue
+      while ( _readyQue.try_pop( pSession ) )
+      {
+      }
+
+      for ( it = _sessions.begin() ; it != _sessions.end() ; ++it )
+      {
+         pSession = *it ;
+         pSession->disconnect() ;
+         SDB_OSS_DEL pSession ;
+         pmdGetKRCB()->getMonDBCB()->connDec() ;
+      }
+      _sessions.clear() ;
+      _sessionNum.poke( 0 ) ;
+
+#if defined (_LINUX)
+      if ( _epollFD >= 0 )
+      {
+         close( _epollFD ) ;
+         _epollFD = -1 ;
+      }
+#endif // _LINUX
+      _maxAgentNum = 0 ;
+   }
+
+   INT32 _pmdPollService::_arm( _pmdLocalSession *pSession, BOOLEAN isAdd )
+   {
+      INT32 rc = SDB_OK ;
+#if defined (_LINUX)
+      struct epoll_event event ;
+
+      ossMemset( &event, 0, sizeof( event ) ) ;
+      // one shot, the session is delivered to only one agent until it is
+      // armed again
+      event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT ;
+      event.data.ptr = (void*)pSession ;
+
+      if ( 0 != epoll_ctl( _epollFD, isAdd ? EPOLL_CTL_ADD : EPOLL_CTL_MOD,
+                           pSession->socket()->native(), &event ) )
+      {
+         PD_LOG( PDERROR, "Session[%s] failed to %s epoll, errno: %d",
+                 pSession->sessionName(), isAdd ? "add to" : "arm",
+                 ossGetLastError() ) ;
+         rc = SDB_NETWORK ;
+      }
+#else
+      rc = SDB_SYS ;
+#endif // _LINUX
+      return rc ;
+   }
+
+   INT32 _pmdPollService::addSession( SOCKET fd )
+   {
+      INT32 rc = SDB_OK ;
+      _pmdLocalSession *pSession = NULL ;
+
+      pSession = SDB_OSS_NEW _pmdLocalSession( fd ) ;
+      if ( !pSession )
+      {
+         ossSocket sock( &fd ) ;
+         sock.close() ;
+         PD_LOG( PDERROR, "Failed to alloc session" ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+
+      _latch.get() ;
+      _sessions.insert( pSession ) ;
+      _latch.release() ;
+      _sessionNum.inc() ;
+
+      rc = _arm( pSession, TRUE ) ;
+      if ( rc )
+      {
+         _latch.get() ;
+         _sessions.erase( pSession ) ;
+         _latch.release() ;
+         _sessionNum.dec() ;
+         pSession->disconnect() ;
+         SDB_OSS_DEL pSession ;
+         goto error ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _pmdPollService::poll( _pmdEDUCB *cb, INT32 timeout )
+   {
+      INT32 rc = SDB_OK ;
+#if defined (_LINUX)
+      struct epoll_event events[ PMD_POLL_EVENT_NUM ] ;
+      INT32 num = epoll_wait( _epollFD, events, PMD_POLL_EVENT_NUM,
+                              timeout ) ;
+      if ( num < 0 )
+      {
+         if ( EINTR != ossGetLastError() )
+         {
+            PD_LOG( PDERROR, "Failed to wait epoll, errno: %d",
+                    ossGetLastError() ) ;
+            rc = SDB_SYS ;
+         }
+         goto done ;
+      }
+
+      for ( INT32 i = 0 ; i < num ; ++i )
+      {
+         // the closed ones are also pushed, the agent finds the socket is
+         // closed and cleans up the session
+         _readyQue.push( (_pmdLocalSession*)events[ i ].data.ptr ) ;
+      }
+
+      if ( num > 0 )
+      {
+         cb->incEventCount( num ) ;
+         _startAgents( cb ) ;
+      }
+   done:
+#endif // _LINUX
+      return rc ;
+   }
+
+   void _pmdPollService::_startAgents( _pmdEDUCB *cb )
+   {
+      INT32 rc = SDB_OK ;
+      EDUID eduID = PMD_INVALID_EDUID ;
+
+      while ( _readyQue.size() > _idleAgentNum.peek() && _reserveAgent() )
+      {
+         // count the new agent as idle, so that it is not started again
+         // before it pops the session
+         _idleAgentNum.inc() ;
+         rc = cb->getEDUMgr()->startEDU( EDU_TYPE_POLLAGENT, (void*)this,
+                                         &eduID ) ;
+         if ( rc )
+         {
+            _idleAgentNum.dec() ;
+            _agentNum.dec() ;
+            PD_LOG( ( rc == SDB_QUIESCED ? PDWARNING : PDERROR ),
+                    "Failed to start poll agent, rc: %d", rc ) ;
+            break ;
+         }
+      }
+   }
+
+   BOOLEAN _pmdPollService::_reserveAgent()
+   {
+      UINT32 agentNum = _agentNum.peek() ;
+
+      // the dedicated agents go back to the bound concurrently
+      while ( agentNum < _maxAgentNum )
+      {
+         if ( _agentNum.compareAndSwap( agentNum, agentNum + 1 ) )
+         {
+            return TRUE ;
+         }
+         agentNum = _agentNum.peek() ;
+      }
+      return FALSE ;
+   }
+
+   BOOLEAN _pmdPollService::popSession( _pmdLocalSession **ppSession,
+                                        INT64 timeout )
+   {
+      BOOLEAN got = _readyQue.timed_wait_and_pop( *ppSession, timeout ) ;
+      if ( got )
+      {
+         _idleAgentNum.dec() ;
+      }
+      return got ;
+   }
+
+   void _pmdPollService::dedicateAgent( _pmdEDUCB *cb )
+   {
+      _agentNum.dec() ;
+      // the ready sessions are served by the others
+      _startAgents( cb ) ;
+   }
+
+   BOOLEAN _pmdPollService::releaseSession( _pmdLocalSession *pSession,
+                                            BOOLEAN dedicated )
+   {
+      if ( pSession->socket()->isClosed() ||
+           SDB_OK != _arm( pSession, FALSE ) )
+      {
+         _closeSession( pSession ) ;
+      }
+
+      if ( dedicated && !_reserveAgent() )
+      {
+         return FALSE ;
+      }
+      _idleAgentNum.inc() ;
+      return TRUE ;
+   }
+
+   void _pmdPollService::_closeSession( _pmdLocalSession *pSession )
+   {
+      _latch.get() ;
+      _sessions.erase( pSession ) ;
+      _latch.release() ;
+      _sessionNum.dec() ;
+
+#if defined (_LINUX)
+      if ( !pSession->socket()->isClosed() )
+      {
+         epoll_ctl( _epollFD, EPOLL_CTL_DEL, pSession->socket()->native(),
+                    NULL ) ;
+      }
+#endif // _LINUX
+      pSession->disconnect() ;
+      SDB_OSS_DEL pSession ;
+      pmdGetKRCB()->getMonDBCB()->connDec() ;
+   }
+
+   void _pmdPollService::onAgentExit()
+   {
+      _idleAgentNum.dec() ;
+      _agentNum.dec() ;
+   }
+
+}
+
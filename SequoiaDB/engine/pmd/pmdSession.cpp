@@ -37,6 +37,7 @@
 #include "pmd.hpp"
 #include "rtn.hpp"
 #include "pmdTrace.hpp"
+#include "msgCompress.hpp"
 
 using namespace bson ;
 
@@ -53,6 +54,11 @@ namespace engine
       ossMemset( (void*)&_replyHeader, 0, sizeof(_replyHeader) ) ;
       _needReply = TRUE ;
       _needRollback = FALSE ;
+      _pinned = FALSE ;
+      _compressType = UTIL_COMPRESSOR_INVALID ;
+      _compressThreshold = 0 ;
+      _pPlainBuff = NULL ;
+      _plainBuffSize = 0 ;
    }
 
    _pmdLocalSession::~_pmdLocalSession()
@@ -75,16 +81,18 @@ namespace engine
 
    void _pmdLocalSession::_onDetach ()
    {
+      // the buffer is allocated from the edu
+      if ( _pPlainBuff )
+      {
+         releaseBuff( _pPlainBuff ) ;
+         _pPlainBuff = NULL ;
+         _plainBuffSize = 0 ;
+      }
    }
 
    INT32 _pmdLocalSession::run()
    {
       INT32 rc                = SDB_OK ;
-      UINT32 msgSize          = 0 ;
-      CHAR *pBuff             = NULL ;
-      INT32 buffSize          = 0 ;
-      pmdEDUMgr *pmdEDUMgr    = NULL ;
-      monDBCB *mondbcb        = pmdGetKRCB()->getMonDBCB () ;
 
       if ( !_pEDUCB )
       {
@@ -92,101 +100,186 @@ namespace engine
          goto error ;
       }
 
-      pmdEDUMgr = _pEDUCB->getEDUMgr() ;
+      while ( !_pEDUCB->isDisconnected() && !_socket.isClosed() )
+      {
+         rc = _recvAndProcess() ;
+         if ( rc )
+         {
+            break ;
+         }
+      } // end while
+
+   done:
+      disconnect() ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _pmdLocalSession::serve( BOOLEAN untilIdle )
+   {
+      INT32 rc                = SDB_OK ;
+
+      if ( !_pEDUCB )
+      {
+         rc = SDB_SYS ;
+         goto error ;
+      }
 
       while ( !_pEDUCB->isDisconnected() && !_socket.isClosed() )
       {
-         _pEDUCB->resetInterrupt() ;
-         _pEDUCB->resetInfo( EDU_INFO_ERROR ) ;
-         _pEDUCB->resetLsn() ;
+         rc = _recvAndProcess() ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         else if ( !untilIdle || isIdle() )
+         {
+            // the left requests are reported by epoll again
+            goto done ;
+         }
+      }
 
-         rc = recvData( (CHAR*)&msgSize, sizeof(UINT32) ) ;
+      // the agent is forced
+      disconnect() ;
+
+   done:
+      return rc ;
+   error:
+      disconnect() ;
+      goto done ;
+   }
+
+   BOOLEAN _pmdLocalSession::isIdle()
+   {
+      if ( _pinned || !_pEDUCB )
+      {
+         return FALSE ;
+      }
+      return 0 == _pEDUCB->contextNum() &&
+             DPS_INVALID_TRANS_ID == _pEDUCB->getTransID() &&
+             !_pEDUCB->isTransaction() ;
+   }
+
+   INT32 _pmdLocalSession::_recvAndProcess()
+   {
+      INT32 rc                = SDB_OK ;
+      UINT32 msgSize          = 0 ;
+      CHAR *pBuff             = NULL ;
+      INT32 buffSize          = 0 ;
+      MsgHeader *pMsg         = NULL ;
+      pmdEDUMgr *pmdEDUMgr    = _pEDUCB->getEDUMgr() ;
+      monDBCB *mondbcb        = pmdGetKRCB()->getMonDBCB () ;
+
+      _pEDUCB->resetInterrupt() ;
+      _pEDUCB->resetInfo( EDU_INFO_ERROR ) ;
+      _pEDUCB->resetLsn() ;
+
+      rc = recvData( (CHAR*)&msgSize, sizeof(UINT32) ) ;
+      if ( rc )
+      {
+         if ( SDB_APP_FORCED != rc )
+         {
+            PD_LOG( PDERROR, "Session[%s] failed to recv msg size, "
+                    "rc: %d", sessionName(), rc ) ;
+         }
+         goto error ;
+      }
+
+      if ( msgSize == (UINT32)MSG_SYSTEM_INFO_LEN )
+      {
+         rc = _recvSysInfoMsg( msgSize, &pBuff, buffSize ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         rc = _processSysInfoRequest( pBuff ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+
+         _setHandshakeReceived() ;
+      }
+      else if ( msgSize < sizeof(MsgHeader) || msgSize > SDB_MAX_MSG_LENGTH )
+      {
+         PD_LOG( PDERROR, "Session[%s] recv msg size[%d] is less than "
+                 "MsgHeader size[%d] or more than max msg size[%d]",
+                 sessionName(), msgSize, sizeof(MsgHeader),
+                 SDB_MAX_MSG_LENGTH ) ;
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+      else
+      {
+         pBuff = getBuff( msgSize + 1 ) ;
+         if ( !pBuff )
+         {
+            rc = SDB_OOM ;
+            goto error ;
+         }
+         buffSize = getBuffLen() ;
+         *(UINT32*)pBuff = msgSize ;
+         INT32 hasReceived = 0 ;
+         rc = recvData( pBuff + sizeof(UINT32),
+                        msgSize - sizeof(UINT32),
+                        PMD_RECV_DATA_AFTER_LENGTH_TIMEOUT,
+                        TRUE, &hasReceived ) ;
          if ( rc )
          {
             if ( SDB_APP_FORCED != rc )
             {
-               PD_LOG( PDERROR, "Session[%s] failed to recv msg size, "
-                       "rc: %d", sessionName(), rc ) ;
+               PD_LOG( PDERROR, "Session[%s] failed to recv msg[len: %u, "
+                       "recieved: %d], rc: %d",
+                       sessionName(), msgSize - sizeof(UINT32),
+                       hasReceived, rc ) ;
             }
-            break ;
+            goto error ;
          }
 
-         if ( msgSize == (UINT32)MSG_SYSTEM_INFO_LEN )
+         _pEDUCB->incEventCount() ;
+         mondbcb->addReceiveNum() ;
+         pBuff[ msgSize ] = 0 ;
+
+         pMsg = (MsgHeader*)pBuff ;
+         if ( MSG_COM_COMPRESS_NEGO_REQ == pMsg->opCode )
          {
-            rc = _recvSysInfoMsg( msgSize, &pBuff, buffSize ) ;
+            rc = _processCompressNego( pMsg ) ;
             if ( rc )
             {
-               break ;
+               goto error ;
             }
-            rc = _processSysInfoRequest( pBuff ) ;
+            goto done ;
+         }
+         else if ( MSG_COM_COMPRESSED == pMsg->opCode )
+         {
+            rc = _uncompressMsg( pMsg, &pMsg ) ;
             if ( rc )
             {
-               break ;
+               goto error ;
             }
+         }
 
-            _setHandshakeReceived() ;
+         if ( SDB_OK != ( rc = pmdEDUMgr->activateEDU( _pEDUCB ) ) )
+         {
+            PD_LOG( PDERROR, "Session[%s] activate edu failed, rc: %d",
+                    sessionName(), rc ) ;
+            goto error ;
          }
-         else if ( msgSize < sizeof(MsgHeader) || msgSize > SDB_MAX_MSG_LENGTH )
+         rc = _processMsg( pMsg ) ;
+         if ( rc )
          {
-            PD_LOG( PDERROR, "Session[%s] recv msg size[%d] is less than "
-                    "MsgHeader size[%d] or more than max msg size[%d]",
-                    sessionName(), msgSize, sizeof(MsgHeader),
-                    SDB_MAX_MSG_LENGTH ) ;
-            rc = SDB_INVALIDARG ;
-            break ;
+            goto error ;
          }
-         else
+         if ( SDB_OK != ( rc = pmdEDUMgr->waitEDU( _pEDUCB ) ) )
          {
-            pBuff = getBuff( msgSize + 1 ) ;
-            if ( !pBuff )
-            {
-               rc = SDB_OOM ;
-               break ;
-            }
-            buffSize = getBuffLen() ;
-            *(UINT32*)pBuff = msgSize ;
-            INT32 hasReceived = 0 ;
-            rc = recvData( pBuff + sizeof(UINT32),
-                           msgSize - sizeof(UINT32),
-                           PMD_RECV_DATA_AFTER_LENGTH_TIMEOUT,
-                           TRUE, &hasReceived ) ;
-            if ( rc )
-            {
-               if ( SDB_APP_FORCED != rc )
-               {
-                  PD_LOG( PDERROR, "Session[%s] failed to recv msg[len: %u, "
-                          "recieved: %d], rc: %d",
-                          sessionName(), msgSize - sizeof(UINT32),
-                          hasReceived, rc ) ;
-               }
-               break ;
-            }
-
-            _pEDUCB->incEventCount() ;
-            mondbcb->addReceiveNum() ;
-            pBuff[ msgSize ] = 0 ;
-            if ( SDB_OK != ( rc = pmdEDUMgr->activateEDU( _pEDUCB ) ) )
-            {
-               PD_LOG( PDERROR, "Session[%s] activate edu failed, rc: %d",
-                       sessionName(), rc ) ;
-               break ;
-            }
-            rc = _processMsg( (MsgHeader*)pBuff ) ;
-            if ( rc )
-            {
-               break ;
-            }
-            if ( SDB_OK != ( rc = pmdEDUMgr->waitEDU( _pEDUCB ) ) )
-            {
-               PD_LOG( PDERROR, "Session[%s] wait edu failed, rc: %d",
-                       sessionName(), rc ) ;
-               break ;
-            }
+            PD_LOG( PDERROR, "Session[%s] wait edu failed, rc: %d",
+                    sessionName(), rc ) ;
+            goto error ;
          }
-      } // end while
+      }
 
    done:
-      disconnect() ;
       return rc ;
    error:
       goto done ;
@@ -285,6 +378,16 @@ namespace engine
          _needRollback = FALSE ;
       }
 
+      if ( MSG_BS_QUERY_REQ == msg->opCode &&
+           msg->messageLength > (INT32)sizeof( MsgOpQuery ) &&
+           0 == ossStrcmp( ((MsgOpQuery*)msg)->name,
+                           CMD_ADMIN_PREFIX CMD_NAME_SETSESS_ATTR ) )
+      {
+         // the session attributes are kept in the agent, the session can't
+         // be moved to another agent any more
+         _pinned = TRUE ;
+      }
+
       MON_START_OP( _pEDUCB->getMonAppCB() ) ;
       _pEDUCB->getMonAppCB()->setLastOpType( msg->opCode ) ;
 
@@ -379,35 +482,185 @@ namespace engine
                                    INT32 bodyLen )
    {
       INT32 rc = SDB_OK ;
+      ossSockVec vec[ 2 ] ;
 
       SDB_ASSERT( responseMsg->header.messageLength ==
                   (SINT32)(sizeof(MsgOpReply) + bodyLen),
                   "Invalid msg" ) ;
 
-      rc = sendData( (const CHAR*)responseMsg, sizeof(MsgOpReply) ) ;
+      if ( pBody && msgNeedCompress( _compressType, _compressThreshold,
+                                     responseMsg->header.messageLength ) )
+      {
+         BOOLEAN sent = FALSE ;
+         rc = _replyCompressed( responseMsg, pBody, bodyLen, sent ) ;
+         if ( rc || sent )
+         {
+            goto done ;
+         }
+      }
+
+      // the body is sent from the buffer of the context directly, with the
+      // header in one gather write
+      vec[ 0 ].pData = (const CHAR*)responseMsg ;
+      vec[ 0 ].len = sizeof( MsgOpReply ) ;
+      vec[ 1 ].pData = pBody ;
+      vec[ 1 ].len = pBody ? bodyLen : 0 ;
+      rc = sendDataV( vec, pBody ? 2 : 1 ) ;
       if ( rc )
       {
-         PD_LOG( PDERROR, "Session[%s] failed to send response header, rc: %d",
+         PD_LOG( PDERROR, "Session[%s] failed to send response, rc: %d",
                  sessionName(), rc ) ;
          goto error ;
       }
-      if ( pBody )
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+
+   INT32 _pmdLocalSession::_processCompressNego( const MsgHeader *msg )
+   {
+      INT32 rc = SDB_OK ;
+      const MsgComCompressNego *pReq = ( const MsgComCompressNego* )msg ;
+      MsgComCompressNego reply ;
+
+      if ( msg->messageLength < (INT32)sizeof( MsgComCompressNego ) )
+      {
+         PD_LOG( PDERROR, "Session[%s] recv invalid compress negotiation "
+                 "msg[len: %d]", sessionName(), msg->messageLength ) ;
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+
+      // the client chooses the compressor it supports
+      if ( msgIsValidCompressType( pReq->compressorType ) )
+      {
+         _compressType = pReq->compressorType ;
+         _compressThreshold = pReq->threshold > 0 ?
+                              pReq->threshold : msgGetCompressThreshold() ;
+      }
+      else
+      {
+         _compressType = UTIL_COMPRESSOR_INVALID ;
+         _compressThreshold = 0 ;
+      }
+
+      msgBuildCompressNego( reply, MSG_COM_COMPRESS_NEGO_RSP,
+                            _compressType, _compressThreshold ) ;
+      reply.header.requestID = msg->requestID ;
+      reply.header.TID = msg->TID ;
+      reply.header.routeID = pmdGetNodeID() ;
+
+      rc = sendData( (const CHAR*)&reply, reply.header.messageLength ) ;
+      PD_RC_CHECK( rc, PDERROR, "Session[%s] failed to send compress "
+                   "negotiation reply, rc: %d", sessionName(), rc ) ;
+
+      PD_LOG( PDDEBUG, "Session[%s] replies are compressed by %s when "
+              "not shorter than %u", sessionName(),
+              msgIsValidCompressType( _compressType ) ?
+              utilCompressType2String( (UINT8)_compressType ) : "none",
+              _compressThreshold ) ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _pmdLocalSession::_uncompressMsg( MsgHeader *msg,
+                                           MsgHeader **ppPlainMsg )
+   {
+      INT32 rc = SDB_OK ;
+      UINT32 len = 0 ;
+      monAppCB *pMonAppCB = _pEDUCB->getMonAppCB() ;
+
+      if ( msg->messageLength < (INT32)sizeof( MsgComCompressed ) )
+      {
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+
+      // keep one more byte for the terminating zero, like the request
+      // buffer does
+      len = msgUncompressedLen( msg ) + 1 ;
+      if ( len > SDB_MAX_MSG_LENGTH + 1 )
+      {
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+      if ( _plainBuffSize < len )
       {
-         rc = sendData( pBody, bodyLen ) ;
+         rc = _pPlainBuff ?
+              reallocBuff( len, &_pPlainBuff, &_plainBuffSize ) :
+              allocBuff( len, &_pPlainBuff, &_plainBuffSize ) ;
          if ( rc )
          {
-            PD_LOG( PDERROR, "Session[%s] failed to send response body, rc: %d",
-                    sessionName(), rc ) ;
+            _pPlainBuff = NULL ;
+            _plainBuffSize = 0 ;
             goto error ;
          }
       }
 
+      rc = msgUncompress( msg, _pPlainBuff, _plainBuffSize ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+      _pPlainBuff[ len - 1 ] = 0 ;
+
+      pMonAppCB->compressWireIn += msg->messageLength ;
+      pMonAppCB->compressRawIn += len - 1 ;
+      *ppPlainMsg = ( MsgHeader* )_pPlainBuff ;
+
    done:
       return rc ;
    error:
+      PD_LOG( PDERROR, "Session[%s] failed to uncompress msg[len: %d], "
+              "rc: %d", sessionName(), msg->messageLength, rc ) ;
       goto done ;
    }
 
+   INT32 _pmdLocalSession::_replyCompressed( MsgOpReply *responseMsg,
+                                             const CHAR *pBody,
+                                             INT32 bodyLen,
+                                             BOOLEAN &sent )
+   {
+      INT32 rc = SDB_OK ;
+      CHAR *pOut = NULL ;
+      UINT32 outLen = 0 ;
+      monAppCB *pMonAppCB = _pEDUCB->getMonAppCB() ;
+
+      sent = FALSE ;
+      // the reply header is kept raw
+      if ( SDB_OK != msgCompress( _compressType, (const CHAR*)responseMsg,
+                                  sizeof( MsgOpReply ), pBody, bodyLen,
+                                  &pOut, outLen ) )
+      {
+         goto done ;
+      }
+
+      rc = sendData( pOut, outLen ) ;
+      if ( rc )
+      {
+         PD_LOG( PDERROR, "Session[%s] failed to send compressed response, "
+                 "rc: %d", sessionName(), rc ) ;
+         goto error ;
+      }
+      sent = TRUE ;
+      pMonAppCB->compressWireOut += outLen ;
+      pMonAppCB->compressRawOut += responseMsg->header.messageLength ;
+
+   done:
+      if ( pOut )
+      {
+         SDB_OSS_FREE( pOut ) ;
+      }
+      return rc ;
+   error:
+      goto done ;
+   }
 
 }
 
@@ -111,18 +111,26 @@ namespace engine
       _pEDUCB->setName( sessionName() ) ;
       _pEDUCB->setClientSock( socket() ) ;
       _client.attachCB( cb ) ;
+      if ( _client.isAuthed() )
+      {
+         _pEDUCB->setUserInfo( _client.getUsername(),
+                               _client.getPassword() ) ;
+      }
 
       _onAttach() ;
    }
 
-   void _pmdSession::detach ()
+   void _pmdSession::detach ( BOOLEAN logout )
    {
       PD_LOG( PDINFO, "Session[%s] detach edu[%d]", sessionName(),
               eduID() ) ;
 
       _onDetach() ;
       clear() ;
-      _client.logout() ;
+      if ( logout )
+      {
+         _client.logout() ;
+      }
       _client.detachCB() ;
       _pEDUCB->detachSession() ;
       _pEDUCB->setClientSock( NULL ) ;
@@ -279,6 +287,41 @@ namespace engine
       return rc ;
    }
 
+   INT32 _pmdSession::sendDataV( ossSockVec *pVec, INT32 num,
+                                 INT32 timeout, INT32 flags )
+   {
+      INT32 rc = SDB_OK ;
+      INT32 sentSize = 0 ;
+      INT32 totalSentSize = 0 ;
+      INT32 realTimeout = timeout < 0 ? OSS_SOCKET_DFT_TIMEOUT : timeout ;
+
+      while ( TRUE )
+      {
+         if ( _pEDUCB && _pEDUCB->isForced () )
+         {
+            rc = SDB_APP_FORCED ;
+            goto done ;
+         }
+         // the pieces are moved forward by the sent bytes
+         rc = _socket.sendv ( pVec, num, sentSize, realTimeout, flags ) ;
+         totalSentSize += sentSize ;
+         if ( timeout < 0 && SDB_TIMEOUT == rc )
+         {
+            continue ;
+         }
+         break ;
+      }
+
+   done :
+#if defined ( SDB_ENGINE )
+      if ( totalSentSize > 0 )
+      {
+         pmdGetKRCB()->getMonDBCB()->svcNetOutAdd( totalSentSize ) ;
+      }
+#endif // SDB_ENGINE
+      return rc ;
+   }
+
    INT32 _pmdSession::recvData( CHAR * pData, INT32 size, INT32 timeout,
                                 BOOLEAN block, INT32 *pRecvLen, INT32 flags )
    {
@@ -41,6 +41,7 @@
 #include "ossMem.hpp"
 #include "pmd.hpp"
 #include "pmdEDUMgr.hpp"
+#include "pmdController.hpp"
 #include "ossSocket.hpp"
 #include "pdTrace.hpp"
 #include "pmdTrace.hpp"
@@ -59,6 +60,7 @@ namespace engine
       pmdEDUMgr * eduMgr = cb->getEDUMgr() ;
       EDUID agentEDU = PMD_INVALID_EDUID ;
       ossSocket *pListerner = ( ossSocket* )pData ;
+      pmdPollService *pPollSvc = sdbGetPMDController()->getPollService() ;
 
       if ( SDB_OK != ( rc = eduMgr->activateEDU ( cb ) ) )
       {
@@ -141,6 +143,19 @@ namespace engine
             continue ;
          }
 
+         if ( pPollSvc->isEnabled() )
+         {
+            // the session is served by the poll agents
+            rc = pPollSvc->addSession( s ) ;
+            if ( rc )
+            {
+               PD_LOG( PDERROR, "Failed to add session to poll service, "
+                       "rc: %d", rc ) ;
+               mondbcb->connDec() ;
+            }
+            continue ;
+         }
+
          rc = eduMgr->startEDU ( EDU_TYPE_AGENT, pData, &agentEDU ) ;
          if ( rc )
          {
@@ -180,5 +195,38 @@ namespace engine
                           pmdTcpListenerEntryPoint,
                           "TCPListener" ) ;
 
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_PMDSVCPOLLERENTPNT, "pmdSvcPollerEntryPoint" )
+   INT32 pmdSvcPollerEntryPoint ( pmdEDUCB *cb, void *pData )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB_PMDSVCPOLLERENTPNT ) ;
+      pmdEDUMgr * eduMgr = cb->getEDUMgr() ;
+      pmdPollService *pPollSvc = ( pmdPollService* )pData ;
+
+      rc = eduMgr->activateEDU ( cb ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to activate edu[%s], rc: %d",
+                   cb->toString().c_str(), rc ) ;
+
+      while ( !cb->isDisconnected() )
+      {
+         rc = pPollSvc->poll( cb, PMD_POLL_WAIT_TIMEOUT ) ;
+         if ( rc )
+         {
+            ossSleep( PMD_POLL_WAIT_TIMEOUT ) ;
+         }
+      }
+      rc = SDB_OK ;
+
+   done :
+      PD_TRACE_EXITRC ( SDB_PMDSVCPOLLERENTPNT, rc );
+      return rc;
+   error :
+      goto done ;
+   }
+
+   PMD_DEFINE_ENTRYPOINT( EDU_TYPE_SVCPOLLER, TRUE,
+                          pmdSvcPollerEntryPoint,
+                          "SvcPoller" ) ;
+
 }
 
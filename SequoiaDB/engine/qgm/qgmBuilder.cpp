@@ -355,6 +355,7 @@ namespace engine
          else
          {
             _qgmPlan *phy = NULL ;
+            _qgmOptiTreeNode *subNode = NULL ;
             rc = _addPhyAggr( (_qgmOptiAggregation *)logicalTree,
                               physicalTree, phy ) ;
             if ( SDB_OK != rc )
@@ -371,7 +372,17 @@ namespace engine
             }
             else
             {
-               rc = _buildPhysicalNode( logicalTree->getSubNode(0), phy ) ;
+               subNode = logicalTree->getSubNode( 0 ) ;
+               if ( _canHashAggr( (_qgmOptiAggregation *)logicalTree,
+                                  subNode ) &&
+                    ((_qgmPlAggregation *)phy)->enableHashAggr(
+                       buildOrderby( ((_qgmOptiSort *)subNode)->_orderby ) ) )
+               {
+                  // the records are grouped by hash, the sort is not
+                  // needed any more
+                  subNode = subNode->getSubNode( 0 ) ;
+               }
+               rc = _buildPhysicalNode( subNode, phy ) ;
                if ( SDB_OK != rc )
                {
                   goto error ;
@@ -772,6 +783,37 @@ namespace engine
       goto done ;
    }
 
+   // the sort below the aggregation only sorts the records by the group
+   // keys, which can be replaced by the hash aggregation
+   BOOLEAN _qgmBuilder::_canHashAggr( _qgmOptiAggregation *aggr,
+                                      _qgmOptiTreeNode *subNode )
+   {
+      qgmOPFieldVec *orderby = NULL ;
+
+      if ( QGM_OPTI_TYPE_SORT != subNode->getType() ||
+           !subNode->hasChildren() )
+      {
+         return FALSE ;
+      }
+
+      orderby = &( ((_qgmOptiSort *)subNode)->_orderby ) ;
+      if ( aggr->_groupby.empty() ||
+           orderby->size() != aggr->_groupby.size() )
+      {
+         return FALSE ;
+      }
+
+      for ( UINT32 i = 0 ; i < orderby->size() ; ++i )
+      {
+         if ( (*orderby)[i].value.attr() != aggr->_groupby[i].value.attr() )
+         {
+            return FALSE ;
+         }
+      }
+
+      return TRUE ;
+   }
+
    // PD_TRACE_DECLARE_FUNCTION( SDB__QGMBUILDER__CRTPHYSORT, "_qgmBuilder::_crtPhySort" )
    INT32 _qgmBuilder::_crtPhySort( _qgmOptiSort *sort,
                                    _qgmPlan *father,
@@ -0,0 +1,1325 @@
+/*******************************************************************************
+
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = qgmHashAggr.cpp
+
+   Descriptive Name = QGM Hash Aggregation
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of QGM component. This file contains functions for the hash
+   table used by the aggregation plan.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#include "qgmHashAggr.hpp"
+#include "qgmSelector.hpp"
+#include "rtnSQLFuncFactory.hpp"
+#include "ixmKey.hpp"
+#include "pmd.hpp"
+#include "ossUtil.hpp"
+#include "qgmUtil.hpp"
+#include "pdTrace.hpp"
+#include "qgmTrace.hpp"
+#include <algorithm>
+
+using namespace bson ;
+
+namespace engine
+{
+   static QGM_HASH_AGGR_FUNC _qgmHashAggrFuncType( const _rtnSQLFunc *func )
+   {
+      const CHAR *name = func->name() ;
+      QGM_HASH_AGGR_FUNC type = QGM_HASH_AGGR_UNKNOWN ;
+
+      if ( 1 != func->param().size() )
+      {
+      }
+      else if ( 0 == ossStrcasecmp( RTN_SQL_FUNC_COUNT, name ) )
+      {
+         type = QGM_HASH_AGGR_COUNT ;
+      }
+      else if ( 0 == ossStrcasecmp( RTN_SQL_FUNC_SUM, name ) )
+      {
+         type = QGM_HASH_AGGR_SUM ;
+      }
+      else if ( 0 == ossStrcasecmp( RTN_SQL_FUNC_AVG, name ) )
+      {
+         type = QGM_HASH_AGGR_AVG ;
+      }
+      else if ( 0 == ossStrcasecmp( RTN_SQL_FUNC_MIN, name ) )
+      {
+         type = QGM_HASH_AGGR_MIN ;
+      }
+      else if ( 0 == ossStrcasecmp( RTN_SQL_FUNC_MAX, name ) )
+      {
+         type = QGM_HASH_AGGR_MAX ;
+      }
+      else if ( 0 == ossStrcasecmp( RTN_SQL_FUNC_FIRST, name ) )
+      {
+         type = QGM_HASH_AGGR_FIRST ;
+      }
+      else if ( 0 == ossStrcasecmp( RTN_SQL_FUNC_LAST, name ) )
+      {
+         type = QGM_HASH_AGGR_LAST ;
+      }
+
+      return type ;
+   }
+
+   // mix the bits, so that both the slots ( low bits ) and the partitions
+   // ( high bits ) are spread
+   static OSS_INLINE UINT32 _qgmHashAggrHash( const UINT8 *pKey, UINT32 len )
+   {
+      UINT32 hash = ossHash( (const CHAR *)pKey, len ) ;
+      hash ^= hash >> 16 ;
+      hash *= 0x85EBCA6B ;
+      hash ^= hash >> 13 ;
+      hash *= 0xC2B2AE35 ;
+      hash ^= hash >> 16 ;
+      return hash ;
+   }
+
+   struct _qgmHashAggrGroupLess
+   {
+      const _qgmHashAggr *_pAggr ;
+
+      _qgmHashAggrGroupLess( const _qgmHashAggr *pAggr )
+      :_pAggr( pAggr )
+      {
+      }
+
+      bool operator()( UINT32 left, UINT32 right ) const
+      {
+         return _pAggr->_compareGroup( left, right ) < 0 ;
+      }
+   } ;
+
+   /*
+      _qgmHashAggr implement
+   */
+   _qgmHashAggr::_qgmHashAggr()
+   :_groupby( NULL ),
+    _pOrder( NULL ),
+    _memLimit( 0 ),
+    _pSlots( NULL ),
+    _slotNum( 0 ),
+    _pKeyBuf( NULL ),
+    _keyBufSize( 0 ),
+    _keyBufUsed( 0 ),
+    _valueSize( 0 ),
+    _pNormBuf( NULL ),
+    _normBufSize( 0 ),
+    _pBatchGroup( NULL ),
+    _pBatchValue( NULL ),
+    _pBatchValid( NULL ),
+    _batchNum( 0 ),
+    _depth( 0 ),
+    _spilled( FALSE ),
+    _pUnit( NULL ),
+    _blkBegin( 0 ),
+    _pReadBuf( NULL ),
+    _readBufSize( 0 ),
+    _fetchPos( 0 ),
+    _finished( FALSE ),
+    _recordNum( 0 )
+   {
+      for ( UINT32 i = 0 ; i < QGM_HASH_AGGR_PART_NUM ; ++i )
+      {
+         _pPartBuf[ i ] = NULL ;
+         _partBufUsed[ i ] = 0 ;
+      }
+   }
+
+   _qgmHashAggr::~_qgmHashAggr()
+   {
+      clear() ;
+
+      SAFE_OSS_FREE( _pSlots ) ;
+      SAFE_OSS_FREE( _pKeyBuf ) ;
+      SAFE_OSS_FREE( _pNormBuf ) ;
+      SAFE_OSS_FREE( _pBatchGroup ) ;
+      SAFE_OSS_FREE( _pBatchValue ) ;
+      SAFE_OSS_FREE( _pBatchValid ) ;
+      SAFE_OSS_DELETE( _pOrder ) ;
+   }
+
+   BOOLEAN _qgmHashAggr::isSupported( const std::vector<_rtnSQLFunc *> &func )
+   {
+      std::vector<_rtnSQLFunc *>::const_iterator itr = func.begin() ;
+      if ( func.empty() )
+      {
+         return FALSE ;
+      }
+      for ( ; itr != func.end() ; ++itr )
+      {
+         if ( QGM_HASH_AGGR_UNKNOWN == _qgmHashAggrFuncType( *itr ) )
+         {
+            return FALSE ;
+         }
+      }
+      return TRUE ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION( SDB__QGMHASHAGGR_INIT, "_qgmHashAggr::init" )
+   INT32 _qgmHashAggr::init( const std::vector<_rtnSQLFunc *> &func,
+                             const _qgmSelector *groupby,
+                             const BSONObj &orderBy,
+                             UINT64 memLimit )
+   {
+      PD_TRACE_ENTRY( SDB__QGMHASHAGGR_INIT ) ;
+      INT32 rc = SDB_OK ;
+      UINT32 funcNum = func.size() ;
+
+      SDB_ASSERT( NULL != groupby && !groupby->empty(), "impossible" ) ;
+      SDB_ASSERT( isSupported( func ), "impossible" ) ;
+
+      _func = func ;
+      _groupby = groupby ;
+      _memLimit = memLimit ;
+
+      try
+      {
+         _orderBy = orderBy.getOwned() ;
+         SAFE_OSS_DELETE( _pOrder ) ;
+         _pOrder = new(std::nothrow) Ordering( Ordering::make( _orderBy ) ) ;
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "unexpected err happened:%s", e.what() ) ;
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+      PD_CHECK( NULL != _pOrder, SDB_OOM, error, PDERROR,
+                "Failed to allocate ordering" ) ;
+
+      for ( UINT32 i = 0 ; i < funcNum ; ++i )
+      {
+         _funcType.push_back( _qgmHashAggrFuncType( func[ i ] ) ) ;
+         _alias.push_back( func[ i ]->alias().toString() ) ;
+      }
+
+      _pBatchGroup = ( UINT32 * )SDB_OSS_MALLOC( sizeof( UINT32 ) *
+                                                 QGM_HASH_AGGR_BATCH_SIZE ) ;
+      _pBatchValue = ( FLOAT64 * )SDB_OSS_MALLOC( sizeof( FLOAT64 ) *
+                                                  QGM_HASH_AGGR_BATCH_SIZE *
+                                                  funcNum ) ;
+      _pBatchValid = ( BOOLEAN * )SDB_OSS_MALLOC( sizeof( BOOLEAN ) *
+                                                  QGM_HASH_AGGR_BATCH_SIZE *
+                                                  funcNum ) ;
+      _pSlots = ( UINT32 * )SDB_OSS_MALLOC( sizeof( UINT32 ) *
+                                            QGM_HASH_AGGR_MIN_SLOT_NUM ) ;
+      if ( NULL == _pBatchGroup || NULL == _pBatchValue ||
+           NULL == _pBatchValid || NULL == _pSlots )
+      {
+         PD_LOG( PDERROR, "Failed to allocate memory for hash aggregation" ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+      _slotNum = QGM_HASH_AGGR_MIN_SLOT_NUM ;
+      ossMemset( _pSlots, 0, sizeof( UINT32 ) * _slotNum ) ;
+
+   done:
+      PD_TRACE_EXITRC( SDB__QGMHASHAGGR_INIT, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   void _qgmHashAggr::clear()
+   {
+      _resetTable() ;
+
+      for ( UINT32 i = 0 ; i < QGM_HASH_AGGR_PART_NUM ; ++i )
+      {
+         SAFE_OSS_FREE( _pPartBuf[ i ] ) ;
+         _partBufUsed[ i ] = 0 ;
+         _parts[ i ]._blks.clear() ;
+      }
+      _pendingParts.clear() ;
+
+      for ( UINT32 i = 0 ; i < _runs.size() ; ++i )
+      {
+         SAFE_OSS_FREE( _runs[ i ]._pBuf ) ;
+      }
+      _runs.clear() ;
+
+      SAFE_OSS_FREE( _pReadBuf ) ;
+      _readBufSize = 0 ;
+      // the temp file is removed with the unit
+      SAFE_OSS_DELETE( _pUnit ) ;
+      _blkBegin = 0 ;
+
+      _depth = 0 ;
+      _spilled = FALSE ;
+      _finished = FALSE ;
+      _recordNum = 0 ;
+   }
+
+   void _qgmHashAggr::_resetTable()
+   {
+      std::vector<qgmHashAggrAccum>::iterator itr = _accums.begin() ;
+      for ( ; itr != _accums.end() ; ++itr )
+      {
+         SAFE_OSS_DELETE( itr->_pDecimal ) ;
+      }
+      _accums.clear() ;
+      _groups.clear() ;
+      _sorted.clear() ;
+      if ( _pSlots )
+      {
+         ossMemset( _pSlots, 0, sizeof( UINT32 ) * _slotNum ) ;
+      }
+      _keyBufUsed = 0 ;
+      _valueSize = 0 ;
+      _batchNum = 0 ;
+      _fetchPos = 0 ;
+   }
+
+   UINT64 _qgmHashAggr::_memUsed() const
+   {
+      return (UINT64)_slotNum * sizeof( UINT32 ) +
+             (UINT64)_groups.capacity() * sizeof( qgmHashAggrGroup ) +
+             (UINT64)_accums.capacity() * sizeof( qgmHashAggrAccum ) +
+             _keyBufSize + _valueSize ;
+   }
+
+   INT32 _qgmHashAggr::push( const qgmFetchOut &next, const BSONObj &key )
+   {
+      ++_recordNum ;
+      return _push( next, key ) ;
+   }
+
+   INT32 _qgmHashAggr::_push( const qgmFetchOut &next, const BSONObj &key )
+   {
+      INT32 rc = SDB_OK ;
+      UINT32 groupID = 0 ;
+
+      rc = _findGroup( key, groupID ) ;
+      if ( SDB_OK == rc )
+      {
+         rc = _update( groupID, next ) ;
+      }
+      else if ( SDB_DMS_EOC == rc )
+      {
+         // no room for the new group
+         rc = _spill( next, groupID ) ;
+      }
+
+      return rc ;
+   }
+
+   // when the group is not found and it can't be added, SDB_DMS_EOC is
+   // returned with the hash in groupID
+   INT32 _qgmHashAggr::_findGroup( const BSONObj &key, UINT32 &groupID )
+   {
+      INT32 rc = SDB_OK ;
+      UINT32 normLen = 0 ;
+      UINT32 hash = 0 ;
+      UINT32 mask = _slotNum - 1 ;
+      UINT32 slot = 0 ;
+
+      try
+      {
+         ixmKeyOwned keyOwned( key ) ;
+         BOOLEAN normalized = FALSE ;
+
+         while ( TRUE )
+         {
+            if ( _normBufSize > 0 )
+            {
+               normalized = keyOwned.normalize( *_pOrder, _pNormBuf + 1,
+                                                _normBufSize - 1, normLen ) ;
+               normLen = normalized ? normLen + 1 : 1 + key.objsize() ;
+               if ( normLen <= _normBufSize )
+               {
+                  break ;
+               }
+            }
+            else
+            {
+               normLen = QGM_HASH_AGGR_MIN_KEY_BUF_SIZE ;
+            }
+
+            UINT8 *pTmp = ( UINT8 * )SDB_OSS_REALLOC( _pNormBuf, normLen ) ;
+            PD_CHECK( NULL != pTmp, SDB_OOM, error, PDERROR,
+                      "Failed to allocate normalized key buffer" ) ;
+            _pNormBuf = pTmp ;
+            _normBufSize = normLen ;
+         }
+
+         if ( normalized )
+         {
+            _pNormBuf[ 0 ] = QGM_HASH_AGGR_NORM_KEY ;
+         }
+         else
+         {
+            _pNormBuf[ 0 ] = QGM_HASH_AGGR_RAW_KEY ;
+            ossMemcpy( _pNormBuf + 1, key.objdata(), key.objsize() ) ;
+         }
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "unexpected err happened:%s", e.what() ) ;
+         rc = SDB_SYS ;
+         goto error ;
+      }
+
+      hash = _qgmHashAggrHash( _pNormBuf, normLen ) ;
+      slot = hash & mask ;
+      while ( 0 != _pSlots[ slot ] )
+      {
+         const qgmHashAggrGroup &group = _groups[ _pSlots[ slot ] - 1 ] ;
+         if ( group._hash == hash && group._normLen == normLen &&
+              0 == ossMemcmp( _pKeyBuf + group._keyOffset, _pNormBuf,
+                              normLen ) )
+         {
+            groupID = _pSlots[ slot ] - 1 ;
+            goto done ;
+         }
+         slot = ( slot + 1 ) & mask ;
+      }
+
+      if ( _memUsed() >= _memLimit && _depth < QGM_HASH_AGGR_MAX_DEPTH )
+      {
+         groupID = hash ;
+         rc = SDB_DMS_EOC ;
+         goto done ;
+      }
+
+      rc = _newGroup( _pNormBuf, normLen, key, hash, groupID ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashAggr::_newGroup( const UINT8 *pNorm, UINT32 normLen,
+                                  const BSONObj &key, UINT32 hash,
+                                  UINT32 &groupID )
+   {
+      INT32 rc = SDB_OK ;
+      qgmHashAggrGroup group ;
+      UINT32 mask = 0 ;
+      UINT32 slot = 0 ;
+
+      if ( ( _groups.size() + 1 ) * 2 > _slotNum )
+      {
+         rc = _growSlots() ;
+         if ( rc )
+         {
+            goto error ;
+         }
+      }
+
+      rc = _reserveKeyBuf( normLen + key.objsize() ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+
+      group._keyOffset = _keyBufUsed ;
+      group._normLen = normLen ;
+      group._hash = hash ;
+      ossMemcpy( _pKeyBuf + _keyBufUsed, pNorm, normLen ) ;
+      ossMemcpy( _pKeyBuf + _keyBufUsed + normLen, key.objdata(),
+                 key.objsize() ) ;
+      _keyBufUsed += normLen + key.objsize() ;
+
+      try
+      {
+         _groups.push_back( group ) ;
+         _accums.resize( _accums.size() + _func.size() ) ;
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "unexpected err happened:%s", e.what() ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+
+      groupID = _groups.size() - 1 ;
+      mask = _slotNum - 1 ;
+      slot = hash & mask ;
+      while ( 0 != _pSlots[ slot ] )
+      {
+         slot = ( slot + 1 ) & mask ;
+      }
+      _pSlots[ slot ] = groupID + 1 ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashAggr::_growSlots()
+   {
+      INT32 rc = SDB_OK ;
+      UINT32 slotNum = _slotNum * 2 ;
+      UINT32 mask = slotNum - 1 ;
+      UINT32 *pSlots = ( UINT32 * )SDB_OSS_MALLOC( sizeof( UINT32 ) *
+                                                   slotNum ) ;
+      PD_CHECK( NULL != pSlots, SDB_OOM, error, PDERROR,
+                "Failed to allocate %u slots", slotNum ) ;
+      ossMemset( pSlots, 0, sizeof( UINT32 ) * slotNum ) ;
+
+      for ( UINT32 i = 0 ; i < _groups.size() ; ++i )
+      {
+         UINT32 slot = _groups[ i ]._hash & mask ;
+         while ( 0 != pSlots[ slot ] )
+         {
+            slot = ( slot + 1 ) & mask ;
+         }
+         pSlots[ slot ] = i + 1 ;
+      }
+
+      SDB_OSS_FREE( _pSlots ) ;
+      _pSlots = pSlots ;
+      _slotNum = slotNum ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashAggr::_reserveKeyBuf( UINT64 size )
+   {
+      INT32 rc = SDB_OK ;
+      UINT64 newSize = _keyBufSize > 0 ? _keyBufSize :
+                       QGM_HASH_AGGR_RUN_BUF_SIZE ;
+      CHAR *pTmp = NULL ;
+
+      if ( _keyBufUsed + size <= _keyBufSize )
+      {
+         goto done ;
+      }
+
+      while ( newSize < _keyBufUsed + size )
+      {
+         newSize *= 2 ;
+      }
+      pTmp = ( CHAR * )SDB_OSS_REALLOC( _pKeyBuf, newSize ) ;
+      PD_CHECK( NULL != pTmp, SDB_OOM, error, PDERROR,
+                "Failed to allocate key buffer, size: %llu", newSize ) ;
+      _pKeyBuf = pTmp ;
+      _keyBufSize = newSize ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashAggr::_update( UINT32 groupID, const qgmFetchOut &next )
+   {
+      INT32 rc = SDB_OK ;
+      UINT32 funcNum = _func.size() ;
+
+      try
+      {
+         for ( UINT32 i = 0 ; i < funcNum ; ++i )
+         {
+            const qgmOpField &field = _func[ i ]->param()[ 0 ] ;
+            qgmHashAggrAccum &accum = _accums[ groupID * funcNum + i ] ;
+            UINT32 pos = i * QGM_HASH_AGGR_BATCH_SIZE + _batchNum ;
+            BOOLEAN setValue = FALSE ;
+            BSONElement ele ;
+
+            if ( !field.empty() )
+            {
+               next.element( field.value, ele ) ;
+            }
+            _pBatchValid[ pos ] = FALSE ;
+
+            switch ( _funcType[ i ] )
+            {
+               case QGM_HASH_AGGR_COUNT :
+                  _pBatchValid[ pos ] = !ele.eoo() ;
+                  break ;
+               case QGM_HASH_AGGR_SUM :
+               case QGM_HASH_AGGR_AVG :
+                  if ( !ele.isNumber() )
+                  {
+                  }
+                  else if ( NumberDecimal == ele.type() )
+                  {
+                     if ( NULL == accum._pDecimal )
+                     {
+                        accum._pDecimal = new(std::nothrow) bsonDecimal() ;
+                        PD_CHECK( NULL != accum._pDecimal, SDB_OOM, error,
+                                  PDERROR, "Failed to allocate decimal" ) ;
+                        _valueSize += sizeof( bsonDecimal ) ;
+                     }
+                     accum._pDecimal->add( ele.numberDecimal() ) ;
+                     ++accum._count ;
+                  }
+                  else
+                  {
+                     _pBatchValue[ pos ] = ele.Number() ;
+                     _pBatchValid[ pos ] = TRUE ;
+                  }
+                  break ;
+               case QGM_HASH_AGGR_MIN :
+                  setValue = !ele.eoo() && !ele.isNull() &&
+                             ( accum._value.isEmpty() ||
+                               0 < accum._value.firstElement().woCompare(
+                                   ele, FALSE ) ) ;
+                  break ;
+               case QGM_HASH_AGGR_MAX :
+                  setValue = !ele.eoo() && !ele.isNull() &&
+                             ( accum._value.isEmpty() ||
+                               0 > accum._value.firstElement().woCompare(
+                                   ele, FALSE ) ) ;
+                  break ;
+               case QGM_HASH_AGGR_FIRST :
+                  setValue = !ele.eoo() && accum._value.isEmpty() ;
+                  break ;
+               case QGM_HASH_AGGR_LAST :
+                  setValue = !ele.eoo() ;
+                  break ;
+               default :
+                  SDB_ASSERT( FALSE, "impossible" ) ;
+                  break ;
+            }
+
+            if ( setValue )
+            {
+               BSONObjBuilder builder ;
+               builder.append( ele ) ;
+               _valueSize -= accum._value.isEmpty() ?
+                             0 : accum._value.objsize() ;
+               accum._value = builder.obj() ;
+               _valueSize += accum._value.objsize() ;
+            }
+         }
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "unexpected err happened:%s", e.what() ) ;
+         rc = SDB_SYS ;
+         goto error ;
+      }
+
+      _pBatchGroup[ _batchNum ] = groupID ;
+      if ( ++_batchNum >= QGM_HASH_AGGR_BATCH_SIZE )
+      {
+         _flushBatch() ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   void _qgmHashAggr::_flushBatch()
+   {
+      UINT32 funcNum = _func.size() ;
+
+      for ( UINT32 i = 0 ; i < funcNum && _batchNum > 0 ; ++i )
+      {
+         const FLOAT64 *pValue = _pBatchValue + i * QGM_HASH_AGGR_BATCH_SIZE ;
+         const BOOLEAN *pValid = _pBatchValid + i * QGM_HASH_AGGR_BATCH_SIZE ;
+         qgmHashAggrAccum *pAccum = &_accums[ 0 ] + i ;
+
+         switch ( _funcType[ i ] )
+         {
+            case QGM_HASH_AGGR_COUNT :
+               for ( UINT32 j = 0 ; j < _batchNum ; ++j )
+               {
+                  pAccum[ _pBatchGroup[ j ] * funcNum ]._count +=
+                     pValid[ j ] ? 1 : 0 ;
+               }
+               break ;
+            case QGM_HASH_AGGR_SUM :
+            case QGM_HASH_AGGR_AVG :
+               for ( UINT32 j = 0 ; j < _batchNum ; ++j )
+               {
+                  if ( pValid[ j ] )
+                  {
+                     qgmHashAggrAccum &accum =
+                        pAccum[ _pBatchGroup[ j ] * funcNum ] ;
+                     accum._sum += pValue[ j ] ;
+                     ++accum._count ;
+                  }
+               }
+               break ;
+            default :
+               break ;
+         }
+      }
+      _batchNum = 0 ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION( SDB__QGMHASHAGGR__SPILL, "_qgmHashAggr::_spill" )
+   INT32 _qgmHashAggr::_spill( const qgmFetchOut &next, UINT32 hash )
+   {
+      PD_TRACE_ENTRY( SDB__QGMHASHAGGR__SPILL ) ;
+      INT32 rc = SDB_OK ;
+      UINT32 shift = 32 - QGM_HASH_AGGR_PART_BITS * ( _depth + 1 ) ;
+      UINT32 index = ( hash >> shift ) & ( QGM_HASH_AGGR_PART_NUM - 1 ) ;
+      BSONObj obj ;
+      UINT32 size = 0 ;
+
+      try
+      {
+         // the record is read back without the alias, so the records
+         // of a join are merged
+         obj = NULL == next.next ? next.obj : next.mergedObj() ;
+         size = obj.objsize() ;
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "unexpected err happened:%s", e.what() ) ;
+         rc = SDB_SYS ;
+         goto error ;
+      }
+
+      if ( NULL == _pUnit )
+      {
+         DMS_TMP_FILE_ID fileID = qgmNewTmpFileID() ;
+         _pUnit = new(std::nothrow) _dmsTmpBlkUnit() ;
+         PD_CHECK( NULL != _pUnit, SDB_OOM, error, PDERROR,
+                   "Failed to allocate temp unit" ) ;
+         rc = _pUnit->openFile( pmdGetOptionCB()->getTmpPath(), fileID ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to open temp file, rc: %d", rc ) ;
+         PD_LOG( PDDEBUG, "Hash aggregation spills to temp file, "
+                 "groups: %u, memory: %llu", _groups.size(), _memUsed() ) ;
+      }
+
+      if ( NULL == _pPartBuf[ index ] )
+      {
+         _pPartBuf[ index ] = ( CHAR * )SDB_OSS_MALLOC(
+                                 QGM_HASH_AGGR_SPILL_BUF_SIZE ) ;
+         PD_CHECK( NULL != _pPartBuf[ index ], SDB_OOM, error, PDERROR,
+                   "Failed to allocate spill buffer" ) ;
+         _partBufUsed[ index ] = 0 ;
+      }
+
+      if ( _partBufUsed[ index ] + size > QGM_HASH_AGGR_SPILL_BUF_SIZE )
+      {
+         rc = _flushPart( index ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+      }
+
+      if ( size > QGM_HASH_AGGR_SPILL_BUF_SIZE )
+      {
+         rc = _writeBlk( obj.objdata(), size, _parts[ index ]._blks ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+      }
+      else
+      {
+         ossMemcpy( _pPartBuf[ index ] + _partBufUsed[ index ],
+                    obj.objdata(), size ) ;
+         _partBufUsed[ index ] += size ;
+      }
+      _spilled = TRUE ;
+
+   done:
+      PD_TRACE_EXITRC( SDB__QGMHASHAGGR__SPILL, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashAggr::_flushPart( UINT32 index )
+   {
+      INT32 rc = SDB_OK ;
+
+      if ( _partBufUsed[ index ] > 0 )
+      {
+         rc = _writeBlk( _pPartBuf[ index ], _partBufUsed[ index ],
+                         _parts[ index ]._blks ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         _partBufUsed[ index ] = 0 ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashAggr::_writeBlk( const CHAR *pData, UINT64 size,
+                                  RTN_SORT_BLKS &blks )
+   {
+      INT32 rc = SDB_OK ;
+      dmsTmpBlk blk ;
+
+      // the blocks may be read between the writes
+      rc = _pUnit->seek( _blkBegin ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to seek temp file, rc: %d", rc ) ;
+
+      rc = _pUnit->write( pData, size, TRUE ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to write temp file, rc: %d", rc ) ;
+
+      rc = _pUnit->buildBlk( _blkBegin, size, blk ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to build block, rc: %d", rc ) ;
+
+      blks.push_back( blk ) ;
+      _blkBegin += size ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashAggr::_readBlk( dmsTmpBlk &blk )
+   {
+      INT32 rc = SDB_OK ;
+      UINT64 got = 0 ;
+
+      if ( blk.size() > _readBufSize )
+      {
+         CHAR *pTmp = ( CHAR * )SDB_OSS_REALLOC( _pReadBuf, blk.size() ) ;
+         PD_CHECK( NULL != pTmp, SDB_OOM, error, PDERROR,
+                   "Failed to allocate read buffer, size: %llu",
+                   blk.size() ) ;
+         _pReadBuf = pTmp ;
+         _readBufSize = blk.size() ;
+      }
+
+      blk.reset() ;
+      rc = _pUnit->read( blk, blk.size(), _pReadBuf, got ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to read temp file, rc: %d", rc ) ;
+      PD_CHECK( got == blk.size(), SDB_SYS, error, PDERROR,
+                "Read %llu bytes of block[%s]", got,
+                blk.toString().c_str() ) ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION( SDB__QGMHASHAGGR_FINISH, "_qgmHashAggr::finish" )
+   INT32 _qgmHashAggr::finish()
+   {
+      PD_TRACE_ENTRY( SDB__QGMHASHAGGR_FINISH ) ;
+      INT32 rc = SDB_OK ;
+
+      rc = _finishPass() ;
+      if ( rc )
+      {
+         goto error ;
+      }
+
+      if ( _spilled )
+      {
+         // group the spilled partitions one by one, each of them gives a
+         // sorted run, and the runs are merged
+         while ( !_pendingParts.empty() )
+         {
+            qgmHashAggrPart part = _pendingParts.front() ;
+            _pendingParts.pop_front() ;
+
+            rc = _loadPart( part ) ;
+            if ( rc )
+            {
+               goto error ;
+            }
+
+            rc = _finishPass() ;
+            if ( rc )
+            {
+               goto error ;
+            }
+         }
+
+         for ( UINT32 i = 0 ; i < _runs.size() ; ++i )
+         {
+            rc = _nextOfRun( _runs[ i ] ) ;
+            if ( rc )
+            {
+               goto error ;
+            }
+         }
+      }
+      _finished = TRUE ;
+
+   done:
+      PD_TRACE_EXITRC( SDB__QGMHASHAGGR_FINISH, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashAggr::_finishPass()
+   {
+      INT32 rc = SDB_OK ;
+
+      _flushBatch() ;
+
+      for ( UINT32 i = 0 ; i < QGM_HASH_AGGR_PART_NUM ; ++i )
+      {
+         rc = _flushPart( i ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+
+         if ( !_parts[ i ]._blks.empty() )
+         {
+            _parts[ i ]._depth = _depth + 1 ;
+            _pendingParts.push_back( _parts[ i ] ) ;
+            _parts[ i ]._blks.clear() ;
+         }
+      }
+
+      _sortGroups() ;
+
+      if ( _spilled )
+      {
+         rc = _saveRun() ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         _resetTable() ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION( SDB__QGMHASHAGGR__LOADPART, "_qgmHashAggr::_loadPart" )
+   INT32 _qgmHashAggr::_loadPart( qgmHashAggrPart &part )
+   {
+      PD_TRACE_ENTRY( SDB__QGMHASHAGGR__LOADPART ) ;
+      INT32 rc = SDB_OK ;
+      RTN_SORT_BLKS::iterator itr = part._blks.begin() ;
+
+      _depth = part._depth ;
+      if ( _depth >= QGM_HASH_AGGR_MAX_DEPTH )
+      {
+         PD_LOG( PDWARNING, "Hash aggregation partition can't be split "
+                 "any more, the memory limit is ignored" ) ;
+      }
+
+      for ( ; itr != part._blks.end() ; ++itr )
+      {
+         UINT64 offset = 0 ;
+
+         rc = _readBlk( *itr ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+
+         while ( offset < itr->size() )
+         {
+            qgmFetchOut next ;
+            BSONObj key ;
+
+            next.obj = BSONObj( _pReadBuf + offset ) ;
+            offset += next.obj.objsize() ;
+
+            rc = _groupby->select( next, key ) ;
+            PD_RC_CHECK( rc, PDERROR, "Failed to select group key, rc: %d",
+                         rc ) ;
+
+            rc = _push( next, key ) ;
+            if ( rc )
+            {
+               goto error ;
+            }
+         }
+      }
+
+   done:
+      PD_TRACE_EXITRC( SDB__QGMHASHAGGR__LOADPART, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashAggr::_compareGroup( UINT32 left, UINT32 right ) const
+   {
+      const UINT8 *pLeft = ( const UINT8 * )_keyOf( left ) ;
+      const UINT8 *pRight = ( const UINT8 * )_keyOf( right ) ;
+
+      if ( QGM_HASH_AGGR_NORM_KEY == pLeft[ 0 ] &&
+           QGM_HASH_AGGR_NORM_KEY == pRight[ 0 ] )
+      {
+         UINT32 leftLen = _groups[ left ]._normLen ;
+         UINT32 rightLen = _groups[ right ]._normLen ;
+         INT32 result = ossMemcmp( pLeft, pRight,
+                                   OSS_MIN( leftLen, rightLen ) ) ;
+         if ( 0 != result )
+         {
+            return result ;
+         }
+         return leftLen < rightLen ? -1 : ( leftLen > rightLen ? 1 : 0 ) ;
+      }
+
+      return _bsonKeyOf( left ).woCompare( _bsonKeyOf( right ), _orderBy,
+                                           FALSE ) ;
+   }
+
+   void _qgmHashAggr::_sortGroups()
+   {
+      _sorted.resize( _groups.size() ) ;
+      for ( UINT32 i = 0 ; i < _groups.size() ; ++i )
+      {
+         _sorted[ i ] = i ;
+      }
+      std::sort( _sorted.begin(), _sorted.end(),
+                 _qgmHashAggrGroupLess( this ) ) ;
+      _fetchPos = 0 ;
+   }
+
+   INT32 _qgmHashAggr::_result( UINT32 groupID, BSONObj &result )
+   {
+      INT32 rc = SDB_OK ;
+      UINT32 funcNum = _func.size() ;
+
+      try
+      {
+         BSONObjBuilder builder ;
+         for ( UINT32 i = 0 ; i < funcNum ; ++i )
+         {
+            qgmHashAggrAccum &accum = _accums[ groupID * funcNum + i ] ;
+            const std::string &alias = _alias[ i ] ;
+
+            switch ( _funcType[ i ] )
+            {
+               case QGM_HASH_AGGR_COUNT :
+                  builder.append( alias, accum._count ) ;
+                  break ;
+               case QGM_HASH_AGGR_SUM :
+               case QGM_HASH_AGGR_AVG :
+                  if ( 0 == accum._count )
+                  {
+                     builder.appendNull( alias ) ;
+                  }
+                  else if ( NULL == accum._pDecimal ||
+                            accum._pDecimal->isZero() )
+                  {
+                     builder.append( alias, QGM_HASH_AGGR_SUM ==
+                                     _funcType[ i ] ? accum._sum :
+                                     accum._sum / accum._count ) ;
+                  }
+                  else
+                  {
+                     bsonDecimal tmpDecimal ;
+                     rc = tmpDecimal.fromDouble( accum._sum ) ;
+                     PD_RC_CHECK( rc, PDERROR, "from double failed:"
+                                  "double=%f,rc=%d", accum._sum, rc ) ;
+                     rc = accum._pDecimal->add( tmpDecimal ) ;
+                     PD_RC_CHECK( rc, PDERROR, "decimal add failed:rc=%d",
+                                  rc ) ;
+                     accum._sum = 0 ;
+                     if ( QGM_HASH_AGGR_SUM == _funcType[ i ] )
+                     {
+                        builder.append( alias, *accum._pDecimal ) ;
+                     }
+                     else
+                     {
+                        rc = accum._pDecimal->div( accum._count,
+                                                   tmpDecimal ) ;
+                        PD_RC_CHECK( rc, PDERROR, "decimal div failed:"
+                                     "rc=%d", rc ) ;
+                        builder.append( alias, tmpDecimal ) ;
+                     }
+                  }
+                  break ;
+               default :
+                  if ( accum._value.isEmpty() )
+                  {
+                     builder.appendNull( alias ) ;
+                  }
+                  else if ( alias.empty() &&
+                            ( QGM_HASH_AGGR_FIRST == _funcType[ i ] ||
+                              QGM_HASH_AGGR_LAST == _funcType[ i ] ) )
+                  {
+                     builder.append( accum._value.firstElement() ) ;
+                  }
+                  else
+                  {
+                     builder.appendAs( accum._value.firstElement(), alias ) ;
+                  }
+                  break ;
+            }
+         }
+         result = builder.obj() ;
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "unexpected err happened:%s", e.what() ) ;
+         rc = SDB_SYS ;
+         goto error ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // a run is the pairs of the group key and the result, in key order
+   INT32 _qgmHashAggr::_saveRun()
+   {
+      INT32 rc = SDB_OK ;
+      CHAR *pBuf = NULL ;
+      UINT32 used = 0 ;
+      UINT64 runBegin = _blkBegin ;
+      UINT64 runSize = 0 ;
+      qgmHashAggrRun run ;
+      RTN_SORT_BLKS blks ;
+
+      if ( _sorted.empty() )
+      {
+         goto done ;
+      }
+
+      pBuf = ( CHAR * )SDB_OSS_MALLOC( QGM_HASH_AGGR_RUN_BUF_SIZE ) ;
+      PD_CHECK( NULL != pBuf, SDB_OOM, error, PDERROR,
+                "Failed to allocate run buffer" ) ;
+
+      for ( UINT32 i = 0 ; i < _sorted.size() ; ++i )
+      {
+         BSONObj key = _bsonKeyOf( _sorted[ i ] ) ;
+         BSONObj result ;
+         const BSONObj *pObjs[ 2 ] = { &key, &result } ;
+
+         rc = _result( _sorted[ i ], result ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+
+         for ( UINT32 j = 0 ; j < 2 ; ++j )
+         {
+            UINT32 size = pObjs[ j ]->objsize() ;
+            if ( used + size > QGM_HASH_AGGR_RUN_BUF_SIZE && used > 0 )
+            {
+               rc = _writeBlk( pBuf, used, blks ) ;
+               if ( rc )
+               {
+                  goto error ;
+               }
+               runSize += used ;
+               used = 0 ;
+            }
+
+            if ( size > QGM_HASH_AGGR_RUN_BUF_SIZE )
+            {
+               rc = _writeBlk( pObjs[ j ]->objdata(), size, blks ) ;
+               if ( rc )
+               {
+                  goto error ;
+               }
+               runSize += size ;
+            }
+            else
+            {
+               ossMemcpy( pBuf + used, pObjs[ j ]->objdata(), size ) ;
+               used += size ;
+            }
+         }
+      }
+
+      if ( used > 0 )
+      {
+         rc = _writeBlk( pBuf, used, blks ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         runSize += used ;
+      }
+
+      // the blocks of a run are written one after another, they are read
+      // as one block
+      rc = _pUnit->buildBlk( runBegin, runSize, run._blk ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to build block, rc: %d", rc ) ;
+      _runs.push_back( run ) ;
+
+   done:
+      SAFE_OSS_FREE( pBuf ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashAggr::_nextOfRun( qgmHashAggrRun &run )
+   {
+      INT32 rc = SDB_OK ;
+      UINT32 need = sizeof( INT32 ) ;
+      UINT32 keySize = 0 ;
+
+      // [ key ][ result ], the size of each bson is in its first 4 bytes
+      while ( TRUE )
+      {
+         UINT32 left = run._loaded - run._read ;
+         UINT64 got = 0 ;
+
+         if ( left >= need )
+         {
+            if ( 0 == keySize )
+            {
+               keySize = *( UINT32 * )( run._pBuf + run._read ) ;
+               need = keySize + sizeof( INT32 ) ;
+               continue ;
+            }
+            else if ( need == keySize + sizeof( INT32 ) )
+            {
+               need = keySize +
+                      *( UINT32 * )( run._pBuf + run._read + keySize ) ;
+               continue ;
+            }
+            break ;
+         }
+
+         if ( run._read > 0 )
+         {
+            ossMemmove( run._pBuf, run._pBuf + run._read, left ) ;
+            run._loaded = left ;
+            run._read = 0 ;
+         }
+         if ( need > run._bufSize )
+         {
+            UINT32 size = OSS_MAX( need, QGM_HASH_AGGR_RUN_BUF_SIZE ) ;
+            CHAR *pTmp = ( CHAR * )SDB_OSS_REALLOC( run._pBuf, size ) ;
+            PD_CHECK( NULL != pTmp, SDB_OOM, error, PDERROR,
+                      "Failed to allocate run buffer, size: %u", size ) ;
+            run._pBuf = pTmp ;
+            run._bufSize = size ;
+         }
+
+         rc = _pUnit->read( run._blk, run._bufSize - run._loaded,
+                            run._pBuf + run._loaded, got ) ;
+         if ( SDB_DMS_EOC == rc )
+         {
+            rc = SDB_OK ;
+            got = 0 ;
+         }
+         PD_RC_CHECK( rc, PDERROR, "Failed to read run, rc: %d", rc ) ;
+         if ( 0 == got )
+         {
+            PD_CHECK( 0 == left, SDB_SYS, error, PDERROR,
+                      "Run is truncated, %u bytes left", left ) ;
+            run._eof = TRUE ;
+            goto done ;
+         }
+         run._loaded += got ;
+      }
+
+      run._key = BSONObj( run._pBuf + run._read ) ;
+      run._result = BSONObj( run._pBuf + run._read + keySize ) ;
+      run._read += need ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashAggr::_fetchMerged( BSONObj &result )
+   {
+      INT32 rc = SDB_OK ;
+      INT32 minRun = -1 ;
+
+      for ( UINT32 i = 0 ; i < _runs.size() ; ++i )
+      {
+         if ( _runs[ i ]._eof )
+         {
+            continue ;
+         }
+         if ( -1 == minRun ||
+              _runs[ i ]._key.woCompare( _runs[ minRun ]._key, _orderBy,
+                                         FALSE ) < 0 )
+         {
+            minRun = i ;
+         }
+      }
+
+      if ( -1 == minRun )
+      {
+         rc = SDB_DMS_EOC ;
+         goto done ;
+      }
+
+      result = _runs[ minRun ]._result.getOwned() ;
+      rc = _nextOfRun( _runs[ minRun ] ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION( SDB__QGMHASHAGGR_FETCH, "_qgmHashAggr::fetch" )
+   INT32 _qgmHashAggr::fetch( BSONObj &result )
+   {
+      PD_TRACE_ENTRY( SDB__QGMHASHAGGR_FETCH ) ;
+      INT32 rc = SDB_OK ;
+
+      SDB_ASSERT( _finished, "should be finished" ) ;
+
+      if ( _spilled )
+      {
+         rc = _fetchMerged( result ) ;
+      }
+      else if ( _fetchPos < _sorted.size() )
+      {
+         rc = _result( _sorted[ _fetchPos ], result ) ;
+         ++_fetchPos ;
+      }
+      else
+      {
+         rc = SDB_DMS_EOC ;
+      }
+
+      PD_TRACE_EXITRC( SDB__QGMHASHAGGR_FETCH, rc ) ;
+      return rc ;
+   }
+}
+
@@ -0,0 +1,1180 @@
+/*******************************************************************************
+
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = qgmHashJoin.cpp
+
+   Descriptive Name = QGM Hash Join
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of QGM component. This file contains the partitioned hash
+   table used by the hash join plan, which spills the partitions to the
+   temp file when the build side doesn't fit in the memory.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#include "qgmHashJoin.hpp"
+#include "qgmUtil.hpp"
+#include "pmd.hpp"
+#include "ossUtil.hpp"
+#include "pdTrace.hpp"
+#include "qgmTrace.hpp"
+#include "rtnParallelJob.hpp"
+#include <boost/thread.hpp>
+
+using namespace bson ;
+
+namespace engine
+{
+   // the numbers of different types are equal when their values are, so
+   // they are hashed by the value of double
+   static OSS_INLINE UINT32 _qgmHashJoinEleHash( const BSONElement &e )
+   {
+      if ( e.isNumber() )
+      {
+         FLOAT64 value = e.numberDouble() ;
+         if ( 0 == value )
+         {
+            // -0 and 0
+            value = 0 ;
+         }
+         return ossHash( (const CHAR *)&value, (UINT32)sizeof( value ) ) ;
+      }
+      return ossHash( e.value(), e.valuesize() ) ^
+             (UINT32)e.canonicalType() ;
+   }
+
+   // mix the bits, so that both the buckets ( low bits ) and the
+   // partitions ( high bits ) are spread
+   static OSS_INLINE UINT32 _qgmHashJoinMix( UINT32 hash )
+   {
+      hash ^= hash >> 16 ;
+      hash *= 0x85EBCA6B ;
+      hash ^= hash >> 13 ;
+      hash *= 0xC2B2AE35 ;
+      hash ^= hash >> 16 ;
+      return hash ;
+   }
+
+   // link the entries of the partitions begin, begin + step, ... into
+   // their buckets, the partitions are linked by several EDUs
+   static void _qgmHashJoinLinkParts( qgmHashJoinPart *pParts, UINT32 begin,
+                                      UINT32 step )
+   {
+      for ( UINT32 i = begin ; i < QGM_HASH_JOIN_PART_NUM ; i += step )
+      {
+         qgmHashJoinPart &part = pParts[ i ] ;
+         UINT32 mask = part._bucketNum - 1 ;
+         UINT32 entryNum = part._entries.size() ;
+
+         if ( NULL == part._pBuckets )
+         {
+            continue ;
+         }
+         for ( UINT32 j = 0 ; j < entryNum ; ++j )
+         {
+            qgmHashJoinEntry &entry = part._entries[ j ] ;
+            UINT32 &bucket = part._pBuckets[ entry._hash & mask ] ;
+            entry._next = bucket ;
+            bucket = j + 1 ;
+         }
+      }
+   }
+
+   /*
+      _qgmHashJoinLinkTask define
+   */
+   class _qgmHashJoinLinkTask : public rtnParallelTask
+   {
+   public:
+      _qgmHashJoinLinkTask()
+      : _pParts( NULL ), _begin( 0 ), _step( 1 )
+      {
+      }
+
+      void set( qgmHashJoinPart *pParts, UINT32 begin, UINT32 step )
+      {
+         _pParts = pParts ;
+         _begin = begin ;
+         _step = step ;
+      }
+
+      virtual void run()
+      {
+         _qgmHashJoinLinkParts( _pParts, _begin, _step ) ;
+      }
+
+   private:
+      qgmHashJoinPart   *_pParts ;
+      UINT32            _begin ;
+      UINT32            _step ;
+   } ;
+
+   /*
+      _qgmHashJoinProbeTask define
+      Match the probe rows of the batch in the partitions begin,
+      begin + step, ... Each row is only written by the task of its
+      partition, so the tasks share nothing else.
+   */
+   class _qgmHashJoinProbeTask : public rtnParallelTask
+   {
+   public:
+      _qgmHashJoinProbeTask()
+      : _pParts( NULL ), _pRows( NULL ), _pProbeBuf( NULL ),
+        _pBuildKeys( NULL ), _pProbeKeys( NULL ), _begin( 0 ), _step( 1 ),
+        _rc( SDB_OK )
+      {
+      }
+
+      void set( qgmHashJoinPart *pParts,
+                std::vector<qgmHashJoinProbeRow> *pRows,
+                const CHAR *pProbeBuf,
+                const std::vector<std::string> *pBuildKeys,
+                const std::vector<std::string> *pProbeKeys,
+                UINT32 begin, UINT32 step )
+      {
+         _pParts = pParts ;
+         _pRows = pRows ;
+         _pProbeBuf = pProbeBuf ;
+         _pBuildKeys = pBuildKeys ;
+         _pProbeKeys = pProbeKeys ;
+         _begin = begin ;
+         _step = step ;
+         _rc = SDB_OK ;
+      }
+
+      OSS_INLINE INT32 getRC() const { return _rc ; }
+
+      virtual void run() ;
+
+   private:
+      BOOLEAN _isKeyEqual( const BSONObj &row ) const ;
+      void    _matchPart( qgmHashJoinPart &part ) ;
+
+   private:
+      qgmHashJoinPart                     *_pParts ;
+      std::vector<qgmHashJoinProbeRow>    *_pRows ;
+      const CHAR                          *_pProbeBuf ;
+      const std::vector<std::string>      *_pBuildKeys ;
+      const std::vector<std::string>      *_pProbeKeys ;
+      UINT32                              _begin ;
+      UINT32                              _step ;
+      INT32                               _rc ;
+      // the keys of the probe row being matched
+      std::vector<BSONElement>            _probeEles ;
+   } ;
+
+   BOOLEAN _qgmHashJoinProbeTask::_isKeyEqual( const BSONObj &row ) const
+   {
+      for ( UINT32 i = 0 ; i < _pBuildKeys->size() ; ++i )
+      {
+         BSONElement e = row.getField( (*_pBuildKeys)[ i ].c_str() ) ;
+         if ( 0 != e.woCompare( _probeEles[ i ], FALSE ) )
+         {
+            return FALSE ;
+         }
+      }
+      return TRUE ;
+   }
+
+   void _qgmHashJoinProbeTask::_matchPart( qgmHashJoinPart &part )
+   {
+      UINT32 mask = part._bucketNum - 1 ;
+
+      for ( UINT32 i = 0 ; i < part._batchRows.size() ; ++i )
+      {
+         qgmHashJoinProbeRow &probeRow = (*_pRows)[ part._batchRows[ i ] ] ;
+         BSONObj row( _pProbeBuf + probeRow._offset ) ;
+         UINT32 next = part._pBuckets[ probeRow._hash & mask ] ;
+
+         for ( UINT32 k = 0 ; k < _pProbeKeys->size() ; ++k )
+         {
+            _probeEles[ k ] = row.getField( (*_pProbeKeys)[ k ].c_str() ) ;
+         }
+
+         probeRow._matchBegin = part._batchMatches.size() ;
+         while ( 0 != next )
+         {
+            const qgmHashJoinEntry &entry = part._entries[ next - 1 ] ;
+            if ( entry._hash == probeRow._hash &&
+                 _isKeyEqual( BSONObj( part._pRowBuf + entry._offset ) ) )
+            {
+               part._batchMatches.push_back( next - 1 ) ;
+            }
+            next = entry._next ;
+         }
+         probeRow._matchEnd = part._batchMatches.size() ;
+      }
+   }
+
+   void _qgmHashJoinProbeTask::run()
+   {
+      try
+      {
+         _probeEles.resize( _pProbeKeys->size() ) ;
+         for ( UINT32 i = _begin ; i < QGM_HASH_JOIN_PART_NUM ; i += _step )
+         {
+            if ( !_pParts[ i ]._batchRows.empty() )
+            {
+               _matchPart( _pParts[ i ] ) ;
+            }
+         }
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "unexpected err happened:%s", e.what() ) ;
+         _rc = SDB_SYS ;
+      }
+   }
+
+   /*
+      _qgmHashJoin implement
+   */
+   _qgmHashJoin::_qgmHashJoin()
+   :_memLimit( 0 ),
+    _buildNum( 0 ),
+    _depth( 0 ),
+    _pProbeBuf( NULL ),
+    _probeBufSize( 0 ),
+    _probeBufUsed( 0 ),
+    _probePos( 0 ),
+    _matchPos( 0 ),
+    _pUnit( NULL ),
+    _blkBegin( 0 ),
+    _pReadBuf( NULL ),
+    _readBufSize( 0 ),
+    _probeOffset( 0 ),
+    _probeLoaded( FALSE )
+   {
+   }
+
+   _qgmHashJoin::~_qgmHashJoin()
+   {
+      clear() ;
+   }
+
+   INT32 _qgmHashJoin::init( const std::vector<std::string> &buildKeys,
+                             const std::vector<std::string> &probeKeys,
+                             UINT64 memLimit )
+   {
+      INT32 rc = SDB_OK ;
+
+      SDB_ASSERT( !buildKeys.empty() &&
+                  buildKeys.size() == probeKeys.size(), "impossible" ) ;
+
+      clear() ;
+
+      try
+      {
+         _buildKeys = buildKeys ;
+         _probeKeys = probeKeys ;
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "unexpected err happened:%s", e.what() ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+      _memLimit = memLimit ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   void _qgmHashJoin::clear()
+   {
+      _resetParts() ;
+      _clearProbeBatch() ;
+      SAFE_OSS_FREE( _pProbeBuf ) ;
+      _probeBufSize = 0 ;
+      _pendings.clear() ;
+      _probeBlks.clear() ;
+      _probeOffset = 0 ;
+      _probeLoaded = FALSE ;
+
+      SAFE_OSS_FREE( _pReadBuf ) ;
+      _readBufSize = 0 ;
+      // the temp file is removed with the unit
+      SAFE_OSS_DELETE( _pUnit ) ;
+      _blkBegin = 0 ;
+      _depth = 0 ;
+   }
+
+   void _qgmHashJoin::_resetParts()
+   {
+      for ( UINT32 i = 0 ; i < QGM_HASH_JOIN_PART_NUM ; ++i )
+      {
+         qgmHashJoinPart &part = _parts[ i ] ;
+         SAFE_OSS_FREE( part._pRowBuf ) ;
+         part._rowBufSize = 0 ;
+         part._rowBufUsed = 0 ;
+         std::vector<qgmHashJoinEntry>().swap( part._entries ) ;
+         SAFE_OSS_FREE( part._pBuckets ) ;
+         part._bucketNum = 0 ;
+         std::vector<UINT32>().swap( part._batchRows ) ;
+         std::vector<UINT32>().swap( part._batchMatches ) ;
+         part._spilled = FALSE ;
+         SAFE_OSS_FREE( part._pSpillBuf ) ;
+         part._spillBufUsed = 0 ;
+         part._buildBlks.clear() ;
+         part._probeBlks.clear() ;
+      }
+      _buildNum = 0 ;
+   }
+
+   UINT64 _qgmHashJoin::_memUsed() const
+   {
+      UINT64 used = 0 ;
+      for ( UINT32 i = 0 ; i < QGM_HASH_JOIN_PART_NUM ; ++i )
+      {
+         const qgmHashJoinPart &part = _parts[ i ] ;
+         // the buckets are allocated after the build, count them in
+         // advance
+         used += part._rowBufSize +
+                 (UINT64)part._entries.capacity() *
+                 ( sizeof( qgmHashJoinEntry ) + 2 * sizeof( UINT32 ) ) ;
+      }
+      return used ;
+   }
+
+   // FALSE is returned when one of the keys doesn't exist, the row doesn't
+   // match any row then
+   BOOLEAN _qgmHashJoin::_keyHash( const BSONObj &row,
+                                   const std::vector<std::string> &keys,
+                                   BSONElement *pEles, UINT32 &hash ) const
+   {
+      hash = 0 ;
+      for ( UINT32 i = 0 ; i < keys.size() ; ++i )
+      {
+         BSONElement e = row.getField( keys[ i ].c_str() ) ;
+         if ( e.eoo() )
+         {
+            return FALSE ;
+         }
+         if ( pEles )
+         {
+            pEles[ i ] = e ;
+         }
+         hash = hash * 31 + _qgmHashJoinEleHash( e ) ;
+      }
+      hash = _qgmHashJoinMix( hash ) ;
+      return TRUE ;
+   }
+
+   UINT32 _qgmHashJoin::_partOf( UINT32 hash ) const
+   {
+      return ( hash >> ( 32 - QGM_HASH_JOIN_PART_BITS * ( _depth + 1 ) ) ) &
+             ( QGM_HASH_JOIN_PART_NUM - 1 ) ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION( SDB__QGMHASHJOIN_PUSHBUILD, "_qgmHashJoin::pushBuild" )
+   INT32 _qgmHashJoin::pushBuild( const BSONObj &row )
+   {
+      PD_TRACE_ENTRY( SDB__QGMHASHJOIN_PUSHBUILD ) ;
+      INT32 rc = SDB_OK ;
+      UINT32 hash = 0 ;
+      UINT32 index = 0 ;
+
+      try
+      {
+         if ( !_keyHash( row, _buildKeys, NULL, hash ) )
+         {
+            goto done ;
+         }
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "unexpected err happened:%s", e.what() ) ;
+         rc = SDB_SYS ;
+         goto error ;
+      }
+
+      index = _partOf( hash ) ;
+      if ( !_parts[ index ]._spilled )
+      {
+         rc = _makeRoom( index, row.objsize() ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+      }
+
+      if ( _parts[ index ]._spilled )
+      {
+         rc = _spillRow( index, row, _parts[ index ]._buildBlks ) ;
+      }
+      else
+      {
+         rc = _addRow( _parts[ index ], row, hash ) ;
+      }
+      if ( rc )
+      {
+         goto error ;
+      }
+      ++_buildNum ;
+
+   done:
+      PD_TRACE_EXITRC( SDB__QGMHASHJOIN_PUSHBUILD, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // spill the largest partitions until the row of the partition fits,
+   // the partition itself may be spilled
+   INT32 _qgmHashJoin::_makeRoom( UINT32 index, UINT64 size )
+   {
+      INT32 rc = SDB_OK ;
+      const qgmHashJoinPart &part = _parts[ index ] ;
+      UINT64 need = sizeof( qgmHashJoinEntry ) + 2 * sizeof( UINT32 ) ;
+
+      if ( part._rowBufUsed + size > part._rowBufSize )
+      {
+         need += OSS_MAX( part._rowBufSize, size ) ;
+      }
+
+      while ( _depth < QGM_HASH_JOIN_MAX_DEPTH &&
+              _memUsed() + need > _memLimit )
+      {
+         UINT32 victim = QGM_HASH_JOIN_PART_NUM ;
+         UINT64 victimSize = 0 ;
+
+         for ( UINT32 i = 0 ; i < QGM_HASH_JOIN_PART_NUM ; ++i )
+         {
+            if ( !_parts[ i ]._spilled &&
+                 ( QGM_HASH_JOIN_PART_NUM == victim ||
+                   _parts[ i ]._rowBufSize > victimSize ) )
+            {
+               victim = i ;
+               victimSize = _parts[ i ]._rowBufSize ;
+            }
+         }
+         if ( QGM_HASH_JOIN_PART_NUM == victim )
+         {
+            break ;
+         }
+
+         rc = _spillPart( victim ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         if ( victim == index )
+         {
+            break ;
+         }
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashJoin::_addRow( qgmHashJoinPart &part, const BSONObj &row,
+                                UINT32 hash )
+   {
+      INT32 rc = SDB_OK ;
+      UINT64 size = row.objsize() ;
+      qgmHashJoinEntry entry ;
+
+      if ( part._rowBufUsed + size > part._rowBufSize )
+      {
+         UINT64 newSize = OSS_MAX( part._rowBufSize * 2,
+                                   QGM_HASH_JOIN_MIN_ROW_BUF_SIZE ) ;
+         CHAR *pTmp = NULL ;
+         while ( newSize < part._rowBufUsed + size )
+         {
+            newSize *= 2 ;
+         }
+         pTmp = ( CHAR * )SDB_OSS_REALLOC( part._pRowBuf, newSize ) ;
+         PD_CHECK( NULL != pTmp, SDB_OOM, error, PDERROR,
+                   "Failed to allocate row buffer, size: %llu", newSize ) ;
+         part._pRowBuf = pTmp ;
+         part._rowBufSize = newSize ;
+      }
+
+      entry._offset = part._rowBufUsed ;
+      entry._hash = hash ;
+      entry._next = 0 ;
+      try
+      {
+         part._entries.push_back( entry ) ;
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "unexpected err happened:%s", e.what() ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+      ossMemcpy( part._pRowBuf + part._rowBufUsed, row.objdata(), size ) ;
+      part._rowBufUsed += size ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION( SDB__QGMHASHJOIN__SPILLPART, "_qgmHashJoin::_spillPart" )
+   INT32 _qgmHashJoin::_spillPart( UINT32 index )
+   {
+      PD_TRACE_ENTRY( SDB__QGMHASHJOIN__SPILLPART ) ;
+      INT32 rc = SDB_OK ;
+      qgmHashJoinPart &part = _parts[ index ] ;
+      UINT32 entryNum = part._entries.size() ;
+      UINT64 begin = 0 ;
+
+      rc = _openUnit() ;
+      if ( rc )
+      {
+         goto error ;
+      }
+
+      PD_LOG( PDDEBUG, "Hash join spills partition[%u] of depth[%u], "
+              "rows: %u, size: %llu, memory: %llu", index, _depth,
+              part._entries.size(), part._rowBufUsed, _memUsed() ) ;
+
+      // the rows are one after another in the buffer, they are written in
+      // blocks of about the size of the spill buffer, which are read back
+      // one by one
+      for ( UINT32 i = 1 ; i <= entryNum ; ++i )
+      {
+         UINT64 end = i < entryNum ? part._entries[ i ]._offset :
+                                     part._rowBufUsed ;
+         if ( i == entryNum || end - begin >= QGM_HASH_JOIN_SPILL_BUF_SIZE )
+         {
+            rc = _writeBlk( part._pRowBuf + begin, end - begin,
+                            part._buildBlks ) ;
+            if ( rc )
+            {
+               goto error ;
+            }
+            begin = end ;
+         }
+      }
+      SAFE_OSS_FREE( part._pRowBuf ) ;
+      part._rowBufSize = 0 ;
+      part._rowBufUsed = 0 ;
+      std::vector<qgmHashJoinEntry>().swap( part._entries ) ;
+      part._spilled = TRUE ;
+
+   done:
+      PD_TRACE_EXITRC( SDB__QGMHASHJOIN__SPILLPART, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashJoin::_spillRow( UINT32 index, const BSONObj &row,
+                                  RTN_SORT_BLKS &blks )
+   {
+      INT32 rc = SDB_OK ;
+      qgmHashJoinPart &part = _parts[ index ] ;
+      UINT32 size = row.objsize() ;
+
+      if ( NULL == part._pSpillBuf )
+      {
+         part._pSpillBuf = ( CHAR * )SDB_OSS_MALLOC(
+                                     QGM_HASH_JOIN_SPILL_BUF_SIZE ) ;
+         PD_CHECK( NULL != part._pSpillBuf, SDB_OOM, error, PDERROR,
+                   "Failed to allocate spill buffer" ) ;
+         part._spillBufUsed = 0 ;
+      }
+
+      if ( part._spillBufUsed + size > QGM_HASH_JOIN_SPILL_BUF_SIZE )
+      {
+         rc = _flushSpill( index, blks ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+      }
+
+      if ( size > QGM_HASH_JOIN_SPILL_BUF_SIZE )
+      {
+         rc = _writeBlk( row.objdata(), size, blks ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+      }
+      else
+      {
+         ossMemcpy( part._pSpillBuf + part._spillBufUsed, row.objdata(),
+                    size ) ;
+         part._spillBufUsed += size ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashJoin::_flushSpill( UINT32 index, RTN_SORT_BLKS &blks )
+   {
+      INT32 rc = SDB_OK ;
+      qgmHashJoinPart &part = _parts[ index ] ;
+
+      if ( part._spillBufUsed > 0 )
+      {
+         rc = _writeBlk( part._pSpillBuf, part._spillBufUsed, blks ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         part._spillBufUsed = 0 ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashJoin::_openUnit()
+   {
+      INT32 rc = SDB_OK ;
+
+      if ( NULL != _pUnit )
+      {
+         goto done ;
+      }
+
+      _pUnit = new(std::nothrow) _dmsTmpBlkUnit() ;
+      PD_CHECK( NULL != _pUnit, SDB_OOM, error, PDERROR,
+                "Failed to allocate temp unit" ) ;
+      rc = _pUnit->openFile( pmdGetOptionCB()->getTmpPath(),
+                             qgmNewTmpFileID() ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to open temp file, rc: %d", rc ) ;
+
+   done:
+      return rc ;
+   error:
+      SAFE_OSS_DELETE( _pUnit ) ;
+      goto done ;
+   }
+
+   INT32 _qgmHashJoin::_writeBlk( const CHAR *pData, UINT64 size,
+                                  RTN_SORT_BLKS &blks )
+   {
+      INT32 rc = SDB_OK ;
+      dmsTmpBlk blk ;
+
+      // the blocks may be read between the writes
+      rc = _pUnit->seek( _blkBegin ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to seek temp file, rc: %d", rc ) ;
+      rc = _pUnit->write( pData, size, TRUE ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to write temp file, rc: %d", rc ) ;
+      rc = _pUnit->buildBlk( _blkBegin, size, blk ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to build block, rc: %d", rc ) ;
+
+      try
+      {
+         blks.push_back( blk ) ;
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "unexpected err happened:%s", e.what() ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+      _blkBegin += size ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashJoin::_readBlk( dmsTmpBlk &blk )
+   {
+      INT32 rc = SDB_OK ;
+      UINT64 got = 0 ;
+
+      if ( blk.size() > _readBufSize )
+      {
+         CHAR *pTmp = ( CHAR * )SDB_OSS_REALLOC( _pReadBuf, blk.size() ) ;
+         PD_CHECK( NULL != pTmp, SDB_OOM, error, PDERROR,
+                   "Failed to allocate read buffer, size: %llu",
+                   blk.size() ) ;
+         _pReadBuf = pTmp ;
+         _readBufSize = blk.size() ;
+      }
+
+      blk.reset() ;
+      rc = _pUnit->read( blk, blk.size(), _pReadBuf, got ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to read temp file, rc: %d", rc ) ;
+      PD_CHECK( got == blk.size(), SDB_SYS, error, PDERROR,
+                "Read %llu bytes of block[%s]", got,
+                blk.toString().c_str() ) ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION( SDB__QGMHASHJOIN_FINISHBUILD, "_qgmHashJoin::finishBuild" )
+   INT32 _qgmHashJoin::finishBuild()
+   {
+      PD_TRACE_ENTRY( SDB__QGMHASHJOIN_FINISHBUILD ) ;
+      INT32 rc = SDB_OK ;
+
+      for ( UINT32 i = 0 ; i < QGM_HASH_JOIN_PART_NUM ; ++i )
+      {
+         if ( _parts[ i ]._spilled )
+         {
+            rc = _flushSpill( i, _parts[ i ]._buildBlks ) ;
+            if ( rc )
+            {
+               goto error ;
+            }
+         }
+      }
+
+      rc = _buildTables() ;
+      if ( rc )
+      {
+         goto error ;
+      }
+
+   done:
+      PD_TRACE_EXITRC( SDB__QGMHASHJOIN_FINISHBUILD, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashJoin::_buildTables()
+   {
+      INT32 rc = SDB_OK ;
+      UINT64 rowNum = 0 ;
+      UINT32 partNum = 0 ;
+      UINT32 threadNum = 0 ;
+      _qgmHashJoinLinkTask tasks[ QGM_HASH_JOIN_MAX_THREAD ] ;
+      rtnParallelRunner runner ;
+
+      // the buckets are allocated here, so that the threads only link
+      for ( UINT32 i = 0 ; i < QGM_HASH_JOIN_PART_NUM ; ++i )
+      {
+         qgmHashJoinPart &part = _parts[ i ] ;
+         UINT32 bucketNum = 16 ;
+
+         if ( part._spilled || part._entries.empty() )
+         {
+            continue ;
+         }
+         while ( bucketNum < part._entries.size() )
+         {
+            bucketNum *= 2 ;
+         }
+         part._pBuckets = ( UINT32 * )SDB_OSS_MALLOC( sizeof( UINT32 ) *
+                                                      bucketNum ) ;
+         PD_CHECK( NULL != part._pBuckets, SDB_OOM, error, PDERROR,
+                   "Failed to allocate buckets, num: %u", bucketNum ) ;
+         ossMemset( part._pBuckets, 0, sizeof( UINT32 ) * bucketNum ) ;
+         part._bucketNum = bucketNum ;
+
+         rowNum += part._entries.size() ;
+         ++partNum ;
+      }
+
+      threadNum = boost::thread::hardware_concurrency() ;
+      threadNum = OSS_MIN( threadNum, QGM_HASH_JOIN_MAX_THREAD ) ;
+      threadNum = OSS_MIN( threadNum, partNum ) ;
+      threadNum = (UINT32)OSS_MIN( (UINT64)threadNum,
+                                   rowNum / QGM_HASH_JOIN_MIN_ROWS_PER_THREAD ) ;
+      if ( threadNum <= 1 )
+      {
+         _qgmHashJoinLinkParts( _parts, 0, 1 ) ;
+         goto done ;
+      }
+
+      // the partitions are linked by the parallel jobs in turn, the first
+      // ones by the current thread, and by the current thread as well when
+      // no job is available
+      for ( UINT32 i = 1 ; i < threadNum ; ++i )
+      {
+         tasks[ i ].set( _parts, i, threadNum ) ;
+         runner.run( &tasks[ i ] ) ;
+      }
+      _qgmHashJoinLinkParts( _parts, 0, threadNum ) ;
+      runner.wait() ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // the partitions keep the rows of the batch for the next one, so that
+   // their vectors are not allocated again
+   void _qgmHashJoin::_clearProbeBatch()
+   {
+      for ( UINT32 i = 0 ; i < QGM_HASH_JOIN_PART_NUM ; ++i )
+      {
+         _parts[ i ]._batchRows.clear() ;
+         _parts[ i ]._batchMatches.clear() ;
+      }
+      _probeRows.clear() ;
+      _probeBufUsed = 0 ;
+      _probePos = 0 ;
+      _matchPos = 0 ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION( SDB__QGMHASHJOIN_PUSHPROBE, "_qgmHashJoin::pushProbe" )
+   INT32 _qgmHashJoin::pushProbe( const BSONObj &row )
+   {
+      PD_TRACE_ENTRY( SDB__QGMHASHJOIN_PUSHPROBE ) ;
+      INT32 rc = SDB_OK ;
+      UINT32 hash = 0 ;
+      UINT32 index = 0 ;
+      UINT64 size = row.objsize() ;
+      qgmHashJoinProbeRow probeRow ;
+
+      try
+      {
+         if ( !_keyHash( row, _probeKeys, NULL, hash ) )
+         {
+            goto done ;
+         }
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "unexpected err happened:%s", e.what() ) ;
+         rc = SDB_SYS ;
+         goto error ;
+      }
+
+      index = _partOf( hash ) ;
+      if ( _parts[ index ]._spilled )
+      {
+         rc = _spillRow( index, row, _parts[ index ]._probeBlks ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         goto done ;
+      }
+      else if ( NULL == _parts[ index ]._pBuckets )
+      {
+         // no build row in the partition
+         goto done ;
+      }
+
+      if ( _probeBufUsed + size > _probeBufSize )
+      {
+         UINT64 newSize = OSS_MAX( _probeBufSize * 2,
+                                   QGM_HASH_JOIN_MIN_ROW_BUF_SIZE ) ;
+         CHAR *pTmp = NULL ;
+         while ( newSize < _probeBufUsed + size )
+         {
+            newSize *= 2 ;
+         }
+         pTmp = ( CHAR * )SDB_OSS_REALLOC( _pProbeBuf, newSize ) ;
+         PD_CHECK( NULL != pTmp, SDB_OOM, error, PDERROR,
+                   "Failed to allocate probe buffer, size: %llu", newSize ) ;
+         _pProbeBuf = pTmp ;
+         _probeBufSize = newSize ;
+      }
+
+      probeRow._offset = _probeBufUsed ;
+      probeRow._hash = hash ;
+      probeRow._part = index ;
+      probeRow._matchBegin = 0 ;
+      probeRow._matchEnd = 0 ;
+      try
+      {
+         _parts[ index ]._batchRows.push_back( _probeRows.size() ) ;
+         _probeRows.push_back( probeRow ) ;
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "unexpected err happened:%s", e.what() ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+      ossMemcpy( _pProbeBuf + _probeBufUsed, row.objdata(), size ) ;
+      _probeBufUsed += size ;
+
+   done:
+      PD_TRACE_EXITRC( SDB__QGMHASHJOIN_PUSHPROBE, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION( SDB__QGMHASHJOIN_PROBEBATCH, "_qgmHashJoin::probeBatch" )
+   INT32 _qgmHashJoin::probeBatch()
+   {
+      PD_TRACE_ENTRY( SDB__QGMHASHJOIN_PROBEBATCH ) ;
+      INT32 rc = SDB_OK ;
+      UINT32 partNum = 0 ;
+      UINT32 threadNum = 0 ;
+      _qgmHashJoinProbeTask tasks[ QGM_HASH_JOIN_MAX_THREAD ] ;
+      rtnParallelRunner runner ;
+
+      for ( UINT32 i = 0 ; i < QGM_HASH_JOIN_PART_NUM ; ++i )
+      {
+         if ( !_parts[ i ]._batchRows.empty() )
+         {
+            ++partNum ;
+         }
+      }
+
+      threadNum = boost::thread::hardware_concurrency() ;
+      threadNum = OSS_MIN( threadNum, QGM_HASH_JOIN_MAX_THREAD ) ;
+      threadNum = OSS_MIN( threadNum, partNum ) ;
+      threadNum = OSS_MIN( threadNum, (UINT32)_probeRows.size() /
+                                      QGM_HASH_JOIN_MIN_PROBES_PER_THREAD ) ;
+      threadNum = OSS_MAX( threadNum, 1 ) ;
+
+      // the same as the link of the tables, the first partitions are
+      // matched by the current thread
+      for ( UINT32 i = 0 ; i < threadNum ; ++i )
+      {
+         tasks[ i ].set( _parts, &_probeRows, _pProbeBuf, &_buildKeys,
+                         &_probeKeys, i, threadNum ) ;
+      }
+      for ( UINT32 i = 1 ; i < threadNum ; ++i )
+      {
+         runner.run( &tasks[ i ] ) ;
+      }
+      tasks[ 0 ].run() ;
+      runner.wait() ;
+
+      for ( UINT32 i = 0 ; i < threadNum ; ++i )
+      {
+         if ( SDB_OK != tasks[ i ].getRC() )
+         {
+            rc = tasks[ i ].getRC() ;
+            goto error ;
+         }
+      }
+
+      _probePos = 0 ;
+      _matchPos = _probeRows.empty() ? 0 : _probeRows[ 0 ]._matchBegin ;
+
+   done:
+      PD_TRACE_EXITRC( SDB__QGMHASHJOIN_PROBEBATCH, rc ) ;
+      return rc ;
+   error:
+      _clearProbeBatch() ;
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION( SDB__QGMHASHJOIN_NEXTMATCH, "_qgmHashJoin::nextMatch" )
+   INT32 _qgmHashJoin::nextMatch( BSONObj &probeRow, BSONObj &buildRow )
+   {
+      PD_TRACE_ENTRY( SDB__QGMHASHJOIN_NEXTMATCH ) ;
+      INT32 rc = SDB_OK ;
+
+      while ( _probePos < _probeRows.size() )
+      {
+         const qgmHashJoinProbeRow &row = _probeRows[ _probePos ] ;
+         if ( _matchPos < row._matchEnd )
+         {
+            const qgmHashJoinPart &part = _parts[ row._part ] ;
+            const qgmHashJoinEntry &entry =
+               part._entries[ part._batchMatches[ _matchPos ] ] ;
+            probeRow = BSONObj( _pProbeBuf + row._offset ) ;
+            buildRow = BSONObj( part._pRowBuf + entry._offset ) ;
+            ++_matchPos ;
+            goto done ;
+         }
+
+         ++_probePos ;
+         if ( _probePos < _probeRows.size() )
+         {
+            _matchPos = _probeRows[ _probePos ]._matchBegin ;
+         }
+      }
+
+      // the rows got last are still in the buffer till the next push
+      _clearProbeBatch() ;
+      rc = SDB_DMS_EOC ;
+
+   done:
+      PD_TRACE_EXITRC( SDB__QGMHASHJOIN_NEXTMATCH, rc ) ;
+      return rc ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION( SDB__QGMHASHJOIN_FINISHPROBE, "_qgmHashJoin::finishProbe" )
+   INT32 _qgmHashJoin::finishProbe()
+   {
+      PD_TRACE_ENTRY( SDB__QGMHASHJOIN_FINISHPROBE ) ;
+      INT32 rc = SDB_OK ;
+
+      for ( UINT32 i = 0 ; i < QGM_HASH_JOIN_PART_NUM ; ++i )
+      {
+         qgmHashJoinPart &part = _parts[ i ] ;
+         if ( !part._spilled )
+         {
+            continue ;
+         }
+         rc = _flushSpill( i, part._probeBlks ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         // it is an inner join, nothing matches without the probe rows
+         if ( part._probeBlks.empty() )
+         {
+            continue ;
+         }
+         try
+         {
+            qgmHashJoinPending pending ;
+            pending._buildBlks = part._buildBlks ;
+            pending._probeBlks = part._probeBlks ;
+            pending._depth = _depth + 1 ;
+            _pendings.push_back( pending ) ;
+         }
+         catch ( std::exception &e )
+         {
+            PD_LOG( PDERROR, "unexpected err happened:%s", e.what() ) ;
+            rc = SDB_OOM ;
+            goto error ;
+         }
+      }
+
+   done:
+      PD_TRACE_EXITRC( SDB__QGMHASHJOIN_FINISHPROBE, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION( SDB__QGMHASHJOIN_NEXTPASS, "_qgmHashJoin::nextPass" )
+   INT32 _qgmHashJoin::nextPass()
+   {
+      PD_TRACE_ENTRY( SDB__QGMHASHJOIN_NEXTPASS ) ;
+      INT32 rc = SDB_OK ;
+      qgmHashJoinPending pending ;
+      RTN_SORT_BLKS::iterator itr ;
+
+      _resetParts() ;
+      _clearProbeBatch() ;
+      _probeBlks.clear() ;
+      _probeOffset = 0 ;
+      _probeLoaded = FALSE ;
+
+      if ( _pendings.empty() )
+      {
+         rc = SDB_DMS_EOC ;
+         goto error ;
+      }
+      pending = _pendings.front() ;
+      _pendings.pop_front() ;
+
+      _depth = pending._depth ;
+      if ( _depth >= QGM_HASH_JOIN_MAX_DEPTH )
+      {
+         PD_LOG( PDWARNING, "Hash join partition can't be split any more, "
+                 "the memory limit is ignored" ) ;
+      }
+
+      for ( itr = pending._buildBlks.begin() ;
+            itr != pending._buildBlks.end() ;
+            ++itr )
+      {
+         UINT64 offset = 0 ;
+         rc = _readBlk( *itr ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         while ( offset < itr->size() )
+         {
+            BSONObj row( _pReadBuf + offset ) ;
+            offset += row.objsize() ;
+            rc = pushBuild( row ) ;
+            if ( rc )
+            {
+               goto error ;
+            }
+         }
+      }
+
+      rc = finishBuild() ;
+      if ( rc )
+      {
+         goto error ;
+      }
+      _probeBlks = pending._probeBlks ;
+
+   done:
+      PD_TRACE_EXITRC( SDB__QGMHASHJOIN_NEXTPASS, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _qgmHashJoin::nextProbe( BSONObj &row )
+   {
+      INT32 rc = SDB_OK ;
+
+      while ( TRUE )
+      {
+         if ( _probeLoaded && _probeOffset < _probeBlks.front().size() )
+         {
+            // the row is kept in the read buffer until the next block
+            row = BSONObj( _pReadBuf + _probeOffset ) ;
+            _probeOffset += row.objsize() ;
+            break ;
+         }
+         else if ( _probeLoaded )
+         {
+            _probeBlks.pop_front() ;
+            _probeLoaded = FALSE ;
+         }
+
+         if ( _probeBlks.empty() )
+         {
+            rc = SDB_DMS_EOC ;
+            goto error ;
+         }
+         rc = _readBlk( _probeBlks.front() ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         _probeOffset = 0 ;
+         _probeLoaded = TRUE ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+}
+
@@ -48,6 +48,29 @@
 
 namespace engine
 {
+   static BOOLEAN _qgmGetEquiConds( qgmConditionNode *cond,
+                                    qgmConditionNodePtrVec &conds )
+   {
+      if ( NULL == cond )
+      {
+         return FALSE ;
+      }
+      else if ( SQL_GRAMMAR::AND == cond->type )
+      {
+         return _qgmGetEquiConds( cond->left, conds ) &&
+                _qgmGetEquiConds( cond->right, conds ) ;
+      }
+      else if ( SQL_GRAMMAR::EG == cond->type &&
+                NULL != cond->left && NULL != cond->right &&
+                SQL_GRAMMAR::DBATTR == cond->left->type &&
+                SQL_GRAMMAR::DBATTR == cond->right->type )
+      {
+         conds.push_back( cond ) ;
+         return TRUE ;
+      }
+      return FALSE ;
+   }
+
    _qgmOptiNLJoin::_qgmOptiNLJoin( INT32 type, _qgmPtrTable *table,
                                    _qgmParamTable *param )
    :_qgmOptiTreeNode( QGM_OPTI_TYPE_JOIN, table, param ),
@@ -166,6 +189,12 @@ namespace engine
       goto done ;
    }
 
+   BOOLEAN _qgmOptiNLJoin::getEquiConds( qgmConditionNodePtrVec &conds ) const
+   {
+      conds.clear() ;
+      return _qgmGetEquiConds( _condition, conds ) ;
+   }
+
    BOOLEAN _qgmOptiNLJoin::canSwapInnerOuter() const
    {
       if ( SQL_GRAMMAR::INNERJOIN != _joinType ||
@@ -321,13 +350,17 @@ namespace engine
       }
       else
       {
-         SDB_ASSERT( NULL != _condition &&
-                     NULL != _condition->left &&
-                     NULL != _condition->right, "can not be NULL") ;
-         SDB_ASSERT( SQL_GRAMMAR::DBATTR == _condition->left->type &&
-                     SQL_GRAMMAR::DBATTR == _condition->right->type,
-                     "impossible" ) ;
+         qgmConditionNodePtrVec conds ;
+         BOOLEAN isEqui = getEquiConds( conds ) ;
+         SDB_ASSERT( isEqui, "impossible" ) ;
+         if ( !isEqui )
+         {
+            rc = SDB_SYS ;
+            goto error ;
+         }
 
+         // the keys of the equations in order, the left ones are of the
+         // inner after the condition is made
          joinUnit = SDB_OSS_NEW qgmOprUnit( QGM_OPTI_TYPE_JOIN ) ;
          if ( !joinUnit )
          {
@@ -335,9 +368,12 @@ namespace engine
             goto error ;
          }
          joinUnit->setDispatchAlias( outer()->getAlias(TRUE) ) ;
-         joinUnit->addOpField( qgmOpField(_condition->right->value,
-                                          SQL_GRAMMAR::DBATTR),
-                               FALSE) ;
+         for ( UINT32 i = 0 ; i < conds.size() ; ++i )
+         {
+            joinUnit->addOpField( qgmOpField(conds[ i ]->right->value,
+                                             SQL_GRAMMAR::DBATTR),
+                                  FALSE) ;
+         }
          _oprUnits.push_back( joinUnit ) ;
          joinUnit = NULL ;
 
@@ -348,9 +384,12 @@ namespace engine
             goto error ;
          }
          joinUnit->setDispatchAlias( inner()->getAlias(TRUE) ) ;
-         joinUnit->addOpField( qgmOpField(_condition->left->value,
-                                          SQL_GRAMMAR::DBATTR),
-                               FALSE) ;
+         for ( UINT32 i = 0 ; i < conds.size() ; ++i )
+         {
+            joinUnit->addOpField( qgmOpField(conds[ i ]->left->value,
+                                             SQL_GRAMMAR::DBATTR),
+                                  FALSE) ;
+         }
          _oprUnits.push_back( joinUnit ) ;
          joinUnit = NULL ;
       }
@@ -708,14 +747,28 @@ namespace engine
       else
       {
          qgmOPFieldVec *fields = oprUnit->getFields() ;
-         SDB_ASSERT( 1 == fields->size(), "size must be one") ;
-         if ( oprUnit->getDispatchAlias() == inner()->getAlias() )
+         qgmConditionNodePtrVec conds ;
+         getEquiConds( conds ) ;
+         if ( fields->size() != conds.size() )
          {
-            _condition->left->value = fields->at( 0 ).value ;
+            PD_LOG( PDERROR, "Node[%s] joinUnit[%s] field num is not with the"
+                    "condition", toString().c_str(),
+                    oprUnit->toString().c_str() ) ;
+            SDB_ASSERT( FALSE , "JoinUnit field num is not with condition" ) ;
+            rc = SDB_SYS ;
+            goto error ;
          }
-         else
+
+         for ( UINT32 i = 0 ; i < conds.size() ; ++i )
          {
-            _condition->right->value = fields->at( 0 ).value ;
+            if ( oprUnit->getDispatchAlias() == inner()->getAlias() )
+            {
+               conds[ i ]->left->value = fields->at( i ).value ;
+            }
+            else
+            {
+               conds[ i ]->right->value = fields->at( i ).value ;
+            }
          }
       }
 
@@ -743,17 +796,12 @@ namespace engine
                                QGM_HINT_HASHJOIN,
                                itr->value.size() ))
          {
-            if ( NULL != _condition &&
-                 SQL_GRAMMAR::EG == _condition->type )
+            // the condition is made up of the equations of the fields
+            qgmConditionNodePtrVec conds ;
+            if ( getEquiConds( conds ) )
             {
-               SDB_ASSERT( NULL != _condition->left &&
-                           NULL != _condition->right, "impossible") ;
-               if ( SQL_GRAMMAR::DBATTR == _condition->left->type &&
-                    SQL_GRAMMAR::DBATTR == _condition->right->type )
-               {
-                  qgmHint hint = *itr ;
-                  _hints.push_back( hint ) ;
-               }
+               qgmHint hint = *itr ;
+               _hints.push_back( hint ) ;
             }
          }
       }
@@ -40,6 +40,7 @@
 #include "pmdCB.hpp"
 #include "qgmUtil.hpp"
 #include "rtnSQLFuncFactory.hpp"
+#include "rtnCB.hpp"
 #include <sstream>
 
 using namespace bson ;
@@ -53,7 +54,8 @@ namespace engine
                                          _qgmPtrTable *table )
    :_qgmPlan( QGM_PLAN_TYPE_AGGR, alias ),
     _eoc( FALSE ), _pushedAtThisTime( FALSE ),
-    _pushedAtAnyTime( FALSE ), _isAggr( FALSE ), _isStat( FALSE )
+    _pushedAtAnyTime( FALSE ), _isAggr( FALSE ), _isStat( FALSE ),
+    _hashAggr( NULL ), _hashBuilt( FALSE )
    {
       INT32 rc = SDB_OK ;
       SQL_CB *sqlCB = pmdGetKRCB()->getSqlCB() ;
@@ -151,6 +153,43 @@ namespace engine
          SAFE_OSS_DELETE( *itr ) ;
       }
       _func.clear() ;
+      SAFE_OSS_DELETE( _hashAggr ) ;
+   }
+
+   BOOLEAN _qgmPlAggregation::enableHashAggr( const BSONObj &orderBy )
+   {
+      INT32 rc = SDB_OK ;
+      UINT64 memLimit = 0 ;
+
+      if ( NULL != _hashAggr )
+      {
+         return TRUE ;
+      }
+      else if ( _groupby.empty() || !_qgmHashAggr::isSupported( _func ) ||
+                orderBy.nFields() > QGM_HASH_AGGR_MAX_KEY_NUM )
+      {
+         return FALSE ;
+      }
+
+      _hashAggr = SDB_OSS_NEW _qgmHashAggr() ;
+      if ( NULL == _hashAggr )
+      {
+         PD_LOG( PDWARNING, "failed to allocate mem, use sort instead" ) ;
+         return FALSE ;
+      }
+
+      // the groups are held in the memory of a sort
+      memLimit = (UINT64)sdbGetRTNCB()->getAPM()->getSortBufferSize() << 20 ;
+      rc = _hashAggr->init( _func, &_groupby, orderBy, memLimit ) ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG( PDWARNING, "failed to init hash aggregation, use sort "
+                 "instead, rc: %d", rc ) ;
+         SAFE_OSS_DELETE( _hashAggr ) ;
+         return FALSE ;
+      }
+
+      return TRUE ;
    }
 
    string _qgmPlAggregation::toString() const
@@ -176,6 +215,11 @@ namespace engine
          ss << "Groupby:" << _groupby.selector().toString() << '\n';
       }
 
+      if ( NULL != _hashAggr )
+      {
+         ss << "Method:Hash" << '\n' ;
+      }
+
       return ss.str() ;
    }
 
@@ -187,6 +231,11 @@ namespace engine
       _pushedAtAnyTime = FALSE ; 
       _eoc = FALSE ;
       _groupbyKey = BSONObj() ;
+      _hashBuilt = FALSE ;
+      if ( NULL != _hashAggr )
+      {
+         _hashAggr->clear() ;
+      }
 
       SDB_ASSERT( 1 == _input.size(), "impossible" ) ;
       rc = input( 0 )->execute( eduCB ) ;
@@ -211,6 +260,11 @@ namespace engine
          rc = SDB_DMS_EOC ;
          goto error ;
       }
+      else if ( NULL != _hashAggr )
+      {
+         rc = _fetchNextHash( next ) ;
+         goto done ;
+      }
 
       do
       {
@@ -330,6 +384,82 @@ namespace engine
       goto done ;
    }
 
+   INT32 _qgmPlAggregation::_fetchNextHash( qgmFetchOut &next )
+   {
+      INT32 rc = SDB_OK ;
+      qgmFetchOut subFetch ;
+      BSONObj currentGroupBy ;
+
+      if ( !_hashBuilt )
+      {
+         while ( TRUE )
+         {
+            rc = input( 0 )->fetchNext( subFetch ) ;
+            if ( SDB_DMS_EOC == rc )
+            {
+               break ;
+            }
+            else if ( SDB_OK != rc )
+            {
+               PD_LOG( PDERROR, "failed to fatch next:%d", rc ) ;
+               goto error ;
+            }
+
+            rc = _groupby.select( subFetch, currentGroupBy ) ;
+            if ( SDB_OK != rc )
+            {
+               goto error ;
+            }
+
+            rc = _hashAggr->push( subFetch, currentGroupBy ) ;
+            if ( SDB_OK != rc )
+            {
+               PD_LOG( PDERROR, "failed to push record to hash "
+                       "aggregation:%d", rc ) ;
+               goto error ;
+            }
+         }
+
+         rc = _hashAggr->finish() ;
+         if ( SDB_OK != rc )
+         {
+            PD_LOG( PDERROR, "failed to finish hash aggregation:%d", rc ) ;
+            goto error ;
+         }
+         _hashBuilt = TRUE ;
+
+         if ( 0 == _hashAggr->recordNum() && _isStat )
+         {
+            // the same as the sort-based one, which returns the
+            // statistics of no record
+            _eoc = TRUE ;
+            rc = _result( next ) ;
+            goto done ;
+         }
+      }
+
+      rc = _hashAggr->fetch( next.obj ) ;
+      if ( SDB_DMS_EOC == rc )
+      {
+         _eoc = TRUE ;
+         goto error ;
+      }
+      else if ( SDB_OK != rc )
+      {
+         goto error ;
+      }
+
+      if ( !_merge && !_alias.empty() )
+      {
+         next.alias = _alias ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
    INT32 _qgmPlAggregation::_select( const qgmFetchOut &next,
                                      const vector<qgmOpField> &fields,
                                      RTN_FUNC_PARAMS &param )
@@ -50,9 +50,9 @@ namespace engine
     _probe( NULL ),
     _buildAlias( NULL ),
     _probeAlias( NULL ),
-    _hashContext( QGM_HT_INVALID_CONTEXT ),
     _state( QGM_HJ_FETCH_STATE_BUILD ),
-    _hitBuildEnd(FALSE)
+    _probeFromPlan( TRUE ),
+    _passDone( FALSE )
    {
       SDB_ASSERT( SQL_GRAMMAR::INNERJOIN == _joinType, "impossible" ) ;
       _type = QGM_PLAN_TYPE_HASHJOIN ;
@@ -60,7 +60,6 @@ namespace engine
 
    _qgmPlHashJoin::~_qgmPlHashJoin()
    {
-
    }
 
    PD_TRACE_DECLARE_FUNCTION( SDB__QGMPLHASHJOIN_INIT, "_qgmPlHashJoin::init" )
@@ -70,46 +69,54 @@ namespace engine
       PD_TRACE_ENTRY( SDB__QGMPLHASHJOIN_INIT ) ;
       SDB_ASSERT( NULL != opti, "impossible" ) ;
       SDB_ASSERT( NULL != opti->_condition, "impossible" ) ;
-      SDB_ASSERT( NULL != opti->_condition->left, "impossible" ) ;
-      SDB_ASSERT( NULL != opti->_condition->right, "impossible" ) ;
-      SDB_ASSERT( SQL_GRAMMAR::EG == opti->_condition->type, "impossible" ) ;
-      SDB_ASSERT( SQL_GRAMMAR::DBATTR == opti->_condition->left->type, "impossible" ) ;
-      SDB_ASSERT( SQL_GRAMMAR::DBATTR == opti->_condition->right->type, "impossible" ) ;
-
-      _qgmConditionNode *left = opti->_condition->left ;
-      _qgmConditionNode *right = opti->_condition->right ;
+      qgmConditionNodePtrVec conds ;
 
       _outerAlias = &(input( 0 )->alias()) ;
       _innerAlias = &(input( 1 )->alias()) ;
       _inner = input( 1 ) ;
       _outer = input( 0 ) ;
+      _buildKeys.clear() ;
+      _probeKeys.clear() ;
 
-      if ( left->value.relegation() == *_outerAlias &&
-           right->value.relegation() == *_innerAlias )
-      {
-         _buildKey = right->value.attr().toString() ;
-         _probeKey = left->value.attr().toString() ;
-      }
-      else if ( left->value.relegation() == *_innerAlias &&
-                right->value.relegation() == *_outerAlias )
+      if ( !opti->getEquiConds( conds ) )
       {
-         _buildKey = left->value.attr().toString() ;
-         _probeKey = right->value.attr().toString() ;
-      }
-      else
-      {
-         PD_LOG( PDERROR, "left key or right key is not found, "
-                 "left:%s, right:%s", left->value.toString().c_str(),
-                 right->value.toString().c_str() ) ;
+         PD_LOG( PDERROR, "condition of hash join is not the equations of "
+                 "fields" ) ;
          rc = SDB_INVALIDARG ;
          goto error ;
       }
 
+      for ( UINT32 i = 0 ; i < conds.size() ; ++i )
+      {
+         _qgmConditionNode *left = conds[ i ]->left ;
+         _qgmConditionNode *right = conds[ i ]->right ;
+
+         if ( left->value.relegation() == *_outerAlias &&
+              right->value.relegation() == *_innerAlias )
+         {
+            _buildKeys.push_back( right->value.attr().toString() ) ;
+            _probeKeys.push_back( left->value.attr().toString() ) ;
+         }
+         else if ( left->value.relegation() == *_innerAlias &&
+                   right->value.relegation() == *_outerAlias )
+         {
+            _buildKeys.push_back( left->value.attr().toString() ) ;
+            _probeKeys.push_back( right->value.attr().toString() ) ;
+         }
+         else
+         {
+            PD_LOG( PDERROR, "left key or right key is not found, "
+                    "left:%s, right:%s", left->value.toString().c_str(),
+                    right->value.toString().c_str() ) ;
+            rc = SDB_INVALIDARG ;
+            goto error ;
+         }
+      }
+
       _build = _inner ;
       _probe = _outer ;
       _buildAlias = _innerAlias ;
       _probeAlias = _outerAlias ;
-
       _initialized = TRUE ;
    done:
       PD_TRACE_EXITRC( SDB__QGMPLHASHJOIN_INIT, rc ) ;
@@ -121,11 +128,28 @@ namespace engine
    string _qgmPlHashJoin::toString()const
    {
       stringstream ss ;
-      ss << "Build Key: " << _buildKey << "\n" ;
-      ss << "Probe Key: " << _probeKey << "\n" ;
+      ss << "Build Key: " ;
+      for ( UINT32 i = 0 ; i < _buildKeys.size() ; ++i )
+      {
+         ss << ( 0 == i ? "" : ", " ) << _buildKeys[ i ] ;
+      }
+      ss << "\n" ;
+      ss << "Probe Key: " ;
+      for ( UINT32 i = 0 ; i < _probeKeys.size() ; ++i )
+      {
+         ss << ( 0 == i ? "" : ", " ) << _probeKeys[ i ] ;
+      }
+      ss << "\n" ;
       return ss.str() ;
    }
 
+   void _qgmPlHashJoin::close()
+   {
+      // remove the temp file
+      _hashJoin.clear() ;
+      _qgmPlan::close() ;
+   }
+
    PD_TRACE_DECLARE_FUNCTION( SDB__QGMPLHASHJOIN__EXEC, "_qgmPlHashJoin::_execute" )
    INT32 _qgmPlHashJoin::_execute( _pmdEDUCB *eduCB )
    {
@@ -133,12 +157,11 @@ namespace engine
       PD_TRACE_ENTRY( SDB__QGMPLHASHJOIN__EXEC ) ;
       SDB_ASSERT( NULL != _build && NULL != _probe, "can not be NULL" ) ;
 
-      _hashTbl.release() ;
-
-      _hitBuildEnd = FALSE ;
-
+      _state = QGM_HJ_FETCH_STATE_BUILD ;
+      _probeFromPlan = TRUE ;
+      _passDone = FALSE ;
       UINT64 bufSize = ( ( UINT64 )pmdGetOptionCB()->getHjBufSize() ) * 1024 * 1024 ;
-      rc = _hashTbl.init( bufSize ) ;
+      rc = _hashJoin.init( _buildKeys, _probeKeys, bufSize ) ;
       if ( SDB_OK != rc )
       {
          PD_LOG( PDERROR, "failed to init hash table:%d", rc ) ;
@@ -187,42 +210,34 @@ namespace engine
                PD_LOG( PDERROR, "failed to exec probe:%d", rc ) ;
                goto error ;
             }
-
             _state = QGM_HJ_FETCH_STATE_PROBE ;
          }
          else if ( QGM_HJ_FETCH_STATE_PROBE == _state )
          {
-            rc = _probe->fetchNext( _probeF ) ;
-            if ( SDB_DMS_EOC == rc )
-            {
-               _state = QGM_HJ_FETCH_STATE_BUILD ;
-            }
-            else if ( SDB_OK != rc )
+            rc = _fillProbeBatch() ;
+            if ( SDB_OK != rc )
             {
-               PD_LOG( PDERROR, "failed to fetch from probe:%d" ,rc ) ;
+               if ( SDB_DMS_EOC == rc )
+               {
+                  PD_LOG( PDEVENT, "hash join done." ) ;
+               }
                goto error ;
             }
-            else
+
+            rc = _hashJoin.probeBatch() ;
+            if ( SDB_OK != rc )
             {
-               SDB_ASSERT( NULL == _probeF.next, "impossible" ) ;
-               _probeEle = _probeF.obj.getField( _probeKey.c_str() ) ;
-               rc = _hashTbl.find( _probeEle, _hashContext ) ;
-               if ( SDB_OK != rc )
-               {
-                  PD_LOG( PDERROR, "failed to find from hash tbl:%d", rc ) ;
-                  goto error ;
-               }
-               _state = QGM_HJ_FETCH_STATE_FIND ;
+               PD_LOG( PDERROR, "failed to find from hash tbl:%d", rc ) ;
+               goto error ;
             }
+            _state = QGM_HJ_FETCH_STATE_FIND ;
          }
          else
          {
-            SDB_ASSERT( !_probeF.obj.isEmpty(), "impossible" ) ;
             BSONObj obj ;
-            rc = _hashTbl.getMore( _probeEle, _hashContext, obj ) ;
+            rc = _hashJoin.nextMatch( _probeF.obj, obj ) ;
             if ( SDB_DMS_EOC == rc )
             {
-               SDB_ASSERT( QGM_HT_INVALID_CONTEXT == _hashContext, "impossible" ) ;
                _state = QGM_HJ_FETCH_STATE_PROBE ;
             }
             else if ( SDB_OK != rc )
@@ -237,6 +252,7 @@ namespace engine
                {
                   next.alias = *_buildAlias ;
                }
+               _probeF.next = NULL ;
                if ( NULL != _probeAlias )
                {
                   _probeF.alias = *_probeAlias ;
@@ -246,6 +262,7 @@ namespace engine
             }
          }
       } while (TRUE) ;
+
    done:
       PD_TRACE_EXITRC( SDB__QGMPLHASHJOIN__FETCHNEXT, rc ) ;
       return rc ;
@@ -258,72 +275,129 @@ namespace engine
    {
       INT32 rc = SDB_OK ;
       PD_TRACE_ENTRY( SDB__QGMPLHASHJOIN__BUILDHASNTBL ) ;
-      _hashTbl.clear() ;
-      UINT64 builded = 0 ;
+
+      // all the build rows are pushed, the partitions which don't fit are
+      // spilled, so that the probe plan is executed only once
       while ( TRUE )
       {
-         if ( _buildF.obj.isEmpty() )
+         rc = _build->fetchNext( _buildF ) ;
+         if ( SDB_DMS_EOC == rc )
          {
-            if ( _hitBuildEnd )
-            {
-               rc = SDB_DMS_EOC ;
-               break ;
-            }
+            rc = SDB_OK ;
+            break ;
+         }
+         else if ( SDB_OK != rc )
+         {
+            PD_LOG( PDERROR, "failed to fetch from build:%d", rc ) ;
+            goto error ;
+         }
 
-            rc = _build->fetchNext( _buildF ) ;
-            if ( SDB_DMS_EOC == rc )
+         SDB_ASSERT( NULL == _buildF.next, "impossible" ) ;
+         rc = _hashJoin.pushBuild( _buildF.obj ) ;
+         if ( SDB_OK != rc )
+         {
+            PD_LOG( PDERROR, "failed to push obj to hashtbl:%d", rc ) ;
+            goto error ;
+         }
+      }
+      _buildF.obj = BSONObj() ;
+
+      if ( 0 == _hashJoin.buildNum() )
+      {
+         rc = SDB_DMS_EOC ;
+         goto error ;
+      }
+
+      rc = _hashJoin.finishBuild() ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG( PDERROR, "failed to build hash tbl:%d", rc ) ;
+         goto error ;
+      }
+      PD_LOG( PDDEBUG, "%llu records were pushed into hash table, "
+              "spilled: %s", _hashJoin.buildNum(),
+              _hashJoin.isSpilled() ? "TRUE" : "FALSE" ) ;
+
+   done:
+      PD_TRACE_EXITRC( SDB__QGMPLHASHJOIN__BUILDHASNTBL, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   PD_TRACE_DECLARE_FUNCTION( SDB__QGMPLHASHJOIN__FILLPROBEBATCH, "_qgmPlHashJoin::_fillProbeBatch")
+   INT32 _qgmPlHashJoin::_fillProbeBatch()
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB__QGMPLHASHJOIN__FILLPROBEBATCH ) ;
+
+      while ( !_hashJoin.isProbeBatchFull() )
+      {
+         if ( _passDone )
+         {
+            // the rows of the pass in the batch are matched first
+            if ( !_hashJoin.isProbeBatchEmpty() )
             {
-               _hitBuildEnd = TRUE ;
                break ;
             }
-            else if ( SDB_OK != rc )
+
+            // the pass is done, join the next spilled partition
+            rc = _hashJoin.finishProbe() ;
+            if ( SDB_OK != rc )
             {
-               PD_LOG( PDERROR, "failed to fetch from build:%d", rc ) ;
+               PD_LOG( PDERROR, "failed to finish probe:%d", rc ) ;
                goto error ;
             }
-            else
+            rc = _hashJoin.nextPass() ;
+            if ( SDB_OK != rc )
             {
+               if ( SDB_DMS_EOC != rc )
+               {
+                  PD_LOG( PDERROR, "failed to load spilled partition:%d",
+                          rc ) ;
+               }
+               goto error ;
             }
+            _probeFromPlan = FALSE ;
+            _passDone = FALSE ;
+            PD_LOG( PDDEBUG, "hash join loaded spilled partition of depth "
+                    "%u, %llu records", _hashJoin.depth(),
+                    _hashJoin.buildNum() ) ;
          }
 
-         SDB_ASSERT( NULL == _buildF.next, "impossible" ) ;
-         rc = _hashTbl.push( _buildKey.c_str(), _buildF.obj ) ;
-         if ( SDB_HIT_HIGH_WATERMARK == rc )
+         if ( _probeFromPlan )
          {
-            rc = SDB_OK ;
-            goto done ;
-         }
-         else if ( SDB_OK != rc )
-         {
-            PD_LOG( PDERROR, "failed to push obj to hashtbl:%d", rc ) ;
-            goto error ;
+            rc = _probe->fetchNext( _probeF ) ;
+            SDB_ASSERT( SDB_OK != rc || NULL == _probeF.next, "impossible" ) ;
          }
          else
          {
-            ++builded ;
-            _buildF.obj = BSONObj() ;
+            _probeF.next = NULL ;
+            rc = _hashJoin.nextProbe( _probeF.obj ) ;
          }
-      }
 
-      if ( SDB_DMS_EOC == rc )
-      {
-         if ( 0 != builded )
+         if ( SDB_DMS_EOC == rc )
          {
+            _passDone = TRUE ;
             rc = SDB_OK ;
+            continue ;
          }
-         else
+         else if ( SDB_OK != rc )
          {
+            PD_LOG( PDERROR, "failed to fetch from probe:%d" ,rc ) ;
+            goto error ;
+         }
+
+         rc = _hashJoin.pushProbe( _probeF.obj ) ;
+         if ( SDB_OK != rc )
+         {
+            PD_LOG( PDERROR, "failed to push obj to probe batch:%d", rc ) ;
             goto error ;
          }
-      }
-      else if ( SDB_OK != rc )
-      {
-         goto error ;
       }
 
-      PD_LOG( PDDEBUG, "%lld records were pushed into hash table", builded ) ;
    done:
-      PD_TRACE_EXITRC( SDB__QGMPLHASHJOIN__BUILDHASNTBL, rc ) ;
+      PD_TRACE_EXITRC( SDB__QGMPLHASHJOIN__FILLPROBEBATCH, rc ) ;
       return rc ;
    error:
       goto done ;
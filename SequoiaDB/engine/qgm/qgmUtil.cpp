@@ -39,6 +39,7 @@
 #include "qgmConditionNode.hpp"
 #include "pd.hpp"
 #include "ossUtil.hpp"
+#include "ossAtomic.hpp"
 #include "pdTrace.hpp"
 #include "qgmTrace.hpp"
 #include "msg.h"
@@ -1301,5 +1302,11 @@ namespace engine
       return FALSE ;
    }
 
+   INT64 qgmNewTmpFileID()
+   {
+      static ossAtomic64 s_tmpFileID( 0 ) ;
+      return -( (INT64)s_tmpFileID.inc() ) - 1 ;
+   }
+
 }
 
@@ -72,6 +72,7 @@ namespace engine
       PD_TRACE_ENTRY ( SDB_RTNBACKUP ) ;
       string bkpath ;
       INT32 maxDataFileSize = 0 ;
+      INT32 streamNum = 0 ;
 
       barBKOfflineLogger logger ;
 
@@ -125,6 +126,14 @@ namespace engine
       PD_RC_CHECK( rc, PDWARNING, "Failed to get field[%s], rc: %d",
                    FIELD_NAME_BACKUP_LOG, rc ) ;
 
+      rc = rtnGetIntElement( option, FIELD_NAME_STREAM_NUM, streamNum ) ;
+      if ( SDB_FIELD_NOT_EXIST == rc )
+      {
+         rc = SDB_OK ;
+      }
+      PD_RC_CHECK( rc, PDWARNING, "Failed to get field[%s], rc: %d",
+                   FIELD_NAME_STREAM_NUM, rc ) ;
+
       rc = rtnGetBooleanElement( option, FIELD_NAME_COMPRESSED, compressed ) ;
       if ( SDB_FIELD_NOT_EXIST == rc )
       {
@@ -183,6 +192,8 @@ namespace engine
       PD_RC_CHECK( rc, PDERROR, "Init off line backup logger failed, rc: %d",
                    rc ) ;
       logger.setBackupLog( backupLog ) ;
+      // the default stream num is used when it's not positive
+      logger.setStreamNum( streamNum > 0 ? (UINT32)streamNum : 0 ) ;
       logger.enableCompress( compressed, compType ) ;
 
       rc = logger.backup( cb ) ;
@@ -527,6 +527,7 @@ namespace engine
       BOOLEAN enSureIndex = TRUE ;
       BOOLEAN isCompressed = FALSE ;
       BOOLEAN strictDataMode = FALSE ;
+      BOOLEAN blockCompressed = FALSE ;
       BOOLEAN autoIndexId = TRUE ;
       BOOLEAN capped = FALSE ;
       const CHAR *compressionType = NULL ;
@@ -577,6 +578,13 @@ namespace engine
          _attributes |= DMS_MB_ATTR_STRICTDATAMODE ;
       }
 
+      rtnGetBooleanElement ( matcher, FIELD_NAME_BLOCKCOMPRESSED,
+                             blockCompressed ) ;
+      if ( blockCompressed )
+      {
+         _attributes |= DMS_MB_ATTR_BLOCKCOMPRESSED ;
+      }
+
       rc = rtnGetStringElement( matcher, FIELD_NAME_COMPRESSIONTYPE,
                                 &compressionType ) ;
       if ( SDB_FIELD_NOT_EXIST == rc )
@@ -653,6 +661,8 @@ namespace engine
          }
 
          _attributes |= DMS_MB_ATTR_CAPPED ;
+         // the extents of capped collection are recycled, never sealed
+         OSS_BIT_CLEAR( _attributes, DMS_MB_ATTR_BLOCKCOMPRESSED ) ;
          rc = rtnGetNumberLongElement( matcher, FIELD_NAME_SIZE, maxSize ) ;
          if ( rc )
          {
@@ -3412,6 +3422,199 @@ namespace engine
       goto done ;
    }
 
+   IMPLEMENT_CMD_AUTO_REGISTER( _rtnBulkLoad )
+   // PD_TRACE_DECLARE_FUNCTION( SDB__RTNBULKLOAD_INIT, "_rtnBulkLoad::init" )
+   INT32 _rtnBulkLoad::init ( INT32 flags, INT64 numToSkip, INT64 numToReturn,
+                              const CHAR *pMatcherBuff,
+                              const CHAR *pSelectBuff,
+                              const CHAR *pOrderByBuff,
+                              const CHAR *pHintBuff )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB__RTNBULKLOAD_INIT ) ;
+      try
+      {
+         BSONObj query( pMatcherBuff ) ;
+         BSONElement eleName, eleData, eleNum, eleVersion ;
+         INT32 blockSize = 0 ;
+
+         eleName = query.getField( FIELD_NAME_COLLECTION ) ;
+         if ( String != eleName.type() )
+         {
+            PD_LOG( PDERROR, "Invalid collection name in command: %s",
+                    query.toString( FALSE, TRUE ).c_str() ) ;
+            rc = SDB_INVALIDARG ;
+            goto error ;
+         }
+         _fullName = eleName.valuestr() ;
+
+         eleData = query.getField( FIELD_NAME_DATA ) ;
+         if ( BinData != eleData.type() )
+         {
+            PD_LOG( PDERROR, "Invalid data of bulk load in command: %s",
+                    query.toString( FALSE, TRUE ).c_str() ) ;
+            rc = SDB_INVALIDARG ;
+            goto error ;
+         }
+         _pBlock = eleData.binData( blockSize ) ;
+         _blockSize = (UINT32)blockSize ;
+
+         eleNum = query.getField( FIELD_NAME_RECORD_NUM ) ;
+         if ( NumberInt != eleNum.type() || eleNum.numberInt() <= 0 )
+         {
+            PD_LOG( PDERROR, "Invalid record num of bulk load in "
+                    "command: %s", query.toString( FALSE, TRUE ).c_str() ) ;
+            rc = SDB_INVALIDARG ;
+            goto error ;
+         }
+         _recordNum = (UINT32)eleNum.numberInt() ;
+
+         eleVersion = query.getField( FIELD_NAME_VERSION ) ;
+         if ( NumberInt != eleVersion.type() )
+         {
+            PD_LOG( PDERROR, "Invalid catalog version of bulk load in "
+                    "command: %s", query.toString( FALSE, TRUE ).c_str() ) ;
+            rc = SDB_INVALIDARG ;
+            goto error ;
+         }
+         _version = eleVersion.numberInt() ;
+      }
+      catch( std::exception &e )
+      {
+         PD_LOG( PDERROR, "unexpected err happened:%s", e.what() ) ;
+         rc = SDB_SYS ;
+         goto error ;
+      }
+
+   done:
+      PD_TRACE_EXITRC( SDB__RTNBULKLOAD_INIT, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION( SDB__RTNBULKLOAD_DOIT, "_rtnBulkLoad::doit" )
+   INT32 _rtnBulkLoad::doit ( _pmdEDUCB *cb, _SDB_DMSCB *dmsCB,
+                              _SDB_RTNCB *rtnCB, _dpsLogWrapper *dpsCB,
+                              INT16 w, INT64 *pContextID )
+   {
+      INT32 rc = SDB_OK ;
+      BOOLEAN isData = ( SDB_ROLE_DATA == pmdGetDBRole() ) ;
+      PD_TRACE_ENTRY( SDB__RTNBULKLOAD_DOIT ) ;
+
+      if ( isData )
+      {
+         rc = _checkCatalog() ;
+         if ( rc )
+         {
+            goto error ;
+         }
+      }
+
+      rc = rtnBulkLoad( _fullName, _pBlock, _blockSize, _recordNum, cb,
+                        dmsCB, dpsCB, w, isData ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to bulk load records to "
+                   "collection[%s], rc: %d", _fullName, rc ) ;
+   done:
+      PD_TRACE_EXITRC( SDB__RTNBULKLOAD_DOIT, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION( SDB__RTNBULKLOAD__CHKCATALOG, "_rtnBulkLoad::_checkCatalog" )
+   INT32 _rtnBulkLoad::_checkCatalog()
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB__RTNBULKLOAD__CHKCATALOG ) ;
+      shardCB *pShdMgr = sdbGetShardCB() ;
+      catAgent *pCatAgent = pShdMgr->getCataAgent() ;
+      UINT32 groupID = pmdGetNodeID().columns.groupID ;
+      clsCatalogSet *pSet = NULL ;
+      BOOLEAN locked = FALSE ;
+      BOOLEAN updated = FALSE ;
+      UINT32 offset = 0 ;
+
+   retry:
+      pCatAgent->lock_r() ;
+      locked = TRUE ;
+      pSet = pCatAgent->collectionSet( _fullName ) ;
+      if ( NULL == pSet || pSet->getVersion() < _version )
+      {
+         pCatAgent->release_r() ;
+         locked = FALSE ;
+         if ( updated )
+         {
+            rc = ( NULL == pSet ) ? SDB_CLS_NO_CATALOG_INFO :
+                                    SDB_CLS_DATA_NODE_CAT_VER_OLD ;
+            goto error ;
+         }
+         rc = pShdMgr->syncUpdateCatalog( _fullName ) ;
+         PD_RC_CHECK( rc, PDWARNING, "Failed to update catalog of "
+                      "collection[%s], rc: %d", _fullName, rc ) ;
+         updated = TRUE ;
+         goto retry ;
+      }
+      else if ( pSet->getVersion() > _version )
+      {
+         PD_LOG( PDWARNING, "Catalog version[%d] of collection[%s] is newer "
+                 "than the one[%d] of bulk load", pSet->getVersion(),
+                 _fullName, _version ) ;
+         rc = SDB_CLS_COORD_NODE_CAT_VER_OLD ;
+         goto error ;
+      }
+      else if ( pSet->isMainCL() )
+      {
+         PD_LOG( PDERROR, "Bulk load can't be used on main-collection[%s]",
+                 _fullName ) ;
+         rc = SDB_OPTION_NOT_SUPPORT ;
+         goto error ;
+      }
+
+      try
+      {
+         while ( offset < _blockSize )
+         {
+            UINT32 size = 0 ;
+            if ( _blockSize - offset < DMS_LOAD_RECORD_MIN_SZ ||
+                 ( size = *(const UINT32*)( _pBlock + offset ) ) <
+                 DMS_LOAD_RECORD_MIN_SZ || size > _blockSize - offset )
+            {
+               PD_LOG( PDERROR, "Invalid record at offset[%u] of block",
+                       offset ) ;
+               rc = SDB_INVALIDARG ;
+               goto error ;
+            }
+
+            BSONObj obj( _pBlock + offset ) ;
+            if ( !pSet->isObjInGroup( obj, groupID ) )
+            {
+               PD_LOG( PDWARNING, "Record[%s] of bulk load doesn't belong "
+                       "to group[%u]", obj.toString().c_str(), groupID ) ;
+               rc = SDB_CLS_COORD_NODE_CAT_VER_OLD ;
+               goto error ;
+            }
+            offset += ossAlign4( size ) ;
+         }
+      }
+      catch( std::exception &e )
+      {
+         PD_LOG( PDERROR, "Occur exception: %s", e.what() ) ;
+         rc = SDB_SYS ;
+         goto error ;
+      }
+
+   done:
+      if ( locked )
+      {
+         pCatAgent->release_r() ;
+      }
+      PD_TRACE_EXITRC( SDB__RTNBULKLOAD__CHKCATALOG, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
    IMPLEMENT_CMD_AUTO_REGISTER( _rtnAlterCollection )
    _rtnAlterCollection::_rtnAlterCollection()
    {
@@ -1929,5 +1929,96 @@ namespace engine
    error:
       goto done ;
    }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_RTNBULKLOAD, "rtnBulkLoad" )
+   INT32 rtnBulkLoad( const CHAR *pCollectionName, const CHAR *pBlock,
+                      UINT32 blockSize, UINT32 recordNum,
+                      pmdEDUCB *cb, SDB_DMSCB *dmsCB, SDB_DPSCB *dpsCB,
+                      INT16 w, BOOLEAN checkDataSync )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB_RTNBULKLOAD ) ;
+
+      SDB_ASSERT( pCollectionName, "collection name can't be NULL" ) ;
+      SDB_ASSERT( pBlock, "block can't be NULL" ) ;
+      SDB_ASSERT( cb, "eduCB can't be NULL" ) ;
+      SDB_ASSERT( dmsCB, "dmsCB can't be NULL" ) ;
+
+      BOOLEAN writable = FALSE ;
+      dmsStorageUnit *su = NULL ;
+      const CHAR *clShortName = NULL ;
+      dmsStorageUnitID suID = DMS_INVALID_SUID ;
+      dmsMBContext *mbContext = NULL ;
+
+      if ( DPS_INVALID_TRANS_ID != cb->getTransID() )
+      {
+         PD_LOG( PDERROR, "Bulk load can't be used in transaction" ) ;
+         rc = SDB_OPERATION_INCOMPATIBLE ;
+         goto error ;
+      }
+
+      rc = dmsCB->writable( cb ) ;
+      PD_RC_CHECK( rc, PDERROR, "Database is not writable, rc: %d", rc ) ;
+      writable = TRUE ;
+
+      rc = rtnResolveCollectionNameAndLock( pCollectionName, dmsCB, &su,
+                                            &clShortName, suID ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to resolve collection name %s, rc: %d",
+                   pCollectionName, rc ) ;
+
+      if ( DMS_STORAGE_NORMAL != su->type() )
+      {
+         PD_LOG( PDERROR, "Bulk load can only be used on normal collection" ) ;
+         rc = SDB_OPTION_NOT_SUPPORT ;
+         goto error ;
+      }
+
+      rc = su->data()->getMBContext( &mbContext, clShortName, -1 ) ;
+      PD_RC_CHECK( rc, PDERROR, "Get collection[%s] mb context failed, "
+                   "rc: %d", pCollectionName, rc ) ;
+
+      if ( checkDataSync &&
+           sdbGetReplCB()->isCLInDataSync( su->LogicalCSID(),
+                                           mbContext->clLID() ) )
+      {
+         PD_LOG( PDWARNING, "Collection[%s] is being synced by split or "
+                 "full sync, bulk load is refused", pCollectionName ) ;
+         rc = SDB_CLS_MUTEX_TASK_EXIST ;
+         goto error ;
+      }
+
+      rc = su->data()->loadRecords( mbContext, pBlock, blockSize, recordNum,
+                                    cb, dpsCB ) ;
+      PD_RC_CHECK( rc, PDERROR, "Load records to collection[%s] failed, "
+                   "rc: %d", pCollectionName, rc ) ;
+
+   done:
+      if ( mbContext )
+      {
+         su->data()->releaseMBContext( mbContext ) ;
+      }
+
+      if ( DMS_INVALID_CS != suID )
+      {
+         dmsCB->suUnlock( suID ) ;
+      }
+
+      if ( writable )
+      {
+         dmsCB->writeDown( cb ) ;
+      }
+      if ( cb )
+      {
+         if ( SDB_OK == rc && dpsCB )
+         {
+            rc = dpsCB->completeOpr( cb, w ) ;
+         }
+      }
+
+      PD_TRACE_EXITRC( SDB_RTNBULKLOAD, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
 }
 
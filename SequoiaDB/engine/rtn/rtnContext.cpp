@@ -54,6 +54,7 @@ namespace engine
    _rtnContextStoreBuf::_rtnContextStoreBuf()
    {
       _buffer = NULL ;
+      _fwdData = NULL ;
       _numRecords = 0 ;
       _bufferSize = 0 ;
       _readOffset = 0 ;
@@ -124,6 +125,7 @@ namespace engine
       {
          *RTN_GET_REFERENCE( _buffer ) = 0 ;
          *RTN_GET_CONTEXT_FLAG( _buffer ) = 1 ;
+         *RTN_GET_FORWARD_BLOCK( _buffer ) = NULL ;
       }
 
    done:
@@ -132,12 +134,97 @@ namespace engine
       goto done ;
    }
 
+   void _rtnContextStoreBuf::_freeForwardBlock()
+   {
+      if ( hasMem() && NULL != *RTN_GET_FORWARD_BLOCK( _buffer ) )
+      {
+         SDB_ASSERT( 0 == getRefCount(), "Forward block is referenced" ) ;
+         SDB_OSS_FREE( *RTN_GET_FORWARD_BLOCK( _buffer ) ) ;
+         *RTN_GET_FORWARD_BLOCK( _buffer ) = NULL ;
+      }
+   }
+
+   INT32 _rtnContextStoreBuf::forward( CHAR *pBlock, const CHAR *objBuf,
+                                       INT32 len, INT32 num )
+   {
+      INT32 rc = SDB_OK ;
+
+      SDB_ASSERT( canForward(), "Can't forward" ) ;
+      SDB_ASSERT( len >= 0, "len should >= 0" ) ;
+      SDB_ASSERT( num >= 0, "num should >= 0" ) ;
+
+      // the head of the buffer holds the block
+      rc = _ensureBufferSize( 1 ) ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG ( PDERROR, "Failed to allocate buffer for context, rc: %d",
+                  rc ) ;
+         goto error ;
+      }
+
+      _freeForwardBlock() ;
+      *RTN_GET_FORWARD_BLOCK( _buffer ) = pBlock ;
+
+      _fwdData = objBuf ;
+      _readOffset = 0 ;
+      _writeOffset = len ;
+      _numRecords += num ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   INT32 _rtnContextStoreBuf::_endForward()
+   {
+      INT32 rc = SDB_OK ;
+      const CHAR *pData = _fwdData ;
+      INT32 readOffset = ossAlign4( (UINT32)_readOffset ) ;
+      INT32 len = _writeOffset > readOffset ? _writeOffset - readOffset : 0 ;
+
+      // the records are not got yet, copy them into the buffer, so that
+      // more can be appended after them
+      _fwdData = NULL ;
+      _readOffset = 0 ;
+      _writeOffset = 0 ;
+      if ( len > 0 )
+      {
+         rc = _ensureBufferSize( len ) ;
+         if ( SDB_OK != rc )
+         {
+            PD_LOG ( PDERROR, "Failed to reallocate buffer for context, rc: "
+                     "%d", rc ) ;
+            goto error ;
+         }
+         ossMemcpy( _buffer, &pData[ readOffset ], len ) ;
+         _writeOffset = len ;
+      }
+      if ( 0 == getRefCount() )
+      {
+         _freeForwardBlock() ;
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
    INT32 _rtnContextStoreBuf::append( const BSONObj& obj )
    {
       INT32 rc = SDB_OK ;
 
       if ( !isCountMode() )
       {
+         if ( NULL != _fwdData )
+         {
+            rc = _endForward() ;
+            if ( SDB_OK != rc )
+            {
+               goto error ;
+            }
+         }
          _writeOffset = ossAlign4( (UINT32)_writeOffset ) ;
          if ( _writeOffset + obj.objsize () > _bufferSize )
          {
@@ -174,6 +261,14 @@ namespace engine
 
       if ( !isCountMode() )
       {
+         if ( NULL != _fwdData )
+         {
+            rc = _endForward() ;
+            if ( SDB_OK != rc )
+            {
+               goto error ;
+            }
+         }
          if ( len > 0 )
          {
             if ( needAligned )
@@ -216,9 +311,13 @@ namespace engine
 
       if ( !isCountMode() )
       {
+         // the records of the forward block are referenced by the
+         // buffer, which holds the block
+         const CHAR *pData = _fwdData ? _fwdData : _buffer ;
+
          _readOffset = ossAlign4( (UINT32)_readOffset ) ;
          buf._pOrgBuff = _buffer ;
-         buf._pBuff = &_buffer[ _readOffset ] ;
+         buf._pBuff = &pData[ _readOffset ] ;
 
          if ( maxNumToReturn < 0 )
          {
@@ -235,7 +334,7 @@ namespace engine
             {
                try
                {
-                  BSONObj obj( &_buffer[_readOffset] ) ;
+                  BSONObj obj( &pData[_readOffset] ) ;
                   _readOffset += ossAlign4( (UINT32)obj.objsize() ) ;
                }
                catch ( std::exception &e )
@@ -285,9 +384,11 @@ namespace engine
       if ( NULL != _buffer )
       {
          *RTN_GET_CONTEXT_FLAG( _buffer ) = 0 ;
+         _fwdData = NULL ;
 
          if ( *RTN_GET_REFERENCE( _buffer ) == 0 )
          {
+            _freeForwardBlock() ;
             SDB_OSS_FREE( RTN_BUFF_TO_REAL_PTR( _buffer ) ) ;
             _buffer = NULL ;
          }
@@ -476,6 +577,32 @@ namespace engine
       goto done ;
    }
 
+   INT32 _rtnContextBase::forwardObjs( CHAR *pBlock, const CHAR *pObjBuff,
+                                       INT32 len, INT32 num )
+   {
+      INT32 rc = SDB_OK ;
+
+      if ( !_isOpened )
+      {
+         _isOpened = TRUE ;
+      }
+
+      rc = _buffer.forward( pBlock, pObjBuff, len, num ) ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG ( PDERROR, "Failed to forward objs to context buffer, rc: "
+                           "%d", rc ) ;
+         goto error ;
+      }
+
+      _totalRecords += num ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
    void _rtnContextBase::_onDataEmpty ()
    {
       if ( _canPrefetch() && 0 != _prefetchID )
@@ -256,6 +256,12 @@ namespace engine
          {
             if ( *RTN_GET_CONTEXT_FLAG( _pOrgBuff ) == 0 )
             {
+               // the context is gone, the buffer and the block forwarded
+               // by it are freed by the last reference
+               if ( NULL != *RTN_GET_FORWARD_BLOCK( _pOrgBuff ) )
+               {
+                  SDB_OSS_FREE( *RTN_GET_FORWARD_BLOCK( _pOrgBuff ) ) ;
+               }
                SDB_OSS_FREE( RTN_BUFF_TO_REAL_PTR( _pOrgBuff ) ) ;
             }
             else
@@ -176,6 +176,7 @@ namespace engine
          goto error ;
       }
       _scanner->setMonCtxCB ( &_monCtxCB ) ;
+      _scanner->setReadAhead ( &_readAhead ) ;
 
       if ( blockObj )
       {
@@ -683,6 +684,9 @@ namespace engine
             break ;
          }
 
+         _readAhead.onAccess( _su->data(), _extentID,
+                              extScanner->curExtent()->_blockSize ) ;
+
          if ( _segmentScan )
          {
             if ( DMS_INVALID_EXTENT == extScanner->nextExtentID() ||
@@ -1071,6 +1075,7 @@ namespace engine
    :_rtnContextData( contextID, eduID )
    {
       _isParalled = FALSE ;
+      _isOrdered  = FALSE ;
       _curIndex   = 0 ;
       _step       = 1 ;
    }
@@ -1112,7 +1117,6 @@ namespace engine
                                     INT32 direction )
    {
       INT32 rc = SDB_OK ;
-      rtnReturnOptions subReturnOptions( returnOptions ) ;
 
       _step = pmdGetKRCB()->getOptionCB()->maxSubQuery() ;
       if ( 0 == _step )
@@ -1158,6 +1162,14 @@ namespace engine
          }
          _indexBlockScan = TRUE ;
          _direction = 1 ;
+
+         // the key ranges are disjoint and in index order, so the order
+         // given by the index is kept by returning the morsels one by one
+         if ( !_planRuntime.sortRequired() &&
+              !_planRuntime.getOrderBy().isEmpty() )
+         {
+            _isOrdered = TRUE ;
+         }
       }
 
       if ( ( _segmentScan && _segments.size() <= 1 ) ||
@@ -1169,25 +1181,22 @@ namespace engine
       _isParalled = TRUE ;
       mbContext->mbUnlock() ;
 
+      _subReturnOptions = returnOptions ;
       if ( returnOptions.getLimit() > 0 &&
            returnOptions.getSkip() > 0 )
       {
-         subReturnOptions.setLimit( returnOptions.getLimit() +
-                                    returnOptions.getSkip() ) ;
+         _subReturnOptions.setLimit( returnOptions.getLimit() +
+                                     returnOptions.getSkip() ) ;
       }
-      subReturnOptions.setSkip( 0 ) ;
-      subReturnOptions.clearFlag( FLG_QUERY_PARALLED ) ;
+      _subReturnOptions.setSkip( 0 ) ;
+      _subReturnOptions.clearFlag( FLG_QUERY_PARALLED ) ;
 
-      while ( NULL != ( blockObj = _nextBlockObj() ) )
+      rc = _checkAndPrefetch( cb ) ;
+      if ( rc && SDB_DMS_EOC != rc )
       {
-         rc = _openSubContext( cb, subReturnOptions, blockObj ) ;
-         if ( rc )
-         {
-            goto error ;
-         }
+         goto error ;
       }
-
-      _checkAndPrefetch () ;
+      rc = SDB_OK ;
 
    done:
       mbContext->mbUnlock() ;
@@ -1266,10 +1275,11 @@ namespace engine
       goto done ;
    }
 
-   INT32 _rtnContextParaData::_checkAndPrefetch ()
+   INT32 _rtnContextParaData::_checkAndPrefetch ( pmdEDUCB *cb )
    {
       INT32 rc = SDB_OK ;
       rtnContextData *pContext = NULL ;
+      const BSONObj *blockObj = NULL ;
       vector< rtnContextData* >::iterator it = _vecContext.begin() ;
       while ( it != _vecContext.end() )
       {
@@ -1291,13 +1301,32 @@ namespace engine
          ++it ;
       }
 
+      // hand out the pending morsels to the free workers
+      while ( _vecContext.size() < _step &&
+              NULL != ( blockObj = _nextBlockObj() ) )
+      {
+         rc = _openSubContext( cb, _subReturnOptions, blockObj ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         pContext = _vecContext.back() ;
+         if ( !pContext->eof() )
+         {
+            pContext->_onDataEmpty() ;
+         }
+      }
+
       if ( _vecContext.size() == 0 )
       {
          rc = SDB_DMS_EOC ;
          _hitEnd = TRUE ;
       }
 
+   done:
       return rc ;
+   error:
+      goto done ;
    }
 
    const BSONObj* _rtnContextParaData::_nextBlockObj ()
@@ -1305,40 +1334,36 @@ namespace engine
       BSONArrayBuilder builder ;
       UINT32 curIndex = _curIndex ;
 
-      if ( _curIndex >= _step ||
-           ( TBSCAN == _scanType && _curIndex >= _segments.size() ) ||
+      if ( ( TBSCAN == _scanType && _curIndex >= _segments.size() ) ||
            ( IXSCAN == _scanType && _curIndex + 1 >= _indexBlocks.size() ) )
       {
          return NULL ;
       }
       ++_curIndex ;
 
+      // every morsel is one segment or one key range
       if ( TBSCAN == _scanType )
       {
-         while ( curIndex < _segments.size() )
-         {
-            builder.append( _segments[curIndex] ) ;
-            curIndex += _step ;
-         }
+         builder.append( _segments[curIndex] ) ;
       }
       else if ( IXSCAN == _scanType )
       {
-         while ( curIndex + 1 < _indexBlocks.size() )
-         {
-            builder.append( BSON( FIELD_NAME_STARTKEY <<
-                                  _indexBlocks[curIndex] <<
-                                  FIELD_NAME_ENDKEY <<
-                                  _indexBlocks[curIndex+1] <<
-                                  FIELD_NAME_STARTRID <<
-                                  BSON_ARRAY( _indexRIDs[curIndex]._extent <<
-                                              _indexRIDs[curIndex]._offset ) <<
-                                  FIELD_NAME_ENDRID <<
-                                  BSON_ARRAY( _indexRIDs[curIndex+1]._extent <<
-                                              _indexRIDs[curIndex+1]._offset )
-                                 )
-                            ) ;
-            curIndex += _step ;
+         if ( _isOrdered && _planRuntime.getDirection() < 0 )
+         {
+            curIndex = _indexBlocks.size() - 2 - curIndex ;
          }
+         builder.append( BSON( FIELD_NAME_STARTKEY <<
+                               _indexBlocks[curIndex] <<
+                               FIELD_NAME_ENDKEY <<
+                               _indexBlocks[curIndex+1] <<
+                               FIELD_NAME_STARTRID <<
+                               BSON_ARRAY( _indexRIDs[curIndex]._extent <<
+                                           _indexRIDs[curIndex]._offset ) <<
+                               FIELD_NAME_ENDRID <<
+                               BSON_ARRAY( _indexRIDs[curIndex+1]._extent <<
+                                           _indexRIDs[curIndex+1]._offset )
+                              )
+                         ) ;
       }
       else
       {
@@ -1401,7 +1426,8 @@ namespace engine
             goto error ;
          }
 
-         if ( _numToSkip <= 0 )
+         // the first sub context holds the lowest morsel in order mode
+         if ( _numToSkip <= 0 && !_isOrdered )
          {
             rc = _getSubCtxWithData( &pContext, cb ) ;
             if ( rc )
@@ -1459,10 +1485,16 @@ namespace engine
             }
          } // end if ( pContext )
 
-         if ( SDB_OK != _checkAndPrefetch() )
+         rc = _checkAndPrefetch( cb ) ;
+         if ( SDB_DMS_EOC == rc )
          {
             break ;
          }
+         else if ( rc )
+         {
+            PD_LOG( PDERROR, "Failed to dispatch morsels, rc: %d", rc ) ;
+            goto error ;
+         }
       } // while ( isEmpty() && 0 != _numToReturn )
 
       if ( 0 == _numToReturn )
@@ -57,14 +57,16 @@ namespace engine
       SDB_RTNCB* rtnCB = pKrcb->getRTNCB() ;
       pmdEDUCB* eduCB = pKrcb->getEDUMgr()->getEDUByID( eduID() ) ;
 
-      SUB_ORDERED_CTX_MAP::iterator orderIter = _orderedContextMap.begin() ;
-      while ( orderIter != _orderedContextMap.end() )
+      for ( UINT32 i = 0 ; i < _orderedContextTree.capacity() ; ++i )
       {
-         rtnCB->contextDelete( orderIter->second->contextID(), eduCB ) ;
-         SDB_OSS_DEL orderIter->second ;
-         ++orderIter ;
+         rtnSubContext *subCtx = _orderedContextTree.at( i ) ;
+         if ( NULL != subCtx )
+         {
+            rtnCB->contextDelete( subCtx->contextID(), eduCB ) ;
+            SDB_OSS_DEL subCtx ;
+         }
       }
-      _orderedContextMap.clear() ;
+      _orderedContextTree.clear() ;
 
       SAFE_OSS_DELETE( _keyGen ) ;
    }
@@ -124,15 +126,10 @@ namespace engine
          goto error ;
       }
 
-      try
-      {
-         _orderedContextMap.insert(
-            SUB_ORDERED_CTX_MAP::value_type( orderKey, subCtx ) ) ;
-      }
-      catch( std::exception& e )
+      rc = _orderedContextTree.push( subCtx, orderKey ) ;
+      if ( SDB_OK != rc )
       {
-         rc = SDB_SYS ;
-         PD_LOG( PDERROR, "occur unexpected error:%s", e.what() );
+         PD_LOG( PDERROR, "Failed to save sub context, rc = %d", rc ) ;
          goto error ;
       }
 
@@ -161,7 +158,7 @@ namespace engine
             goto error ;
          }
 
-         if ( _orderedContextMap.size() == 0 )
+         if ( _orderedContextTree.empty() )
          {
             _hitEnd = TRUE ;
             rc = SDB_DMS_EOC ;
@@ -179,8 +176,8 @@ namespace engine
             break ;
          }
 
-         SUB_ORDERED_CTX_MAP::iterator iter = _orderedContextMap.begin();
-         if ( _orderedContextMap.end() == iter )
+         rtnSubContext* ctx = _orderedContextTree.top() ;
+         if ( NULL == ctx )
          {
             _hitEnd = TRUE ;
             if ( isEmpty() )
@@ -190,8 +187,6 @@ namespace engine
             break;
          }
 
-         rtnSubContext* ctx = iter->second ;
-
          if ( _numToSkip <= 0 )
          {
             const CHAR* data = ctx->front() ;
@@ -255,7 +250,10 @@ namespace engine
 
          if ( ctx->recordNum() <= 0 )
          {
-            _orderedContextMap.erase ( iter ) ;
+            UINT32 ctxNum = 0 ;
+
+            _orderedContextTree.popTop() ;
+            ctxNum = _orderedContextTree.size() ;
 
             rc = _saveEmptyOrderedSubCtx( ctx ) ;
             if ( SDB_OK != rc )
@@ -264,21 +262,25 @@ namespace engine
                goto error ;
             }
 
-            if ( !isEmpty() )
+            // the sub context may be refilled by the prefetched data and
+            // be back to the tree, then the merging goes on
+            if ( _orderedContextTree.size() <= ctxNum && !isEmpty() )
             {
                break ;
             }
          }
          else
          {
-            _orderedContextMap.erase ( iter ) ;
-
-            rc = _saveNonEmptyOrderedSubCtx( ctx ) ;
+            // the winner is replaced by its next record, no need to take
+            // it out of the tree
+            rtnOrderKey orderKey ;
+            rc = ctx->getOrderKey( orderKey ) ;
             if ( SDB_OK != rc )
             {
-               SDB_OSS_DEL ctx ;
+               PD_LOG( PDERROR, "Failed to get orderKey, rc = %d", rc ) ;
                goto error ;
             }
+            _orderedContextTree.replaceTop( orderKey ) ;
          }
 
          if ( buffEndOffset() + DMS_RECORD_MAX_SZ >
@@ -369,13 +371,8 @@ namespace engine
                _numToReturn -= ctx->recordNum() ;
             }
 
-            rc = appendObjs( ctx->front(),
-                             ctx->remainLength(),
-                             ctx->recordNum() ) ;
+            rc = _appendSubCtxObjs( ctx ) ;
             PD_RC_CHECK( rc, PDERROR, "Failed to append objs, rc: %d", rc ) ;
-
-            rc = ctx->popAll() ;
-            PD_RC_CHECK( rc, PDERROR, "Failed to pop all objs of sub ctx, rc: %d", rc ) ;
          }
          else
          {
@@ -451,6 +448,44 @@ namespace engine
    
    }
 
+   INT32 _rtnContextMain::_appendSubCtxObjs( rtnSubContext *ctx )
+   {
+      INT32 rc = SDB_OK ;
+      const CHAR *pObjs = ctx->front() ;
+      INT32 len = ctx->remainLength() ;
+      INT32 num = ctx->recordNum() ;
+      CHAR *pBlock = NULL ;
+
+      // the records need no merging, the reply of the sub context is
+      // returned as the buffer of the main context when it is empty
+      if ( NULL != pObjs && canForwardObjs() &&
+           NULL != ( pBlock = ctx->detachData() ) )
+      {
+         rc = forwardObjs( pBlock, pObjs, len, num ) ;
+         if ( SDB_OK != rc )
+         {
+            SDB_OSS_FREE( pBlock ) ;
+            goto error ;
+         }
+         goto done ;
+      }
+
+      rc = appendObjs( pObjs, len, num ) ;
+      if ( SDB_OK != rc )
+      {
+         goto error ;
+      }
+
+      rc = ctx->popAll() ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to pop all objs of sub ctx, rc: %d",
+                   rc ) ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
    INT32 _rtnContextMain::_processSubContext ( rtnSubContext * subContext,
                                                BOOLEAN & skipData )
    {
@@ -0,0 +1,194 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = rtnExtentSealJob.cpp
+
+   Descriptive Name = Runtime Extent Seal Job
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of runtime component. This file contains the background job
+   which compresses the full extents of the block compressed collections.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#include "rtnExtentSealJob.hpp"
+#include "dmsStorageUnit.hpp"
+#include "pmd.hpp"
+#include "pdTrace.hpp"
+#include "rtnTrace.hpp"
+
+namespace engine
+{
+
+   /*
+      _rtnExtentSealJob implement
+   */
+   _rtnExtentSealJob::_rtnExtentSealJob()
+   {
+   }
+
+   _rtnExtentSealJob::~_rtnExtentSealJob()
+   {
+   }
+
+   RTN_JOB_TYPE _rtnExtentSealJob::type () const
+   {
+      return RTN_JOB_SEAL_EXTENT ;
+   }
+
+   const CHAR* _rtnExtentSealJob::name () const
+   {
+      return "ExtentSealer" ;
+   }
+
+   BOOLEAN _rtnExtentSealJob::muteXOn ( const _rtnBaseJob *pOther )
+   {
+      return FALSE ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__RTNEXTENTSEALJOB_DOIT, "_rtnExtentSealJob::doit" )
+   INT32 _rtnExtentSealJob::doit ()
+   {
+      PD_TRACE_ENTRY ( SDB__RTNEXTENTSEALJOB_DOIT ) ;
+      INT32 rc = SDB_OK ;
+      pmdKRCB *krcb = pmdGetKRCB() ;
+      pmdEDUMgr *eduMgr = krcb->getEDUMgr() ;
+      SDB_DMSCB *dmsCB = krcb->getDMSCB() ;
+      pmdEDUCB *cb = eduCB() ;
+      dmsSealJob job ;
+
+      while ( !PMD_IS_DB_DOWN() && !cb->isForced() )
+      {
+         eduMgr->waitEDU( cb ) ;
+         if ( !dmsCB->dispatchSealJob( job, RTN_SEAL_WAIT_INTERVAL ) )
+         {
+            continue ;
+         }
+         eduMgr->activateEDU( cb ) ;
+
+         /*
+            The failed extents are not pushed back, they are checked again
+            when the next extent of the collection is allocated
+         */
+         rc = _sealCL( job ) ;
+         if ( rc && SDB_DMS_CS_NOTEXIST != rc && SDB_DMS_NOTEXIST != rc )
+         {
+            PD_LOG( PDWARNING, "Failed to seal the extents of collection[%u] "
+                    "in storage unit[%d], rc: %d", job._clID, job._suID, rc ) ;
+         }
+
+         cb->incEventCount() ;
+      }
+
+      PD_TRACE_EXIT ( SDB__RTNEXTENTSEALJOB_DOIT ) ;
+      return SDB_OK ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__RTNEXTENTSEALJOB__SEALCL, "_rtnExtentSealJob::_sealCL" )
+   INT32 _rtnExtentSealJob::_sealCL( const dmsSealJob &job )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY ( SDB__RTNEXTENTSEALJOB__SEALCL ) ;
+      SDB_DMSCB *dmsCB = pmdGetKRCB()->getDMSCB() ;
+      pmdEDUCB *cb = eduCB() ;
+      dmsStorageUnit *su = NULL ;
+      dmsMBContext *mbContext = NULL ;
+      BOOLEAN writable = FALSE ;
+      UINT32 sealedNum = 0 ;
+
+      rc = dmsCB->writable( cb ) ;
+      PD_RC_CHECK( rc, PDERROR, "Database is not writable, rc: %d", rc ) ;
+      writable = TRUE ;
+
+      // the storage unit or the collection may be dropped
+      su = dmsCB->suLock( job._suID ) ;
+      if ( NULL == su || su->LogicalCSID() != job._suLID )
+      {
+         rc = SDB_DMS_CS_NOTEXIST ;
+         goto error ;
+      }
+
+      rc = su->data()->getMBContext( &mbContext, job._clID, job._clLID,
+                                     DMS_INVALID_CLID ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+
+      rc = su->data()->sealExtents( mbContext, cb, sealedNum ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to seal the extents of "
+                   "collection[%s.%s], rc: %d", su->CSName(),
+                   mbContext->mb()->_collectionName, rc ) ;
+      if ( sealedNum > 0 )
+      {
+         PD_LOG( PDDEBUG, "Sealed %u extents of collection[%s.%s]",
+                 sealedNum, su->CSName(),
+                 mbContext->mb()->_collectionName ) ;
+      }
+
+   done:
+      if ( mbContext )
+      {
+         su->data()->releaseMBContext( mbContext ) ;
+      }
+      if ( su )
+      {
+         dmsCB->suUnlock( job._suID ) ;
+      }
+      if ( writable )
+      {
+         dmsCB->writeDown( cb ) ;
+      }
+      PD_TRACE_EXITRC ( SDB__RTNEXTENTSEALJOB__SEALCL, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB_STARTEXTENTSEALJOB, "startExtentSealJob" )
+   INT32 startExtentSealJob ( EDUID *pEDUID )
+   {
+      INT32 rc = SDB_OK ;
+      rtnExtentSealJob *pJob = NULL ;
+      PD_TRACE_ENTRY ( SDB_STARTEXTENTSEALJOB ) ;
+
+      pJob = SDB_OSS_NEW rtnExtentSealJob() ;
+      PD_CHECK( pJob, SDB_OOM, error, PDERROR,
+                "Failed to allocate memory for extent seal job" ) ;
+
+      rc = rtnGetJobMgr()->startJob( pJob, RTN_JOB_MUTEX_RET, pEDUID ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to start extent seal job, rc: %d",
+                   rc ) ;
+
+   done:
+      PD_TRACE_EXITRC ( SDB_STARTEXTENTSEALJOB, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+}
@@ -51,6 +51,7 @@ namespace engine
      _order(Ordering::make(indexCB->keyPattern())),
      _su(su),
      _pMonCtxCB(NULL),
+     _pReadAhead(NULL),
      _cb(cb),
      _direction(predList->getDirection())
    {
@@ -100,6 +101,7 @@ namespace engine
                        keyObj.toString().c_str(), rid._extent,
                        rid._offset ) ;
          _savedObj = keyObj.copy() ;
+         _savedKeyData.clear() ;
          _savedRID = rid ;
          DMS_MON_OP_COUNT_INC( pMonAppCB, MON_INDEX_READ, 1 ) ;
          DMS_MON_CONTEXT_COUNT_INC ( _pMonCtxCB, MON_INDEX_READ, 1 ) ;
@@ -208,10 +210,9 @@ namespace engine
                {
                   try
                   {
-                     _curKeyObj = ixmKey(dataBuffer).toBson() ;
                      DMS_MON_OP_COUNT_INC( pMonAppCB, MON_INDEX_READ, 1 ) ;
                      DMS_MON_CONTEXT_COUNT_INC ( _pMonCtxCB, MON_INDEX_READ, 1 ) ;
-                     if ( _curKeyObj.shallowEqual(_savedObj) )
+                     if ( _isSavedKey( ixmKey(dataBuffer) ) )
                      {
                         rc = indexExtent.advance ( _curIndexRID, _direction ) ;
                         if ( rc )
@@ -280,21 +281,31 @@ namespace engine
          }
          try
          {
-            try
+            ixmKey curKey ( dataBuffer ) ;
+            DMS_MON_OP_COUNT_INC( pMonAppCB, MON_INDEX_READ, 1 ) ;
+            DMS_MON_CONTEXT_COUNT_INC ( _pMonCtxCB, MON_INDEX_READ, 1 ) ;
+            if ( _isSameKey( _matchedKeyData, curKey ) )
             {
-               _curKeyObj = ixmKey(dataBuffer).toBson() ;
-               DMS_MON_OP_COUNT_INC( pMonAppCB, MON_INDEX_READ, 1 ) ;
-               DMS_MON_CONTEXT_COUNT_INC ( _pMonCtxCB, MON_INDEX_READ, 1 ) ;
+               // the same bytes as the last key in the bounds, so it's in
+               // the bounds too, and the iterator stays where it is
+               rc = -1 ;
             }
-            catch ( std::exception &e )
+            else
             {
-               PD_RC_CHECK ( SDB_SYS, PDERROR,
-                             "Failed to convert from buffer "
-                             "to bson, rid: %d,%d: %s",
-                             _curIndexRID._extent,
-                             _curIndexRID._slot, e.what() ) ;
+               try
+               {
+                  _curKeyObj = curKey.toBson() ;
+               }
+               catch ( std::exception &e )
+               {
+                  PD_RC_CHECK ( SDB_SYS, PDERROR,
+                                "Failed to convert from buffer "
+                                "to bson, rid: %d,%d: %s",
+                                _curIndexRID._extent,
+                                _curIndexRID._slot, e.what() ) ;
+               }
+               rc = _listIterator.advance ( _curKeyObj ) ;
             }
-            rc = _listIterator.advance ( _curKeyObj ) ;
             if ( -2 == rc )
             {
                rc = SDB_IXM_EOC ;
@@ -302,6 +313,7 @@ namespace engine
             }
             else if ( rc >= 0 )
             {
+               _matchedKeyData.clear() ;
                lastRID = _curIndexRID ;
                rc = indexExtent.keyAdvance ( _curIndexRID, _curKeyObj, rc,
                                              _listIterator.after(),
@@ -318,6 +330,7 @@ namespace engine
             }
             else
             {
+               _keepKeyData( _matchedKeyData, curKey ) ;
                _savedRID =
                      indexExtent.getRID ( _curIndexRID._slot ) ;
                if ( _savedRID.isNull() ||
@@ -334,9 +347,15 @@ namespace engine
                }*/
                _dupBuffer.insert ( _savedRID ) ;
                rid = _savedRID ;
+               if ( _pReadAhead )
+               {
+                  _pReadAhead->onAccess( _su->index(), _curIndexRID._extent,
+                                         1 ) ;
+               }
                if ( !isReadOnly )
                {
                   _savedObj = _curKeyObj.getOwned() ;
+                  _savedKeyData = _matchedKeyData ;
                }
                else
                {
@@ -388,6 +407,7 @@ namespace engine
          try
          {
             _savedObj = ixmKey(dataBuffer).toBson().copy() ;
+            _keepKeyData( _savedKeyData, ixmKey(dataBuffer) ) ;
          }
          catch ( std::exception &e )
          {
@@ -460,8 +480,7 @@ namespace engine
       {
          try
          {
-            BSONObj curObj = ixmKey(dataBuffer).toBson() ;
-            if ( curObj.shallowEqual(_savedObj) )
+            if ( _isSavedKey( ixmKey(dataBuffer) ) )
             {
                dmsRecordID onDiskRID = indexExtent.getRID (
                      _curIndexRID._slot ) ;
@@ -498,5 +517,15 @@ namespace engine
       goto done ;
    }
 
+   BOOLEAN _rtnIXScanner::_isSavedKey ( const ixmKey &key ) const
+   {
+      // compact keys are compared by bytes, equal keys have the same bytes
+      if ( !_savedKeyData.empty() && key.isCompactFormat() )
+      {
+         return _isSameKey( _savedKeyData, key ) ;
+      }
+      return key.toBson().shallowEqual( _savedObj ) ;
+   }
+
 }
 
@@ -31,9 +31,114 @@
 #include "rtnIxmKeySorter.hpp"
 #include <algorithm>
 #include "ossUtil.h"
+#include "pd.hpp"
+#include "rtnParallelJob.hpp"
+#include <boost/thread.hpp>
 
 namespace engine
 {
+   #define RTN_IXM_SORT_MAX_THREAD              ( 8 )
+   #define RTN_IXM_SORT_MIN_KEYS_PER_THREAD     ( 65536 )
+
+   /*
+      _rtnIxmKeySlot define
+
+      The slots are at the head of the buffer, and the keys at the tail. A
+      slot holds the normalized prefix of the key, and points to the key
+      data, which is followed by the record id.
+   */
+   struct _rtnIxmKeySlot
+   {
+      UINT64   _prefix ;
+      CHAR*    _key ;
+   } ;
+   typedef struct _rtnIxmKeySlot rtnIxmKeySlot ;
+
+   /*
+      _rtnIxmKeySlotComparer define
+
+      Keys are ordered by ( key, rid ), so that the sorted keys can be loaded
+      into the index in order. Most of the keys are told apart by the
+      normalized prefixes without touching the key data.
+   */
+   class _rtnIxmKeySlotComparer
+   {
+   public:
+      _rtnIxmKeySlotComparer( const _dmsIxmKeyComparer& comparer )
+      : _comparer( comparer )
+      {
+      }
+
+      bool operator()( const rtnIxmKeySlot& slot1,
+                       const rtnIxmKeySlot& slot2 ) const
+      {
+         if ( slot1._prefix != slot2._prefix &&
+              0 != slot1._prefix && 0 != slot2._prefix )
+         {
+            return slot1._prefix < slot2._prefix ;
+         }
+
+         ixmKey key1( slot1._key ) ;
+         ixmKey key2( slot2._key ) ;
+         INT32 result = _comparer.compare( key1, key2 ) ;
+         if ( 0 == result )
+         {
+            const dmsRecordID* rid1 =
+               (const dmsRecordID*)( slot1._key + key1.dataSize() ) ;
+            const dmsRecordID* rid2 =
+               (const dmsRecordID*)( slot2._key + key2.dataSize() ) ;
+            result = rid1->compare( *rid2 ) ;
+         }
+         return result < 0 ;
+      }
+
+   private:
+      _dmsIxmKeyComparer _comparer ;
+   } ;
+   typedef class _rtnIxmKeySlotComparer rtnIxmKeySlotComparer ;
+
+   /*
+      _rtnIxmSortTask define
+
+      Sort the slots in [ begin, end ), or merge the sorted [ begin, middle )
+      and [ middle, end ) when the middle is given.
+   */
+   class _rtnIxmSortTask : public rtnParallelTask
+   {
+   public:
+      _rtnIxmSortTask()
+      : _begin( NULL ), _middle( NULL ), _end( NULL ), _comparer( NULL )
+      {
+      }
+
+      void set( rtnIxmKeySlot* begin, rtnIxmKeySlot* middle,
+                rtnIxmKeySlot* end, const rtnIxmKeySlotComparer* comparer )
+      {
+         _begin = begin ;
+         _middle = middle ;
+         _end = end ;
+         _comparer = comparer ;
+      }
+
+      virtual void run()
+      {
+         if ( NULL == _middle )
+         {
+            std::sort( _begin, _end, *_comparer ) ;
+         }
+         else
+         {
+            std::inplace_merge( _begin, _middle, _end, *_comparer ) ;
+         }
+      }
+
+   private:
+      rtnIxmKeySlot*                _begin ;
+      rtnIxmKeySlot*                _middle ;
+      rtnIxmKeySlot*                _end ;
+      const rtnIxmKeySlotComparer*  _comparer ;
+   } ;
+
    _rtnIxmKeySorter::_rtnIxmKeySorter( INT64 bufSize, const _dmsIxmKeyComparer& comparer )
    : _dmsIxmKeySorter( bufSize, comparer )
    {
@@ -95,12 +200,12 @@ namespace engine
       INT32 rc = SDB_OK ;
       CHAR* keyPosition ;
       dmsRecordID* rid ;
-      CHAR** keySlot ;
+      rtnIxmKeySlot* keySlot ;
 
       SDB_ASSERT( _inited, "must be inited before pushing" ) ;
       SDB_ASSERT( !_sorted, "already sorted, can't push" ) ;
 
-      if ( (INT64)( keyDataSize + sizeof(dmsRecordID) + sizeof(ixmKey*) ) >
+      if ( (INT64)( keyDataSize + sizeof(dmsRecordID) + sizeof(rtnIxmKeySlot) ) >
            _tailOffset - _headOffset )
       {
          rc = SDB_DMS_EOC ;
@@ -115,9 +220,10 @@ namespace engine
       rid = (dmsRecordID*)( keyPosition + keyDataSize ) ;
       *rid = recordID ;
 
-      keySlot = (CHAR**)( _buf + _headOffset ) ;
-      *keySlot = keyPosition ;
-      _headOffset += sizeof(ixmKey*) ;
+      keySlot = (rtnIxmKeySlot*)( _buf + _headOffset ) ;
+      keySlot->_prefix = key.normalizedPrefix( _comparer.getOrder() ) ;
+      keySlot->_key = keyPosition ;
+      _headOffset += sizeof(rtnIxmKeySlot) ;
 
       _keyNum++ ;
 
@@ -134,15 +240,89 @@ namespace engine
 
       if ( _keyNum > 0 )
       {
-         CHAR** keyStart = (CHAR**)_buf ;
-         CHAR** keyEnd = (CHAR**)( _buf + _keyNum * sizeof(ixmKey*) ) ;
-         std::sort( keyStart, keyEnd, _comparer ) ;
+         rtnIxmKeySlot* keyStart = (rtnIxmKeySlot*)_buf ;
+         rtnIxmKeySlot* keyEnd = keyStart + _keyNum ;
+         rtnIxmKeySlotComparer comparer( _comparer ) ;
+         UINT32 threadNum = _sortThreadNum() ;
+
+         if ( threadNum > 1 )
+         {
+            _parallelSort( keyStart, threadNum ) ;
+         }
+         else
+         {
+            std::sort( keyStart, keyEnd, comparer ) ;
+         }
       }
 
       _sorted = TRUE ;
       return SDB_OK ;
    }
 
+   UINT32 _rtnIxmKeySorter::_sortThreadNum() const
+   {
+      UINT32 threadNum = boost::thread::hardware_concurrency() ;
+      UINT64 maxNum = _keyNum / RTN_IXM_SORT_MIN_KEYS_PER_THREAD ;
+
+      if ( threadNum > RTN_IXM_SORT_MAX_THREAD )
+      {
+         threadNum = RTN_IXM_SORT_MAX_THREAD ;
+      }
+      if ( (UINT64)threadNum > maxNum )
+      {
+         threadNum = (UINT32)maxNum ;
+      }
+      return threadNum > 0 ? threadNum : 1 ;
+   }
+
+   void _rtnIxmKeySorter::_parallelSort( rtnIxmKeySlot* keyStart,
+                                         UINT32 threadNum )
+   {
+      rtnIxmKeySlot* bounds[ RTN_IXM_SORT_MAX_THREAD + 1 ] ;
+      _rtnIxmSortTask tasks[ RTN_IXM_SORT_MAX_THREAD ] ;
+      rtnIxmKeySlotComparer comparer( _comparer ) ;
+      rtnParallelRunner runner ;
+      UINT32 step = 1 ;
+
+      SDB_ASSERT( threadNum > 1 && threadNum <= RTN_IXM_SORT_MAX_THREAD,
+                  "invalid thread number" ) ;
+
+      for ( UINT32 i = 0 ; i <= threadNum ; ++i )
+      {
+         bounds[ i ] = keyStart + _keyNum * i / threadNum ;
+      }
+
+      // sort the runs concurrently, the first run is sorted by the current
+      // thread, and the others by the parallel jobs, or by the current
+      // thread as well when no job is available
+      for ( UINT32 i = 1 ; i < threadNum ; ++i )
+      {
+         tasks[ i ].set( bounds[ i ], NULL, bounds[ i + 1 ], &comparer ) ;
+         runner.run( &tasks[ i ] ) ;
+      }
+      tasks[ 0 ].set( bounds[ 0 ], NULL, bounds[ 1 ], &comparer ) ;
+      tasks[ 0 ].run() ;
+      runner.wait() ;
+
+      // merge the neighbouring runs pair by pair, the pairs of the same pass
+      // are merged concurrently
+      for ( step = 1 ; step < threadNum ; step *= 2 )
+      {
+         for ( UINT32 i = 2 * step ; i + step < threadNum ; i += 2 * step )
+         {
+            UINT32 end = OSS_MIN( i + 2 * step, threadNum ) ;
+            tasks[ i ].set( bounds[ i ], bounds[ i + step ], bounds[ end ],
+                            &comparer ) ;
+            runner.run( &tasks[ i ] ) ;
+         }
+         tasks[ 0 ].set( bounds[ 0 ], bounds[ step ],
+                         bounds[ OSS_MIN( 2 * step, threadNum ) ],
+                         &comparer ) ;
+         tasks[ 0 ].run() ;
+         runner.wait() ;
+      }
+   }
+
    INT32 _rtnIxmKeySorter::fetch( ixmKey& key, dmsRecordID& recordID )
    {
       INT32 rc = SDB_OK ;
@@ -151,7 +331,7 @@ namespace engine
 
       if( _fetchedNum < _keyNum )
       {
-         CHAR* keyData = *(CHAR**)( _buf + sizeof(ixmKey*) * _fetchedNum ) ;
+         CHAR* keyData = ((rtnIxmKeySlot*)_buf)[ _fetchedNum ]._key ;
          key.assign( ixmKey( keyData ) );
          recordID = *(dmsRecordID*)( keyData + key.dataSize() ) ;
          _fetchedNum++ ;
@@ -743,6 +743,8 @@ namespace engine
       SINT64 readSize = 0 ;
       INT32 pageSize =  _su->getLobPageSize() ;
       UINT32 needLen = 0 ;
+      dmsLobRecord record ;
+      DMS_LOB_READ_PIECES pieces ;
       _getPool().clear() ;
 
       for ( RTN_LOB_TUPLES::const_iterator itr = tuples.begin() ;
@@ -759,29 +761,53 @@ namespace engine
          goto error ;
       }
 
-      for ( RTN_LOB_TUPLES::const_iterator iter = tuples.begin() ;
-            iter != tuples.end() ;
-            ++iter )
+      try
       {
-         const _rtnLobTuple& t = *iter ;
-
-         if ( NULL != piecesInfo &&
-              !piecesInfo->hasPiece( t.tuple.columns.sequence ) )
-         {
-            ossMemset( buf + readSize, 0, t.tuple.columns.len ) ;
-         }
-         else
+         pieces.reserve( tuples.size() ) ;
+         for ( RTN_LOB_TUPLES::const_iterator iter = tuples.begin() ;
+               iter != tuples.end() ;
+               ++iter )
          {
-            rc = _read( t, cb, buf + readSize ) ;
-            if ( SDB_OK != rc )
+            const _rtnLobTuple& t = *iter ;
+
+            if ( NULL != piecesInfo &&
+                 !piecesInfo->hasPiece( t.tuple.columns.sequence ) )
             {
-               goto error ;
+               ossMemset( buf + readSize, 0, t.tuple.columns.len ) ;
             }
+            else
+            {
+               record.set( &getOID(),
+                           t.tuple.columns.sequence,
+                           t.tuple.columns.offset,
+                           t.tuple.columns.len,
+                           NULL ) ;
+               pieces.push_back( dmsLobReadPiece( record, buf + readSize ) ) ;
+            }
+            readSize += t.tuple.columns.len ;
          }
-         readSize += t.tuple.columns.len ;
+      }
+      catch ( std::exception &e )
+      {
+         PD_LOG( PDERROR, "Occur exception: %s", e.what() ) ;
+         rc = SDB_OOM ;
+         goto error ;
       }
 
       SDB_ASSERT( readSize == needLen, "impossible" ) ;
+
+      // read the pages of the window in one batch, so that the pages which
+      // are not cached are submitted to the file together
+      if ( !pieces.empty() )
+      {
+         rc = _su->lob()->readv( pieces, _mbContext, cb ) ;
+         if ( SDB_OK != rc )
+         {
+            PD_LOG( PDERROR, "failed to read %u pieces of lob[%s], rc:%d",
+                    pieces.size(), getOID().str().c_str(), rc ) ;
+            goto error ;
+         }
+      }
       rc = _getPool().push( buf, readSize,
                             RTN_LOB_GET_OFFSET_OF_LOB(
                                 pageSize,
@@ -802,34 +828,6 @@ namespace engine
       goto done ;
    }
 
-   INT32 _rtnLocalLobStream::_read( const _rtnLobTuple &tuple,
-                                    _pmdEDUCB *cb,
-                                    CHAR *buf )
-   {
-      INT32 rc = SDB_OK ;
-      UINT32 len = 0 ;
-      dmsLobRecord record ;
-      record.set( &getOID(),
-                  tuple.tuple.columns.sequence,
-                  tuple.tuple.columns.offset,
-                  tuple.tuple.columns.len,
-                  tuple.data ) ;
-      rc = _su->lob()->read( record, _mbContext, cb,
-                             buf, len ) ;
-      if ( SDB_OK != rc )
-      {
-         PD_LOG( PDERROR, "failed to read lob[%s], sequence[%d], rc:%d",
-                 record._oid->str().c_str(), record._sequence, rc ) ;
-         goto error ;
-      }
-
-      SDB_ASSERT( len == record._dataLen, "impossible" ) ;
-   done:
-      return rc ;
-   error:
-      goto done ;
-   }
-
    // PD_TRACE_DECLARE_FUNCTION ( SDB_RTNLOCALLOBSTREAM__ROLLBACK, "_rtnLocalLobStream::_rooback" )
    INT32 _rtnLocalLobStream::_rollback( _pmdEDUCB *cb )
    {
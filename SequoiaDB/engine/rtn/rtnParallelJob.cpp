@@ -0,0 +1,156 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = rtnParallelJob.cpp
+
+   Descriptive Name = Runtime Parallel Job
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of runtime component. This file contains the background job
+   which runs a piece of an operation split for several EDUs.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#include "rtnParallelJob.hpp"
+#include "ossAtomic.hpp"
+#include "pd.hpp"
+
+namespace engine
+{
+   // the parallel jobs running in the node
+   static ossAtomic32 s_parallelJobNum( 0 ) ;
+
+   /*
+      _rtnParallelRunner implement
+   */
+   _rtnParallelRunner::_rtnParallelRunner ()
+   :_runningNum( 0 )
+   {
+      _event.signalAll() ;
+   }
+
+   _rtnParallelRunner::~_rtnParallelRunner ()
+   {
+      wait() ;
+   }
+
+   void _rtnParallelRunner::run ( rtnParallelTask *pTask )
+   {
+      INT32 rc = SDB_OK ;
+      rtnParallelJob *pJob = NULL ;
+
+      if ( s_parallelJobNum.inc() >= RTN_PARALLEL_MAX_JOB_NUM )
+      {
+         goto runself ;
+      }
+
+      pJob = SDB_OSS_NEW rtnParallelJob( this, pTask ) ;
+      if ( NULL == pJob )
+      {
+         goto runself ;
+      }
+
+      _latch.get() ;
+      if ( 0 == _runningNum++ )
+      {
+         _event.reset() ;
+      }
+      _latch.release() ;
+
+      // the job is deleted when it's not started
+      rc = rtnGetJobMgr()->startJob( pJob, RTN_JOB_MUTEX_NONE, NULL ) ;
+      if ( rc )
+      {
+         PD_LOG( PDINFO, "Failed to start parallel job, rc: %d", rc ) ;
+         _onJobEnd() ;
+         goto runself ;
+      }
+
+   done:
+      return ;
+   runself:
+      s_parallelJobNum.dec() ;
+      pTask->run() ;
+      goto done ;
+   }
+
+   void _rtnParallelRunner::wait ()
+   {
+      // the tasks don't wait for anything, they always end
+      _event.wait() ;
+   }
+
+   void _rtnParallelRunner::_onJobEnd ()
+   {
+      _latch.get() ;
+      if ( 0 == --_runningNum )
+      {
+         _event.signalAll() ;
+      }
+      _latch.release() ;
+   }
+
+   /*
+      _rtnParallelJob implement
+   */
+   _rtnParallelJob::_rtnParallelJob ( rtnParallelRunner *pRunner,
+                                      rtnParallelTask *pTask )
+   {
+      _pRunner = pRunner ;
+      _pTask = pTask ;
+   }
+
+   _rtnParallelJob::~_rtnParallelJob ()
+   {
+      _pRunner = NULL ;
+      _pTask = NULL ;
+   }
+
+   RTN_JOB_TYPE _rtnParallelJob::type () const
+   {
+      return RTN_JOB_PARALLEL ;
+   }
+
+   const CHAR* _rtnParallelJob::name () const
+   {
+      return "Parallel" ;
+   }
+
+   BOOLEAN _rtnParallelJob::muteXOn ( const _rtnBaseJob *pOther )
+   {
+      return FALSE ;
+   }
+
+   INT32 _rtnParallelJob::doit ()
+   {
+      _pTask->run() ;
+      s_parallelJobNum.dec() ;
+      // the runner may be gone once it's told
+      _pRunner->_onJobEnd() ;
+      return SDB_OK ;
+   }
+}
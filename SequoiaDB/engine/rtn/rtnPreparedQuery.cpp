@@ -0,0 +1,597 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = rtnPreparedQuery.cpp
+
+   Descriptive Name = Runtime Prepared Query
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of runtime component. This file contains functions to bind the
+   parameters of the prepared queries, and to cache the shapes of them.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#include "rtnPreparedQuery.hpp"
+#include "rtnQueryOptions.hpp"
+#include "msgDef.h"
+#include "ossUtil.hpp"
+#include "pd.hpp"
+#include "pdTrace.hpp"
+#include "rtnTrace.hpp"
+
+namespace engine
+{
+
+   BOOLEAN rtnIsPreparedSlot ( const BSONElement &e, INT32 &index )
+   {
+      if ( Object == e.type() )
+      {
+         BSONObj obj = e.embeddedObject() ;
+         if ( 1 == obj.nFields() )
+         {
+            BSONElement first = obj.firstElement() ;
+            if ( first.isNumber() &&
+                 0 == ossStrcmp( first.fieldName(), FIELD_NAME_PARAM ) )
+            {
+               index = first.numberInt() ;
+               return TRUE ;
+            }
+         }
+      }
+      return FALSE ;
+   }
+
+   // the value of an Object or Array slot may hold operators ( e.g.
+   // { $gt : 5 } ), whose structure is a part of the plan, so they are
+   // never bound to a learned shape
+   static OSS_INLINE BOOLEAN _rtnIsBindableSlotType ( INT8 type )
+   {
+      return Object != type && Array != type ;
+   }
+
+   /*
+      _rtnPreparedShape implement
+   */
+   _rtnPreparedShape::_rtnPreparedShape ()
+   :_refCount( 0 ), _state( RTN_PREPARED_UNKNOWN )
+   {
+      _hash = 0 ;
+      _sign = 0 ;
+      _slotNum = 0 ;
+      _paramNum = 0 ;
+      ossMemset( _slotTypes, 0, sizeof( _slotTypes ) ) ;
+      ossMemset( _paramSlots, 0, sizeof( _paramSlots ) ) ;
+   }
+
+   _rtnPreparedShape::~_rtnPreparedShape ()
+   {
+   }
+
+   INT32 _rtnPreparedShape::init ( const BSONObj &shape, UINT32 hash )
+   {
+      INT32 rc = SDB_OK ;
+
+      try
+      {
+         _shape = shape.getOwned() ;
+         _hash = hash ;
+      }
+      catch( std::exception &e )
+      {
+         PD_LOG( PDERROR, "Failed to copy the shape of prepared query, "
+                 "occur exception: %s", e.what() ) ;
+         rc = SDB_OOM ;
+      }
+
+      return rc ;
+   }
+
+   BOOLEAN _rtnPreparedShape::isSame ( const BSONObj &shape ) const
+   {
+      return shape.objsize() == _shape.objsize() &&
+             0 == ossMemcmp( shape.objdata(), _shape.objdata(),
+                             _shape.objsize() ) ;
+   }
+
+   void _rtnPreparedShape::setLearned ( UINT32 sign,
+                                        const _rtnPreparedBinding &binding,
+                                        const BSONObj &normalizedQuery,
+                                        const INT8 *paramSlots,
+                                        UINT32 paramNum,
+                                        const BSONObj &constParams )
+   {
+      SDB_ASSERT( paramNum <= RTN_MAX_PARAM_NUM, "Param num is invalid" ) ;
+
+      for ( UINT32 i = 0 ; i < binding.getSlotNum() ; ++i )
+      {
+         if ( !_rtnIsBindableSlotType( binding.getSlotType( i ) ) )
+         {
+            setUnlearnable() ;
+            return ;
+         }
+      }
+
+      _latch.get() ;
+      if ( RTN_PREPARED_UNKNOWN == _state.peek() )
+      {
+         try
+         {
+            _normalizedQuery = normalizedQuery.getOwned() ;
+            _constParams = constParams.getOwned() ;
+            _sign = sign ;
+            _slotNum = binding.getSlotNum() ;
+            for ( UINT32 i = 0 ; i < _slotNum ; ++i )
+            {
+               _slotTypes[ i ] = binding.getSlotType( i ) ;
+            }
+            _paramNum = paramNum ;
+            ossMemcpy( _paramSlots, paramSlots, paramNum ) ;
+            _state.poke( RTN_PREPARED_LEARNED ) ;
+         }
+         catch( std::exception &e )
+         {
+            PD_LOG( PDWARNING, "Failed to learn the shape of prepared "
+                    "query, occur exception: %s", e.what() ) ;
+            _state.poke( RTN_PREPARED_UNLEARNABLE ) ;
+         }
+      }
+      _latch.release() ;
+   }
+
+   void _rtnPreparedShape::setUnlearnable ()
+   {
+      _latch.get() ;
+      if ( RTN_PREPARED_UNKNOWN == _state.peek() )
+      {
+         PD_LOG( PDDEBUG, "The shape of prepared query[%s] is not learnable",
+                 _shape.toString( FALSE, TRUE ).c_str() ) ;
+         _state.poke( RTN_PREPARED_UNLEARNABLE ) ;
+      }
+      _latch.release() ;
+   }
+
+   BOOLEAN _rtnPreparedShape::canBind ( UINT32 sign,
+                                        const _rtnPreparedBinding &binding )
+                                        const
+   {
+      if ( RTN_PREPARED_LEARNED != _state.peek() ||
+           sign != _sign ||
+           binding.getSlotNum() != _slotNum )
+      {
+         return FALSE ;
+      }
+      // the types decide the parameterization and the canonical types in
+      // the normalized query
+      for ( UINT32 i = 0 ; i < _slotNum ; ++i )
+      {
+         if ( binding.getSlotType( i ) != _slotTypes[ i ] ||
+              !_rtnIsBindableSlotType( _slotTypes[ i ] ) )
+         {
+            return FALSE ;
+         }
+      }
+      return TRUE ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__RTNPREPAREDSHAPE_BINDPARAMS, "_rtnPreparedShape::bindParams" )
+   INT32 _rtnPreparedShape::bindParams ( const BSONObj &query,
+                                         const _rtnPreparedBinding &binding,
+                                         rtnParamList &parameters ) const
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB__RTNPREPAREDSHAPE_BINDPARAMS ) ;
+      BSONObjIterator constItr( _constParams ) ;
+      BSONElement param ;
+
+      SDB_ASSERT( RTN_PREPARED_LEARNED == _state.peek(),
+                  "Shape should be learned" ) ;
+
+      parameters.clearParams() ;
+      for ( UINT32 i = 0 ; i < _paramNum ; ++i )
+      {
+         if ( _paramSlots[ i ] >= 0 )
+         {
+            param = BSONElement( query.objdata() +
+                                 binding.getSlotOffset( _paramSlots[ i ] ) ) ;
+         }
+         else
+         {
+            PD_CHECK( constItr.more(), SDB_SYS, error, PDERROR,
+                      "Constant parameters of the shape are not enough" ) ;
+            param = constItr.next() ;
+         }
+
+         PD_CHECK( -1 != parameters.addParam( param ), SDB_SYS, error,
+                   PDERROR, "Failed to add parameter[%u]", i ) ;
+      }
+
+   done:
+      PD_TRACE_EXITRC( SDB__RTNPREPAREDSHAPE_BINDPARAMS, rc ) ;
+      return rc ;
+   error:
+      parameters.clearParams() ;
+      goto done ;
+   }
+
+   /*
+      _rtnPreparedShapeMgr implement
+   */
+   _rtnPreparedShapeMgr::_rtnPreparedShapeMgr ()
+   :_shapeNum( 0 )
+   {
+   }
+
+   _rtnPreparedShapeMgr::~_rtnPreparedShapeMgr ()
+   {
+      MAP_SHAPE::iterator it ;
+      for ( it = _shapes.begin() ; it != _shapes.end() ; ++it )
+      {
+         SDB_OSS_DEL it->second ;
+      }
+      _shapes.clear() ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__RTNPREPAREDSHAPEMGR_ACQUIRE, "_rtnPreparedShapeMgr::acquire" )
+   INT32 _rtnPreparedShapeMgr::acquire ( const BSONObj &shape,
+                                         rtnPreparedShape **ppShape )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB__RTNPREPAREDSHAPEMGR_ACQUIRE ) ;
+      UINT32 hash = ossHash( shape.objdata(), shape.objsize() ) ;
+      rtnPreparedShape *pShape = NULL ;
+      MAP_SHAPE::iterator it ;
+
+      *ppShape = NULL ;
+
+      _latch.get_shared() ;
+      it = _shapes.find( hash ) ;
+      if ( it != _shapes.end() && it->second->isSame( shape ) )
+      {
+         it->second->incRef() ;
+         *ppShape = it->second ;
+      }
+      _latch.release_shared() ;
+
+      if ( *ppShape || it != _shapes.end() )
+      {
+         // found, or another shape with the same hash is cached, the
+         // binding goes on without the cache then
+         goto done ;
+      }
+
+      pShape = SDB_OSS_NEW rtnPreparedShape() ;
+      PD_CHECK( pShape, SDB_OOM, error, PDERROR,
+                "Failed to alloc shape of prepared query" ) ;
+      rc = pShape->init( shape, hash ) ;
+      PD_RC_CHECK( rc, PDERROR, "Failed to init shape of prepared query, "
+                   "rc: %d", rc ) ;
+
+      _latch.get() ;
+      it = _shapes.find( hash ) ;
+      if ( it != _shapes.end() )
+      {
+         // added by another session
+         if ( it->second->isSame( shape ) )
+         {
+            it->second->incRef() ;
+            *ppShape = it->second ;
+         }
+      }
+      else
+      {
+         if ( _shapes.size() >= RTN_PREPARED_MAX_SHAPE_NUM )
+         {
+            _evictOne() ;
+         }
+         if ( _shapes.size() < RTN_PREPARED_MAX_SHAPE_NUM )
+         {
+            pShape->incRef() ;
+            _shapes[ hash ] = pShape ;
+            _shapeNum.inc() ;
+            *ppShape = pShape ;
+            pShape = NULL ;
+         }
+      }
+      _latch.release() ;
+
+   done:
+      if ( pShape )
+      {
+         SDB_OSS_DEL pShape ;
+      }
+      PD_TRACE_EXITRC( SDB__RTNPREPAREDSHAPEMGR_ACQUIRE, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   void _rtnPreparedShapeMgr::release ( rtnPreparedShape *pShape )
+   {
+      // the shape is deleted by the manager only, when it is evicted
+      // without reference
+      pShape->decRef() ;
+   }
+
+   void _rtnPreparedShapeMgr::_evictOne ()
+   {
+      MAP_SHAPE::iterator it ;
+      for ( it = _shapes.begin() ; it != _shapes.end() ; ++it )
+      {
+         if ( 0 == it->second->getRef() )
+         {
+            SDB_OSS_DEL it->second ;
+            _shapes.erase( it ) ;
+            _shapeNum.dec() ;
+            break ;
+         }
+      }
+   }
+
+   rtnPreparedShapeMgr* rtnGetPreparedShapeMgr()
+   {
+      static rtnPreparedShapeMgr s_shapeMgr ;
+      return &s_shapeMgr ;
+   }
+
+   /*
+      _rtnPreparedBinding implement
+   */
+   _rtnPreparedBinding::_rtnPreparedBinding ()
+   {
+      _pShape = NULL ;
+      _slotNum = 0 ;
+   }
+
+   _rtnPreparedBinding::~_rtnPreparedBinding ()
+   {
+      _releaseShape() ;
+   }
+
+   void _rtnPreparedBinding::_releaseShape ()
+   {
+      if ( _pShape )
+      {
+         rtnGetPreparedShapeMgr()->release( _pShape ) ;
+         _pShape = NULL ;
+      }
+   }
+
+   INT32 _rtnPreparedBinding::findSlot ( INT32 offset ) const
+   {
+      for ( UINT32 i = 0 ; i < _slotNum ; ++i )
+      {
+         if ( _slotOffsets[ i ] == offset )
+         {
+            return (INT32)i ;
+         }
+      }
+      return -1 ;
+   }
+
+   INT32 _rtnPreparedBinding::_bindObj ( const BSONObj &shape,
+                                         BSONObjBuilder &builder,
+                                         const BSONElement *values,
+                                         UINT32 valueNum )
+   {
+      INT32 rc = SDB_OK ;
+      INT32 index = 0 ;
+      BSONObjIterator itr( shape ) ;
+
+      while ( itr.more() )
+      {
+         BSONElement e = itr.next() ;
+
+         if ( rtnIsPreparedSlot( e, index ) )
+         {
+            PD_CHECK( index >= 0 && (UINT32)index < valueNum,
+                      SDB_INVALIDARG, error, PDERROR,
+                      "Parameter[%d] of prepared query is not given, "
+                      "parameter num: %u", index, valueNum ) ;
+            PD_CHECK( _slotNum < RTN_PREPARED_MAX_SLOT_NUM,
+                      SDB_INVALIDARG, error, PDERROR,
+                      "Prepared query has more than %d slots",
+                      RTN_PREPARED_MAX_SLOT_NUM ) ;
+            builder.appendAs( values[ index ], e.fieldName() ) ;
+            _slotTypes[ _slotNum ] = (INT8)values[ index ].type() ;
+            ++_slotNum ;
+         }
+         else if ( Object == e.type() )
+         {
+            BSONObjBuilder sub( builder.subobjStart( e.fieldName() ) ) ;
+            rc = _bindObj( e.embeddedObject(), sub, values, valueNum ) ;
+            if ( rc )
+            {
+               goto error ;
+            }
+            sub.done() ;
+         }
+         else if ( Array == e.type() )
+         {
+            BSONObjBuilder sub( builder.subarrayStart( e.fieldName() ) ) ;
+            rc = _bindObj( e.embeddedObject(), sub, values, valueNum ) ;
+            if ( rc )
+            {
+               goto error ;
+            }
+            sub.done() ;
+         }
+         else
+         {
+            builder.append( e ) ;
+         }
+      }
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   void _rtnPreparedBinding::_locateSlots ( const BSONObj &shape,
+                                            const BSONObj &bound,
+                                            const CHAR *pBase,
+                                            UINT32 &slot )
+   {
+      INT32 index = 0 ;
+      BSONObjIterator shapeItr( shape ) ;
+      BSONObjIterator boundItr( bound ) ;
+
+      while ( shapeItr.more() && boundItr.more() )
+      {
+         BSONElement s = shapeItr.next() ;
+         BSONElement b = boundItr.next() ;
+
+         if ( rtnIsPreparedSlot( s, index ) )
+         {
+            _slotOffsets[ slot++ ] = (INT32)( b.rawdata() - pBase ) ;
+         }
+         else if ( Object == s.type() || Array == s.type() )
+         {
+            _locateSlots( s.embeddedObject(), b.embeddedObject(), pBase,
+                          slot ) ;
+         }
+      }
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__RTNPREPAREDBINDING_BIND, "_rtnPreparedBinding::bind" )
+   INT32 _rtnPreparedBinding::bind ( const BSONObj &shape,
+                                     const BSONObj &hint,
+                                     BSONObj &query,
+                                     BSONObj &newHint )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB__RTNPREPAREDBINDING_BIND ) ;
+      BSONElement values[ RTN_PREPARED_MAX_SLOT_NUM ] ;
+      UINT32 valueNum = 0 ;
+      UINT32 slot = 0 ;
+      BSONObj boundQuery ;
+      BSONObj boundHint ;
+
+      _slotNum = 0 ;
+
+      try
+      {
+         BSONObjBuilder hintBuilder ;
+         BSONObjBuilder queryBuilder ;
+         BSONObjIterator itr( hint ) ;
+
+         while ( itr.more() )
+         {
+            BSONElement e = itr.next() ;
+            if ( 0 != ossStrcmp( e.fieldName(),
+                                 FIELD_NAME_PREPARED_PARAMS ) )
+            {
+               hintBuilder.append( e ) ;
+               continue ;
+            }
+
+            PD_CHECK( Array == e.type(), SDB_INVALIDARG, error, PDERROR,
+                      "Field[%s] of prepared query should be array",
+                      FIELD_NAME_PREPARED_PARAMS ) ;
+            BSONObjIterator paramItr( e.embeddedObject() ) ;
+            while ( paramItr.more() )
+            {
+               PD_CHECK( valueNum < RTN_PREPARED_MAX_SLOT_NUM,
+                         SDB_INVALIDARG, error, PDERROR,
+                         "Prepared query has more than %d parameters",
+                         RTN_PREPARED_MAX_SLOT_NUM ) ;
+               values[ valueNum++ ] = paramItr.next() ;
+            }
+         }
+         boundHint = hintBuilder.obj() ;
+
+         rc = _bindObj( shape, queryBuilder, values, valueNum ) ;
+         if ( rc )
+         {
+            goto error ;
+         }
+         boundQuery = queryBuilder.obj() ;
+
+         _locateSlots( shape, boundQuery, boundQuery.objdata(), slot ) ;
+         SDB_ASSERT( slot == _slotNum, "Slots are not located" ) ;
+      }
+      catch( std::exception &e )
+      {
+         PD_LOG( PDERROR, "Failed to bind prepared query[%s], occur "
+                 "exception: %s", shape.toString( FALSE, TRUE ).c_str(),
+                 e.what() ) ;
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+
+      query = boundQuery ;
+      newHint = boundHint ;
+
+   done:
+      PD_TRACE_EXITRC( SDB__RTNPREPAREDBINDING_BIND, rc ) ;
+      return rc ;
+   error:
+      _slotNum = 0 ;
+      goto done ;
+   }
+
+   // PD_TRACE_DECLARE_FUNCTION ( SDB__RTNPREPAREDBINDING_BIND_OPTIONS, "_rtnPreparedBinding::bind" )
+   INT32 _rtnPreparedBinding::bind ( _rtnQueryOptions &options )
+   {
+      INT32 rc = SDB_OK ;
+      PD_TRACE_ENTRY( SDB__RTNPREPAREDBINDING_BIND_OPTIONS ) ;
+      BSONObj query ;
+      BSONObj hint ;
+
+      PD_CHECK( !options.testFlag( FLG_QUERY_MODIFY ), SDB_INVALIDARG,
+                error, PDERROR, "Query and modify can't be prepared" ) ;
+
+      _releaseShape() ;
+
+      rc = bind( options.getQuery(), options.getHint(), query, hint ) ;
+      if ( rc )
+      {
+         goto error ;
+      }
+
+      if ( _slotNum > 0 )
+      {
+         rc = rtnGetPreparedShapeMgr()->acquire( options.getQuery(),
+                                                 &_pShape ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to acquire shape of prepared "
+                      "query, rc: %d", rc ) ;
+      }
+
+      options.setQuery( query ) ;
+      options.setHint( hint ) ;
+      options.clearFlag( FLG_QUERY_PREPARED ) ;
+      options.setPreparedBinding( _pShape ? this : NULL ) ;
+
+   done:
+      PD_TRACE_EXITRC( SDB__RTNPREPAREDBINDING_BIND_OPTIONS, rc ) ;
+      return rc ;
+   error:
+      goto done ;
+   }
+
+}
+
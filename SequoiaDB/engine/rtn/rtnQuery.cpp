@@ -47,6 +47,7 @@
 #include "rtnContextExplain.hpp"
 #include "rtnContextTS.hpp"
 #include "rtnQueryModifier.hpp"
+#include "rtnPreparedQuery.hpp"
 
 using namespace bson ;
 
@@ -536,8 +537,9 @@ namespace engine
       optAccessPlanRuntime *planRuntime = NULL ;
       rtnQueryModifier *queryModifier = NULL ;
       BOOLEAN writable = FALSE ;
+      rtnPreparedBinding preparedBinding ;
 
-      BSONObj hintTmp = options.getHint() ;
+      BSONObj hintTmp ;
       BSONObj blockObj, emptyObj ;
       BSONObj *pBlockObj = NULL ;
       const CHAR *indexName = NULL ;
@@ -547,6 +549,14 @@ namespace engine
       rtnQueryType queryType = RTN_QUERY_NORMAL ;
       rtnRemoteMessenger* messenger = rtnCB->getRemoteMessenger() ;
 
+      if ( options.testFlag( FLG_QUERY_PREPARED ) )
+      {
+         rc = preparedBinding.bind( options ) ;
+         PD_RC_CHECK( rc, PDERROR, "Failed to bind prepared query, rc: %d",
+                      rc ) ;
+      }
+      hintTmp = options.getHint() ;
+
       if ( messenger && messenger->isReady() )
       {
          rc = _getQueryType( options.getQuery(), queryType ) ;
@@ -758,6 +768,10 @@ namespace engine
       }
 
    done :
+      if ( options.getPreparedBinding() == &preparedBinding )
+      {
+         options.setPreparedBinding( NULL ) ;
+      }
       PD_TRACE_EXITRC ( SDB_RTNQUERY_OPTIONS, rc ) ;
       return rc ;
    error :
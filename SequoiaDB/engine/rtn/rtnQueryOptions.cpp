@@ -121,7 +121,8 @@ namespace engine
      _fullName( NULL ),
      _fullNameBuf( NULL ),
      _mainCLName( NULL ),
-     _mainCLNameBuf( NULL )
+     _mainCLNameBuf( NULL ),
+     _preparedBinding( NULL )
    {
    }
 
@@ -140,7 +141,8 @@ namespace engine
      _fullName( fullName ),
      _fullNameBuf( NULL ),
      _mainCLName( NULL ),
-     _mainCLNameBuf( NULL )
+     _mainCLNameBuf( NULL ),
+     _preparedBinding( NULL )
    {
    }
 
@@ -159,7 +161,8 @@ namespace engine
      _fullName( fullName ),
      _fullNameBuf( NULL ),
      _mainCLName( NULL ),
-     _mainCLNameBuf( NULL )
+     _mainCLNameBuf( NULL ),
+     _preparedBinding( NULL )
    {
    }
 
@@ -171,7 +174,8 @@ namespace engine
      _fullName( o._fullName ),
      _fullNameBuf( NULL ),
      _mainCLName( o._mainCLName ),
-     _mainCLNameBuf( NULL )
+     _mainCLNameBuf( NULL ),
+     _preparedBinding( o._preparedBinding )
    {
    }
 
@@ -216,6 +220,8 @@ namespace engine
       _query = _query.getOwned() ;
       _orderBy = _orderBy.getOwned() ;
       _hint = _hint.getOwned() ;
+      // the binding lives with the request only
+      _preparedBinding = NULL ;
 
    done:
       return rc ;
@@ -271,6 +277,7 @@ namespace engine
       SAFE_OSS_FREE( _fullNameBuf ) ;
       _mainCLName = o._mainCLName ;
       SAFE_OSS_FREE( _mainCLNameBuf ) ;
+      _preparedBinding = o._preparedBinding ;
 
       return *this ;
    }
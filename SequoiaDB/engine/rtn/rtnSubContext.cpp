@@ -36,6 +36,8 @@
 
 *******************************************************************************/
 #include "rtnSubContext.hpp"
+#include "ixmKey.hpp"
+#include "../bson/ordering.h"
 #include "pdTrace.hpp"
 #include "rtnTrace.hpp"
 
@@ -56,19 +58,32 @@ namespace engine
 
    // PD_TRACE_DECLARE_FUNCTION ( SDB_RTNORDERKEY_OPLT, "_rtnOrderKey::operator<" )
    BOOLEAN _rtnOrderKey::operator<( const _rtnOrderKey &rhs ) const
-   {
+   {
       PD_TRACE_ENTRY ( SDB_RTNORDERKEY_OPLT ) ;
-      BOOLEAN result = FALSE ;
-      INT32 rsCmp = _keyObj.woCompare( rhs._keyObj, _orderBy, FALSE ) ;
-      if ( rsCmp < 0
-         || ( 0 == rsCmp && _hash.hash < rhs._hash.hash ))
-      {
-         result = TRUE ;
-      }
+      BOOLEAN result = compare( rhs ) < 0 ? TRUE : FALSE ;
       PD_TRACE1 ( SDB_RTNORDERKEY_OPLT, PD_PACK_INT(result) );
       PD_TRACE_EXIT ( SDB_RTNORDERKEY_OPLT ) ;
-      return result;
-   }
+      return result;
+   }
+
+   INT32 _rtnOrderKey::compare( const _rtnOrderKey &rhs ) const
+   {
+      INT32 rsCmp = _keyObj.woCompare( rhs._keyObj, _orderBy, FALSE ) ;
+      if ( 0 == rsCmp )
+      {
+         rsCmp = compareHash( rhs ) ;
+      }
+      return rsCmp ;
+   }
+
+   INT32 _rtnOrderKey::compareHash( const _rtnOrderKey &rhs ) const
+   {
+      if ( _hash.hash != rhs._hash.hash )
+      {
+         return _hash.hash < rhs._hash.hash ? -1 : 1 ;
+      }
+      return 0 ;
+   }
 
    void _rtnOrderKey::clear()
    {
@@ -130,4 +145,260 @@ namespace engine
       _keyGen = NULL ;
       _contextID = -1 ;
    }
+
+   /*
+      _rtnSubCtxTree implement
+   */
+   _rtnSubCtxTree::_rtnSubCtxTree()
+   :_num( 0 ), _seq( 0 )
+   {
+   }
+
+   _rtnSubCtxTree::~_rtnSubCtxTree()
+   {
+      clear() ;
+   }
+
+   BOOLEAN _rtnSubCtxTree::_less( INT32 left, INT32 right ) const
+   {
+      const _leaf &l = _leaves[ left ] ;
+      const _leaf &r = _leaves[ right ] ;
+      INT32 rsCmp = 0 ;
+
+      // the free leaves are larger than any one
+      if ( NULL == l._pCtx || NULL == r._pCtx )
+      {
+         return NULL != l._pCtx ;
+      }
+      if ( l._normalized && r._normalized )
+      {
+         rsCmp = ossMemcmp( &l._norm[ 0 ], &r._norm[ 0 ],
+                            OSS_MIN( l._normLen, r._normLen ) ) ;
+         if ( 0 == rsCmp && l._normLen != r._normLen )
+         {
+            rsCmp = l._normLen < r._normLen ? -1 : 1 ;
+         }
+         else if ( 0 == rsCmp )
+         {
+            rsCmp = l._key.compareHash( r._key ) ;
+         }
+      }
+      else
+      {
+         rsCmp = l._key.compare( r._key ) ;
+      }
+      return rsCmp < 0 || ( 0 == rsCmp && l._seq < r._seq ) ;
+   }
+
+   void _rtnSubCtxTree::_setKey( INT32 leaf, const rtnOrderKey &key )
+   {
+      _leaf &l = _leaves[ leaf ] ;
+      UINT32 length = 0 ;
+
+      l._key = key ;
+      l._normalized = FALSE ;
+      try
+      {
+         ixmKeyOwned keyOwned( key.getKeyObj() ) ;
+         Ordering order = Ordering::make( key.getOrderBy() ) ;
+
+         if ( l._norm.empty() )
+         {
+            l._norm.resize( RTN_SUB_CTX_NORM_KEY_SIZE ) ;
+         }
+         if ( !keyOwned.normalize( order, &l._norm[ 0 ], l._norm.size(),
+                                   length ) )
+         {
+            goto done ;
+         }
+         if ( length > l._norm.size() )
+         {
+            l._norm.resize( length ) ;
+            keyOwned.normalize( order, &l._norm[ 0 ], length, length ) ;
+         }
+         l._normLen = length ;
+         l._normalized = TRUE ;
+      }
+      catch( std::exception &e )
+      {
+         // compared by woCompare then
+         PD_LOG( PDDEBUG, "Failed to normalize order key, occur "
+                 "exception: %s", e.what() ) ;
+      }
+
+   done:
+      return ;
+   }
+
+   void _rtnSubCtxTree::_replay( INT32 leaf )
+   {
+      INT32 winner = leaf ;
+      UINT32 node = ( leaf + _leaves.size() ) >> 1 ;
+
+      while ( node > 0 )
+      {
+         if ( _less( _nodes[ node ], winner ) )
+         {
+            INT32 tmp = _nodes[ node ] ;
+            _nodes[ node ] = winner ;
+            winner = tmp ;
+         }
+         node >>= 1 ;
+      }
+      _nodes[ 0 ] = winner ;
+   }
+
+   INT32 _rtnSubCtxTree::_build( UINT32 node )
+   {
+      INT32 left = 0 ;
+      INT32 right = 0 ;
+
+      // the leaf i is the node i + n
+      if ( node >= _leaves.size() )
+      {
+         return node - _leaves.size() ;
+      }
+      left = _build( node << 1 ) ;
+      right = _build( ( node << 1 ) + 1 ) ;
+      if ( _less( right, left ) )
+      {
+         _nodes[ node ] = left ;
+         return right ;
+      }
+      _nodes[ node ] = right ;
+      return left ;
+   }
+
+   void _rtnSubCtxTree::_rebuild()
+   {
+      _nodes.resize( _leaves.size() ) ;
+      if ( 1 == _leaves.size() )
+      {
+         _nodes[ 0 ] = 0 ;
+      }
+      else if ( _leaves.size() > 1 )
+      {
+         _nodes[ 0 ] = _build( 1 ) ;
+      }
+   }
+
+   void _rtnSubCtxTree::_free( INT32 leaf )
+   {
+      _leaves[ leaf ]._pCtx = NULL ;
+      _leaves[ leaf ]._key.clear() ;
+      _freeLeaves.push_back( leaf ) ;
+      --_num ;
+   }
+
+   INT32 _rtnSubCtxTree::push( rtnSubContext *pCtx, const rtnOrderKey &key )
+   {
+      INT32 rc = SDB_OK ;
+      INT32 leaf = -1 ;
+
+      SDB_ASSERT( NULL != pCtx, "Sub context can't be NULL" ) ;
+
+      try
+      {
+         if ( !_freeLeaves.empty() )
+         {
+            leaf = _freeLeaves.back() ;
+            _freeLeaves.pop_back() ;
+         }
+         else
+         {
+            // the leaves only grow when the sub contexts are added
+            _leaves.push_back( _leaf() ) ;
+            _freeLeaves.reserve( _leaves.size() ) ;
+            leaf = _leaves.size() - 1 ;
+         }
+      }
+      catch( std::exception &e )
+      {
+         PD_LOG( PDERROR, "Failed to add leaf to the tree, occur "
+                 "exception: %s", e.what() ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+
+      _leaves[ leaf ]._pCtx = pCtx ;
+      _setKey( leaf, key ) ;
+      _leaves[ leaf ]._seq = ++_seq ;
+      ++_num ;
+      _rebuild() ;
+
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   rtnSubContext* _rtnSubCtxTree::top() const
+   {
+      if ( 0 == _num )
+      {
+         return NULL ;
+      }
+      return _leaves[ _nodes[ 0 ] ]._pCtx ;
+   }
+
+   void _rtnSubCtxTree::replaceTop( const rtnOrderKey &key )
+   {
+      INT32 winner = 0 ;
+
+      SDB_ASSERT( _num > 0, "Tree can't be empty" ) ;
+
+      winner = _nodes[ 0 ] ;
+      _setKey( winner, key ) ;
+      _leaves[ winner ]._seq = ++_seq ;
+      _replay( winner ) ;
+   }
+
+   rtnSubContext* _rtnSubCtxTree::popTop()
+   {
+      INT32 winner = 0 ;
+      rtnSubContext *pCtx = NULL ;
+
+      if ( 0 == _num )
+      {
+         return NULL ;
+      }
+
+      winner = _nodes[ 0 ] ;
+      pCtx = _leaves[ winner ]._pCtx ;
+      _free( winner ) ;
+      _replay( winner ) ;
+      return pCtx ;
+   }
+
+   BOOLEAN _rtnSubCtxTree::erase( rtnSubContext *pCtx )
+   {
+      if ( 0 == _num )
+      {
+         return FALSE ;
+      }
+      else if ( pCtx == top() )
+      {
+         popTop() ;
+         return TRUE ;
+      }
+
+      for ( UINT32 i = 0 ; i < _leaves.size() ; ++i )
+      {
+         if ( _leaves[ i ]._pCtx == pCtx )
+         {
+            _free( i ) ;
+            _rebuild() ;
+            return TRUE ;
+         }
+      }
+      return FALSE ;
+   }
+
+   void _rtnSubCtxTree::clear()
+   {
+      _leaves.clear() ;
+      _nodes.clear() ;
+      _freeLeaves.clear() ;
+      _num = 0 ;
+   }
 }
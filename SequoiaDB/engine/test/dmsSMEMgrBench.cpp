@@ -0,0 +1,207 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+*******************************************************************************/
+
+/*
+   Microbenchmark of the segment space manager: every thread reserves and
+   releases extents of random size, keeping a small ring of extents held so
+   that the segments get fragmented. Usage:
+      dmsSMEBench [-l loops] [-p maxpages]
+*/
+
+#include "core.hpp"
+#include "oss.hpp"
+#include "ossUtil.hpp"
+#include "ossAtomic.hpp"
+#include "dmsStorageBase.hpp"
+#include "dmsSMEMgr.hpp"
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include "boost/thread.hpp"
+#include "boost/date_time/posix_time/posix_time.hpp"
+
+using namespace engine ;
+using namespace std ;
+
+#define BENCH_PAGE_SIZE          ( 65536 )
+#define BENCH_SEGMENT_SQUARE     ( 11 )
+#define BENCH_SEGMENT_NUM        ( 64 )
+#define BENCH_PAGE_NUM           ( BENCH_SEGMENT_NUM << BENCH_SEGMENT_SQUARE )
+#define BENCH_HOLD_NUM           ( 16 )
+#define BENCH_MAX_THREAD         ( 64 )
+
+static UINT32 g_loopNum = 100000 ;
+static UINT32 g_maxPages = 16 ;
+
+struct benchExtent
+{
+   dmsExtentID _start ;
+   UINT16      _num ;
+} ;
+
+static void benchWorker( dmsSMEMgr *pMgr, UINT32 seed, ossAtomic32 *pFailed,
+                         ossAtomic32 *pNoSpace )
+{
+   benchExtent hold[ BENCH_HOLD_NUM ] ;
+   UINT32 pos = 0 ;
+   ossMemset( hold, 0, sizeof( hold ) ) ;
+
+   for ( UINT32 i = 0 ; i < g_loopNum ; ++i )
+   {
+      benchExtent &slot = hold[ pos ] ;
+      pos = ( pos + 1 ) % BENCH_HOLD_NUM ;
+
+      if ( slot._num > 0 )
+      {
+         if ( SDB_OK != pMgr->releasePages( slot._start, slot._num ) )
+         {
+            pFailed->inc() ;
+         }
+         slot._num = 0 ;
+      }
+
+      UINT16 numPages = (UINT16)( rand_r( &seed ) % g_maxPages + 1 ) ;
+      if ( SDB_OK != pMgr->reservePages( numPages, slot._start ) )
+      {
+         pFailed->inc() ;
+         continue ;
+      }
+      else if ( DMS_INVALID_EXTENT == slot._start )
+      {
+         // all segments are full, not an error
+         pNoSpace->inc() ;
+         continue ;
+      }
+      slot._num = numPages ;
+   }
+
+   for ( UINT32 i = 0 ; i < BENCH_HOLD_NUM ; ++i )
+   {
+      if ( hold[ i ]._num > 0 &&
+           SDB_OK != pMgr->releasePages( hold[ i ]._start, hold[ i ]._num ) )
+      {
+         pFailed->inc() ;
+      }
+   }
+}
+
+static INT32 benchRun( UINT32 threadNum, _dmsSpaceManagementExtent *pSME )
+{
+   INT32 rc = SDB_OK ;
+   ossAtomic32 failed( 0 ) ;
+   ossAtomic32 noSpace( 0 ) ;
+   boost::thread *threads[ BENCH_MAX_THREAD ] = { NULL } ;
+   dmsSMEMgr *pMgr = SDB_OSS_NEW dmsSMEMgr() ;
+   if ( NULL == pMgr )
+   {
+      return SDB_OOM ;
+   }
+
+   rc = pMgr->init( BENCH_PAGE_SIZE, BENCH_SEGMENT_SQUARE, BENCH_PAGE_NUM,
+                    pSME ) ;
+   if ( rc )
+   {
+      cout << "Failed to init SME manager, rc = " << rc << endl ;
+      goto done ;
+   }
+
+   {
+      boost::posix_time::ptime begin =
+         boost::posix_time::microsec_clock::local_time() ;
+      for ( UINT32 i = 0 ; i < threadNum ; ++i )
+      {
+         threads[ i ] = new boost::thread( benchWorker, pMgr, i + 1,
+                                           &failed, &noSpace ) ;
+      }
+      for ( UINT32 i = 0 ; i < threadNum ; ++i )
+      {
+         threads[ i ]->join() ;
+         delete threads[ i ] ;
+      }
+      boost::posix_time::ptime end =
+         boost::posix_time::microsec_clock::local_time() ;
+
+      UINT64 ms = ( end - begin ).total_milliseconds() ;
+      UINT64 pairs = (UINT64)threadNum * g_loopNum ;
+      cout << "threads: " << threadNum
+           << ", pairs: " << pairs
+           << ", time(ms): " << ms
+           << ", pairs/s: " << ( ms ? pairs * 1000 / ms : pairs * 1000 )
+           << ", nospace: " << noSpace.peek()
+           << ", failed: " << failed.peek() << endl ;
+   }
+
+   if ( pMgr->totalFree() != BENCH_PAGE_NUM )
+   {
+      cout << "Free pages mismatch, expect " << BENCH_PAGE_NUM
+           << ", actual " << pMgr->totalFree() << endl ;
+      rc = SDB_SYS ;
+   }
+   else if ( failed.peek() > 0 )
+   {
+      rc = SDB_SYS ;
+   }
+
+done :
+   SDB_OSS_DEL pMgr ;
+   return rc ;
+}
+
+INT32 main( INT32 argc, CHAR **argv )
+{
+   INT32 rc = SDB_OK ;
+   _dmsSpaceManagementExtent *pSME = NULL ;
+
+   for ( INT32 i = 1 ; i + 1 < argc ; i += 2 )
+   {
+      if ( 0 == ossStrcmp( argv[ i ], "-l" ) )
+      {
+         g_loopNum = (UINT32)ossAtoi( argv[ i + 1 ] ) ;
+      }
+      else if ( 0 == ossStrcmp( argv[ i ], "-p" ) )
+      {
+         g_maxPages = (UINT32)ossAtoi( argv[ i + 1 ] ) ;
+      }
+   }
+   if ( 0 == g_maxPages || g_maxPages > ( 1 << BENCH_SEGMENT_SQUARE ) )
+   {
+      g_maxPages = 16 ;
+   }
+
+   pSME = SDB_OSS_NEW _dmsSpaceManagementExtent() ;
+   if ( NULL == pSME )
+   {
+      cout << "Unable to allocate SME" << endl ;
+      return SDB_OOM ;
+   }
+
+   for ( UINT32 threadNum = 1 ; threadNum <= BENCH_MAX_THREAD ;
+         threadNum *= 2 )
+   {
+      rc = benchRun( threadNum, pSME ) ;
+      if ( rc )
+      {
+         cout << "Benchmark failed with " << threadNum << " threads, rc = "
+              << rc << endl ;
+         break ;
+      }
+   }
+
+   SDB_OSS_DEL pSME ;
+   return rc ;
+}
@@ -0,0 +1,129 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = dpsCommitTest.cpp
+
+   Descriptive Name = Group commit test
+
+   When/how to use: test the group commit of the replica log manager when
+   the committer is alone, a lone committer must lead both the flush and
+   the sync by itself
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#include "ossTypes.hpp"
+#include <gtest/gtest.h>
+
+#include "core.hpp"
+#include "dpsReplicaLogMgr.hpp"
+#include "dpsLogWrapper.hpp"
+#include "ossIO.hpp"
+
+#include <string>
+
+#include <boost/thread.hpp>
+#include <boost/lexical_cast.hpp>
+
+using namespace engine;
+using namespace std;
+
+// a commit which doesn't end in it is taken as a hang
+#define COMMIT_TIMEOUT_SEC 30
+
+static void deleteLogFiles()
+{
+   for ( UINT32 i = 0 ; i < 20 ; i++ )
+   {
+      string file( "sequoiadbLog." ) ;
+      file += boost::lexical_cast<string>( i ) ;
+      ossDelete( file.c_str() ) ;
+   }
+}
+
+static void commitOnce( _dpsReplicaLogMgr *mgr, BOOLEAN deeply,
+                        volatile INT32 *result )
+{
+   *result = mgr->commit( deeply, NULL ) ;
+}
+
+/*
+   Run one commit in its own thread, returns FALSE if it doesn't end in
+   time. The manager is leaked then, since the spinning thread still
+   uses it
+*/
+static BOOLEAN runCommit( _dpsReplicaLogMgr *mgr, BOOLEAN deeply,
+                          INT32 &rc )
+{
+   volatile INT32 result = SDB_SYS ;
+   boost::thread t( commitOnce, mgr, deeply, &result ) ;
+   if ( !t.timed_join( boost::posix_time::seconds( COMMIT_TIMEOUT_SEC ) ) )
+   {
+      t.detach() ;
+      return FALSE ;
+   }
+   rc = result ;
+   return TRUE ;
+}
+
+TEST(dpsCommitTest, deepCommitAlone)
+{
+   INT32 rc = SDB_SYS ;
+   deleteLogFiles() ;
+   _dpsReplicaLogMgr *mgr = new _dpsReplicaLogMgr() ;
+   ASSERT_TRUE( SDB_OK == mgr->init( ".", DPS_DFT_LOG_BUF_SZ, NULL ) ) ;
+
+   // no other committer leads the sync, so the committer must do it
+   ASSERT_TRUE( runCommit( mgr, TRUE, rc ) ) ;
+   ASSERT_TRUE( SDB_OK == rc ) ;
+
+   // and again, the generations go on from the last round
+   ASSERT_TRUE( runCommit( mgr, TRUE, rc ) ) ;
+   ASSERT_TRUE( SDB_OK == rc ) ;
+
+   mgr->tearDown() ;
+   delete mgr ;
+   deleteLogFiles() ;
+}
+
+TEST(dpsCommitTest, deepCommitAfterFlush)
+{
+   INT32 rc = SDB_SYS ;
+   deleteLogFiles() ;
+   _dpsReplicaLogMgr *mgr = new _dpsReplicaLogMgr() ;
+   ASSERT_TRUE( SDB_OK == mgr->init( ".", DPS_DFT_LOG_BUF_SZ, NULL ) ) ;
+
+   // a flush only commit, then a deep one finds nothing to flush but
+   // still has to sync
+   ASSERT_TRUE( runCommit( mgr, FALSE, rc ) ) ;
+   ASSERT_TRUE( SDB_OK == rc ) ;
+   ASSERT_TRUE( runCommit( mgr, TRUE, rc ) ) ;
+   ASSERT_TRUE( SDB_OK == rc ) ;
+
+   mgr->tearDown() ;
+   delete mgr ;
+   deleteLogFiles() ;
+}
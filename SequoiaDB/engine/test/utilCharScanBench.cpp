@@ -0,0 +1,315 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+*******************************************************************************/
+
+/*
+   Microbenchmark of the structural character scan used by sdbimprt: the
+   CSV sample is split into records and fields with the quotes honored, and
+   the JSON sample is split into records by the braces, first by the scalar
+   scan and then by utilScanChars. The counts must be the same. The samples
+   are generated unless a file is given, which is taken as both. Usage:
+      utilCharScanBench [-l loops] [-s sizeMB] [-f file]
+*/
+
+#include "core.hpp"
+#include "oss.hpp"
+#include "ossUtil.hpp"
+#include "utilCharScan.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <iostream>
+#include "boost/date_time/posix_time/posix_time.hpp"
+
+using namespace engine ;
+using namespace std ;
+
+typedef UINT32 (*BENCH_SCAN_FUNC)( const CHAR *pData, UINT32 len,
+                                   const CHAR *pChars, UINT32 num ) ;
+
+struct benchCount
+{
+   UINT64 _records ;
+   UINT64 _fields ;
+
+   BOOLEAN operator==( const benchCount &rhs ) const
+   {
+      return _records == rhs._records && _fields == rhs._fields ;
+   }
+} ;
+
+static UINT32 g_loopNum = 10 ;
+static UINT32 g_sizeMB = 32 ;
+
+static const CHAR *g_words[] = { "sequoiadb", "distributed", "document",
+                                 "database", "import", "tokenizer",
+                                 "\xe5\xb7\xb2\xe7\x94\x9f\xe6\x88\x90",
+                                 "shard" } ;
+#define BENCH_WORD_NUM  ( sizeof( g_words ) / sizeof( g_words[0] ) )
+
+static void benchGenCSV( string &data, UINT32 size, UINT32 seed )
+{
+   CHAR num[ 32 ] ;
+   data.reserve( size + 256 ) ;
+   for ( UINT32 i = 0 ; data.size() < size ; ++i )
+   {
+      ossSnprintf( num, sizeof( num ), "%u,%d.%u,", i, rand_r( &seed ),
+                   rand_r( &seed ) % 1000 ) ;
+      data += num ;
+      // a long quoted text with the delimiters and the escaped quotes
+      data += '"' ;
+      for ( UINT32 w = rand_r( &seed ) % 16 + 4 ; w > 0 ; --w )
+      {
+         data += g_words[ rand_r( &seed ) % BENCH_WORD_NUM ] ;
+         data += ( 0 == rand_r( &seed ) % 8 ) ? ", " : " " ;
+      }
+      if ( 0 == rand_r( &seed ) % 4 )
+      {
+         data += "\"\"quoted\"\"" ;
+      }
+      data += "\"," ;
+      data += g_words[ rand_r( &seed ) % BENCH_WORD_NUM ] ;
+      data += ",true\n" ;
+   }
+}
+
+static void benchGenJSON( string &data, UINT32 size, UINT32 seed )
+{
+   CHAR num[ 64 ] ;
+   data.reserve( size + 256 ) ;
+   for ( UINT32 i = 0 ; data.size() < size ; ++i )
+   {
+      ossSnprintf( num, sizeof( num ), "{ \"_id\": %u, \"value\": %d, ",
+                   i, rand_r( &seed ) ) ;
+      data += num ;
+      data += "\"text\": \"" ;
+      for ( UINT32 w = rand_r( &seed ) % 16 + 4 ; w > 0 ; --w )
+      {
+         data += g_words[ rand_r( &seed ) % BENCH_WORD_NUM ] ;
+         data += ( 0 == rand_r( &seed ) % 8 ) ? " {\\\"} " : " " ;
+      }
+      data += "\", \"tags\": [ 'a', 'b' ], \"sub\": { \"name\": '" ;
+      data += g_words[ rand_r( &seed ) % BENCH_WORD_NUM ] ;
+      data += "' } }\n" ;
+   }
+}
+
+// the same state machine as csvParser::csv2bson
+static benchCount benchSplitCSV( const string &data, BENCH_SCAN_FUNC func )
+{
+   static const CHAR stopChars[] = { '"', ',', '\n' } ;
+   benchCount count = { 0, 0 } ;
+   const CHAR *pCursor = data.c_str() ;
+   UINT32 size = data.size() ;
+   BOOLEAN isString = FALSE ;
+
+   while ( size > 0 )
+   {
+      UINT32 skip = func( pCursor, size, stopChars, isString ? 1 : 3 ) ;
+      pCursor += skip ;
+      size -= skip ;
+      if ( 0 == size )
+      {
+         break ;
+      }
+      if ( '"' == *pCursor )
+      {
+         isString = !isString ;
+      }
+      else if ( !isString )
+      {
+         ++count._fields ;
+         if ( '\n' == *pCursor )
+         {
+            ++count._records ;
+         }
+      }
+      ++pCursor ;
+      --size ;
+   }
+   return count ;
+}
+
+// the same state machine as RecordScanner::_scanJSON
+static benchCount benchSplitJSON( const string &data, BENCH_SCAN_FUNC func )
+{
+   static const CHAR stopChars[] = { '{', '}', '\'', '"', '\\' } ;
+   benchCount count = { 0, 0 } ;
+   const CHAR *pCursor = data.c_str() ;
+   UINT32 size = data.size() ;
+   CHAR quote = 0 ;
+   INT32 level = 0 ;
+
+   while ( size > 0 )
+   {
+      UINT32 skip = func( pCursor, size, stopChars, sizeof( stopChars ) ) ;
+      pCursor += skip ;
+      size -= skip ;
+      if ( 0 == size )
+      {
+         break ;
+      }
+      switch ( *pCursor )
+      {
+      case '{' :
+         if ( 0 == quote )
+         {
+            ++level ;
+            ++count._fields ;
+         }
+         break ;
+      case '}' :
+         if ( 0 == quote && 0 == --level )
+         {
+            ++count._records ;
+         }
+         break ;
+      case '\'' :
+      case '"' :
+         if ( 0 == quote )
+         {
+            quote = *pCursor ;
+         }
+         else if ( quote == *pCursor )
+         {
+            quote = 0 ;
+         }
+         break ;
+      default :
+         // the escaped one
+         if ( size > 1 )
+         {
+            ++pCursor ;
+            --size ;
+         }
+         break ;
+      }
+      ++pCursor ;
+      --size ;
+   }
+   return count ;
+}
+
+typedef benchCount (*BENCH_SPLIT_FUNC)( const string &data,
+                                        BENCH_SCAN_FUNC func ) ;
+
+static INT32 benchRun( const CHAR *pName, const string &data,
+                       BENCH_SPLIT_FUNC split )
+{
+   BENCH_SCAN_FUNC funcs[ 2 ] = { utilScanCharsScalar, utilScanChars } ;
+   const CHAR *names[ 2 ] = { "scalar", utilScanImplName() } ;
+   benchCount counts[ 2 ] ;
+
+   for ( UINT32 f = 0 ; f < 2 ; ++f )
+   {
+      boost::posix_time::ptime begin =
+         boost::posix_time::microsec_clock::local_time() ;
+      for ( UINT32 i = 0 ; i < g_loopNum ; ++i )
+      {
+         counts[ f ] = split( data, funcs[ f ] ) ;
+      }
+      boost::posix_time::ptime end =
+         boost::posix_time::microsec_clock::local_time() ;
+
+      UINT64 us = ( end - begin ).total_microseconds() ;
+      UINT64 bytes = (UINT64)data.size() * g_loopNum ;
+      cout << pName << " " << names[ f ]
+           << ", bytes: " << data.size()
+           << ", records: " << counts[ f ]._records
+           << ", fields: " << counts[ f ]._fields
+           << ", MB/s: " << ( us ? bytes / us : bytes ) << endl ;
+   }
+
+   if ( !( counts[ 0 ] == counts[ 1 ] ) )
+   {
+      cout << pName << " count mismatch" << endl ;
+      return SDB_SYS ;
+   }
+   return SDB_OK ;
+}
+
+static INT32 benchLoadFile( const CHAR *pPath, string &data )
+{
+   CHAR buff[ 65536 ] ;
+   size_t readSize = 0 ;
+   FILE *pFile = fopen( pPath, "rb" ) ;
+   if ( NULL == pFile )
+   {
+      cout << "Failed to open file " << pPath << endl ;
+      return SDB_FNE ;
+   }
+   while ( ( readSize = fread( buff, 1, sizeof( buff ), pFile ) ) > 0 )
+   {
+      data.append( buff, readSize ) ;
+   }
+   fclose( pFile ) ;
+   return SDB_OK ;
+}
+
+INT32 main( INT32 argc, CHAR **argv )
+{
+   INT32 rc = SDB_OK ;
+   const CHAR *pPath = NULL ;
+   string csvData ;
+   string jsonData ;
+
+   for ( INT32 i = 1 ; i + 1 < argc ; i += 2 )
+   {
+      if ( 0 == ossStrcmp( argv[ i ], "-l" ) )
+      {
+         g_loopNum = (UINT32)ossAtoi( argv[ i + 1 ] ) ;
+      }
+      else if ( 0 == ossStrcmp( argv[ i ], "-s" ) )
+      {
+         g_sizeMB = (UINT32)ossAtoi( argv[ i + 1 ] ) ;
+      }
+      else if ( 0 == ossStrcmp( argv[ i ], "-f" ) )
+      {
+         pPath = argv[ i + 1 ] ;
+      }
+   }
+   if ( 0 == g_loopNum )
+   {
+      g_loopNum = 10 ;
+   }
+   if ( 0 == g_sizeMB || g_sizeMB > 1024 )
+   {
+      g_sizeMB = 32 ;
+   }
+
+   if ( pPath )
+   {
+      rc = benchLoadFile( pPath, csvData ) ;
+      if ( rc )
+      {
+         return rc ;
+      }
+      jsonData = csvData ;
+   }
+   else
+   {
+      benchGenCSV( csvData, g_sizeMB << 20, 1 ) ;
+      benchGenJSON( jsonData, g_sizeMB << 20, 2 ) ;
+   }
+
+   rc = benchRun( "csv", csvData, benchSplitCSV ) ;
+   if ( SDB_OK == rc )
+   {
+      rc = benchRun( "json", jsonData, benchSplitJSON ) ;
+   }
+   return rc ;
+}
@@ -522,8 +522,10 @@ namespace exprt
                goto error ;
             }
          }
-         else if ( FORMAT_CSV == _options.type()  )
+         else if ( FORMAT_CSV == _options.type() ||
+                   FORMAT_COLUMNAR == _options.type() )
          {
+            // the columns are fixed by the fields as csv
             const CHAR* pSelect = EXP_SELECT_WITHOUT_ID ;
             if ( _options.withId() ) 
             { 
@@ -540,14 +542,14 @@ namespace exprt
                goto error ;
             }
 
-            if ( FORMAT_CSV == _options.type() && 
-                 !_options.force() &&
+            if ( !_options.force() &&
                  !it->fields.empty() &&
                  _options.select().empty() )
             {
-               cerr << "for csv, fields for each collection must be specified"
+               cerr << "for " << _options.typeName()
+                    << ", fields for each collection must be specified"
                     << endl ;
-               PD_LOG( PDERROR, "For csv, fields for each collection "
+               PD_LOG( PDERROR, "For csv/columnar, fields for each collection "
                                 "must be specified, but collection %s not",
                        it->fullName().c_str() ) ;
                rc = SDB_INVALIDARG ;
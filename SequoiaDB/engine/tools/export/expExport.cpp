@@ -35,11 +35,15 @@
 #include "pd.hpp"
 #include "jstobs.h"
 #include <iostream>
+#include <sstream>
 
 namespace exprt
 {
 
    #define EXP_LOG_OUTPUT_SIZE  ( 1024 * 1024 * 1024 ) // 1G
+   #define EXP_SPILL_BLOCK_SIZE ( 4 * 1024 * 1024 )    // 4M
+   #define EXP_PART_FILE_SUFFIX ".part"
+   #define EXP_SPILL_FILE_SUFFIX ".tmp"
 
    INT32 expCLExporter::_query( sdbCollectionHandle &hCL, 
                                 sdbCursorHandle &hCusor )
@@ -147,6 +151,15 @@ namespace exprt
 
       while ( TRUE )
       {
+         // another stream of the collection has failed
+         if ( _pStopped && _pStopped->peek() )
+         {
+            rc = SDB_INTERRUPT ;
+            PD_LOG( PDWARNING, "Exporting of %s is interrupted",
+                    _cl.fullName().c_str() ) ;
+            goto error ;
+         }
+
          rc = sdbNext( hCusor, &record ) ;
          if ( SDB_DMS_EOC == rc )
          {
@@ -185,6 +198,10 @@ namespace exprt
             accumulatedSize = 0 ;
          }
 
+         if ( !_convertor.recordDelimited() )
+         {
+            continue ;
+         }
          buf = _options.delRecord().c_str() ;
          size = (UINT32)_options.delRecord().size() ;
          accumulatedSize += size ;
@@ -242,7 +259,8 @@ namespace exprt
          PD_LOG( PDERROR, "Failed to get head of convertor, rc = %d", rc ) ;
          goto error ;
       }
-      if ( size > 0 )
+      // the streams after the first one of a file are without the head
+      if ( size > 0 && _withHead )
       {
          rc = _out.output( buf, size );
          if ( SDB_OK != rc )
@@ -250,14 +268,17 @@ namespace exprt
             PD_LOG( PDERROR, "Failed to output the head, rc = %d", rc ) ;
             goto error ;
          }
-         buf = _options.delRecord().c_str() ;
-         size = (UINT32)_options.delRecord().size() ;
-         rc = _out.output( buf, size );
-         if ( SDB_OK != rc )
+         if ( _convertor.recordDelimited() )
          {
-            PD_LOG( PDERROR, "Failed to output the record delimiter, rc = %d",
-                    rc ) ;
-            goto error ;
+            buf = _options.delRecord().c_str() ;
+            size = (UINT32)_options.delRecord().size() ;
+            rc = _out.output( buf, size );
+            if ( SDB_OK != rc )
+            {
+               PD_LOG( PDERROR, "Failed to output the record delimiter, "
+                       "rc = %d", rc ) ;
+               goto error ;
+            }
          }
       }
 
@@ -318,16 +339,273 @@ namespace exprt
       }
    }
 
-   INT32 expRoutine::_exportOne( sdbConnectionHandle hConn, const expCL &cl ) 
+   static expConvertor *newConvertor( const expOptions &options,
+                                      const expCL &cl )
+   {
+      expConvertor *pConvertor = NULL ;
+
+      if ( FORMAT_CSV == options.type() )
+      {
+         pConvertor = SDB_OSS_NEW expCSVConvertor( options, cl ) ;
+      }
+      else if ( FORMAT_JSON == options.type() )
+      {
+         pConvertor = SDB_OSS_NEW expJsonConvertor( options, cl ) ;
+      }
+      else if ( FORMAT_COLUMNAR == options.type() )
+      {
+         pConvertor = SDB_OSS_NEW expColumnConvertor( options, cl ) ;
+      }
+      return pConvertor ;
+   }
+
+   expRangeStreams::~expRangeStreams()
+   {
+      for ( vector<_task*>::iterator it = _tasks.begin() ;
+            _tasks.end() != it ; ++it )
+      {
+         _task *pTask = *it ;
+         if ( pTask->pOutput )    { SDB_OSS_DEL pTask->pOutput ; }
+         if ( pTask->pConvertor ) { SDB_OSS_DEL pTask->pConvertor ; }
+         SDB_OSS_DEL pTask ;
+      }
+      _tasks.clear() ;
+   }
+
+   INT32 expRangeStreams::init( const vector<expCLRange> &ranges,
+                                const string &fileName, expCLOutput *pFile )
+   {
+      INT32 rc = SDB_OK ;
+      // the file rolls at the boundaries of the blocks when merged
+      UINT32 blockSize = (UINT32)OSS_MIN( (UINT64)EXP_SPILL_BLOCK_SIZE,
+                                          _options.fileLimit() ) ;
+
+      for ( UINT32 i = 0 ; i < ranges.size() ; ++i )
+      {
+         ostringstream ss ;
+         _task *pTask = SDB_OSS_NEW _task( ranges[i] ) ;
+         if ( !pTask )
+         {
+            PD_LOG( PDERROR, "Failed to alloc the task" ) ;
+            rc = SDB_OOM ;
+            goto error ;
+         }
+         _tasks.push_back( pTask ) ;
+
+         pTask->pConvertor = newConvertor( _options, pTask->range.cl ) ;
+         if ( !pTask->pConvertor )
+         {
+            PD_LOG( PDERROR, "Failed to alloc the pConvertor" ) ;
+            rc = SDB_OOM ;
+            goto error ;
+         }
+
+         if ( NULL == pFile )
+         {
+            ss << fileName ;
+            if ( ranges.size() > 1 )
+            {
+               ss << EXP_PART_FILE_SUFFIX << i ;
+            }
+            pTask->pOutput = SDB_OSS_NEW expCLFile( _options, ss.str() ) ;
+         }
+         else if ( 0 == i )
+         {
+            pTask->pOutput = SDB_OSS_NEW expCLOutputRef( *pFile ) ;
+         }
+         else
+         {
+            ss << fileName << EXP_SPILL_FILE_SUFFIX << i ;
+            pTask->pSpill = SDB_OSS_NEW expCLSpill( ss.str(), blockSize ) ;
+            pTask->pOutput = pTask->pSpill ;
+            pTask->withHead = FALSE ;
+         }
+         if ( !pTask->pOutput )
+         {
+            PD_LOG( PDERROR, "Failed to alloc the pOutput" ) ;
+            rc = SDB_OOM ;
+            goto error ;
+         }
+      }
+
+   done :
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   void expRangeStreams::_routine( import::WorkerArgs *pArgs )
+   {
+      expRangeStreams *pStreams = (expRangeStreams*)pArgs ;
+      pStreams->_runTasks() ;
+   }
+
+   void expRangeStreams::_runTasks()
+   {
+      UINT32 index = 0 ;
+
+      while ( ( index = _next.inc() ) < _tasks.size() )
+      {
+         _task &task = *_tasks[ index ] ;
+         if ( _stopped.peek() )
+         {
+            task.rc = SDB_INTERRUPT ;
+            continue ;
+         }
+         task.rc = _runTask( task ) ;
+         if ( SDB_OK != task.rc )
+         {
+            _stopped.poke( 1 ) ;
+         }
+      }
+   }
+
+   INT32 expRangeStreams::_runTask( _task &task )
+   {
+      INT32 rc = SDB_OK ;
+      sdbConnectionHandle hConn = SDB_INVALID_HANDLE ;
+
+      rc = expConnect( _options, task.range.hostName, task.range.svcName,
+                       hConn ) ;
+      if ( SDB_OK != rc )
+      {
+         goto error ;
+      }
+
+      {
+         expCLExporter exporter( _options, hConn, task.range.cl,
+                                 *task.pOutput, *task.pConvertor,
+                                 task.withHead, &_stopped ) ;
+         rc = exporter.run( task.exportedCount, task.failCount ) ;
+      }
+      if ( SDB_OK != rc )
+      {
+         PD_LOG( PDERROR, "Failed to export the range %s of %s, rc = %d",
+                 task.range.cl.filter.c_str(),
+                 task.range.cl.fullName().c_str(), rc ) ;
+         goto error ;
+      }
+
+   done :
+      if ( SDB_INVALID_HANDLE != hConn )
+      {
+         sdbDisconnect( hConn ) ;
+         sdbReleaseConnection( hConn ) ;
+      }
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   INT32 expRangeStreams::run()
+   {
+      INT32 rc = SDB_OK ;
+      UINT32 workerNum = OSS_MIN( _options.jobs(), (UINT32)_tasks.size() ) ;
+      vector<import::Worker*> workers ;
+
+      for ( UINT32 i = 0 ; i < workerNum ; ++i )
+      {
+         import::Worker *pWorker = SDB_OSS_NEW import::Worker( _routine,
+                                                               this ) ;
+         if ( !pWorker )
+         {
+            PD_LOG( PDERROR, "Failed to alloc the worker" ) ;
+            rc = SDB_OOM ;
+            break ;
+         }
+         rc = pWorker->start() ;
+         if ( SDB_OK != rc )
+         {
+            PD_LOG( PDERROR, "Failed to start the worker, rc = %d", rc ) ;
+            SDB_OSS_DEL pWorker ;
+            break ;
+         }
+         workers.push_back( pWorker ) ;
+      }
+
+      // the started workers still take all the tasks
+      if ( SDB_OK != rc )
+      {
+         _stopped.poke( 1 ) ;
+      }
+      for ( vector<import::Worker*>::iterator it = workers.begin() ;
+            workers.end() != it ; ++it )
+      {
+         (*it)->waitStop() ;
+         SDB_OSS_DEL *it ;
+      }
+      if ( SDB_OK != rc )
+      {
+         goto error ;
+      }
+
+      for ( vector<_task*>::iterator it = _tasks.begin() ;
+            _tasks.end() != it ; ++it )
+      {
+         // report the first failure, the others are interrupted by it
+         if ( SDB_OK != (*it)->rc &&
+              ( SDB_OK == rc || SDB_INTERRUPT == rc ) )
+         {
+            rc = (*it)->rc ;
+         }
+      }
+      if ( SDB_OK != rc )
+      {
+         goto error ;
+      }
+
+   done :
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   INT32 expRangeStreams::merge( expCLOutput &file )
+   {
+      INT32 rc = SDB_OK ;
+
+      for ( vector<_task*>::iterator it = _tasks.begin() ;
+            _tasks.end() != it ; ++it )
+      {
+         if ( NULL == (*it)->pSpill )
+         {
+            continue ;
+         }
+         rc = (*it)->pSpill->replay( file ) ;
+         if ( SDB_OK != rc )
+         {
+            PD_LOG( PDERROR, "Failed to merge the range %s, rc = %d",
+                    (*it)->range.cl.filter.c_str(), rc ) ;
+            goto error ;
+         }
+      }
+
+   done :
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   void expRangeStreams::getCount( UINT64 &exportedCount,
+                                   UINT64 &failCount ) const
+   {
+      for ( vector<_task*>::const_iterator it = _tasks.begin() ;
+            _tasks.end() != it ; ++it )
+      {
+         exportedCount += (*it)->exportedCount ;
+         failCount += (*it)->failCount ;
+      }
+   }
+
+   INT32 expRoutine::_exportStream( sdbConnectionHandle hConn,
+                                    const expCL &cl,
+                                    const string &fileName,
+                                    UINT64 &count, UINT64 &failCount )
    {
       INT32 rc = SDB_OK ;
-      UINT64 count = 0 ;
-      UINT64 failCount = 0 ;
-      string fileName ;
       expCLOutput  *pOutput = NULL ;
       expConvertor *pConvertor = NULL ;
       
-      _getCLFileName( cl, fileName ) ;
       pOutput = SDB_OSS_NEW expCLFile( _options, fileName ) ;
       if ( !pOutput )
       {
@@ -336,14 +614,7 @@ namespace exprt
          goto error ;
       }
       
-      if ( FORMAT_CSV == _options.type() )
-      {
-         pConvertor = SDB_OSS_NEW expCSVConvertor( _options, cl ) ;
-      }
-      else if ( FORMAT_JSON == _options.type() )
-      {
-         pConvertor = SDB_OSS_NEW expJsonConvertor( _options, cl ) ;
-      }
+      pConvertor = newConvertor( _options, cl ) ;
       if ( !pConvertor )
       {
          PD_LOG( PDERROR, "Failed to alloc the pConvertor" ) ;
@@ -356,6 +627,102 @@ namespace exprt
          rc = exporter.run( count, failCount ) ;
       }
 
+   done :
+      if ( pOutput )    { SDB_OSS_DEL pOutput; }
+      if ( pConvertor ) { SDB_OSS_DEL pConvertor; }
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   INT32 expRoutine::_exportRanges( sdbConnectionHandle hConn,
+                                    const expCL &cl,
+                                    const string &fileName,
+                                    UINT64 &count, UINT64 &failCount )
+   {
+      INT32 rc = SDB_OK ;
+      vector<expCLRange> ranges ;
+      expRangePlanner planner( _options, hConn ) ;
+      expRangeStreams streams( _options ) ;
+      expCLOutput *pFile = NULL ;
+
+      rc = planner.plan( cl, _options.jobs(), ranges ) ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG( PDERROR, "Failed to split collection %s into ranges, "
+                 "rc = %d", cl.fullName().c_str(), rc ) ;
+         goto error ;
+      }
+
+      // the ranges are merged into the file unless they are split
+      if ( !_options.splitFile() )
+      {
+         pFile = SDB_OSS_NEW expCLFile( _options, fileName ) ;
+         if ( !pFile )
+         {
+            PD_LOG( PDERROR, "Failed to alloc the pFile" ) ;
+            rc = SDB_OOM ;
+            goto error ;
+         }
+         rc = pFile->open() ;
+         if ( SDB_OK != rc )
+         {
+            PD_LOG( PDERROR, "Failed to open output, rc = %d", rc ) ;
+            goto error ;
+         }
+      }
+
+      rc = streams.init( ranges, fileName, pFile ) ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG( PDERROR, "Failed to init the streams, rc = %d", rc ) ;
+         goto error ;
+      }
+
+      rc = streams.run() ;
+      streams.getCount( count, failCount ) ;
+      if ( SDB_OK != rc )
+      {
+         goto error ;
+      }
+
+      if ( pFile )
+      {
+         rc = streams.merge( *pFile ) ;
+         if ( SDB_OK != rc )
+         {
+            goto error ;
+         }
+      }
+
+   done :
+      if ( pFile )
+      {
+         pFile->close() ;
+         SDB_OSS_DEL pFile ;
+      }
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   INT32 expRoutine::_exportOne( sdbConnectionHandle hConn, const expCL &cl ) 
+   {
+      INT32 rc = SDB_OK ;
+      UINT64 count = 0 ;
+      UINT64 failCount = 0 ;
+      string fileName ;
+      
+      _getCLFileName( cl, fileName ) ;
+      if ( _options.jobs() > 1 )
+      {
+         rc = _exportRanges( hConn, cl, fileName, count, failCount ) ;
+      }
+      else
+      {
+         rc = _exportStream( hConn, cl, fileName, count, failCount ) ;
+      }
+
       _exportedRecordCount += count ;
       _failRecordCount += failCount ;
 
@@ -375,8 +742,6 @@ namespace exprt
               count, failCount ) ;
          
    done :
-      if ( pOutput )    { SDB_OSS_DEL pOutput; }
-      if ( pConvertor ) { SDB_OSS_DEL pConvertor; }
       return rc ;
    error :
       goto done ;
@@ -408,36 +773,7 @@ namespace exprt
 
    INT32 expRoutine::_connectDB( sdbConnectionHandle &hConn )
    {
-      INT32 rc = SDB_OK ;
-      const expOptions &options = _options ;
-      
-   #ifdef SDB_SSL
-      if ( options.useSSL() )
-      {
-         rc = sdbSecureConnect( options.hostName().c_str(), 
-                                options.svcName().c_str(),
-                                options.user().c_str(),
-                                options.password().c_str(),
-                                &hConn ) ;
-      }
-      else
-   #endif
-      {
-         rc = sdbConnect( options.hostName().c_str(), options.svcName().c_str(),
-                          options.user().c_str(), options.password().c_str(),
-                          &hConn ) ;
-      }
-
-      if ( SDB_OK != rc )
-      {
-         PD_LOG ( PDERROR, "Failed to connect database %s:%s, rc = %d",
-                  options.hostName().c_str(), options.svcName().c_str(), rc ) ;
-         goto error ;
-      }
-   done:
-      return rc ;
-   error:
-      goto done ;
+      return expConnect( _options, "", "", hConn ) ;
    }
    
    INT32 expRoutine::run()
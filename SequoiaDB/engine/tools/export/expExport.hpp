@@ -37,6 +37,9 @@
 #include "expOptions.hpp"
 #include "expCL.hpp"
 #include "expOutput.hpp"
+#include "expRange.hpp"
+#include "ossAtomic.hpp"
+#include "../import/impWorker.hpp"
 #include <vector>
 
 namespace exprt
@@ -50,13 +53,17 @@ namespace exprt
                      sdbConnectionHandle hConn,
                      const expCL &cl, 
                      expCLOutput &out, 
-                     expConvertor &convertor  ) :
+                     expConvertor &convertor,
+                     BOOLEAN withHead = TRUE,
+                     ossAtomic32 *pStopped = NULL ) :
                      
                      _options(options), 
                      _hConn(hConn), 
                      _cl(cl), 
                      _out(out),
-                     _convertor(convertor)
+                     _convertor(convertor),
+                     _withHead(withHead),
+                     _pStopped(pStopped)
       {
       }
       INT32 run( UINT64 &exportedCount, UINT64 &failCount ) ;
@@ -70,6 +77,58 @@ namespace exprt
       const expCL          &_cl ;
       expCLOutput          &_out ;
       expConvertor         &_convertor ;
+      BOOLEAN              _withHead ;
+      ossAtomic32          *_pStopped ;
+   } ;
+
+   /*
+      expRangeStreams define
+      The ranges of a collection are exported by the jobs in parallel, a
+      job takes the next range when it's done with one. In the split mode
+      each range has its own files, otherwise the first range is written to
+      the file directly and the others are spilled, then they are merged in
+      the order of the ranges.
+   */
+   class expRangeStreams : public import::WorkerArgs
+   {
+      struct _task : public SDBObject
+      {
+         expCLRange     range ;
+         expConvertor   *pConvertor ;
+         expCLOutput    *pOutput ;
+         expCLSpill     *pSpill ;
+         BOOLEAN        withHead ;
+         INT32          rc ;
+         UINT64         exportedCount ;
+         UINT64         failCount ;
+
+         explicit _task( const expCLRange &range_ ) :
+            range(range_), pConvertor(NULL), pOutput(NULL), pSpill(NULL),
+            withHead(TRUE), rc(SDB_OK), exportedCount(0), failCount(0)
+         {
+         }
+      } ;
+
+   public :
+      explicit expRangeStreams( expOptions &options ) :
+         _options(options), _next(0), _stopped(0)
+      {
+      }
+      ~expRangeStreams() ;
+      INT32 init( const vector<expCLRange> &ranges,
+                  const string &fileName, expCLOutput *pFile ) ;
+      INT32 run() ;
+      INT32 merge( expCLOutput &file ) ;
+      void  getCount( UINT64 &exportedCount, UINT64 &failCount ) const ;
+   private :
+      static void _routine( import::WorkerArgs *pArgs ) ;
+      void  _runTasks() ;
+      INT32 _runTask( _task &task ) ;
+   private :
+      expOptions        &_options ;
+      vector<_task*>    _tasks ;
+      ossAtomic32       _next ;
+      ossAtomic32       _stopped ;
    } ;
 
    class expRoutine : public SDBObject
@@ -88,6 +147,12 @@ namespace exprt
       void  printStatistics() ;
    private :
       INT32 _exportOne( sdbConnectionHandle hConn, const expCL &cl ) ;
+      INT32 _exportStream( sdbConnectionHandle hConn, const expCL &cl,
+                           const string &fileName,
+                           UINT64 &count, UINT64 &failCount ) ;
+      INT32 _exportRanges( sdbConnectionHandle hConn, const expCL &cl,
+                           const string &fileName,
+                           UINT64 &count, UINT64 &failCount ) ;
       INT32 _export( sdbConnectionHandle hConn ) ;
       INT32 _connectDB( sdbConnectionHandle &hConn ) ;
       void  _getCLFileName( const expCL &cl, string &fileName ) ;
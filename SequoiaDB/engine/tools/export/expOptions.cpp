@@ -59,6 +59,8 @@ namespace exprt
    #define OPTION_SSL               "ssl"
    #define OPTION_FLOATFMT          "floatfmt"
    #define OPTION_REPLACE           "replace"
+   #define OPTION_JOBS              "jobs"
+   #define OPTION_SPLITFILE         "splitfile"
 
    #define OPTION_COLLECTSPACE      "csname"
    #define OPTION_COLLECTION        "clname"
@@ -96,7 +98,7 @@ namespace exprt
    #define EXPLAIN_PASSWORD         "password"
    #define EXPLAIN_FILELIMIT        "the limit of max size for one file, in K/k/M/m/G/g, default: 16G"
    #define EXPLAIN_DELRECORD        "record delimiter, default: '\\n' "
-   #define EXPLAIN_TYPE             "type of file to output, default: csv (json,csv)"
+   #define EXPLAIN_TYPE             "type of file to output, default: csv (json,csv,columnar)"
    #define EXPLAIN_WITHID           "keep the fields with '_id' when force to export or generate the fields"  
    #define EXPLAIN_ERRORSTOP        "whether stop by hitting error, default false"
    #define EXPLAIN_SSL              "use SSL connection (arg: [true|false], e.g. --ssl true)"
@@ -107,6 +109,10 @@ namespace exprt
    #define EXPLAIN_FLOATFMT         "float format, default: '%.16g', input 'db2' is '%+.14E', " \
                                     "format %[+][.precision](f|e|E|g|G) ( float only )"
    #define EXPLAIN_REPLACE          "whether to overwrite the output file"
+   #define EXPLAIN_JOBS             "the number of parallel streams to export one collection, " \
+                                    "which is split by group and by '_id' range, default: 1"
+   #define EXPLAIN_SPLITFILE        "whether each stream writes to its own file, otherwise the streams " \
+                                    "are merged into one file in order, default: false"
 
    #define EXPLAIN_STRICT           "strict export of data types, default: false"
 
@@ -144,6 +150,8 @@ namespace exprt
 
    #define FILELIMIT_MAX            ( 16LL * 1024 * 1024 * 1024 * 1024 ) // 16T
 
+   #define JOBS_MAX                 ( 128 )
+
    #define _TYPE(T) po::value< T >()
 
    #define EXP_GENERAL_OPTIONS \
@@ -160,7 +168,9 @@ namespace exprt
       ( OPTION_FIELDS,         _TYPE(vector<string>),    EXPLAIN_FIELDS ) \
       ( OPTION_SSL,                    _TYPE(bool),      EXPLAIN_SSL) \
       ( OPTION_FLOATFMT,               _TYPE(string),    EXPLAIN_FLOATFMT ) \
-      ( OPTION_REPLACE,                /* no arg */      EXPLAIN_REPLACE )
+      ( OPTION_REPLACE,                /* no arg */      EXPLAIN_REPLACE ) \
+      ( OPTION_JOBS",j",               _TYPE(INT32),     EXPLAIN_JOBS ) \
+      ( OPTION_SPLITFILE,              _TYPE(bool),      EXPLAIN_SPLITFILE )
 
    #define EXP_SINGLE_COLLECTION_OPTIONS \
       ( OPTION_COLLECTSPACE",c",       _TYPE(string),    EXPLAIN_COLLECTSPACE )\
@@ -239,7 +249,8 @@ namespace exprt
       }
    }
 
-   static const CHAR *formatNames[FORMAT_COUNT] = { "csv", "json" } ;
+   static const CHAR *formatNames[FORMAT_COUNT] = { "csv", "json",
+                                                    "columnar" } ;
    INT32 formatOfName( const string & name, EXP_FILE_FORMAT &format )
    {
       INT32 rc = SDB_INVALIDARG ;
@@ -305,6 +316,8 @@ namespace exprt
                               _errorStop     (FALSE),
                               _useSSL        (FALSE),
                               _fileLimit     (DEFAULT_FILELIMIT),
+                              _jobs          (1),
+                              _splitFile     (FALSE),
                               _skip          (0),
                               _limit         (-1),
                               _strict        (FALSE),
@@ -382,6 +395,8 @@ namespace exprt
       WRITE_BOOL_OPTION( writeBuf, OPTION_SSL, _useSSL, TRUE ) ;
       WRITE_STR_OPTION( writeBuf, OPTION_FLOATFMT, _floatFmt, TRUE ) ;
       WRITE_STR_OPTION( writeBuf, OPTION_REPLACE, "", _has( OPTION_REPLACE ) ) ;
+      WRITE_INT32_OPTION( writeBuf, OPTION_JOBS, (INT32)_jobs, _has(OPTION_JOBS) ) ;
+      WRITE_BOOL_OPTION( writeBuf, OPTION_SPLITFILE, _splitFile, _has(OPTION_SPLITFILE) ) ;
 
       WRITE_BOOL_OPTION( writeBuf, OPTION_STRICT, _strict, _has(OPTION_STRICT) ) ;
 
@@ -1131,6 +1146,24 @@ namespace exprt
 
       _replace = _has( OPTION_REPLACE ) ;
 
+      if ( _has(OPTION_JOBS) )
+      {
+         INT32 jobs = _get<INT32>(OPTION_JOBS) ;
+         if ( jobs < 1 || jobs > JOBS_MAX )
+         {
+            cerr << "invalid value for option \"" << OPTION_JOBS
+                 << "\", range: [1, " << JOBS_MAX << "]" << endl ;
+            PD_LOG( PDERROR, "invalid value for option \"" OPTION_JOBS "\"" ) ;
+            rc = SDB_INVALIDARG ;
+            goto error ;
+         }
+         _jobs = (UINT32)jobs ;
+      }
+      if ( _has(OPTION_SPLITFILE) )
+      {
+         _splitFile = _get<bool>(OPTION_SPLITFILE) ;
+      }
+
       rc = _setDelOptions() ;
       if ( SDB_OK != rc )
       {
@@ -46,6 +46,7 @@ namespace exprt
    {
       FORMAT_CSV = 0,
       FORMAT_JSON,
+      FORMAT_COLUMNAR,
 
 
       FORMAT_COUNT
@@ -97,6 +98,8 @@ namespace exprt
       inline EXP_FILE_FORMAT type()       const { return _type ; }
       inline const string &floatFmt()     const { return _floatFmt ; }
       inline BOOLEAN replace()            const { return _replace ; }
+      inline UINT32  jobs()               const { return _jobs ; }
+      inline BOOLEAN splitFile()          const { return _splitFile ; }
       
       inline const vector<string> &fieldsList() const 
       { 
@@ -139,6 +142,10 @@ namespace exprt
       string               _floatFmt ;
       BOOLEAN              _replace ;
 
+      /* parallel */
+      UINT32               _jobs ;
+      BOOLEAN              _splitFile ;
+
       /* single collection */
       string         _csName ;
       string         _clName ;
@@ -31,6 +31,7 @@
 #include "expOutput.hpp"
 #include "pd.hpp"
 #include "ossUtil.hpp"
+#include "ossIO.hpp"
 #include <sstream>
 #include <iostream>
 
@@ -259,6 +260,209 @@ namespace exprt
       goto done ;
    }
 
+   static bson_type findColumn( bson_iterator *pIt, fieldResolve *pFieldRe )
+   {
+      bson_type type = BSON_EOO ;
+      while ( BSON_EOO != ( type = bson_iterator_next( pIt ) ) )
+      {
+         if ( 0 != ossStrcmp( bson_iterator_key( pIt ), pFieldRe->pField ) )
+         {
+            continue ;
+         }
+         if ( NULL == pFieldRe->pSubField )
+         {
+            return type ;
+         }
+         if ( BSON_OBJECT == type || BSON_ARRAY == type )
+         {
+            bson_iterator sub ;
+            bson_iterator_subiterator( pIt, &sub ) ;
+            *pIt = sub ;
+            return findColumn( pIt, pFieldRe->pSubField ) ;
+         }
+         break ;
+      }
+      return BSON_EOO ;
+   }
+
+   static CHAR *putUINT16( CHAR *pos, UINT16 value )
+   {
+      pos[0] = (CHAR)( value & 0xFF ) ;
+      pos[1] = (CHAR)( ( value >> 8 ) & 0xFF ) ;
+      return pos + 2 ;
+   }
+
+   static CHAR *putUINT32( CHAR *pos, UINT32 value )
+   {
+      pos[0] = (CHAR)( value & 0xFF ) ;
+      pos[1] = (CHAR)( ( value >> 8 ) & 0xFF ) ;
+      pos[2] = (CHAR)( ( value >> 16 ) & 0xFF ) ;
+      pos[3] = (CHAR)( ( value >> 24 ) & 0xFF ) ;
+      return pos + 4 ;
+   }
+
+   INT32 expColumnConvertor::init()
+   {
+      INT32 rc = SDB_OK ;
+      UINT32 columnNum = 0 ;
+
+      rc = expJsonConvertor::init() ;
+      if ( SDB_OK != rc )
+      {
+         goto error ;
+      }
+
+      columnNum = (UINT32)_decodeBson._vFields.size() ;
+      if ( 0 == columnNum || columnNum > 0xFFFF )
+      {
+         PD_LOG ( PDERROR, "Invalid column number %u of %s.%s", columnNum,
+                  _cl.csName.c_str(), _cl.clName.c_str() ) ;
+         rc = SDB_INVALIDARG ;
+         goto error ;
+      }
+
+      _names.resize( columnNum ) ;
+      _bitmaps.resize( columnNum ) ;
+      _values.resize( columnNum ) ;
+      for ( UINT32 i = 0; i < columnNum; ++i )
+      {
+         appendCSVField( _decodeBson._vFields[i], _names[i] ) ;
+         if ( _names[i].size() > 0xFFFF )
+         {
+            PD_LOG ( PDERROR, "Column name is too long: %s",
+                     _names[i].c_str() ) ;
+            rc = SDB_INVALIDARG ;
+            goto error ;
+         }
+      }
+
+   done :
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   INT32 expColumnConvertor::convert( bson &fromRecord, 
+                                      const CHAR *&toBuf, 
+                                      UINT32 &toSize )
+   {
+      INT32 rc = SDB_OK ;
+      UINT32 bit = _recordNum % 8 ;
+
+      toBuf = NULL ;
+      toSize = 0 ;
+
+      for ( UINT32 i = 0; i < _names.size(); ++i )
+      {
+         bson_iterator it ;
+         bson_iterator next ;
+         bson_type type = BSON_EOO ;
+         const CHAR *value = NULL ;
+         UINT32 valueSize = 0 ;
+
+         if ( 0 == bit )
+         {
+            _bitmaps[i].push_back( 0 ) ;
+         }
+
+         bson_iterator_from_buffer( &it, fromRecord.data ) ;
+         type = findColumn( &it, _decodeBson._vFields[i] ) ;
+         if ( BSON_EOO == type || BSON_NULL == type ||
+              BSON_UNDEFINED == type )
+         {
+            continue ;
+         }
+
+         // the bson value is up to the next element
+         value = bson_iterator_value( &it ) ;
+         next = it ;
+         bson_iterator_next( &next ) ;
+         valueSize = (UINT32)( next.cur - value ) ;
+
+         _bitmaps[i][ _bitmaps[i].size() - 1 ] |= (CHAR)( 1 << bit ) ;
+         _values[i].push_back( (CHAR)type ) ;
+         _values[i].append( value, valueSize ) ;
+         _valueSize += valueSize + 1 ;
+      }
+      ++_recordNum ;
+
+      if ( _recordNum >= EXP_COLUMN_GROUP_RECORDS ||
+           _valueSize >= EXP_COLUMN_GROUP_SIZE )
+      {
+         rc = _flush( toBuf, toSize ) ;
+      }
+
+      return rc ;
+   }
+
+   INT32 expColumnConvertor::tail( const CHAR *&toBuf, UINT32 &toSize )
+   {
+      toBuf = NULL ;
+      toSize = 0 ;
+      if ( _recordNum > 0 )
+      {
+         return _flush( toBuf, toSize ) ;
+      }
+      return SDB_OK ;
+   }
+
+   INT32 expColumnConvertor::_flush( const CHAR *&toBuf, UINT32 &toSize )
+   {
+      INT32 rc = SDB_OK ;
+      UINT32 groupSize = EXP_COLUMN_HEADER_SIZE ;
+      CHAR *pos = NULL ;
+
+      for ( UINT32 i = 0; i < _names.size(); ++i )
+      {
+         groupSize += 2 + _names[i].size() ;
+         groupSize += 4 + _bitmaps[i].size() + _values[i].size() ;
+      }
+
+      toBuf = _getBuf( groupSize ) ;
+      if ( !toBuf )
+      {
+         PD_LOG ( PDERROR, "Failed to alloc buf sized %u ", groupSize ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+
+      pos = (CHAR*)toBuf ;
+      ossMemcpy( pos, EXP_COLUMN_MAGIC, 4 ) ;
+      pos += 4 ;
+      pos = putUINT16( pos, EXP_COLUMN_VERSION ) ;
+      pos = putUINT16( pos, (UINT16)_names.size() ) ;
+      pos = putUINT32( pos, groupSize ) ;
+      pos = putUINT32( pos, _recordNum ) ;
+
+      for ( UINT32 i = 0; i < _names.size(); ++i )
+      {
+         pos = putUINT16( pos, (UINT16)_names[i].size() ) ;
+         ossMemcpy( pos, _names[i].c_str(), _names[i].size() ) ;
+         pos += _names[i].size() ;
+      }
+      for ( UINT32 i = 0; i < _names.size(); ++i )
+      {
+         pos = putUINT32( pos, (UINT32)( _bitmaps[i].size() +
+                                         _values[i].size() ) ) ;
+         ossMemcpy( pos, _bitmaps[i].c_str(), _bitmaps[i].size() ) ;
+         pos += _bitmaps[i].size() ;
+         ossMemcpy( pos, _values[i].c_str(), _values[i].size() ) ;
+         pos += _values[i].size() ;
+         _bitmaps[i].clear() ;
+         _values[i].clear() ;
+      }
+      SDB_ASSERT( pos == toBuf + groupSize, "group size is wrong" ) ;
+
+      toSize = groupSize ;
+      _recordNum = 0 ;
+      _valueSize = 0 ;
+
+   done :
+      return rc ;
+   error :
+      goto done ;
+   }
+
    expCLFile::expCLFile( const expOptions &options, 
                          const string &fileName ) : 
                          _options(options), 
@@ -385,4 +589,197 @@ namespace exprt
       goto done ;
    }
    
+   expCLSpill::expCLSpill( const string &fileName, UINT32 blockSize ) :
+                           _fileName(fileName),
+                           _opened(FALSE),
+                           _block(NULL),
+                           _blockSize(blockSize),
+                           _used(0),
+                           _flushRC(SDB_OK)
+   {
+   }
+
+   expCLSpill::~expCLSpill()
+   {
+      _remove() ;
+      if ( _block )
+      {
+         SDB_OSS_FREE( _block ) ;
+         _block = NULL ;
+      }
+   }
+
+   INT32 expCLSpill::open()
+   {
+      INT32 rc = SDB_OK ;
+
+      SDB_ASSERT( !_opened, "cant open again" ) ;
+
+      _block = (CHAR*)SDB_OSS_MALLOC( _blockSize ) ;
+      if ( !_block )
+      {
+         PD_LOG ( PDERROR, "Failed to alloc buf sized %u ", _blockSize ) ;
+         rc = SDB_OOM ;
+         goto error ;
+      }
+
+      rc = ossOpen ( _fileName.c_str(),
+                     OSS_REPLACE | OSS_READWRITE | OSS_EXCLUSIVE,
+                     OSS_RU | OSS_WU | OSS_RG,
+                     _file ) ;
+      if ( SDB_OK != rc )
+      {
+          PD_LOG ( PDERROR, "Failed to open file %s, rc = %d",
+                   _fileName.c_str(), rc ) ;
+          goto error ;
+      }
+      _opened = TRUE ;
+
+   done :
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   void expCLSpill::close()
+   {
+      if ( _opened && _used > 0 && SDB_OK == _flushRC )
+      {
+         _flushRC = _flushBlock() ;
+      }
+   }
+
+   void expCLSpill::_remove()
+   {
+      if ( _opened )
+      {
+         ossClose( _file ) ;
+         ossDelete( _fileName.c_str() ) ;
+         _opened = FALSE ;
+      }
+   }
+
+   INT32 expCLSpill::_flushBlock()
+   {
+      INT32 rc = SDB_OK ;
+      SINT64 writed = 0 ;
+      UINT32 allWrited = 0 ;
+
+      while ( allWrited < _used )
+      {
+         rc = ossWrite ( &_file, _block + allWrited, _used - allWrited,
+                         &writed ) ;
+         if ( SDB_OK != rc && SDB_INTERRUPT != rc )
+         {
+            PD_LOG ( PDERROR, "Failed to write to file %s, rc = %d",
+                     _fileName.c_str(), rc ) ;
+            goto error ;
+         }
+         allWrited += ( (UINT32)writed ) ;
+         rc = SDB_OK ;
+      }
+      _blockLens.push_back( _used ) ;
+      _used = 0 ;
+
+   done :
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   INT32 expCLSpill::output( const CHAR *buf, UINT32 sz )
+   {
+      INT32 rc = SDB_OK ;
+
+      SDB_ASSERT( _opened, "not opened" ) ;
+
+      if ( _used > 0 && _used + sz > _blockSize )
+      {
+         rc = _flushBlock() ;
+         if ( SDB_OK != rc )
+         {
+            goto error ;
+         }
+      }
+
+      if ( sz > _blockSize )
+      {
+         // a large record is a block by itself
+         CHAR *block = (CHAR*)SDB_OSS_REALLOC( _block, sz ) ;
+         if ( !block )
+         {
+            PD_LOG ( PDERROR, "Failed to alloc buf sized %u ", sz ) ;
+            rc = SDB_OOM ;
+            goto error ;
+         }
+         _block = block ;
+         _blockSize = sz ;
+      }
+
+      ossMemcpy( _block + _used, buf, sz ) ;
+      _used += sz ;
+
+   done :
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   INT32 expCLSpill::replay( expCLOutput &out )
+   {
+      INT32 rc = _flushRC ;
+      SINT64 readed = 0 ;
+
+      if ( SDB_OK != rc )
+      {
+         goto error ;
+      }
+      else if ( !_opened )
+      {
+         goto done ;
+      }
+
+      rc = ossSeek( &_file, 0, OSS_SEEK_SET ) ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG ( PDERROR, "Failed to seek file %s, rc = %d",
+                  _fileName.c_str(), rc ) ;
+         goto error ;
+      }
+
+      for ( UINT32 i = 0; i < _blockLens.size(); ++i )
+      {
+         UINT32 blockLen = _blockLens[i] ;
+         UINT32 allReaded = 0 ;
+
+         SDB_ASSERT( blockLen <= _blockSize, "block is too large" ) ;
+         while ( allReaded < blockLen )
+         {
+            rc = ossRead( &_file, _block + allReaded, blockLen - allReaded,
+                          &readed ) ;
+            if ( SDB_OK != rc && SDB_INTERRUPT != rc )
+            {
+               PD_LOG ( PDERROR, "Failed to read file %s, rc = %d",
+                        _fileName.c_str(), rc ) ;
+               goto error ;
+            }
+            allReaded += (UINT32)readed ;
+            rc = SDB_OK ;
+         }
+
+         rc = out.output( _block, blockLen ) ;
+         if ( SDB_OK != rc )
+         {
+            PD_LOG ( PDERROR, "Failed to output the block, rc = %d", rc ) ;
+            goto error ;
+         }
+      }
+
+   done :
+      _remove() ;
+      return rc ;
+   error :
+      goto done ;
+   }
+
 }
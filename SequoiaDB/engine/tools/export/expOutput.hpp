@@ -39,6 +39,7 @@
 #include "expOptions.hpp"
 #include "expCL.hpp"
 #include <string>
+#include <vector>
 
 namespace exprt
 {
@@ -65,6 +66,8 @@ namespace exprt
       virtual INT32 convert( bson &fromRecord, 
                              const CHAR *&toBuf, 
                              UINT32 &toSize ) = 0 ;
+      // whether the record delimiter follows the head and each record
+      virtual BOOLEAN recordDelimited() const { return TRUE ; }
    protected :
       CHAR *_getBuf( UINT32 reqSize ) ;
       void  _freeBuf() ;
@@ -102,6 +105,49 @@ namespace exprt
                              UINT32 &toSize )  ;
    } ;
 
+   #define EXP_COLUMN_MAGIC            "SDBC"
+   #define EXP_COLUMN_VERSION          ( 1 )
+   #define EXP_COLUMN_HEADER_SIZE      ( 16 )
+   #define EXP_COLUMN_GROUP_RECORDS    ( 8192 )
+   #define EXP_COLUMN_GROUP_SIZE       ( 8 * 1024 * 1024 )
+
+   /*
+      expColumnConvertor define
+      The records are buffered by columns and output as row groups, each
+      one describes itself, so that the files can be concatenated or split
+      at the row groups. The integers are little-endian:
+         CHAR[4]  magic "SDBC"
+         UINT16   version
+         UINT16   column number
+         UINT32   group size, including the header
+         UINT32   record number
+         column names, each one is UINT16 length and the name without '\0'
+         column chunks, each one is UINT32 chunk size, the bitmap of the
+         records which have the value, and the values of these records. A
+         value is the bson type( UINT8 ) and the bson value. The missing,
+         null and undefined values are not in the bitmap.
+   */
+   class expColumnConvertor : public expJsonConvertor
+   {
+   public :
+      expColumnConvertor( const expOptions &options, const expCL &cl ) :
+         expJsonConvertor( options, cl ), _recordNum(0), _valueSize(0) {}
+      virtual INT32 init() ;
+      virtual INT32 tail( const CHAR *&toBuf, UINT32 &toSize ) ;
+      virtual INT32 convert( bson &fromRecord, 
+                             const CHAR *&toBuf, 
+                             UINT32 &toSize )  ;
+      virtual BOOLEAN recordDelimited() const { return FALSE ; }
+   private :
+      INT32 _flush( const CHAR *&toBuf, UINT32 &toSize ) ;
+   private :
+      vector<string>    _names ;
+      vector<string>    _bitmaps ;
+      vector<string>    _values ;
+      UINT32            _recordNum ;
+      UINT32            _valueSize ;
+   } ;
+
    class expCLOutput : public SDBObject
    {
    public :
@@ -129,5 +175,52 @@ namespace exprt
       UINT64            _writedSize ;
       UINT32            _fileSuffix ;
    } ;
+
+   /*
+      expCLOutputRef define
+      Share an opened output, which is opened and closed by the owner.
+   */
+   class expCLOutputRef : public expCLOutput
+   {
+   public :
+      explicit expCLOutputRef( expCLOutput &out ) : _out(out) {}
+      virtual INT32 output( const CHAR *buf, UINT32 sz )
+      {
+         return _out.output( buf, sz ) ;
+      }
+   private :
+      expCLOutput      &_out ;
+   } ;
+
+   /*
+      expCLSpill define
+      The output of a stream which is merged into the file later. It's
+      written by blocks, which are replayed to the file as they are, so
+      that the file still rolls by the limit at the boundaries of the
+      records in most cases. close() only flushes the last block, the file
+      is removed after replay or when the spill is destroyed.
+   */
+   class expCLSpill : public expCLOutput
+   {
+   public :
+      expCLSpill( const string &fileName, UINT32 blockSize ) ;
+      virtual ~expCLSpill() ;
+      virtual INT32 open() ;
+      virtual void  close() ;
+      virtual INT32 output( const CHAR *buf, UINT32 sz ) ;
+      INT32 replay( expCLOutput &out ) ;
+   protected :
+      INT32 _flushBlock() ;
+      void  _remove() ;
+   protected :
+      string            _fileName ;
+      OSSFILE           _file ;
+      BOOLEAN           _opened ;
+      CHAR             *_block ;
+      UINT32            _blockSize ;
+      UINT32            _used ;
+      INT32             _flushRC ;
+      vector<UINT32>    _blockLens ;
+   } ;
 }
 #endif
\ No newline at end of file
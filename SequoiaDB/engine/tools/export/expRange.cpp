@@ -0,0 +1,644 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2016 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = expRange.cpp
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who          Description
+   ====== =========== ============ =============================================
+          17/10/2026  LL           Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#include "expRange.hpp"
+#include "ossUtil.hpp"
+#include "pd.hpp"
+#include <math.h>
+#include <algorithm>
+
+namespace exprt
+{
+   #define EXP_FIELD_NAME        "Name"
+   #define EXP_FIELD_ISMAINCL    "IsMainCL"
+   #define EXP_FIELD_CATAINFO    "CataInfo"
+   #define EXP_FIELD_GROUPNAME   "GroupName"
+   #define EXP_FIELD_ID          "_id"
+
+   #define EXP_BOUND_BUF_SIZE    ( 64 )
+
+   INT32 expConnect( const expOptions &options, const string &hostName,
+                     const string &svcName, sdbConnectionHandle &hConn )
+   {
+      INT32 rc = SDB_OK ;
+      const CHAR *pHost = hostName.empty() ? options.hostName().c_str() :
+                                             hostName.c_str() ;
+      const CHAR *pSvc = hostName.empty() ? options.svcName().c_str() :
+                                            svcName.c_str() ;
+
+   #ifdef SDB_SSL
+      if ( options.useSSL() )
+      {
+         rc = sdbSecureConnect( pHost, pSvc,
+                                options.user().c_str(),
+                                options.password().c_str(),
+                                &hConn ) ;
+      }
+      else
+   #endif
+      {
+         rc = sdbConnect( pHost, pSvc,
+                          options.user().c_str(), options.password().c_str(),
+                          &hConn ) ;
+      }
+
+      if ( SDB_OK != rc )
+      {
+         PD_LOG ( PDERROR, "Failed to connect database %s:%s, rc = %d",
+                  pHost, pSvc, rc ) ;
+         goto error ;
+      }
+   done:
+      return rc ;
+   error:
+      goto done ;
+   }
+
+   static void expDisconnect( sdbConnectionHandle &hConn )
+   {
+      if ( SDB_INVALID_HANDLE != hConn )
+      {
+         sdbDisconnect( hConn ) ;
+         sdbReleaseConnection( hConn ) ;
+         hConn = SDB_INVALID_HANDLE ;
+      }
+   }
+
+   static void combineFilter( const string &filter, const string &cond,
+                              string &combined )
+   {
+      if ( filter.empty() )
+      {
+         combined = cond ;
+      }
+      else
+      {
+         combined = "{ \"$and\": [ " ;
+         combined += filter ;
+         combined += ", " ;
+         combined += cond ;
+         combined += " ] }" ;
+      }
+   }
+
+   // bounds are increasing, the n bounds make n + 1 conditions
+   static void boundsToConditions( const vector<string> &bounds,
+                                   vector<string> &conditions )
+   {
+      string cond ;
+      for ( UINT32 i = 0 ; i <= bounds.size() ; ++i )
+      {
+         cond = "{ \"" EXP_FIELD_ID "\": { " ;
+         if ( i > 0 )
+         {
+            cond += "\"$gte\": " ;
+            cond += bounds[ i - 1 ] ;
+         }
+         if ( i < bounds.size() )
+         {
+            cond += ( i > 0 ) ? ", \"$lt\": " : "\"$lt\": " ;
+            cond += bounds[ i ] ;
+         }
+         cond += " } }" ;
+         conditions.push_back( cond ) ;
+      }
+   }
+
+   static void oidBounds( bson_iterator *pMin, bson_iterator *pMax,
+                          UINT32 rangeNum, vector<string> &bounds )
+   {
+      UINT32 minTime = (UINT32)bson_oid_generated_time(
+                                             bson_iterator_oid( pMin ) ) ;
+      UINT32 maxTime = (UINT32)bson_oid_generated_time(
+                                             bson_iterator_oid( pMax ) ) ;
+      UINT32 span = 0 ;
+      CHAR hex[ 25 ] = { 0 } ;
+
+      if ( maxTime <= minTime )
+      {
+         return ;
+      }
+      span = maxTime - minTime ;
+      if ( rangeNum > span )
+      {
+         rangeNum = span ;
+      }
+
+      // the time is the leading 4 bytes in big-endian, the rest are zero
+      for ( UINT32 i = 1 ; i < rangeNum ; ++i )
+      {
+         bson_oid_t oid ;
+         UINT32 time = minTime + (UINT32)( (UINT64)span * i / rangeNum ) ;
+         ossMemset( &oid, 0, sizeof( oid ) ) ;
+         bson_big_endian32( &oid.ints[0], &time ) ;
+         bson_oid_to_string( &oid, hex ) ;
+         bounds.push_back( string( "{ \"$oid\": \"" ) + hex + "\" }" ) ;
+      }
+   }
+
+   static void longBounds( INT64 minValue, INT64 maxValue,
+                           UINT32 rangeNum, vector<string> &bounds )
+   {
+      UINT64 span = 0 ;
+      CHAR buf[ EXP_BOUND_BUF_SIZE ] = { 0 } ;
+
+      if ( maxValue <= minValue )
+      {
+         return ;
+      }
+      span = (UINT64)maxValue - (UINT64)minValue ;
+      if ( rangeNum > span )
+      {
+         rangeNum = (UINT32)span ;
+      }
+
+      for ( UINT32 i = 1 ; i < rangeNum ; ++i )
+      {
+         UINT64 offset = span / rangeNum * i + span % rangeNum * i / rangeNum ;
+         ossSnprintf( buf, sizeof( buf ), "%lld",
+                      (INT64)( (UINT64)minValue + offset ) ) ;
+         bounds.push_back( buf ) ;
+      }
+   }
+
+   static void doubleBounds( FLOAT64 minValue, FLOAT64 maxValue,
+                             UINT32 rangeNum, vector<string> &bounds )
+   {
+      FLOAT64 span = maxValue - minValue ;
+      FLOAT64 last = minValue ;
+      CHAR buf[ EXP_BOUND_BUF_SIZE ] = { 0 } ;
+
+      // also false for the NaN and infinity
+      if ( !( span > 0 ) || !( span < HUGE_VAL ) )
+      {
+         return ;
+      }
+
+      for ( UINT32 i = 1 ; i < rangeNum ; ++i )
+      {
+         FLOAT64 bound = 0 ;
+         ossSnprintf( buf, sizeof( buf ), "%.17g",
+                      minValue + span * i / rangeNum ) ;
+         // the bound is the one written, skip it when it doesn't increase
+         bound = ossAtof( buf ) ;
+         if ( bound <= last || bound >= maxValue )
+         {
+            continue ;
+         }
+         last = bound ;
+         bounds.push_back( buf ) ;
+      }
+   }
+
+   static BOOLEAN isNumberType( bson_type type )
+   {
+      return BSON_INT == type || BSON_LONG == type || BSON_DOUBLE == type ;
+   }
+
+   INT32 expRangePlanner::_getIdBound( sdbCollectionHandle hCL,
+                                       BOOLEAN isMax,
+                                       bson &record, BOOLEAN &found )
+   {
+      INT32 rc = SDB_OK ;
+      sdbCursorHandle hCursor = SDB_INVALID_HANDLE ;
+      bson orderBy ;
+
+      bson_init( &orderBy ) ;
+      found = FALSE ;
+
+      if ( BSON_OK != bson_append_int( &orderBy, EXP_FIELD_ID,
+                                       isMax ? -1 : 1 ) ||
+           BSON_OK != bson_finish( &orderBy ) )
+      {
+         rc = SDB_OOM ;
+         PD_LOG( PDERROR, "Failed to build the order of _id" ) ;
+         goto error ;
+      }
+
+      rc = sdbQuery( hCL, NULL, NULL, &orderBy, NULL, 0, 1, &hCursor ) ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG( PDERROR, "Failed to query the %s _id, rc = %d",
+                 isMax ? "max" : "min", rc ) ;
+         goto error ;
+      }
+
+      rc = sdbNext( hCursor, &record ) ;
+      if ( SDB_DMS_EOC == rc )
+      {
+         rc = SDB_OK ;
+         goto done ;
+      }
+      else if ( SDB_OK != rc )
+      {
+         PD_LOG( PDERROR, "Failed to get the %s _id, rc = %d",
+                 isMax ? "max" : "min", rc ) ;
+         goto error ;
+      }
+      found = TRUE ;
+
+   done :
+      if ( SDB_INVALID_HANDLE != hCursor )
+      {
+         sdbCloseCursor( hCursor ) ;
+         sdbReleaseCursor( hCursor ) ;
+      }
+      bson_destroy( &orderBy ) ;
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   INT32 expRangePlanner::_splitById( sdbConnectionHandle hConn,
+                                      const expCL &cl, UINT32 rangeNum,
+                                      vector<string> &conditions )
+   {
+      INT32 rc = SDB_OK ;
+      sdbCollectionHandle hCL = SDB_INVALID_HANDLE ;
+      string clFullName = cl.fullName() ;
+      vector<string> bounds ;
+      BOOLEAN foundMin = FALSE ;
+      BOOLEAN foundMax = FALSE ;
+      bson_iterator minIt ;
+      bson_iterator maxIt ;
+      bson_type minType = BSON_EOO ;
+      bson_type maxType = BSON_EOO ;
+      bson minRecord ;
+      bson maxRecord ;
+
+      bson_init( &minRecord ) ;
+      bson_init( &maxRecord ) ;
+
+      if ( rangeNum <= 1 )
+      {
+         goto done ;
+      }
+
+      rc = sdbGetCollection( hConn, clFullName.c_str(), &hCL ) ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG( PDERROR, "Failed to get collection %s, rc = %d",
+                 clFullName.c_str(), rc ) ;
+         goto error ;
+      }
+
+      rc = _getIdBound( hCL, FALSE, minRecord, foundMin ) ;
+      if ( SDB_OK != rc || !foundMin )
+      {
+         goto done ;
+      }
+      rc = _getIdBound( hCL, TRUE, maxRecord, foundMax ) ;
+      if ( SDB_OK != rc || !foundMax )
+      {
+         goto done ;
+      }
+
+      // the matcher compares the values of the same type only, so the
+      // records are covered when all the '_id' have the type of the bounds
+      minType = bson_find( &minIt, &minRecord, EXP_FIELD_ID ) ;
+      maxType = bson_find( &maxIt, &maxRecord, EXP_FIELD_ID ) ;
+      if ( BSON_OID == minType && BSON_OID == maxType )
+      {
+         oidBounds( &minIt, &maxIt, rangeNum, bounds ) ;
+      }
+      else if ( ( BSON_INT == minType || BSON_LONG == minType ) &&
+                ( BSON_INT == maxType || BSON_LONG == maxType ) )
+      {
+         longBounds( bson_iterator_long( &minIt ),
+                     bson_iterator_long( &maxIt ), rangeNum, bounds ) ;
+      }
+      else if ( isNumberType( minType ) && isNumberType( maxType ) )
+      {
+         doubleBounds( bson_iterator_double( &minIt ),
+                       bson_iterator_double( &maxIt ), rangeNum, bounds ) ;
+      }
+      else
+      {
+         PD_LOG( PDINFO, "The _id of collection %s are not split, "
+                 "the types are %d and %d", clFullName.c_str(),
+                 minType, maxType ) ;
+      }
+
+   done :
+      if ( SDB_OK == rc )
+      {
+         if ( bounds.empty() )
+         {
+            // the whole collection
+            conditions.push_back( "" ) ;
+         }
+         else
+         {
+            boundsToConditions( bounds, conditions ) ;
+         }
+      }
+      if ( SDB_INVALID_HANDLE != hCL )
+      {
+         sdbReleaseCollection( hCL ) ;
+      }
+      bson_destroy( &minRecord ) ;
+      bson_destroy( &maxRecord ) ;
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   INT32 expRangePlanner::_getGroups( const expCL &cl,
+                                      vector<string> &groups )
+   {
+      INT32 rc = SDB_OK ;
+      sdbCursorHandle hCursor = SDB_INVALID_HANDLE ;
+      string clFullName = cl.fullName() ;
+      bson_iterator it ;
+      bson_iterator itemIt ;
+      bson condition ;
+      bson record ;
+
+      bson_init( &condition ) ;
+      bson_init( &record ) ;
+
+      if ( BSON_OK != bson_append_string( &condition, EXP_FIELD_NAME,
+                                          clFullName.c_str() ) ||
+           BSON_OK != bson_finish( &condition ) )
+      {
+         rc = SDB_OOM ;
+         PD_LOG( PDERROR, "Failed to build the condition of catalog" ) ;
+         goto error ;
+      }
+
+      rc = sdbGetSnapshot( _hConn, SDB_SNAP_CATALOG, &condition,
+                           NULL, NULL, &hCursor ) ;
+      if ( SDB_RTN_COORD_ONLY == rc )
+      {
+         // standalone
+         rc = SDB_OK ;
+         goto done ;
+      }
+      else if ( SDB_OK != rc )
+      {
+         PD_LOG( PDERROR, "Failed to get the catalog of %s, rc = %d",
+                 clFullName.c_str(), rc ) ;
+         goto error ;
+      }
+
+      rc = sdbNext( hCursor, &record ) ;
+      if ( SDB_DMS_EOC == rc )
+      {
+         rc = SDB_OK ;
+         goto done ;
+      }
+      else if ( SDB_OK != rc )
+      {
+         PD_LOG( PDERROR, "Failed to get the catalog of %s, rc = %d",
+                 clFullName.c_str(), rc ) ;
+         goto error ;
+      }
+
+      // the sub-collections of a main-collection are not known here
+      if ( BSON_BOOL == bson_find( &it, &record, EXP_FIELD_ISMAINCL ) &&
+           bson_iterator_bool( &it ) )
+      {
+         goto done ;
+      }
+      if ( BSON_ARRAY != bson_find( &it, &record, EXP_FIELD_CATAINFO ) )
+      {
+         goto done ;
+      }
+
+      bson_iterator_subiterator( &it, &itemIt ) ;
+      while ( bson_iterator_next( &itemIt ) )
+      {
+         bson_iterator groupIt ;
+         string groupName ;
+
+         if ( BSON_OBJECT != bson_iterator_type( &itemIt ) )
+         {
+            continue ;
+         }
+         bson_iterator_subiterator( &itemIt, &groupIt ) ;
+         while ( bson_iterator_next( &groupIt ) )
+         {
+            if ( BSON_STRING == bson_iterator_type( &groupIt ) &&
+                 0 == ossStrcmp( bson_iterator_key( &groupIt ),
+                                 EXP_FIELD_GROUPNAME ) )
+            {
+               groupName = bson_iterator_string( &groupIt ) ;
+               break ;
+            }
+         }
+         if ( groupName.empty() )
+         {
+            continue ;
+         }
+         // a group has several ranges of the hash or range sharding
+         if ( groups.end() == std::find( groups.begin(), groups.end(),
+                                         groupName ) )
+         {
+            groups.push_back( groupName ) ;
+         }
+      }
+
+   done :
+      if ( SDB_INVALID_HANDLE != hCursor )
+      {
+         sdbCloseCursor( hCursor ) ;
+         sdbReleaseCursor( hCursor ) ;
+      }
+      bson_destroy( &condition ) ;
+      bson_destroy( &record ) ;
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   INT32 expRangePlanner::_getPrimary( const string &groupName,
+                                       string &hostName, string &svcName )
+   {
+      INT32 rc = SDB_OK ;
+      sdbReplicaGroupHandle hGroup = SDB_INVALID_HANDLE ;
+      sdbNodeHandle hNode = SDB_INVALID_HANDLE ;
+      const CHAR *pHost = NULL ;
+      const CHAR *pSvc = NULL ;
+
+      rc = sdbGetReplicaGroup( _hConn, groupName.c_str(), &hGroup ) ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG( PDERROR, "Failed to get group %s, rc = %d",
+                 groupName.c_str(), rc ) ;
+         goto error ;
+      }
+
+      rc = sdbGetNodeMaster( hGroup, &hNode ) ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG( PDERROR, "Failed to get the primary of group %s, rc = %d",
+                 groupName.c_str(), rc ) ;
+         goto error ;
+      }
+
+      rc = sdbGetNodeAddr( hNode, &pHost, &pSvc, NULL, NULL ) ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG( PDERROR, "Failed to get the address of the primary of "
+                 "group %s, rc = %d", groupName.c_str(), rc ) ;
+         goto error ;
+      }
+      hostName = pHost ;
+      svcName = pSvc ;
+
+   done :
+      if ( SDB_INVALID_HANDLE != hNode )
+      {
+         sdbReleaseNode( hNode ) ;
+      }
+      if ( SDB_INVALID_HANDLE != hGroup )
+      {
+         sdbReleaseReplicaGroup( hGroup ) ;
+      }
+      return rc ;
+   error :
+      goto done ;
+   }
+
+   INT32 expRangePlanner::plan( const expCL &cl, UINT32 rangeNum,
+                                vector<expCLRange> &ranges )
+   {
+      INT32 rc = SDB_OK ;
+      string clFullName = cl.fullName() ;
+      vector<string> groups ;
+      vector<string> conditions ;
+
+      ranges.clear() ;
+
+      // the order, skip and limit are of the whole result
+      if ( rangeNum <= 1 || !cl.sort.empty() || cl.skip > 0 || cl.limit >= 0 )
+      {
+         if ( rangeNum > 1 )
+         {
+            PD_LOG( PDINFO, "Collection %s is exported by one stream, "
+                    "as it has sort, skip or limit", clFullName.c_str() ) ;
+         }
+         ranges.push_back( expCLRange( cl ) ) ;
+         goto done ;
+      }
+
+      rc = _getGroups( cl, groups ) ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG( PDERROR, "Failed to get the groups of collection %s, "
+                 "rc = %d", clFullName.c_str(), rc ) ;
+         goto error ;
+      }
+
+      if ( groups.size() > 1 )
+      {
+         UINT32 groupRangeNum = ( rangeNum + groups.size() - 1 ) /
+                                groups.size() ;
+         for ( vector<string>::const_iterator it = groups.begin() ;
+               groups.end() != it ; ++it )
+         {
+            sdbConnectionHandle hNode = SDB_INVALID_HANDLE ;
+            string hostName ;
+            string svcName ;
+
+            rc = _getPrimary( *it, hostName, svcName ) ;
+            if ( SDB_OK == rc )
+            {
+               rc = expConnect( _options, hostName, svcName, hNode ) ;
+            }
+            if ( SDB_OK != rc )
+            {
+               break ;
+            }
+
+            conditions.clear() ;
+            rc = _splitById( hNode, cl, groupRangeNum, conditions ) ;
+            expDisconnect( hNode ) ;
+            if ( SDB_OK != rc )
+            {
+               break ;
+            }
+
+            for ( vector<string>::const_iterator condIt = conditions.begin() ;
+                  conditions.end() != condIt ; ++condIt )
+            {
+               ranges.push_back( expCLRange( cl ) ) ;
+               expCLRange &range = ranges.back() ;
+               if ( !condIt->empty() )
+               {
+                  combineFilter( cl.filter, *condIt, range.cl.filter ) ;
+               }
+               range.groupName = *it ;
+               range.hostName = hostName ;
+               range.svcName = svcName ;
+            }
+         }
+
+         if ( SDB_OK == rc )
+         {
+            goto done ;
+         }
+         // the primaries may be unreachable from here, read by the
+         // coordinator instead
+         PD_LOG( PDWARNING, "Failed to split collection %s by groups, "
+                 "rc = %d, split by the coordinator", clFullName.c_str(),
+                 rc ) ;
+         ranges.clear() ;
+         rc = SDB_OK ;
+      }
+
+      conditions.clear() ;
+      rc = _splitById( _hConn, cl, rangeNum, conditions ) ;
+      if ( SDB_OK != rc )
+      {
+         PD_LOG( PDERROR, "Failed to split collection %s by _id, rc = %d",
+                 clFullName.c_str(), rc ) ;
+         goto error ;
+      }
+      for ( vector<string>::const_iterator condIt = conditions.begin() ;
+            conditions.end() != condIt ; ++condIt )
+      {
+         ranges.push_back( expCLRange( cl ) ) ;
+         if ( !condIt->empty() )
+         {
+            combineFilter( cl.filter, *condIt, ranges.back().cl.filter ) ;
+         }
+      }
+
+   done :
+      PD_LOG( PDINFO, "Collection %s is split into %u ranges",
+              clFullName.c_str(), (UINT32)ranges.size() ) ;
+      return rc ;
+   error :
+      goto done ;
+   }
+}
+
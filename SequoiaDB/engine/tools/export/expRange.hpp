@@ -0,0 +1,95 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2016 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = expRange.hpp
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who          Description
+   ====== =========== ============ =============================================
+          17/10/2026  LL           Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+#ifndef EXP_RANGE_HPP_
+#define EXP_RANGE_HPP_
+
+#include "oss.hpp"
+#include "../client/bson/bson.h"
+#include "../client/client.h"
+#include "expOptions.hpp"
+#include "expCL.hpp"
+#include <vector>
+#include <string>
+
+namespace exprt
+{
+   using namespace std ;
+
+   /*
+      expCLRange define
+      A part of the collection read by one cursor. The filter of the cl
+      includes the range. The range is read from the node of the address,
+      or from the coordinator when the address is empty.
+   */
+   struct expCLRange : public SDBObject
+   {
+      expCL    cl ;
+      string   groupName ;
+      string   hostName ;
+      string   svcName ;
+
+      expCLRange( const expCL &cl_ ) : cl(cl_) {}
+   } ;
+
+   /*
+      expRangePlanner define
+      Split the collection by the groups which it's on, and by the '_id'
+      inside a group, the ranges are in the order of the group and '_id'.
+      The '_id' is split only when the min and max are both ObjectId or
+      both number, as all the '_id' in between have the same type then.
+   */
+   class expRangePlanner : public SDBObject
+   {
+   public :
+      expRangePlanner( const expOptions &options, sdbConnectionHandle hConn ) :
+         _options(options), _hConn(hConn)
+      {
+      }
+      INT32 plan( const expCL &cl, UINT32 rangeNum,
+                  vector<expCLRange> &ranges ) ;
+   private :
+      INT32 _getGroups( const expCL &cl, vector<string> &groups ) ;
+      INT32 _getPrimary( const string &groupName,
+                         string &hostName, string &svcName ) ;
+      INT32 _splitById( sdbConnectionHandle hConn, const expCL &cl,
+                        UINT32 rangeNum, vector<string> &conditions ) ;
+      INT32 _getIdBound( sdbCollectionHandle hCL, BOOLEAN isMax,
+                         bson &record, BOOLEAN &found ) ;
+   private :
+      const expOptions    &_options ;
+      sdbConnectionHandle  _hConn ;
+   } ;
+
+   INT32 expConnect( const expOptions &options, const string &hostName,
+                     const string &svcName, sdbConnectionHandle &hConn ) ;
+}
+
+#endif
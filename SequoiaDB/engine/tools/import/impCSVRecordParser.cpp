@@ -32,6 +32,7 @@
 #include "../client/base64c.h"
 #include "ossUtil.h"
 #include "pd.hpp"
+#include "utilCharScan.hpp"
 #include <cctype>
 #include <cmath>
 #include <iostream>
@@ -1641,7 +1642,9 @@ namespace import
       CHAR* str = (CHAR*)data;
       INT32 len = length;
       INT32 rc = SDB_OK;
+      INT32 skip = 0;
       BOOLEAN inString = FALSE;
+      const CHAR stopChars[2] = { strDel[0], fieldDel[0] };
       fieldEnd = FALSE;
 
       SDB_ASSERT(NULL != data, "data can't be NULL");
@@ -1659,6 +1662,16 @@ namespace import
 
       while (len > 0)
       {
+         // the field delimiter is a part of the value in string
+         skip = engine::utilScanChars(str, len, stopChars,
+                                      inString ? 1 : 2);
+         str += skip;
+         len -= skip;
+         if (0 == len)
+         {
+            break;
+         }
+
          if (_startWith(str, len, strDel, strDelLen))
          {
             /*if ('\\' == *(str - 1))
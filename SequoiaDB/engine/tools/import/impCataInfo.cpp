@@ -59,6 +59,13 @@ namespace import
       return _cataSet->getAllGroupID()->size();
    }
 
+   INT32 CataInfo::getVersion()
+   {
+      SDB_ASSERT(NULL != _cataSet, "must be inited");
+
+      return _cataSet->getVersion();
+   }
+
    INT32 CataInfo::getGroupByRecord(const char* bsonData, UINT32& groupId)
    {
       INT32 rc = SDB_OK;
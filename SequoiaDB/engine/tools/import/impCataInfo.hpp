@@ -51,6 +51,7 @@ namespace import
       CataInfo();
       ~CataInfo();
       INT32 getGroupNum();
+      INT32 getVersion();
       BOOLEAN isMainCL();
       INT32 getSubCLList(vector<string>& list);
       INT32 getGroupByRecord(const char* bsonData, UINT32& groupId);
@@ -74,7 +74,8 @@ namespace import
                               options->clname(),
                               options->useSSL(),
                               options->enableTransaction(),
-                              options->allowKeyDuplication());
+                              options->allowKeyDuplication(),
+                              options->bulkLoad());
 
       SDB_ASSERT(NULL != workQueue, "workQueue can't be NULL");
       SDB_ASSERT(NULL != logFile, "logFile can't be NULL");
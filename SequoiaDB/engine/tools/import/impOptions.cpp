@@ -72,6 +72,7 @@ namespace import
    #define IMP_OPTION_COORD             "coord"
    #define IMP_OPTION_TRANSACTION       "transaction"
    #define IMP_OPTION_ALLOWKEYDUP       "allowkeydup"
+   #define IMP_OPTION_BULKLOAD          "bulkload"
    #define IMP_OPTION_HELPFULL          "helpfull"
    #define IMP_OPTION_RECORDSMEM        "recordsmem"
    #define IMP_OPTION_CAST              "cast"
@@ -114,6 +115,7 @@ namespace import
    #define IMP_EXPLAIN_COORD            "find coordinators automatically, default: true"
    #define IMP_EXPLAIN_TRANSACTION      "enable transaction, default: false"
    #define IMP_EXPLAIN_ALLOWKEYDUP      "allow key duplication, default: true"
+   #define IMP_EXPLAIN_BULKLOAD         "load record blocks to the primary data nodes directly, can't be used with transaction, default: false"
    #define IMP_EXPLAIN_HELPFULL         "print all options"
    #define IMP_EXPLAIN_RECORDSMEM       "the maximum memory size used by records, the unit is MB, range is [128~81920], default: 512"
    #define IMP_EXPLAIN_CAST             "allow type cast when lost precision, default: false"
@@ -158,6 +160,7 @@ namespace import
       (IMP_OPTION_SHARDING,            _TYPE(string),    IMP_EXPLAIN_SHARDING) \
       (IMP_OPTION_TRANSACTION,         _TYPE(string),    IMP_EXPLAIN_TRANSACTION) \
       (IMP_OPTION_ALLOWKEYDUP,         _TYPE(string),    IMP_EXPLAIN_ALLOWKEYDUP) \
+      (IMP_OPTION_BULKLOAD,            _TYPE(string),    IMP_EXPLAIN_BULKLOAD) \
 
    #define IMP_INPUT_OPTIONS \
       (IMP_OPTION_FILENAME,            _TYPE(string),    IMP_EXPLAIN_FILENAME) \
@@ -471,6 +474,7 @@ namespace import
       _enableCoord = TRUE;
       _enableTransaction = FALSE;
       _allowKeyDuplication = TRUE;
+      _bulkLoad = FALSE;
 
       _stringDelimiter = "\"";
       _fieldDelimiter = ",";
@@ -986,6 +990,21 @@ namespace import
          ossStrToBoolean(allowKeyDup.c_str(), &_allowKeyDuplication);
       }
 
+      if (has(IMP_OPTION_BULKLOAD))
+      {
+         string bulkLoad = get<string>(IMP_OPTION_BULKLOAD);
+         ossStrToBoolean(bulkLoad.c_str(), &_bulkLoad);
+      }
+
+      if (_bulkLoad && _enableTransaction)
+      {
+         std::cerr << IMP_OPTION_BULKLOAD " can't be used with "
+                   IMP_OPTION_TRANSACTION
+                   << std::endl;
+         rc = SDB_INVALIDARG;
+         goto error;
+      }
+
       if (has(IMP_OPTION_RECORDSMEM))
       {
          INT64 recordsMem = get<INT32>(IMP_OPTION_RECORDSMEM);
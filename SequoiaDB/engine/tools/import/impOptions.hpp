@@ -94,6 +94,7 @@ namespace import
       inline BOOLEAN enableCoord() const { return _enableCoord; }
       inline BOOLEAN enableTransaction() const { return _enableTransaction; }
       inline BOOLEAN allowKeyDuplication() const { return _allowKeyDuplication; }
+      inline BOOLEAN bulkLoad() const { return _bulkLoad; }
 
       /* input */
       inline const vector<string>& files() const { return _files; }
@@ -149,6 +150,7 @@ namespace import
       BOOLEAN        _enableCoord;
       BOOLEAN        _enableTransaction;
       BOOLEAN        _allowKeyDuplication;
+      BOOLEAN        _bulkLoad;
 
       /* input */
       vector<string> _files;
@@ -36,6 +36,11 @@
 namespace import
 {
    #define IMP_MAX_RECORDS_SIZE (SDB_MAX_MSG_LENGTH - 1024 * 1024 * 1)
+   // the size of the block loaded to the data node at a time
+   #define IMP_BULK_BLOCK_SIZE (4 * 1024 * 1024)
+   // the size of the generated _id element: type, "_id" and oid
+   #define IMP_BULK_OID_ELE_SIZE (1 + 4 + 12)
+   #define IMP_ID_FIELD_NAME "_id"
 
    RecordImporter::RecordImporter(const string& hostname,
                                   const string& svcname,
@@ -45,7 +50,8 @@ namespace import
                                   const string& clname,
                                   BOOLEAN useSSL,
                                   BOOLEAN enableTransaction,
-                                  BOOLEAN allowKeyDuplication)
+                                  BOOLEAN allowKeyDuplication,
+                                  BOOLEAN bulkLoad)
    : _hostname(hostname),
      _svcname(svcname),
      _user(user),
@@ -54,11 +60,14 @@ namespace import
      _clname(clname),
      _useSSL(useSSL),
      _enableTransaction(enableTransaction),
-     _allowKeyDuplication(allowKeyDuplication)
+     _allowKeyDuplication(allowKeyDuplication),
+     _enableBulkLoad(bulkLoad)
    {
       _connection = 0;
       _collectionSpace = 0;
       _collection = 0;
+      _block = NULL;
+      _blockCapacity = 0;
    }
 
    RecordImporter::~RecordImporter()
@@ -136,6 +145,18 @@ namespace import
 
    void RecordImporter::disconnect()
    {
+      while (!_primaryConnections.empty())
+      {
+         _releasePrimaryConnection(_primaryConnections.begin()->first);
+      }
+
+      if (NULL != _block)
+      {
+         SDB_OSS_FREE(_block);
+         _block = NULL;
+         _blockCapacity = 0;
+      }
+
       if (0 != _collection)
       {
          sdbReleaseCollection(_collection);
@@ -217,6 +238,18 @@ namespace import
       SDB_ASSERT(NULL != array, "array can't be NULL");
       SDB_ASSERT(!array->empty(), "array can't be empty");
 
+      // the records which are not sharded are inserted by coordinator
+      if (_enableBulkLoad && 0 != array->groupId())
+      {
+         rc = _bulkLoad(array);
+         if (SDB_OK != rc)
+         {
+            PD_LOG(PDERROR, "failed to bulk load records, rc=%d", rc);
+            goto error;
+         }
+         goto done;
+      }
+
       size = array->size();
       records = array->array();
 
@@ -275,4 +308,250 @@ namespace import
    error:
       goto done;
    }
+
+   INT32 RecordImporter::_bulkLoad(RecordArray* array)
+   {
+      INT32 rc = SDB_OK;
+      INT32 i = 0;
+      INT32 start = 0;
+      INT32 blockSize = 0;
+      INT32 size = array->size();
+      bson** records = array->array();
+
+      for (; i < size; i++)
+      {
+         bson* obj = records[i];
+         SDB_ASSERT(NULL != obj, "obj can't be NULL");
+
+         INT32 objSize = bson_size(obj) + IMP_BULK_OID_ELE_SIZE;
+
+         if (i > start && blockSize + objSize > IMP_BULK_BLOCK_SIZE)
+         {
+            rc = _loadBlock(array, &records[start], i - start, blockSize);
+            if (SDB_OK != rc)
+            {
+               goto error;
+            }
+            start = i;
+            blockSize = 0;
+         }
+
+         rc = _appendToBlock(obj, blockSize);
+         if (SDB_OK != rc)
+         {
+            goto error;
+         }
+      }
+
+      if (i > start)
+      {
+         rc = _loadBlock(array, &records[start], i - start, blockSize);
+         if (SDB_OK != rc)
+         {
+            goto error;
+         }
+      }
+
+   done:
+      return rc;
+   error:
+      goto done;
+   }
+
+   INT32 RecordImporter::_loadBlock(RecordArray* array,
+                                    bson* objs[], INT32 num,
+                                    INT32 blockSize)
+   {
+      INT32 rc = SDB_OK;
+      sdbConnectionHandle conn = SDB_INVALID_HANDLE;
+      UINT32 groupId = array->groupId();
+      const string& collection = array->collection();
+
+      rc = _getPrimaryConnection(groupId, conn);
+      if (SDB_OK == rc)
+      {
+         rc = sdbBulkLoad(conn, collection.c_str(), _block, blockSize, num,
+                          array->version());
+         if (SDB_OK == rc)
+         {
+            goto done;
+         }
+
+         if (SDB_CLS_NOT_PRIMARY == rc ||
+             SDB_NETWORK == rc ||
+             SDB_NETWORK_CLOSE == rc)
+         {
+            // the primary may be changed, find it again next time
+            _releasePrimaryConnection(groupId);
+         }
+         // when the catalog is changed, or the collection is being split
+         // or full synced, the records are routed by the coordinator
+         else if (SDB_OPTION_NOT_SUPPORT != rc &&
+                  SDB_CLS_COORD_NODE_CAT_VER_OLD != rc &&
+                  SDB_CLS_DATA_NODE_CAT_VER_OLD != rc &&
+                  SDB_CLS_NO_CATALOG_INFO != rc &&
+                  SDB_CLS_MUTEX_TASK_EXIST != rc &&
+                  !(SDB_IXM_DUP_KEY == rc && _allowKeyDuplication))
+         {
+            PD_LOG(PDERROR, "failed to bulk load records to %s, rc=%d",
+                   collection.c_str(), rc);
+            goto error;
+         }
+      }
+
+      // the block is loaded as a whole, so none of the records is loaded,
+      // insert them by coordinator instead
+      PD_LOG(PDWARNING, "failed to bulk load records to %s of group %u, "
+             "insert them instead, rc=%d", collection.c_str(), groupId, rc);
+      rc = import(objs, num);
+      if (SDB_OK != rc)
+      {
+         PD_LOG(PDERROR, "failed to import records, rc=%d", rc);
+         goto error;
+      }
+
+   done:
+      return rc;
+   error:
+      goto done;
+   }
+
+   INT32 RecordImporter::_appendToBlock(bson* obj, INT32& blockSize)
+   {
+      INT32 rc = SDB_OK;
+      bson_iterator it;
+      INT32 objSize = bson_size(obj);
+      BOOLEAN hasOID = (BSON_EOO != bson_find(&it, obj, IMP_ID_FIELD_NAME));
+      INT32 recordSize = hasOID ? objSize : objSize + IMP_BULK_OID_ELE_SIZE;
+      INT32 newSize = blockSize + ossRoundUpToMultipleX(recordSize, 4);
+      CHAR* record = NULL;
+
+      if (newSize > _blockCapacity)
+      {
+         INT32 capacity = newSize > IMP_BULK_BLOCK_SIZE ?
+                          newSize : IMP_BULK_BLOCK_SIZE;
+         CHAR* block = (CHAR*)SDB_OSS_REALLOC(_block, capacity);
+         if (NULL == block)
+         {
+            rc = SDB_OOM;
+            PD_LOG(PDERROR, "failed to alloc block, size=%d, rc=%d",
+                   capacity, rc);
+            goto error;
+         }
+         _block = block;
+         _blockCapacity = capacity;
+      }
+
+      record = _block + blockSize;
+      if (hasOID)
+      {
+         ossMemcpy(record, bson_data(obj), objSize);
+      }
+      else
+      {
+         // every loaded record must have _id, put it at the first
+         // as the server does
+         bson_oid_t oid;
+         bson_oid_gen(&oid);
+
+         *(INT32*)record = recordSize;
+         record[4] = (CHAR)BSON_OID;
+         ossMemcpy(record + 5, IMP_ID_FIELD_NAME, 4);
+         ossMemcpy(record + 9, &oid, sizeof(oid));
+         ossMemcpy(record + 4 + IMP_BULK_OID_ELE_SIZE,
+                   bson_data(obj) + 4, objSize - 4);
+      }
+      ossMemset(record + recordSize, 0, newSize - blockSize - recordSize);
+      blockSize = newSize;
+
+   done:
+      return rc;
+   error:
+      goto done;
+   }
+
+   INT32 RecordImporter::_getPrimaryConnection(UINT32 groupId,
+                                               sdbConnectionHandle& conn)
+   {
+      INT32 rc = SDB_OK;
+      sdbReplicaGroupHandle group = SDB_INVALID_HANDLE;
+      sdbNodeHandle node = SDB_INVALID_HANDLE;
+      const CHAR* hostname = NULL;
+      const CHAR* svcname = NULL;
+      map<UINT32, sdbConnectionHandle>::iterator it;
+
+      it = _primaryConnections.find(groupId);
+      if (it != _primaryConnections.end())
+      {
+         conn = it->second;
+         goto done;
+      }
+
+      rc = sdbGetReplicaGroup1(_connection, groupId, &group);
+      if (SDB_OK != rc)
+      {
+         PD_LOG(PDERROR, "failed to get group %u, rc=%d", groupId, rc);
+         goto error;
+      }
+
+      rc = sdbGetNodeMaster(group, &node);
+      if (SDB_OK != rc)
+      {
+         PD_LOG(PDERROR, "failed to get primary of group %u, rc=%d",
+                groupId, rc);
+         goto error;
+      }
+
+      rc = sdbGetNodeAddr(node, &hostname, &svcname, NULL, NULL);
+      if (SDB_OK != rc)
+      {
+         PD_LOG(PDERROR, "failed to get address of primary, rc=%d", rc);
+         goto error;
+      }
+
+      if (_useSSL)
+      {
+         rc = sdbSecureConnect(hostname, svcname,
+                               _user.c_str(), _password.c_str(), &conn);
+      }
+      else
+      {
+         rc = sdbConnect(hostname, svcname,
+                         _user.c_str(), _password.c_str(), &conn);
+      }
+      if (SDB_OK != rc)
+      {
+         PD_LOG(PDERROR, "failed to connect to primary %s:%s, rc=%d",
+                hostname, svcname, rc);
+         goto error;
+      }
+
+      _primaryConnections[groupId] = conn;
+
+   done:
+      if (SDB_INVALID_HANDLE != node)
+      {
+         sdbReleaseNode(node);
+      }
+      if (SDB_INVALID_HANDLE != group)
+      {
+         sdbReleaseReplicaGroup(group);
+      }
+      return rc;
+   error:
+      goto done;
+   }
+
+   void RecordImporter::_releasePrimaryConnection(UINT32 groupId)
+   {
+      map<UINT32, sdbConnectionHandle>::iterator it;
+
+      it = _primaryConnections.find(groupId);
+      if (it != _primaryConnections.end())
+      {
+         sdbDisconnect(it->second);
+         sdbReleaseConnection(it->second);
+         _primaryConnections.erase(it);
+      }
+   }
 }
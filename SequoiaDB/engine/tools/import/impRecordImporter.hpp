@@ -36,6 +36,7 @@
 #include "impRecordQueue.hpp"
 #include "../client/client.h"
 #include <string>
+#include <map>
 
 using namespace std;
 
@@ -52,13 +53,22 @@ namespace import
                      const string& clname,
                      BOOLEAN useSSL = FALSE,
                      BOOLEAN enableTransaction = FALSE,
-                     BOOLEAN allowKeyDuplication = TRUE);
+                     BOOLEAN allowKeyDuplication = TRUE,
+                     BOOLEAN bulkLoad = FALSE);
       ~RecordImporter();
       INT32 connect();
       void disconnect();
       INT32 import(bson* objs[], INT32 num);
       INT32 import(RecordArray* array);
 
+   private:
+      INT32 _bulkLoad(RecordArray* array);
+      INT32 _loadBlock(RecordArray* array, bson* objs[], INT32 num,
+                       INT32 blockSize);
+      INT32 _appendToBlock(bson* obj, INT32& blockSize);
+      INT32 _getPrimaryConnection(UINT32 groupId, sdbConnectionHandle& conn);
+      void  _releasePrimaryConnection(UINT32 groupId);
+
    private:
       string   _hostname;
       string   _svcname;
@@ -69,10 +79,16 @@ namespace import
       BOOLEAN  _useSSL;
       BOOLEAN  _enableTransaction;
       BOOLEAN  _allowKeyDuplication;
+      BOOLEAN  _enableBulkLoad;
 
       sdbConnectionHandle  _connection;
       sdbCSHandle          _collectionSpace;
       sdbCollectionHandle  _collection;
+
+      // group id -> connection of the primary node
+      map<UINT32, sdbConnectionHandle> _primaryConnections;
+      CHAR*    _block;
+      INT32    _blockCapacity;
    };
 }
 
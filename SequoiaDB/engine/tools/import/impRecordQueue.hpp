@@ -35,6 +35,7 @@
 #include "ossUtil.h"
 #include "../client/bson/bson.h"
 #include "pd.hpp"
+#include <string>
 
 namespace import
 {
@@ -48,6 +49,8 @@ namespace import
          _size = 0;
          _bsonSize = 0;
          _finished = FALSE;
+         _groupId = 0;
+         _version = -1;
       }
 
       ~BsonArray()
@@ -158,12 +161,41 @@ namespace import
          return obj;
       }
 
+      // the collection and the group which the records belong to, and
+      // the catalog version by which they are routed. The group id is 0 if
+      // the records are not sharded
+      inline void setTarget(const std::string& collection, UINT32 groupId,
+                            INT32 version)
+      {
+         _collection = collection;
+         _groupId = groupId;
+         _version = version;
+      }
+
+      inline const std::string& collection() const
+      {
+         return _collection;
+      }
+
+      inline UINT32 groupId() const
+      {
+         return _groupId;
+      }
+
+      inline INT32 version() const
+      {
+         return _version;
+      }
+
    private:
-      bson**   _array;
-      INT32    _capacity;
-      INT32    _size;
-      INT64    _bsonSize;
-      BOOLEAN  _finished;
+      bson**      _array;
+      INT32       _capacity;
+      INT32       _size;
+      INT64       _bsonSize;
+      BOOLEAN     _finished;
+      std::string _collection;
+      UINT32      _groupId;
+      INT32       _version;
    };
 
    typedef class BsonArray RecordArray;
@@ -31,6 +31,7 @@
 #include "impRecordScanner.hpp"
 #include "ossUtil.h"
 #include "pd.hpp"
+#include "utilCharScan.hpp"
 
 namespace import
 {
@@ -96,6 +97,7 @@ namespace import
       const INT32 recDelLen = _recordDelimiter.length();   
       INT32 len = length;
       CHAR* str = (CHAR*)data;
+      INT32 skip = 0;
       INT32 rc = SDB_EOF;
 
       SDB_ASSERT(NULL != data, "data can't be NULL");
@@ -106,6 +108,15 @@ namespace import
       {
          while(len > 0)
          {
+            // skip to the next candidate of the record delimiter
+            skip = engine::utilScanChars(str, len, recDel, 1);
+            len -= skip;
+            str += skip;
+            if (0 == len)
+            {
+               break;
+            }
+
             if (_startWith(str, len, recDel, recDelLen))
             {
                recordLength = length - len;
@@ -122,10 +133,27 @@ namespace import
       {
          const CHAR* strDel = _stringDelimiter.c_str();
          const INT32 strDelLen = _stringDelimiter.length();
+         const CHAR outChars[2] = { recDel[0], strDel[0] };
          BOOLEAN inString = FALSE;
 
          while (len > 0)
          {
+            // skip the bytes which can't start a delimiter
+            if (!inString)
+            {
+               skip = engine::utilScanChars(str, len, outChars, 2);
+            }
+            else
+            {
+               skip = engine::utilScanChars(str, len, strDel, 1);
+            }
+            len -= skip;
+            str += skip;
+            if (0 == len)
+            {
+               break;
+            }
+
             if (!inString)
             {
                if (_startWith(str, len, recDel, recDelLen))
@@ -189,6 +217,8 @@ namespace import
    #define SCANNER_QUOTES_NONE   0
    #define SCANNER_QUOTES        1
    #define SCANNER_QUOTES_DOUBLE 2
+   // the characters which change the state of the json scanner
+   static const CHAR _jsonChars[] = { '{', '}', '\'', '\"', '\\' };
    INT32 RecordScanner::_scanJSON(const CHAR* data, INT32 length, BOOLEAN final,
                                   INT32& recordLength)
    {
@@ -197,6 +227,7 @@ namespace import
       INT32 stringType = SCANNER_QUOTES_NONE ;
       BOOLEAN hasJson = FALSE;
       INT32 level = 0;
+      INT32 skip = 0;
       INT32 rc = SDB_EOF;
 
       SDB_ASSERT(NULL != data, "data can't be NULL");
@@ -204,6 +235,15 @@ namespace import
 
       while (len > 0)
       {
+         skip = engine::utilScanChars(str, len, _jsonChars,
+                                      sizeof(_jsonChars));
+         len -= skip;
+         str += skip;
+         if (0 == len)
+         {
+            break;
+         }
+
          switch (*str)
          {
          case '{':
@@ -259,15 +299,12 @@ namespace import
 
       if (SDB_OK == rc)
       {
-         while (len > 0)
+         if (len > 0)
          {
-            if ('{' == *str)
-            {
-               break;
-            }
-
-            str++;
-            len--;
+            // the bytes before next record belong to this one
+            skip = engine::utilScanChars(str, len, "{", 1);
+            len -= skip;
+            str += skip;
          }
 
          recordLength = length - len;         
@@ -240,14 +240,15 @@ namespace import
 
    INT32 RecordSharding::getGroupByRecord(bson* record,
                                           string& collection,
-                                          UINT32& groupId)
+                                          UINT32& groupId,
+                                          INT32& version)
    {
       INT32 rc = SDB_OK;
 
       SDB_ASSERT(_inited, "must be inited");
       SDB_ASSERT(NULL != record, "record can't be NULL");
 
-      if (_groupNum > 1)
+      if (_groupNum > 0)
       {
          if (_isMainCL)
          {
@@ -276,6 +277,7 @@ namespace import
                       collection.c_str(), rc);
                goto error;
             }
+            version = (it->second).getVersion();
          }
          else
          {
@@ -286,11 +288,13 @@ namespace import
                goto error;
             }
             collection = _collectionName;
+            version = _cataInfo.getVersion();
          }
       }
       else
       {
          groupId = 0;
+         version = -1;
       }
 
    done:
@@ -56,7 +56,9 @@ namespace import
                  const string& clname,
                  BOOLEAN useSSL);
       INT32 getGroupNum() const { return _groupNum; }
-      INT32 getGroupByRecord(bson* record, string& collection, UINT32& groupId);
+      // the version is the catalog version of the collection
+      INT32 getGroupByRecord(bson* record, string& collection,
+                             UINT32& groupId, INT32& version);
 
    private:
       const vector<Host>*     _hosts;
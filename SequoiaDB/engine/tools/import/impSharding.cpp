@@ -118,8 +118,9 @@ namespace import
             string cl;
             SubShardingGroups* subGroups = NULL;
             UINT32 groupId = 0;
+            INT32 version = -1;
 
-            rc = sharding->getGroupByRecord(record, cl, groupId);
+            rc = sharding->getGroupByRecord(record, cl, groupId, version);
             if (SDB_OK != rc)
             {
                INT32 ret;
@@ -181,6 +182,7 @@ namespace import
                   goto error;
                }
 
+               array->setTarget(cl, groupId, version);
                array->push(record);
                if (array->full())
                {
@@ -279,9 +281,7 @@ namespace import
       SDB_ASSERT(_sharding.getGroupNum() >= 0,
                  "groupNum must be greater than or equals 0");
 
-      if (_sharding.getGroupNum() <= 1 ||
-          !_options->enableSharding() ||
-          _options->batchSize() <= 1)
+      if (!needSharding())
       {
          _inited = TRUE;
          goto done;
@@ -305,7 +305,12 @@ namespace import
 
    BOOLEAN Sharding::needSharding() const
    {
-      SDB_ASSERT(_inited, "must be inited");
+      // bulk load sends the records to the primary of their group,
+      // so the records are grouped even if there is only one group
+      if (_options->bulkLoad() && _sharding.getGroupNum() > 0)
+      {
+         return TRUE;
+      }
 
       return (_options->enableSharding() &&
               _options->batchSize() > 1 &&
@@ -115,7 +115,8 @@ namespace replay
          RPL_LOG_OP_TS_ROLLBACK,
          RPL_LOG_OP_INVALIDATE_CATA,
          RPL_LOG_OP_CS_RENAME,
-         RPL_LOG_OP_POP
+         RPL_LOG_OP_POP,
+         RPL_LOG_OP_LOAD
       };
 
       const INT32 opNum = sizeof(ops) / sizeof(ops[0]);
@@ -143,6 +144,7 @@ namespace replay
       case LOG_TYPE_DATA_DELETE:
       case LOG_TYPE_CL_TRUNC:
       case LOG_TYPE_DATA_POP:
+      case LOG_TYPE_DATA_LOAD:
          return TRUE;
       default:
          return FALSE;
@@ -212,6 +214,7 @@ namespace replay
          _op.insert(RPL_LOG_OP_DELETE);
          _op.insert(RPL_LOG_OP_TRUNCATE_CL);
          _op.insert(RPL_LOG_OP_POP);
+         _op.insert(RPL_LOG_OP_LOAD);
       }
 
       value = DPS_INVALID_LSN_OFFSET;
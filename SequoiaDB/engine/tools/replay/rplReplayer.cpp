@@ -817,6 +817,9 @@ namespace replay
       case LOG_TYPE_DATA_POP:
          rc = _replayPop(log) ;
          break ;
+      case LOG_TYPE_DATA_LOAD:
+         rc = _replayLoad(log);
+         break;
       default:
          SDB_ASSERT(FALSE, "invalid log type");
       }
@@ -882,6 +885,65 @@ namespace replay
       goto done;
    }
 
+   INT32 Replayer::_replayLoad(const CHAR* log)
+   {
+      INT32 rc = SDB_OK;
+      const dpsLogRecordHeader& header = *(const dpsLogRecordHeader*)log;
+      const CHAR* fullName = NULL;
+      const CHAR* pBlock = NULL;
+      UINT32 blockSize = 0;
+      UINT32 recordNum = 0;
+      UINT32 offset = 0;
+      sdbCollection cl;
+
+      SDB_ASSERT(LOG_TYPE_DATA_LOAD == header._type, "not data load log");
+
+      rc = dpsRecord2Load(log, &fullName, &pBlock, blockSize, recordNum);
+      if (SDB_OK != rc)
+      {
+         PD_LOG(PDERROR, "Failed to parse log record, lsn[%lld], rc=%d",
+                header._lsn, rc);
+         goto error;
+      }
+
+      rc = _sdb->getCollection(fullName, cl);
+      if (SDB_OK != rc)
+      {
+         PD_LOG(PDERROR, "Failed to get collection:%s, lsn[%lld], rc=%d",
+                fullName, header._lsn, rc ) ;
+         goto error ;
+      }
+
+      // the records of the block are inserted one by one
+      while (offset < blockSize)
+      {
+         BSONObj obj(pBlock + offset);
+
+         rc = cl.insert(obj);
+         if (SDB_OK != rc)
+         {
+            if (SDB_IXM_DUP_KEY == rc)
+            {
+               /* If duplicate key was found, just skip. */
+               rc = SDB_OK;
+            }
+            else
+            {
+               PD_LOG(PDERROR, "Failed to insert record(%s), lsn[%lld], "
+                      "rc=%d", obj.toString(FALSE, TRUE).c_str(),
+                      header._lsn, rc);
+               goto error;
+            }
+         }
+         offset += ossRoundUpToMultipleX(obj.objsize(), 4);
+      }
+
+   done:
+      return rc;
+   error:
+      goto done;
+   }
+
    INT32 Replayer::_replayUpdate(const CHAR* log)
    {
       INT32 rc = SDB_OK;
@@ -2352,6 +2414,9 @@ namespace replay
       case LOG_TYPE_DATA_POP:
          rc = _rollbackPop(log);
          break;
+      case LOG_TYPE_DATA_LOAD:
+         rc = _rollbackLoad(log);
+         break;
       default:
          SDB_ASSERT(FALSE, "invalid log type");
       }
@@ -2436,6 +2501,79 @@ namespace replay
       goto done;
    }
 
+   INT32 Replayer::_rollbackLoad(const CHAR* log)
+   {
+      INT32 rc = SDB_OK;
+      const dpsLogRecordHeader& header = *(const dpsLogRecordHeader*)log;
+      const CHAR* fullName = NULL;
+      const CHAR* pBlock = NULL;
+      UINT32 blockSize = 0;
+      UINT32 recordNum = 0;
+      UINT32 offset = 0;
+      BSONObj hint = BSON(""<<IXM_ID_KEY_NAME);
+      sdbCollection cl;
+
+      SDB_ASSERT(LOG_TYPE_DATA_LOAD == header._type, "not data load log");
+
+      rc = dpsRecord2Load(log, &fullName, &pBlock, blockSize, recordNum);
+      if (SDB_OK != rc)
+      {
+         PD_LOG(PDERROR, "Failed to parse log record, lsn[%lld], rc=%d",
+                header._lsn, rc);
+         goto error;
+      }
+
+      rc = _sdb->getCollection(fullName, cl);
+      if (SDB_OK != rc)
+      {
+         PD_LOG(PDERROR, "Failed to get collection:%s, lsn[%lld], rc=%d",
+                fullName, header._lsn, rc ) ;
+         goto error ;
+      }
+
+      while (offset < blockSize)
+      {
+         BSONObj obj(pBlock + offset);
+         BSONObj selector;
+         BSONElement idEle = obj.getField( DMS_ID_KEY_NAME ) ;
+         if ( idEle.eoo() )
+         {
+            PD_LOG(PDWARNING, "Failed to parse oid from bson:[%s]",
+                   obj.toString().c_str()) ;
+            rc = SDB_SYS;
+            goto error;
+         }
+
+         try
+         {
+            BSONObjBuilder selectorBuilder ;
+            selectorBuilder.append( idEle ) ;
+            selector = selectorBuilder.obj() ;
+         }
+         catch (std::exception& e)
+         {
+            rc = SDB_SYS;
+            PD_LOG(PDERROR, "Unexpected error happened: %s", e.what());
+            goto error;
+         }
+
+         rc = cl.del(selector, hint);
+         if (SDB_OK != rc)
+         {
+            PD_LOG(PDERROR, "Failed to rollback load record(%s), lsn[%lld], "
+                   "rc=%d", obj.toString(FALSE, TRUE).c_str(),
+                   header._lsn, rc);
+            goto error;
+         }
+         offset += ossRoundUpToMultipleX(obj.objsize(), 4);
+      }
+
+   done:
+      return rc;
+   error:
+      goto done;
+   }
+
    INT32 Replayer::_rollbackUpdate(const CHAR* log)
    {
       INT32 rc = SDB_OK;
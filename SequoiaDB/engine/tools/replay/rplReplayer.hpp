@@ -95,6 +95,7 @@ namespace replay
       INT32 _replayDelete(const CHAR* log);
       INT32 _replayTruncateCL(const CHAR* log);
       INT32 _replayPop(const CHAR *log) ;
+      INT32 _replayLoad(const CHAR* log);
       INT32 _move(UINT32 startFileId);
       INT32 _rollbackLogFile(engine::dpsLogFile& logFile,
                            DPS_LSN_OFFSET startLSN, DPS_LSN_OFFSET endLSN);
@@ -108,6 +109,7 @@ namespace replay
       INT32 _rollbackDelete(const CHAR* log);
       INT32 _rollbackTruncateCL(const CHAR* log);
       INT32 _rollbackPop(const CHAR* log);
+      INT32 _rollbackLoad(const CHAR* log);
       INT32 _deflateFile(const string& file);
       INT32 _inflateFile(const string& file);
 
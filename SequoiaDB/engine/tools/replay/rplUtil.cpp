@@ -80,6 +80,8 @@ namespace replay
          return RPL_LOG_OP_CS_RENAME;
       case LOG_TYPE_DATA_POP:
          return RPL_LOG_OP_POP;
+      case LOG_TYPE_DATA_LOAD:
+         return RPL_LOG_OP_LOAD;
       default:
          SDB_ASSERT(FALSE, "unknown log type");
          return "unknown";
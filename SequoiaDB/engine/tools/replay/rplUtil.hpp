@@ -56,6 +56,7 @@ namespace replay
    #define RPL_LOG_OP_INVALIDATE_CATA  "invalidatecata"
    #define RPL_LOG_OP_CS_RENAME        "renamecs"
    #define RPL_LOG_OP_POP              "pop"
+   #define RPL_LOG_OP_LOAD             "load"
 
    CHAR* getOPName(UINT16 type);
 }
@@ -38,6 +38,7 @@
 #include "csv2rawbson.hpp"
 #include "ossUtil.h"
 #include "pd.hpp"
+#include "utilCharScan.hpp"
 #include "../client/bson/bson.h"
 #include "time.h"
 #include <math.h>
@@ -2194,12 +2195,23 @@ INT32 csvParser::csv2bson( CHAR *pBuffer, INT32 size, CHAR **ppRawbson )
    CHAR   *leftField    = pBuffer ;
    CHAR   *pBsonBuf     = NULL ;
    CHAR    fieldName[CSV_STR_FIELD_MAX_SIZE] ;
+   const CHAR stopChars[3] = { _delChar, _delField, _delRecord } ;
+   INT32   skip         = 0 ;
    _valueData valueData ;
    bson obj ;
    bson_init ( &obj ) ;
 
    do
    {
+      // skip the bytes which change nothing, only delChar ends a string
+      if ( size > 0 )
+      {
+         skip = (INT32)engine::utilScanChars( pCursor, (UINT32)size,
+                                              stopChars, isString ? 1 : 3 ) ;
+         pCursor += skip ;
+         size -= skip ;
+      }
+
       if ( 0 == size )
       {
          if ( !isString )
@@ -0,0 +1,228 @@
+/*******************************************************************************
+
+   Copyright (C) 2011-2014 SequoiaDB Ltd.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the term of the GNU Affero General Public License, version 3,
+   as published by the Free Software Foundation.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warrenty of
+   MARCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU Affero General Public License for more details.
+
+   You should have received a copy of the GNU Affero General Public License
+   along with this program. If not, see <http://www.gnu.org/license/>.
+
+   Source File Name = utilCharScan.cpp
+
+   Descriptive Name = Structural Character Scan
+
+   When/how to use: this program may be used on binary and text-formatted
+   versions of utility component. This file contains the functions which
+   search the first structural character( delimiters, quotes, braces ) of
+   the CSV or JSON text by SIMD.
+
+   Dependencies: N/A
+
+   Restrictions: N/A
+
+   Change Activity:
+   defect Date        Who Description
+   ====== =========== === ==============================================
+          10/17/2026  LL  Initial Draft
+
+   Last Changed =
+
+*******************************************************************************/
+
+#include "utilCharScan.hpp"
+#include <string.h>
+
+#if defined (__x86_64__) || defined (_M_X64)
+#define UTIL_SCAN_SSE2
+#include <emmintrin.h>
+#if defined (__GNUC__) && !defined (__clang__) && \
+    ( __GNUC__ > 4 || ( __GNUC__ == 4 && __GNUC_MINOR__ >= 9 ) )
+#define UTIL_SCAN_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined (_WINDOWS)
+#include <intrin.h>
+#endif
+
+namespace engine
+{
+   typedef UINT32 (*UTIL_SCAN_FUNC)( const CHAR *pData, UINT32 len,
+                                     const CHAR *pChars, UINT32 num ) ;
+
+   static UTIL_SCAN_FUNC   _utilScanFunc = NULL ;
+   static const CHAR      *_utilScanName = "scalar" ;
+
+   UINT32 utilScanCharsScalar( const CHAR *pData, UINT32 len,
+                               const CHAR *pChars, UINT32 num )
+   {
+      UINT32 pos = 0 ;
+      for ( ; pos < len ; ++pos )
+      {
+         for ( UINT32 i = 0 ; i < num ; ++i )
+         {
+            if ( pData[ pos ] == pChars[ i ] )
+            {
+               return pos ;
+            }
+         }
+      }
+      return len ;
+   }
+
+#if defined (UTIL_SCAN_SSE2)
+
+   OSS_INLINE UINT32 _utilScanFirstBit( UINT32 mask )
+   {
+#if defined (_WINDOWS)
+      unsigned long index = 0 ;
+      _BitScanForward( &index, mask ) ;
+      return (UINT32)index ;
+#else
+      return (UINT32)__builtin_ctz( mask ) ;
+#endif
+   }
+
+   // 16 bytes a round, SSE2 is always there on x86_64
+   static UINT32 _utilScanCharsSSE2( const CHAR *pData, UINT32 len,
+                                     const CHAR *pChars, UINT32 num )
+   {
+      __m128i needles[ UTIL_SCAN_MAX_CHARS ] ;
+      UINT32 pos = 0 ;
+
+      for ( UINT32 i = 0 ; i < num ; ++i )
+      {
+         needles[ i ] = _mm_set1_epi8( pChars[ i ] ) ;
+      }
+
+      while ( pos + 16 <= len )
+      {
+         __m128i block = _mm_loadu_si128( (const __m128i*)( pData + pos ) ) ;
+         __m128i hit = _mm_cmpeq_epi8( block, needles[ 0 ] ) ;
+         for ( UINT32 i = 1 ; i < num ; ++i )
+         {
+            hit = _mm_or_si128( hit, _mm_cmpeq_epi8( block, needles[ i ] ) ) ;
+         }
+         UINT32 mask = (UINT32)_mm_movemask_epi8( hit ) ;
+         if ( mask )
+         {
+            return pos + _utilScanFirstBit( mask ) ;
+         }
+         pos += 16 ;
+      }
+
+      return pos + utilScanCharsScalar( pData + pos, len - pos,
+                                        pChars, num ) ;
+   }
+
+#endif // UTIL_SCAN_SSE2
+
+#if defined (UTIL_SCAN_AVX2)
+
+   // 64 bytes a round by two registers, the tail goes by SSE2
+   __attribute__((target("avx2")))
+   static UINT32 _utilScanCharsAVX2( const CHAR *pData, UINT32 len,
+                                     const CHAR *pChars, UINT32 num )
+   {
+      __m256i needles[ UTIL_SCAN_MAX_CHARS ] ;
+      UINT32 pos = 0 ;
+
+      for ( UINT32 i = 0 ; i < num ; ++i )
+      {
+         needles[ i ] = _mm256_set1_epi8( pChars[ i ] ) ;
+      }
+
+      while ( pos + 64 <= len )
+      {
+         __m256i lo = _mm256_loadu_si256( (const __m256i*)( pData + pos ) ) ;
+         __m256i hi = _mm256_loadu_si256(
+                                 (const __m256i*)( pData + pos + 32 ) ) ;
+         __m256i hitLo = _mm256_cmpeq_epi8( lo, needles[ 0 ] ) ;
+         __m256i hitHi = _mm256_cmpeq_epi8( hi, needles[ 0 ] ) ;
+         for ( UINT32 i = 1 ; i < num ; ++i )
+         {
+            hitLo = _mm256_or_si256( hitLo,
+                                     _mm256_cmpeq_epi8( lo, needles[ i ] ) ) ;
+            hitHi = _mm256_or_si256( hitHi,
+                                     _mm256_cmpeq_epi8( hi, needles[ i ] ) ) ;
+         }
+         UINT64 mask = (UINT32)_mm256_movemask_epi8( hitLo ) |
+                       ( (UINT64)(UINT32)_mm256_movemask_epi8( hitHi ) << 32 ) ;
+         if ( mask )
+         {
+            return pos + (UINT32)__builtin_ctzll( mask ) ;
+         }
+         pos += 64 ;
+      }
+
+      return pos + _utilScanCharsSSE2( pData + pos, len - pos,
+                                       pChars, num ) ;
+   }
+
+#endif // UTIL_SCAN_AVX2
+
+   static void _utilScanInit()
+   {
+      UTIL_SCAN_FUNC func = utilScanCharsScalar ;
+      const CHAR *pName = "scalar" ;
+#if defined (UTIL_SCAN_SSE2)
+      func = _utilScanCharsSSE2 ;
+      pName = "sse2" ;
+#endif
+#if defined (UTIL_SCAN_AVX2)
+      __builtin_cpu_init() ;
+      if ( __builtin_cpu_supports( "avx2" ) )
+      {
+         func = _utilScanCharsAVX2 ;
+         pName = "avx2" ;
+      }
+#endif
+      // all the threads choose the same one, so the race is harmless
+      _utilScanName = pName ;
+      _utilScanFunc = func ;
+   }
+
+   UINT32 utilScanChars( const CHAR *pData, UINT32 len,
+                         const CHAR *pChars, UINT32 num )
+   {
+      if ( 0 == len || 0 == num )
+      {
+         return len ;
+      }
+      else if ( 1 == num )
+      {
+         // memchr of libc has been vectorized
+         const CHAR *pFound = (const CHAR*)memchr( pData, pChars[ 0 ], len ) ;
+         return pFound ? (UINT32)( pFound - pData ) : len ;
+      }
+      else if ( num > UTIL_SCAN_MAX_CHARS )
+      {
+         return utilScanCharsScalar( pData, len, pChars, num ) ;
+      }
+
+      if ( NULL == _utilScanFunc )
+      {
+         _utilScanInit() ;
+      }
+      return _utilScanFunc( pData, len, pChars, num ) ;
+   }
+
+   const CHAR* utilScanImplName()
+   {
+      if ( NULL == _utilScanFunc )
+      {
+         _utilScanInit() ;
+      }
+      return _utilScanName ;
+   }
+
+}
+